@@ -51,6 +51,9 @@ import { useFonts } from 'expo-font';
 import { useEffect, useRef } from 'react';
 import { OnboardingProvider } from '../src/context/OnboardingContext';
 import UnifiedSmartRingService from '../src/services/UnifiedSmartRingService';
+import { appLog } from '../src/services/SupabaseService';
+import { atLeast } from '../src/services/LogPipeline';
+import { resetRingDateCache } from '../src/utils/ringDate';
 import { HomeDataProvider } from '../src/context/HomeDataContext';
 import { AddOverlayProvider } from '../src/context/AddOverlayContext';
 import { MetricExplainerProvider } from '../src/context/MetricExplainerContext';
@@ -112,18 +115,29 @@ function RootLayout() {
     }
   }, [fontError]);
 
-  // Re-sync ring clock on foreground — catches TZ changes from travel or DST before the next data read.
+  // Re-apply device config on foreground — catches TZ changes from travel or DST before the next
+  // data read. A no-op without BLE traffic when nothing changed. Cached ring-date midnights are
+  // dropped for the same reason.
   const appStateRef = useRef(AppState.currentState);
   useEffect(() => {
     const sub = AppState.addEventListener('change', nextState => {
       if (appStateRef.current !== 'active' && nextState === 'active') {
-        UnifiedSmartRingService.maybeSyncRingClock().catch(() => {});
+        resetRingDateCache();
+        UnifiedSmartRingService.applyDeviceConfig();
       }
       appStateRef.current = nextState;
     });
     return () => sub.remove();
   }, []);
 
+  // Ring bridge warnings and errors join the app's remote log; debug / info stay on device
+  useEffect(() => UnifiedSmartRingService.onNativeLog((batch, source) => {
+    for (const entry of batch.entries) {
+      if (atLeast(entry.level, 'warn')) appLog.log(entry.level, source, entry.message, { nativeAt: entry.at });
+    }
+    if (batch.dropped > 0) appLog.log('warn', source, 'native_log_dropped', { dropped: batch.dropped });
+  }), []);
+
   // Safety timeout — never let splash hang more than 5s
   useEffect(() => {
     const timer = setTimeout(() => {
@@ -29,7 +29,7 @@ import { DetailPageHeader } from '../../src/components/detail/DetailPageHeader';
 import { MetricsGrid } from '../../src/components/detail/MetricsGrid';
 import { useMetricHistory, buildDayNavigatorLabels } from '../../src/hooks/useMetricHistory';
 import type { DayActivityData } from '../../src/hooks/useMetricHistory';
-import { useHomeDataContext } from '../../src/context/HomeDataContext';
+import { useHomeDataFields } from '../../src/context/HomeDataContext';
 import { spacing, fontSize, fontFamily } from '../../src/theme/colors';
 
 const COLLAPSE_END = 80;
@@ -145,7 +145,7 @@ function StepsArcGauge({ steps, goal }: { steps: number; goal: number }) {
 export default function ActivityDetailScreen() {
   const [selectedIndex, setSelectedIndex] = useState(0);
   const { data, isLoading } = useMetricHistory<DayActivityData>('activity', { fullDays: 30 });
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('activity');
 
   const selectedDateKey = DAY_ENTRIES[selectedIndex]?.dateKey;
   const todayKey = DAY_ENTRIES[0]?.dateKey;
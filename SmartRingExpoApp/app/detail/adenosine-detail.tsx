@@ -37,7 +37,7 @@ import { TrendBarChart } from '../../src/components/detail/TrendBarChart';
 import { MetricsGrid } from '../../src/components/detail/MetricsGrid';
 import { LogDrinkSheet, type LogDrinkSheetHandle } from '../../src/components/home/LogDrinkSheet';
 import { buildDayNavigatorLabels } from '../../src/hooks/useMetricHistory';
-import { useHomeDataContext } from '../../src/context/HomeDataContext';
+import { useHomeDataFields } from '../../src/context/HomeDataContext';
 import { useCaffeineTimeline } from '../../src/hooks/useCaffeineTimeline';
 import supabaseService from '../../src/services/SupabaseService';
 import {
@@ -457,7 +457,7 @@ const drinkStyles = StyleSheet.create({
 // ─── Main screen ─────────────────────────────────────────────────────────────
 export default function AdenosineDetailScreen() {
   const { t } = useTranslation();
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('lastNightSleep');
   const [selectedIndex, setSelectedIndex] = useState(0);
   const logSheetRef = useRef<LogDrinkSheetHandle>(null);
 
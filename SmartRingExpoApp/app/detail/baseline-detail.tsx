@@ -34,7 +34,7 @@ import Svg, {
 import { colors, fontFamily, fontSize } from '../../src/theme/colors';
 import { BackArrow } from '../../src/components/detail/BackArrow';
 import { useBaselineMode } from '../../src/context/BaselineModeContext';
-import { useHomeDataContext } from '../../src/context/HomeDataContext';
+import { useHomeDataFields } from '../../src/context/HomeDataContext';
 import {
   useMetricHistory,
   buildDayNavigatorLabels,
@@ -398,7 +398,7 @@ function TrendBars({ bars, t }: { bars: DayBarData[]; t: (k: string) => string }
 export default function BaselineDetailScreen() {
   const { t } = useTranslation();
   const baseline = useBaselineMode();
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('activity', 'hrvSdnn', 'lastNightSleep', 'sleepScore', 'todayVitals');
 
   const { data: sleepData, isLoading: sleepLoading } = useMetricHistory<DaySleepData>('sleep');
   const { data: hrData, isLoading: hrLoading } = useMetricHistory<DayHRData>('heartRate');
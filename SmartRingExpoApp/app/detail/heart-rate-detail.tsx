@@ -27,7 +27,7 @@ import { LiveHeartRateCard } from '../../src/components/home/LiveHeartRateCard';
 import { ActivityInfoSheet } from '../../src/components/home/ActivityInfoSheet';
 import { useMetricHistory, buildDayNavigatorLabels } from '../../src/hooks/useMetricHistory';
 import type { DayHRData } from '../../src/hooks/useMetricHistory';
-import { useHomeDataContext } from '../../src/context/HomeDataContext';
+import { useHomeDataFields } from '../../src/context/HomeDataContext';
 import { useHistoricalStravaActivities } from '../../src/hooks/useHistoricalStravaActivities';
 import { findActivitiesForDay, findActivityAtTime } from '../../src/utils/activityMatching';
 import type { UnifiedActivity } from '../../src/types/activity.types';
@@ -416,7 +416,7 @@ export default function HeartRateDetailScreen() {
   const [selectedIndex, setSelectedIndex] = useState(0);
   const [selectedActivity, setSelectedActivity] = useState<UnifiedActivity | null>(null);
   const { data, isLoading } = useMetricHistory<DayHRData>('heartRate', { initialDays: 7, fullDays: 30 });
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('hrChartData', 'hrDataIsToday', 'unifiedActivities');
   const historicalActivities = useHistoricalStravaActivities();
 
   const selectedDateKey = DAY_ENTRIES[selectedIndex]?.dateKey;
@@ -23,7 +23,7 @@ import { MetricsGrid } from '../../src/components/detail/MetricsGrid';
 import { TrendBarChart } from '../../src/components/detail/TrendBarChart';
 import { useMetricHistory, buildDayNavigatorLabels } from '../../src/hooks/useMetricHistory';
 import type { DayHRVData } from '../../src/hooks/useMetricHistory';
-import { useHomeDataContext } from '../../src/context/HomeDataContext';
+import { useHomeDataFields } from '../../src/context/HomeDataContext';
 import { spacing, fontSize, fontFamily } from '../../src/theme/colors';
 
 const DAY_ENTRIES = buildDayNavigatorLabels(30);
@@ -64,7 +64,7 @@ function buildTodayHRVFromContext(hrvSdnn: number): DayHRVData | null {
 export default function HRVDetailScreen() {
   const [selectedIndex, setSelectedIndex] = useState(0);
   const { data, isLoading } = useMetricHistory<DayHRVData>('hrv', { initialDays: 7, fullDays: 30 });
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('hrvSdnn');
 
   const selectedDateKey = DAY_ENTRIES[selectedIndex]?.dateKey;
   const todayKey = DAY_ENTRIES[0]?.dateKey;
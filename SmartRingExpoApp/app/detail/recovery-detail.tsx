@@ -33,7 +33,7 @@ import { MetricsGrid } from '../../src/components/detail/MetricsGrid';
 import { TrendBarChart } from '../../src/components/detail/TrendBarChart';
 import { useMetricHistory, buildDayNavigatorLabels } from '../../src/hooks/useMetricHistory';
 import type { DaySleepData, DayHRData, DayHRVData } from '../../src/hooks/useMetricHistory';
-import { useHomeDataContext } from '../../src/context/HomeDataContext';
+import { useHomeDataFields } from '../../src/context/HomeDataContext';
 import { useFocusDataContext } from '../../src/context/FocusDataContext';
 import { useDayMetrics } from '../../src/hooks/useDayMetrics';
 import type { DayMetrics } from '../../src/types/focus.types';
@@ -674,7 +674,7 @@ function recoveryInsight(r: DayReadiness): string {
 
 export default function RecoveryDetailScreen() {
   const [selectedIndex, setSelectedIndex] = useState(0);
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('strain', 'strainBreakdown');
   const explainerRef = useRef<BottomSheetModal>(null);
 
   const openExplainer = useCallback(() => {
@@ -32,7 +32,7 @@ import { TrendBarChart } from '../../src/components/detail/TrendBarChart';
 import { SleepHypnogram } from '../../src/components/home/SleepHypnogram';
 import { useMetricHistory, buildDayNavigatorLabels } from '../../src/hooks/useMetricHistory';
 import type { DaySleepData } from '../../src/hooks/useMetricHistory';
-import { useHomeDataContext } from '../../src/context/HomeDataContext';
+import { useHomeDataContext, useHomeDataFields } from '../../src/context/HomeDataContext';
 import { spacing, fontSize, fontFamily } from '../../src/theme/colors';
 import { useTranslation } from 'react-i18next';
 
@@ -674,7 +674,9 @@ export default function SleepDetailScreen() {
 
   // Progressive: show last 7 days immediately, extend to 30 silently in background
   const { data, isLoading } = useMetricHistory<DaySleepData>('sleep', { initialDays: 7, fullDays: 30 });
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields(
+    'hrChartData', 'lastNightSleep', 'todayNaps', 'totalNapMinutesToday', 'unifiedSleepSessions',
+  );
 
   const selectedDateKey = DAY_ENTRIES[selectedIndex]?.dateKey;
   // For today, always prefer live ring data — it's fresher than a cached Supabase sync,
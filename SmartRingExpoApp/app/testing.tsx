@@ -7,6 +7,7 @@ import { SleepScoreIcon } from '../src/assets/icons';
 import { spacing, fontSize, fontFamily } from '../src/theme/colors';
 import UnifiedSmartRingService from '../src/services/UnifiedSmartRingService';
 import JstyleService from '../src/services/JstyleService';
+import { segmentRingSleep } from '../src/services/SleepSegmentation';
 import { Alert } from 'react-native';
 
 type SleepDataLite = {
@@ -21,25 +22,8 @@ type BatteryLite = { battery: number } | null;
 type HRLite = { heartRate: number; samples: number[] } | null;
 type HRVLite = { sdnn: number; heartRate?: number; stress?: number; timestamp?: number } | null;
 
-// Map SDK quality to hypnogram stages
-const mapSleepType = (type: number): SleepSegment['stage'] => {
-  switch (type) {
-    case 1: return 'deep';
-    case 2: return 'core';
-    case 3: return 'rem';
-    default: return 'awake';
-  }
-};
-
-function parseStart(str?: string): number | undefined {
-  if (!str) return;
-  const [d, t] = str.split(' ');
-  if (!d || !t) return;
-  const [y, m, day] = d.split('.').map(Number);
-  const [hh, mm, ss] = t.split(':').map(Number);
-  if ([y, m, day, hh, mm, ss].some(n => Number.isNaN(n))) return;
-  return new Date(y, (m ?? 1) - 1, day, hh, mm, ss).getTime();
-}
+// Timeline code (STAGE_*) → hypnogram stage
+const TIMELINE_STAGES: SleepSegment['stage'][] = ['awake', 'core', 'rem', 'deep'];
 
 function formatMinutes(mins: number): string {
   const h = Math.floor(mins / 60);
@@ -52,68 +36,22 @@ function formatMinutes(mins: number): string {
 function deriveFromRaw(rawRecords: any[]): SleepDataLite | null {
   if (!rawRecords || rawRecords.length === 0) return null;
 
-  // Normalize records
-  const normalizedAll = rawRecords.map(r => {
-    const start = r.startTimestamp || parseStart(r.startTime_SleepData);
-    const unit = Number(r.sleepUnitLength) || 1;
-    const arr: number[] = r.arraySleepQuality || [];
-    const durationMin = Number(r.totalSleepTime) || arr.length * unit;
-    return { start, unit, arr, durationMin };
-  }).filter(r => typeof r.start === 'number' && r.start > 0);
-
-  if (normalizedAll.length === 0) return null;
-
-  // Build longest continuous block (max 60m gap between records)
-  const sorted = [...normalizedAll].sort((a, b) => a.start! - b.start!);
-  const MAX_GAP_MS = 60 * 60 * 1000;
-  const blocks: { start: number; end: number; records: typeof normalizedAll }[] = [];
-  let block: { start: number; end: number; records: typeof normalizedAll } | null = null;
-
-  for (const rec of sorted) {
-    const recStart = rec.start!;
-    const recEnd = rec.start! + rec.durationMin * 60000;
-    if (!block) {
-      block = { start: recStart, end: recEnd, records: [rec] };
-      continue;
-    }
-    if (recStart - block.end <= MAX_GAP_MS) {
-      block.end = Math.max(block.end, recEnd);
-      block.records.push(rec);
-    } else {
-      blocks.push(block);
-      block = { start: recStart, end: recEnd, records: [rec] };
-    }
-  }
-  if (block) blocks.push(block);
-
+  // Sessions from a one-off segmenter (≤60 min gaps between records)
+  const blocks = segmentRingSleep(rawRecords);
   if (blocks.length === 0) return null;
   // Choose the most recent block (latest end time)
   const chosen = blocks.reduce((acc, b) => (b.end > acc.end ? b : acc), blocks[0]);
 
   const earliestStart = chosen.start;
   const latestEnd = chosen.end;
-  const totalMinutes = Math.max(0, Math.round((latestEnd - earliestStart) / 60000));
-  const timeline: number[] = new Array(totalMinutes).fill(0); // 0 awake, 1 core, 2 rem, 3 deep
-
-  for (const rec of chosen.records) {
-    const startOffset = Math.round((rec.start! - earliestStart) / 60000);
-    const unit = Math.max(1, rec.unit);
-    rec.arr.forEach((val: number, idx: number) => {
-      const stage = mapSleepType(Number(val));
-      const stageVal = stage === 'deep' ? 3 : stage === 'rem' ? 2 : stage === 'core' ? 1 : 0;
-      for (let k = 0; k < unit; k++) {
-        const pos = startOffset + idx * unit + k;
-        if (pos >= 0 && pos < timeline.length) timeline[pos] = stageVal;
-      }
-    });
-  }
+  const { timeline } = chosen;
+  const totalMinutes = timeline.length;
 
   // Totals and segments from timeline (continuous, gaps already awake)
   let deep = 0, light = 0, rem = 0, awake = 0;
   const segments: SleepSegment[] = [];
   for (let i = 0; i < timeline.length; i++) {
-    const val = timeline[i];
-    const stage: SleepSegment['stage'] = val === 3 ? 'deep' : val === 2 ? 'rem' : val === 1 ? 'core' : 'awake';
+    const stage = TIMELINE_STAGES[timeline[i]];
     switch (stage) {
       case 'deep': deep++; break;
       case 'core': light++; break;
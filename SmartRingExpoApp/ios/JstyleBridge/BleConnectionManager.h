@@ -0,0 +1,60 @@
+//
+//  BleConnectionManager.h
+//  SmartRing
+//
+//  Single owner of "stay connected to the paired ring" for both bridges.
+//
+//  JstyleBridge and V8Bridge share one NewBle, so reconnection lives here
+//  rather than in each bridge. NewBle reports link events; the manager runs
+//  them through BleReconnectPolicy and performs the resulting action:
+//
+//    - link lost      → immediate pending connect (completes when the ring is
+//                       back in range, no app wake-ups in between)
+//    - connect failed → retry on exponential backoff with jitter
+//    - radio off/on   → pause, then reconnect as soon as the radio is back
+//    - app relaunched by CoreBluetooth state restoration → adopt the restored
+//      peripheral and resume where the previous process left off
+//
+//  Bridges call connectPeripheral: for user-initiated connects (so the target
+//  is known) and stopReconnecting for intentional disconnects.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+
+@class BleLogQueue;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface BleConnectionManager : NSObject
+
++ (instancetype)sharedManager;
+
+/// Where reconnect state transitions are logged (JstyleBridge's queue); nil drops them.
+@property (nonatomic, strong, nullable) BleLogQueue *logQueue;
+
+/// Known peripheral for a saved identifier without scanning: the CoreBluetooth
+/// cache first (retrievePeripheralsWithIdentifiers), then peripherals the system
+/// already holds a link to for `services`. nil means the caller has to scan.
+- (nullable CBPeripheral *)retrievePeripheralWithIdentifier:(NSString *)identifier
+                                                   services:(NSArray<CBUUID *> *)services;
+
+/// Make `peripheral` the reconnect target and connect to it now.
+- (void)connectPeripheral:(CBPeripheral *)peripheral;
+
+/// Intentional disconnect or forget: drop the target and any armed retry.
+- (void)stopReconnecting;
+
+// NewBle callbacks (main queue)
+- (void)handleConnected:(CBPeripheral *)peripheral;
+- (void)handleDisconnect:(CBPeripheral *)peripheral error:(nullable NSError *)error;
+- (void)handleConnectFailed:(CBPeripheral *)peripheral;
+- (void)handleCentralState:(CBManagerState)state;
+- (void)handleRestoredPeripheral:(CBPeripheral *)peripheral;
+
+/// { state, failures, targetId }
+- (NSDictionary *)snapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,218 @@
+//
+//  BleConnectionManager.m
+//  SmartRing
+//
+
+#import "BleConnectionManager.h"
+#import "BleLogQueue.h"
+#import "BleReconnectPolicy.h"
+#import "BleSyncStats.h"
+#import "NewBle.h"
+
+@implementation BleConnectionManager {
+    // Policy and timer are only touched on the main queue; the lock covers snapshot reads from the bridge queue
+    BleReconnectPolicy _policy;
+    NSLock *_lock;
+    CBPeripheral *_target;
+    CBPeripheral *_restored;
+    NSTimer *_retryTimer;
+}
+
++ (instancetype)sharedManager {
+    static BleConnectionManager *shared;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        shared = [[BleConnectionManager alloc] init];
+    });
+    return shared;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _lock = [[NSLock alloc] init];
+        BleReconnectConfig config = BleReconnectConfigDefault();
+        // Radio state is unknown until the first centralManagerDidUpdateState
+        BleReconnectPolicyInit(&_policy, &config, arc4random(), false);
+    }
+    return self;
+}
+
+static void BleOnMain(dispatch_block_t block) {
+    if ([NSThread isMainThread]) {
+        block();
+    } else {
+        dispatch_async(dispatch_get_main_queue(), block);
+    }
+}
+
+#pragma mark - Bridge API
+
+- (void)setTarget:(CBPeripheral *)peripheral {
+    [_lock lock];
+    _target = peripheral;
+    [_lock unlock];
+}
+
+- (CBPeripheral *)retrievePeripheralWithIdentifier:(NSString *)identifier services:(NSArray<CBUUID *> *)services {
+    CBCentralManager *central = [NewBle sharedManager].CentralManage;
+    NSUUID *uuid = [[NSUUID alloc] initWithUUIDString:identifier];
+    if (uuid) {
+        CBPeripheral *known = [central retrievePeripheralsWithIdentifiers:@[uuid]].firstObject;
+        if (known) {
+            return known;
+        }
+    }
+    // Connected to the system (e.g. by another app or a previous process) but not yet to us.
+    // Prefer the saved identifier; otherwise take the first ring offering the service, as before.
+    NSArray<CBPeripheral *> *connected = [central retrieveConnectedPeripheralsWithServices:services];
+    for (CBPeripheral *peripheral in connected) {
+        if ([peripheral.identifier isEqual:uuid]) {
+            return peripheral;
+        }
+    }
+    return connected.firstObject;
+}
+
+- (void)connectPeripheral:(CBPeripheral *)peripheral {
+    BleOnMain(^{
+        [self setTarget:peripheral];
+        self->_restored = nil;
+        [self apply:BleReconnectEventStart];
+    });
+}
+
+- (void)stopReconnecting {
+    BleOnMain(^{
+        [self setTarget:nil];
+        self->_restored = nil;
+        [self apply:BleReconnectEventStop];
+    });
+}
+
+#pragma mark - NewBle callbacks
+
+- (BOOL)isTarget:(CBPeripheral *)peripheral {
+    return _target && [_target.identifier isEqual:peripheral.identifier];
+}
+
+- (void)handleConnected:(CBPeripheral *)peripheral {
+    if (!_target) {
+        // Connected without going through connectPeripheral: (e.g. the OS completed an old pending connect)
+        [self setTarget:peripheral];
+    }
+    if ([self isTarget:peripheral]) {
+        [self apply:BleReconnectEventConnected];
+    }
+}
+
+- (void)handleDisconnect:(CBPeripheral *)peripheral error:(NSError *)error {
+    // No error = cancelPeripheralConnection, i.e. ours
+    if (error && [self isTarget:peripheral]) {
+        [self apply:BleReconnectEventLinkLost];
+    }
+}
+
+- (void)handleConnectFailed:(CBPeripheral *)peripheral {
+    if ([self isTarget:peripheral]) {
+        [self apply:BleReconnectEventConnectFailed];
+    }
+}
+
+- (void)handleCentralState:(CBManagerState)state {
+    if (state != CBManagerStatePoweredOn) {
+        [self apply:BleReconnectEventRadioOff];
+        return;
+    }
+
+    CBPeripheral *restored = _restored;
+    _restored = nil;
+    [self apply:BleReconnectEventRadioOn];
+    if (!restored) {
+        return;
+    }
+
+    [self setTarget:restored];
+    if (restored.state == CBPeripheralStateConnected) {
+        // The link survived the relaunch; only the GATT setup has to be redone
+        [[NewBle sharedManager] resumeConnectedPeripheral:restored];
+    } else {
+        [self apply:BleReconnectEventStart];
+    }
+}
+
+- (void)handleRestoredPeripheral:(CBPeripheral *)peripheral {
+    // CoreBluetooth delivers willRestoreState before the first state update;
+    // commands have to wait for powered-on, so just remember the peripheral
+    _restored = peripheral;
+    [[BleLinkStats sharedStats] didRestore];
+}
+
+#pragma mark - Policy
+
+- (void)apply:(BleReconnectEvent)event {
+    [_lock lock];
+    BleReconnectState previous = _policy.state;
+    BleReconnectAction action = BleReconnectPolicyHandle(&_policy, event);
+    BleReconnectState next = _policy.state;
+    [_lock unlock];
+
+    switch (action.type) {
+        case BleReconnectActionConnect:
+            [self cancelRetryTimer];
+            if (_target) {
+                if (event != BleReconnectEventStart) {
+                    [[BleLinkStats sharedStats] reconnectRequested];
+                }
+                [[NewBle sharedManager] connectDevice:_target];
+            }
+            break;
+        case BleReconnectActionSchedule:
+            [self scheduleRetryAfter:action.delayMs / 1000.0];
+            break;
+        case BleReconnectActionCancel:
+            [self cancelRetryTimer];
+            break;
+        case BleReconnectActionNone:
+            break;
+    }
+
+    if (previous != next) {
+        BLE_LOG(self.logQueue, BleLogLevelInfo, @"[BleConnectionManager] %s → %s",
+                BleReconnectStateName(previous), BleReconnectStateName(next));
+    }
+}
+
+- (void)scheduleRetryAfter:(NSTimeInterval)delay {
+    [self cancelRetryTimer];
+    _retryTimer = [NSTimer scheduledTimerWithTimeInterval:delay
+                                                   target:self
+                                                 selector:@selector(retryTimerFired:)
+                                                 userInfo:nil
+                                                  repeats:NO];
+    // Let the system coalesce the wake-up with other work
+    _retryTimer.tolerance = delay * 0.1;
+}
+
+- (void)cancelRetryTimer {
+    [_retryTimer invalidate];
+    _retryTimer = nil;
+}
+
+- (void)retryTimerFired:(NSTimer *)timer {
+    _retryTimer = nil;
+    [self apply:BleReconnectEventTimerFired];
+}
+
+- (NSDictionary *)snapshot {
+    [_lock lock];
+    NSDictionary *out = @{
+        @"state": @(BleReconnectStateName(_policy.state)),
+        @"failures": @(_policy.failures),
+        @"targetId": _target.identifier.UUIDString ?: [NSNull null],
+    };
+    [_lock unlock];
+    return out;
+}
+
+@end
@@ -0,0 +1,117 @@
+//
+//  BleFetchEngine.h
+//  SmartRing
+//
+//  Table-driven paginated history fetch shared by JstyleBridge (X3) and V8Bridge.
+//
+//  Each history type is one BleFetchDescriptor: how to build the first / next-page
+//  command, where the records sit in a parsed packet, how the end of the transfer
+//  is detected, and how the accumulated records become the resolved payload.
+//  The engine owns the one active fetch, its reusable record buffer, the idle
+//  timer for end-by-silence, and per-type metrics. The bridge keeps owning the
+//  JS promise + watchdog and is told when a fetch finishes.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, BleFetchEndDetection) {
+    /// Page with mode 2 until a packet arrives with dataEnd (X3 protocol).
+    BleFetchEndOnDataEnd,
+    /// dataEnd, or a packet carrying fewer than pageSize records.
+    BleFetchEndOnShortPage,
+    /// dataEnd; request the next page each time the total reaches a multiple of
+    /// pageSize, and finish with what we have after idleTimeout of silence.
+    BleFetchEndOnDataEndOrIdle,
+};
+
+typedef NS_ENUM(NSInteger, BleFetchAbortReason) {
+    BleFetchAbortTimeout,
+    BleFetchAbortCancelled,
+    BleFetchAbortError,
+    BleFetchAbortDisconnected,
+};
+
+/// Mode byte that makes every ...WithMode: history command delete all records of its type.
+extern const int BleFetchModeDeleteAll;
+
+@interface BleFetchDescriptor : NSObject
+
+@property (nonatomic, copy) NSString *name;
+/// Fetch key passed to startFetchForDataType: and reported back on finish.
+@property (nonatomic, assign) NSInteger dataType;
+/// Type the ring's reply packets are parsed as. Defaults to dataType; differs when two
+/// commands share one reply type (X3 continuous SpO2 answers as AutomaticSpo2Data_X3).
+@property (nonatomic, assign) NSInteger packetDataType;
+/// mode 0 = first page, 2 = next page, BleFetchModeDeleteAll = clear the type on the ring.
+@property (nonatomic, copy) NSData *_Nullable (^commandForMode)(int mode);
+/// Keys tried in order for the record array. Empty = the whole packet dictionary is one record.
+@property (nonatomic, copy) NSArray<NSString *> *payloadKeys;
+@property (nonatomic, assign) BleFetchEndDetection endDetection;
+@property (nonatomic, assign) NSUInteger pageSize;
+@property (nonatomic, assign) NSTimeInterval idleTimeout;
+/// The ring also pushes this type unasked (activity mode streams ActivityModeData while a
+/// workout runs). Packets with no fetch in flight are left to the delegate instead of
+/// being dropped as late pages.
+@property (nonatomic, assign) BOOL streamsWhenIdle;
+/// Builds the resolved value. Default: @{ @"data": records }.
+@property (nonatomic, copy, nullable) NSDictionary *(^finish)(NSArray *records, NSDictionary *_Nullable lastPacket);
+
++ (instancetype)descriptorWithName:(NSString *)name
+                          dataType:(NSInteger)dataType
+                       payloadKeys:(NSArray<NSString *> *)payloadKeys
+                      endDetection:(BleFetchEndDetection)endDetection
+                    commandForMode:(NSData *_Nullable (^)(int mode))commandForMode;
+
+@end
+
+@class BleFetchEngine;
+
+@protocol BleFetchEngineDelegate <NSObject>
+- (void)fetchEngine:(BleFetchEngine *)engine writeCommand:(NSData *)command;
+- (void)fetchEngine:(BleFetchEngine *)engine didFinishDataType:(NSInteger)dataType result:(NSDictionary *)result;
+/// The ring replied to the delete-all command from deleteCommandForDataType:.
+- (void)fetchEngine:(BleFetchEngine *)engine didDeleteDataType:(NSInteger)dataType;
+- (void)fetchEngine:(BleFetchEngine *)engine log:(NSString *)message;
+@end
+
+@interface BleFetchEngine : NSObject
+
+@property (nonatomic, weak, nullable) id<BleFetchEngineDelegate> delegate;
+/// Data type of the fetch in progress, or NSNotFound.
+@property (nonatomic, assign, readonly) NSInteger activeDataType;
+
+- (void)registerDescriptor:(BleFetchDescriptor *)descriptor;
+- (BOOL)handlesDataType:(NSInteger)dataType;
+
+/// Reset the type's buffer, start metrics and write the mode-0 command.
+- (BOOL)startFetchForDataType:(NSInteger)dataType;
+
+/// Feed a parsed packet (by packetDataType). Returns NO if no descriptor replies with
+/// that type (caller handles it).
+- (BOOL)handlePacketForDataType:(NSInteger)dataType
+                        dicData:(nullable NSDictionary *)dicData
+                        dataEnd:(BOOL)dataEnd;
+
+/// The type's delete-all command (mode 0x99), or nil without a descriptor. Counted in
+/// the type's metrics; the caller writes it and must not have a fetch in flight. The
+/// ring's reply is reported through fetchEngine:didDeleteDataType:; abortWithReason:
+/// stops waiting for it.
+- (nullable NSData *)deleteCommandForDataType:(NSInteger)dataType;
+
+/// Attribute raw notification bytes to the active fetch.
+- (void)recordBytes:(NSUInteger)length;
+
+/// Drop the active fetch (watchdog, JS cancel, DataError, disconnect). No-op when idle.
+- (void)abortWithReason:(BleFetchAbortReason)reason;
+
+/// Per-type totals keyed by descriptor name: fetches, completed, pages, records, bytes,
+/// lastMs, avgMs, maxMs, idleEnds, timeouts, cancels, errors, disconnects, deletes, plus
+/// ttfbMs / durationMs histograms (see BleLatencyHistogramSnapshot).
+- (NSDictionary<NSString *, NSDictionary *> *)metricsSnapshot;
+- (void)resetMetrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
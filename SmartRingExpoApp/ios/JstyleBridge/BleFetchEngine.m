@@ -0,0 +1,414 @@
+//
+//  BleFetchEngine.m
+//  SmartRing
+//
+
+#import "BleFetchEngine.h"
+#import "BleSyncStats.h"
+
+const int BleFetchModeDeleteAll = 0x99;
+
+static const NSUInteger kDefaultPageSize = 50;
+static const NSTimeInterval kDefaultIdleTimeout = 3.0;
+// Typical history pull is a few hundred records; grow from there without rehashing early pages
+static const NSUInteger kInitialBufferCapacity = 256;
+
+#pragma mark - Descriptor
+
+@implementation BleFetchDescriptor
+
++ (instancetype)descriptorWithName:(NSString *)name
+                          dataType:(NSInteger)dataType
+                       payloadKeys:(NSArray<NSString *> *)payloadKeys
+                      endDetection:(BleFetchEndDetection)endDetection
+                    commandForMode:(NSData *_Nullable (^)(int mode))commandForMode {
+    BleFetchDescriptor *d = [[self alloc] init];
+    d.name = name;
+    d.dataType = dataType;
+    d.packetDataType = dataType;
+    d.payloadKeys = payloadKeys ?: @[];
+    d.endDetection = endDetection;
+    d.commandForMode = commandForMode;
+    d.pageSize = kDefaultPageSize;
+    d.idleTimeout = kDefaultIdleTimeout;
+    return d;
+}
+
+@end
+
+#pragma mark - Metrics
+
+@interface BleFetchMetrics : NSObject {
+@public
+    BleLatencyHistogram ttfb;
+    BleLatencyHistogram duration;
+}
+@property (nonatomic, assign) NSUInteger fetches;
+@property (nonatomic, assign) NSUInteger completed;
+@property (nonatomic, assign) NSUInteger pages;
+@property (nonatomic, assign) NSUInteger records;
+@property (nonatomic, assign) NSUInteger bytes;
+@property (nonatomic, assign) double lastMs;
+@property (nonatomic, assign) double totalMs;
+@property (nonatomic, assign) double maxMs;
+@property (nonatomic, assign) NSUInteger idleEnds;
+@property (nonatomic, assign) NSUInteger timeouts;
+@property (nonatomic, assign) NSUInteger cancels;
+@property (nonatomic, assign) NSUInteger errors;
+@property (nonatomic, assign) NSUInteger disconnects;
+@property (nonatomic, assign) NSUInteger deletes;
+@end
+
+@implementation BleFetchMetrics
+@end
+
+#pragma mark - Engine
+
+@interface BleFetchEngine ()
+
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, BleFetchDescriptor *> *descriptors;
+/// packetDataType → every descriptor replying with it, in registration order (idle packets)
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSMutableArray<BleFetchDescriptor *> *> *packetDescriptors;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSMutableArray *> *buffers;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, BleFetchMetrics *> *metrics;
+
+// Active fetch
+@property (nonatomic, assign, readwrite) NSInteger activeDataType;
+@property (nonatomic, strong, nullable) BleFetchDescriptor *active;
+@property (nonatomic, strong, nullable) NSMutableArray *activeBuffer;
+@property (nonatomic, strong, nullable) NSDictionary *lastPacket;
+@property (nonatomic, assign) CFAbsoluteTime startedAt;
+@property (nonatomic, assign) NSUInteger activePages;
+@property (nonatomic, assign) NSUInteger activeBytes;
+@property (nonatomic, assign) BOOL sawFirstByte;
+@property (nonatomic, strong, nullable) NSTimer *idleTimer;
+
+// Delete-all command written, waiting for the ring's reply (NSNotFound when none)
+@property (nonatomic, assign) NSInteger pendingDeleteType;
+
+@end
+
+@implementation BleFetchEngine
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _descriptors = [NSMutableDictionary dictionary];
+        _packetDescriptors = [NSMutableDictionary dictionary];
+        _buffers = [NSMutableDictionary dictionary];
+        _metrics = [NSMutableDictionary dictionary];
+        _activeDataType = NSNotFound;
+        _pendingDeleteType = NSNotFound;
+    }
+    return self;
+}
+
+- (void)registerDescriptor:(BleFetchDescriptor *)descriptor {
+    NSNumber *key = @(descriptor.dataType);
+    self.descriptors[key] = descriptor;
+    NSNumber *packetKey = @(descriptor.packetDataType);
+    if (!self.packetDescriptors[packetKey]) {
+        self.packetDescriptors[packetKey] = [NSMutableArray array];
+    }
+    [self.packetDescriptors[packetKey] addObject:descriptor];
+    self.buffers[key] = [NSMutableArray arrayWithCapacity:kInitialBufferCapacity];
+    self.metrics[key] = [[BleFetchMetrics alloc] init];
+}
+
+- (BOOL)handlesDataType:(NSInteger)dataType {
+    return self.descriptors[@(dataType)] != nil;
+}
+
+
+- (void)log:(NSString *)message {
+    [self.delegate fetchEngine:self log:message];
+}
+
+#pragma mark - Lifecycle
+
+- (BOOL)startFetchForDataType:(NSInteger)dataType {
+    BleFetchDescriptor *descriptor = self.descriptors[@(dataType)];
+    if (!descriptor) {
+        return NO;
+    }
+    NSData *cmd = descriptor.commandForMode(0);
+    if (!cmd) {
+        return NO;
+    }
+
+    // A fetch still open here was orphaned by the bridge; count it as cancelled
+    [self abortWithReason:BleFetchAbortCancelled];
+
+    self.active = descriptor;
+    self.activeDataType = dataType;
+    self.activeBuffer = self.buffers[@(dataType)];
+    [self.activeBuffer removeAllObjects];
+    self.lastPacket = nil;
+    self.activePages = 0;
+    self.activeBytes = 0;
+    self.sawFirstByte = NO;
+    self.startedAt = CFAbsoluteTimeGetCurrent();
+    self.metrics[@(dataType)].fetches += 1;
+
+    [self.delegate fetchEngine:self writeCommand:cmd];
+    return YES;
+}
+
+- (BOOL)handlePacketForDataType:(NSInteger)dataType
+                        dicData:(NSDictionary *)dicData
+                        dataEnd:(BOOL)dataEnd {
+    BleFetchDescriptor *descriptor = self.active;
+    if (!descriptor || descriptor.packetDataType != dataType) {
+        return [self handleIdlePacketForDataType:dataType];
+    }
+
+    [self noteFirstByte];
+    NSUInteger received = [self appendRecordsFrom:dicData descriptor:descriptor];
+    self.activePages += 1;
+    self.lastPacket = dicData;
+
+    NSUInteger total = self.activeBuffer.count;
+    switch (descriptor.endDetection) {
+        case BleFetchEndOnDataEnd:
+            if (dataEnd) {
+                [self finishActiveFetchByIdle:NO];
+            } else {
+                [self requestNextPage];
+            }
+            break;
+
+        case BleFetchEndOnShortPage:
+            if (dataEnd || received < descriptor.pageSize) {
+                [self finishActiveFetchByIdle:NO];
+            } else {
+                [self requestNextPage];
+            }
+            break;
+
+        case BleFetchEndOnDataEndOrIdle:
+            if (dataEnd) {
+                [self finishActiveFetchByIdle:NO];
+            } else {
+                if (total > 0 && total % descriptor.pageSize == 0) {
+                    // Full page — ask for the next one; the ring answers with more data or dataEnd
+                    [self log:[NSString stringWithFormat:@"%@ page complete (%lu records) - requesting next page",
+                               descriptor.name, (unsigned long)total]];
+                    [self requestNextPage];
+                }
+                // Some firmware goes silent instead of sending dataEnd
+                [self armIdleTimer];
+            }
+            break;
+    }
+    return YES;
+}
+
+/// A packet no fetch in flight asked for. Several descriptors can share its type (X3 SpO2 and
+/// continuous SpO2), so each one is checked rather than whichever registered last.
+- (BOOL)handleIdlePacketForDataType:(NSInteger)dataType {
+    NSArray<BleFetchDescriptor *> *sharing = self.packetDescriptors[@(dataType)];
+    if (sharing.count == 0) {
+        return NO;
+    }
+    for (BleFetchDescriptor *descriptor in sharing) {
+        if (descriptor.dataType == self.pendingDeleteType) {
+            // The ring answers a delete-all with one packet of the type it cleared
+            self.pendingDeleteType = NSNotFound;
+            [self log:[NSString stringWithFormat:@"%@ delete-all acknowledged", descriptor.name]];
+            [self.delegate fetchEngine:self didDeleteDataType:descriptor.dataType];
+            return YES;
+        }
+    }
+    for (BleFetchDescriptor *descriptor in sharing) {
+        if (descriptor.streamsWhenIdle) {
+            return NO;
+        }
+    }
+    // Late page from a fetch that already finished, timed out or was cancelled
+    NSString *names = [[sharing valueForKey:@"name"] componentsJoinedByString:@" / "];
+    [self log:[NSString stringWithFormat:@"%@ pagination stopped - no pending request", names]];
+    return YES;
+}
+
+- (NSUInteger)appendRecordsFrom:(NSDictionary *)dicData descriptor:(BleFetchDescriptor *)descriptor {
+    if (!dicData) {
+        return 0;
+    }
+    if (descriptor.payloadKeys.count == 0) {
+        [self.activeBuffer addObject:dicData];
+        return 1;
+    }
+    for (NSString *key in descriptor.payloadKeys) {
+        id items = dicData[key];
+        if ([items isKindOfClass:[NSArray class]]) {
+            [self.activeBuffer addObjectsFromArray:items];
+            return [items count];
+        }
+    }
+    return 0;
+}
+
+- (void)requestNextPage {
+    NSData *cmd = self.active.commandForMode(2);
+    if (cmd) {
+        [self.delegate fetchEngine:self writeCommand:cmd];
+    }
+}
+
+- (void)recordBytes:(NSUInteger)length {
+    if (self.active) {
+        [self noteFirstByte];
+        self.activeBytes += length;
+    }
+}
+
+/// Time from the mode-0 write to the first notification: radio + ring latency, before any paging.
+- (void)noteFirstByte {
+    if (self.sawFirstByte) {
+        return;
+    }
+    self.sawFirstByte = YES;
+    BleFetchMetrics *m = self.metrics[@(self.activeDataType)];
+    BleLatencyHistogramRecord(&m->ttfb, (CFAbsoluteTimeGetCurrent() - self.startedAt) * 1000.0);
+}
+
+- (void)finishActiveFetchByIdle:(BOOL)byIdle {
+    BleFetchDescriptor *descriptor = self.active;
+    if (!descriptor) {
+        return;
+    }
+    [self invalidateIdleTimer];
+
+    NSArray *records = [self.activeBuffer copy];
+    NSDictionary *lastPacket = self.lastPacket;
+    double ms = [self closeActiveFetch];
+
+    BleFetchMetrics *m = self.metrics[@(descriptor.dataType)];
+    m.completed += 1;
+    m.records += records.count;
+    m.lastMs = ms;
+    m.totalMs += ms;
+    m.maxMs = MAX(m.maxMs, ms);
+    BleLatencyHistogramRecord(&m->duration, ms);
+    if (byIdle) {
+        m.idleEnds += 1;
+    }
+
+    [self log:[NSString stringWithFormat:@"%@ fetch complete%@: %lu records in %.0f ms",
+               descriptor.name, byIdle ? @" (idle)" : @"", (unsigned long)records.count, ms]];
+
+    NSDictionary *result = descriptor.finish ? descriptor.finish(records, lastPacket) : @{@"data": records};
+    [self.delegate fetchEngine:self didFinishDataType:descriptor.dataType result:result];
+}
+
+- (void)abortWithReason:(BleFetchAbortReason)reason {
+    // An unanswered delete is dropped too; a late reply is then logged as a stray page
+    self.pendingDeleteType = NSNotFound;
+    BleFetchDescriptor *descriptor = self.active;
+    if (!descriptor) {
+        return;
+    }
+    [self invalidateIdleTimer];
+    [self closeActiveFetch];
+
+    BleFetchMetrics *m = self.metrics[@(descriptor.dataType)];
+    switch (reason) {
+        case BleFetchAbortTimeout:      m.timeouts += 1; break;
+        case BleFetchAbortCancelled:    m.cancels += 1; break;
+        case BleFetchAbortError:        m.errors += 1; break;
+        case BleFetchAbortDisconnected: m.disconnects += 1; break;
+    }
+}
+
+/// Folds pages/bytes into metrics, empties the reusable buffer and returns elapsed ms.
+- (double)closeActiveFetch {
+    BleFetchMetrics *m = self.metrics[@(self.activeDataType)];
+    m.pages += self.activePages;
+    m.bytes += self.activeBytes;
+    double ms = (CFAbsoluteTimeGetCurrent() - self.startedAt) * 1000.0;
+
+    [self.activeBuffer removeAllObjects];
+    self.active = nil;
+    self.activeBuffer = nil;
+    self.lastPacket = nil;
+    self.activeDataType = NSNotFound;
+    return ms;
+}
+
+#pragma mark - Idle timer
+
+- (void)armIdleTimer {
+    [self invalidateIdleTimer];
+    self.idleTimer = [NSTimer scheduledTimerWithTimeInterval:self.active.idleTimeout
+                                                      target:self
+                                                    selector:@selector(idleTimerFired:)
+                                                    userInfo:nil
+                                                     repeats:NO];
+}
+
+- (void)invalidateIdleTimer {
+    if (self.idleTimer) {
+        [self.idleTimer invalidate];
+        self.idleTimer = nil;
+    }
+}
+
+- (void)idleTimerFired:(NSTimer *)timer {
+    (void)timer;
+    self.idleTimer = nil;
+    [self finishActiveFetchByIdle:YES];
+}
+
+#pragma mark - Delete
+
+- (NSData *)deleteCommandForDataType:(NSInteger)dataType {
+    BleFetchDescriptor *descriptor = self.descriptors[@(dataType)];
+    if (!descriptor) {
+        return nil;
+    }
+    NSData *cmd = descriptor.commandForMode(BleFetchModeDeleteAll);
+    if (cmd) {
+        self.pendingDeleteType = dataType;
+        self.metrics[@(dataType)].deletes += 1;
+        [self log:[NSString stringWithFormat:@"%@ delete-all command issued", descriptor.name]];
+    }
+    return cmd;
+}
+
+#pragma mark - Metrics
+
+- (NSDictionary<NSString *, NSDictionary *> *)metricsSnapshot {
+    NSMutableDictionary *out = [NSMutableDictionary dictionaryWithCapacity:self.metrics.count];
+    [self.metrics enumerateKeysAndObjectsUsingBlock:^(NSNumber *key, BleFetchMetrics *m, BOOL *stop) {
+        if (m.fetches == 0 && m.deletes == 0) {
+            return;
+        }
+        out[self.descriptors[key].name] = @{
+            @"fetches": @(m.fetches),
+            @"completed": @(m.completed),
+            @"pages": @(m.pages),
+            @"records": @(m.records),
+            @"bytes": @(m.bytes),
+            @"lastMs": @(round(m.lastMs)),
+            @"avgMs": @(m.completed > 0 ? round(m.totalMs / m.completed) : 0),
+            @"maxMs": @(round(m.maxMs)),
+            @"idleEnds": @(m.idleEnds),
+            @"timeouts": @(m.timeouts),
+            @"cancels": @(m.cancels),
+            @"errors": @(m.errors),
+            @"disconnects": @(m.disconnects),
+            @"deletes": @(m.deletes),
+            @"ttfbMs": BleLatencyHistogramSnapshot(&m->ttfb),
+            @"durationMs": BleLatencyHistogramSnapshot(&m->duration),
+        };
+    }];
+    return out;
+}
+
+- (void)resetMetrics {
+    for (NSNumber *key in self.descriptors) {
+        self.metrics[key] = [[BleFetchMetrics alloc] init];
+    }
+}
+
+@end
@@ -0,0 +1,300 @@
+//
+//  BleLog.c
+//  SmartRing
+//
+
+#include "BleLog.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLE_LOG_LEVELS BleLogLevelOff
+
+typedef struct {
+    // Producer claims the slot when seq == position, publishes with seq = position + 1;
+    // the consumer frees it for the next lap with seq = position + capacity
+    _Atomic size_t seq;
+    double timestampMs;
+    uint16_t length;
+    uint8_t level;
+    char text[BLE_LOG_MAX_TEXT];
+} BleLogCell;
+
+struct BleLog {
+    BleLogCell *cells;
+    size_t mask;
+    _Atomic size_t enqueuePos;
+    size_t dequeuePos;      // consumer only
+
+    _Atomic int level;
+    _Atomic uint32_t sampleEvery[BLE_LOG_LEVELS];
+    _Atomic uint32_t sampleCounter[BLE_LOG_LEVELS];
+
+    _Atomic uint64_t appended;
+    _Atomic uint64_t dropped;
+    _Atomic uint64_t droppedSinceDrain;
+    _Atomic uint64_t sampledOut;
+    _Atomic uint64_t drained;
+    _Atomic uint64_t batches;
+};
+
+BleLog *BleLogCreate(uint32_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    BleLog *log = calloc(1, sizeof(BleLog));
+    if (!log) {
+        return NULL;
+    }
+    log->cells = calloc(size, sizeof(BleLogCell));
+    if (!log->cells) {
+        free(log);
+        return NULL;
+    }
+    log->mask = size - 1;
+    for (size_t i = 0; i < size; i++) {
+        atomic_init(&log->cells[i].seq, i);
+    }
+    atomic_init(&log->enqueuePos, 0);
+    atomic_init(&log->level, BleLogLevelInfo);
+    return log;
+}
+
+void BleLogDestroy(BleLog *log) {
+    if (!log) {
+        return;
+    }
+    free(log->cells);
+    free(log);
+}
+
+void BleLogSetLevel(BleLog *log, BleLogLevel level) {
+    atomic_store_explicit(&log->level, (int)level, memory_order_relaxed);
+}
+
+BleLogLevel BleLogGetLevel(const BleLog *log) {
+    return (BleLogLevel)atomic_load_explicit(&((BleLog *)log)->level, memory_order_relaxed);
+}
+
+void BleLogSetSampleEvery(BleLog *log, BleLogLevel level, uint32_t every) {
+    if (level >= BLE_LOG_LEVELS) {
+        return;
+    }
+    atomic_store_explicit(&log->sampleEvery[level], every, memory_order_relaxed);
+}
+
+bool BleLogWants(BleLog *log, BleLogLevel level) {
+    if (!log || level >= BLE_LOG_LEVELS ||
+        (int)level < atomic_load_explicit(&log->level, memory_order_relaxed)) {
+        return false;
+    }
+    uint32_t every = atomic_load_explicit(&log->sampleEvery[level], memory_order_relaxed);
+    if (every > 1 &&
+        atomic_fetch_add_explicit(&log->sampleCounter[level], 1, memory_order_relaxed) % every != 0) {
+        atomic_fetch_add_explicit(&log->sampledOut, 1, memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+// Longest prefix of at most `max` bytes that doesn't end inside a multi-byte character
+static size_t BleLogClampUtf8(const char *utf8, size_t length, size_t max) {
+    if (length <= max) {
+        return length;
+    }
+    size_t cut = max;
+    while (cut > 0 && ((unsigned char)utf8[cut] & 0xC0) == 0x80) {
+        cut--;
+    }
+    return cut;
+}
+
+bool BleLogAppend(BleLog *log, BleLogLevel level, double timestampMs, const char *utf8, size_t length) {
+    if (!log) {
+        return false;
+    }
+    size_t pos = atomic_load_explicit(&log->enqueuePos, memory_order_relaxed);
+    BleLogCell *cell;
+    for (;;) {
+        cell = &log->cells[pos & log->mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&log->enqueuePos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full: the consumer hasn't freed this slot from the previous lap
+            atomic_fetch_add_explicit(&log->dropped, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&log->droppedSinceDrain, 1, memory_order_relaxed);
+            return false;
+        } else {
+            pos = atomic_load_explicit(&log->enqueuePos, memory_order_relaxed);
+        }
+    }
+
+    size_t n = utf8 ? BleLogClampUtf8(utf8, length, BLE_LOG_MAX_TEXT) : 0;
+    if (n > 0) {
+        memcpy(cell->text, utf8, n);
+    }
+    cell->length = (uint16_t)n;
+    cell->level = (uint8_t)level;
+    cell->timestampMs = timestampMs;
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+    atomic_fetch_add_explicit(&log->appended, 1, memory_order_relaxed);
+    return true;
+}
+
+static void BleLogPut16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void BleLogPut32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static void BleLogPut64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint16_t BleLogGet16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t BleLogGet32(const uint8_t *p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        v |= (uint32_t)p[i] << (8 * i);
+    }
+    return v;
+}
+
+static uint64_t BleLogGet64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v |= (uint64_t)p[i] << (8 * i);
+    }
+    return v;
+}
+
+size_t BleLogDrain(BleLog *log, uint8_t *out, size_t capacity, uint32_t *count) {
+    *count = 0;
+    if (!log || capacity < BLE_LOG_HEADER_BYTES + BLE_LOG_ENTRY_HEADER_BYTES) {
+        return 0;
+    }
+    size_t used = BLE_LOG_HEADER_BYTES;
+    double baseMs = 0;
+    uint32_t n = 0;
+
+    for (;;) {
+        size_t pos = log->dequeuePos;
+        BleLogCell *cell = &log->cells[pos & log->mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        if ((intptr_t)seq - (intptr_t)(pos + 1) < 0) {
+            break;  // empty, or the next producer hasn't published yet
+        }
+        // Peek before consuming: an entry that doesn't fit stays for the next batch
+        if (used + BLE_LOG_ENTRY_HEADER_BYTES + cell->length > capacity) {
+            break;
+        }
+        if (n == 0) {
+            baseMs = cell->timestampMs;
+        }
+        double offset = round(cell->timestampMs - baseMs);
+        offset = fmax(fmin(offset, (double)INT32_MAX), (double)INT32_MIN);
+        uint8_t *p = out + used;
+        BleLogPut32(p, (uint32_t)(int32_t)offset);
+        p[4] = cell->level;
+        BleLogPut16(p + 5, cell->length);
+        memcpy(p + BLE_LOG_ENTRY_HEADER_BYTES, cell->text, cell->length);
+        used += BLE_LOG_ENTRY_HEADER_BYTES + cell->length;
+        n++;
+
+        log->dequeuePos = pos + 1;
+        atomic_store_explicit(&cell->seq, pos + log->mask + 1, memory_order_release);
+    }
+
+    uint64_t dropped = atomic_exchange_explicit(&log->droppedSinceDrain, 0, memory_order_relaxed);
+    if (n == 0 && dropped == 0) {
+        return 0;
+    }
+    uint64_t baseBits;
+    memcpy(&baseBits, &baseMs, sizeof(baseBits));
+    BleLogPut32(out, BLE_LOG_MAGIC);
+    BleLogPut16(out + 4, BLE_LOG_VERSION);
+    BleLogPut16(out + 6, 0);
+    BleLogPut32(out + 8, n);
+    BleLogPut32(out + 12, dropped > UINT32_MAX ? UINT32_MAX : (uint32_t)dropped);
+    BleLogPut64(out + 16, baseBits);
+
+    atomic_fetch_add_explicit(&log->drained, n, memory_order_relaxed);
+    atomic_fetch_add_explicit(&log->batches, 1, memory_order_relaxed);
+    *count = n;
+    return used;
+}
+
+bool BleLogBatchNext(const uint8_t *batch, size_t length, size_t *offset, BleLogEntry *entry) {
+    if (length < BLE_LOG_HEADER_BYTES || BleLogGet32(batch) != BLE_LOG_MAGIC ||
+        BleLogGet16(batch + 4) != BLE_LOG_VERSION) {
+        return false;
+    }
+    if (*offset < BLE_LOG_HEADER_BYTES) {
+        *offset = BLE_LOG_HEADER_BYTES;
+    }
+    if (*offset + BLE_LOG_ENTRY_HEADER_BYTES > length) {
+        return false;
+    }
+    const uint8_t *p = batch + *offset;
+    uint16_t n = BleLogGet16(p + 5);
+    if (*offset + BLE_LOG_ENTRY_HEADER_BYTES + n > length) {
+        return false;
+    }
+    uint64_t baseBits = BleLogGet64(batch + 16);
+    double baseMs;
+    memcpy(&baseMs, &baseBits, sizeof(baseMs));
+
+    entry->timestampMs = baseMs + (int32_t)BleLogGet32(p);
+    entry->level = (BleLogLevel)p[4];
+    entry->length = n;
+    entry->text = (const char *)p + BLE_LOG_ENTRY_HEADER_BYTES;
+    *offset += BLE_LOG_ENTRY_HEADER_BYTES + n;
+    return true;
+}
+
+BleLogStats BleLogGetStats(BleLog *log) {
+    BleLogStats stats;
+    stats.appended = atomic_load_explicit(&log->appended, memory_order_relaxed);
+    stats.dropped = atomic_load_explicit(&log->dropped, memory_order_relaxed);
+    stats.sampledOut = atomic_load_explicit(&log->sampledOut, memory_order_relaxed);
+    stats.drained = atomic_load_explicit(&log->drained, memory_order_relaxed);
+    stats.batches = atomic_load_explicit(&log->batches, memory_order_relaxed);
+    return stats;
+}
+
+void BleLogResetStats(BleLog *log) {
+    atomic_store_explicit(&log->appended, 0, memory_order_relaxed);
+    atomic_store_explicit(&log->dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&log->sampledOut, 0, memory_order_relaxed);
+    atomic_store_explicit(&log->drained, 0, memory_order_relaxed);
+    atomic_store_explicit(&log->batches, 0, memory_order_relaxed);
+}
+
+const char *BleLogLevelName(BleLogLevel level) {
+    switch (level) {
+        case BleLogLevelDebug: return "debug";
+        case BleLogLevelInfo: return "info";
+        case BleLogLevelWarn: return "warn";
+        case BleLogLevelError: return "error";
+        case BleLogLevelOff: return "off";
+    }
+    return "unknown";
+}
@@ -0,0 +1,99 @@
+//
+//  BleLog.h
+//  SmartRing
+//
+//  Log buffer behind both bridges' debug logging.
+//
+//  Plain C11 like BleReconnectPolicy, so the hot path can be benchmarked on any
+//  host. Producers (CoreBluetooth callbacks, the fetch engine, RN method queue)
+//  append without taking a lock: a bounded multi-producer ring where each slot
+//  carries its own sequence number. When the ring is full the entry is counted
+//  as dropped instead of blocking the BLE thread. One consumer drains the ring
+//  into a binary batch for the JS bridge.
+//
+//  Call BleLogWants() before formatting anything: a level below the threshold
+//  (or an entry that loses the sampling draw) costs one atomic load and a
+//  compare, with no string built.
+//
+//  Batch layout (little-endian):
+//    header  u32 magic 'BLOG'  u16 version  u16 reserved
+//            u32 count  u32 dropped (since the previous batch)  f64 baseMs
+//    entry   i32 offsetMs (from baseMs)  u8 level  u16 length  length bytes of UTF-8
+//
+
+#ifndef BleLog_h
+#define BleLog_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    BleLogLevelDebug = 0,
+    BleLogLevelInfo,
+    BleLogLevelWarn,
+    BleLogLevelError,
+    BleLogLevelOff,     // threshold only: nothing is logged
+} BleLogLevel;
+
+#define BLE_LOG_MAGIC 0x474F4C42u   // "BLOG"
+#define BLE_LOG_VERSION 1
+#define BLE_LOG_HEADER_BYTES 24
+#define BLE_LOG_ENTRY_HEADER_BYTES 7
+/// Longer messages are cut on a UTF-8 character boundary.
+#define BLE_LOG_MAX_TEXT 192
+
+typedef struct BleLog BleLog;
+
+typedef struct {
+    uint64_t appended;
+    uint64_t dropped;       // ring full
+    uint64_t sampledOut;    // passed the level, lost the sampling draw
+    uint64_t drained;
+    uint64_t batches;
+} BleLogStats;
+
+typedef struct {
+    BleLogLevel level;
+    double timestampMs;
+    const char *text;       // not NUL-terminated; points into the batch
+    uint16_t length;
+} BleLogEntry;
+
+/// `capacity` is rounded up to a power of two. Starts at BleLogLevelInfo, unsampled.
+BleLog *BleLogCreate(uint32_t capacity);
+void BleLogDestroy(BleLog *log);
+
+void BleLogSetLevel(BleLog *log, BleLogLevel level);
+BleLogLevel BleLogGetLevel(const BleLog *log);
+/// Keep one entry in `every` at `level`; 0 or 1 keeps all.
+void BleLogSetSampleEvery(BleLog *log, BleLogLevel level, uint32_t every);
+
+/// Whether an entry at `level` should be formatted and appended. NULL-safe.
+bool BleLogWants(BleLog *log, BleLogLevel level);
+
+/// Enqueue one entry, without the level/sampling check (call BleLogWants first).
+/// Returns false if the ring is full.
+bool BleLogAppend(BleLog *log, BleLogLevel level, double timestampMs, const char *utf8, size_t length);
+
+/// Single consumer: move as many entries as fit in `capacity` bytes into a batch at
+/// `out`. Returns the bytes written (0 when there was nothing to drain) and sets *count.
+size_t BleLogDrain(BleLog *log, uint8_t *out, size_t capacity, uint32_t *count);
+
+/// Walk a batch: start with *offset = 0; returns false at the end or on a malformed batch.
+bool BleLogBatchNext(const uint8_t *batch, size_t length, size_t *offset, BleLogEntry *entry);
+
+BleLogStats BleLogGetStats(BleLog *log);
+void BleLogResetStats(BleLog *log);
+
+const char *BleLogLevelName(BleLogLevel level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BleLog_h */
@@ -0,0 +1,58 @@
+//
+//  BleLogQueue.h
+//  SmartRing
+//
+//  Debug logging for JstyleBridge (X3) and V8Bridge on top of BleLog.
+//
+//  Logging only appends to the lock-free ring; nothing is sent to JS or the
+//  system log on the calling thread. A private serial queue drains the ring
+//  flushInterval after the first pending entry, echoes each entry to os_log and
+//  hands the whole batch to batchHandler, which the bridges send as one
+//  onDebugLog / V8DebugLog event.
+//
+//  Use BLE_LOG for formatted messages so the format arguments are only evaluated
+//  when the level (and sampling) lets the entry through.
+//
+
+#import <Foundation/Foundation.h>
+#import "BleLog.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Called on the log queue. `dropped`: entries lost to a full ring since the last batch.
+typedef void (^BleLogBatchHandler)(NSData *batch, NSUInteger count, NSUInteger dropped);
+
+@interface BleLogQueue : NSObject
+
+/// Debug level in DEBUG builds, Info otherwise; no sampling; 0.5 s flush interval.
+- (instancetype)initWithName:(NSString *)name batchHandler:(BleLogBatchHandler)handler NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, readonly) BleLog *core;
+@property (nonatomic, assign) NSTimeInterval flushInterval;
+
+/// Level and sampling checked here; for messages that are already built.
+- (void)log:(BleLogLevel)level message:(NSString *)message;
+/// No level check: call through BLE_LOG, which has already asked BleLogWants.
+- (void)append:(BleLogLevel)level format:(NSString *)format, ... NS_FORMAT_FUNCTION(2, 3);
+
+/// { level: 'debug'|'info'|'warn'|'error'|'off', sample: { debug: n, ... }, flushIntervalMs }
+/// Missing keys keep their current value.
+- (void)configure:(NSDictionary *)options;
+/// Drain now (stream stopped, app backgrounding) instead of waiting for the interval.
+- (void)flush;
+
+/// { level, appended, dropped, sampledOut, drained, batches }
+- (NSDictionary *)snapshot;
+- (void)resetMetrics;
+
+@end
+
+#define BLE_LOG(queue, lvl, ...) do { \
+    BleLogQueue *bleLogQueue_ = (queue); \
+    if (BleLogWants(bleLogQueue_.core, (lvl))) { \
+        [bleLogQueue_ append:(lvl) format:__VA_ARGS__]; \
+    } \
+} while (0)
+
+NS_ASSUME_NONNULL_END
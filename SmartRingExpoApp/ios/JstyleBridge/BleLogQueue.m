@@ -0,0 +1,175 @@
+//
+//  BleLogQueue.m
+//  SmartRing
+//
+
+#import "BleLogQueue.h"
+#import <os/log.h>
+#import <stdatomic.h>
+
+// Ring slots (~220 KB); draining every flushInterval keeps it far from full
+static const uint32_t kBleLogCapacity = 1024;
+static const size_t kBleLogBatchBytes = 16 * 1024;
+
+static NSArray<NSString *> *BleLogLevelNames(void) {
+    return @[@"debug", @"info", @"warn", @"error", @"off"];
+}
+
+static BleLogLevel BleLogLevelFromName(NSString *name, BleLogLevel fallback) {
+    NSUInteger index = [BleLogLevelNames() indexOfObject:name.lowercaseString];
+    return index == NSNotFound ? fallback : (BleLogLevel)index;
+}
+
+@interface BleLogQueue ()
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) BleLogBatchHandler handler;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) os_log_t osLog;
+@end
+
+@implementation BleLogQueue {
+    BleLog *_core;
+    atomic_bool _drainScheduled;
+}
+
+- (instancetype)initWithName:(NSString *)name batchHandler:(BleLogBatchHandler)handler {
+    if (self = [super init]) {
+        _name = [name copy];
+        _handler = [handler copy];
+        _core = BleLogCreate(kBleLogCapacity);
+        atomic_init(&_drainScheduled, false);
+        _flushInterval = 0.5;
+        NSString *label = [NSString stringWithFormat:@"com.smartring.log.%@", name];
+        _queue = dispatch_queue_create(label.UTF8String, DISPATCH_QUEUE_SERIAL);
+        _osLog = os_log_create("com.smartring.ble", name.UTF8String);
+#if DEBUG
+        BleLogSetLevel(_core, BleLogLevelDebug);
+#else
+        BleLogSetLevel(_core, BleLogLevelInfo);
+#endif
+    }
+    return self;
+}
+
+- (void)dealloc {
+    BleLogDestroy(_core);
+}
+
+- (BleLog *)core {
+    return _core;
+}
+
+- (void)log:(BleLogLevel)level message:(NSString *)message {
+    if (BleLogWants(_core, level)) {
+        [self enqueue:level message:message];
+    }
+}
+
+- (void)append:(BleLogLevel)level format:(NSString *)format, ... {
+    va_list args;
+    va_start(args, format);
+    NSString *message = [[NSString alloc] initWithFormat:format arguments:args];
+    va_end(args);
+    [self enqueue:level message:message];
+}
+
+- (void)enqueue:(BleLogLevel)level message:(NSString *)message {
+    // Whole characters only, straight into a stack buffer: no UTF8String allocation
+    char buffer[BLE_LOG_MAX_TEXT];
+    NSUInteger used = 0;
+    [message getBytes:buffer
+            maxLength:sizeof(buffer)
+           usedLength:&used
+             encoding:NSUTF8StringEncoding
+              options:0
+                range:NSMakeRange(0, message.length)
+       remainingRange:NULL];
+    BleLogAppend(_core, level, [[NSDate date] timeIntervalSince1970] * 1000.0, buffer, used);
+    [self scheduleDrain];
+}
+
+- (void)scheduleDrain {
+    // Only the first entry of a batch pays for dispatch_after
+    if (atomic_exchange_explicit(&_drainScheduled, true, memory_order_acq_rel)) {
+        return;
+    }
+    __weak BleLogQueue *weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.flushInterval * NSEC_PER_SEC)), self.queue, ^{
+        [weakSelf drain];
+    });
+}
+
+- (void)flush {
+    __weak BleLogQueue *weakSelf = self;
+    dispatch_async(self.queue, ^{
+        [weakSelf drain];
+    });
+}
+
+// Log queue only
+- (void)drain {
+    // Cleared first: an entry appended while draining schedules the next pass
+    atomic_store_explicit(&_drainScheduled, false, memory_order_release);
+    NSMutableData *buffer = [NSMutableData dataWithLength:kBleLogBatchBytes];
+    for (;;) {
+        uint32_t count = 0;
+        size_t bytes = BleLogDrain(_core, buffer.mutableBytes, buffer.length, &count);
+        if (bytes == 0) {
+            break;
+        }
+        NSData *batch = [NSData dataWithBytes:buffer.bytes length:bytes];
+        [self echo:batch];
+        uint32_t dropped = 0;
+        [batch getBytes:&dropped range:NSMakeRange(12, sizeof(dropped))];
+        self.handler(batch, count, CFSwapInt32LittleToHost(dropped));
+    }
+}
+
+- (void)echo:(NSData *)batch {
+    size_t offset = 0;
+    BleLogEntry entry;
+    while (BleLogBatchNext(batch.bytes, batch.length, &offset, &entry)) {
+        os_log_type_t type = entry.level >= BleLogLevelError ? OS_LOG_TYPE_ERROR
+            : entry.level == BleLogLevelDebug ? OS_LOG_TYPE_DEBUG
+            : OS_LOG_TYPE_INFO;
+        os_log_with_type(self.osLog, type, "%{public}.*s", (int)entry.length, entry.text);
+    }
+}
+
+- (void)configure:(NSDictionary *)options {
+    NSString *level = options[@"level"];
+    if ([level isKindOfClass:[NSString class]]) {
+        BleLogSetLevel(_core, BleLogLevelFromName(level, BleLogGetLevel(_core)));
+    }
+    NSDictionary *sample = options[@"sample"];
+    if ([sample isKindOfClass:[NSDictionary class]]) {
+        [sample enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSNumber *every, BOOL *stop) {
+            BleLogLevel sampled = BleLogLevelFromName(key, BleLogLevelOff);
+            if (sampled != BleLogLevelOff && [every isKindOfClass:[NSNumber class]]) {
+                BleLogSetSampleEvery(self->_core, sampled, (uint32_t)MAX(0, every.intValue));
+            }
+        }];
+    }
+    NSNumber *intervalMs = options[@"flushIntervalMs"];
+    if ([intervalMs isKindOfClass:[NSNumber class]]) {
+        self.flushInterval = MAX(0, intervalMs.doubleValue) / 1000.0;
+    }
+}
+
+- (NSDictionary *)snapshot {
+    BleLogStats stats = BleLogGetStats(_core);
+    return @{
+        @"level": BleLogLevelNames()[BleLogGetLevel(_core)],
+        @"appended": @(stats.appended),
+        @"dropped": @(stats.dropped),
+        @"sampledOut": @(stats.sampledOut),
+        @"drained": @(stats.drained),
+        @"batches": @(stats.batches),
+    };
+}
+
+- (void)resetMetrics {
+    BleLogResetStats(_core);
+}
+
+@end
@@ -0,0 +1,56 @@
+//
+//  BleRealtimeCoalescer.h
+//  SmartRing
+//
+//  Turns the ring's realtime packets (steps / HR / calories / distance / temperature)
+//  into frames for the JS bridge, shared by JstyleBridge (X3) and V8Bridge.
+//
+//  Packets arriving within one frame period are merged (latest value per field
+//  wins) and sent as a single frame, at most rateHz frames per second; rate 0
+//  sends every packet as its own frame. With deltas on, a frame carries only the
+//  fields that changed since the previous frame, plus a full keyframe every
+//  keyframeInterval so a listener that attached late catches up. A frame with
+//  no changes is not sent at all.
+//
+//  Every frame has three meta fields next to the data:
+//    seq       — increments per frame
+//    keyframe  — YES when the frame holds every field (replace, don't merge)
+//    packets   — ring packets merged into this frame
+//
+//  Main queue only, like the CoreBluetooth callbacks that feed it; snapshot is
+//  safe from any queue.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void (^BleRealtimeFrameHandler)(NSDictionary *frame);
+
+@interface BleRealtimeCoalescer : NSObject
+
+/// Default 4 Hz with deltas: what the realtime screens render.
+- (instancetype)initWithFrameHandler:(BleRealtimeFrameHandler)handler NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Frames per second; 0 = one frame per packet (full rate, for recording).
+@property (nonatomic, assign) double rateHz;
+@property (nonatomic, assign) BOOL deltas;
+@property (nonatomic, assign) NSTimeInterval keyframeInterval;
+
+- (void)ingestPacket:(NSDictionary *)packet;
+/// Send whatever is pending now.
+- (void)flush;
+/// Drop pending fields and the last-sent state (stream stopped, disconnect); the next
+/// frame is a keyframe.
+- (void)reset;
+
+/// { rateHz, deltas, packets, frames, keyframes, merged, unchanged, fieldsIn, fieldsOut }
+/// merged: packets folded into a frame another packet opened. unchanged: frames not sent
+/// because no field changed. fieldsIn / fieldsOut: values received vs sent over the bridge.
+- (NSDictionary *)snapshot;
+- (void)resetMetrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
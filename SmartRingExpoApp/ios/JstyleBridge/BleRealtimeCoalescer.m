@@ -0,0 +1,196 @@
+//
+//  BleRealtimeCoalescer.m
+//  SmartRing
+//
+
+#import "BleRealtimeCoalescer.h"
+
+@interface BleRealtimeCoalescer ()
+@property (nonatomic, copy) BleRealtimeFrameHandler handler;
+@property (nonatomic, strong) NSMutableDictionary *pending;
+@property (nonatomic, assign) NSUInteger pendingPackets;
+/// Every field as last sent; what deltas are computed against.
+@property (nonatomic, strong) NSMutableDictionary *sent;
+@property (nonatomic, strong, nullable) NSTimer *frameTimer;
+@property (nonatomic, assign) CFAbsoluteTime lastFrameAt;
+@property (nonatomic, assign) CFAbsoluteTime lastKeyframeAt;
+@property (nonatomic, assign) BOOL needsKeyframe;
+@property (nonatomic, assign) NSUInteger seq;
+@end
+
+@implementation BleRealtimeCoalescer {
+    // Counters are written on the main queue and read from the bridge queue
+    NSLock *_lock;
+    NSUInteger _packets;
+    NSUInteger _frames;
+    NSUInteger _keyframes;
+    NSUInteger _merged;
+    NSUInteger _unchanged;
+    NSUInteger _fieldsIn;
+    NSUInteger _fieldsOut;
+}
+
+- (instancetype)initWithFrameHandler:(BleRealtimeFrameHandler)handler {
+    if (self = [super init]) {
+        _handler = [handler copy];
+        _lock = [[NSLock alloc] init];
+        _pending = [NSMutableDictionary dictionary];
+        _sent = [NSMutableDictionary dictionary];
+        _rateHz = 4;
+        _deltas = YES;
+        _keyframeInterval = 5.0;
+        _needsKeyframe = YES;
+    }
+    return self;
+}
+
+- (void)setRateHz:(double)rateHz {
+    _rateHz = MAX(0, rateHz);
+    // A pending frame may now be due sooner (or right away at full rate)
+    if (self.pendingPackets > 0) {
+        [self cancelTimer];
+        [self scheduleFrame];
+    }
+}
+
+- (void)setDeltas:(BOOL)deltas {
+    _deltas = deltas;
+    self.needsKeyframe = YES;
+}
+
+- (void)ingestPacket:(NSDictionary *)packet {
+    if (packet.count == 0) {
+        return;
+    }
+    [_lock lock];
+    _packets += 1;
+    _fieldsIn += packet.count;
+    if (self.pendingPackets > 0) {
+        _merged += 1;
+    }
+    [_lock unlock];
+
+    [self.pending addEntriesFromDictionary:packet];
+    self.pendingPackets += 1;
+    [self scheduleFrame];
+}
+
+- (void)scheduleFrame {
+    if (self.frameTimer) {
+        return;
+    }
+    NSTimeInterval period = self.rateHz > 0 ? 1.0 / self.rateHz : 0;
+    NSTimeInterval wait = self.lastFrameAt + period - CFAbsoluteTimeGetCurrent();
+    if (wait <= 0) {
+        // Leading edge: a packet after a quiet period goes out without delay
+        [self flush];
+        return;
+    }
+    self.frameTimer = [NSTimer scheduledTimerWithTimeInterval:wait
+                                                       target:self
+                                                     selector:@selector(frameTimerFired:)
+                                                     userInfo:nil
+                                                      repeats:NO];
+}
+
+- (void)frameTimerFired:(NSTimer *)timer {
+    self.frameTimer = nil;
+    [self flush];
+}
+
+- (void)flush {
+    [self cancelTimer];
+    if (self.pendingPackets == 0) {
+        return;
+    }
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    NSUInteger packets = self.pendingPackets;
+    BOOL keyframe = !self.deltas || self.needsKeyframe || now - self.lastKeyframeAt >= self.keyframeInterval;
+
+    NSMutableDictionary *frame;
+    if (keyframe) {
+        // The whole state, including fields the ring stopped repeating
+        [self.sent addEntriesFromDictionary:self.pending];
+        frame = [self.sent mutableCopy];
+    } else {
+        frame = [NSMutableDictionary dictionaryWithCapacity:self.pending.count + 3];
+        [self.pending enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+            if (![self.sent[key] isEqual:value]) {
+                frame[key] = value;
+            }
+        }];
+        [self.sent addEntriesFromDictionary:self.pending];
+    }
+    [self.pending removeAllObjects];
+    self.pendingPackets = 0;
+    self.lastFrameAt = now;
+
+    [_lock lock];
+    if (frame.count == 0) {
+        _unchanged += 1;
+        [_lock unlock];
+        return;
+    }
+    _frames += 1;
+    _fieldsOut += frame.count;
+    if (keyframe) {
+        _keyframes += 1;
+    }
+    [_lock unlock];
+
+    if (keyframe) {
+        self.lastKeyframeAt = now;
+        self.needsKeyframe = NO;
+    }
+    self.seq += 1;
+    frame[@"seq"] = @(self.seq);
+    frame[@"keyframe"] = @(keyframe);
+    frame[@"packets"] = @(packets);
+    self.handler(frame);
+}
+
+- (void)reset {
+    [self cancelTimer];
+    [self.pending removeAllObjects];
+    [self.sent removeAllObjects];
+    self.pendingPackets = 0;
+    self.needsKeyframe = YES;
+}
+
+- (void)cancelTimer {
+    if (self.frameTimer) {
+        [self.frameTimer invalidate];
+        self.frameTimer = nil;
+    }
+}
+
+- (NSDictionary *)snapshot {
+    [_lock lock];
+    NSDictionary *out = @{
+        @"rateHz": @(self.rateHz),
+        @"deltas": @(self.deltas),
+        @"packets": @(_packets),
+        @"frames": @(_frames),
+        @"keyframes": @(_keyframes),
+        @"merged": @(_merged),
+        @"unchanged": @(_unchanged),
+        @"fieldsIn": @(_fieldsIn),
+        @"fieldsOut": @(_fieldsOut),
+    };
+    [_lock unlock];
+    return out;
+}
+
+- (void)resetMetrics {
+    [_lock lock];
+    _packets = 0;
+    _frames = 0;
+    _keyframes = 0;
+    _merged = 0;
+    _unchanged = 0;
+    _fieldsIn = 0;
+    _fieldsOut = 0;
+    [_lock unlock];
+}
+
+@end
@@ -0,0 +1,133 @@
+//
+//  BleReconnectPolicy.c
+//  SmartRing
+//
+
+#include "BleReconnectPolicy.h"
+
+#include <math.h>
+
+BleReconnectConfig BleReconnectConfigDefault(void) {
+    BleReconnectConfig config;
+    config.baseMs = 2000;
+    config.maxMs = 5 * 60 * 1000;
+    config.multiplier = 2;
+    config.maxAttempts = 12;
+    return config;
+}
+
+void BleReconnectPolicyInit(BleReconnectPolicy *policy, const BleReconnectConfig *config, uint32_t seed, bool radioOn) {
+    policy->config = *config;
+    policy->state = BleReconnectStateIdle;
+    policy->failures = 0;
+    policy->rng = seed ? seed : 0x9e3779b9u;
+    policy->radioOn = radioOn;
+}
+
+// xorshift32 — deterministic for a given seed, good enough for jitter
+static double BleReconnectRandom(BleReconnectPolicy *policy) {
+    uint32_t x = policy->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    policy->rng = x;
+    return (double)x / 4294967296.0;
+}
+
+double BleReconnectPolicyBackoffMs(BleReconnectPolicy *policy, uint32_t failures) {
+    const BleReconnectConfig *c = &policy->config;
+    double exponent = failures > 0 ? (double)(failures - 1) : 0;
+    double ceiling = fmin(c->maxMs, c->baseMs * pow(c->multiplier, exponent));
+    return ceiling / 2 + BleReconnectRandom(policy) * ceiling / 2;
+}
+
+static BleReconnectAction BleReconnectMake(BleReconnectActionType type, double delayMs) {
+    BleReconnectAction action;
+    action.type = type;
+    action.delayMs = delayMs;
+    return action;
+}
+
+static BleReconnectAction BleReconnectConnectNow(BleReconnectPolicy *policy) {
+    if (!policy->radioOn) {
+        policy->state = BleReconnectStatePaused;
+        return BleReconnectMake(BleReconnectActionCancel, 0);
+    }
+    policy->state = BleReconnectStateConnecting;
+    return BleReconnectMake(BleReconnectActionConnect, 0);
+}
+
+BleReconnectAction BleReconnectPolicyHandle(BleReconnectPolicy *policy, BleReconnectEvent event) {
+    const BleReconnectAction none = BleReconnectMake(BleReconnectActionNone, 0);
+
+    switch (event) {
+        case BleReconnectEventStart:
+            policy->failures = 0;
+            return BleReconnectConnectNow(policy);
+
+        case BleReconnectEventConnected:
+            // Also covers connections the OS completed on its own (restored pending connects)
+            policy->state = BleReconnectStateConnected;
+            policy->failures = 0;
+            return BleReconnectMake(BleReconnectActionCancel, 0);
+
+        case BleReconnectEventLinkLost:
+            if (policy->state == BleReconnectStateIdle) {
+                return none;
+            }
+            return BleReconnectConnectNow(policy);
+
+        case BleReconnectEventConnectFailed: {
+            if (policy->state != BleReconnectStateConnecting) {
+                return none;
+            }
+            policy->failures += 1;
+            if (policy->config.maxAttempts > 0 && policy->failures >= policy->config.maxAttempts) {
+                policy->state = BleReconnectStateIdle;
+                return BleReconnectMake(BleReconnectActionCancel, 0);
+            }
+            policy->state = BleReconnectStateWaiting;
+            return BleReconnectMake(BleReconnectActionSchedule, BleReconnectPolicyBackoffMs(policy, policy->failures));
+        }
+
+        case BleReconnectEventTimerFired:
+            if (policy->state != BleReconnectStateWaiting) {
+                return none;
+            }
+            return BleReconnectConnectNow(policy);
+
+        case BleReconnectEventRadioOff:
+            policy->radioOn = false;
+            if (policy->state == BleReconnectStateIdle || policy->state == BleReconnectStatePaused) {
+                return none;
+            }
+            policy->state = BleReconnectStatePaused;
+            return BleReconnectMake(BleReconnectActionCancel, 0);
+
+        case BleReconnectEventRadioOn:
+            policy->radioOn = true;
+            if (policy->state != BleReconnectStatePaused) {
+                return none;
+            }
+            // A radio toggle isn't the ring's fault: start the budget over
+            policy->failures = 0;
+            return BleReconnectConnectNow(policy);
+
+        case BleReconnectEventStop:
+            policy->state = BleReconnectStateIdle;
+            policy->failures = 0;
+            return BleReconnectMake(BleReconnectActionCancel, 0);
+    }
+    return none;
+}
+
+const char *BleReconnectStateName(BleReconnectState state) {
+    switch (state) {
+        case BleReconnectStateIdle: return "idle";
+        case BleReconnectStateConnecting: return "connecting";
+        case BleReconnectStateConnected: return "connected";
+        case BleReconnectStateWaiting: return "waiting";
+        case BleReconnectStatePaused: return "paused";
+    }
+    return "unknown";
+}
@@ -0,0 +1,95 @@
+//
+//  BleReconnectPolicy.h
+//  SmartRing
+//
+//  Reconnection state machine for BleConnectionManager.
+//
+//  Plain C with no CoreBluetooth or Foundation dependency: the manager feeds it
+//  link events and carries out the action it returns (connect now, arm a timer,
+//  cancel the timer). Keeping the policy free of the radio means it can be
+//  compiled and driven with a scripted event sequence on any host.
+//
+//  After an unexpected link loss the first action is always an immediate
+//  connect. On iOS that is a pending connect with no timeout: the controller
+//  completes it the moment the ring advertises again, without waking the app.
+//  Backoff only applies when a connect attempt actually fails, and grows as
+//  base * multiplier^(n-1) up to maxMs with "equal jitter" (half fixed, half
+//  random) so several phones near one ring don't retry in lockstep.
+//
+
+#ifndef BleReconnectPolicy_h
+#define BleReconnectPolicy_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    BleReconnectStateIdle = 0,      // no target, or gave up
+    BleReconnectStateConnecting,    // connect issued, waiting for the link
+    BleReconnectStateConnected,
+    BleReconnectStateWaiting,       // backoff timer armed
+    BleReconnectStatePaused,        // radio off; resumes on power-on
+} BleReconnectState;
+
+typedef enum {
+    BleReconnectEventStart = 0,     // a target peripheral was set (or restored)
+    BleReconnectEventConnected,
+    BleReconnectEventLinkLost,      // disconnect with an error
+    BleReconnectEventConnectFailed,
+    BleReconnectEventTimerFired,
+    BleReconnectEventRadioOff,
+    BleReconnectEventRadioOn,
+    BleReconnectEventStop,          // intentional disconnect / forget
+} BleReconnectEvent;
+
+typedef enum {
+    BleReconnectActionNone = 0,
+    BleReconnectActionConnect,
+    BleReconnectActionSchedule,     // arm the timer for delayMs
+    BleReconnectActionCancel,       // disarm the timer
+} BleReconnectActionType;
+
+typedef struct {
+    BleReconnectActionType type;
+    double delayMs;
+} BleReconnectAction;
+
+typedef struct {
+    double baseMs;
+    double maxMs;
+    double multiplier;
+    /// Consecutive failed connects before giving up; 0 = never give up.
+    uint32_t maxAttempts;
+} BleReconnectConfig;
+
+typedef struct {
+    BleReconnectConfig config;
+    BleReconnectState state;
+    uint32_t failures;
+    uint32_t rng;
+    bool radioOn;
+} BleReconnectPolicy;
+
+/// 2 s base, x2, 5 min cap, 12 failures (~30 min of backoff).
+BleReconnectConfig BleReconnectConfigDefault(void);
+
+/// `seed` feeds the jitter; any value works (0 is remapped).
+void BleReconnectPolicyInit(BleReconnectPolicy *policy, const BleReconnectConfig *config, uint32_t seed, bool radioOn);
+
+/// Advance the state machine; the caller performs the returned action.
+BleReconnectAction BleReconnectPolicyHandle(BleReconnectPolicy *policy, BleReconnectEvent event);
+
+/// Delay before retry number `failures` (1-based), jitter included.
+double BleReconnectPolicyBackoffMs(BleReconnectPolicy *policy, uint32_t failures);
+
+const char *BleReconnectStateName(BleReconnectState state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BleReconnectPolicy_h */
@@ -0,0 +1,87 @@
+//
+//  BleRingDate.c
+//  SmartRing
+//
+
+#include "BleRingDate.h"
+
+#include <math.h>
+#include <time.h>
+
+static const double kDayMs = 24.0 * 60 * 60 * 1000;
+
+static int BleRingDigits2(const char *s) {
+    int a = s[0] - '0';
+    int b = s[1] - '0';
+    return a >= 0 && a <= 9 && b >= 0 && b <= 9 ? a * 10 + b : -1;
+}
+
+static double BleRingLocalMs(int y, int mo, int d, int hh, int mm, int ss) {
+    struct tm fields = {0};
+    fields.tm_year = y - 1900;
+    fields.tm_mon = mo - 1;
+    fields.tm_mday = d;
+    fields.tm_hour = hh;
+    fields.tm_min = mm;
+    fields.tm_sec = ss;
+    fields.tm_isdst = -1;
+    time_t t = mktime(&fields);
+    return t == (time_t)-1 ? NAN : (double)t * 1000.0;
+}
+
+static double BleRingMidnight(BleRingDateCache *cache, int y, int mo, int d) {
+    int32_t key = y * 10000 + mo * 100 + d;
+    if (cache && cache->dayKey == key) {
+        return cache->midnightMs;
+    }
+    double start = BleRingLocalMs(y, mo, d, 0, 0, 0);
+    double next = BleRingLocalMs(y, mo, d + 1, 0, 0, 0);
+    double midnight = next - start == kDayMs ? start : NAN;
+    if (cache) {
+        cache->dayKey = key;
+        cache->midnightMs = midnight;
+    }
+    return midnight;
+}
+
+void BleRingDateCacheInit(BleRingDateCache *cache) {
+    cache->dayKey = 0;
+    cache->midnightMs = NAN;
+}
+
+bool BleRingDateParse(const char *text, size_t length, BleRingDateCache *cache, double *outMs) {
+    if (!text || (length != 10 && length != 16 && length != 19)) {
+        return false;
+    }
+    int yHi = BleRingDigits2(text);
+    int yLo = BleRingDigits2(text + 2);
+    int mo = BleRingDigits2(text + 5);
+    int d = BleRingDigits2(text + 8);
+    char sep = text[4];
+    if (yHi < 0 || yLo < 0 || mo < 1 || mo > 12 || d < 1 || d > 31 ||
+        (sep != '.' && sep != '-') || text[7] != sep) {
+        return false;
+    }
+    int y = yHi * 100 + yLo;
+
+    int hh = 0, mm = 0, ss = 0;
+    if (length > 10) {
+        hh = BleRingDigits2(text + 11);
+        mm = BleRingDigits2(text + 14);
+        ss = length == 19 ? BleRingDigits2(text + 17) : 0;
+        if (text[10] != ' ' || text[13] != ':' || (length == 19 && text[16] != ':') ||
+            hh < 0 || hh > 23 || mm < 0 || mm > 59 || ss < 0 || ss > 59) {
+            return false;
+        }
+    }
+
+    double midnight = BleRingMidnight(cache, y, mo, d);
+    double ms = isnan(midnight)
+        ? BleRingLocalMs(y, mo, d, hh, mm, ss)
+        : midnight + (hh * 3600 + mm * 60 + ss) * 1000.0;
+    if (!isfinite(ms) || ms <= 0) {
+        return false;
+    }
+    *outMs = ms;
+    return true;
+}
@@ -0,0 +1,43 @@
+//
+//  BleRingDate.h
+//  SmartRing
+//
+//  Parser for the SDK's local-time date strings ("yyyy.MM.dd HH:mm:ss",
+//  "yyyy.MM.dd HH:mm", "yyyy.MM.dd"; '-' also accepted between date parts).
+//
+//  Plain C like BleReconnectPolicy. Same scheme as src/utils/ringDate.ts: fixed-
+//  width digits read straight from the bytes, and each day's local midnight
+//  computed once with mktime and reused from a caller-owned cache. A day that
+//  isn't 24 h long (DST switch) is never cached; its stamps go through mktime,
+//  so every result equals mktime of the same fields with tm_isdst = -1.
+//
+//  A cache is single-threaded and assumes the time zone doesn't change; pass
+//  NULL for a one-off parse.
+//
+
+#ifndef BleRingDate_h
+#define BleRingDate_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int32_t dayKey;         // yyyymmdd of the cached day, 0 = empty
+    double midnightMs;      // its local midnight, NAN when the day has a DST switch
+} BleRingDateCache;
+
+void BleRingDateCacheInit(BleRingDateCache *cache);
+
+/// Local epoch ms in *outMs. False for a malformed value or one before 1970.
+bool BleRingDateParse(const char *text, size_t length, BleRingDateCache *cache, double *outMs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BleRingDate_h */
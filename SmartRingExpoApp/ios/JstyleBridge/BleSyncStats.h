@@ -0,0 +1,62 @@
+//
+//  BleSyncStats.h
+//  SmartRing
+//
+//  Structured link telemetry for NewBle, JstyleBridge and V8Bridge.
+//
+//  BleLatencyHistogram is a fixed-size log2 histogram (a plain struct, no
+//  allocation per sample) used for connect, service discovery, time-to-first-byte
+//  fetch duration and link recovery. BleLinkStats is the process-wide counter set NewBle feeds
+//  from the CoreBluetooth callbacks: connection setup, discovery, bytes/packets
+//  in and out, SDK parse time, disconnects and reconnects. Both bridges share one
+//  NewBle, so they share one BleLinkStats.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Bucket i counts samples below 2^(i+4) ms (16 ms … 32 s); the last bucket is everything above.
+#define BLE_HISTOGRAM_BUCKETS 13
+
+typedef struct {
+    uint32_t count;
+    double sumMs;
+    double maxMs;
+    uint32_t buckets[BLE_HISTOGRAM_BUCKETS];
+} BleLatencyHistogram;
+
+void BleLatencyHistogramRecord(BleLatencyHistogram *histogram, double ms);
+
+/// { count, sumMs, avgMs, maxMs, p50Ms, p90Ms, buckets } — percentiles are bucket upper bounds.
+NSDictionary *BleLatencyHistogramSnapshot(const BleLatencyHistogram *histogram);
+
+@interface BleLinkStats : NSObject
+
++ (instancetype)sharedStats;
+
+- (void)connectRequested;
+- (void)didConnect;
+- (void)connectFailed;
+/// All characteristics discovered; the link is usable.
+- (void)servicesReady;
+- (void)didDisconnectWithError:(nullable NSError *)error;
+- (void)reconnectRequested;
+/// Process relaunched by CoreBluetooth state restoration.
+- (void)didRestore;
+
+- (void)recordInbound:(NSUInteger)length;
+- (void)recordOutbound:(NSUInteger)length;
+/// Time the vendor SDK spent parsing one notification.
+- (void)recordParseMs:(double)ms;
+
+/// { connects, connectFailures, disconnects, unexpectedDisconnects, reconnects,
+///   restores, bytesIn, packetsIn, bytesOut, packetsOut, parseAvgMs, parseMaxMs,
+///   connectMs, discoveryMs, recoveryMs }
+/// recoveryMs runs from an unexpected disconnect to the link being usable again.
+- (NSDictionary *)snapshot;
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,237 @@
+//
+//  BleSyncStats.m
+//  SmartRing
+//
+
+#import "BleSyncStats.h"
+
+static const int kFirstBucketLog2 = 4; // 16 ms
+
+#pragma mark - Histogram
+
+void BleLatencyHistogramRecord(BleLatencyHistogram *histogram, double ms) {
+    if (ms < 0) {
+        ms = 0;
+    }
+    int bucket = 0;
+    while (bucket < BLE_HISTOGRAM_BUCKETS - 1 && ms >= (double)(1 << (bucket + kFirstBucketLog2))) {
+        bucket++;
+    }
+    histogram->buckets[bucket] += 1;
+    histogram->count += 1;
+    histogram->sumMs += ms;
+    histogram->maxMs = MAX(histogram->maxMs, ms);
+}
+
+static double BleLatencyHistogramPercentile(const BleLatencyHistogram *histogram, double p) {
+    if (histogram->count == 0) {
+        return 0;
+    }
+    uint32_t rank = (uint32_t)ceil(p * histogram->count);
+    uint32_t seen = 0;
+    for (int i = 0; i < BLE_HISTOGRAM_BUCKETS - 1; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            return MIN((double)(1 << (i + kFirstBucketLog2)), histogram->maxMs);
+        }
+    }
+    return histogram->maxMs;
+}
+
+NSDictionary *BleLatencyHistogramSnapshot(const BleLatencyHistogram *histogram) {
+    NSMutableArray *buckets = [NSMutableArray arrayWithCapacity:BLE_HISTOGRAM_BUCKETS];
+    for (int i = 0; i < BLE_HISTOGRAM_BUCKETS; i++) {
+        [buckets addObject:@(histogram->buckets[i])];
+    }
+    return @{
+        @"count": @(histogram->count),
+        @"sumMs": @(round(histogram->sumMs)),
+        @"avgMs": @(histogram->count > 0 ? round(histogram->sumMs / histogram->count) : 0),
+        @"maxMs": @(round(histogram->maxMs)),
+        @"p50Ms": @(round(BleLatencyHistogramPercentile(histogram, 0.5))),
+        @"p90Ms": @(round(BleLatencyHistogramPercentile(histogram, 0.9))),
+        @"buckets": buckets,
+    };
+}
+
+#pragma mark - Link stats
+
+@implementation BleLinkStats {
+    // CoreBluetooth callbacks arrive on the main queue, JS reads from the bridge queue
+    NSLock *_lock;
+    CFAbsoluteTime _connectRequestedAt;
+    CFAbsoluteTime _connectedAt;
+    CFAbsoluteTime _linkLostAt;
+    NSUInteger _connects;
+    NSUInteger _connectFailures;
+    NSUInteger _disconnects;
+    NSUInteger _unexpectedDisconnects;
+    NSUInteger _reconnects;
+    NSUInteger _restores;
+    NSUInteger _bytesIn;
+    NSUInteger _packetsIn;
+    NSUInteger _bytesOut;
+    NSUInteger _packetsOut;
+    NSUInteger _parseCount;
+    double _parseTotalMs;
+    double _parseMaxMs;
+    BleLatencyHistogram _connectMs;
+    BleLatencyHistogram _discoveryMs;
+    BleLatencyHistogram _recoveryMs;
+}
+
++ (instancetype)sharedStats {
+    static BleLinkStats *shared;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        shared = [[BleLinkStats alloc] init];
+    });
+    return shared;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _lock = [[NSLock alloc] init];
+    }
+    return self;
+}
+
+- (void)connectRequested {
+    [_lock lock];
+    _connectRequestedAt = CFAbsoluteTimeGetCurrent();
+    [_lock unlock];
+}
+
+- (void)didConnect {
+    [_lock lock];
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    _connects += 1;
+    // System-initiated reconnects (pending connect after a link loss) have no request time
+    if (_connectRequestedAt > 0) {
+        BleLatencyHistogramRecord(&_connectMs, (now - _connectRequestedAt) * 1000.0);
+        _connectRequestedAt = 0;
+    }
+    _connectedAt = now;
+    [_lock unlock];
+}
+
+- (void)connectFailed {
+    [_lock lock];
+    _connectFailures += 1;
+    _connectRequestedAt = 0;
+    [_lock unlock];
+}
+
+- (void)servicesReady {
+    [_lock lock];
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    if (_connectedAt > 0) {
+        BleLatencyHistogramRecord(&_discoveryMs, (now - _connectedAt) * 1000.0);
+        _connectedAt = 0;
+    }
+    if (_linkLostAt > 0) {
+        BleLatencyHistogramRecord(&_recoveryMs, (now - _linkLostAt) * 1000.0);
+        _linkLostAt = 0;
+    }
+    [_lock unlock];
+}
+
+- (void)didDisconnectWithError:(NSError *)error {
+    [_lock lock];
+    _disconnects += 1;
+    if (error) {
+        _unexpectedDisconnects += 1;
+        // Keep the first loss time if the link flaps before it recovers
+        if (_linkLostAt == 0) {
+            _linkLostAt = CFAbsoluteTimeGetCurrent();
+        }
+    } else {
+        _linkLostAt = 0;
+    }
+    _connectedAt = 0;
+    [_lock unlock];
+}
+
+- (void)reconnectRequested {
+    [_lock lock];
+    _reconnects += 1;
+    _connectRequestedAt = CFAbsoluteTimeGetCurrent();
+    [_lock unlock];
+}
+
+- (void)didRestore {
+    [_lock lock];
+    _restores += 1;
+    [_lock unlock];
+}
+
+- (void)recordInbound:(NSUInteger)length {
+    [_lock lock];
+    _bytesIn += length;
+    _packetsIn += 1;
+    [_lock unlock];
+}
+
+- (void)recordOutbound:(NSUInteger)length {
+    [_lock lock];
+    _bytesOut += length;
+    _packetsOut += 1;
+    [_lock unlock];
+}
+
+- (void)recordParseMs:(double)ms {
+    [_lock lock];
+    _parseCount += 1;
+    _parseTotalMs += ms;
+    _parseMaxMs = MAX(_parseMaxMs, ms);
+    [_lock unlock];
+}
+
+- (NSDictionary *)snapshot {
+    [_lock lock];
+    NSDictionary *out = @{
+        @"connects": @(_connects),
+        @"connectFailures": @(_connectFailures),
+        @"disconnects": @(_disconnects),
+        @"unexpectedDisconnects": @(_unexpectedDisconnects),
+        @"reconnects": @(_reconnects),
+        @"restores": @(_restores),
+        @"bytesIn": @(_bytesIn),
+        @"packetsIn": @(_packetsIn),
+        @"bytesOut": @(_bytesOut),
+        @"packetsOut": @(_packetsOut),
+        // Sub-millisecond: keep two decimals
+        @"parseAvgMs": @(_parseCount > 0 ? round(_parseTotalMs / _parseCount * 100.0) / 100.0 : 0),
+        @"parseMaxMs": @(round(_parseMaxMs * 100.0) / 100.0),
+        @"connectMs": BleLatencyHistogramSnapshot(&_connectMs),
+        @"discoveryMs": BleLatencyHistogramSnapshot(&_discoveryMs),
+        @"recoveryMs": BleLatencyHistogramSnapshot(&_recoveryMs),
+    };
+    [_lock unlock];
+    return out;
+}
+
+- (void)reset {
+    [_lock lock];
+    _connects = 0;
+    _connectFailures = 0;
+    _disconnects = 0;
+    _unexpectedDisconnects = 0;
+    _reconnects = 0;
+    _restores = 0;
+    _linkLostAt = 0;
+    _bytesIn = 0;
+    _packetsIn = 0;
+    _bytesOut = 0;
+    _packetsOut = 0;
+    _parseCount = 0;
+    _parseTotalMs = 0;
+    _parseMaxMs = 0;
+    memset(&_connectMs, 0, sizeof(_connectMs));
+    memset(&_discoveryMs, 0, sizeof(_discoveryMs));
+    memset(&_recoveryMs, 0, sizeof(_recoveryMs));
+    [_lock unlock];
+}
+
+@end
@@ -10,7 +10,12 @@
 #import "BleSDK_X3.h"
 #import "BleSDK_Header_X3.h"
 #import "DeviceData_X3.h"
-#import <React/RCTLog.h>
+#import "BleFetchEngine.h"
+#import "BleSyncStats.h"
+#import "BleRealtimeCoalescer.h"
+#import "BleLogQueue.h"
+#import "BleConnectionManager.h"
+#import "BleRingDate.h"
 #import <CoreBluetooth/CoreBluetooth.h>
 #import <UserNotifications/UserNotifications.h>
 
@@ -19,8 +24,11 @@ static NSString *const kJstyleWriteCharUUID = @"FFF6";
 static NSString *const kJstyleNotifyCharUUID = @"FFF7";
 static NSString *const kPairedDeviceUUIDKey = @"JstylePairedDeviceUUID";
 static NSString *const kPairedDeviceNameKey = @"JstylePairedDeviceName";
+// Fetch key for continuous SpO2: its replies come back as AutomaticSpo2Data_X3, so it
+// needs a key of its own outside the SDK's DATATYPE_X3 range
+static const DATATYPE_X3 kContinuousSpo2Fetch_X3 = (DATATYPE_X3)(DataError_X3 + 1);
 
-@interface JstyleBridge () <MyBleDelegate>
+@interface JstyleBridge () <MyBleDelegate, BleFetchEngineDelegate>
 
 @property (nonatomic, assign) BOOL hasListeners;
 @property (nonatomic, strong) NSMutableArray<NSDictionary *> *discoveredDevices;
@@ -32,28 +40,23 @@ static NSString *const kPairedDeviceNameKey = @"JstylePairedDeviceName";
 @property (nonatomic, copy) RCTPromiseRejectBlock pendingConnectRejecter;
 
 // Pagination state for data retrieval
-@property (nonatomic, strong) NSMutableArray *accumulatedStepsData;
-@property (nonatomic, strong) NSMutableArray *accumulatedSleepData;
-@property (nonatomic, strong) NSMutableArray *accumulatedHRData;
-@property (nonatomic, strong) NSMutableArray *accumulatedSpO2Data;
-@property (nonatomic, strong) NSMutableArray *accumulatedTempData;
-@property (nonatomic, strong) NSMutableArray *accumulatedHRVData;
-@property (nonatomic, strong) NSMutableArray *accumulatedActivityModeData;
-@property (nonatomic, strong) NSMutableArray *accumulatedSleepHRVData;
-@property (nonatomic, strong) NSMutableArray *accumulatedOSAData;
-@property (nonatomic, strong) NSMutableArray *accumulatedEOVData;
-@property (nonatomic, strong) NSMutableArray *accumulatedPPIData;
+@property (nonatomic, strong) BleFetchEngine *fetchEngine;
+@property (nonatomic, strong) BleRealtimeCoalescer *realtimeCoalescer;
+@property (nonatomic, strong) BleLogQueue *log;
 @property (nonatomic, copy) RCTPromiseResolveBlock pendingDataResolver;
 @property (nonatomic, copy) RCTPromiseRejectBlock pendingDataRejecter;
 @property (nonatomic, assign) DATATYPE_X3 pendingDataType;
 @property (nonatomic, strong) NSTimer *pendingDataWatchdogTimer;
 @property (nonatomic, assign) NSTimeInterval pendingDataTimeoutInterval;
+@property (nonatomic, assign) NSUInteger watchdogFires;
+/// Incremental cursor for detail activity: the ring resumes from the record stamped with this date.
+@property (nonatomic, strong, nullable) NSDate *detailActivityStartDate;
+/// Same cursors for the overnight streams (continuous SpO2, sleep + activity).
+@property (nonatomic, strong, nullable) NSDate *continuousSpo2StartDate;
+@property (nonatomic, strong, nullable) NSDate *sleepActivityStartDate;
 
 // Connection stability improvements
 @property (nonatomic, assign) BOOL isDisconnecting;  // Track intentional disconnect
-@property (nonatomic, strong) NSTimer *reconnectionTimer;
-@property (nonatomic, assign) NSInteger reconnectionAttempts;
-@property (nonatomic, assign) NSTimeInterval reconnectionInterval;
 
 // Background notification state
 @property (nonatomic, strong) NSDate *lastHRAlertTime;
@@ -69,24 +72,32 @@ RCT_EXPORT_MODULE();
     self = [super init];
     if (self) {
         _discoveredDevices = [NSMutableArray array];
-        _accumulatedStepsData = [NSMutableArray array];
-        _accumulatedSleepData = [NSMutableArray array];
-        _accumulatedHRData = [NSMutableArray array];
-        _accumulatedSpO2Data = [NSMutableArray array];
-        _accumulatedTempData = [NSMutableArray array];
-        _accumulatedHRVData = [NSMutableArray array];
-        _accumulatedActivityModeData = [NSMutableArray array];
-        _accumulatedSleepHRVData = [NSMutableArray array];
-        _accumulatedOSAData = [NSMutableArray array];
-        _accumulatedEOVData = [NSMutableArray array];
-        _accumulatedPPIData = [NSMutableArray array];
+        _fetchEngine = [[BleFetchEngine alloc] init];
+        _fetchEngine.delegate = self;
+        [self registerFetchDescriptors];
+        __weak JstyleBridge *weakSelf = self;
+        _realtimeCoalescer = [[BleRealtimeCoalescer alloc] initWithFrameHandler:^(NSDictionary *frame) {
+            JstyleBridge *strongSelf = weakSelf;
+            if (strongSelf.hasListeners) {
+                [strongSelf sendEventWithName:@"onRealTimeData" body:frame];
+            }
+        }];
+        _log = [[BleLogQueue alloc] initWithName:@"JstyleBridge" batchHandler:^(NSData *batch, NSUInteger count, NSUInteger dropped) {
+            JstyleBridge *strongSelf = weakSelf;
+            if (strongSelf.hasListeners) {
+                [strongSelf sendEventWithName:@"onDebugLog" body:@{
+                    @"batch": [batch base64EncodedStringWithOptions:0],
+                    @"count": @(count),
+                    @"dropped": @(dropped),
+                }];
+            }
+        }];
+        [BleConnectionManager sharedManager].logQueue = _log;
         _pendingDataType = DataError_X3;
         _pendingDataTimeoutInterval = 20.0;
 
-        // Connection stability
+        // Connection stability (reconnection itself is BleConnectionManager's)
         _isDisconnecting = NO;
-        _reconnectionAttempts = 0;
-        _reconnectionInterval = 6.0;  // Match demo app: 6 seconds
 
         // Notification state
         _lastBatteryAlertThreshold = 100; // re-arms as battery crosses thresholds downward
@@ -109,6 +120,8 @@ RCT_EXPORT_MODULE();
         @"onRealTimeData",
         @"onMeasurementResult",
         @"onBatteryData",
+        @"onActivityModeData",
+        @"onDeviceReady",
         @"onError",
         @"onDebugLog"
     ];
@@ -124,14 +137,9 @@ RCT_EXPORT_MODULE();
 
 #pragma mark - Helper Methods
 
+// Enqueue only: self.log batches entries into onDebugLog off this thread
 - (void)debugLog:(NSString *)message {
-    RCTLogInfo(@"JstyleBridge: %@", message);
-    if (self.hasListeners) {
-        [self sendEventWithName:@"onDebugLog" body:@{
-            @"message": message,
-            @"timestamp": @([[NSDate date] timeIntervalSince1970] * 1000)
-        }];
-    }
+    [self.log log:BleLogLevelInfo message:message];
 }
 
 - (void)sendError:(NSString *)code message:(NSString *)message {
@@ -196,9 +204,10 @@ RCT_EXPORT_MODULE();
     }
     NSString *message = [NSString stringWithFormat:@"Pending data request timed out in native bridge (data type %d)",
                          (int)self.pendingDataType];
-    [self debugLog:message];
+    [self.log log:BleLogLevelWarn message:message];
+    self.watchdogFires += 1;
     [self rejectPendingDataRequestWithCode:@"NATIVE_TIMEOUT" message:message];
-    [self clearAccumulatedDataBuffers];
+    [self.fetchEngine abortWithReason:BleFetchAbortTimeout];
 }
 
 - (void)invalidatePendingDataWatchdog {
@@ -208,20 +217,6 @@ RCT_EXPORT_MODULE();
     }
 }
 
-- (void)clearAccumulatedDataBuffers {
-    [self.accumulatedStepsData removeAllObjects];
-    [self.accumulatedSleepData removeAllObjects];
-    [self.accumulatedHRData removeAllObjects];
-    [self.accumulatedSpO2Data removeAllObjects];
-    [self.accumulatedTempData removeAllObjects];
-    [self.accumulatedHRVData removeAllObjects];
-    [self.accumulatedActivityModeData removeAllObjects];
-    [self.accumulatedSleepHRVData removeAllObjects];
-    [self.accumulatedOSAData removeAllObjects];
-    [self.accumulatedEOVData removeAllObjects];
-    [self.accumulatedPPIData removeAllObjects];
-}
-
 #pragma mark - Initialize SDK
 
 RCT_EXPORT_METHOD(initialize:(RCTPromiseResolveBlock)resolve
@@ -263,7 +258,7 @@ RCT_EXPORT_METHOD(stopScan:(RCTPromiseResolveBlock)resolve
 RCT_EXPORT_METHOD(connectToDevice:(NSString *)deviceId
                   resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    [self debugLog:[NSString stringWithFormat:@"Connecting to device: %@", deviceId]];
+    BLE_LOG(self.log, BleLogLevelInfo, @"Connecting to device: %@", deviceId);
 
     // Find the peripheral in discovered devices first
     CBPeripheral *peripheral = nil;
@@ -283,7 +278,7 @@ RCT_EXPORT_METHOD(connectToDevice:(NSString *)deviceId
             NSArray *peripherals = [[NewBle sharedManager].CentralManage retrievePeripheralsWithIdentifiers:@[uuid]];
             if (peripherals.count > 0) {
                 peripheral = peripherals[0];
-                [self debugLog:[NSString stringWithFormat:@"Retrieved peripheral via UUID: %@", peripheral.name]];
+                BLE_LOG(self.log, BleLogLevelInfo, @"Retrieved peripheral via UUID: %@", peripheral.name);
             }
         }
     }
@@ -298,7 +293,7 @@ RCT_EXPORT_METHOD(connectToDevice:(NSString *)deviceId
     self.pendingConnectResolver = resolve;
     self.pendingConnectRejecter = reject;
 
-    [[NewBle sharedManager] connectDevice:peripheral];
+    [[BleConnectionManager sharedManager] connectPeripheral:peripheral];
 }
 
 RCT_EXPORT_METHOD(disconnect:(RCTPromiseResolveBlock)resolve
@@ -307,10 +302,10 @@ RCT_EXPORT_METHOD(disconnect:(RCTPromiseResolveBlock)resolve
 
     // Mark as intentional disconnect to prevent auto-reconnect
     self.isDisconnecting = YES;
-    [self stopReconnectionTimer];
+    [[BleConnectionManager sharedManager] stopReconnecting];
     [self rejectPendingDataRequestWithCode:@"DISCONNECTED"
                                    message:@"Disconnected before pending data request completed"];
-    [self clearAccumulatedDataBuffers];
+    [self.fetchEngine abortWithReason:BleFetchAbortDisconnected];
 
     if (self.connectedPeripheral) {
         [[NewBle sharedManager] Disconnect];
@@ -345,14 +340,14 @@ RCT_EXPORT_METHOD(cancelPendingDataRequest:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     (void)reject;
     if (self.pendingDataResolver) {
-        [self debugLog:[NSString stringWithFormat:@"Cancelling pending data request (type %d)", (int)self.pendingDataType]];
+        BLE_LOG(self.log, BleLogLevelInfo, @"Cancelling pending data request (type %d)", (int)self.pendingDataType);
         [self rejectPendingDataRequestWithCode:@"CANCELLED"
                                        message:@"Pending data request cancelled by JS timeout recovery"];
     } else {
         [self clearPendingDataRequest];
     }
 
-    [self clearAccumulatedDataBuffers];
+    [self.fetchEngine abortWithReason:BleFetchAbortCancelled];
     resolve(@{@"success": @YES});
 }
 
@@ -375,9 +370,9 @@ RCT_EXPORT_METHOD(forgetPairedDevice:(RCTPromiseResolveBlock)resolve
 
     if (self.connectedPeripheral) {
         self.isDisconnecting = YES;
-        [self stopReconnectionTimer];
+        [[BleConnectionManager sharedManager] stopReconnecting];
         [self rejectPendingDataRequestWithCode:@"DISCONNECTED" message:@"Paired device forgotten"];
-        [self clearAccumulatedDataBuffers];
+        [self.fetchEngine abortWithReason:BleFetchAbortDisconnected];
         [[NewBle sharedManager] Disconnect];
         self.connectedPeripheral = nil;
         self.connectedDeviceId = nil;
@@ -397,33 +392,19 @@ RCT_EXPORT_METHOD(autoReconnect:(RCTPromiseResolveBlock)resolve
         return;
     }
 
-    // Try to retrieve the peripheral by saved UUID first
-    NSUUID *uuid = [[NSUUID alloc] initWithUUIDString:pairedUUID];
-    if (uuid) {
-        NSArray *peripherals = [[NewBle sharedManager].CentralManage retrievePeripheralsWithIdentifiers:@[uuid]];
-        if (peripherals.count > 0) {
-            CBPeripheral *peripheral = peripherals[0];
-            [[NewBle sharedManager] setDelegate:self];
-            self.pendingConnectResolver = resolve;
-            self.pendingConnectRejecter = reject;
-            [[NewBle sharedManager] connectDevice:peripheral];
-            return;
-        }
-    }
-
-    // Fallback: try retrieveConnectedPeripherals (already connected by system)
+    // Known to CoreBluetooth (cache or system-connected): connect directly, no scan
     CBUUID *serviceUUID = [CBUUID UUIDWithString:kJstyleServiceUUID];
-    NSArray *peripherals = [[NewBle sharedManager] retrieveConnectedPeripheralsWithServices:@[serviceUUID]];
-
-    if (peripherals.count > 0) {
-        CBPeripheral *peripheral = peripherals[0];
-        [[NewBle sharedManager] setDelegate:self];
-        self.pendingConnectResolver = resolve;
-        self.pendingConnectRejecter = reject;
-        [[NewBle sharedManager] connectDevice:peripheral];
-    } else {
+    CBPeripheral *peripheral = [[BleConnectionManager sharedManager] retrievePeripheralWithIdentifier:pairedUUID
+                                                                                             services:@[serviceUUID]];
+    if (!peripheral) {
         resolve(@{@"success": @NO, @"message": @"Paired device not found nearby"});
+        return;
     }
+
+    [[NewBle sharedManager] setDelegate:self];
+    self.pendingConnectResolver = resolve;
+    self.pendingConnectRejecter = reject;
+    [[BleConnectionManager sharedManager] connectPeripheral:peripheral];
 }
 
 #pragma mark - Device Info
@@ -479,6 +460,9 @@ RCT_EXPORT_METHOD(setUserInfo:(NSDictionary *)userInfo
         reject(@"NOT_CONNECTED", @"No device connected", nil);
         return;
     }
+    if ([self rejectIfBusyForOperation:@"setUserInfo" rejecter:reject]) {
+        return;
+    }
 
     // Note: X3 uses opposite gender encoding from QCBand
     // X3: 0=female, 1=male (normalized in bridge)
@@ -493,104 +477,161 @@ RCT_EXPORT_METHOD(setUserInfo:(NSDictionary *)userInfo
     info.weight = [userInfo[@"weight"] intValue];
     info.stride = [userInfo[@"stride"] intValue] ?: 70; // Default stride
 
+    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:SetPersonalInfo_X3];
+
     NSMutableData *cmd = [[BleSDK_X3 sharedManager] SetPersonalInfo:info];
     [[NewBle sharedManager] writeValue:kJstyleServiceUUID
                       characteristicUUID:kJstyleWriteCharUUID
                                        p:self.connectedPeripheral
                                     data:cmd];
-
-    resolve(@{@"success": @YES});
 }
 
-#pragma mark - Data Retrieval
-
-RCT_EXPORT_METHOD(getStepsData:(RCTPromiseResolveBlock)resolve
+RCT_EXPORT_METHOD(getUserInfo:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     if (!self.connectedPeripheral) {
         reject(@"NOT_CONNECTED", @"No device connected", nil);
         return;
     }
-    if ([self rejectIfBusyForOperation:@"getStepsData" rejecter:reject]) {
+    if ([self rejectIfBusyForOperation:@"getUserInfo" rejecter:reject]) {
         return;
     }
 
-    [self debugLog:@"Getting steps data"];
+    [self debugLog:@"Reading personal info"];
 
-    [self.accumulatedStepsData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:TotalActivityData_X3];
+    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:GetPersonalInfo_X3];
 
-    // Mode 0: Start reading from latest position
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetTotalActivityDataWithMode:0 withStartDate:nil];
+    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetPersonalInfo];
     [[NewBle sharedManager] writeValue:kJstyleServiceUUID
                       characteristicUUID:kJstyleWriteCharUUID
                                        p:self.connectedPeripheral
                                     data:cmd];
 }
 
-RCT_EXPORT_METHOD(getSleepData:(RCTPromiseResolveBlock)resolve
+#pragma mark - Automatic Monitoring
+
+// dataType: 1 = HR, 2 = SpO2, 3 = temperature, 4 = HRV
+RCT_EXPORT_METHOD(getAutoMonitoring:(int)dataType
+                  resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     if (!self.connectedPeripheral) {
         reject(@"NOT_CONNECTED", @"No device connected", nil);
         return;
     }
-    if ([self rejectIfBusyForOperation:@"getSleepData" rejecter:reject]) {
+    if ([self rejectIfBusyForOperation:@"getAutoMonitoring" rejecter:reject]) {
         return;
     }
 
-    [self debugLog:@"Getting sleep data"];
+    BLE_LOG(self.log, BleLogLevelInfo, @"Reading automatic monitoring (type %d)", dataType);
 
-    [self.accumulatedSleepData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:DetailSleepData_X3];
+    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:GetAutomaticMonitoring_X3];
 
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetDetailSleepDataWithMode:0 withStartDate:nil];
+    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetAutomaticMonitoringWithDataType:dataType];
     [[NewBle sharedManager] writeValue:kJstyleServiceUUID
                       characteristicUUID:kJstyleWriteCharUUID
                                        p:self.connectedPeripheral
                                     data:cmd];
 }
 
-RCT_EXPORT_METHOD(getHeartRateData:(RCTPromiseResolveBlock)resolve
+// config: { dataType, workMode (0 = off, 2 = interval), startTime / endTime "HH:mm",
+// weeks (bit 0 = Sunday), intervalTime (minutes) }
+RCT_EXPORT_METHOD(setAutoMonitoring:(NSDictionary *)config
+                  resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     if (!self.connectedPeripheral) {
         reject(@"NOT_CONNECTED", @"No device connected", nil);
         return;
     }
-    if ([self rejectIfBusyForOperation:@"getHeartRateData" rejecter:reject]) {
+    if ([self rejectIfBusyForOperation:@"setAutoMonitoring" rejecter:reject]) {
         return;
     }
 
-    [self debugLog:@"Getting heart rate data"];
+    MyAutomaticMonitoring_X3 monitoring = [self automaticMonitoringFromConfig:config];
+    BLE_LOG(self.log, BleLogLevelInfo, @"Setting automatic monitoring (type %d, mode %d, every %d min)",
+            monitoring.dataType, monitoring.mode, monitoring.intervalTime);
 
-    [self.accumulatedHRData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:DynamicHR_X3];
+    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:SetAutomaticMonitoring_X3];
 
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetContinuousHRDataWithMode:0 withStartDate:nil];
+    NSMutableData *cmd = [[BleSDK_X3 sharedManager] SetAutomaticHRMonitoring:monitoring];
     [[NewBle sharedManager] writeValue:kJstyleServiceUUID
                       characteristicUUID:kJstyleWriteCharUUID
                                        p:self.connectedPeripheral
                                     data:cmd];
 }
 
-RCT_EXPORT_METHOD(getSingleHeartRateData:(RCTPromiseResolveBlock)resolve
-                  rejecter:(RCTPromiseRejectBlock)reject) {
+- (MyAutomaticMonitoring_X3)automaticMonitoringFromConfig:(NSDictionary *)config {
+    NSArray<NSString *> *start = [config[@"startTime"] ?: @"00:00" componentsSeparatedByString:@":"];
+    NSArray<NSString *> *end = [config[@"endTime"] ?: @"23:59" componentsSeparatedByString:@":"];
+    int weeks = config[@"weeks"] ? [config[@"weeks"] intValue] : 0x7f;
+
+    MyAutomaticMonitoring_X3 monitoring;
+    monitoring.mode = config[@"workMode"] ? [config[@"workMode"] intValue] : 2;
+    monitoring.dataType = config[@"dataType"] ? [config[@"dataType"] intValue] : 1;
+    monitoring.startTime_Hour = [start.firstObject intValue];
+    monitoring.startTime_Minutes = start.count > 1 ? [start[1] intValue] : 0;
+    monitoring.endTime_Hour = [end.firstObject intValue];
+    monitoring.endTime_Minutes = end.count > 1 ? [end[1] intValue] : 0;
+    monitoring.intervalTime = [config[@"intervalTime"] intValue] ?: 5;
+    monitoring.weeks.sunday = (weeks & (1 << 0)) != 0;
+    monitoring.weeks.monday = (weeks & (1 << 1)) != 0;
+    monitoring.weeks.Tuesday = (weeks & (1 << 2)) != 0;
+    monitoring.weeks.Wednesday = (weeks & (1 << 3)) != 0;
+    monitoring.weeks.Thursday = (weeks & (1 << 4)) != 0;
+    monitoring.weeks.Friday = (weeks & (1 << 5)) != 0;
+    monitoring.weeks.Saturday = (weeks & (1 << 6)) != 0;
+    return monitoring;
+}
+
+#pragma mark - Data Retrieval
+
+// Every history type is paged through the shared fetch engine; see registerFetchDescriptors.
+- (void)startPagedFetch:(DATATYPE_X3)type
+              operation:(NSString *)operation
+                message:(NSString *)message
+               resolver:(RCTPromiseResolveBlock)resolve
+               rejecter:(RCTPromiseRejectBlock)reject {
     if (!self.connectedPeripheral) {
         reject(@"NOT_CONNECTED", @"No device connected", nil);
         return;
     }
-    if ([self rejectIfBusyForOperation:@"getSingleHeartRateData" rejecter:reject]) {
+    if ([self rejectIfBusyForOperation:operation rejecter:reject]) {
         return;
     }
 
-    [self debugLog:@"Getting single/static heart rate data"];
+    [self debugLog:message];
 
-    [self.accumulatedHRData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:StaticHR_X3];
+    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:type];
+    if (![self.fetchEngine startFetchForDataType:type]) {
+        [self rejectPendingDataRequestWithCode:@"UNSUPPORTED"
+                                       message:[NSString stringWithFormat:@"%@ has no fetch descriptor", operation]];
+    }
+}
 
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetSingleHRDataWithMode:0 withStartDate:nil];
-    [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                      characteristicUUID:kJstyleWriteCharUUID
-                                       p:self.connectedPeripheral
-                                    data:cmd];
+RCT_EXPORT_METHOD(getStepsData:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    [self startPagedFetch:TotalActivityData_X3 operation:@"getStepsData" message:@"Getting steps data" resolver:resolve rejecter:reject];
+}
+
+// `since` is the "yyyy.MM.dd HH:mm:ss" start of the newest window already ingested; null = everything
+RCT_EXPORT_METHOD(getDetailActivityData:(nullable NSString *)since
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    self.detailActivityStartDate = [self dateFromRingString:since];
+    [self startPagedFetch:DetailActivityData_X3 operation:@"getDetailActivityData" message:@"Getting detail activity data" resolver:resolve rejecter:reject];
+}
+
+RCT_EXPORT_METHOD(getSleepData:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    [self startPagedFetch:DetailSleepData_X3 operation:@"getSleepData" message:@"Getting sleep data" resolver:resolve rejecter:reject];
+}
+
+RCT_EXPORT_METHOD(getHeartRateData:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    [self startPagedFetch:DynamicHR_X3 operation:@"getHeartRateData" message:@"Getting heart rate data" resolver:resolve rejecter:reject];
+}
+
+RCT_EXPORT_METHOD(getSingleHeartRateData:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    [self startPagedFetch:StaticHR_X3 operation:@"getSingleHeartRateData" message:@"Getting single/static heart rate data" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(enableAutoHRMonitoring:(RCTPromiseResolveBlock)resolve
@@ -605,178 +646,131 @@ RCT_EXPORT_METHOD(enableAutoHRMonitoring:(RCTPromiseResolveBlock)resolve
 
 RCT_EXPORT_METHOD(getSpO2Data:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) {
-        reject(@"NOT_CONNECTED", @"No device connected", nil);
-        return;
-    }
-    if ([self rejectIfBusyForOperation:@"getSpO2Data" rejecter:reject]) {
-        return;
-    }
-
-    [self debugLog:@"Getting SpO2 data"];
+    [self startPagedFetch:AutomaticSpo2Data_X3 operation:@"getSpO2Data" message:@"Getting SpO2 data" resolver:resolve rejecter:reject];
+}
 
-    [self.accumulatedSpO2Data removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:AutomaticSpo2Data_X3];
+// Per-minute overnight SpO2; `since` works like getDetailActivityData's
+RCT_EXPORT_METHOD(getContinuousSpO2Data:(nullable NSString *)since
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    self.continuousSpo2StartDate = [self dateFromRingString:since];
+    [self startPagedFetch:kContinuousSpo2Fetch_X3 operation:@"getContinuousSpO2Data" message:@"Getting continuous SpO2 data" resolver:resolve rejecter:reject];
+}
 
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetAutomaticSpo2DataWithMode:0 withStartDate:nil];
-    [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                      characteristicUUID:kJstyleWriteCharUUID
-                                       p:self.connectedPeripheral
-                                    data:cmd];
+// Sleep detail with the activity level of each sleep unit (same pairing V8 gets from type 81)
+RCT_EXPORT_METHOD(getSleepWithActivity:(nullable NSString *)since
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    self.sleepActivityStartDate = [self dateFromRingString:since];
+    [self startPagedFetch:sleepAndAcitivityData_X3 operation:@"getSleepWithActivity" message:@"Getting sleep and activity data" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getTemperatureData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) {
-        reject(@"NOT_CONNECTED", @"No device connected", nil);
-        return;
-    }
-    if ([self rejectIfBusyForOperation:@"getTemperatureData" rejecter:reject]) {
-        return;
-    }
-
-    [self debugLog:@"Getting temperature data"];
-
-    [self.accumulatedTempData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:TemperatureData_X3];
-
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetTemperatureDataWithMode:0 withStartDate:nil];
-    [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                      characteristicUUID:kJstyleWriteCharUUID
-                                       p:self.connectedPeripheral
-                                    data:cmd];
+    [self startPagedFetch:TemperatureData_X3 operation:@"getTemperatureData" message:@"Getting temperature data" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getHRVData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) {
-        reject(@"NOT_CONNECTED", @"No device connected", nil);
-        return;
-    }
-    if ([self rejectIfBusyForOperation:@"getHRVData" rejecter:reject]) {
-        return;
-    }
-
-    [self debugLog:@"Getting HRV data"];
-
-    [self.accumulatedHRVData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:HRVData_X3];
-
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetHRVDataWithMode:0 withStartDate:nil];
-    [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                      characteristicUUID:kJstyleWriteCharUUID
-                                       p:self.connectedPeripheral
-                                    data:cmd];
+    [self startPagedFetch:HRVData_X3 operation:@"getHRVData" message:@"Getting HRV data" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getActivityModeData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) {
-        reject(@"NOT_CONNECTED", @"No device connected", nil);
-        return;
-    }
-    if ([self rejectIfBusyForOperation:@"getActivityModeData" rejecter:reject]) {
-        return;
-    }
-
-    [self debugLog:@"Getting activity mode data"];
-
-    [self.accumulatedActivityModeData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:ActivityModeData_X3];
-
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetActivityModeDataWithMode:0 withStartDate:nil];
-    [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                      characteristicUUID:kJstyleWriteCharUUID
-                                       p:self.connectedPeripheral
-                                    data:cmd];
+    [self startPagedFetch:ActivityModeData_X3 operation:@"getActivityModeData" message:@"Getting activity mode data" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getSleepHRVData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) {
-        reject(@"NOT_CONNECTED", @"No device connected", nil);
-        return;
-    }
-    if ([self rejectIfBusyForOperation:@"getSleepHRVData" rejecter:reject]) {
-        return;
-    }
-
-    [self debugLog:@"Getting sleep HRV data"];
-
-    [self.accumulatedSleepHRVData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:sleepHrvData_X3];
-
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetSleepHRVDataWithMode:0 withStartDate:nil];
-    [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                      characteristicUUID:kJstyleWriteCharUUID
-                                       p:self.connectedPeripheral
-                                    data:cmd];
+    [self startPagedFetch:sleepHrvData_X3 operation:@"getSleepHRVData" message:@"Getting sleep HRV data" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getOSAData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) {
-        reject(@"NOT_CONNECTED", @"No device connected", nil);
-        return;
-    }
-    if ([self rejectIfBusyForOperation:@"getOSAData" rejecter:reject]) {
-        return;
-    }
-
-    [self debugLog:@"Getting OSA data"];
+    [self startPagedFetch:osaData_X3 operation:@"getOSAData" message:@"Getting OSA data" resolver:resolve rejecter:reject];
+}
 
-    [self.accumulatedOSAData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:osaData_X3];
+RCT_EXPORT_METHOD(getEOVData:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    [self startPagedFetch:eovData_X3 operation:@"getEOVData" message:@"Getting EOV data" resolver:resolve rejecter:reject];
+}
 
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetOSADataWithMode:0 withStartDate:nil];
-    [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                      characteristicUUID:kJstyleWriteCharUUID
-                                       p:self.connectedPeripheral
-                                    data:cmd];
+RCT_EXPORT_METHOD(getPPIData:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    [self startPagedFetch:ppiData_X3 operation:@"getPPIData" message:@"Getting PPI data" resolver:resolve rejecter:reject];
 }
 
-RCT_EXPORT_METHOD(getEOVData:(RCTPromiseResolveBlock)resolve
+// Clears one history type on the ring (mode 0x99). `operation` is the fetch method name the
+// records came from; JS only calls this once they are stored locally and acked by the backend.
+RCT_EXPORT_METHOD(deleteHistoryData:(NSString *)operation
+                  resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     if (!self.connectedPeripheral) {
         reject(@"NOT_CONNECTED", @"No device connected", nil);
         return;
     }
-    if ([self rejectIfBusyForOperation:@"getEOVData" rejecter:reject]) {
+    if ([self rejectIfBusyForOperation:@"deleteHistoryData" rejecter:reject]) {
         return;
     }
 
-    [self debugLog:@"Getting EOV data"];
+    NSNumber *type = [self deletableDataTypes][operation];
+    NSData *cmd = type ? [self.fetchEngine deleteCommandForDataType:type.integerValue] : nil;
+    if (!cmd) {
+        reject(@"UNSUPPORTED", [NSString stringWithFormat:@"%@ has no delete command", operation], nil);
+        return;
+    }
 
-    [self.accumulatedEOVData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:eovData_X3];
+    // Resolved by fetchEngine:didDeleteDataType: once the ring confirms; the watchdog rejects otherwise
+    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:(DATATYPE_X3)type.integerValue];
+    BLE_LOG(self.log, BleLogLevelInfo, @"Deleting ring history for %@", operation);
+    [self writeCommand:cmd];
+}
 
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetEOVDataWithMode:0 withStartDate:nil];
-    [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                      characteristicUUID:kJstyleWriteCharUUID
-                                       p:self.connectedPeripheral
-                                    data:cmd];
+RCT_EXPORT_METHOD(getFetchMetrics:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    resolve([self.fetchEngine metricsSnapshot]);
 }
 
-RCT_EXPORT_METHOD(getPPIData:(RCTPromiseResolveBlock)resolve
+RCT_EXPORT_METHOD(resetFetchMetrics:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) {
-        reject(@"NOT_CONNECTED", @"No device connected", nil);
-        return;
-    }
-    if ([self rejectIfBusyForOperation:@"getPPIData" rejecter:reject]) {
-        return;
-    }
+    (void)reject;
+    [self.fetchEngine resetMetrics];
+    resolve(@{@"success": @YES});
+}
 
-    [self debugLog:@"Getting PPI data"];
+RCT_EXPORT_METHOD(getSyncStats:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    resolve(@{
+        @"link": [[BleLinkStats sharedStats] snapshot],
+        @"fetch": [self.fetchEngine metricsSnapshot],
+        @"realtime": [self.realtimeCoalescer snapshot],
+        @"log": [self.log snapshot],
+        @"watchdogFires": @(self.watchdogFires),
+        @"reconnect": [[BleConnectionManager sharedManager] snapshot],
+    });
+}
 
-    [self.accumulatedPPIData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:ppiData_X3];
+RCT_EXPORT_METHOD(resetSyncStats:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    [[BleLinkStats sharedStats] reset];
+    [self.fetchEngine resetMetrics];
+    [self.realtimeCoalescer resetMetrics];
+    [self.log resetMetrics];
+    self.watchdogFires = 0;
+    resolve(@{@"success": @YES});
+}
 
-    NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetPpiDataWithMode:0 withStartDate:nil];
-    [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                      characteristicUUID:kJstyleWriteCharUUID
-                                       p:self.connectedPeripheral
-                                    data:cmd];
+// { level, sample: { debug: n, ... }, flushIntervalMs } — see BleLogQueue. Resolves the
+// log stats with the new level.
+RCT_EXPORT_METHOD(configureLogging:(NSDictionary *)options
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    [self.log configure:options];
+    resolve([self.log snapshot]);
 }
 
 #pragma mark - Time Sync
@@ -871,7 +865,7 @@ RCT_EXPORT_METHOD(setStepGoal:(int)goal
         return;
     }
 
-    [self debugLog:[NSString stringWithFormat:@"Setting step goal: %d", goal]];
+    BLE_LOG(self.log, BleLogLevelInfo, @"Setting step goal: %d", goal);
 
     [self setPendingDataRequestWithResolver:resolve rejecter:reject type:SetDeviceGoal_X3];
 
@@ -928,6 +922,35 @@ RCT_EXPORT_METHOD(factoryReset:(RCTPromiseResolveBlock)resolve
                                     data:cmd];
 }
 
+#pragma mark - Activity Mode
+
+// workMode: 1 start, 2 pause, 3 continue, 4 stop (WORKMODE_X3). activityMode is the
+// ACTIVITYMODE_X3 sport; minutes is the planned duration the ring counts down from.
+RCT_EXPORT_METHOD(controlActivityMode:(int)activityMode
+                  workMode:(int)workMode
+                  minutes:(int)minutes
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    if (!self.connectedPeripheral) {
+        reject(@"NOT_CONNECTED", @"No device connected", nil);
+        return;
+    }
+    if (workMode < startActivity || workMode > stopActivity) {
+        reject(@"INVALID_ARGUMENT", [NSString stringWithFormat:@"Unknown work mode %d", workMode], nil);
+        return;
+    }
+
+    BLE_LOG(self.log, BleLogLevelInfo, @"Activity mode %d work mode %d (%d min)", activityMode, workMode, minutes);
+
+    MyBreathParameter_X3 breath = {0, 0};
+    NSMutableData *cmd = [[BleSDK_X3 sharedManager] startActivityMode:(ACTIVITYMODE_X3)activityMode
+                                                             WorkMode:(WORKMODE_X3)workMode
+                                                         ActivityTime:minutes
+                                                      BreathParameter:breath];
+    [self writeCommand:cmd];
+    resolve(@{@"success": @YES});
+}
+
 #pragma mark - Real-Time Data
 
 RCT_EXPORT_METHOD(startRealTimeData:(RCTPromiseResolveBlock)resolve
@@ -956,6 +979,10 @@ RCT_EXPORT_METHOD(stopRealTimeData:(RCTPromiseResolveBlock)resolve
     }
 
     [self debugLog:@"Stopping real-time data"];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self.realtimeCoalescer flush];
+        [self.realtimeCoalescer reset];
+    });
 
     NSMutableData *cmd = [[BleSDK_X3 sharedManager] RealTimeDataWithType:0];
     [[NewBle sharedManager] writeValue:kJstyleServiceUUID
@@ -966,6 +993,20 @@ RCT_EXPORT_METHOD(stopRealTimeData:(RCTPromiseResolveBlock)resolve
     resolve(@{@"success": @YES});
 }
 
+// rateHz: realtime frames per second, 0 = every packet (recording). deltas: send only
+// changed fields (with periodic keyframes). See BleRealtimeCoalescer.
+RCT_EXPORT_METHOD(configureRealTimeStream:(double)rateHz
+                  deltas:(BOOL)deltas
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self.realtimeCoalescer.rateHz = rateHz;
+        self.realtimeCoalescer.deltas = deltas;
+        resolve([self.realtimeCoalescer snapshot]);
+    });
+}
+
 #pragma mark - Manual Measurements
 
 RCT_EXPORT_METHOD(startHeartRateMeasurement:(RCTPromiseResolveBlock)resolve
@@ -1092,21 +1133,18 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
             }];
         }
 
-        [self debugLog:[NSString stringWithFormat:@"Discovered X3 device: %@", deviceName]];
+        BLE_LOG(self.log, BleLogLevelDebug, @"Discovered X3 device: %@", deviceName);
     }
 }
 
 - (void)ConnectSuccessfully {
     CBPeripheral *peripheral = [NewBle sharedManager].activityPeripheral;
-    [self debugLog:[NSString stringWithFormat:@"Connected to: %@", peripheral.name]];
+    BLE_LOG(self.log, BleLogLevelInfo, @"Connected to: %@", peripheral.name);
 
     self.connectedPeripheral = peripheral;
     self.connectedDeviceId = peripheral.identifier.UUIDString;
 
-    // Stop reconnection timer on successful connection
-    [self stopReconnectionTimer];
-    self.reconnectionAttempts = 0;
-    [self clearAccumulatedDataBuffers];
+    [self.fetchEngine abortWithReason:BleFetchAbortDisconnected];
     if (self.pendingDataResolver) {
         [self rejectPendingDataRequestWithCode:@"CONNECTION_RESET"
                                        message:@"Connection reset before pending data request completed"];
@@ -1142,30 +1180,24 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
     // Use EnableCommunicate below instead.
 }
 
-// Called after service+characteristic discovery completes (didDiscoverCharacteristicsForService → enable)
+// Called after service+characteristic discovery completes (didDiscoverCharacteristicsForService → enable).
+// Settings (auto HR monitoring, profile, step goal, clock) are no longer rewritten here on every
+// connect: JS diffs them against the ring's cached config and writes only what changed.
 - (void)EnableCommunicate {
-    [self enableAutomaticHRMonitoring];
+    if (self.hasListeners && self.connectedDeviceId) {
+        [self sendEventWithName:@"onDeviceReady" body:@{@"deviceId": self.connectedDeviceId}];
+    }
 }
 
 - (void)enableAutomaticHRMonitoring {
     if (!self.connectedPeripheral) return;
     [self debugLog:@"Enabling automatic HR monitoring (24/7, 5min interval)"];
 
-    MyAutomaticMonitoring_X3 config;
-    config.mode = 2;             // interval within time period
-    config.dataType = 1;         // 1 = heartRate
-    config.startTime_Hour = 0;
-    config.startTime_Minutes = 0;
-    config.endTime_Hour = 23;
-    config.endTime_Minutes = 59;
-    config.intervalTime = 5;     // every 5 minutes (minimum)
-    config.weeks.sunday = YES;
-    config.weeks.monday = YES;
-    config.weeks.Tuesday = YES;
-    config.weeks.Wednesday = YES;
-    config.weeks.Thursday = YES;
-    config.weeks.Friday = YES;
-    config.weeks.Saturday = YES;
+    // mode 2 = interval within time period, dataType 1 = heartRate, every 5 minutes (minimum)
+    MyAutomaticMonitoring_X3 config = [self automaticMonitoringFromConfig:@{
+        @"workMode": @2, @"dataType": @1, @"startTime": @"00:00", @"endTime": @"23:59",
+        @"weeks": @0x7f, @"intervalTime": @5
+    }];
 
     NSMutableData *cmd = [[BleSDK_X3 sharedManager] SetAutomaticHRMonitoring:config];
     [[NewBle sharedManager] writeValue:kJstyleServiceUUID
@@ -1176,17 +1208,15 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
 
 - (void)Disconnect:(NSError *)error {
     CBPeripheral *peripheral = self.connectedPeripheral;
-    [self debugLog:[NSString stringWithFormat:@"Disconnected from: %@ (error: %@)",
-                    peripheral.name ?: @"Unknown", error ? @"YES" : @"NO"]];
-
-    // Keep peripheral reference for potential reconnection
-    CBPeripheral *disconnectedPeripheral = self.connectedPeripheral;
+    BLE_LOG(self.log, BleLogLevelInfo, @"Disconnected from: %@ (error: %@)",
+            peripheral.name ?: @"Unknown", error ? @"YES" : @"NO");
 
     self.connectedPeripheral = nil;
     self.connectedDeviceId = nil;
     [self rejectPendingDataRequestWithCode:@"DISCONNECTED"
                                    message:@"Connection dropped before pending data request completed"];
-    [self clearAccumulatedDataBuffers];
+    [self.fetchEngine abortWithReason:BleFetchAbortDisconnected];
+    [self.realtimeCoalescer reset];
 
     if (self.hasListeners) {
         [self sendEventWithName:@"onConnectionStateChanged" body:@{
@@ -1195,10 +1225,9 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
         }];
     }
 
-    // Automatic reconnection if NOT intentional disconnect
-    if (!self.isDisconnecting && error && disconnectedPeripheral) {
-        [self debugLog:@"Unexpected disconnect - starting auto-reconnection"];
-        [self startReconnectionTimer:disconnectedPeripheral];
+    // Unexpected drops are reconnected by BleConnectionManager (pending connect + backoff)
+    if (!self.isDisconnecting && error) {
+        [self debugLog:@"Unexpected disconnect - BleConnectionManager will reconnect"];
     } else if (self.isDisconnecting) {
         [self debugLog:@"Intentional disconnect - no auto-reconnect"];
         self.isDisconnecting = NO;  // Reset flag
@@ -1212,12 +1241,12 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
 }
 
 - (void)ConnectFailedWithError:(NSError *)error {
-    [self debugLog:[NSString stringWithFormat:@"Failed to connect: %@", error.localizedDescription]];
+    BLE_LOG(self.log, BleLogLevelWarn, @"Failed to connect: %@", error.localizedDescription);
 
     if (self.pendingDataResolver) {
         [self rejectPendingDataRequestWithCode:@"CONNECTION_FAILED"
                                        message:@"Connection failed before pending data request completed"];
-        [self clearAccumulatedDataBuffers];
+        [self.fetchEngine abortWithReason:BleFetchAbortDisconnected];
     }
 
     if (self.pendingConnectRejecter) {
@@ -1228,16 +1257,20 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
 }
 
 - (void)BleCommunicateWithPeripheral:(CBPeripheral *)Peripheral data:(NSData *)data {
+    [self.fetchEngine recordBytes:data.length];
+
     // Parse response using BleSDK_X3
+    CFAbsoluteTime parseStart = CFAbsoluteTimeGetCurrent();
     DeviceData_X3 *parsed = [[BleSDK_X3 sharedManager] DataParsingWithData:data];
+    [[BleLinkStats sharedStats] recordParseMs:(CFAbsoluteTimeGetCurrent() - parseStart) * 1000.0];
 
     if (!parsed) {
-        [self debugLog:@"Failed to parse data"];
+        [self.log log:BleLogLevelWarn message:@"Failed to parse data"];
         return;
     }
 
-    [self debugLog:[NSString stringWithFormat:@"Received data type: %d, dataEnd: %d",
-                    (int)parsed.dataType, parsed.dataEnd]];
+    BLE_LOG(self.log, BleLogLevelDebug, @"Received data type: %d, dataEnd: %d",
+            (int)parsed.dataType, parsed.dataEnd);
 
     [self handleParsedData:parsed];
 }
@@ -1245,6 +1278,13 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
 #pragma mark - Data Parsing
 
 - (void)handleParsedData:(DeviceData_X3 *)parsed {
+    // History types (steps, sleep, HR, SpO2, ...) are paged by the fetch engine
+    if ([self.fetchEngine handlePacketForDataType:parsed.dataType
+                                          dicData:parsed.dicData
+                                          dataEnd:parsed.dataEnd]) {
+        return;
+    }
+
     switch (parsed.dataType) {
         case GetDeviceBattery_X3:
             [self handleBatteryData:parsed];
@@ -1254,55 +1294,18 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
             [self handleVersionData:parsed];
             break;
 
-        case TotalActivityData_X3:
-            [self handleStepsData:parsed];
-            break;
-
-        case DetailSleepData_X3:
-            [self handleSleepData:parsed];
-            break;
-
-        case DynamicHR_X3:
-        case StaticHR_X3:
-            [self handleHeartRateData:parsed];
-            break;
-
-        case AutomaticSpo2Data_X3:
-            [self handleSpO2Data:parsed];
-            break;
-
-        case TemperatureData_X3:
-            [self handleTemperatureData:parsed];
-            break;
-
-        case HRVData_X3:
-            [self handleHRVData:parsed];
+        case RealTimeStep_X3:
+            [self handleRealTimeData:parsed];
             break;
 
         case ActivityModeData_X3:
+        case StartActivityMode_X3:
+        case PauseActivityMode_X3:
+        case ContinueActivityMode_X3:
+        case StopActivityMode_X3:
             [self handleActivityModeData:parsed];
             break;
 
-        case sleepHrvData_X3:
-            [self handleSleepHRVData:parsed];
-            break;
-
-        case osaData_X3:
-            [self handleOSAData:parsed];
-            break;
-
-        case eovData_X3:
-            [self handleEOVData:parsed];
-            break;
-
-        case ppiData_X3:
-            [self handlePPIData:parsed];
-            break;
-
-        case RealTimeStep_X3:
-            [self handleRealTimeData:parsed];
-            break;
-
         case DeviceMeasurement_HR_X3:
             [self handleManualHRResult:parsed];
             break;
@@ -1339,8 +1342,20 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
             [self handleFactoryResetResponse:parsed];
             break;
 
+        case GetAutomaticMonitoring_X3:
+            [self handleGetAutoMonitoringResponse:parsed];
+            break;
+
         case SetAutomaticMonitoring_X3:
-            [self debugLog:@"Automatic HR monitoring configured successfully"];
+            [self handleSetAutoMonitoringResponse:parsed];
+            break;
+
+        case GetPersonalInfo_X3:
+            [self handleGetPersonalInfoResponse:parsed];
+            break;
+
+        case SetPersonalInfo_X3:
+            [self handleSetPersonalInfoResponse:parsed];
             break;
 
         case DataError_X3:
@@ -1348,7 +1363,7 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
             break;
 
         default:
-            [self debugLog:[NSString stringWithFormat:@"Unhandled data type: %d", (int)parsed.dataType]];
+            BLE_LOG(self.log, BleLogLevelDebug, @"Unhandled data type: %d", (int)parsed.dataType);
             break;
     }
 }
@@ -1357,12 +1372,12 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
     NSString *rawMessage = parsed.dicData[@"msg"] ?: parsed.dicData[@"message"] ?: parsed.dicData[@"error"];
     NSString *message = rawMessage ?: [NSString stringWithFormat:@"SDK returned DataError (pending data type %d)",
                                        (int)self.pendingDataType];
-    [self debugLog:[NSString stringWithFormat:@"DataError received: %@", message]];
+    BLE_LOG(self.log, BleLogLevelWarn, @"DataError received: %@", message);
     [self sendError:@"DATA_ERROR" message:message];
 
     if (self.pendingDataResolver) {
         [self rejectPendingDataRequestWithCode:@"DATA_ERROR" message:message];
-        [self clearAccumulatedDataBuffers];
+        [self.fetchEngine abortWithReason:BleFetchAbortError];
     }
 }
 
@@ -1397,340 +1412,190 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
     }
 }
 
-- (void)handleStepsData:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        [self.accumulatedStepsData addObject:parsed.dicData];
-    }
-
-    if (parsed.dataEnd) {
-        // All data received - normalize and return
-        NSMutableArray *normalizedData = [NSMutableArray array];
-
-        for (NSDictionary *record in self.accumulatedStepsData) {
-            NSMutableDictionary *normalized = [record mutableCopy];
-
-            // Convert distance from km to meters
-            if (record[@"distance"]) {
-                double distanceKm = [record[@"distance"] doubleValue];
-                normalized[@"distance"] = @(distanceKm * 1000);
-            }
-
-            [normalizedData addObject:normalized];
-        }
+#pragma mark - Paged History Fetch
 
-        if (self.pendingDataResolver && self.pendingDataType == TotalActivityData_X3) {
-            self.pendingDataResolver(@{@"data": normalizedData});
-            [self clearPendingDataRequest];
-        }
-
-        [self.accumulatedStepsData removeAllObjects];
-    } else {
-        // Only continue pagination if a pending request is still waiting for data
-        if (self.pendingDataResolver && self.pendingDataType == TotalActivityData_X3) {
-            NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetTotalActivityDataWithMode:2 withStartDate:nil];
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"Steps pagination stopped - no pending request"];
-            [self.accumulatedStepsData removeAllObjects];
-        }
-    }
-}
-
-- (void)handleSleepData:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        NSArray *arrayDetailSleepData = parsed.dicData[@"arrayDetailSleepData"];
-        if (arrayDetailSleepData && arrayDetailSleepData.count > 0) {
-            [self.accumulatedSleepData addObjectsFromArray:arrayDetailSleepData];
-        }
-    }
-
-    if (parsed.dataEnd) {
-        if (self.pendingDataResolver && self.pendingDataType == DetailSleepData_X3) {
-            [self debugLog:[NSString stringWithFormat:@"Sleep data complete: %lu records", (unsigned long)self.accumulatedSleepData.count]];
-
-            // Permanent log: last 3 records' raw quality arrays for stage verification
-            NSUInteger total = self.accumulatedSleepData.count;
-            NSUInteger start = total > 3 ? total - 3 : 0;
-            for (NSUInteger i = start; i < total; i++) {
-                NSDictionary *rec = self.accumulatedSleepData[i];
-                NSArray *quality = rec[@"arraySleepQuality"];
-                NSLog(@"🛏️ [raw][%lu] %@ %@min unit=%@ stages=%@",
-                      (unsigned long)i,
-                      rec[@"startTime_SleepData"],
-                      rec[@"totalSleepTime"],
-                      rec[@"sleepUnitLength"],
-                      quality ? [quality componentsJoinedByString:@","] : @"(none)");
-            }
-
-            NSArray *sleepDataCopy = [self.accumulatedSleepData copy];
-            self.pendingDataResolver(@{@"data": sleepDataCopy});
-            [self clearPendingDataRequest];
-        }
-
-        [self.accumulatedSleepData removeAllObjects];
-    } else {
-        // Only continue pagination if a pending request is still waiting for data
-        if (self.pendingDataResolver && self.pendingDataType == DetailSleepData_X3) {
-            [self debugLog:@"Requesting next page of sleep data"];
-            NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetDetailSleepDataWithMode:2 withStartDate:nil];
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"Sleep pagination stopped - no pending request"];
-            [self.accumulatedSleepData removeAllObjects];
-        }
+- (nullable NSDate *)dateFromRingString:(nullable NSString *)value {
+    const char *text = value.UTF8String;
+    double ms = 0;
+    if (!text || !BleRingDateParse(text, strlen(text), NULL, &ms)) {
+        return nil;
     }
+    return [NSDate dateWithTimeIntervalSince1970:ms / 1000.0];
 }
 
-- (void)handleHeartRateData:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        [self.accumulatedHRData addObject:parsed.dicData];
-    }
-
-    BOOL isDynamic = self.pendingDataType == DynamicHR_X3;
-    BOOL isStatic = self.pendingDataType == StaticHR_X3;
+- (void)registerFetchDescriptors {
+    BleSDK_X3 *sdk = [BleSDK_X3 sharedManager];
+    BleFetchDescriptor *steps =
+        [BleFetchDescriptor descriptorWithName:@"Steps" dataType:TotalActivityData_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetTotalActivityDataWithMode:mode withStartDate:nil]; }];
+    __weak typeof(self) weakSelf = self;
+    // 10-minute windows (per-minute arraySteps); the start date only applies to the first page
+    BleFetchDescriptor *detailActivity =
+        [BleFetchDescriptor descriptorWithName:@"Detail activity" dataType:DetailActivityData_X3 payloadKeys:@[@"arrayDetailActivityData"]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) {
+            return [sdk GetDetailActivityDataWithMode:mode withStartDate:mode == 0 ? weakSelf.detailActivityStartDate : nil];
+        }];
+    BleFetchDescriptor *sleep =
+        [BleFetchDescriptor descriptorWithName:@"Sleep" dataType:DetailSleepData_X3 payloadKeys:@[@"arrayDetailSleepData"]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetDetailSleepDataWithMode:mode withStartDate:nil]; }];
+
+    // Overnight streams; records are left as whole packets since their array keys vary by firmware
+    BleFetchDescriptor *continuousSpo2 =
+        [BleFetchDescriptor descriptorWithName:@"Continuous SpO2" dataType:kContinuousSpo2Fetch_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) {
+            return [sdk GetContinuousSpO2DataWithMode:mode withStartDate:mode == 0 ? weakSelf.continuousSpo2StartDate : nil];
+        }];
+    continuousSpo2.packetDataType = AutomaticSpo2Data_X3;
+    BleFetchDescriptor *sleepActivity =
+        [BleFetchDescriptor descriptorWithName:@"Sleep+activity" dataType:sleepAndAcitivityData_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) {
+            return [sdk GetSleepDetailAndActivityDataWithMode:mode withStartDate:mode == 0 ? weakSelf.sleepActivityStartDate : nil];
+        }];
 
-    if (parsed.dataEnd) {
-        if (self.pendingDataResolver && (isDynamic || isStatic)) {
-            NSArray *hrDataCopy = [self.accumulatedHRData copy];
-            self.pendingDataResolver(@{@"data": hrDataCopy});
-            [self clearPendingDataRequest];
-        }
+    // Also the live stream of a workout started with controlActivityMode
+    BleFetchDescriptor *activityMode =
+        [BleFetchDescriptor descriptorWithName:@"Activity mode" dataType:ActivityModeData_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetActivityModeDataWithMode:mode withStartDate:nil]; }];
+    activityMode.streamsWhenIdle = YES;
+
+    // X3 sends one record per packet (sleep: one array per packet) and flags the last with dataEnd
+    NSArray<BleFetchDescriptor *> *table = @[
+        steps,
+        detailActivity,
+        sleep,
+        sleepActivity,
+        [BleFetchDescriptor descriptorWithName:@"HR" dataType:DynamicHR_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetContinuousHRDataWithMode:mode withStartDate:nil]; }],
+        [BleFetchDescriptor descriptorWithName:@"Single HR" dataType:StaticHR_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetSingleHRDataWithMode:mode withStartDate:nil]; }],
+        [BleFetchDescriptor descriptorWithName:@"SpO2" dataType:AutomaticSpo2Data_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetAutomaticSpo2DataWithMode:mode withStartDate:nil]; }],
+        continuousSpo2,
+        [BleFetchDescriptor descriptorWithName:@"Temperature" dataType:TemperatureData_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetTemperatureDataWithMode:mode withStartDate:nil]; }],
+        [BleFetchDescriptor descriptorWithName:@"HRV" dataType:HRVData_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetHRVDataWithMode:mode withStartDate:nil]; }],
+        activityMode,
+        [BleFetchDescriptor descriptorWithName:@"Sleep HRV" dataType:sleepHrvData_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetSleepHRVDataWithMode:mode withStartDate:nil]; }],
+        [BleFetchDescriptor descriptorWithName:@"OSA" dataType:osaData_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetOSADataWithMode:mode withStartDate:nil]; }],
+        [BleFetchDescriptor descriptorWithName:@"EOV" dataType:eovData_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetEOVDataWithMode:mode withStartDate:nil]; }],
+        [BleFetchDescriptor descriptorWithName:@"PPI" dataType:ppiData_X3 payloadKeys:@[]
+                                  endDetection:BleFetchEndOnDataEnd
+                                commandForMode:^NSData *(int mode) { return [sdk GetPpiDataWithMode:mode withStartDate:nil]; }],
+    ];
 
-        [self.accumulatedHRData removeAllObjects];
-    } else {
-        if (self.pendingDataResolver && (isDynamic || isStatic)) {
-            NSMutableData *cmd;
-            if (isDynamic) {
-                cmd = [[BleSDK_X3 sharedManager] GetContinuousHRDataWithMode:2 withStartDate:nil];
+    steps.finish = ^NSDictionary *(NSArray *records, NSDictionary *lastPacket) {
+        (void)lastPacket;
+        // Convert distance from km to meters
+        NSMutableArray *normalizedData = [NSMutableArray arrayWithCapacity:records.count];
+        for (NSDictionary *record in records) {
+            if (record[@"distance"]) {
+                NSMutableDictionary *normalized = [record mutableCopy];
+                normalized[@"distance"] = @([record[@"distance"] doubleValue] * 1000);
+                [normalizedData addObject:normalized];
             } else {
-                cmd = [[BleSDK_X3 sharedManager] GetSingleHRDataWithMode:2 withStartDate:nil];
+                [normalizedData addObject:record];
             }
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"HR pagination stopped - no pending request"];
-            [self.accumulatedHRData removeAllObjects];
         }
-    }
-}
-
-- (void)handleSpO2Data:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        [self.accumulatedSpO2Data addObject:parsed.dicData];
-    }
-
-    if (parsed.dataEnd) {
-        if (self.pendingDataResolver && self.pendingDataType == AutomaticSpo2Data_X3) {
-            NSArray *spo2DataCopy = [self.accumulatedSpO2Data copy];
-            self.pendingDataResolver(@{@"data": spo2DataCopy});
-            [self clearPendingDataRequest];
+        return @{@"data": normalizedData};
+    };
+
+    sleep.finish = ^NSDictionary *(NSArray *records, NSDictionary *lastPacket) {
+        (void)lastPacket;
+        // Permanent log: last 3 records' raw quality arrays for stage verification
+        NSUInteger total = records.count;
+        NSUInteger start = total > 3 ? total - 3 : 0;
+        for (NSUInteger i = start; i < total; i++) {
+            NSDictionary *rec = records[i];
+            NSArray *quality = rec[@"arraySleepQuality"];
+            NSLog(@"🛏️ [raw][%lu] %@ %@min unit=%@ stages=%@",
+                  (unsigned long)i,
+                  rec[@"startTime_SleepData"],
+                  rec[@"totalSleepTime"],
+                  rec[@"sleepUnitLength"],
+                  quality ? [quality componentsJoinedByString:@","] : @"(none)");
         }
-
-        [self.accumulatedSpO2Data removeAllObjects];
-    } else {
-        if (self.pendingDataResolver && self.pendingDataType == AutomaticSpo2Data_X3) {
-            NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetAutomaticSpo2DataWithMode:2 withStartDate:nil];
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"SpO2 pagination stopped - no pending request"];
-            [self.accumulatedSpO2Data removeAllObjects];
-        }
-    }
-}
-
-- (void)handleTemperatureData:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        [self.accumulatedTempData addObject:parsed.dicData];
-    }
-
-    if (parsed.dataEnd) {
-        if (self.pendingDataResolver && self.pendingDataType == TemperatureData_X3) {
-            NSArray *tempDataCopy = [self.accumulatedTempData copy];
-            self.pendingDataResolver(@{@"data": tempDataCopy});
-            [self clearPendingDataRequest];
-        }
-
-        [self.accumulatedTempData removeAllObjects];
-    } else {
-        if (self.pendingDataResolver && self.pendingDataType == TemperatureData_X3) {
-            NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetTemperatureDataWithMode:2 withStartDate:nil];
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"Temperature pagination stopped - no pending request"];
-            [self.accumulatedTempData removeAllObjects];
-        }
-    }
-}
-
-- (void)handleHRVData:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        [self.accumulatedHRVData addObject:parsed.dicData];
-    }
-
-    if (parsed.dataEnd) {
-        if (self.pendingDataResolver && self.pendingDataType == HRVData_X3) {
-            NSArray *hrvDataCopy = [self.accumulatedHRVData copy];
-            self.pendingDataResolver(@{@"data": hrvDataCopy});
-            [self clearPendingDataRequest];
-        }
-
-        [self.accumulatedHRVData removeAllObjects];
-    } else {
-        if (self.pendingDataResolver && self.pendingDataType == HRVData_X3) {
-            NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetHRVDataWithMode:2 withStartDate:nil];
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"HRV pagination stopped - no pending request"];
-            [self.accumulatedHRVData removeAllObjects];
-        }
-    }
+        return @{@"data": records};
+    };
+
+    for (BleFetchDescriptor *descriptor in table) {
+        [self.fetchEngine registerDescriptor:descriptor];
+    }
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)deletableDataTypes {
+    static NSDictionary<NSString *, NSNumber *> *types;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        types = @{
+            @"getStepsData": @(TotalActivityData_X3),
+            @"getDetailActivityData": @(DetailActivityData_X3),
+            @"getSleepData": @(DetailSleepData_X3),
+            @"getSleepWithActivity": @(sleepAndAcitivityData_X3),
+            @"getHeartRateData": @(DynamicHR_X3),
+            @"getSingleHeartRateData": @(StaticHR_X3),
+            @"getSpO2Data": @(AutomaticSpo2Data_X3),
+            @"getContinuousSpO2Data": @(kContinuousSpo2Fetch_X3),
+            @"getTemperatureData": @(TemperatureData_X3),
+            @"getHRVData": @(HRVData_X3),
+            @"getActivityModeData": @(ActivityModeData_X3),
+            @"getSleepHRVData": @(sleepHrvData_X3),
+            @"getOSAData": @(osaData_X3),
+            @"getEOVData": @(eovData_X3),
+            @"getPPIData": @(ppiData_X3),
+        };
+    });
+    return types;
 }
 
-- (void)handleActivityModeData:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        [self.accumulatedActivityModeData addObject:parsed.dicData];
-    }
-
-    if (parsed.dataEnd) {
-        if (self.pendingDataResolver && self.pendingDataType == ActivityModeData_X3) {
-            NSArray *activityDataCopy = [self.accumulatedActivityModeData copy];
-            self.pendingDataResolver(@{@"data": activityDataCopy});
-            [self clearPendingDataRequest];
-        }
-        [self.accumulatedActivityModeData removeAllObjects];
-    } else {
-        if (self.pendingDataResolver && self.pendingDataType == ActivityModeData_X3) {
-            NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetActivityModeDataWithMode:2 withStartDate:nil];
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"Activity mode pagination stopped - no pending request"];
-            [self.accumulatedActivityModeData removeAllObjects];
-        }
-    }
+- (void)writeCommand:(NSData *)cmd {
+    [[NewBle sharedManager] writeValue:kJstyleServiceUUID
+                      characteristicUUID:kJstyleWriteCharUUID
+                                       p:self.connectedPeripheral
+                                    data:cmd];
 }
 
-- (void)handleSleepHRVData:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        [self.accumulatedSleepHRVData addObject:parsed.dicData];
-    }
-
-    if (parsed.dataEnd) {
-        if (self.pendingDataResolver && self.pendingDataType == sleepHrvData_X3) {
-            NSArray *sleepHrvDataCopy = [self.accumulatedSleepHRVData copy];
-            self.pendingDataResolver(@{@"data": sleepHrvDataCopy});
-            [self clearPendingDataRequest];
-        }
-        [self.accumulatedSleepHRVData removeAllObjects];
-    } else {
-        if (self.pendingDataResolver && self.pendingDataType == sleepHrvData_X3) {
-            NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetSleepHRVDataWithMode:2 withStartDate:nil];
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"Sleep HRV pagination stopped - no pending request"];
-            [self.accumulatedSleepHRVData removeAllObjects];
-        }
-    }
+- (void)fetchEngine:(BleFetchEngine *)engine writeCommand:(NSData *)command {
+    (void)engine;
+    [self writeCommand:command];
 }
 
-- (void)handleOSAData:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        [self.accumulatedOSAData addObject:parsed.dicData];
-    }
-
-    if (parsed.dataEnd) {
-        if (self.pendingDataResolver && self.pendingDataType == osaData_X3) {
-            NSArray *osaDataCopy = [self.accumulatedOSAData copy];
-            self.pendingDataResolver(@{@"data": osaDataCopy});
-            [self clearPendingDataRequest];
-        }
-        [self.accumulatedOSAData removeAllObjects];
-    } else {
-        if (self.pendingDataResolver && self.pendingDataType == osaData_X3) {
-            NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetOSADataWithMode:2 withStartDate:nil];
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"OSA pagination stopped - no pending request"];
-            [self.accumulatedOSAData removeAllObjects];
-        }
+- (void)fetchEngine:(BleFetchEngine *)engine didFinishDataType:(NSInteger)dataType result:(NSDictionary *)result {
+    (void)engine;
+    if (self.pendingDataResolver && self.pendingDataType == (DATATYPE_X3)dataType) {
+        self.pendingDataResolver(result);
+        [self clearPendingDataRequest];
     }
 }
 
-- (void)handleEOVData:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        [self.accumulatedEOVData addObject:parsed.dicData];
-    }
-
-    if (parsed.dataEnd) {
-        if (self.pendingDataResolver && self.pendingDataType == eovData_X3) {
-            NSArray *eovDataCopy = [self.accumulatedEOVData copy];
-            self.pendingDataResolver(@{@"data": eovDataCopy});
-            [self clearPendingDataRequest];
-        }
-        [self.accumulatedEOVData removeAllObjects];
-    } else {
-        if (self.pendingDataResolver && self.pendingDataType == eovData_X3) {
-            NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetEOVDataWithMode:2 withStartDate:nil];
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"EOV pagination stopped - no pending request"];
-            [self.accumulatedEOVData removeAllObjects];
-        }
+- (void)fetchEngine:(BleFetchEngine *)engine didDeleteDataType:(NSInteger)dataType {
+    (void)engine;
+    if (self.pendingDataResolver && self.pendingDataType == (DATATYPE_X3)dataType) {
+        self.pendingDataResolver(@{@"success": @YES});
+        [self clearPendingDataRequest];
     }
 }
 
-- (void)handlePPIData:(DeviceData_X3 *)parsed {
-    if (parsed.dicData) {
-        [self.accumulatedPPIData addObject:parsed.dicData];
-    }
-
-    if (parsed.dataEnd) {
-        if (self.pendingDataResolver && self.pendingDataType == ppiData_X3) {
-            NSArray *ppiDataCopy = [self.accumulatedPPIData copy];
-            self.pendingDataResolver(@{@"data": ppiDataCopy});
-            [self clearPendingDataRequest];
-        }
-        [self.accumulatedPPIData removeAllObjects];
-    } else {
-        if (self.pendingDataResolver && self.pendingDataType == ppiData_X3) {
-            NSMutableData *cmd = [[BleSDK_X3 sharedManager] GetPpiDataWithMode:2 withStartDate:nil];
-            [[NewBle sharedManager] writeValue:kJstyleServiceUUID
-                              characteristicUUID:kJstyleWriteCharUUID
-                                               p:self.connectedPeripheral
-                                            data:cmd];
-        } else {
-            [self debugLog:@"PPI pagination stopped - no pending request"];
-            [self.accumulatedPPIData removeAllObjects];
-        }
-    }
+- (void)fetchEngine:(BleFetchEngine *)engine log:(NSString *)message {
+    (void)engine;
+    [self debugLog:message];
 }
 
 #pragma mark - Background Notifications
@@ -1800,9 +1665,10 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
                        userInfo:@{@"type": @"battery_alert", @"level": @(level)}];
 }
 
+// Merged into frames at the configured rate; see configureRealTimeStream
 - (void)handleRealTimeData:(DeviceData_X3 *)parsed {
     if (self.hasListeners && parsed.dicData) {
-        [self sendEventWithName:@"onRealTimeData" body:parsed.dicData];
+        [self.realtimeCoalescer ingestPacket:parsed.dicData];
     }
 
     // HR alert fires in background even when JS bridge is not listening
@@ -1812,6 +1678,18 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
     }
 }
 
+// Live workout packets and the ring's acks of start / pause / continue / stop. Forwarded
+// as-is with the packet type; WorkoutSession normalizes them at 1 Hz.
+- (void)handleActivityModeData:(DeviceData_X3 *)parsed {
+    if (!self.hasListeners) {
+        return;
+    }
+    NSMutableDictionary *body = [NSMutableDictionary dictionaryWithDictionary:parsed.dicData ?: @{}];
+    body[@"packetType"] = @(parsed.dataType);
+    body[@"timestamp"] = @([[NSDate date] timeIntervalSince1970] * 1000);
+    [self sendEventWithName:@"onActivityModeData" body:body];
+}
+
 - (void)handleManualHRResult:(DeviceData_X3 *)parsed {
     if (self.hasListeners && parsed.dicData) {
         NSMutableDictionary *result = [parsed.dicData mutableCopy];
@@ -1900,73 +1778,64 @@ RCT_EXPORT_METHOD(stopMeasurement:(RCTPromiseResolveBlock)resolve
     }
 }
 
-- (void)handleMacAddressResponse:(DeviceData_X3 *)parsed {
-    if (self.pendingDataResolver && self.pendingDataType == GetDeviceMacAddress_X3) {
-        NSString *macAddress = parsed.dicData[@"macAddress"] ?: @"N/A";
-        self.pendingDataResolver(@{@"mac": macAddress});
+- (void)handleGetAutoMonitoringResponse:(DeviceData_X3 *)parsed {
+    if (self.pendingDataResolver && self.pendingDataType == GetAutomaticMonitoring_X3) {
+        NSDictionary *dic = parsed.dicData ?: @{};
+        self.pendingDataResolver(@{
+            @"workMode": dic[@"workMode"] ?: @0,
+            @"startTime": dic[@"startTime"] ?: @"00:00",
+            @"endTime": dic[@"endTime"] ?: @"00:00",
+            @"weeks": dic[@"weeks"] ?: @0,
+            @"intervalTime": dic[@"intervalTime"] ?: @0,
+            @"dataType": dic[@"dataType"] ?: @0
+        });
         [self clearPendingDataRequest];
     }
 }
 
-- (void)handleFactoryResetResponse:(DeviceData_X3 *)parsed {
-    if (self.pendingDataResolver && self.pendingDataType == FactoryReset_X3) {
+- (void)handleSetAutoMonitoringResponse:(DeviceData_X3 *)parsed {
+    [self debugLog:@"Automatic monitoring configured successfully"];
+    if (self.pendingDataResolver && self.pendingDataType == SetAutomaticMonitoring_X3) {
         self.pendingDataResolver(@{@"success": @YES});
         [self clearPendingDataRequest];
     }
 }
 
-#pragma mark - Connection Stability Helpers
-
-- (void)startReconnectionTimer:(CBPeripheral *)peripheral {
-    if (!peripheral) {
-        [self debugLog:@"Cannot start reconnection timer - no peripheral"];
-        return;
+- (void)handleGetPersonalInfoResponse:(DeviceData_X3 *)parsed {
+    if (self.pendingDataResolver && self.pendingDataType == GetPersonalInfo_X3) {
+        NSDictionary *dic = parsed.dicData ?: @{};
+        // Back to the JS encoding (0=male, 1=female); see setUserInfo
+        int gender = [dic[@"gender"] intValue] == 1 ? 0 : 1;
+        self.pendingDataResolver(@{
+            @"gender": @(gender),
+            @"age": dic[@"age"] ?: @0,
+            @"height": dic[@"height"] ?: @0,
+            @"weight": dic[@"weight"] ?: @0,
+            @"stride": dic[@"stride"] ?: @0
+        });
+        [self clearPendingDataRequest];
     }
-
-    [self stopReconnectionTimer];
-
-    [self debugLog:[NSString stringWithFormat:@"Starting reconnection timer (attempt %ld)", (long)self.reconnectionAttempts + 1]];
-
-    // Store peripheral for reconnection attempts
-    __weak typeof(self) weakSelf = self;
-    __weak CBPeripheral *weakPeripheral = peripheral;
-
-    self.reconnectionTimer = [NSTimer scheduledTimerWithTimeInterval:self.reconnectionInterval
-                                                              target:weakSelf
-                                                            selector:@selector(attemptReconnectionWithTimer:)
-                                                            userInfo:weakPeripheral
-                                                             repeats:YES];
 }
 
-- (void)stopReconnectionTimer {
-    if (self.reconnectionTimer) {
-        [self debugLog:@"Stopping reconnection timer"];
-        [self.reconnectionTimer invalidate];
-        self.reconnectionTimer = nil;
+- (void)handleSetPersonalInfoResponse:(DeviceData_X3 *)parsed {
+    if (self.pendingDataResolver && self.pendingDataType == SetPersonalInfo_X3) {
+        self.pendingDataResolver(@{@"success": @YES});
+        [self clearPendingDataRequest];
     }
 }
 
-- (void)attemptReconnectionWithTimer:(NSTimer *)timer {
-    CBPeripheral *peripheral = timer.userInfo;
-
-    if (!peripheral) {
-        [self debugLog:@"No peripheral to reconnect to - stopping timer"];
-        [self stopReconnectionTimer];
-        return;
+- (void)handleMacAddressResponse:(DeviceData_X3 *)parsed {
+    if (self.pendingDataResolver && self.pendingDataType == GetDeviceMacAddress_X3) {
+        NSString *macAddress = parsed.dicData[@"macAddress"] ?: @"N/A";
+        self.pendingDataResolver(@{@"mac": macAddress});
+        [self clearPendingDataRequest];
     }
+}
 
-    self.reconnectionAttempts++;
-    [self debugLog:[NSString stringWithFormat:@"Reconnection attempt %ld to %@",
-                    (long)self.reconnectionAttempts, peripheral.name]];
-
-    // Use NewBle's connectDevice which will trigger ConnectSuccessfully on success
-    [[NewBle sharedManager] connectDevice:peripheral];
-
-    // Optional: Stop after max attempts (e.g., 20 attempts = 2 minutes)
-    if (self.reconnectionAttempts >= 20) {
-        [self debugLog:@"Max reconnection attempts reached - stopping"];
-        [self stopReconnectionTimer];
-        self.reconnectionAttempts = 0;
+- (void)handleFactoryResetResponse:(DeviceData_X3 *)parsed {
+    if (self.pendingDataResolver && self.pendingDataType == FactoryReset_X3) {
+        self.pendingDataResolver(@{@"success": @YES});
+        [self clearPendingDataRequest];
     }
 }
 
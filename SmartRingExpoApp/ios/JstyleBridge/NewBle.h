@@ -50,6 +50,11 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)startScanningWithServices:(nullable NSArray<CBUUID *> *)serviceUUIDs;
 
 - (void)connectDevice:(CBPeripheral*)peripheral;
+
+/**
+ Description Re-adopt a peripheral that is still connected after state restoration (rediscovers services, notifies the delegate)
+ */
+- (void)resumeConnectedPeripheral:(CBPeripheral*)peripheral;
 #pragma mark 获取已经被系统蓝牙连接的设备
 - (NSArray *)retrieveConnectedPeripheralsWithServices:(NSArray<CBUUID *> *)serviceUUIDs;
 
@@ -8,12 +8,17 @@
 //
 
 #import "NewBle.h"
+#import "BleSyncStats.h"
+#import "BleConnectionManager.h"
 
 // X3 BLE Protocol UUIDs
 #define SERVICE    @"FFF0"
 #define SEND_CHAR  @"FFF6"
 #define REC_CHAR   @"FFF7"
 
+// Lets iOS relaunch the app for ring events after it was suspended or killed
+static NSString *const kCentralRestoreIdentifier = @"com.focusring.app.central";
+
 // No-op replacement for demo's file-based logging
 static inline void writeLogs(NSString *msg, NSString *file) {
 }
@@ -41,7 +46,7 @@ static inline void writeLogs(NSString *msg, NSString *file) {
     self = [super init];
     if (self) {
         // Auto-initialize the central manager so it's ready for scanning
-        CentralManage = [[CBCentralManager alloc] initWithDelegate:self queue:nil];
+        CentralManage = [[CBCentralManager alloc] initWithDelegate:self queue:nil options:[self centralOptions]];
     }
     return self;
 }
@@ -49,10 +54,15 @@ static inline void writeLogs(NSString *msg, NSString *file) {
 - (void)SetUpCentralManager
 {
     if (!CentralManage) {
-        CentralManage = [[CBCentralManager alloc] initWithDelegate:self queue:nil];
+        CentralManage = [[CBCentralManager alloc] initWithDelegate:self queue:nil options:[self centralOptions]];
     }
 }
 
+- (NSDictionary *)centralOptions
+{
+    return @{CBCentralManagerOptionRestoreIdentifierKey: kCentralRestoreIdentifier};
+}
+
 - (void)SetUpPeripheralManager
 {
 
@@ -99,6 +109,7 @@ static inline void writeLogs(NSString *msg, NSString *file) {
       activityPeripheral = peripheral;
       activityPeripheral.delegate = self;
       peripheral.delegate = self;
+     [[BleLinkStats sharedStats] connectRequested];
      [CentralManage connectPeripheral:peripheral options:options];
 }
 
@@ -150,6 +161,7 @@ static void (^BLE_Block_Receive)(Byte* _Nullable buf,int length);
     {
         return;
     }
+    [[BleLinkStats sharedStats] recordOutbound:data.length];
     [p writeValue:data forCharacteristic:characteristic type:CBCharacteristicWriteWithoutResponse];
 }
 
@@ -174,6 +186,7 @@ static void (^BLE_Block_Receive)(Byte* _Nullable buf,int length);
     {
         return;
     }
+    [[BleLinkStats sharedStats] recordOutbound:data.length];
     [p writeValue:data forCharacteristic:characteristic type:CBCharacteristicWriteWithResponse];
 }
 
@@ -270,11 +283,26 @@ static void (^BLE_Block_Receive)(Byte* _Nullable buf,int length);
 }
 
 - (void)centralManagerDidUpdateState:(nonnull CBCentralManager *)central {
+    [[BleConnectionManager sharedManager] handleCentralState:central.state];
 }
 
 - (void)centralManager:(CBCentralManager *)central willRestoreState:(NSDictionary<NSString *, id> *)dict
 {
+    // Only one ring is ever connected; if the previous process had more, keep the first
+    CBPeripheral *peripheral = [dict[CBCentralManagerRestoredStatePeripheralsKey] firstObject];
+    if (!peripheral) {
+        return;
+    }
+    activityPeripheral = peripheral;
+    peripheral.delegate = self;
+    [[BleConnectionManager sharedManager] handleRestoredPeripheral:peripheral];
+}
 
+- (void)resumeConnectedPeripheral:(CBPeripheral *)peripheral
+{
+    activityPeripheral = peripheral;
+    peripheral.delegate = self;
+    [self centralManager:CentralManage didConnectPeripheral:peripheral];
 }
 
 - (void)centralManager:(CBCentralManager *)central didDiscoverPeripheral:(CBPeripheral *)peripheral advertisementData:(NSDictionary<NSString *, id> *)advertisementData RSSI:(NSNumber *)RSSI
@@ -284,12 +312,16 @@ static void (^BLE_Block_Receive)(Byte* _Nullable buf,int length);
 
 - (void)centralManager:(CBCentralManager *)central didConnectPeripheral:(CBPeripheral *)peripheral
 {
+    [[BleLinkStats sharedStats] didConnect];
+    [[BleConnectionManager sharedManager] handleConnected:peripheral];
     [peripheral discoverServices:nil];
     [self.delegate ConnectSuccessfully];
 }
 
 - (void)centralManager:(CBCentralManager *)central didFailToConnectPeripheral:(CBPeripheral *)peripheral error:(nullable NSError *)error
 {
+    [[BleLinkStats sharedStats] connectFailed];
+    [[BleConnectionManager sharedManager] handleConnectFailed:peripheral];
     [self.delegate ConnectFailedWithError:error];
 }
 
@@ -297,11 +329,10 @@ static void (^BLE_Block_Receive)(Byte* _Nullable buf,int length);
 {
     NSString * strError = [NSString stringWithFormat:@"Device %@ disconnected: %@",peripheral.name,error.description];
     writeLogs(strError, @"Ble SDK Demo.txt");
-    if(error)
-    {
-        [central connectPeripheral:peripheral options:nil];
-    }
+    [[BleLinkStats sharedStats] didDisconnectWithError:error];
+    // Reconnect (or not) is the manager's call; notify the bridge first so it sees a clean disconnect
      [self.delegate Disconnect:error];
+    [[BleConnectionManager sharedManager] handleDisconnect:peripheral error:error];
 }
 
 #pragma mark - CBPeripheralDelegate
@@ -336,7 +367,10 @@ static void (^BLE_Block_Receive)(Byte* _Nullable buf,int length);
 - (void)peripheral:(CBPeripheral *)peripheral didDiscoverCharacteristicsForService:(CBService *)service error:(nullable NSError *)error
 {
     if([service isEqual:peripheral.services.lastObject])
+    {
+        [[BleLinkStats sharedStats] servicesReady];
         [self enable];
+    }
 }
 
 - (void)peripheral:(CBPeripheral *)peripheral didUpdateValueForCharacteristic:(CBCharacteristic *)characteristic error:(nullable NSError *)error
@@ -351,6 +385,7 @@ static void (^BLE_Block_Receive)(Byte* _Nullable buf,int length);
         }
         strData = [@"Receive:" stringByAppendingString:[NSString stringWithFormat:@"(length:%d) %@",(int)characteristic.value.length,strData]];
         writeLogs(strData, @"Ble SDK Demo.txt");
+        [[BleLinkStats sharedStats] recordInbound:characteristic.value.length];
         [self.delegate BleCommunicateWithPeripheral:peripheral data:characteristic.value];
     }
 }
@@ -10,7 +10,12 @@
 #import "BleSDK_V8.h"
 #import "BleSDK_Header_V8.h"
 #import "DeviceData_V8.h"
-#import <React/RCTLog.h>
+#import "BleFetchEngine.h"
+#import "BleSyncStats.h"
+#import "BleRealtimeCoalescer.h"
+#import "BleLogQueue.h"
+#import "BleConnectionManager.h"
+#import "BleRingDate.h"
 #import <CoreBluetooth/CoreBluetooth.h>
 
 static NSString *const kV8ServiceUUID = @"FFF0";
@@ -19,7 +24,7 @@ static NSString *const kV8NotifyCharUUID = @"FFF7";
 static NSString *const kV8PairedDeviceUUIDKey = @"V8PairedDeviceUUID";
 static NSString *const kV8PairedDeviceNameKey = @"V8PairedDeviceName";
 
-@interface V8Bridge () <MyBleDelegate>
+@interface V8Bridge () <MyBleDelegate, BleFetchEngineDelegate>
 
 @property (nonatomic, assign) BOOL hasListeners;
 @property (nonatomic, strong) NSMutableArray<NSDictionary *> *discoveredDevices;
@@ -31,26 +36,20 @@ static NSString *const kV8PairedDeviceNameKey = @"V8PairedDeviceName";
 @property (nonatomic, copy) RCTPromiseRejectBlock pendingConnectRejecter;
 
 // Pagination state for data retrieval
-@property (nonatomic, strong) NSMutableArray *accumulatedStepsData;
-@property (nonatomic, strong) NSMutableArray *accumulatedSleepData;
-@property (nonatomic, strong) NSMutableArray *accumulatedHRData;
-@property (nonatomic, strong) NSMutableArray *accumulatedSpO2Data;
-@property (nonatomic, strong) NSMutableArray *accumulatedTempData;
-@property (nonatomic, strong) NSMutableArray *accumulatedHRVData;
-@property (nonatomic, strong) NSMutableArray *accumulatedActivityModeData;
-@property (nonatomic, strong) NSMutableArray *accumulatedSleepActivityData;
-@property (nonatomic, strong) NSMutableArray *accumulatedPPIData;
+@property (nonatomic, strong) BleFetchEngine *fetchEngine;
+@property (nonatomic, strong) BleRealtimeCoalescer *realtimeCoalescer;
+@property (nonatomic, strong) BleLogQueue *log;
 @property (nonatomic, copy) RCTPromiseResolveBlock pendingDataResolver;
 @property (nonatomic, copy) RCTPromiseRejectBlock pendingDataRejecter;
 @property (nonatomic, assign) DATATYPE_V8 pendingDataType;
 @property (nonatomic, strong) NSTimer *pendingDataWatchdogTimer;
 @property (nonatomic, assign) NSTimeInterval pendingDataTimeoutInterval;
-@property (nonatomic, strong) NSTimer *sleepActivityIdleTimer;
+@property (nonatomic, assign) NSUInteger watchdogFires;
+/// Incremental cursor for detail activity: the band resumes from the record stamped with this date.
+@property (nonatomic, strong, nullable) NSDate *detailActivityStartDate;
 
 // Connection stability
 @property (nonatomic, assign) BOOL isDisconnecting;
-@property (nonatomic, strong) NSTimer *reconnectionTimer;
-@property (nonatomic, assign) NSInteger reconnectionAttempts;
 
 @end
 
@@ -62,19 +61,29 @@ RCT_EXPORT_MODULE();
     self = [super init];
     if (self) {
         _discoveredDevices = [NSMutableArray array];
-        _accumulatedStepsData = [NSMutableArray array];
-        _accumulatedSleepData = [NSMutableArray array];
-        _accumulatedHRData = [NSMutableArray array];
-        _accumulatedSpO2Data = [NSMutableArray array];
-        _accumulatedTempData = [NSMutableArray array];
-        _accumulatedHRVData = [NSMutableArray array];
-        _accumulatedActivityModeData = [NSMutableArray array];
-        _accumulatedSleepActivityData = [NSMutableArray array];
-        _accumulatedPPIData = [NSMutableArray array];
+        _fetchEngine = [[BleFetchEngine alloc] init];
+        _fetchEngine.delegate = self;
+        [self registerFetchDescriptors];
+        __weak V8Bridge *weakSelf = self;
+        _realtimeCoalescer = [[BleRealtimeCoalescer alloc] initWithFrameHandler:^(NSDictionary *frame) {
+            V8Bridge *strongSelf = weakSelf;
+            if (strongSelf.hasListeners) {
+                [strongSelf sendEventWithName:@"V8RealTimeData" body:frame];
+            }
+        }];
+        _log = [[BleLogQueue alloc] initWithName:@"V8Bridge" batchHandler:^(NSData *batch, NSUInteger count, NSUInteger dropped) {
+            V8Bridge *strongSelf = weakSelf;
+            if (strongSelf.hasListeners) {
+                [strongSelf sendEventWithName:@"V8DebugLog" body:@{
+                    @"batch": [batch base64EncodedStringWithOptions:0],
+                    @"count": @(count),
+                    @"dropped": @(dropped),
+                }];
+            }
+        }];
         _pendingDataType = DataError_V8;
         _pendingDataTimeoutInterval = 20.0;
         _isDisconnecting = NO;
-        _reconnectionAttempts = 0;
     }
     return self;
 }
@@ -91,6 +100,8 @@ RCT_EXPORT_MODULE();
         @"V8RealTimeData",
         @"V8MeasurementResult",
         @"V8BatteryData",
+        @"V8ActivityModeData",
+        @"V8DeviceReady",
         @"V8Error",
         @"V8DebugLog"
     ];
@@ -106,14 +117,9 @@ RCT_EXPORT_MODULE();
 
 #pragma mark - Helper Methods
 
+// Enqueue only: self.log batches entries into V8DebugLog off this thread
 - (void)debugLog:(NSString *)message {
-    RCTLogInfo(@"V8Bridge: %@", message);
-    if (self.hasListeners) {
-        [self sendEventWithName:@"V8DebugLog" body:@{
-            @"message": message,
-            @"timestamp": @([[NSDate date] timeIntervalSince1970] * 1000)
-        }];
-    }
+    [self.log log:BleLogLevelInfo message:message];
 }
 
 - (void)sendError:(NSString *)code message:(NSString *)message {
@@ -157,7 +163,6 @@ RCT_EXPORT_MODULE();
 
 - (void)clearPendingDataRequest {
     [self invalidatePendingDataWatchdog];
-    [self invalidateSleepActivityIdleTimer];
     self.pendingDataResolver = nil;
     self.pendingDataRejecter = nil;
     self.pendingDataType = DataError_V8;
@@ -176,9 +181,10 @@ RCT_EXPORT_MODULE();
     if (!self.pendingDataResolver) return;
     NSString *message = [NSString stringWithFormat:@"V8 pending data request timed out (data type %d)",
                          (int)self.pendingDataType];
-    [self debugLog:message];
+    [self.log log:BleLogLevelWarn message:message];
+    self.watchdogFires += 1;
     [self rejectPendingDataRequestWithCode:@"NATIVE_TIMEOUT" message:message];
-    [self clearAccumulatedDataBuffers];
+    [self.fetchEngine abortWithReason:BleFetchAbortTimeout];
 }
 
 - (void)invalidatePendingDataWatchdog {
@@ -188,66 +194,11 @@ RCT_EXPORT_MODULE();
     }
 }
 
-- (void)resetSleepActivityIdleTimer {
-    if (self.sleepActivityIdleTimer) {
-        [self.sleepActivityIdleTimer invalidate];
-        self.sleepActivityIdleTimer = nil;
-    }
-    self.sleepActivityIdleTimer = [NSTimer scheduledTimerWithTimeInterval:3.0
-                                                                    target:self
-                                                                  selector:@selector(sleepActivityIdleTimerFired:)
-                                                                  userInfo:nil
-                                                                   repeats:NO];
-}
-
-- (void)invalidateSleepActivityIdleTimer {
-    if (self.sleepActivityIdleTimer) {
-        [self.sleepActivityIdleTimer invalidate];
-        self.sleepActivityIdleTimer = nil;
-    }
-}
-
-- (void)sleepActivityIdleTimerFired:(NSTimer *)timer {
-    (void)timer;
-    if (!self.pendingDataResolver) return;
-    NSArray *resolveData = nil;
-    NSString *logTag = @"[V8Idle]";
-    if (self.pendingDataType == DetailSleepAndActivityData_V8) {
-        resolveData = [self.accumulatedSleepActivityData copy];
-        logTag = @"[V8SleepActivity]";
-        [self.accumulatedSleepActivityData removeAllObjects];
-    } else if (self.pendingDataType == DynamicHR_V8) {
-        resolveData = [self.accumulatedHRData copy];
-        logTag = @"[V8HR]";
-        [self.accumulatedHRData removeAllObjects];
-    } else if (self.pendingDataType == HRVData_V8) {
-        resolveData = [self.accumulatedHRVData copy];
-        logTag = @"[V8HRV]";
-        [self.accumulatedHRVData removeAllObjects];
-    } else {
-        return;
-    }
-    self.pendingDataResolver(@{@"data": resolveData});
-    [self clearPendingDataRequest];
-}
-
-- (void)clearAccumulatedDataBuffers {
-    [self.accumulatedStepsData removeAllObjects];
-    [self.accumulatedSleepData removeAllObjects];
-    [self.accumulatedHRData removeAllObjects];
-    [self.accumulatedSpO2Data removeAllObjects];
-    [self.accumulatedTempData removeAllObjects];
-    [self.accumulatedHRVData removeAllObjects];
-    [self.accumulatedActivityModeData removeAllObjects];
-    [self.accumulatedSleepActivityData removeAllObjects];
-    [self.accumulatedPPIData removeAllObjects];
-}
-
 - (void)claimDelegate {
     [[NewBle sharedManager] setDelegate:self];
 }
 
-- (void)writeCommand:(NSMutableData *)cmd {
+- (void)writeCommand:(NSData *)cmd {
     [[NewBle sharedManager] writeValue:kV8ServiceUUID
                       characteristicUUID:kV8WriteCharUUID
                                        p:self.connectedPeripheral
@@ -293,7 +244,7 @@ RCT_EXPORT_METHOD(stopScan:(RCTPromiseResolveBlock)resolve
 RCT_EXPORT_METHOD(connectToDevice:(NSString *)deviceId
                   resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    [self debugLog:[NSString stringWithFormat:@"V8 connecting to device: %@", deviceId]];
+    BLE_LOG(self.log, BleLogLevelInfo, @"V8 connecting to device: %@", deviceId);
     [self claimDelegate];
 
     CBPeripheral *peripheral = nil;
@@ -321,16 +272,16 @@ RCT_EXPORT_METHOD(connectToDevice:(NSString *)deviceId
 
     self.pendingConnectResolver = resolve;
     self.pendingConnectRejecter = reject;
-    [[NewBle sharedManager] connectDevice:peripheral];
+    [[BleConnectionManager sharedManager] connectPeripheral:peripheral];
 }
 
 RCT_EXPORT_METHOD(disconnect:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     [self debugLog:@"V8 disconnecting (intentional)"];
     self.isDisconnecting = YES;
-    [self stopReconnectionTimer];
+    [[BleConnectionManager sharedManager] stopReconnecting];
     [self rejectPendingDataRequestWithCode:@"DISCONNECTED" message:@"V8 disconnected"];
-    [self clearAccumulatedDataBuffers];
+    [self.fetchEngine abortWithReason:BleFetchAbortDisconnected];
 
     if (self.connectedPeripheral) {
         [self claimDelegate];
@@ -393,6 +344,8 @@ RCT_EXPORT_METHOD(forgetPairedDevice:(RCTPromiseResolveBlock)resolve
     [[NSUserDefaults standardUserDefaults] synchronize];
 
     if (self.connectedPeripheral) {
+        self.isDisconnecting = YES;
+        [[BleConnectionManager sharedManager] stopReconnecting];
         [self claimDelegate];
         [[NewBle sharedManager] Disconnect];
         self.connectedPeripheral = nil;
@@ -413,28 +366,18 @@ RCT_EXPORT_METHOD(autoReconnect:(RCTPromiseResolveBlock)resolve
 
     [self claimDelegate];
 
-    NSUUID *uuid = [[NSUUID alloc] initWithUUIDString:pairedUUID];
-    if (uuid) {
-        NSArray *peripherals = [[NewBle sharedManager].CentralManage retrievePeripheralsWithIdentifiers:@[uuid]];
-        if (peripherals.count > 0) {
-            CBPeripheral *peripheral = peripherals[0];
-            self.pendingConnectResolver = resolve;
-            self.pendingConnectRejecter = reject;
-            [[NewBle sharedManager] connectDevice:peripheral];
-            return;
-        }
-    }
-
+    // Known to CoreBluetooth (cache or system-connected): connect directly, no scan
     CBUUID *serviceUUID = [CBUUID UUIDWithString:kV8ServiceUUID];
-    NSArray *peripherals = [[NewBle sharedManager] retrieveConnectedPeripheralsWithServices:@[serviceUUID]];
-    if (peripherals.count > 0) {
-        CBPeripheral *peripheral = peripherals[0];
-        self.pendingConnectResolver = resolve;
-        self.pendingConnectRejecter = reject;
-        [[NewBle sharedManager] connectDevice:peripheral];
-    } else {
+    CBPeripheral *peripheral = [[BleConnectionManager sharedManager] retrievePeripheralWithIdentifier:pairedUUID
+                                                                                             services:@[serviceUUID]];
+    if (!peripheral) {
         resolve(@{@"success": @NO, @"message": @"V8 paired device not found nearby"});
+        return;
     }
+
+    self.pendingConnectResolver = resolve;
+    self.pendingConnectRejecter = reject;
+    [[BleConnectionManager sharedManager] connectPeripheral:peripheral];
 }
 
 RCT_EXPORT_METHOD(cancelPendingDataRequest:(RCTPromiseResolveBlock)resolve
@@ -444,7 +387,7 @@ RCT_EXPORT_METHOD(cancelPendingDataRequest:(RCTPromiseResolveBlock)resolve
     } else {
         [self clearPendingDataRequest];
     }
-    [self clearAccumulatedDataBuffers];
+    [self.fetchEngine abortWithReason:BleFetchAbortCancelled];
     resolve(@{@"success": @YES});
 }
 
@@ -501,122 +444,276 @@ RCT_EXPORT_METHOD(setUserInfo:(NSDictionary *)userInfo
     resolve(@{@"success": @YES});
 }
 
+#pragma mark - Paged History Fetch
+
+- (nullable NSDate *)dateFromRingString:(nullable NSString *)value {
+    const char *text = value.UTF8String;
+    double ms = 0;
+    if (!text || !BleRingDateParse(text, strlen(text), NULL, &ms)) {
+        return nil;
+    }
+    return [NSDate dateWithTimeIntervalSince1970:ms / 1000.0];
+}
+
+- (void)registerFetchDescriptors {
+    BleSDK_V8 *sdk = [BleSDK_V8 sharedManager];
+
+    BleFetchDescriptor *hr =
+        [BleFetchDescriptor descriptorWithName:@"HR" dataType:DynamicHR_V8 payloadKeys:@[@"arrayContinuousHR"]
+                                  endDetection:BleFetchEndOnDataEndOrIdle
+                                commandForMode:^NSData *(int mode) {
+            if (mode != 0) {
+                return [sdk GetContinuousHRDataWithMode:mode withStartDate:nil];
+            }
+            // Request only last 2 days — avoids transferring full history (can be 3000+ records)
+            NSDate *twoDaysAgo = [NSDate dateWithTimeIntervalSinceNow:-2 * 24 * 3600];
+            NSDateFormatter *fmt = [[NSDateFormatter alloc] init];
+            fmt.dateFormat = @"YYYY.MM.dd";
+            NSDate *startDate = [fmt dateFromString:[fmt stringFromDate:twoDaysAgo]];
+            return [sdk GetContinuousHRDataWithMode:0 withStartDate:startDate];
+        }];
+
+    __weak typeof(self) weakSelf = self;
+    // 10-minute windows (per-minute arraySteps); the start date only applies to the first page
+    BleFetchDescriptor *detailActivity =
+        [BleFetchDescriptor descriptorWithName:@"Detail activity" dataType:DetailActivityData_V8 payloadKeys:@[@"arrayDetailActivityData"]
+                                  endDetection:BleFetchEndOnShortPage
+                                commandForMode:^NSData *(int mode) {
+            return [sdk GetDetailActivityDataWithMode:mode withStartDate:mode == 0 ? weakSelf.detailActivityStartDate : nil];
+        }];
+
+    BleFetchDescriptor *activityMode =
+        [BleFetchDescriptor descriptorWithName:@"Activity mode" dataType:ActivityModeData_V8 payloadKeys:@[@"arrayActivityModeData"]
+                                  endDetection:BleFetchEndOnShortPage
+                                commandForMode:^NSData *(int mode) { return [sdk GetActivityModeDataWithMode:mode withStartDate:nil needMETS:NO]; }];
+    activityMode.streamsWhenIdle = YES;
+    activityMode.finish = ^NSDictionary *(NSArray *records, NSDictionary *lastPacket) {
+        return @{
+            @"data": records,
+            @"activityMode": lastPacket[@"activityMode"] ?: @(-1)
+        };
+    };
+
+    // V8 packs up to 50 records per packet. Most types end on a short page; HR, HRV and
+    // sleep+activity only page on a full 50 and some firmware goes silent instead of
+    // sending dataEnd, so those also finish after an idle gap.
+    NSArray<BleFetchDescriptor *> *table = @[
+        [BleFetchDescriptor descriptorWithName:@"Steps" dataType:TotalActivityData_V8 payloadKeys:@[@"arrayTotalActivityData"]
+                                  endDetection:BleFetchEndOnShortPage
+                                commandForMode:^NSData *(int mode) { return [sdk GetTotalActivityDataWithMode:mode withStartDate:nil]; }],
+        detailActivity,
+        [BleFetchDescriptor descriptorWithName:@"Sleep" dataType:DetailSleepData_V8 payloadKeys:@[@"arrayDetailSleepData"]
+                                  endDetection:BleFetchEndOnShortPage
+                                commandForMode:^NSData *(int mode) { return [sdk GetDetailSleepDataWithMode:mode withStartDate:nil]; }],
+        [BleFetchDescriptor descriptorWithName:@"Sleep+activity" dataType:DetailSleepAndActivityData_V8 payloadKeys:@[@"arrayDetailSleepAndActivityData"]
+                                  endDetection:BleFetchEndOnDataEndOrIdle
+                                commandForMode:^NSData *(int mode) { return [sdk getSleepDetailsAndActivityWithMode:mode withStartDate:nil]; }],
+        [BleFetchDescriptor descriptorWithName:@"PPI" dataType:ppiData_V8 payloadKeys:@[@"arrayPPIData"]
+                                  endDetection:BleFetchEndOnShortPage
+                                commandForMode:^NSData *(int mode) { return [sdk GetPPIDataWithMode:mode withStartDate:nil]; }],
+        hr,
+        [BleFetchDescriptor descriptorWithName:@"HRV" dataType:HRVData_V8 payloadKeys:@[@"arrayHrvData"]
+                                  endDetection:BleFetchEndOnDataEndOrIdle
+                                commandForMode:^NSData *(int mode) { return [sdk GetHRVDataWithMode:mode withStartDate:nil]; }],
+        [BleFetchDescriptor descriptorWithName:@"SpO2" dataType:AutomaticSpo2Data_V8 payloadKeys:@[@"arrayAutomaticSpo2Data"]
+                                  endDetection:BleFetchEndOnShortPage
+                                commandForMode:^NSData *(int mode) { return [sdk GetAutomaticSpo2DataWithMode:mode withStartDate:nil]; }],
+        // Note: SDK uses typo key "arrayemperatureData"
+        [BleFetchDescriptor descriptorWithName:@"Temperature" dataType:TemperatureData_V8 payloadKeys:@[@"arrayemperatureData", @"arrayTemperatureData"]
+                                  endDetection:BleFetchEndOnShortPage
+                                commandForMode:^NSData *(int mode) { return [sdk GetTemperatureDataWithMode:mode withStartDate:nil]; }],
+        activityMode,
+    ];
+    for (BleFetchDescriptor *descriptor in table) {
+        [self.fetchEngine registerDescriptor:descriptor];
+    }
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)deletableDataTypes {
+    static NSDictionary<NSString *, NSNumber *> *types;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        types = @{
+            @"getStepsData": @(TotalActivityData_V8),
+            @"getDetailActivityData": @(DetailActivityData_V8),
+            @"getSleepData": @(DetailSleepData_V8),
+            @"getSleepWithActivity": @(DetailSleepAndActivityData_V8),
+            @"getPPIData": @(ppiData_V8),
+            @"getContinuousHR": @(DynamicHR_V8),
+            @"getHRVData": @(HRVData_V8),
+            @"getAutoSpO2": @(AutomaticSpo2Data_V8),
+            @"getTemperature": @(TemperatureData_V8),
+            @"getActivityModeData": @(ActivityModeData_V8),
+        };
+    });
+    return types;
+}
+
+- (void)fetchEngine:(BleFetchEngine *)engine writeCommand:(NSData *)command {
+    (void)engine;
+    [self writeCommand:command];
+}
+
+- (void)fetchEngine:(BleFetchEngine *)engine didFinishDataType:(NSInteger)dataType result:(NSDictionary *)result {
+    (void)engine;
+    if (self.pendingDataResolver && self.pendingDataType == (DATATYPE_V8)dataType) {
+        self.pendingDataResolver(result);
+        [self clearPendingDataRequest];
+    }
+}
+
+- (void)fetchEngine:(BleFetchEngine *)engine didDeleteDataType:(NSInteger)dataType {
+    (void)engine;
+    if (self.pendingDataResolver && self.pendingDataType == (DATATYPE_V8)dataType) {
+        self.pendingDataResolver(@{@"success": @YES});
+        [self clearPendingDataRequest];
+    }
+}
+
+- (void)fetchEngine:(BleFetchEngine *)engine log:(NSString *)message {
+    (void)engine;
+    [self debugLog:message];
+}
+
 #pragma mark - Data Retrieval
 
-RCT_EXPORT_METHOD(getStepsData:(RCTPromiseResolveBlock)resolve
-                  rejecter:(RCTPromiseRejectBlock)reject) {
+// Every history type is paged through the shared fetch engine; see registerFetchDescriptors.
+- (void)startPagedFetch:(DATATYPE_V8)type
+              operation:(NSString *)operation
+               resolver:(RCTPromiseResolveBlock)resolve
+               rejecter:(RCTPromiseRejectBlock)reject {
     if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
-    if ([self rejectIfBusyForOperation:@"getStepsData" rejecter:reject]) return;
+    if ([self rejectIfBusyForOperation:operation rejecter:reject]) return;
 
     [self claimDelegate];
-    [self.accumulatedStepsData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:TotalActivityData_V8];
-    NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetTotalActivityDataWithMode:0 withStartDate:nil];
-    [self writeCommand:cmd];
+    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:type];
+    if (![self.fetchEngine startFetchForDataType:type]) {
+        [self rejectPendingDataRequestWithCode:@"UNSUPPORTED"
+                                       message:[NSString stringWithFormat:@"%@ has no V8 fetch descriptor", operation]];
+    }
 }
 
-RCT_EXPORT_METHOD(getSleepData:(RCTPromiseResolveBlock)resolve
+RCT_EXPORT_METHOD(getStepsData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
-    if ([self rejectIfBusyForOperation:@"getSleepData" rejecter:reject]) return;
+    [self startPagedFetch:TotalActivityData_V8 operation:@"getStepsData" resolver:resolve rejecter:reject];
+}
 
-    [self claimDelegate];
-    [self.accumulatedSleepData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:DetailSleepData_V8];
-    NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetDetailSleepDataWithMode:0 withStartDate:nil];
-    [self writeCommand:cmd];
+// `since` is the "yyyy.MM.dd HH:mm:ss" start of the newest window already ingested; null = everything
+RCT_EXPORT_METHOD(getDetailActivityData:(nullable NSString *)since
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    self.detailActivityStartDate = [self dateFromRingString:since];
+    [self startPagedFetch:DetailActivityData_V8 operation:@"getDetailActivityData" resolver:resolve rejecter:reject];
 }
 
-RCT_EXPORT_METHOD(getSleepWithActivity:(RCTPromiseResolveBlock)resolve
+RCT_EXPORT_METHOD(getSleepData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
-    if ([self rejectIfBusyForOperation:@"getSleepWithActivity" rejecter:reject]) return;
+    [self startPagedFetch:DetailSleepData_V8 operation:@"getSleepData" resolver:resolve rejecter:reject];
+}
 
-    [self claimDelegate];
-    [self.accumulatedSleepActivityData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:DetailSleepAndActivityData_V8];
-    NSMutableData *cmd = [[BleSDK_V8 sharedManager] getSleepDetailsAndActivityWithMode:0 withStartDate:nil];
-    [self writeCommand:cmd];
+RCT_EXPORT_METHOD(getSleepWithActivity:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    [self startPagedFetch:DetailSleepAndActivityData_V8 operation:@"getSleepWithActivity" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getPPIData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
-    if ([self rejectIfBusyForOperation:@"getPPIData" rejecter:reject]) return;
-
-    [self claimDelegate];
-    [self.accumulatedPPIData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:ppiData_V8];
-    NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetPPIDataWithMode:0 withStartDate:nil];
-    [self writeCommand:cmd];
+    [self startPagedFetch:ppiData_V8 operation:@"getPPIData" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getContinuousHR:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
-    if ([self rejectIfBusyForOperation:@"getContinuousHR" rejecter:reject]) return;
-
-    [self claimDelegate];
-    [self.accumulatedHRData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:DynamicHR_V8];
-    // Request only last 2 days — avoids transferring full history (can be 3000+ records)
-    NSDate *twoDaysAgo = [NSDate dateWithTimeIntervalSinceNow:-2 * 24 * 3600];
-    NSDateFormatter *fmt = [[NSDateFormatter alloc] init];
-    fmt.dateFormat = @"YYYY.MM.dd";
-    NSString *startDateStr = [fmt stringFromDate:twoDaysAgo];
-    NSDate *startDate = [fmt dateFromString:startDateStr];
-    NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetContinuousHRDataWithMode:0 withStartDate:startDate];
-    [self writeCommand:cmd];
+    [self startPagedFetch:DynamicHR_V8 operation:@"getContinuousHR" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getHRVData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
-    if ([self rejectIfBusyForOperation:@"getHRVData" rejecter:reject]) return;
-
-    [self claimDelegate];
-    [self.accumulatedHRVData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:HRVData_V8];
-    NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetHRVDataWithMode:0 withStartDate:nil];
-    [self writeCommand:cmd];
+    [self startPagedFetch:HRVData_V8 operation:@"getHRVData" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getAutoSpO2:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
-    if ([self rejectIfBusyForOperation:@"getAutoSpO2" rejecter:reject]) return;
-
-    [self claimDelegate];
-    [self.accumulatedSpO2Data removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:AutomaticSpo2Data_V8];
-    NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetAutomaticSpo2DataWithMode:0 withStartDate:nil];
-    [self writeCommand:cmd];
+    [self startPagedFetch:AutomaticSpo2Data_V8 operation:@"getAutoSpO2" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getTemperature:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
-    if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
-    if ([self rejectIfBusyForOperation:@"getTemperature" rejecter:reject]) return;
-
-    [self claimDelegate];
-    [self.accumulatedTempData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:TemperatureData_V8];
-    NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetTemperatureDataWithMode:0 withStartDate:nil];
-    [self writeCommand:cmd];
+    [self startPagedFetch:TemperatureData_V8 operation:@"getTemperature" resolver:resolve rejecter:reject];
 }
 
 RCT_EXPORT_METHOD(getActivityModeData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
+    [self startPagedFetch:ActivityModeData_V8 operation:@"getActivityModeData" resolver:resolve rejecter:reject];
+}
+
+// Clears one history type on the ring (mode 0x99); see JstyleBridge deleteHistoryData
+RCT_EXPORT_METHOD(deleteHistoryData:(NSString *)operation
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
     if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
-    if ([self rejectIfBusyForOperation:@"getActivityModeData" rejecter:reject]) return;
+    if ([self rejectIfBusyForOperation:@"deleteHistoryData" rejecter:reject]) return;
+
+    NSNumber *type = [self deletableDataTypes][operation];
+    NSData *cmd = type ? [self.fetchEngine deleteCommandForDataType:type.integerValue] : nil;
+    if (!cmd) {
+        reject(@"UNSUPPORTED", [NSString stringWithFormat:@"%@ has no V8 delete command", operation], nil);
+        return;
+    }
 
     [self claimDelegate];
-    [self.accumulatedActivityModeData removeAllObjects];
-    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:ActivityModeData_V8];
-    NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetActivityModeDataWithMode:0 withStartDate:nil needMETS:NO];
+    // Resolved by fetchEngine:didDeleteDataType: once the ring confirms; the watchdog rejects otherwise
+    [self setPendingDataRequestWithResolver:resolve rejecter:reject type:(DATATYPE_V8)type.integerValue];
+    BLE_LOG(self.log, BleLogLevelInfo, @"Deleting ring history for %@", operation);
     [self writeCommand:cmd];
 }
 
+RCT_EXPORT_METHOD(getFetchMetrics:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    resolve([self.fetchEngine metricsSnapshot]);
+}
+
+RCT_EXPORT_METHOD(resetFetchMetrics:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    [self.fetchEngine resetMetrics];
+    resolve(@{@"success": @YES});
+}
+
+RCT_EXPORT_METHOD(getSyncStats:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    resolve(@{
+        @"link": [[BleLinkStats sharedStats] snapshot],
+        @"fetch": [self.fetchEngine metricsSnapshot],
+        @"realtime": [self.realtimeCoalescer snapshot],
+        @"log": [self.log snapshot],
+        @"watchdogFires": @(self.watchdogFires),
+        @"reconnect": [[BleConnectionManager sharedManager] snapshot],
+    });
+}
+
+RCT_EXPORT_METHOD(resetSyncStats:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    [[BleLinkStats sharedStats] reset];
+    [self.fetchEngine resetMetrics];
+    [self.realtimeCoalescer resetMetrics];
+    [self.log resetMetrics];
+    self.watchdogFires = 0;
+    resolve(@{@"success": @YES});
+}
+
+// { level, sample: { debug: n, ... }, flushIntervalMs } — see BleLogQueue. Resolves the
+// log stats with the new level.
+RCT_EXPORT_METHOD(configureLogging:(NSDictionary *)options
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    [self.log configure:options];
+    resolve([self.log snapshot]);
+}
+
 RCT_EXPORT_METHOD(factoryReset:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
@@ -656,6 +753,28 @@ RCT_EXPORT_METHOD(getStepGoal:(RCTPromiseResolveBlock)resolve
     [self writeCommand:cmd];
 }
 
+// See JstyleBridge controlActivityMode (WORKMODE_V8 / ACTIVITYMODE_V8 share the X3 values)
+RCT_EXPORT_METHOD(controlActivityMode:(int)activityMode
+                  workMode:(int)workMode
+                  minutes:(int)minutes
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
+    if (workMode < startActivity || workMode > stopActivity) {
+        reject(@"INVALID_ARGUMENT", [NSString stringWithFormat:@"Unknown work mode %d", workMode], nil);
+        return;
+    }
+
+    [self claimDelegate];
+    MyBreathParameter_V8 breath = {0, 0};
+    NSMutableData *cmd = [[BleSDK_V8 sharedManager] startActivityMode:(ACTIVITYMODE_V8)activityMode
+                                                             WorkMode:(WORKMODE_V8)workMode
+                                                         ActivityTime:minutes
+                                                      BreathParameter:breath];
+    [self writeCommand:cmd];
+    resolve(@{@"success": @YES});
+}
+
 RCT_EXPORT_METHOD(startRealTimeData:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     if (!self.connectedPeripheral) { reject(@"NOT_CONNECTED", @"V8 not connected", nil); return; }
@@ -673,9 +792,27 @@ RCT_EXPORT_METHOD(stopRealTimeData:(RCTPromiseResolveBlock)resolve
     [self claimDelegate];
     NSMutableData *cmd = [[BleSDK_V8 sharedManager] RealTimeDataWithType:0];
     [self writeCommand:cmd];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self.realtimeCoalescer flush];
+        [self.realtimeCoalescer reset];
+    });
     resolve(@{@"success": @YES});
 }
 
+// rateHz: realtime frames per second, 0 = every packet (recording). deltas: send only
+// changed fields (with periodic keyframes). See BleRealtimeCoalescer.
+RCT_EXPORT_METHOD(configureRealTimeStream:(double)rateHz
+                  deltas:(BOOL)deltas
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    (void)reject;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self.realtimeCoalescer.rateHz = rateHz;
+        self.realtimeCoalescer.deltas = deltas;
+        resolve([self.realtimeCoalescer snapshot]);
+    });
+}
+
 RCT_EXPORT_METHOD(startManualMeasurement:(int)dataType
                   measurementTime:(int)time
                   resolver:(RCTPromiseResolveBlock)resolve
@@ -706,42 +843,6 @@ RCT_EXPORT_METHOD(stopManualMeasurement:(int)dataType
     resolve(@{@"success": @YES});
 }
 
-#pragma mark - Reconnection
-
-- (void)stopReconnectionTimer {
-    if (self.reconnectionTimer) {
-        [self.reconnectionTimer invalidate];
-        self.reconnectionTimer = nil;
-    }
-    self.reconnectionAttempts = 0;
-}
-
-- (void)startReconnectionTimer:(CBPeripheral *)peripheral {
-    [self stopReconnectionTimer];
-    self.reconnectionTimer = [NSTimer scheduledTimerWithTimeInterval:6.0
-                                                              target:self
-                                                            selector:@selector(attemptReconnection:)
-                                                            userInfo:peripheral
-                                                             repeats:YES];
-}
-
-- (void)attemptReconnection:(NSTimer *)timer {
-    CBPeripheral *peripheral = timer.userInfo;
-    if (!peripheral || self.isDisconnecting) {
-        [self stopReconnectionTimer];
-        return;
-    }
-    self.reconnectionAttempts++;
-    if (self.reconnectionAttempts > 10) {
-        [self debugLog:@"V8 max reconnection attempts reached"];
-        [self stopReconnectionTimer];
-        return;
-    }
-    [self debugLog:[NSString stringWithFormat:@"V8 reconnection attempt %ld", (long)self.reconnectionAttempts]];
-    [self claimDelegate];
-    [[NewBle sharedManager] connectDevice:peripheral];
-}
-
 #pragma mark - MyBleDelegate
 
 - (void)scanWithPeripheral:(CBPeripheral *)peripheral
@@ -782,7 +883,6 @@ RCT_EXPORT_METHOD(stopManualMeasurement:(int)dataType
     self.connectedPeripheral = peripheral;
     self.connectedDeviceId = [peripheral.identifier UUIDString];
     self.isDisconnecting = NO;
-    [self stopReconnectionTimer];
 
     // Save paired device
     [[NSUserDefaults standardUserDefaults] setObject:self.connectedDeviceId forKey:kV8PairedDeviceUUIDKey];
@@ -795,11 +895,10 @@ RCT_EXPORT_METHOD(stopManualMeasurement:(int)dataType
 
     if (self.hasListeners) {
         [self sendEventWithName:@"V8ConnectionStateChanged" body:@{@"state": @"connected"}];
+        // JS applies clock / profile / goal from its cached device config, writing only what changed
+        [self sendEventWithName:@"V8DeviceReady" body:@{@"deviceId": self.connectedDeviceId ?: @""}];
     }
 
-    // Sync time on connect
-    [self writeCommand:[self buildTimeSyncCommand]];
-
     // Resolve pending connect
     if (self.pendingConnectResolver) {
         self.pendingConnectResolver(@{
@@ -813,11 +912,12 @@ RCT_EXPORT_METHOD(stopManualMeasurement:(int)dataType
     }
 }
 
-- (void)Disconnect:(CBPeripheral *)peripheral error:(NSError *)error {
-    [self debugLog:[NSString stringWithFormat:@"V8 disconnected: %@", error ?: @"clean"]];
+- (void)Disconnect:(NSError *)error {
+    BLE_LOG(self.log, BleLogLevelInfo, @"V8 disconnected: %@", error ?: @"clean");
 
     [self rejectPendingDataRequestWithCode:@"DISCONNECTED" message:@"V8 device disconnected"];
-    [self clearAccumulatedDataBuffers];
+    [self.fetchEngine abortWithReason:BleFetchAbortDisconnected];
+    [self.realtimeCoalescer reset];
 
     if (self.pendingConnectResolver) {
         self.pendingConnectRejecter(@"CONNECT_FAILED", @"V8 device disconnected during connect", error);
@@ -829,16 +929,15 @@ RCT_EXPORT_METHOD(stopManualMeasurement:(int)dataType
         [self sendEventWithName:@"V8ConnectionStateChanged" body:@{@"state": @"disconnected"}];
     }
 
-    if (!self.isDisconnecting && self.connectedPeripheral) {
-        [self startReconnectionTimer:self.connectedPeripheral];
-    }
+    // Unexpected drops are reconnected by BleConnectionManager (pending connect + backoff)
+    self.isDisconnecting = NO;
 
     self.connectedPeripheral = nil;
     self.connectedDeviceId = nil;
 }
 
-- (void)ConnectFailedWithError:(CBPeripheral *)peripheral error:(NSError *)error {
-    [self debugLog:[NSString stringWithFormat:@"V8 connect failed: %@", error]];
+- (void)ConnectFailedWithError:(NSError *)error {
+    BLE_LOG(self.log, BleLogLevelWarn, @"V8 connect failed: %@", error);
 
     if (self.pendingConnectRejecter) {
         self.pendingConnectRejecter(@"CONNECT_FAILED", error.localizedDescription ?: @"V8 connect failed", error);
@@ -850,13 +949,21 @@ RCT_EXPORT_METHOD(stopManualMeasurement:(int)dataType
 #pragma mark - Data Parsing
 
 - (void)BleCommunicateWithPeripheral:(CBPeripheral *)peripheral data:(NSData *)data {
+    [self.fetchEngine recordBytes:data.length];
+    CFAbsoluteTime parseStart = CFAbsoluteTimeGetCurrent();
     DeviceData_V8 *deviceData = [[BleSDK_V8 sharedManager] DataParsingWithData:data];
+    [[BleLinkStats sharedStats] recordParseMs:(CFAbsoluteTimeGetCurrent() - parseStart) * 1000.0];
     if (!deviceData) return;
 
     DATATYPE_V8 dataType = deviceData.dataType;
     NSDictionary *dicData = deviceData.dicData;
     BOOL dataEnd = deviceData.dataEnd;
 
+    // History types (steps, sleep, HR, SpO2, ...) are paged by the fetch engine
+    if ([self.fetchEngine handlePacketForDataType:dataType dicData:dicData dataEnd:dataEnd]) {
+        return;
+    }
+
     switch (dataType) {
 
         case GetDeviceBattery_V8: {
@@ -901,145 +1008,6 @@ RCT_EXPORT_METHOD(stopManualMeasurement:(int)dataType
             break;
         }
 
-        case TotalActivityData_V8: {
-            NSArray *items = dicData[@"arrayTotalActivityData"];
-            if (items) [self.accumulatedStepsData addObjectsFromArray:items];
-
-            if (dataEnd || items.count < 50) {
-                if (self.pendingDataResolver && self.pendingDataType == TotalActivityData_V8) {
-                    self.pendingDataResolver(@{@"data": [self.accumulatedStepsData copy]});
-                    [self clearPendingDataRequest];
-                    [self.accumulatedStepsData removeAllObjects];
-                }
-            } else {
-                NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetTotalActivityDataWithMode:2 withStartDate:nil];
-                [self writeCommand:cmd];
-            }
-            break;
-        }
-
-        case DetailSleepData_V8: {
-            NSArray *items = dicData[@"arrayDetailSleepData"];
-            if (items) [self.accumulatedSleepData addObjectsFromArray:items];
-
-            if (dataEnd || items.count < 50) {
-                if (self.pendingDataResolver && self.pendingDataType == DetailSleepData_V8) {
-                    self.pendingDataResolver(@{@"data": [self.accumulatedSleepData copy]});
-                    [self clearPendingDataRequest];
-                    [self.accumulatedSleepData removeAllObjects];
-                }
-            } else {
-                NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetDetailSleepDataWithMode:2 withStartDate:nil];
-                [self writeCommand:cmd];
-            }
-            break;
-        }
-
-        case DynamicHR_V8: {
-            NSArray *items = dicData[@"arrayContinuousHR"];
-            NSLog(@"[V8HR] packet — dataEnd=%d itemsInPacket=%lu accumulated=%lu", dataEnd, (unsigned long)items.count, (unsigned long)self.accumulatedHRData.count);
-            if (items) [self.accumulatedHRData addObjectsFromArray:items];
-
-            if (dataEnd) {
-                [self invalidateSleepActivityIdleTimer];
-                NSLog(@"[V8HR] fetch complete (dataEnd=1) — total records=%lu", (unsigned long)self.accumulatedHRData.count);
-                if (self.pendingDataResolver && self.pendingDataType == DynamicHR_V8) {
-                    self.pendingDataResolver(@{@"data": [self.accumulatedHRData copy]});
-                    [self clearPendingDataRequest];
-                    [self.accumulatedHRData removeAllObjects];
-                }
-            } else if (self.accumulatedHRData.count % 50 == 0 && self.accumulatedHRData.count > 0) {
-                [self invalidateSleepActivityIdleTimer];
-                NSLog(@"[V8HR] page complete (%lu items) — requesting mode:2", (unsigned long)self.accumulatedHRData.count);
-                NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetContinuousHRDataWithMode:2 withStartDate:nil];
-                [self writeCommand:cmd];
-                [self resetSleepActivityIdleTimer];
-            } else {
-                [self resetSleepActivityIdleTimer];
-            }
-            break;
-        }
-
-        case HRVData_V8: {
-            NSArray *items = dicData[@"arrayHrvData"];
-            NSLog(@"[V8HRV] packet — dataEnd=%d itemsInPacket=%lu accumulated=%lu", dataEnd, (unsigned long)items.count, (unsigned long)self.accumulatedHRVData.count);
-            if (items) [self.accumulatedHRVData addObjectsFromArray:items];
-
-            if (dataEnd) {
-                [self invalidateSleepActivityIdleTimer];
-                NSLog(@"[V8HRV] fetch complete (dataEnd=1) — total records=%lu", (unsigned long)self.accumulatedHRVData.count);
-                if (self.pendingDataResolver && self.pendingDataType == HRVData_V8) {
-                    self.pendingDataResolver(@{@"data": [self.accumulatedHRVData copy]});
-                    [self clearPendingDataRequest];
-                    [self.accumulatedHRVData removeAllObjects];
-                }
-            } else if (self.accumulatedHRVData.count % 50 == 0 && self.accumulatedHRVData.count > 0) {
-                [self invalidateSleepActivityIdleTimer];
-                NSLog(@"[V8HRV] page complete (%lu items) — requesting mode:2", (unsigned long)self.accumulatedHRVData.count);
-                NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetHRVDataWithMode:2 withStartDate:nil];
-                [self writeCommand:cmd];
-                [self resetSleepActivityIdleTimer];
-            } else {
-                [self resetSleepActivityIdleTimer];
-            }
-            break;
-        }
-
-        case AutomaticSpo2Data_V8: {
-            NSArray *items = dicData[@"arrayAutomaticSpo2Data"];
-            if (items) [self.accumulatedSpO2Data addObjectsFromArray:items];
-
-            if (dataEnd || items.count < 50) {
-                if (self.pendingDataResolver && self.pendingDataType == AutomaticSpo2Data_V8) {
-                    self.pendingDataResolver(@{@"data": [self.accumulatedSpO2Data copy]});
-                    [self clearPendingDataRequest];
-                    [self.accumulatedSpO2Data removeAllObjects];
-                }
-            } else {
-                NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetAutomaticSpo2DataWithMode:2 withStartDate:nil];
-                [self writeCommand:cmd];
-            }
-            break;
-        }
-
-        case TemperatureData_V8: {
-            // Note: SDK uses typo key "arrayemperatureData"
-            NSArray *items = dicData[@"arrayemperatureData"] ?: dicData[@"arrayTemperatureData"];
-            if (items) [self.accumulatedTempData addObjectsFromArray:items];
-
-            if (dataEnd || (items && items.count < 50)) {
-                if (self.pendingDataResolver && self.pendingDataType == TemperatureData_V8) {
-                    self.pendingDataResolver(@{@"data": [self.accumulatedTempData copy]});
-                    [self clearPendingDataRequest];
-                    [self.accumulatedTempData removeAllObjects];
-                }
-            } else {
-                NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetTemperatureDataWithMode:2 withStartDate:nil];
-                [self writeCommand:cmd];
-            }
-            break;
-        }
-
-        case ActivityModeData_V8: {
-            NSArray *items = dicData[@"arrayActivityModeData"];
-            if (items) [self.accumulatedActivityModeData addObjectsFromArray:items];
-
-            if (dataEnd || items.count < 50) {
-                if (self.pendingDataResolver && self.pendingDataType == ActivityModeData_V8) {
-                    self.pendingDataResolver(@{
-                        @"data": [self.accumulatedActivityModeData copy],
-                        @"activityMode": dicData[@"activityMode"] ?: @(-1)
-                    });
-                    [self clearPendingDataRequest];
-                    [self.accumulatedActivityModeData removeAllObjects];
-                }
-            } else {
-                NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetActivityModeDataWithMode:2 withStartDate:nil needMETS:NO];
-                [self writeCommand:cmd];
-            }
-            break;
-        }
-
         case DeviceMeasurement_HR_V8: {
             if (self.hasListeners) {
                 [self sendEventWithName:@"V8MeasurementResult" body:@{
@@ -1074,7 +1042,7 @@ RCT_EXPORT_METHOD(stopManualMeasurement:(int)dataType
 
         case RealTimeStep_V8: {
             if (self.hasListeners) {
-                [self sendEventWithName:@"V8RealTimeData" body:@{
+                [self.realtimeCoalescer ingestPacket:@{
                     @"steps": dicData[@"step"] ?: @0,
                     @"heartRate": dicData[@"heartRate"] ?: @0,
                     @"calories": dicData[@"calories"] ?: @0,
@@ -1084,60 +1052,30 @@ RCT_EXPORT_METHOD(stopManualMeasurement:(int)dataType
             break;
         }
 
-        case DetailSleepAndActivityData_V8: {
-            NSArray *items = dicData[@"arrayDetailSleepAndActivityData"];
-            if (items) [self.accumulatedSleepActivityData addObjectsFromArray:items];
-
-            if (dataEnd) {
-                // Ring signals end of transfer — resolve.
-                [self invalidateSleepActivityIdleTimer];
-                if (self.pendingDataResolver && self.pendingDataType == DetailSleepAndActivityData_V8) {
-                    self.pendingDataResolver(@{@"data": [self.accumulatedSleepActivityData copy]});
-                    [self clearPendingDataRequest];
-                    [self.accumulatedSleepActivityData removeAllObjects];
-                }
-            } else if (self.accumulatedSleepActivityData.count % 50 == 0) {
-                // Full page received (50 items) — request next page / signal completion.
-                // Ring responds with more data or dataEnd=1. This is the correct SDK protocol
-                // per the V8 demo: getSleepDetailsAndActivityWithMode:2 after every full page.
-                [self invalidateSleepActivityIdleTimer];
-                NSMutableData *cmd = [[BleSDK_V8 sharedManager] getSleepDetailsAndActivityWithMode:2 withStartDate:nil];
-                [self writeCommand:cmd];
-                // Safety idle timer: if ring goes silent after mode:2, resolve after 3s.
-                [self resetSleepActivityIdleTimer];
-            } else {
-                // Partial page — still accumulating, reset idle timer as safety net.
-                [self resetSleepActivityIdleTimer];
-            }
-            break;
-        }
-
-        case ppiData_V8: {
-            NSArray *items = dicData[@"arrayPPIData"];
-            if (items) [self.accumulatedPPIData addObjectsFromArray:items];
-
-            if (dataEnd || items.count < 50) {
-                if (self.pendingDataResolver && self.pendingDataType == ppiData_V8) {
-                    self.pendingDataResolver(@{@"data": [self.accumulatedPPIData copy]});
-                    [self clearPendingDataRequest];
-                    [self.accumulatedPPIData removeAllObjects];
-                }
-            } else {
-                NSMutableData *cmd = [[BleSDK_V8 sharedManager] GetPPIDataWithMode:2 withStartDate:nil];
-                [self writeCommand:cmd];
+        // Live workout packets and the ring's acks of start / pause / continue / stop
+        case ActivityModeData_V8:
+        case StartActivityMode_V8:
+        case PauseActivityMode_V8:
+        case ContinueActivityMode_V8:
+        case StopActivityMode_V8: {
+            if (self.hasListeners) {
+                NSMutableDictionary *body = [NSMutableDictionary dictionaryWithDictionary:dicData ?: @{}];
+                body[@"packetType"] = @(dataType);
+                body[@"timestamp"] = @([[NSDate date] timeIntervalSince1970] * 1000);
+                [self sendEventWithName:@"V8ActivityModeData" body:body];
             }
             break;
         }
 
         case DataError_V8: {
-            [self debugLog:@"V8 DataError received"];
+            [self.log log:BleLogLevelWarn message:@"V8 DataError received"];
             [self rejectPendingDataRequestWithCode:@"DATA_ERROR" message:@"V8 data parse error"];
-            [self clearAccumulatedDataBuffers];
+            [self.fetchEngine abortWithReason:BleFetchAbortError];
             break;
         }
 
         default:
-            [self debugLog:[NSString stringWithFormat:@"V8 unhandled data type: %d", (int)dataType]];
+            BLE_LOG(self.log, BleLogLevelDebug, @"V8 unhandled data type: %d", (int)dataType);
             break;
     }
 }
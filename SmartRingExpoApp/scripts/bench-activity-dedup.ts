@@ -0,0 +1,161 @@
+/**
+ * Benchmark for ActivityDeduplicator.mergeActivities over multi-year histories.
+ *
+ * Generates a synthetic athlete: ~1.2 Strava workouts/day, most of them also
+ * recorded by Apple Watch (HealthKit, start/end jittered by a few minutes),
+ * extra HealthKit-only walks, and a handful of ring sport sessions. Runs the
+ * previous all-pairs merge and the interval-index merge on the same input,
+ * checks both keep the same activities, and reports timings.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/bench-activity-dedup.ts [years=2] [runs=5]
+ */
+
+import {
+  mergeActivities,
+  healthKitToUnified,
+  ringToUnified,
+  sportCategory,
+  stravaToUnified,
+} from '../src/services/ActivityDeduplicator';
+import type { HKWorkoutResult, UnifiedActivity } from '../src/types/activity.types';
+import type { StravaActivitySummary } from '../src/types/strava.types';
+import type { X3ActivitySession } from '../src/types/sdk.types';
+
+const YEARS = Number(process.argv[2] ?? 2);
+const RUNS = Number(process.argv[3] ?? 5);
+
+const DAY_MS = 86_400_000;
+const SPORTS = ['Run', 'Ride', 'Walk', 'Swim', 'WeightTraining', 'Yoga'];
+
+// Deterministic PRNG so runs are comparable
+let seed = 42;
+const rand = () => {
+  seed = (seed * 1_103_515_245 + 12_345) & 0x7fffffff;
+  return seed / 0x7fffffff;
+};
+
+function syntheticHistory(years: number) {
+  const strava: StravaActivitySummary[] = [];
+  const healthKit: HKWorkoutResult[] = [];
+  const ring: X3ActivitySession[] = [];
+  const end = Date.now();
+  const start = end - years * 365 * DAY_MS;
+
+  for (let day = start; day < end; day += DAY_MS) {
+    const workouts = rand() < 0.2 ? 2 : rand() < 0.85 ? 1 : 0;
+    for (let w = 0; w < workouts; w++) {
+      const sport = SPORTS[Math.floor(rand() * SPORTS.length)];
+      const t0 = day + (6 + w * 10 + rand() * 3) * 3_600_000;
+      const dur = Math.round((20 + rand() * 100) * 60);
+      strava.push({
+        id: strava.length + 1,
+        name: `${sport} ${strava.length}`,
+        sport_type: sport,
+        start_date: new Date(t0).toISOString(),
+        distance_m: rand() * 20_000,
+        moving_time_sec: dur,
+        average_heartrate: 140,
+        max_heartrate: 170,
+        suffer_score: 40,
+        calories: 500,
+        splits_metric_json: null,
+        zones_json: null,
+      } as unknown as StravaActivitySummary);
+
+      if (rand() < 0.9) {
+        const jitter = (rand() - 0.5) * 4 * 60_000;
+        healthKit.push({
+          uuid: `hk-${healthKit.length}`,
+          activityType: 0,
+          sportType: sport,
+          name: sport,
+          startDate: new Date(t0 + jitter).toISOString(),
+          endDate: new Date(t0 + jitter + dur * 1000).toISOString(),
+          durationSec: dur,
+          sourceName: 'Apple Watch',
+        } as HKWorkoutResult);
+      }
+    }
+    if (rand() < 0.3) {
+      const t0 = day + 18 * 3_600_000;
+      healthKit.push({
+        uuid: `hk-${healthKit.length}`,
+        activityType: 0,
+        sportType: 'Walk',
+        name: 'Evening Walk',
+        startDate: new Date(t0).toISOString(),
+        endDate: new Date(t0 + 30 * 60_000).toISOString(),
+        durationSec: 1800,
+        sourceName: 'iPhone',
+      } as HKWorkoutResult);
+    }
+    if (rand() < 0.1) {
+      const t0 = day + 12 * 3_600_000;
+      ring.push({
+        type: 0,
+        typeLabel: 'Run',
+        startTime: new Date(t0).toISOString(),
+        endTime: new Date(t0 + 40 * 60_000).toISOString(),
+        duration: 40,
+        steps: 5000,
+        distance: 5,
+        calories: 300,
+        heartRateAvg: 150,
+        heartRateMax: 175,
+      } as unknown as X3ActivitySession);
+    }
+  }
+  return { strava, healthKit, ring };
+}
+
+// The merge as it was before the interval index: every candidate scanned
+// against every accepted activity, re-parsing both dates each time.
+function legacyMerge(
+  strava: StravaActivitySummary[],
+  healthKit: HKWorkoutResult[],
+  ringActivities: X3ActivitySession[],
+): UnifiedActivity[] {
+  const ratio = (a: { start: number; end: number }, b: { start: number; end: number }) => {
+    const overlap = Math.max(0, Math.min(a.end, b.end) - Math.max(a.start, b.start));
+    const shorter = Math.min(a.end - a.start, b.end - b.start);
+    return shorter > 0 ? overlap / shorter : 0;
+  };
+  const result: UnifiedActivity[] = strava.map(stravaToUnified);
+  for (const cand of [...healthKit.map(healthKitToUnified), ...ringActivities.map(ringToUnified)]) {
+    const range = { start: new Date(cand.startDate).getTime(), end: new Date(cand.endDate).getTime() };
+    const cat = sportCategory(cand.sportType);
+    const dup = result.some(e =>
+      sportCategory(e.sportType) === cat
+      && ratio(range, { start: new Date(e.startDate).getTime(), end: new Date(e.endDate).getTime() }) >= 0.7);
+    if (!dup) result.push(cand);
+  }
+  result.sort((a, b) => new Date(b.startDate).getTime() - new Date(a.startDate).getTime());
+  return result;
+}
+
+function time<T>(fn: () => T): { ms: number; out: T } {
+  let out!: T;
+  const samples: number[] = [];
+  for (let i = 0; i < RUNS; i++) {
+    const t0 = performance.now();
+    out = fn();
+    samples.push(performance.now() - t0);
+  }
+  samples.sort((a, b) => a - b);
+  return { ms: samples[Math.floor(samples.length / 2)], out };
+}
+
+const { strava, healthKit, ring } = syntheticHistory(YEARS);
+console.log(`[bench] ${YEARS}y history: strava=${strava.length} healthKit=${healthKit.length} ring=${ring.length} (median of ${RUNS})`);
+
+const legacy = time(() => legacyMerge(strava, healthKit, ring));
+const indexed = time(() => mergeActivities(strava, healthKit, ring));
+
+const sameIds = legacy.out.length === indexed.out.length
+  && legacy.out.every((a, i) => a.id === indexed.out[i].id);
+console.log(`[bench] all-pairs : ${legacy.ms.toFixed(1)} ms → ${legacy.out.length} activities`);
+console.log(`[bench] interval  : ${indexed.ms.toFixed(1)} ms → ${indexed.out.length} activities`);
+console.log(`[bench] speedup ${(legacy.ms / indexed.ms).toFixed(1)}x, identical output: ${sameIds}`);
+if (!sameIds) process.exit(1);
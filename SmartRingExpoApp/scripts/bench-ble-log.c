@@ -0,0 +1,284 @@
+/**
+ * Benchmark for ios/JstyleBridge/BleLog.c, the bridges' debug-log buffer.
+ *
+ * Measures the per-call cost on the BLE thread for:
+ *   - a level below the threshold (what every packet log costs in release)
+ *   - an entry that loses the sampling draw
+ *   - a formatted append that is kept
+ * then drains into batches, and runs several producer threads against one
+ * draining consumer to check no entry is lost, duplicated or reordered per
+ * producer (drops are allowed when the ring is full, but must be counted).
+ * Exits non-zero on a mismatch or if the disabled path costs 1 µs or more.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   cc -O2 -std=c11 -pthread -Iios/JstyleBridge scripts/bench-ble-log.c ios/JstyleBridge/BleLog.c -lm -o /tmp/bench-ble-log
+ *   /tmp/bench-ble-log [iterations=10000000] [producers=4]
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "BleLog.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RUNS 5
+#define BATCH_BYTES 16384
+
+static long ITERATIONS = 10000000;
+static int PRODUCERS = 4;
+
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int compareDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/// Median over RUNS of fn's ns per call.
+static double timeNs(const char *label, double (*fn)(BleLog *, long), BleLog *log, long n) {
+    double samples[RUNS];
+    for (int r = 0; r < RUNS; r++) {
+        samples[r] = fn(log, n);
+    }
+    qsort(samples, RUNS, sizeof(double), compareDouble);
+    printf("[bench] %-34s %8.2f ns/call\n", label, samples[RUNS / 2]);
+    return samples[RUNS / 2];
+}
+
+// Keep the compiler from dropping the loops
+static volatile uint64_t sink;
+static uint8_t batch[BATCH_BYTES];
+
+static double runWants(BleLog *log, long n) {
+    uint64_t kept = 0;
+    double t0 = nowNs();
+    for (long i = 0; i < n; i++) {
+        if (BleLogWants(log, BleLogLevelDebug)) {
+            kept++;
+        }
+    }
+    double ns = (nowNs() - t0) / (double)n;
+    sink += kept;
+    return ns;
+}
+
+static void drainAll(BleLog *log) {
+    uint32_t count;
+    while (BleLogDrain(log, batch, sizeof(batch), &count) > 0) {
+        sink += count;
+    }
+}
+
+static double runAppend(BleLog *log, long n) {
+    char text[BLE_LOG_MAX_TEXT];
+    double spent = 0;
+    for (long i = 0; i < n; i++) {
+        double t0 = nowNs();
+        if (BleLogWants(log, BleLogLevelDebug)) {
+            int len = snprintf(text, sizeof(text), "Received data type: %ld, dataEnd: %d", i % 40, (int)(i & 1));
+            BleLogAppend(log, BleLogLevelDebug, 1.7e12 + (double)i, text, (size_t)len);
+        }
+        spent += nowNs() - t0;
+        // The app drains every few hundred ms; here whenever the ring could be full
+        if ((i & 1023) == 1023) {
+            drainAll(log);
+        }
+    }
+    drainAll(log);
+    return spent / (double)n;
+}
+
+static double runDrain(BleLog *log, long n) {
+    const char *text = "Received data type: 25, dataEnd: 0";
+    size_t len = strlen(text);
+    uint32_t count;
+    double spent = 0;
+    long done = 0;
+    while (done < n) {
+        long chunk = 0;
+        while (chunk < 1024 && BleLogAppend(log, BleLogLevelDebug, 1.7e12 + (double)done, text, len)) {
+            chunk++;
+            done++;
+        }
+        double t0 = nowNs();
+        while (BleLogDrain(log, batch, sizeof(batch), &count) > 0) {
+            sink += count;
+        }
+        spent += nowNs() - t0;
+    }
+    return spent / (double)n;
+}
+
+typedef struct {
+    BleLog *log;
+    int id;
+    long count;
+    long appended;
+} Producer;
+
+static atomic_int producersDone;
+
+static void *produce(void *arg) {
+    Producer *p = arg;
+    char text[64];
+    for (long i = 0; i < p->count; i++) {
+        int len = snprintf(text, sizeof(text), "p%d %ld", p->id, i);
+        if (BleLogAppend(p->log, BleLogLevelInfo, (double)i, text, (size_t)len)) {
+            p->appended++;
+        }
+    }
+    atomic_fetch_add(&producersDone, 1);
+    return NULL;
+}
+
+/// Several producers, one consumer draining concurrently. Returns 0 when consistent.
+static int runConcurrent(long perProducer) {
+    BleLog *log = BleLogCreate(4096);
+    Producer *producers = calloc((size_t)PRODUCERS, sizeof(Producer));
+    pthread_t *threads = calloc((size_t)PRODUCERS, sizeof(pthread_t));
+    long *lastSeen = malloc(sizeof(long) * (size_t)PRODUCERS);
+    for (int i = 0; i < PRODUCERS; i++) {
+        lastSeen[i] = -1;
+    }
+    atomic_store(&producersDone, 0);
+
+    double t0 = nowNs();
+    for (int i = 0; i < PRODUCERS; i++) {
+        producers[i] = (Producer){ log, i, perProducer, 0 };
+        pthread_create(&threads[i], NULL, produce, &producers[i]);
+    }
+
+    int bad = 0;
+    long received = 0;
+    uint64_t droppedReported = 0;
+    for (;;) {
+        int finished = atomic_load(&producersDone) == PRODUCERS;
+        uint32_t count;
+        size_t bytes;
+        while ((bytes = BleLogDrain(log, batch, sizeof(batch), &count)) > 0) {
+            droppedReported += batch[12] | (batch[13] << 8) | (batch[14] << 16) | ((uint32_t)batch[15] << 24);
+            size_t offset = 0;
+            BleLogEntry entry;
+            uint32_t walked = 0;
+            while (BleLogBatchNext(batch, bytes, &offset, &entry)) {
+                int id;
+                long seq;
+                char text[64];
+                memcpy(text, entry.text, entry.length);
+                text[entry.length] = '\0';
+                if (sscanf(text, "p%d %ld", &id, &seq) != 2 || id < 0 || id >= PRODUCERS ||
+                    seq <= lastSeen[id] || (double)seq != entry.timestampMs) {
+                    bad++;
+                } else {
+                    lastSeen[id] = seq;
+                }
+                walked++;
+            }
+            if (walked != count) {
+                bad++;
+            }
+            received += count;
+        }
+        if (finished) {
+            break;
+        }
+    }
+    double ms = (nowNs() - t0) / 1e6;
+
+    long appended = 0;
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+        appended += producers[i].appended;
+    }
+    BleLogStats stats = BleLogGetStats(log);
+    long total = perProducer * PRODUCERS;
+    printf("[bench] %d producers x %ld: %.1f ms, %.1f ns/entry, received %ld, dropped %llu\n",
+           PRODUCERS, perProducer, ms, ms * 1e6 / (double)total, received, (unsigned long long)stats.dropped);
+
+    int ok = bad == 0 && received == appended && (uint64_t)(total - appended) == stats.dropped &&
+             droppedReported == stats.dropped && stats.drained == (uint64_t)received;
+    if (!ok) {
+        printf("[bench] MISMATCH: bad=%d received=%ld appended=%ld dropped=%llu reported=%llu\n",
+               bad, received, appended, (unsigned long long)stats.dropped, (unsigned long long)droppedReported);
+    }
+    free(lastSeen);
+    free(threads);
+    free(producers);
+    BleLogDestroy(log);
+    return ok ? 0 : 1;
+}
+
+static int checkTruncation(void) {
+    BleLog *log = BleLogCreate(4);
+    // 'é' is two bytes; 200 of them cross the limit mid-character
+    char text[400];
+    for (int i = 0; i < 200; i++) {
+        text[2 * i] = (char)0xC3;
+        text[2 * i + 1] = (char)0xA9;
+    }
+    BleLogAppend(log, BleLogLevelWarn, 1000.5, text, sizeof(text));
+    uint32_t count;
+    size_t bytes = BleLogDrain(log, batch, sizeof(batch), &count);
+    size_t offset = 0;
+    BleLogEntry entry;
+    int ok = count == 1 && BleLogBatchNext(batch, bytes, &offset, &entry) &&
+             entry.length == BLE_LOG_MAX_TEXT && entry.level == BleLogLevelWarn &&
+             memcmp(entry.text, text, entry.length) == 0;
+    BleLogDestroy(log);
+    if (!ok) {
+        printf("[bench] MISMATCH: truncation\n");
+    }
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) ITERATIONS = atol(argv[1]);
+    if (argc > 2) PRODUCERS = atoi(argv[2]);
+    int failures = 0;
+
+    BleLog *log = BleLogCreate(2048);
+
+    BleLogSetLevel(log, BleLogLevelInfo);
+    double disabled = timeNs("below level (release packet log)", runWants, log, ITERATIONS);
+    BleLogSetLevel(log, BleLogLevelOff);
+    timeNs("level off", runWants, log, ITERATIONS);
+
+    BleLogSetLevel(log, BleLogLevelDebug);
+    BleLogSetSampleEvery(log, BleLogLevelDebug, 100);
+    timeNs("sampled 1/100", runWants, log, ITERATIONS);
+    timeNs("sampled 1/100 + format + append", runAppend, log, ITERATIONS / 10);
+
+    BleLogSetSampleEvery(log, BleLogLevelDebug, 1);
+    timeNs("format + append", runAppend, log, ITERATIONS / 10);
+    timeNs("drain into batches", runDrain, log, ITERATIONS / 10);
+
+    BleLogStats stats = BleLogGetStats(log);
+    printf("[bench] stats: appended %llu, drained %llu, batches %llu, sampledOut %llu, dropped %llu\n",
+           (unsigned long long)stats.appended, (unsigned long long)stats.drained,
+           (unsigned long long)stats.batches, (unsigned long long)stats.sampledOut,
+           (unsigned long long)stats.dropped);
+    BleLogDestroy(log);
+
+    failures += checkTruncation();
+    failures += runConcurrent(ITERATIONS / 20);
+
+    if (disabled >= 1000) {
+        printf("[bench] FAIL: disabled path %.2f ns >= 1 µs\n", disabled);
+        failures++;
+    }
+    if (failures) {
+        return 1;
+    }
+    printf("[bench] ok\n");
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * Benchmark for the caffeine curve kernel in src/utils/caffeinePk.
+ *
+ * Runs a day of synthetic dose sets through the per-sample reference
+ * (totalMgAt at every point, one pow per dose per sample) and through the
+ * recurrence kernel, and checks that peak, clearance and the curve samples
+ * agree within 0.05 mg. The "warm" pass repeats the same dose sets, as a
+ * re-render does, and is served from the memo.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/bench-caffeine-curve.ts [sets=500] [dosesPerSet=4]
+ */
+
+import {
+  buildMultiDoseCurvePath,
+  caffeineCurve,
+  clearanceHour,
+  peakMgForDoses,
+  totalMgAt,
+  type CaffeineDose,
+} from '../src/utils/caffeinePk';
+
+const SETS = Number(process.argv[2] ?? 500);
+const DOSES = Number(process.argv[3] ?? 4);
+
+let seed = 11;
+const rand = () => {
+  seed = (seed * 1_103_515_245 + 12_345) & 0x7fffffff;
+  return seed / 0x7fffffff;
+};
+
+const doseSets: CaffeineDose[][] = Array.from({ length: SETS }, () =>
+  Array.from({ length: DOSES }, () => ({
+    intakeHour: Math.round((6 + rand() * 12) * 60) / 60,
+    amountMg: [63, 95, 150, 200][Math.floor(rand() * 4)],
+  })));
+
+// Same grid the kernel uses: `step` shrunk so the last sample lands on `end`
+function referenceSeries(doses: CaffeineDose[], start: number, end: number, step: number): number[] {
+  const intervals = Math.max(1, Math.ceil((end - start) / step - 1e-9));
+  const s = (end - start) / intervals;
+  return Array.from({ length: intervals + 1 }, (_, i) => totalMgAt(start + i * s, doses));
+}
+
+// The path builder as it was: toFixed() per point over totalMgAt samples
+function referencePath(doses: CaffeineDose[]): string {
+  const pts: string[] = [];
+  for (let t = 5; t <= 24 + 0.05; t += 0.12) {
+    const tc = Math.min(t, 24);
+    const conc = Math.min(totalMgAt(tc, doses) / 400, 1);
+    pts.push(`${pts.length === 0 ? 'M' : 'L'}${(20 + ((tc - 5) / 19) * 300).toFixed(1)},${(10 + (1 - conc) * 100).toFixed(1)}`);
+  }
+  return pts.join(' ');
+}
+
+function referenceClearance(doses: CaffeineDose[]): number | null {
+  const from = Math.max(...doses.map(d => d.intakeHour)) + 0.75;
+  const series = referenceSeries(doses, from, 26, 0.1);
+  const i = series.findIndex(v => v < 100);
+  return i < 0 ? null : from + i * ((26 - from) / (series.length - 1));
+}
+
+function bench(label: string, fn: () => void): number {
+  const t0 = performance.now();
+  fn();
+  const ms = performance.now() - t0;
+  console.log(`[bench] ${label.padEnd(26)} ${ms.toFixed(2)} ms`);
+  return ms;
+}
+
+console.log(`[bench] ${SETS} dose sets × ${DOSES} doses`);
+
+let ok = true;
+const ref = { peak: [] as number[], clear: [] as (number | null)[], curves: [] as number[][] };
+const cold = bench('per-sample reference', () => {
+  for (const d of doseSets) {
+    ref.curves.push(referenceSeries(d, 5, 24, 0.12));
+    referencePath(d);
+    ref.peak.push(Math.max(...referenceSeries(d, 6, 23, 0.1)));
+    ref.clear.push(referenceClearance(d));
+  }
+});
+
+const kernel = bench('kernel (cold)', () => {
+  doseSets.forEach((d, i) => {
+    const curve = caffeineCurve(d, 5, 24, 0.12);
+    buildMultiDoseCurvePath(d, 300, 20, 5, 24, 10, 110);
+    const peak = peakMgForDoses(d);
+    const clear = clearanceHour(d);
+    if (
+      Math.abs(peak - ref.peak[i]) > 0.05
+      || (clear === null) !== (ref.clear[i] === null)
+      || (clear !== null && Math.abs(clear - ref.clear[i]!) > 1e-6)
+      || curve.mg.some((v, j) => Math.abs(v - ref.curves[i][j]) > 0.05)
+    ) {
+      ok = false;
+      console.error(`[bench] MISMATCH in set ${i}`);
+    }
+  });
+});
+
+bench('kernel (warm, memoized)', () => {
+  for (const d of doseSets.slice(-16)) {
+    buildMultiDoseCurvePath(d, 300, 20, 5, 24, 10, 110);
+    peakMgForDoses(d);
+    clearanceHour(d);
+  }
+});
+
+console.log(`[bench] cold speedup ${(cold / kernel).toFixed(1)}x`);
+console.log(ok ? '[bench] results agree' : '[bench] FAILED');
+if (!ok) process.exit(1);
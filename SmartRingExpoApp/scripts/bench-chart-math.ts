@@ -0,0 +1,95 @@
+/**
+ * Micro-benchmarks for src/utils/chartMath across series sizes.
+ *
+ * For each size, runs the previous implementation and the current one of:
+ *   - rolling average series: rollingAvg per index (slice+filter) vs rollingAverages
+ *   - roundedBar:             array join vs single template
+ *   - monotoneCubicPath:      a rebuild vs a memoPath hit (incl. seriesKey)
+ * checks the outputs agree, and prints µs per call. Exits non-zero on mismatch.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/bench-chart-math.ts [sizes=7,30,90,365,1825]
+ */
+
+import {
+  memoPath,
+  monotoneCubicPath,
+  rollingAverages,
+  roundedBar,
+  seriesKey,
+} from '../src/utils/chartMath';
+
+const SIZES = (process.argv[2] ?? '7,30,90,365,1825').split(',').map(Number);
+
+let seed = 3;
+const rand = () => {
+  seed = (seed * 1_103_515_245 + 12_345) & 0x7fffffff;
+  return seed / 0x7fffffff;
+};
+
+// ── Previous implementations ─────────────────────────────────────────────────
+
+function legacyRollingAvg(values: number[], i: number, window = 5): number | null {
+  const half = Math.floor(window / 2);
+  const from = Math.max(0, i - half);
+  const to = Math.min(values.length - 1, i + half);
+  const valid = values.slice(from, to + 1).filter(v => v > 0);
+  return valid.length > 0 ? valid.reduce((a, b) => a + b, 0) / valid.length : null;
+}
+
+function legacyRoundedBar(x: number, y: number, w: number, h: number, rTop: number, rBot: number): string {
+  const rt = Math.min(rTop, h / 2, w / 2);
+  const rb = Math.min(rBot, h / 2, w / 2);
+  return [
+    `M ${x + rt} ${y}`, `H ${x + w - rt}`, `Q ${x + w} ${y} ${x + w} ${y + rt}`,
+    `V ${y + h - rb}`, `Q ${x + w} ${y + h} ${x + w - rb} ${y + h}`, `H ${x + rb}`,
+    `Q ${x} ${y + h} ${x} ${y + h - rb}`, `V ${y + rt}`, `Q ${x} ${y} ${x + rt} ${y}`, `Z`,
+  ].join(' ');
+}
+
+// ── Harness ──────────────────────────────────────────────────────────────────
+
+function perCall<T>(fn: () => T): { us: number; out: T } {
+  let out!: T;
+  let iters = 0;
+  const t0 = performance.now();
+  // Run for ~50 ms so tiny series still get a stable reading
+  while (performance.now() - t0 < 50) {
+    out = fn();
+    iters++;
+  }
+  return { us: ((performance.now() - t0) * 1000) / iters, out };
+}
+
+let ok = true;
+function row(label: string, n: number, before: { us: number; out: unknown }, after: { us: number; out: unknown }) {
+  const same = JSON.stringify(before.out) === JSON.stringify(after.out);
+  if (!same) {
+    ok = false;
+    console.error(`[bench] MISMATCH ${label} n=${n}`);
+  }
+  console.log(
+    `[bench] ${label.padEnd(16)} n=${String(n).padEnd(5)} ${before.us.toFixed(2).padStart(9)} µs → ${after.us.toFixed(2).padStart(8)} µs  (${(before.us / after.us).toFixed(1)}x)`,
+  );
+}
+
+for (const n of SIZES) {
+  const values = Array.from({ length: n }, () => (rand() < 0.15 ? 0 : Math.round(40 + rand() * 60)));
+  const pts = values.map((v, i) => ({ x: i * 38 + 19, y: 130 - v }));
+
+  row('rolling series', n,
+    perCall(() => values.map((_, i) => legacyRollingAvg(values, i))),
+    perCall(() => rollingAverages(values)));
+
+  row('roundedBar ×n', n,
+    perCall(() => values.map((v, i) => legacyRoundedBar(i * 38 + 5, 130 - v, 28, v, 8, 2))),
+    perCall(() => values.map((v, i) => roundedBar(i * 38 + 5, 130 - v, 28, v, 8, 2))));
+
+  row('cubic → memo', n,
+    perCall(() => monotoneCubicPath(pts)),
+    perCall(() => memoPath(`bench|${seriesKey(values)}`, () => monotoneCubicPath(pts))));
+}
+
+console.log(ok ? '[bench] results identical' : '[bench] FAILED');
+if (!ok) process.exit(1);
@@ -0,0 +1,172 @@
+/**
+ * Render-count replay for the selector-based HomeDataContext (src/utils/selectorStore).
+ *
+ * Replays the state updates one full useHomeData sync makes (phase changes, a
+ * loading / done tick per metric, sleep, battery, a day of HR, HRV, steps, vitals,
+ * cloud) twice: a cold sync from empty state, then a foreground re-sync that fetches
+ * the same data again as fresh objects. For each home consumer it counts renders under
+ *   - the old context: every update is a new context value, so every consumer renders
+ *   - the store: a consumer renders when its slice (the fields it selects, or the props
+ *     a memoized card gets) changes after structural sharing, or when its parent
+ *     renders and it isn't memoized (tabs under the screen, CaffeineWindowCard)
+ * and checks every shared snapshot still deep-equals the state it was built from.
+ * Exits non-zero on mismatch or if any consumer renders more than before.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/bench-home-data-store.ts
+ */
+
+import { createSelection, createSelectorStore, shallowEqual } from '../src/utils/selectorStore';
+
+type State = Record<string, any>;
+
+const METRICS = ['sleep', 'battery', 'heartRate', 'hrv', 'steps', 'vitals', 'cloud'];
+const day = new Date(2026, 3, 14).getTime();
+const MINUTE = 60_000;
+
+const emptyState = (): State => ({
+  overallScore: 0, strain: 0, strainBreakdown: [], readiness: 0, sleepScore: 0,
+  lastNightSleep: { score: 0, timeAsleep: '0h 0m', timeAsleepMinutes: 0, restingHR: 0, respiratoryRate: 0, segments: [], bedTime: new Date(day), wakeTime: new Date(day) },
+  activity: { steps: 0, calories: 0, activeMinutes: 0, workouts: [] },
+  ringBattery: 0, isRingCharging: false, streakDays: 0, insight: '', insightType: 'general',
+  isLoading: true, isSyncing: false, error: null, userName: '', avatarUrl: '', isRingConnected: false,
+  hrChartData: [], hrDataIsToday: false, hrvSdnn: 0,
+  todayVitals: { temperatureC: null, minSpo2: null, lastSpo2: null, updatedAt: null },
+  cardDataStatus: 'idle', contributors: {}, featureAvailability: {}, activitySessions: [], recoveryContributors: {},
+  syncProgress: { phase: 'idle', showSheet: false, metrics: METRICS.map(key => ({ key, label: key, status: 'pending' })) },
+  lastSyncedAt: null, stravaActivities: [], unifiedActivities: [], todayNaps: [], totalNapMinutesToday: 0,
+  unifiedSleepSessions: [], totalSleepMinutes: 0,
+  refresh: async () => {}, applyOverrideNow: async () => {}, refreshMissingCardData: async () => {},
+});
+
+// Fresh objects each call, like a sync re-reading the ring
+const sleepData = () => {
+  const segments = [];
+  for (let m = 0; m < 460; m += 20) {
+    segments.push({ stage: ['core', 'deep', 'rem', 'awake'][(m / 20) % 4], startTime: new Date(day - 7 * 60 * MINUTE + m * MINUTE), endTime: new Date(day - 7 * 60 * MINUTE + (m + 20) * MINUTE) });
+  }
+  return { score: 82, timeAsleep: '7h 12m', timeAsleepMinutes: 432, restingHR: 52, respiratoryRate: 14, segments, bedTime: new Date(day - 7 * 60 * MINUTE), wakeTime: new Date(day + 40 * MINUTE), inBedTime: new Date(day - 7 * 60 * MINUTE) };
+};
+const hrChart = () => Array.from({ length: 1440 }, (_, m) => ({ timeMinutes: m, heartRate: 55 + ((m * 7) % 40) }));
+const activities = () => [{ id: 'a1', source: 'ring', startDate: new Date(day + 9 * 60 * MINUTE).toISOString(), durationMin: 35 }];
+
+/** The setData calls of one fetchData run, as (prev → next) functions. */
+function syncUpdates(syncedAt: number): Array<(prev: State) => State> {
+  const sp = (update: (p: any) => any) => (prev: State) => ({ ...prev, syncProgress: update(prev.syncProgress) });
+  const metric = (key: string, status: string) =>
+    sp(p => ({ ...p, metrics: p.metrics.map((m: any) => m.key === key ? { ...m, status } : m) }));
+  const updates: Array<(prev: State) => State> = [
+    prev => ({ ...prev, isSyncing: true, error: null, syncProgress: { ...prev.syncProgress, phase: 'connecting', metrics: METRICS.map(key => ({ key, label: key, status: 'pending' })) } }),
+    sp(p => ({ ...p, phase: 'connected' })),
+    prev => ({ ...prev, isRingConnected: true }),
+    sp(p => ({ ...p, phase: 'syncing' })),
+  ];
+  for (const key of METRICS) {
+    updates.push(metric(key, 'loading'));
+    if (key === 'sleep') {
+      updates.push(prev => ({ ...prev, lastNightSleep: sleepData(), sleepScore: 82, unifiedSleepSessions: [{ segments: sleepData().segments, bedTime: new Date(day - 7 * 60 * MINUTE), wakeTime: new Date(day + 40 * MINUTE), label: 'Night' }] }));
+    } else if (key === 'battery') {
+      updates.push(prev => ({ ...prev, ringBattery: 76, isRingCharging: false }));
+    } else if (key === 'heartRate') {
+      updates.push(prev => ({ ...prev, hrChartData: hrChart(), hrDataIsToday: true }));
+    } else if (key === 'hrv') {
+      updates.push(prev => ({ ...prev, hrvSdnn: 48 }));
+    } else if (key === 'steps') {
+      updates.push(prev => ({ ...prev, activity: { steps: 6400, calories: 2100, activeMinutes: 42, workouts: [] }, unifiedActivities: activities() }));
+    } else if (key === 'vitals') {
+      updates.push(prev => ({ ...prev, todayVitals: { temperatureC: 36.4, minSpo2: 94, lastSpo2: 97, updatedAt: day }, cardDataStatus: 'ready' }));
+    }
+    updates.push(metric(key, 'done'));
+  }
+  updates.push(
+    prev => ({ ...prev, overallScore: 78, readiness: 74, strain: 9.2, insight: 'Good recovery', insightType: 'sleep', isLoading: false }),
+    sp(p => ({ ...p, phase: 'complete' })),
+    prev => ({ ...prev, isSyncing: false, lastSyncedAt: syncedAt }),
+  );
+  return updates;
+}
+
+// ---- Consumers: fields they select (tabs, screen) or props their parent passes (memoized cards) ----
+
+const pick = (...keys: string[]) => (s: State) => Object.fromEntries(keys.map(k => [k, s[k]]));
+// Parents listed before children
+const consumers: Record<string, (s: State) => unknown> = {
+  NewHomeScreen: pick('avatarUrl', 'isRingCharging', 'isRingConnected', 'isSyncing', 'lastNightSleep', 'lastSyncedAt', 'refresh', 'ringBattery', 'sleepScore', 'streakDays', 'userName'),
+  SyncStatusSheet: s => ({ syncProgress: s.syncProgress, isSyncing: s.isSyncing }),
+  OverviewTab: pick('activitySessions', 'hrChartData', 'insight', 'isLoading', 'lastNightSleep', 'lastSyncedAt', 'overallScore', 'readiness', 'refresh', 'sleepScore', 'strain', 'todayNaps', 'unifiedActivities', 'userName'),
+  SleepTab: pick('applyOverrideNow', 'cardDataStatus', 'hrvSdnn', 'insight', 'insightType', 'isLoading', 'isRingConnected', 'isSyncing', 'lastNightSleep', 'lastSyncedAt', 'refresh', 'refreshMissingCardData', 'sleepScore', 'todayNaps', 'todayVitals', 'totalNapMinutesToday', 'unifiedSleepSessions'),
+  ActivityTab: pick('activity', 'cardDataStatus', 'isRingConnected', 'isSyncing', 'lastSyncedAt', 'refresh', 'refreshMissingCardData', 'stravaActivities', 'todayVitals', 'unifiedActivities'),
+  DailyHeartRateCard: s => ({ preloadedData: s.hrChartData, unifiedActivities: s.unifiedActivities }),
+  SleepHypnogram: s => ({ segments: s.lastNightSleep.segments, bedTime: s.lastNightSleep.inBedTime ?? s.lastNightSleep.bedTime, wakeTime: s.lastNightSleep.wakeTime, sessions: s.unifiedSleepSessions }),
+  DailyTimelineCard: s => ({ sleep: s.lastNightSleep, activitySessions: s.activitySessions, unifiedActivities: s.unifiedActivities, todayNaps: s.todayNaps }),
+  CaffeineWindowCard: pick('lastNightSleep'),
+};
+/** Non-memoized children re-render with their parent. */
+const parentOf: Record<string, string> = {
+  OverviewTab: 'NewHomeScreen',
+  SleepTab: 'NewHomeScreen',
+  ActivityTab: 'NewHomeScreen',
+  CaffeineWindowCard: 'OverviewTab',
+};
+
+// ---- Replay ----
+
+const toJson = (s: State) => JSON.stringify(s, (_k, v) => (typeof v === 'function' ? 'fn' : v));
+let ok = true;
+
+function replay(label: string, initial: State, updates: Array<(prev: State) => State>): State {
+  const store = createSelectorStore(initial);
+  const rendersOld: Record<string, number> = {};
+  const rendersNew: Record<string, number> = {};
+  const selections = Object.fromEntries(Object.keys(consumers).map(name => [name, createSelection<State, unknown>()]));
+  const last: Record<string, unknown> = {};
+  for (const name of Object.keys(consumers)) {
+    last[name] = selections[name].read(store.getSnapshot(), consumers[name], shallowEqual);
+    rendersOld[name] = 0;
+    rendersNew[name] = 0;
+  }
+  store.subscribe(() => {
+    const rendered = new Set<string>();
+    for (const name of Object.keys(consumers)) {
+      const value = selections[name].read(store.getSnapshot(), consumers[name], shallowEqual);
+      if (value !== last[name] || rendered.has(parentOf[name])) {
+        rendersNew[name]++;
+        rendered.add(name);
+      }
+      last[name] = value;
+    }
+  });
+
+  let state = initial;
+  let setMs = 0;
+  for (const update of updates) {
+    state = update(state);
+    for (const name of Object.keys(consumers)) rendersOld[name]++;
+    const t0 = performance.now();
+    store.set(state);
+    setMs += performance.now() - t0;
+    if (toJson(store.getSnapshot()) !== toJson(state)) {
+      ok = false;
+      console.error(`[bench] MISMATCH ${label}: shared snapshot differs from state`);
+    }
+  }
+  console.log(`[bench] ${label}: ${updates.length} updates, ${setMs.toFixed(2)} ms in store.set + selectors`);
+  console.log(`[bench]   ${'consumer'.padEnd(20)} ${'context'.padStart(7)} ${'store'.padStart(7)}`);
+  let totalOld = 0;
+  let totalNew = 0;
+  for (const name of Object.keys(consumers)) {
+    console.log(`[bench]   ${name.padEnd(20)} ${String(rendersOld[name]).padStart(7)} ${String(rendersNew[name]).padStart(7)}`);
+    totalOld += rendersOld[name];
+    totalNew += rendersNew[name];
+    if (rendersNew[name] > rendersOld[name]) ok = false;
+  }
+  console.log(`[bench]   ${'total'.padEnd(20)} ${String(totalOld).padStart(7)} ${String(totalNew).padStart(7)}`);
+  return state;
+}
+
+const afterCold = replay('cold sync', emptyState(), syncUpdates(day + 3 * 60 * MINUTE));
+replay('re-sync, same data', afterCold, syncUpdates(day + 5 * 60 * MINUTE));
+
+console.log(ok ? '[bench] results identical' : '[bench] FAILED');
+if (!ok) process.exit(1);
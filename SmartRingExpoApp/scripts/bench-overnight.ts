@@ -0,0 +1,130 @@
+/**
+ * Benchmark for OvernightStore over a full night of X3 overnight data.
+ *
+ * Synthesizes what the ring returns for one 8 h night: continuous SpO2 in
+ * 15-minute records (one per packet, as X3 pages them) with a few
+ * desaturation dips, and sleep detail + activity in per-minute units. Then
+ * measures, each as the median of N runs:
+ *   - ingest: parse packets, fill the night grid, summarize, persist
+ *   - cold read: summary and full decoded series from a fresh store instance
+ * and compares the persisted size against the raw packets and against the
+ * naive [{ timestamp, spo2 }] sample list.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/bench-overnight.ts [nights=1] [runs=20]
+ */
+
+import { OvernightStore } from '../src/services/OvernightStore';
+import type { ActivityDetailStorage } from '../src/services/ActivityDetailStore';
+
+const NIGHTS = Number(process.argv[2] ?? 1);
+const RUNS = Number(process.argv[3] ?? 20);
+
+// Deterministic PRNG so runs are comparable
+let seed = 42;
+const rand = () => {
+  seed = (seed * 1_103_515_245 + 12_345) & 0x7fffffff;
+  return seed / 0x7fffffff;
+};
+
+const pad2 = (n: number) => (n < 10 ? `0${n}` : `${n}`);
+const ringDate = (d: Date) =>
+  `${d.getFullYear()}.${pad2(d.getMonth() + 1)}.${pad2(d.getDate())} ${pad2(d.getHours())}:${pad2(d.getMinutes())}:${pad2(d.getSeconds())}`;
+
+function syntheticNights(nights: number) {
+  const spo2Packets: any[] = [];
+  const sleepPackets: any[] = [];
+  let samples = 0;
+  for (let n = nights; n >= 1; n--) {
+    const bed = new Date();
+    bed.setDate(bed.getDate() - n);
+    bed.setHours(23, 10, 0, 0);
+    const minutes = 8 * 60;
+
+    for (let m = 0; m < minutes; m += 15) {
+      const values: number[] = [];
+      for (let i = 0; i < 15; i++) {
+        const dip = rand() < 0.02 ? 4 + Math.floor(rand() * 4) : 0;
+        values.push(Math.max(85, Math.min(100, Math.round(96 + rand() * 2 - dip))));
+      }
+      samples += values.length;
+      spo2Packets.push({ arrayContinueSpo2Data: [{ date: ringDate(new Date(bed.getTime() + m * 60_000)), arrayContinueSpo2Data: values }] });
+    }
+
+    const quality: number[] = [];
+    const activity: number[] = [];
+    for (let m = 0; m < minutes; m++) {
+      const cycle = (m % 90) / 90;
+      quality.push(m < 15 || m > minutes - 10 ? 4 : cycle < 0.25 ? 1 : cycle < 0.75 ? 2 : 3);
+      activity.push(rand() < 0.08 ? 1 + Math.floor(rand() * 20) : 0);
+    }
+    sleepPackets.push({
+      arraySleepData: [{ startTime_SleepData: ringDate(bed), sleepUnitLength: 1, arraySleepQuality: quality, arrayActicityData: activity }],
+    });
+  }
+  return { spo2Packets, sleepPackets, samples };
+}
+
+function memoryStorage(): ActivityDetailStorage & { map: Map<string, string> } {
+  const map = new Map<string, string>();
+  return {
+    map,
+    async getItem(k) { return map.get(k) ?? null; },
+    async setItem(k, v) { map.set(k, v); },
+    async multiGet(ks) { return ks.map(k => [k, map.get(k) ?? null] as const); },
+    async multiSet(pairs) { for (const [k, v] of pairs) map.set(k, v); },
+    async getAllKeys() { return [...map.keys()]; },
+    async multiRemove(ks) { for (const k of ks) map.delete(k); },
+  };
+}
+
+async function time<T>(fn: () => Promise<T>): Promise<{ ms: number; out: T }> {
+  let out!: T;
+  const samples: number[] = [];
+  for (let i = 0; i < RUNS; i++) {
+    const t0 = performance.now();
+    out = await fn();
+    samples.push(performance.now() - t0);
+  }
+  samples.sort((a, b) => a - b);
+  return { ms: samples[Math.floor(samples.length / 2)], out };
+}
+
+async function main() {
+  const { spo2Packets, sleepPackets, samples } = syntheticNights(NIGHTS);
+  console.log(`[bench] ${NIGHTS} night(s): spo2 packets=${spo2Packets.length} (${samples} samples), sleep packets=${sleepPackets.length} (median of ${RUNS})`);
+
+  let storage = memoryStorage();
+  const ingest = await time(async () => {
+    storage = memoryStorage();
+    const store = new OvernightStore(async () => spo2Packets, async () => sleepPackets, storage);
+    return store.sync();
+  });
+  const nightKey = ingest.out.nights[ingest.out.nights.length - 1];
+  console.log(`[bench] ingest     : ${ingest.ms.toFixed(2)} ms → nights=${ingest.out.nights.join(',')}`);
+
+  const summary = await time(async () => new OvernightStore(async () => [], async () => [], storage).getNight(nightKey));
+  const series = await time(async () => new OvernightStore(async () => [], async () => [], storage).getSeries(nightKey));
+  console.log(`[bench] cold summary: ${summary.ms.toFixed(3)} ms`);
+  console.log(`[bench] cold series : ${series.ms.toFixed(3)} ms`);
+  console.log('[bench] summary', summary.out);
+
+  const rawBytes = JSON.stringify(spo2Packets).length + JSON.stringify(sleepPackets).length;
+  const naive: { timestamp: number; spo2: number }[] = [];
+  for (const p of spo2Packets) {
+    for (const e of p.arrayContinueSpo2Data) {
+      const [d, t] = e.date.split(' ');
+      const [y, mo, da] = d.split('.').map(Number);
+      const [h, mi] = t.split(':').map(Number);
+      const start = new Date(y, mo - 1, da, h, mi).getTime();
+      e.arrayContinueSpo2Data.forEach((v: number, i: number) => naive.push({ timestamp: start + i * 60_000, spo2: v }));
+    }
+  }
+  const naiveBytes = JSON.stringify(naive).length;
+  let storedBytes = 0;
+  for (const [k, v] of storage.map) if (k.startsWith('overnight_v1:')) storedBytes += v.length;
+  console.log(`[bench] bytes: raw packets=${rawBytes} naive spo2 samples=${naiveBytes} stored (all streams)=${storedBytes}`);
+}
+
+main();
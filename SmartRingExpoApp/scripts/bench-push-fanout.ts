@@ -0,0 +1,128 @@
+/**
+ * Local benchmark for the daily-summary-push / whatsapp-checkin fan-out path.
+ *
+ * Spins up a mock push endpoint on localhost (fixed latency + a fraction of
+ * 429 responses), then sends N synthetic tokens through the shared cohort
+ * grouping + bounded-concurrency sender, and compares against a strictly
+ * serial batch loop. Both use the same non-idempotent retry policy as
+ * daily-summary-push, so they deliver the same messages and users/s compares
+ * only the concurrency.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/bench-push-fanout.ts [tokens=10000] [latencyMs=60] [rateLimitRate=0.05]
+ */
+
+import * as http from 'http';
+import type { AddressInfo } from 'net';
+import {
+  chunk,
+  fetchWithRetry,
+  groupByTzCohort,
+  mapWithConcurrency,
+} from '../supabase/functions/_shared/fanout';
+
+const TOKENS = Number(process.argv[2] ?? 10_000);
+const LATENCY_MS = Number(process.argv[3] ?? 60);
+const FAIL_RATE = Number(process.argv[4] ?? 0.05);
+
+const EXPO_BATCH = 100;
+const SEND_CONCURRENCY = 4;
+const TZ_OFFSETS = [-480, -300, -240, -180, 0, 60, 120, 330, 480, 540];
+
+let served = 0;
+let rejected = 0;
+
+function startMockEndpoint(): Promise<http.Server> {
+  const server = http.createServer((req, res) => {
+    let body = '';
+    req.on('data', c => { body += c; });
+    req.on('end', () => {
+      setTimeout(() => {
+        if (Math.random() < FAIL_RATE) {
+          rejected++;
+          res.writeHead(429, { 'Retry-After': '0' });
+          res.end();
+          return;
+        }
+        served += (JSON.parse(body) as unknown[]).length;
+        res.writeHead(200, { 'Content-Type': 'application/json' });
+        res.end('{"data":[]}');
+      }, LATENCY_MS);
+    });
+  });
+  return new Promise(resolve => server.listen(0, '127.0.0.1', () => resolve(server)));
+}
+
+function syntheticTokens(n: number) {
+  const rows = [];
+  for (let i = 0; i < n; i++) {
+    rows.push({
+      user_id: `user-${Math.floor(i / 1.2)}`, // ~20% users with 2 devices
+      token: `ExponentPushToken[${i.toString(36)}]`,
+      tz_offset_min: TZ_OFFSETS[i % TZ_OFFSETS.length],
+    });
+  }
+  return rows;
+}
+
+function toMessages(rows: ReturnType<typeof syntheticTokens>) {
+  return rows.map(r => ({
+    to: r.token,
+    title: 'Good morning! Your sleep is ready 🌙',
+    body: 'You slept 7h 32m · Score: 85. Tap to see your full analysis.',
+    sound: 'default',
+    data: { url: 'smartring:///?tab=sleep' },
+  }));
+}
+
+/** One Expo batch, retried the way daily-summary-push retries it. */
+async function sendBatch(url: string, batch: unknown[]): Promise<number> {
+  const res = await fetchWithRetry(url, {
+    method: 'POST',
+    headers: { 'Content-Type': 'application/json' },
+    body: JSON.stringify(batch),
+  }, { baseDelayMs: 20, idempotent: false });
+  await res.arrayBuffer();
+  return res.ok ? batch.length : 0;
+}
+
+async function runSerial(url: string, rows: ReturnType<typeof syntheticTokens>) {
+  let sent = 0;
+  for (const batch of chunk(toMessages(rows), EXPO_BATCH)) sent += await sendBatch(url, batch);
+  return sent;
+}
+
+async function runFanout(url: string, rows: ReturnType<typeof syntheticTokens>) {
+  const cohorts = groupByTzCohort(rows);
+  const messages = cohorts.flatMap(c => toMessages(c.rows));
+  const sentPerBatch = await mapWithConcurrency(chunk(messages, EXPO_BATCH), SEND_CONCURRENCY, batch => sendBatch(url, batch));
+  return { sent: sentPerBatch.reduce((a, b) => a + b, 0), cohorts: cohorts.length };
+}
+
+async function main() {
+  const server = await startMockEndpoint();
+  const url = `http://127.0.0.1:${(server.address() as AddressInfo).port}/push/send`;
+  const rows = syntheticTokens(TOKENS);
+
+  console.log(`[bench] ${TOKENS} tokens, ${LATENCY_MS} ms latency, ${(FAIL_RATE * 100).toFixed(0)}% 429`);
+
+  served = 0; rejected = 0;
+  let t0 = performance.now();
+  const serialSent = await runSerial(url, rows);
+  let secs = (performance.now() - t0) / 1000;
+  console.log(`[bench] serial : sent ${serialSent}/${TOKENS} in ${secs.toFixed(2)} s → ${(serialSent / secs).toFixed(0)} users/s (retried batches: ${rejected})`);
+
+  served = 0; rejected = 0;
+  t0 = performance.now();
+  const fan = await runFanout(url, rows);
+  secs = (performance.now() - t0) / 1000;
+  console.log(`[bench] fan-out: sent ${fan.sent}/${TOKENS} in ${secs.toFixed(2)} s → ${(fan.sent / secs).toFixed(0)} users/s (${fan.cohorts} cohorts, retried batches: ${rejected})`);
+
+  server.close();
+}
+
+main().catch(err => {
+  console.error('[bench] failed:', err);
+  process.exit(1);
+});
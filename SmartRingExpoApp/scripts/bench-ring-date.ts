@@ -0,0 +1,121 @@
+/**
+ * Correctness + throughput check for src/utils/ringDate.
+ *
+ * Correctness: every 7m13s of a year (so both DST switches of the current TZ, and every
+ * minute offset, are hit), plus the nonexistent / repeated hours around the usual
+ * switch dates, must parse exactly like new Date(y, m - 1, d, hh, mm, ss). Out-of-range
+ * fields roll over like new Date; malformed values are rejected. Run it in several zones:
+ *   for tz in UTC Europe/Berlin America/New_York Australia/Lord_Howe; do TZ=$tz npx tsx ...; done
+ *
+ * Throughput: the split / map(Number) / new Date parser the services used before vs
+ * parseRingDate on a day of per-second stamps. Target is >10M parses/s on a laptop-class
+ * core; the fast path does little more than read the 19 characters.
+ *
+ * Exits non-zero on any mismatch.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/bench-ring-date.ts [year=2026]
+ */
+
+import { RingDateParser, parseRingDate, resetRingDateCache, ringDateMinutes } from '../src/utils/ringDate';
+
+const YEAR = Number(process.argv[2] ?? 2026);
+
+const pad = (n: number) => String(n).padStart(2, '0');
+const fmt = (y: number, mo: number, d: number, hh: number, mm: number, ss: number) =>
+  `${y}.${pad(mo)}.${pad(d)} ${pad(hh)}:${pad(mm)}:${pad(ss)}`;
+
+let failures = 0;
+const fail = (msg: string) => {
+  if (failures++ < 10) console.error(`[bench] MISMATCH ${msg}`);
+};
+
+// ---- Correctness ----
+
+let checked = 0;
+const parser = new RingDateParser();
+for (let t = new Date(YEAR, 0, 1).getTime(); t < new Date(YEAR + 1, 0, 1).getTime(); t += 433_000) {
+  const d = new Date(t);
+  const fields = [d.getFullYear(), d.getMonth() + 1, d.getDate(), d.getHours(), d.getMinutes(), d.getSeconds()] as const;
+  const text = fmt(...fields);
+  const expected = new Date(fields[0], fields[1] - 1, fields[2], fields[3], fields[4], fields[5]).getTime();
+  if (parseRingDate(text) !== expected) fail(`${text}: ${parseRingDate(text)} vs ${expected}`);
+  if (parser.parse(text.replace(/\./g, '-')) !== expected) fail(`${text} (dashes)`);
+  if (ringDateMinutes(text) !== fields[3] * 60 + fields[4]) fail(`${text} minutes`);
+  checked++;
+}
+
+// Wall-clock times that don't exist or happen twice in common zones
+const edges = [
+  [3, 8], [3, 29], [3, 30], [4, 5], [9, 27], [10, 4], [10, 25], [10, 26], [11, 1], [11, 2],
+].flatMap(([mo, d]) => [0, 1, 2, 3].flatMap(hh => [0, 15, 30, 59].map(mm => [YEAR, mo, d, hh, mm, 30] as const)));
+for (const f of edges) {
+  const expected = new Date(f[0], f[1] - 1, f[2], f[3], f[4], f[5]).getTime();
+  if (parseRingDate(fmt(...f)) !== expected) fail(`edge ${fmt(...f)}`);
+  if (new RingDateParser().parse(fmt(...f)) !== expected) fail(`edge ${fmt(...f)} (cold)`);
+  checked++;
+}
+
+const shortForms: Array<[string, number]> = [
+  [`${YEAR}.04.12`, new Date(YEAR, 3, 12).getTime()],
+  [`${YEAR}.04.12 07:45`, new Date(YEAR, 3, 12, 7, 45).getTime()],
+  [`${YEAR}.4.2 7:05:09`, new Date(YEAR, 3, 2, 7, 5, 9).getTime()],
+  [`  ${YEAR}.04.12   07:45:10 `, new Date(YEAR, 3, 12, 7, 45, 10).getTime()],
+];
+for (const [text, expected] of shortForms) {
+  if (parseRingDate(text) !== expected) fail(`"${text}"`);
+  checked++;
+}
+
+// Out-of-range fields roll over like new Date, as every parser before this one did
+const rollovers: Array<[string, number]> = [
+  [`${YEAR}.13.01 00:00:00`, new Date(YEAR, 12, 1).getTime()],
+  [`${YEAR}.01.01 24:00:00`, new Date(YEAR, 0, 1, 24).getTime()],
+];
+for (const [text, expected] of rollovers) {
+  if (parseRingDate(text) !== expected) fail(`"${text}"`);
+  checked++;
+}
+
+for (const bad of [undefined, null, 42, '', 'garbage', `${YEAR}.01.01T00:00:00`, `${YEAR}.ab.01`, '1900.01.01 00:00:00']) {
+  if (parseRingDate(bad) !== undefined) fail(`accepted ${JSON.stringify(bad)}`);
+  checked++;
+}
+
+resetRingDateCache();
+console.log(`[bench] ${checked} stamps checked against new Date in ${Intl.DateTimeFormat().resolvedOptions().timeZone}`);
+
+// ---- Throughput ----
+
+function baseline(value?: string): number | undefined {
+  if (!value || typeof value !== 'string') return undefined;
+  const [datePart, timePart] = value.trim().split(/\s+/);
+  if (!datePart) return undefined;
+  const [y, m, d] = datePart.split('.').map(Number);
+  if ([y, m, d].some(n => Number.isNaN(n))) return undefined;
+  const [hh, mm, ss] = (timePart || '00:00:00').split(':').map(Number);
+  if ([hh, mm, ss].some(n => Number.isNaN(n))) return undefined;
+  const ts = new Date(y, m - 1, d, hh, mm, ss).getTime();
+  return Number.isFinite(ts) && ts > 0 ? ts : undefined;
+}
+
+const stamps: string[] = [];
+for (let s = 0; s < 86_400; s++) stamps.push(fmt(YEAR, 6, 15, Math.floor(s / 3600), Math.floor(s / 60) % 60, s % 60));
+
+function bench(label: string, parse: (v: string) => number | undefined, rounds: number): number {
+  let sum = 0;
+  for (const s of stamps) sum += parse(s)!; // warm-up
+  const t0 = performance.now();
+  for (let r = 0; r < rounds; r++) for (let i = 0; i < stamps.length; i++) sum += parse(stamps[i])!;
+  const ms = performance.now() - t0;
+  const rate = (rounds * stamps.length) / ms / 1000;
+  console.log(`[bench] ${label.padEnd(22)} ${rate.toFixed(2)} M parses/s`);
+  return sum;
+}
+
+bench('split + new Date', baseline, 3);
+bench('parseRingDate', parseRingDate, 50);
+
+console.log(failures === 0 ? '[bench] results identical' : `[bench] FAILED (${failures})`);
+if (failures > 0) process.exit(1);
@@ -0,0 +1,103 @@
+/**
+ * Regression benchmark for src/utils/rollingStats over multi-year histories.
+ *
+ * Replays N years of synthetic nightly values through the old and new forms of
+ * what production does each night:
+ *   - sleep debt:  slice+reduce of the last 7 deficits vs one RollingWindow(7)
+ *                  carried from night to night (SleepDebtService.nightlyPoints)
+ *   - baselines:   pushRolling + copy+sort median per read vs pushRolling +
+ *                  baselineMedian, whose window moves with the array
+ *   - bootstrap:   the old pushRolling chain vs collect + one slice
+ *                  (ReadinessService.bootstrapBaselinesFromSupabase)
+ * checks the results agree, and prints timings. Exits non-zero on mismatch.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/bench-rolling-stats.ts [years=5]
+ */
+
+import { BASELINE_DAYS, RollingWindow, baselineMedian, median, pushRolling } from '../src/utils/rollingStats';
+
+const YEARS = Number(process.argv[2] ?? 5);
+const NIGHTS = Math.round(YEARS * 365);
+const TARGET = 480;
+// Baseline medians read per night (readiness components, day metrics, illness watch, home cards)
+const READS_PER_NIGHT = 6;
+
+let seed = 7;
+const rand = () => {
+  seed = (seed * 1_103_515_245 + 12_345) & 0x7fffffff;
+  return seed / 0x7fffffff;
+};
+
+const sleepMin = Array.from({ length: NIGHTS }, () => Math.round(330 + rand() * 210));
+const hrv = Array.from({ length: NIGHTS }, () => Math.round(30 + rand() * 50));
+
+function bench<T>(label: string, fn: () => T): T {
+  const t0 = performance.now();
+  let out!: T;
+  for (let i = 0; i < 20; i++) out = fn();
+  console.log(`[bench] ${label.padEnd(30)} ${((performance.now() - t0) / 20).toFixed(3)} ms`);
+  return out;
+}
+
+let ok = true;
+const check = (label: string, a: number[], b: number[]) => {
+  const same = a.length === b.length && a.every((v, i) => Math.abs(v - b[i]) < 1e-9);
+  if (!same) {
+    ok = false;
+    console.error(`[bench] MISMATCH in ${label}`);
+  }
+};
+
+console.log(`[bench] ${YEARS}y = ${NIGHTS} nights, baseline ${BASELINE_DAYS} days, ${READS_PER_NIGHT} median reads/night`);
+
+const deficits = sleepMin.map(m => Math.max(0, TARGET - m));
+const naiveDebt = bench('debt slice+reduce', () =>
+  deficits.map((_, i) => deficits.slice(Math.max(0, i - 6), i + 1).reduce((s, v) => s + v, 0)));
+const fastDebt = bench('debt RollingWindow(7)', () => {
+  const w = new RollingWindow(7);
+  return deficits.map(d => {
+    w.push(d);
+    return w.sum;
+  });
+});
+check('debt', naiveDebt, fastDebt);
+
+const naiveMed = bench('baseline copy+sort median', () => {
+  let arr: number[] = [];
+  const out: number[] = [];
+  for (const v of hrv) {
+    arr = pushRolling(arr, v);
+    for (let r = 0; r < READS_PER_NIGHT; r++) out.push(median(arr)!);
+  }
+  return out;
+});
+const fastMed = bench('baseline baselineMedian', () => {
+  let arr: number[] = [];
+  const out: number[] = [];
+  for (const v of hrv) {
+    arr = pushRolling(arr, v);
+    for (let r = 0; r < READS_PER_NIGHT; r++) out.push(baselineMedian(arr)!);
+  }
+  return out;
+});
+check('baseline median', naiveMed, fastMed);
+
+const naiveBoot = bench('bootstrap pushRolling chain', () => {
+  let arr: number[] = [];
+  for (const v of hrv) {
+    const next = [...arr, v];
+    arr = next.length <= BASELINE_DAYS ? next : next.slice(next.length - BASELINE_DAYS);
+  }
+  return arr;
+});
+const fastBoot = bench('bootstrap collect+slice', () => {
+  const series: number[] = [];
+  for (const v of hrv) series.push(v);
+  return series.slice(-BASELINE_DAYS);
+});
+check('bootstrap', naiveBoot, fastBoot);
+
+console.log(ok ? '[bench] results identical' : '[bench] FAILED');
+if (!ok) process.exit(1);
@@ -0,0 +1,178 @@
+/**
+ * Regression benchmark for src/services/SampleColumns on a week of X3 history.
+ *
+ * Builds SDK-shaped packets (50 entries each, "YYYY.MM.DD HH:mm:ss" dates) for PPI,
+ * HRV, SpO2 and temperature, then normalizes them with:
+ *   - the per-record path the services used before (split/map(Number)/new Date per
+ *     stamp, every fallback key tried per entry, one object per row)
+ *   - the column path (x3*Columns)
+ * checks both give the same rows, and prints timings. A sparse batch (the PPI value only
+ * appears after the first few hundred entries, under a fallback key) checks fields the key
+ * scan misses are still read per entry. Exits non-zero on mismatch.
+ *
+ * Payloads are generated in the SDK's shapes, not recorded from a ring.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/bench-sample-columns.ts [days=7] [ppiEverySec=3]
+ */
+
+import {
+  x3HrvColumns,
+  x3PpiColumns,
+  x3SpO2Columns,
+  x3TemperatureColumns,
+} from '../src/services/SampleColumns';
+
+const DAYS = Number(process.argv[2] ?? 7);
+const PPI_EVERY_SEC = Number(process.argv[3] ?? 3);
+const PACKET = 50;
+const FALLBACK_TS = Date.UTC(2026, 0, 1);
+
+let seed = 11;
+const rand = () => {
+  seed = (seed * 1_103_515_245 + 12_345) & 0x7fffffff;
+  return seed / 0x7fffffff;
+};
+
+const pad = (n: number) => String(n).padStart(2, '0');
+const ringDate = (ms: number) => {
+  const d = new Date(ms);
+  return `${d.getFullYear()}.${pad(d.getMonth() + 1)}.${pad(d.getDate())} ` +
+    `${pad(d.getHours())}:${pad(d.getMinutes())}:${pad(d.getSeconds())}`;
+};
+
+function packets(arrayKey: string, everySec: number, entry: (ms: number) => Record<string, unknown>): any[] {
+  const start = new Date(2026, 2, 25).getTime(); // spans the EU DST switch when TZ has one
+  const count = Math.floor((DAYS * 86_400) / everySec);
+  const out: any[] = [];
+  for (let i = 0; i < count; i += PACKET) {
+    const list: Record<string, unknown>[] = [];
+    for (let j = i; j < Math.min(count, i + PACKET); j++) list.push(entry(start + j * everySec * 1000));
+    out.push({ [arrayKey]: list });
+  }
+  return out;
+}
+
+const ppiPackets = packets('arrayPpiData', PPI_EVERY_SEC, ms => ({ date: ringDate(ms), ppi: Math.round(600 + rand() * 500) }));
+const hrvPackets = packets('arrayHrvData', 300, ms => ({
+  date: ringDate(ms), hrv: Math.round(20 + rand() * 60), heartRate: Math.round(50 + rand() * 40), stress: Math.round(rand() * 100),
+}));
+// Placeholder entries first, then the value under a fallback key only
+const sparsePpiPackets = packets('arrayPpiData', PPI_EVERY_SEC, ms => {
+  const i = (ms - new Date(2026, 2, 25).getTime()) / (PPI_EVERY_SEC * 1000);
+  return i < 300 ? { date: ringDate(ms) } : { date: ringDate(ms), rri: Math.round(600 + rand() * 500) };
+}).slice(0, 20);
+const spo2Packets = packets('arrayAutomaticSpo2Data', 300, ms => ({ date: ringDate(ms), automaticSpo2Data: rand() < 0.05 ? 0 : 94 + Math.round(rand() * 5) }));
+const tempPackets = packets('arrayemperatureData', 300, ms => ({ date: ringDate(ms), temperature: rand() < 0.02 ? 0 : 35.5 + rand() * 1.5 }));
+
+// ---- Baseline: the per-record implementations the services used before ----
+
+function parseX3DateTime(value?: string): number | undefined {
+  if (!value || typeof value !== 'string') return undefined;
+  const [datePart, timePart] = value.trim().split(/\s+/);
+  if (!datePart) return undefined;
+  const [y, m, d] = datePart.split('.').map(Number);
+  if ([y, m, d].some(n => Number.isNaN(n))) return undefined;
+  const [hh, mm, ss] = (timePart || '00:00:00').split(':').map(Number);
+  if ([hh, mm, ss].some(n => Number.isNaN(n))) return undefined;
+  const ts = new Date(y, m - 1, d, hh, mm, ss).getTime();
+  return Number.isFinite(ts) && ts > 0 ? ts : undefined;
+}
+
+function pickNumber(record: Record<string, any>, keys: string[]): number | undefined {
+  for (const key of keys) {
+    const value = Number(record?.[key]);
+    if (Number.isFinite(value)) return value;
+  }
+  return undefined;
+}
+
+function baselinePpi(records: any[]) {
+  const rows: Array<{ timestamp: number; ppi: number }> = [];
+  for (const record of records) {
+    const entries = Array.isArray(record?.arrayPpiData) ? record.arrayPpiData : [record];
+    for (const entry of entries) {
+      const ppi = pickNumber(entry || {}, ['ppi', 'rrInterval', 'rri']);
+      if (!ppi || ppi <= 0) continue;
+      rows.push({ timestamp: parseX3DateTime(entry?.date || entry?.startDate || entry?.startTime) ?? FALLBACK_TS, ppi });
+    }
+  }
+  return rows;
+}
+
+function baselineHrv(records: any[]) {
+  const rows: Array<{ sdnn: number; heartRate: number; stress: number; timestamp: number }> = [];
+  for (const record of records) {
+    for (const rec of record.arrayHrvData) {
+      const ts = rec.date ? parseX3DateTime(rec.date) : undefined;
+      rows.push({
+        sdnn: Number(rec.hrv ?? rec.hrvValue ?? 0),
+        heartRate: Number(rec.heartRate ?? 0),
+        stress: Number(rec.stress ?? 0),
+        timestamp: ts && !Number.isNaN(ts) ? ts : FALLBACK_TS,
+      });
+    }
+  }
+  return rows;
+}
+
+function baselineSpO2(records: any[]) {
+  const rows: Array<{ spo2: number; timestamp: number }> = [];
+  for (const record of records) {
+    for (const entry of record.arrayAutomaticSpo2Data || []) {
+      const spo2 = Number(entry.automaticSpo2Data ?? entry.spo2 ?? 0);
+      if (spo2 > 0) rows.push({ spo2, timestamp: parseX3DateTime(entry.date) ?? FALLBACK_TS });
+    }
+  }
+  return rows;
+}
+
+function baselineTemperature(records: any[]) {
+  const rows: Array<{ temperature: number; timestamp: number }> = [];
+  for (const record of records) {
+    for (const entry of record.arrayemperatureData || record.arrayTemperatureData || []) {
+      const temperature = Number(entry.temperature ?? 0);
+      if (temperature >= 34 && temperature <= 42) rows.push({ temperature, timestamp: parseX3DateTime(entry.date) ?? FALLBACK_TS });
+    }
+  }
+  return rows;
+}
+
+// ---- Harness ----
+
+function bench<T>(label: string, fn: () => T): T {
+  fn(); // warm-up
+  const t0 = performance.now();
+  let out!: T;
+  for (let i = 0; i < 10; i++) out = fn();
+  console.log(`[bench] ${label.padEnd(28)} ${((performance.now() - t0) / 10).toFixed(3)} ms`);
+  return out;
+}
+
+let ok = true;
+function check<R extends Record<string, number>>(label: string, rows: R[], cols: { length: number } & Record<keyof R, Float64Array>) {
+  const fields = rows.length > 0 ? (Object.keys(rows[0]) as (keyof R)[]) : [];
+  const same = rows.length === cols.length && rows.every((row, i) => fields.every(f => row[f] === cols[f][i]));
+  if (!same) {
+    ok = false;
+    console.error(`[bench] MISMATCH in ${label} (${rows.length} rows vs ${cols.length})`);
+  }
+}
+
+const entryCount = (list: any[], key: string) => list.reduce((n, p) => n + p[key].length, 0);
+console.log(`[bench] ${DAYS} days: ${entryCount(ppiPackets, 'arrayPpiData')} PPI, ` +
+  `${entryCount(hrvPackets, 'arrayHrvData')} HRV/SpO2/temperature entries each, ${PACKET} per packet`);
+
+check('ppi', bench('ppi per-record', () => baselinePpi(ppiPackets)),
+  bench('ppi columns', () => x3PpiColumns(ppiPackets, FALLBACK_TS)));
+check('ppi sparse', baselinePpi(sparsePpiPackets), x3PpiColumns(sparsePpiPackets, FALLBACK_TS));
+check('hrv', bench('hrv per-record', () => baselineHrv(hrvPackets)),
+  bench('hrv columns', () => x3HrvColumns(hrvPackets, FALLBACK_TS)));
+check('spo2', bench('spo2 per-record', () => baselineSpO2(spo2Packets)),
+  bench('spo2 columns', () => x3SpO2Columns(spo2Packets, FALLBACK_TS)));
+check('temperature', bench('temperature per-record', () => baselineTemperature(tempPackets)),
+  bench('temperature columns', () => x3TemperatureColumns(tempPackets, FALLBACK_TS)));
+
+console.log(ok ? '[bench] results identical' : '[bench] FAILED');
+if (!ok) process.exit(1);
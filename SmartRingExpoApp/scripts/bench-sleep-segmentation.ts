@@ -0,0 +1,193 @@
+/**
+ * Correctness + timing check for src/services/SleepSegmentation.
+ *
+ * Builds SDK-shaped sleep records (2 h arraySleepQuality chunks, "YYYY.MM.DD HH:mm:ss"
+ * starts) for a run of nights with wake gaps and afternoon naps, then checks:
+ *   - SleepSegmenter blocks and stage minutes equal the per-consumer merge the services
+ *     used before (normalize, sort, ≤60 min sweep, 1-min timeline)
+ *   - adding a day at a time (one sync) gives the same sessions as one batch, keeps the
+ *     objects for sessions the new day can't touch, and handles shuffled batches and a
+ *     record replaced by a longer one with the same start
+ *   - HealthKit fusion sets suggestedBedTime only for ≥45 min earlier in-bed starts
+ * and prints timings for a full re-merge vs an incremental daily add. Exits non-zero on
+ * mismatch.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/bench-sleep-segmentation.ts [days=12]
+ */
+
+import { SleepSegmenter, segmentRingSleep, type SleepSession } from '../src/services/SleepSegmentation';
+import { parseRingDate } from '../src/utils/ringDate';
+
+const DAYS = Math.min(13, Number(process.argv[2] ?? 12)); // SleepSegmenter keeps 14 days
+const MINUTE = 60_000;
+
+let seed = 7;
+const rand = () => {
+  seed = (seed * 1_103_515_245 + 12_345) & 0x7fffffff;
+  return seed / 0x7fffffff;
+};
+
+const pad = (n: number) => String(n).padStart(2, '0');
+const ringDate = (ms: number) => {
+  const d = new Date(ms);
+  return `${d.getFullYear()}.${pad(d.getMonth() + 1)}.${pad(d.getDate())} ` +
+    `${pad(d.getHours())}:${pad(d.getMinutes())}:${pad(d.getSeconds())}`;
+};
+
+function record(start: number, minutes: number): any {
+  const arr: number[] = [];
+  for (let i = 0; i < minutes; i++) arr.push(rand() < 0.08 ? 0 : 1 + Math.floor(rand() * 3));
+  return {
+    startTime_SleepData: ringDate(start),
+    sleepUnitLength: 1,
+    arraySleepQuality: arr,
+    totalSleepTime: arr.filter(v => v > 0 && v < 4).length,
+  };
+}
+
+/** One day's records: a night (with an occasional >60 min wake gap) and sometimes a nap. */
+function dayRecords(day: number): any[] {
+  const base = new Date(2026, 2, 20 + day).getTime(); // crosses the EU DST switch
+  const out: any[] = [];
+  let t = base - 2 * 60 * MINUTE + Math.floor(rand() * 120) * MINUTE; // 22:00–00:00
+  const nightEnd = base + (6 * 60 + Math.floor(rand() * 150)) * MINUTE;
+  while (t < nightEnd) {
+    const len = Math.min(120, Math.round((nightEnd - t) / MINUTE));
+    out.push(record(t, len));
+    t += (len + Math.floor(rand() * 20)) * MINUTE;
+    if (rand() < 0.05) t += 90 * MINUTE;
+  }
+  if (rand() < 0.4) out.push(record(base + (13 * 60 + Math.floor(rand() * 180)) * MINUTE, 20 + Math.floor(rand() * 60)));
+  return out;
+}
+
+const days = Array.from({ length: DAYS }, (_, d) => dayRecords(d));
+const all = days.flat();
+
+let failures = 0;
+const fail = (msg: string) => {
+  if (failures++ < 10) console.error(`[bench] MISMATCH ${msg}`);
+};
+
+// ---- Baseline: the merge useHomeData.deriveFromRaw did before ----
+
+function baseline(rawRecords: any[]) {
+  const normalized = rawRecords.map(r => {
+    const start = r.startTimestamp || parseRingDate(r.startTime_SleepData);
+    const unit = Number(r.sleepUnitLength) || 1;
+    const arr: number[] = r.arraySleepQuality || [];
+    return { start, unit, arr, durationMin: arr.length * unit };
+  }).filter(r => typeof r.start === 'number' && r.start > 0);
+  const sorted = [...normalized].sort((a, b) => a.start! - b.start!);
+  const blocks: { start: number; end: number; records: typeof normalized }[] = [];
+  let block: typeof blocks[0] | null = null;
+  for (const rec of sorted) {
+    const recEnd = rec.start! + rec.durationMin * MINUTE;
+    if (block && rec.start! - block.end <= 60 * MINUTE) {
+      block.end = Math.max(block.end, recEnd);
+      block.records.push(rec);
+    } else {
+      block = { start: rec.start!, end: recEnd, records: [rec] };
+      blocks.push(block);
+    }
+  }
+  return blocks.map(b => {
+    const timeline = new Array(Math.max(0, Math.round((b.end - b.start) / MINUTE))).fill(0);
+    for (const rec of b.records) {
+      const offset = Math.round((rec.start! - b.start) / MINUTE);
+      rec.arr.forEach((val, idx) => {
+        const tv = val === 1 ? 3 : val === 3 ? 2 : val === 2 ? 1 : 0;
+        for (let k = 0; k < rec.unit; k++) {
+          const pos = offset + idx * rec.unit + k;
+          if (pos >= 0 && pos < timeline.length) timeline[pos] = tv;
+        }
+      });
+    }
+    const count = (v: number) => timeline.filter(x => x === v).length;
+    return { start: b.start, end: b.end, deep: count(3), light: count(1), rem: count(2), awake: count(0) };
+  });
+}
+
+const summary = (s: SleepSession) =>
+  ({ start: s.start, end: s.end, deep: s.stages.deep, light: s.stages.light, rem: s.stages.rem, awake: s.stages.awake });
+const same = (a: object[], b: object[]) => JSON.stringify(a) === JSON.stringify(b);
+
+// ---- Correctness ----
+
+const expected = baseline(all);
+const batch = segmentRingSleep(all);
+if (!same(expected, batch.map(summary))) fail(`batch: ${expected.length} baseline blocks vs ${batch.length}`);
+
+const shuffled = [...all].sort(() => rand() - 0.5);
+if (!same(expected, segmentRingSleep(shuffled).map(summary))) fail('shuffled batch');
+
+const incremental = new SleepSegmenter();
+let previous: readonly SleepSession[] = [];
+for (const day of days) {
+  incremental.addRingRecords(day);
+  const now = incremental.sessions();
+  // Sessions ending more than the merge gap before this day's first record are untouched
+  const firstNew = Math.min(...day.map(r => parseRingDate(r.startTime_SleepData)!));
+  for (const s of previous) {
+    if (s.end + 60 * MINUTE < firstNew && !now.includes(s)) fail(`session ${new Date(s.start).toISOString()} rebuilt`);
+  }
+  previous = now;
+}
+if (!same(expected, incremental.sessions().map(summary))) fail('incremental');
+if (incremental.addRingRecords(days[DAYS - 1])) fail('re-adding a synced day reported a change');
+
+// A night first synced mid-sleep, then in full
+const partial = new SleepSegmenter();
+const lastNight = days[DAYS - 1][0];
+partial.addRingRecords([{ ...lastNight, arraySleepQuality: lastNight.arraySleepQuality.slice(0, 30) }]);
+partial.addRingRecords(days[DAYS - 1]);
+if (!same(baseline(days[DAYS - 1]), partial.sessions().map(summary))) fail('longer record did not replace partial one');
+
+// HealthKit: in bed 50 min before the ring's first record → suggested; 20 min → not
+const fused = new SleepSegmenter();
+fused.addRingRecords(all);
+const nights = fused.sessions().filter(s => s.end - s.start >= 180 * MINUTE);
+const [early, late] = nights.slice(-2);
+fused.setHealthKit([
+  { start: early.start - 50 * MINUTE, end: early.start + 30 * MINUTE },
+  { start: early.start + 40 * MINUTE, end: early.end },
+  { start: late.start - 20 * MINUTE, end: late.end },
+]);
+const fusedEarly = fused.sessionAt(early.start)!;
+const fusedLate = fused.sessionAt(late.start)!;
+if (fusedEarly.suggestedBedTime !== early.start - 50 * MINUTE) fail('suggestedBedTime not set');
+if (fusedLate.suggestedBedTime !== undefined || !fusedLate.sources.includes('healthkit')) fail('late HealthKit fusion');
+fused.setOverride({ bedTime: late.start - 30 * MINUTE, wakeTime: late.end });
+if (!fused.sessionAt(late.start)!.sources.includes('manual') || fused.sessionAt(early.start) !== fusedEarly) fail('override fusion');
+
+console.log(`[bench] ${DAYS} days: ${all.length} records → ${expected.length} blocks, ` +
+  `${incremental.sessions().filter(s => s.sessionType === 'night').length} nights`);
+
+// ---- Timing ----
+
+function bench(label: string, fn: () => void, rounds = 20) {
+  fn(); // warm-up
+  const t0 = performance.now();
+  for (let i = 0; i < rounds; i++) fn();
+  console.log(`[bench] ${label.padEnd(34)} ${((performance.now() - t0) / rounds).toFixed(3)} ms`);
+}
+
+const history = days.slice(0, -1).flat();
+let addDayMs = 0;
+bench('baseline re-merge (per consumer)', () => { baseline(all); });
+bench('segmenter full build', () => { segmentRingSleep(all).length; });
+bench('segmenter history + add one day', () => {
+  const s = new SleepSegmenter();
+  s.addRingRecords(history);
+  s.sessions();
+  const t0 = performance.now();
+  s.addRingRecords(days[DAYS - 1]);
+  s.sessions();
+  addDayMs += performance.now() - t0;
+});
+console.log(`[bench]   of which the daily add itself     ${(addDayMs / 21).toFixed(3)} ms`);
+
+console.log(failures === 0 ? '[bench] results identical' : `[bench] FAILED (${failures})`);
+if (failures > 0) process.exit(1);
@@ -0,0 +1,179 @@
+/**
+ * Headless check of src/services/HealthKit/AnchoredSampleStore against a mock
+ * HealthKit.
+ *
+ * Simulates N days of a watch writing step and sleep samples (with occasional
+ * deletions, late backfills and an app relaunch mid-run). Every simulated
+ * hydration reads today's steps and last night's sleep through the store. Each
+ * read is compared with a plain full-window query, and the samples each
+ * approach transferred are totalled. Exits non-zero on any mismatch.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   npx tsx scripts/sim-healthkit-anchors.ts [days=14] [hydrationsPerDay=12]
+ */
+
+import { AnchoredSampleStore } from '../src/services/HealthKit/AnchoredSampleStore';
+import type {
+  AnchoredItem,
+  AnchoredQueryAdapter,
+  AnchoredStorage,
+} from '../src/services/HealthKit/AnchoredSampleStore';
+
+const DAYS = Number(process.argv[2] ?? 14);
+const PER_DAY = Number(process.argv[3] ?? 12);
+const HOUR = 3_600_000;
+const DAY = 24 * HOUR;
+
+let seed = 5;
+const rand = () => {
+  seed = (seed * 1_103_515_245 + 12_345) & 0x7fffffff;
+  return seed / 0x7fffffff;
+};
+
+// ── Mock HealthKit ───────────────────────────────────────────────────────────
+
+interface MockSample { uuid: string; type: string; start: number; end: number; quantity?: number; value?: number; seq: number }
+
+class MockHealthKit {
+  seq = 0;
+  samples = new Map<string, MockSample>();
+  deleted: Array<{ uuid: string; seq: number }> = [];
+  roundTrips = 0;
+  transferred = 0;
+
+  add(type: string, start: number, end: number, extra: { quantity?: number; value?: number }) {
+    const uuid = `s${++this.seq}`;
+    this.samples.set(uuid, { uuid, type, start, end, ...extra, seq: this.seq });
+  }
+
+  removeRandom(type: string) {
+    const ofType = [...this.samples.values()].filter(s => s.type === type);
+    if (!ofType.length) return;
+    const victim = ofType[Math.floor(rand() * ofType.length)];
+    this.samples.delete(victim.uuid);
+    this.deleted.push({ uuid: victim.uuid, seq: ++this.seq });
+  }
+
+  /** Plain date-window query — what the fetchers did before. */
+  window(type: string, from: number, to: number): MockSample[] {
+    this.roundTrips++;
+    const out = [...this.samples.values()].filter(s => s.type === type && s.end > from && s.start < to);
+    this.transferred += out.length;
+    return out;
+  }
+
+  adapter: AnchoredQueryAdapter = {
+    query: async (spec, anchor, from) => {
+      this.roundTrips++;
+      const since = anchor ? Number(anchor) : 0;
+      const samples = [...this.samples.values()]
+        .filter(s => s.type === spec.identifier && s.seq > since && s.end > from.getTime())
+        .map(s => ({ uuid: s.uuid, startDate: new Date(s.start), endDate: new Date(s.end), quantity: s.quantity, value: s.value }));
+      const deletedUuids = since ? this.deleted.filter(d => d.seq > since).map(d => d.uuid) : [];
+      this.transferred += samples.length + deletedUuids.length;
+      return { samples, deletedUuids, newAnchor: String(this.seq) };
+    },
+  };
+}
+
+class MemoryStorage implements AnchoredStorage {
+  data = new Map<string, string>();
+  writes = 0;
+  async multiGet(keys: readonly string[]) { return keys.map(k => [k, this.data.get(k) ?? null] as const); }
+  async multiSet(pairs: [string, string][]) { this.writes++; for (const [k, v] of pairs) this.data.set(k, v); }
+  async getAllKeys() { return [...this.data.keys()]; }
+  async multiRemove(keys: readonly string[]) { for (const k of keys) this.data.delete(k); }
+}
+
+// ── Simulation ───────────────────────────────────────────────────────────────
+
+interface Item extends AnchoredItem { quantity?: number; value?: number }
+const toItem = (s: any): Item => ({
+  uuid: s.uuid,
+  startMs: new Date(s.startDate).getTime(),
+  endMs: new Date(s.endDate).getTime(),
+  quantity: s.quantity,
+  value: s.value,
+});
+
+const hk = new MockHealthKit();
+const storage = new MemoryStorage();
+let clock = Date.UTC(2026, 0, 1);
+
+function makeStore(): AnchoredSampleStore {
+  const store = new AnchoredSampleStore(hk.adapter, storage, { minRefreshMs: 0, now: () => clock });
+  store.register({ id: 'steps', kind: 'quantity', identifier: 'steps', retentionMs: 2 * DAY, map: toItem });
+  store.register({ id: 'sleep', kind: 'category', identifier: 'sleep', retentionMs: 8 * DAY, map: toItem });
+  return store;
+}
+
+let store = makeStore();
+let ok = true;
+let anchoredTransferred = 0;
+let anchoredTrips = 0;
+let fullTransferred = 0;
+let fullTrips = 0;
+
+const key = (xs: Array<{ uuid: string }>) => xs.map(x => x.uuid).sort().join(',');
+
+async function hydrate(dayStart: number) {
+  const sleepFrom = dayStart - 6 * HOUR;
+  const sleepTo = dayStart + 12 * HOUR;
+
+  const t0 = hk.transferred, r0 = hk.roundTrips;
+  // Issued together so they share one batch
+  const [steps, sleep] = await Promise.all([
+    store.read<Item>('steps', new Date(dayStart), new Date(clock)),
+    store.read<Item>('sleep', new Date(sleepFrom), new Date(sleepTo)),
+  ]);
+  anchoredTransferred += hk.transferred - t0;
+  anchoredTrips += hk.roundTrips - r0;
+
+  const t1 = hk.transferred, r1 = hk.roundTrips;
+  const fullSteps = hk.window('steps', dayStart, clock);
+  const fullSleep = hk.window('sleep', sleepFrom, sleepTo);
+  fullTransferred += hk.transferred - t1;
+  fullTrips += hk.roundTrips - r1;
+
+  if (key(steps!) !== key(fullSteps) || key(sleep!) !== key(fullSleep)) {
+    ok = false;
+    console.error(`[sim] MISMATCH at ${new Date(clock).toISOString()}`);
+  }
+}
+
+(async () => {
+  const writesBefore = storage.writes;
+  for (let d = 0; d < DAYS; d++) {
+    const dayStart = clock;
+    // Last night's sleep: a handful of stage samples from 23:00 the previous day
+    let t = dayStart - HOUR;
+    while (t < dayStart + 7 * HOUR) {
+      const len = (10 + rand() * 50) * 60_000;
+      hk.add('sleep', t, t + len, { value: 2 + Math.floor(rand() * 4) });
+      t += len;
+    }
+    for (let h = 0; h < PER_DAY; h++) {
+      // Steps written since the last hydration
+      const until = dayStart + ((h + 1) / PER_DAY) * DAY;
+      while (clock < until) {
+        hk.add('steps', clock, clock + 10 * 60_000, { quantity: Math.round(rand() * 900) });
+        clock += 10 * 60_000;
+      }
+      if (rand() < 0.2) hk.removeRandom('steps');
+      // Late backfill of an earlier sample (e.g. a watch that was out of range)
+      if (rand() < 0.1) hk.add('steps', dayStart + rand() * (clock - dayStart), clock - 60_000, { quantity: 50 });
+      await hydrate(dayStart);
+    }
+    // App relaunch: fresh store instance, anchors come back from storage
+    if (d === Math.floor(DAYS / 2)) store = makeStore();
+  }
+
+  const batches = storage.writes - writesBefore;
+  console.log(`[sim] ${DAYS} days × ${PER_DAY} hydrations, ${hk.samples.size} samples in mock HealthKit`);
+  console.log(`[sim] full-window: ${fullTrips} queries, ${fullTransferred} samples transferred`);
+  console.log(`[sim] anchored  : ${anchoredTrips} queries in ${batches} batches, ${anchoredTransferred} samples transferred`);
+  console.log(`[sim] last batch: ${JSON.stringify(store.getLastMetrics())}`);
+  console.log(ok ? '[sim] cache matches full queries' : '[sim] FAILED');
+  if (!ok) process.exit(1);
+})();
@@ -0,0 +1,234 @@
+/**
+ * Scripted simulation of ios/JstyleBridge/BleReconnectPolicy.c, the reconnect state
+ * machine behind BleConnectionManager.
+ *
+ * A mock transport plays the radio: it carries out each action the policy returns
+ * (connect now, arm / cancel the timer) on a virtual clock, and answers connects from a
+ * script (ring in range or not). Scenarios:
+ *   - ring gone for good: 12 failed connects, then the policy gives up
+ *   - backoff: every scheduled delay within equal-jitter bounds of its ceiling, the
+ *     ceiling doubling from 2 s and capped at 5 minutes, jitter covering both halves
+ *   - link lost in the background: immediate (pending) connect, no backoff
+ *   - radio off / on mid-backoff: paused, then a fresh budget on power-on
+ *   - intentional disconnect: timer cancelled, late events ignored
+ * Exits non-zero on the first mismatch.
+ *
+ * Usage:
+ *   cd SmartRingExpoApp
+ *   cc -O2 -std=c11 -Iios/JstyleBridge scripts/sim-reconnect-policy.c ios/JstyleBridge/BleReconnectPolicy.c -lm -o /tmp/sim-reconnect-policy
+ *   /tmp/sim-reconnect-policy [seeds=1000]
+ */
+
+#include "BleReconnectPolicy.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MAX_FAILURES 12
+#define BASE_MS 2000.0
+#define CAP_MS (5 * 60 * 1000.0)
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                                                      \
+    do {                                                                      \
+        if (!(cond)) {                                                        \
+            fprintf(stderr, "[sim] FAIL %s:%d: ", __FILE__, __LINE__);        \
+            fprintf(stderr, __VA_ARGS__);                                     \
+            fprintf(stderr, "\n");                                            \
+            failures++;                                                       \
+            return;                                                           \
+        }                                                                     \
+    } while (0)
+
+/** Mock radio: performs the policy's actions on a virtual clock. */
+typedef struct {
+    BleReconnectPolicy policy;
+    double nowMs;
+    bool timerArmed;
+    double timerAtMs;
+    bool connectPending;
+    int connects;
+    int schedules;
+    double delays[64];
+} MockTransport;
+
+static void mockInit(MockTransport *t, uint32_t seed) {
+    BleReconnectConfig config = BleReconnectConfigDefault();
+    BleReconnectPolicyInit(&t->policy, &config, seed, true);
+    t->nowMs = 0;
+    t->timerArmed = false;
+    t->timerAtMs = 0;
+    t->connectPending = false;
+    t->connects = 0;
+    t->schedules = 0;
+}
+
+static void mockSend(MockTransport *t, BleReconnectEvent event) {
+    BleReconnectAction action = BleReconnectPolicyHandle(&t->policy, event);
+    switch (action.type) {
+        case BleReconnectActionNone:
+            break;
+        case BleReconnectActionConnect:
+            t->connectPending = true;
+            t->connects++;
+            break;
+        case BleReconnectActionSchedule:
+            t->timerArmed = true;
+            t->timerAtMs = t->nowMs + action.delayMs;
+            if (t->schedules < 64) t->delays[t->schedules] = action.delayMs;
+            t->schedules++;
+            break;
+        case BleReconnectActionCancel:
+            t->timerArmed = false;
+            break;
+    }
+}
+
+/** Answer the pending connect (ring in range or not), then fire the timer if armed. */
+static void mockStep(MockTransport *t, bool ringInRange) {
+    if (t->connectPending) {
+        t->connectPending = false;
+        mockSend(t, ringInRange ? BleReconnectEventConnected : BleReconnectEventConnectFailed);
+        return;
+    }
+    if (t->timerArmed) {
+        t->timerArmed = false;
+        t->nowMs = t->timerAtMs;
+        mockSend(t, BleReconnectEventTimerFired);
+    }
+}
+
+static double ceilingFor(uint32_t failure) {
+    return fmin(CAP_MS, BASE_MS * pow(2, failure - 1));
+}
+
+static void scenarioGivesUp(uint32_t seed) {
+    MockTransport t;
+    mockInit(&t, seed);
+    mockSend(&t, BleReconnectEventStart);
+    for (int i = 0; i < 200 && (t.connectPending || t.timerArmed); i++) mockStep(&t, false);
+
+    CHECK(t.policy.state == BleReconnectStateIdle, "seed %u: state %s after exhausting the budget",
+          seed, BleReconnectStateName(t.policy.state));
+    CHECK(t.connects == MAX_FAILURES, "seed %u: %d connects, want %d", seed, t.connects, MAX_FAILURES);
+    CHECK(t.schedules == MAX_FAILURES - 1, "seed %u: %d backoffs, want %d", seed, t.schedules, MAX_FAILURES - 1);
+    CHECK(!t.timerArmed, "seed %u: timer still armed after giving up", seed);
+
+    for (int i = 0; i < t.schedules; i++) {
+        double ceiling = ceilingFor((uint32_t)i + 1);
+        CHECK(t.delays[i] >= ceiling / 2 && t.delays[i] < ceiling,
+              "seed %u: backoff %d = %.0f ms outside [%.0f, %.0f)", seed, i + 1, t.delays[i], ceiling / 2, ceiling);
+    }
+
+    // A late timer or failure after giving up does nothing
+    mockSend(&t, BleReconnectEventTimerFired);
+    mockSend(&t, BleReconnectEventConnectFailed);
+    CHECK(t.connects == MAX_FAILURES && t.policy.state == BleReconnectStateIdle, "seed %u: revived after giving up", seed);
+}
+
+static void scenarioBackoffBounds(int seeds) {
+    double minFrac = 1, maxFrac = 0;
+    for (int s = 1; s <= seeds; s++) {
+        BleReconnectPolicy policy;
+        BleReconnectConfig config = BleReconnectConfigDefault();
+        BleReconnectPolicyInit(&policy, &config, (uint32_t)s, true);
+        for (uint32_t n = 1; n <= 40; n++) {
+            double ceiling = ceilingFor(n);
+            double delay = BleReconnectPolicyBackoffMs(&policy, n);
+            CHECK(delay >= ceiling / 2 && delay < ceiling, "seed %d: retry %u = %.0f ms outside [%.0f, %.0f)",
+                  s, n, delay, ceiling / 2, ceiling);
+            CHECK(delay <= CAP_MS, "seed %d: retry %u = %.0f ms above the 5 min cap", s, n, delay);
+            double frac = delay / ceiling;
+            if (frac < minFrac) minFrac = frac;
+            if (frac > maxFrac) maxFrac = frac;
+        }
+    }
+    CHECK(ceilingFor(9) == CAP_MS && ceilingFor(8) < CAP_MS, "cap should first apply at retry 9");
+    // Equal jitter: half fixed, half random, so the draws should span [0.5, 1) of the ceiling
+    CHECK(minFrac < 0.52 && maxFrac > 0.98, "jitter spans only [%.3f, %.3f] of the ceiling", minFrac, maxFrac);
+    printf("[sim] backoff: %d seeds x 40 retries within [ceiling/2, ceiling), jitter %.3f-%.3f, cap %.0f ms\n",
+           seeds, minFrac, maxFrac, CAP_MS);
+}
+
+static void scenarioBackgroundLinkLoss(uint32_t seed) {
+    MockTransport t;
+    mockInit(&t, seed);
+    mockSend(&t, BleReconnectEventStart);
+    mockStep(&t, false);                        // one failure, then the ring is back
+    mockStep(&t, true);
+    mockStep(&t, true);
+    CHECK(t.policy.state == BleReconnectStateConnected, "seed %u: not connected (%s)", seed,
+          BleReconnectStateName(t.policy.state));
+    CHECK(t.policy.failures == 0, "seed %u: failures not reset on connect", seed);
+
+    // App backgrounded, ring walks out of range: reconnect is an immediate pending connect
+    int schedulesBefore = t.schedules;
+    mockSend(&t, BleReconnectEventLinkLost);
+    CHECK(t.connectPending && t.schedules == schedulesBefore, "seed %u: link loss did not connect immediately", seed);
+    CHECK(t.policy.state == BleReconnectStateConnecting, "seed %u: state %s after link loss", seed,
+          BleReconnectStateName(t.policy.state));
+    mockStep(&t, true);
+    CHECK(t.policy.state == BleReconnectStateConnected, "seed %u: pending connect did not complete", seed);
+}
+
+static void scenarioRadioToggle(uint32_t seed) {
+    MockTransport t;
+    mockInit(&t, seed);
+    mockSend(&t, BleReconnectEventStart);
+    for (int i = 0; i < 9; i++) mockStep(&t, false);    // 5 failures, timer armed
+    CHECK(t.policy.state == BleReconnectStateWaiting && t.policy.failures == 5,
+          "seed %u: state %s with %u failures", seed, BleReconnectStateName(t.policy.state), t.policy.failures);
+
+    mockSend(&t, BleReconnectEventRadioOff);
+    CHECK(t.policy.state == BleReconnectStatePaused && !t.timerArmed, "seed %u: radio off did not pause", seed);
+    mockSend(&t, BleReconnectEventTimerFired);
+    CHECK(!t.connectPending, "seed %u: connected while the radio is off", seed);
+
+    mockSend(&t, BleReconnectEventRadioOn);
+    CHECK(t.connectPending && t.policy.failures == 0, "seed %u: radio on did not reconnect with a fresh budget", seed);
+
+    // The fresh budget allows the full 12 failures again
+    int connectsBefore = t.connects;
+    for (int i = 0; i < 200 && (t.connectPending || t.timerArmed); i++) mockStep(&t, false);
+    CHECK(t.connects - connectsBefore == MAX_FAILURES - 1 && t.policy.state == BleReconnectStateIdle,
+          "seed %u: %d connects after radio on, want %d", seed, t.connects - connectsBefore, MAX_FAILURES - 1);
+}
+
+static void scenarioStop(uint32_t seed) {
+    MockTransport t;
+    mockInit(&t, seed);
+    mockSend(&t, BleReconnectEventStart);
+    mockStep(&t, false);
+    CHECK(t.timerArmed, "seed %u: no backoff after a failed connect", seed);
+    mockSend(&t, BleReconnectEventStop);
+    CHECK(!t.timerArmed && t.policy.state == BleReconnectStateIdle, "seed %u: stop left the timer armed", seed);
+    mockSend(&t, BleReconnectEventLinkLost);
+    mockSend(&t, BleReconnectEventTimerFired);
+    CHECK(t.connects == 1, "seed %u: reconnected after an intentional disconnect", seed);
+}
+
+int main(int argc, char **argv) {
+    int seeds = argc > 1 ? atoi(argv[1]) : 1000;
+    if (seeds < 1) seeds = 1;
+
+    for (int s = 1; s <= seeds && failures == 0; s++) {
+        scenarioGivesUp((uint32_t)s);
+        scenarioBackgroundLinkLoss((uint32_t)s);
+        scenarioRadioToggle((uint32_t)s);
+        scenarioStop((uint32_t)s);
+    }
+    if (failures == 0) {
+        printf("[sim] %d seeds: gives up after %d failures, link loss reconnects immediately, "
+               "radio toggle restarts the budget, stop is final\n", seeds, MAX_FAILURES);
+    }
+    scenarioBackoffBounds(seeds);
+
+    if (failures > 0) {
+        fprintf(stderr, "[sim] %d mismatch(es)\n", failures);
+        return 1;
+    }
+    printf("[sim] ok\n");
+    return 0;
+}
@@ -1,7 +1,7 @@
 import React, { useState, useMemo, useRef } from 'react';
 import { View, Text, StyleSheet, Dimensions, PanResponder } from 'react-native';
 import Svg, { Defs, LinearGradient, Stop, Path, Line, Circle, Text as SvgText } from 'react-native-svg';
-import { monotoneCubicPath, parseLocalDate } from '../../utils/chartMath';
+import { monotoneCubicPath, memoPath, seriesKey, parseLocalDate } from '../../utils/chartMath';
 import { formatSleepTime } from '../../utils/time';
 import { fontFamily, spacing } from '../../theme/colors';
 import { useTranslation } from 'react-i18next';
@@ -49,7 +49,9 @@ export function SleepDebtLine({ points }: Props) {
   const { linePath, linePts } = useMemo(() => {
     if (points.length < 2) return { linePath: '', linePts: [] };
     const pts = points.map((p, i) => ({ x: toX(i), y: toY(p.runningDebtMin) }));
-    return { linePath: monotoneCubicPath(pts), linePts: pts };
+    // The curve only depends on the series + geometry, so it survives remounts
+    const key = `debt|${seriesKey(points.map(p => p.runningDebtMin))}|${chartW}|${maxDebt}`;
+    return { linePath: memoPath(key, () => monotoneCubicPath(pts)), linePts: pts };
   // eslint-disable-next-line react-hooks/exhaustive-deps
   }, [points, chartW, maxDebt]);
 
@@ -1,7 +1,7 @@
 import React, { useMemo } from 'react';
 import { View, Text, StyleSheet, Dimensions } from 'react-native';
 import Svg, { Defs, LinearGradient, Stop, Path, Line, Circle, Text as SvgText } from 'react-native-svg';
-import { monotoneCubicPath, parseLocalDate } from '../../utils/chartMath';
+import { monotoneCubicPath, memoPath, seriesKey, parseLocalDate } from '../../utils/chartMath';
 import { fontFamily, spacing } from '../../theme/colors';
 import type { NightlyPoint } from '../../types/sleepDebt.types';
 
@@ -42,13 +42,18 @@ export function SleepVsTargetOverlay({ nights, height = CHART_H }: Props) {
     if (nights.length < 2) return { actualPath: '', recPath: '', actualPts: [] };
     const aPts = nights.map((n, i) => ({ x: toX(i), y: toY(n.actualMin) }));
     const rPts = nights.map((n, i) => ({ x: toX(i), y: toY(n.recommendedMin ?? n.targetMin) }));
+    // Curves only depend on the series + geometry, so they survive remounts
+    const geomKey = `${chartW}|${height}|${domainMax}`;
     return {
-      actualPath: monotoneCubicPath(aPts),
-      recPath: monotoneCubicPath(rPts),
+      actualPath: memoPath(`sleepActual|${seriesKey(nights.map(n => n.actualMin))}|${geomKey}`, () => monotoneCubicPath(aPts)),
+      recPath: memoPath(
+        `sleepRec|${seriesKey(nights.map(n => n.recommendedMin ?? n.targetMin))}|${geomKey}`,
+        () => monotoneCubicPath(rPts),
+      ),
       actualPts: aPts,
     };
   // eslint-disable-next-line react-hooks/exhaustive-deps
-  }, [nights, chartW, domainMax]);
+  }, [nights, chartW, height, domainMax]);
 
   const areaPath = actualPts.length >= 2
     ? `${actualPath} L ${actualPts[actualPts.length - 1].x} ${graphBottom} L ${actualPts[0].x} ${graphBottom} Z`
@@ -3,7 +3,7 @@ import { View, Text, ScrollView, TouchableOpacity, StyleSheet, Dimensions } from
 import Svg, { Rect, Path, G, Line, Text as SvgText } from 'react-native-svg';
 import * as Haptics from 'expo-haptics';
 import { fontFamily } from '../../theme/colors';
-import { roundedBar, rollingAvg, monotoneCubicPath, parseLocalDate } from '../../utils/chartMath';
+import { roundedBar, rollingAverages, monotoneCubicPath, memoPath, seriesKey, parseLocalDate } from '../../utils/chartMath';
 
 const SCREEN_WIDTH = Dimensions.get('window').width;
 
@@ -79,32 +79,47 @@ export function TrendBarChart({
 
   const denom = Math.max(1, maxValue - minValue);
 
-  const { rawValues, dateLabels, trendPath, snapOffsets } = useMemo(() => {
-    const rv = reversed.map(d => values.find(s => s.dateKey === d.dateKey)?.value ?? 0);
+  const { rawValues, dateLabels, trendPath, barPaths, snapOffsets } = useMemo(() => {
+    const byDate = new Map(values.map(s => [s.dateKey, s.value]));
+    const rv = reversed.map(d => byDate.get(d.dateKey) ?? 0);
 
     const dl = reversed.map(d => {
       const date = parseLocalDate(d.dateKey);
       return { day: String(date.getDate()), month: date.toLocaleDateString(undefined, { month: 'short' }) };
     });
 
-    const trendPts: Array<{ x: number; y: number }> = [];
-    rv.forEach((_, i) => {
-      const avg = rollingAvg(rv, i);
-      if (avg !== null) {
-        const cx = i * colWidth + colWidth / 2;
-        const clamped = Math.max(minValue, Math.min(avg, maxValue));
-        const barH = ((clamped - minValue) / denom) * maxBarH;
-        trendPts.push({ x: cx, y: baseline - barH });
-      }
+    // Trend line only depends on the series + geometry, so it survives remounts
+    const geomKey = `${colWidth}|${minValue}|${maxValue}|${maxBarH}|${baseline}`;
+    const trend = memoPath(`trend|${seriesKey(rv)}|${geomKey}`, () => {
+      const trendPts: Array<{ x: number; y: number }> = [];
+      rollingAverages(rv).forEach((avg, i) => {
+        if (avg !== null) {
+          const cx = i * colWidth + colWidth / 2;
+          const clamped = Math.max(minValue, Math.min(avg, maxValue));
+          const barH = ((clamped - minValue) / denom) * maxBarH;
+          trendPts.push({ x: cx, y: baseline - barH });
+        }
+      });
+      return monotoneCubicPath(trendPts);
     });
 
+    // Bar outlines don't change with selection; build them once per series
+    const bars = roundedBars
+      ? rv.map((v, i) => {
+          const clamped = v <= 0 ? minValue : Math.max(minValue, Math.min(v, maxValue));
+          const barH = Math.max(3, ((clamped - minValue) / denom) * maxBarH);
+          const x = i * colWidth + colWidth / 2 - barWidth / 2;
+          return roundedBar(x, baseline - barH, barWidth, barH, R_TOP, R_BOT);
+        })
+      : [];
+
     const maxScroll = Math.max(0, contentW - SCREEN_WIDTH);
     const snaps = reversed.map((_, i) =>
       Math.min(maxScroll, Math.max(0, i * colWidth + colWidth / 2 - SCREEN_WIDTH / 2))
     );
 
-    return { rawValues: rv, dateLabels: dl, trendPath: monotoneCubicPath(trendPts), snapOffsets: snaps };
-  }, [reversed, values, colWidth, minValue, maxValue, denom, maxBarH, baseline, contentW]);
+    return { rawValues: rv, dateLabels: dl, trendPath: trend, barPaths: bars, snapOffsets: snaps };
+  }, [reversed, values, colWidth, barWidth, roundedBars, minValue, maxValue, denom, maxBarH, baseline, contentW]);
 
   useEffect(() => {
     const todayCenterX = todayColIndex * colWidth + colWidth / 2;
@@ -213,7 +228,7 @@ export function TrendBarChart({
                   <G key={d.dateKey}>
                     {roundedBars ? (
                       <Path
-                        d={roundedBar(x, y, barWidth, barH, R_TOP, R_BOT)}
+                        d={barPaths[i]}
                         fill={barColor}
                       />
                     ) : (
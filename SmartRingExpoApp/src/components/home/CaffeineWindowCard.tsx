@@ -28,7 +28,7 @@ import {
   type CaffeineDose,
 } from '../../utils/caffeinePk';
 import { useCaffeineTimeline } from '../../hooks/useCaffeineTimeline';
-import { useHomeDataContext } from '../../context/HomeDataContext';
+import { useHomeDataFields } from '../../context/HomeDataContext';
 
 // ─── Chart geometry ───────────────────────────────────────────────────────────
 const CHART_PAD_L = 30;
@@ -62,7 +62,7 @@ export function CaffeineWindowCard() {
   const innerW    = cardWidth - CHART_PAD_L - CHART_PAD_R;
 
   // Reads directly from the global HomeDataContext — no prop drilling needed
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('lastNightSleep');
   const { wakeHour, bedHour } = getSleepHours(
     homeData.lastNightSleep?.wakeTime,
     homeData.lastNightSleep?.bedTime,
@@ -5,9 +5,11 @@ import { useTranslation } from 'react-i18next';
 import Ionicons from '@expo/vector-icons/Ionicons';
 import { GradientInfoCard } from '../common/GradientInfoCard';
 import UnifiedSmartRingService from '../../services/UnifiedSmartRingService';
-import { useHomeDataContext } from '../../context/HomeDataContext';
+import { useHomeDataSelector } from '../../context/HomeDataContext';
 import { spacing, fontSize, fontFamily } from '../../theme/colors';
 import { reportError } from '../../utils/sentry';
+import { ringDateMinutes } from '../../utils/ringDate';
+import { countRender } from '../../utils/renderCounts';
 import { ActivityInfoSheet } from './ActivityInfoSheet';
 import type { UnifiedActivity } from '../../types/activity.types';
 
@@ -21,13 +23,14 @@ type Props = {
   onTouchEnd?: () => void;
 };
 
-export function DailyHeartRateCard({ preloadedData, headerRight, onTouchStart, onTouchEnd }: Props = {}) {
+export const DailyHeartRateCard = React.memo(function DailyHeartRateCard({ preloadedData, headerRight, onTouchStart, onTouchEnd }: Props = {}) {
+  if (__DEV__) countRender('DailyHeartRateCard');
   const { t } = useTranslation();
   const [hourlyHrRanges, setHourlyHrRanges] = useState<HourRange[]>([]);
   const [selectedHrIndex, setSelectedHrIndex] = useState<number | null>(null);
   const [selectedActivity, setSelectedActivity] = useState<UnifiedActivity | null>(null);
   const isMockData = UnifiedSmartRingService.isUsingMockData();
-  const homeData = useHomeDataContext();
+  const unifiedActivities = useHomeDataSelector(data => data.unifiedActivities);
   const chartWidthRef = useRef(0);
   const touchStartXRef = useRef(0);
   const lastSetHrIndexRef = useRef<number | null>(null);
@@ -36,7 +39,7 @@ export function DailyHeartRateCard({ preloadedData, headerRight, onTouchStart, o
   const activitiesByHour = useMemo(() => {
     const todayStr = new Date().toISOString().split('T')[0];
     const map = new Map<number, UnifiedActivity[]>();
-    for (const a of homeData.unifiedActivities) {
+    for (const a of unifiedActivities) {
       if (!a.startDate.startsWith(todayStr)) continue;
       const hour = new Date(a.startDate).getHours();
       const existing = map.get(hour) ?? [];
@@ -44,7 +47,7 @@ export function DailyHeartRateCard({ preloadedData, headerRight, onTouchStart, o
       map.set(hour, existing);
     }
     return map;
-  }, [homeData.unifiedActivities]);
+  }, [unifiedActivities]);
   const activitiesByHourRef = useRef(activitiesByHour);
   activitiesByHourRef.current = activitiesByHour;
   const handleTouchRef = useRef<(x: number) => void>(() => {});
@@ -53,18 +56,6 @@ export function DailyHeartRateCard({ preloadedData, headerRight, onTouchStart, o
   onTouchStartRef.current = onTouchStart;
   onTouchEndRef.current   = onTouchEnd;
 
-  const parseX3DateToMinutes = (value?: string): number | undefined => {
-    if (!value || typeof value !== 'string') return undefined;
-    const [datePart, timePart] = value.trim().split(/\s+/);
-    if (!datePart) return undefined;
-    const [y, m, d] = datePart.split('.').map(Number);
-    const [hh, mm, ss] = (timePart || '00:00:00').split(':').map(Number);
-    if ([y, m, d, hh, mm, ss].some((n) => Number.isNaN(n))) return undefined;
-    const dt = new Date(y, m - 1, d, hh, mm, ss);
-    if (!Number.isFinite(dt.getTime()) || dt.getTime() <= 0) return undefined;
-    return dt.getHours() * 60 + dt.getMinutes();
-  };
-
   const buildRanges = (data: Array<{ timeMinutes: number; heartRate: number }>) => {
     if (data && data.length > 0) {
       const hourly = new Map<number, { min: number; max: number; hasData: boolean }>();
@@ -112,7 +103,7 @@ export function DailyHeartRateCard({ preloadedData, headerRight, onTouchStart, o
           const ts = rec.startTimestamp;
           const startMin = typeof ts === 'number'
             ? (ts > 1e10 ? new Date(ts).getHours() * 60 + new Date(ts).getMinutes() : Math.round(ts / 60))
-            : (parseX3DateToMinutes(rec.date) ?? 0);
+            : (ringDateMinutes(rec.date) ?? 0);
           arr.forEach((v: number, idx: number) => {
             if (v > 0) points.push({ timeMinutes: startMin + idx, heartRate: v });
           });
@@ -123,7 +114,7 @@ export function DailyHeartRateCard({ preloadedData, headerRight, onTouchStart, o
               const segVals = Array.isArray(seg?.arrayHR)
                 ? seg.arrayHR.map((v: any) => Number(v)).filter((v: number) => Number.isFinite(v))
                 : [];
-              const segStart = parseX3DateToMinutes(seg?.date) ?? startMin;
+              const segStart = ringDateMinutes(seg?.date) ?? startMin;
               segVals.forEach((v: number, idx: number) => {
                 if (v > 0) points.push({ timeMinutes: segStart + idx, heartRate: v });
               });
@@ -325,7 +316,7 @@ export function DailyHeartRateCard({ preloadedData, headerRight, onTouchStart, o
     </GradientInfoCard>
     </>
   );
-}
+});
 
 const styles = StyleSheet.create({
   hrIcon: {
@@ -3,7 +3,7 @@ import { View, Text, StyleSheet } from 'react-native';
 import { useTranslation } from 'react-i18next';
 import { GradientInfoCard } from '../common/GradientInfoCard';
 import { spacing, fontFamily, fontSize } from '../../theme/colors';
-import { useHomeDataContext } from '../../context/HomeDataContext';
+import { useHomeDataFields } from '../../context/HomeDataContext';
 import { supabase } from '../../services/SupabaseService';
 import { parseLocalDate } from '../../utils/chartMath';
 import { reportError } from '../../utils/sentry';
@@ -27,7 +27,7 @@ export function DailySleepTrendCard({ headerRight }: DailySleepTrendCardProps =
     t('sleep_trend.day_sat'),
   ];
   const [sleepDays, setSleepDays] = useState<SleepDay[]>([]);
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('lastNightSleep');
 
   useEffect(() => {
     let cancelled = false;
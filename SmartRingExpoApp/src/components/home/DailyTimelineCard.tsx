@@ -4,6 +4,7 @@ import Ionicons from '@expo/vector-icons/Ionicons';
 import { HeartIcon } from '../common/HeartIcon';
 import { useTranslation } from 'react-i18next';
 import { spacing, fontSize, fontFamily } from '../../theme/colors';
+import { countRender } from '../../utils/renderCounts';
 import type { SleepData } from '../../hooks/useHomeData';
 import type { X3ActivitySession } from '../../types/sdk.types';
 import type { TimelineEntry, RecoverySubtype } from '../../types/timeline.types';
@@ -180,7 +181,7 @@ interface DailyTimelineCardProps {
 
 // ─── Component ────────────────────────────────────────────────────────────────
 
-export default function DailyTimelineCard({
+const DailyTimelineCard = React.memo(function DailyTimelineCard({
   sleep,
   activitySessions,
   manualEntries,
@@ -189,6 +190,7 @@ export default function DailyTimelineCard({
   caffeineEntries = [],
   onAddPress,
 }: DailyTimelineCardProps) {
+  if (__DEV__) countRender('DailyTimelineCard');
   const { t } = useTranslation();
   const events = useMemo<TimelineEvent[]>(() => {
     const list: TimelineEvent[] = [];
@@ -371,7 +373,7 @@ export default function DailyTimelineCard({
       </View>
     </View>
   );
-}
+});
 
 const styles = StyleSheet.create({
   container: {
@@ -473,3 +475,5 @@ const styles = StyleSheet.create({
     fontFamily: fontFamily.regular,
   },
 });
+
+export default DailyTimelineCard;
@@ -5,7 +5,7 @@ import Svg, { Path } from 'react-native-svg';
 import { useTranslation } from 'react-i18next';
 import { GradientInfoCard } from '../common/GradientInfoCard';
 import UnifiedSmartRingService from '../../services/UnifiedSmartRingService';
-import { useHomeDataContext } from '../../context/HomeDataContext';
+import { useHomeDataFields } from '../../context/HomeDataContext';
 import { spacing, fontSize, fontFamily } from '../../theme/colors';
 import { reportError } from '../../utils/sentry';
 
@@ -50,7 +50,7 @@ type LiveHeartRateCardProps = {
 
 export function LiveHeartRateCard({ headerRight }: LiveHeartRateCardProps = {}) {
   const { t } = useTranslation();
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('isRingConnected');
   const [state, setState] = useState<MeasurementState>('idle');
   const [currentHR, setCurrentHR] = useState<number | null>(null);
   const [secondsLeft, setSecondsLeft] = useState(MEASURE_DURATION);
@@ -3,6 +3,7 @@ import { View, Text, StyleSheet, Dimensions, PanResponder } from 'react-native';
 import Svg, { Defs, Line, LinearGradient, Pattern, Rect, Stop, Text as SvgText } from 'react-native-svg';
 import { BedtimeIcon, SleptIcon, WakeTimeIcon } from '../../assets/icons';
 import { spacing, fontFamily } from '../../theme/colors';
+import { countRender } from '../../utils/renderCounts';
 
 export type SleepStage = 'awake' | 'rem' | 'core' | 'deep';
 
@@ -95,7 +96,8 @@ type TooltipState = {
   sessionLabel?: string;
 } | null;
 
-export function SleepHypnogram({ segments, bedTime, wakeTime, sessions, onTouchStart, onTouchEnd }: SleepHypnogramProps) {
+export const SleepHypnogram = React.memo(function SleepHypnogram({ segments, bedTime, wakeTime, sessions, onTouchStart, onTouchEnd }: SleepHypnogramProps) {
+  if (__DEV__) countRender('SleepHypnogram');
   const [tooltip, setTooltip] = useState<TooltipState>(null);
   const layoutWidth    = useRef(0);
   const handleTouchRef = useRef<(x: number) => void>(() => {});
@@ -501,7 +503,7 @@ export function SleepHypnogram({ segments, bedTime, wakeTime, sessions, onTouchS
       </View>
     </View>
   );
-}
+});
 
 const styles = StyleSheet.create({
   container: {
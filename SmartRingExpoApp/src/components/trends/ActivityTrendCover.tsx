@@ -10,7 +10,7 @@ import { TREND_CHART_W, CARD_BLUR_STYLE } from './trendLayout';
 import { BlurView } from 'expo-blur';
 import { useMetricHistory, DayActivityData, buildDayNavigatorLabels } from '../../hooks/useMetricHistory';
 import { trendDirection } from '../../utils/baselineStats';
-import { useHomeDataContext } from '../../context/HomeDataContext';
+import { useHomeDataFields } from '../../context/HomeDataContext';
 import { spacing, fontFamily } from '../../theme/colors';
 
 const STEP_COLOR = '#FFB84D';
@@ -23,7 +23,7 @@ function formatSteps(n: number): string {
 export function ActivityTrendCover() {
   const { t } = useTranslation();
   const router = useRouter();
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('strain', 'strainBreakdown');
 
   const { data: activityData, isLoading } = useMetricHistory<DayActivityData>('activity', { initialDays: 7 });
   const dayLabels = useMemo(() => buildDayNavigatorLabels(7), []);
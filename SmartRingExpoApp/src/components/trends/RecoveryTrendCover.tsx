@@ -10,7 +10,7 @@ import { TREND_LINE_CHART_W, CARD_BLUR_STYLE } from './trendLayout';
 import { BlurView } from 'expo-blur';
 import { useMetricHistory, DayHRVData, buildDayNavigatorLabels } from '../../hooks/useMetricHistory';
 import { bandFromBaseline, mean, trendDirection } from '../../utils/baselineStats';
-import { useHomeDataContext } from '../../context/HomeDataContext';
+import { useHomeDataFields } from '../../context/HomeDataContext';
 import type { FocusBaselines } from '../../types/focus.types';
 import { spacing, fontFamily } from '../../theme/colors';
 
@@ -23,7 +23,7 @@ interface Props {
 export function RecoveryTrendCover({ baselines }: Props) {
   const { t } = useTranslation();
   const router = useRouter();
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('hrvSdnn', 'lastNightSleep', 'todayVitals');
 
   const { data: hrvData, isLoading } = useMetricHistory<DayHRVData>('hrv', { initialDays: 7, fullDays: 30 });
   const dayLabels30 = useMemo(() => buildDayNavigatorLabels(30), []);
@@ -1,6 +1,6 @@
 import React, { createContext, useContext, useState, useEffect, useCallback, useMemo, useRef, ReactNode } from 'react';
 import AsyncStorage from '@react-native-async-storage/async-storage';
-import { useHomeDataContext } from './HomeDataContext';
+import { useHomeDataFields } from './HomeDataContext';
 import {
   computeBaselineState,
   loadBaselineCompletedAt,
@@ -65,7 +65,7 @@ function statesAreEqual(a: BaselineModeState, b: BaselineModeState): boolean {
 }
 
 export function BaselineModeProvider({ children }: { children: ReactNode }) {
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('hrvSdnn', 'sleepScore');
   const [state, setState] = useState<BaselineModeState>(EMPTY_STATE);
   const [justCompleted, setJustCompleted] = useState(false);
   const [initialized, setInitialized] = useState(false);
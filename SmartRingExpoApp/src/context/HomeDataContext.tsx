@@ -1,13 +1,27 @@
-import React, { createContext, useContext, ReactNode } from 'react';
+import React, {
+  createContext,
+  useContext,
+  useLayoutEffect,
+  useMemo,
+  useRef,
+  useState,
+  useSyncExternalStore,
+  ReactNode,
+} from 'react';
 import { useHomeData, HomeData } from '../hooks/useHomeData';
 import { useOnboarding } from './OnboardingContext';
+import { createSelection, createSelectorStore, shallowEqual, type Selection, type SelectorStore } from '../utils/selectorStore';
+import { renderCounts, resetRenderCounts } from '../utils/renderCounts';
 
 interface HomeDataContextValue extends HomeData {
   refresh: () => Promise<void>;
   applyOverrideNow: () => Promise<void>;
 }
 
-const HomeDataContext = createContext<HomeDataContextValue | null>(null);
+// The context carries the store, which never changes; consumers subscribe to the
+// slices they read (useHomeDataSelector / useHomeDataFields), so a sync-progress tick
+// only re-renders what shows sync progress.
+const HomeDataContext = createContext<SelectorStore<HomeDataContextValue> | null>(null);
 
 interface HomeDataProviderProps {
   children: ReactNode;
@@ -17,19 +31,82 @@ export function HomeDataProvider({ children }: HomeDataProviderProps) {
   const { isAuthenticated, hasConnectedDevice } = useOnboarding();
   const homeData = useHomeData(isAuthenticated && hasConnectedDevice);
 
+  // useHomeData hands out fresh callbacks every render; publish stable ones so they
+  // don't count as a change
+  const latest = useRef(homeData);
+  latest.current = homeData;
+  const actions = useMemo(() => ({
+    refresh: () => latest.current.refresh(),
+    applyOverrideNow: () => latest.current.applyOverrideNow(),
+    refreshMissingCardData: (...args: Parameters<HomeData['refreshMissingCardData']>) =>
+      latest.current.refreshMissingCardData(...args),
+  }), []);
+
+  const [store] = useState(() => createSelectorStore<HomeDataContextValue>({ ...homeData, ...actions }));
+  useLayoutEffect(() => {
+    store.set({ ...homeData, ...actions });
+  }, [store, homeData, actions]);
+
+  // Dev: renders per component over one full sync (see utils/renderCounts)
+  useLayoutEffect(() => {
+    if (!__DEV__) return;
+    let phase = store.getSnapshot().syncProgress.phase;
+    return store.subscribe(() => {
+      const next = store.getSnapshot().syncProgress.phase;
+      if (next === phase) return;
+      if (next === 'connecting') resetRenderCounts();
+      if ((next === 'complete' || next === 'idle') && phase !== 'complete' && phase !== 'idle') {
+        console.log('[renders] sync', next, renderCounts());
+      }
+      phase = next;
+    });
+  }, [store]);
+
   return (
-    <HomeDataContext.Provider value={homeData}>
+    <HomeDataContext.Provider value={store}>
       {children}
     </HomeDataContext.Provider>
   );
 }
 
-export function useHomeDataContext(): HomeDataContextValue {
-  const context = useContext(HomeDataContext);
-  if (!context) {
-    throw new Error('useHomeDataContext must be used within a HomeDataProvider');
+function useHomeDataStore(hook: string): SelectorStore<HomeDataContextValue> {
+  const store = useContext(HomeDataContext);
+  if (!store) {
+    throw new Error(`${hook} must be used within a HomeDataProvider`);
   }
-  return context;
+  return store;
+}
+
+/**
+ * The slice of home data `selector` returns. Re-renders only when that slice changes
+ * (Object.is by default; pass shallowEqual for a selector that builds an object).
+ */
+export function useHomeDataSelector<T>(
+  selector: (data: HomeDataContextValue) => T,
+  isEqual: (a: T, b: T) => boolean = Object.is,
+): T {
+  const store = useHomeDataStore('useHomeDataSelector');
+  const selection = useRef<Selection<HomeDataContextValue, T> | null>(null);
+  selection.current ??= createSelection();
+  const read = () => selection.current!.read(store.getSnapshot(), selector, isEqual);
+  return useSyncExternalStore(store.subscribe, read, read);
+}
+
+/** The named fields of home data; re-renders only when one of them changes. */
+export function useHomeDataFields<K extends keyof HomeDataContextValue>(
+  ...keys: K[]
+): Pick<HomeDataContextValue, K> {
+  return useHomeDataSelector(data => {
+    const picked = {} as Pick<HomeDataContextValue, K>;
+    for (const key of keys) picked[key] = data[key];
+    return picked;
+  }, shallowEqual);
+}
+
+/** All of home data. Re-renders on every change — prefer useHomeDataSelector / useHomeDataFields. */
+export function useHomeDataContext(): HomeDataContextValue {
+  const store = useHomeDataStore('useHomeDataContext');
+  return useSyncExternalStore(store.subscribe, store.getSnapshot, store.getSnapshot);
 }
 
 export default HomeDataContext;
@@ -1,4 +1,4 @@
-import { useState, useEffect, useCallback, useRef } from 'react';
+import { useState, useEffect, useCallback, useMemo, useRef } from 'react';
 import { supabase } from '../services/SupabaseService';
 
 let _subCounter = 0;
@@ -7,6 +7,7 @@ import { reportError } from '../utils/sentry';
 import {
   CaffeineDose,
   totalMgAt,
+  caffeineCurve,
   clearanceHour as computeClearanceHour,
 } from '../utils/caffeinePk';
 import type { Database } from '../types/supabase.types';
@@ -99,23 +100,23 @@ export function useCaffeineTimeline(date: Date = new Date()): UseCaffeineTimelin
     };
   }, [load]);
 
-  const doses: CaffeineDose[] = entries.map(e => ({
+  // Stable identity while entries are unchanged, so consumers' memos hold across renders
+  const doses: CaffeineDose[] = useMemo(() => entries.map(e => ({
     intakeHour: rowToDecimalHour(e.consumed_at),
     amountMg: e.caffeine_mg,
-  }));
+  })), [entries]);
 
   const now = new Date();
   const nowHour = now.getHours() + now.getMinutes() / 60;
   const currentMg = Math.round(totalMgAt(nowHour, doses));
 
-  // Peak: sample every 15 min from first dose to now
+  // Peak: sample every 15 min from first dose to now (curve is memoized by dose set)
   let peakMgToday = 0;
   if (doses.length > 0) {
     const earliest = Math.min(...doses.map(d => d.intakeHour));
-    for (let h = earliest; h <= nowHour; h += 0.25) {
-      peakMgToday = Math.max(peakMgToday, totalMgAt(h, doses));
+    if (nowHour >= earliest) {
+      peakMgToday = Math.round(caffeineCurve(doses, earliest, nowHour, 0.25).peakMg);
     }
-    peakMgToday = Math.round(peakMgToday);
   }
 
   const totalMgToday = Math.round(entries.reduce((s, e) => s + e.caffeine_mg, 0));
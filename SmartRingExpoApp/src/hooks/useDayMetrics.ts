@@ -16,7 +16,7 @@
 
 import { useCallback } from 'react';
 import { useFocusDataContext } from '../context/FocusDataContext';
-import { useHomeDataContext } from '../context/HomeDataContext';
+import { useHomeDataFields } from '../context/HomeDataContext';
 import { buildDayMetrics } from '../services/ReadinessService';
 import type { DayMetrics } from '../types/focus.types';
 import type { DaySleepData, DayHRData, DayHRVData } from './useMetricHistory';
@@ -36,7 +36,7 @@ export function useDayMetrics({ sleepData, hrData, hrvData, todayKey }: DayMetri
   resolve: (dateKey: string) => DayMetrics | null;
 } {
   const focusData = useFocusDataContext();
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('hrvSdnn', 'lastNightSleep');
 
   const resolve = useCallback((dateKey: string): DayMetrics | null => {
     const baselines = focusData.baselines;
@@ -24,8 +24,13 @@ import HealthKitSleepProcessor from '../services/HealthKit/HealthKitSleepProcess
 import { stravaService } from '../services/StravaService';
 import { mergeActivities } from '../services/ActivityDeduplicator';
 import { formatSleepDuration, calculateSleepScore, calculateSleepScoreFromStages, extractSleepVitalsFromRaw } from '../utils/ringData/sleep';
-import { getSleepOverride } from '../services/SleepOverrideService';
+import { getSleepOverride, overrideWindow } from '../services/SleepOverrideService';
 import { fillSleepGap } from '../services/SleepGapFillService';
+import { startHydration, type HydrationStage, type StageGetter } from '../services/HydrationPipeline';
+import { baselineMedian, pushRolling } from '../utils/rollingStats';
+import { parseRingDate, ringDateMinutes } from '../utils/ringDate';
+import { NIGHT_MIN_MS, SUGGESTED_BEDTIME_MIN_GAP_MS, sleepSegmenter, type SleepSession } from '../services/SleepSegmentation';
+import { localDateKey, type DayActivityRollup } from '../services/ActivityDetailStore';
 
 type AuthUser = { user_metadata?: Record<string, any>; email?: string | null } | null | undefined;
 
@@ -271,32 +276,20 @@ const getEmptyBaselines = (): MetricBaselines => ({
   activeMinutes: [],
 });
 
-const median = (values: number[]): number | null => {
-  if (values.length === 0) return null;
-  const sorted = [...values].sort((a, b) => a - b);
-  const mid = Math.floor(sorted.length / 2);
-  if (sorted.length % 2 === 0) {
-    return (sorted[mid - 1] + sorted[mid]) / 2;
-  }
-  return sorted[mid];
-};
-
-const pushRolling = (values: number[], value: number, max: number = 14): number[] => {
-  if (!Number.isFinite(value) || value <= 0) return values;
-  const next = [...values, value];
-  if (next.length <= max) return next;
-  return next.slice(next.length - max);
-};
-
 // Compute a single day's activity load on a 0–100 scale.
 // Uses the same formula as the old today-only strain, applied to any day's inputs.
+// With per-minute ring history, the steps term scores cadence-based intensity
+// minutes (an hour of moderate, or 30 min of vigorous = 100) instead of the total.
 const computeDailyLoad = (
   activeCalories: number,
   steps: number,
   stravaSufferSum: number | null,
+  intensity?: Pick<DayActivityRollup, 'moderateMinutes' | 'vigorousMinutes'> | null,
 ): number => {
   const calStrain = Math.max(0, Math.min(100, ((activeCalories - 300) / 900) * 100));
-  const stepsScore = Math.max(0, Math.min(100, (steps / 10000) * 100));
+  const stepsScore = intensity
+    ? Math.min(100, ((intensity.moderateMinutes + 2 * intensity.vigorousMinutes) / 60) * 100)
+    : Math.max(0, Math.min(100, (steps / 10000) * 100));
   if (stravaSufferSum != null && stravaSufferSum > 0) {
     const stravaStrain = Math.min(100, stravaSufferSum / 2);
     return 0.65 * stravaStrain + 0.35 * calStrain;
@@ -365,14 +358,14 @@ function buildContributors(
   const tempC = vitals.temperatureC;
   const spo2 = vitals.lastSpo2 ?? vitals.minSpo2;
 
-  const baselineSleep = median(baselines.sleepMinutes);
-  const baselineRestingHR = median(baselines.restingHR);
-  const baselineHrv = median(baselines.hrvSdnn);
-  const baselineTemp = median(baselines.temperature);
-  const baselineSpo2 = median(baselines.spo2);
-  const baselineSteps = median(baselines.steps);
-  const baselineCalories = median(baselines.calories);
-  const baselineActive = median(baselines.activeMinutes);
+  const baselineSleep = baselineMedian(baselines.sleepMinutes);
+  const baselineRestingHR = baselineMedian(baselines.restingHR);
+  const baselineHrv = baselineMedian(baselines.hrvSdnn);
+  const baselineTemp = baselineMedian(baselines.temperature);
+  const baselineSpo2 = baselineMedian(baselines.spo2);
+  const baselineSteps = baselineMedian(baselines.steps);
+  const baselineCalories = baselineMedian(baselines.calories);
+  const baselineActive = baselineMedian(baselines.activeMinutes);
   const baselineCount = Math.min(
     baselines.sleepMinutes.length,
     baselines.restingHR.length,
@@ -712,30 +705,19 @@ function buildNapSegments(detailJson: any, startTimeIso: string, endTimeIso: str
   return [{ stage: 'core', startTime: startDate, endTime: endDate }];
 }
 
-/**
- * Parse "YYYY.MM.DD HH:MM:SS" string timestamps from raw SDK records.
- */
-function parseStart(str?: string): number | undefined {
-  if (!str) return;
-  const [d, t] = str.split(' ');
-  if (!d || !t) return;
-  const [y, m, day] = d.split('.').map(Number);
-  const [hh, mm, ss] = t.split(':').map(Number);
-  if ([y, m, day, hh, mm, ss].some(n => Number.isNaN(n))) return;
-  return new Date(y, (m ?? 1) - 1, day, hh, mm, ss).getTime();
-}
-
 // Returns a suggested bedtime when the ring started recording ≥45 min after the user
 // actually went to bed. Tries HealthKit in-bed time first, then Supabase 7-night average.
 async function getSuggestedBedtime(ringBedTime: Date, userId: string): Promise<Date | null> {
-  const MIN_GAP_MIN = 45;
-
   try {
+    // Fused onto the ring session by SleepSegmenter when HealthKit's session overlaps it
     const hkSleep = await new HealthKitSleepProcessor().fetchSleepData();
-    if (hkSleep?.bedTime) {
-      const hkBed = new Date(hkSleep.bedTime);
-      const gapMin = (ringBedTime.getTime() - hkBed.getTime()) / 60000;
-      if (gapMin >= MIN_GAP_MIN) return hkBed;
+    if (hkSleep?.samples.length) {
+      sleepSegmenter.setHealthKit(hkSleep.samples.map(s => ({
+        start: new Date(s.startDate).getTime(),
+        end: new Date(s.endDate).getTime(),
+      })));
+      const suggested = sleepSegmenter.sessionAt(ringBedTime.getTime())?.suggestedBedTime;
+      if (suggested !== undefined) return new Date(suggested);
     }
   } catch {}
 
@@ -768,8 +750,7 @@ async function getSuggestedBedtime(ringBedTime: Date, userId: string): Promise<D
     suggested.setHours(Math.floor(normMin / 60) % 24, Math.round(normMin % 60), 0, 0);
     if (suggested.getTime() >= ringBedTime.getTime()) suggested.setDate(suggested.getDate() - 1);
 
-    const gapMin = (ringBedTime.getTime() - suggested.getTime()) / 60000;
-    if (gapMin >= MIN_GAP_MIN) return suggested;
+    if (ringBedTime.getTime() - suggested.getTime() >= SUGGESTED_BEDTIME_MIN_GAP_MS) return suggested;
   } catch {}
 
   return null;
@@ -777,9 +758,8 @@ async function getSuggestedBedtime(ringBedTime: Date, userId: string): Promise<D
 
 /**
  * Build SleepData from raw JstyleService.getSleepData() records.
- * Smarter than buildSleepSegments: handles multi-record gaps (up to 60min),
- * builds a continuous 1-min timeline, and chooses the most recent sleep block.
- * Ported from testing.tsx (the cheatsheet).
+ * Records are merged into sessions by the shared SleepSegmenter (≤60 min gaps, 1-min
+ * stage timeline), so this picks the same blocks DataSyncService uploads.
  */
 function deriveFromRaw(rawRecords: any[]): { night: SleepData | null; ringNaps: RingNapBlock[] } | null {
   if (!rawRecords || rawRecords.length === 0) return null;
@@ -787,7 +767,7 @@ function deriveFromRaw(rawRecords: any[]): { night: SleepData | null; ringNaps:
   // ── RAW RECORD DUMP ────────────────────────────────────────────────────────
   console.log(`😴 [deriveFromRaw] RAW RECORDS (${rawRecords.length}):`);
   rawRecords.forEach((r, i) => {
-    const startTs = r.startTimestamp || parseStart(r.startTime_SleepData);
+    const startTs = r.startTimestamp || parseRingDate(r.startTime_SleepData);
     const startStr = startTs ? new Date(startTs).toLocaleString() : 'NO_START';
     const dur = Number(r.totalSleepTime) || (r.arraySleepQuality?.length || 0) * (Number(r.sleepUnitLength) || 1);
     console.log(`  [${i}] date=${r.date} startTime_SleepData=${r.startTime_SleepData} startTimestamp=${r.startTimestamp} → parsed=${startStr} totalSleepTime=${r.totalSleepTime} arraySleepQuality.length=${r.arraySleepQuality?.length} deep=${r.deepSleepTime} light=${r.lightSleepTime} durMin=${dur}`);
@@ -796,71 +776,23 @@ function deriveFromRaw(rawRecords: any[]): { night: SleepData | null; ringNaps:
 
   const extractedVitals = extractSleepVitalsFromRaw(rawRecords);
 
-  const normalizedAll = rawRecords.map(r => {
-    const start = r.startTimestamp || parseStart(r.startTime_SleepData);
-    const unit = Number(r.sleepUnitLength) || 1;
-    const arr: number[] = r.arraySleepQuality || [];
-    // Use recording-period length (arr.length × unit) for block grouping — NOT totalSleepTime.
-    // totalSleepTime is net sleep (excludes awake minutes), so it undershoots the 2-hour chunk
-    // boundary and creates false >60 min gaps between adjacent records.
-    const durationMin = arr.length * unit;
-    return { start, unit, arr, durationMin };
-  }).filter(r => typeof r.start === 'number' && r.start > 0);
-
-  if (normalizedAll.length === 0) return null;
-
-  const sorted = [...normalizedAll].sort((a, b) => a.start! - b.start!);
-  const MAX_GAP_MS = 60 * 60 * 1000;
-  const blocks: { start: number; end: number; records: typeof normalizedAll }[] = [];
-  let block: { start: number; end: number; records: typeof normalizedAll } | null = null;
-
-  for (const rec of sorted) {
-    const recStart = rec.start!;
-    const recEnd = rec.start! + rec.durationMin * 60000;
-    if (!block) {
-      block = { start: recStart, end: recEnd, records: [rec] };
-      continue;
-    }
-    if (recStart - block.end <= MAX_GAP_MS) {
-      block.end = Math.max(block.end, recEnd);
-      block.records.push(rec);
-    } else {
-      blocks.push(block);
-      block = { start: recStart, end: recEnd, records: [rec] };
-    }
-  }
-  if (block) blocks.push(block);
+  sleepSegmenter.addRingRecords(rawRecords);
+  const blocks = sleepSegmenter.sessions().filter(b => b.records.length > 0);
   if (blocks.length === 0) return null;
 
   console.log(`😴 [deriveFromRaw] BLOCKS (${blocks.length}):`);
   blocks.forEach((b, i) => {
-    console.log(`  [${i}] ${new Date(b.start).toLocaleString()} → ${new Date(b.end).toLocaleString()} (${Math.round((b.end - b.start) / 60000)}min, ${b.records.length} records)`);
+    console.log(`  [${i}] ${new Date(b.start).toLocaleString()} → ${new Date(b.end).toLocaleString()} (${Math.round((b.end - b.start) / 60000)}min, ${b.records.length} records, ${b.sessionType})`);
   });
 
-  // Pick most recent night-length block (≥180min), fallback using Oura-style nap detection
-  const NIGHT_THRESHOLD_MS = 180 * 60 * 1000; // 3 hours
-  const nightCandidates = blocks.filter(b => (b.end - b.start) >= NIGHT_THRESHOLD_MS);
-
-  // Oura-style: long block → always night; short block starting 8 PM–4 AM → disrupted night;
-  // short block starting 4 AM–8 PM → nap (daytime), not night sleep
-  let nightBlock: typeof blocks[0] | null = null;
-  if (nightCandidates.length > 0) {
-    nightBlock = nightCandidates.reduce((acc, b) => (b.end > acc.end ? b : acc), nightCandidates[0]);
-  } else {
-    const mostRecent = blocks.reduce((acc, b) => (b.end > acc.end ? b : acc), blocks[0]);
-    const startHour = new Date(mostRecent.start).getHours();
-    const endHour = new Date(mostRecent.end).getHours();
-    // Early morning session (3–9 AM start, ends before 9 AM) = morning wake phase, not a daytime nap.
-    // Catches V8 band behavior where only the last sleep fragment before waking is recorded.
-    const isEarlyMorning = startHour >= 3 && startHour < 10 && endHour < 9;
-    const isNapLike = startHour >= 4 && startHour < 20 && !isEarlyMorning;
-    if (!isNapLike) nightBlock = mostRecent; // nighttime or early-morning wake phase → disrupted night
-  }
+  // Most recent night-length block (≥180min); otherwise the most recent block unless it
+  // classifies as a daytime nap
+  const nightBlock = sleepSegmenter.mainNight();
 
   if (nightBlock) {
-    console.log(`🛏️ [deriveFromRaw] ${blocks.length} blocks, ${nightCandidates.length} night candidates → chosen: ${new Date(nightBlock.start).toLocaleString()} → ${new Date(nightBlock.end).toLocaleString()} (${Math.round((nightBlock.end - nightBlock.start) / 60000)}min)`);
+    console.log(`🛏️ [deriveFromRaw] ${blocks.length} blocks → chosen: ${new Date(nightBlock.start).toLocaleString()} → ${new Date(nightBlock.end).toLocaleString()} (${Math.round((nightBlock.end - nightBlock.start) / 60000)}min, ${nightBlock.reason})`);
   } else {
-    console.log(`🛏️ [deriveFromRaw] ${blocks.length} blocks are nap-like (daytime start) → no night block, will use Supabase fallback`);
+    console.log(`🛏️ [deriveFromRaw] ${blocks.length} blocks, most recent is nap-like (daytime start) → no night block, will use Supabase fallback`);
   }
 
   const todayStart = new Date();
@@ -870,7 +802,7 @@ function deriveFromRaw(rawRecords: any[]): { night: SleepData | null; ringNaps:
   // When all ring blocks are nap-like, return them as ringNaps with null night
   if (!nightBlock) {
     const ringNapsFromNullNight = blocks
-      .filter(b => b.start >= todayStartMs && (b.end - b.start) <= NIGHT_THRESHOLD_MS)
+      .filter(b => b.start >= todayStartMs && (b.end - b.start) <= NIGHT_MIN_MS)
       .map(blockToRingNap)
       .filter(n => n.totalMin > 0);
     console.log(`🛏️ [deriveFromRaw] ringNaps (null-night path): ${ringNapsFromNullNight.length}`);
@@ -882,14 +814,12 @@ function deriveFromRaw(rawRecords: any[]): { night: SleepData | null; ringNaps:
 
   // Remaining blocks are ring-detected nap candidates
   // Only include blocks from TODAY that are short (<180min = nap threshold from NapClassifierService)
-  const MAX_NAP_DURATION_MS = 180 * 60 * 1000; // 3 hours
-
   const ringNaps: RingNapBlock[] = blocks
     .filter(b => b !== nightBlock)
     .filter(b => {
       const dur = b.end - b.start;
       const isToday = b.start >= todayStartMs;
-      const isShort = dur <= MAX_NAP_DURATION_MS;
+      const isShort = dur <= NIGHT_MIN_MS;
       // Early-morning blocks (start 0–9 AM, end before 9 AM) are sleep tails, not daytime naps
       const startHour = new Date(b.start).getHours();
       const endHour = new Date(b.end).getHours();
@@ -915,51 +845,27 @@ interface RingNapBlock {
   totalMin: number;
 }
 
-// Trims leading & trailing awake segments so the displayed sleep window
-// matches actual sleep onset → offset. Mid-night awakenings are preserved
-// because they're real sleep disturbances.
-function blockToRingNap(b: { start: number; end: number; records: any[] }): RingNapBlock {
-  const segs = buildBlockSegments(b);
-  let deepMin = 0, lightMin = 0, remMin = 0, awakeMin = 0;
-  for (const seg of segs) {
-    const durMin = Math.round((seg.endTime.getTime() - seg.startTime.getTime()) / 60000);
-    if (seg.stage === 'deep') deepMin += durMin;
-    else if (seg.stage === 'core') lightMin += durMin;
-    else if (seg.stage === 'rem') remMin += durMin;
-    else awakeMin += durMin;
-  }
+function blockToRingNap(b: SleepSession): RingNapBlock {
+  const { deep, light, rem, awake } = b.stages;
   return {
     startMs: b.start,
     endMs: b.end,
-    segments: segs,
-    deepMin,
-    lightMin,
-    remMin,
-    awakeMin,
-    totalMin: deepMin + lightMin + remMin,
+    segments: buildBlockSegments(b),
+    deepMin: deep,
+    lightMin: light,
+    remMin: rem,
+    awakeMin: awake,
+    totalMin: deep + light + rem,
   };
 }
 
-function buildBlockSegments(block: { start: number; end: number; records: Array<{ start: number | undefined; unit: number; arr: number[]; durationMin: number }> }): SleepSegment[] {
-  const totalMinutes = Math.max(0, Math.round((block.end - block.start) / 60000));
-  if (totalMinutes === 0) return [];
-  const timeline: number[] = new Array(totalMinutes).fill(0);
-  for (const rec of block.records) {
-    const startOffset = Math.round((rec.start! - block.start) / 60000);
-    const unit = Math.max(1, rec.unit);
-    rec.arr.forEach((val: number, idx: number) => {
-      const stage = mapSleepType(Number(val));
-      const stageVal = stage === 'deep' ? 3 : stage === 'rem' ? 2 : stage === 'core' ? 1 : 0;
-      for (let k = 0; k < unit; k++) {
-        const pos = startOffset + idx * unit + k;
-        if (pos >= 0 && pos < timeline.length) timeline[pos] = stageVal;
-      }
-    });
-  }
+const TIMELINE_STAGES: SleepStage[] = ['awake', 'core', 'rem', 'deep']; // indexed by STAGE_* code
+
+function buildBlockSegments(block: SleepSession): SleepSegment[] {
+  const { timeline } = block;
   const segments: SleepSegment[] = [];
   for (let i = 0; i < timeline.length; i++) {
-    const val = timeline[i];
-    const stage: SleepStage = val === 3 ? 'deep' : val === 2 ? 'rem' : val === 1 ? 'core' : 'awake';
+    const stage = TIMELINE_STAGES[timeline[i]];
     const startMs = block.start + i * 60000;
     const endMs = startMs + 60000;
     if (segments.length && segments[segments.length - 1].stage === stage) {
@@ -972,34 +878,13 @@ function buildBlockSegments(block: { start: number; end: number; records: Array<
 }
 
 function buildBlockResult(
-  block: { start: number; end: number; records: Array<{ start: number | undefined; unit: number; arr: number[]; durationMin: number }> },
+  block: SleepSession,
   extractedVitals: { restingHR: number; respiratoryRate: number },
 ): SleepData | null {
-  const totalMinutes = Math.max(0, Math.round((block.end - block.start) / 60000));
-  if (totalMinutes === 0) return null;
+  if (block.timeline.length === 0) return null;
 
   const segments = buildBlockSegments(block);
-  const timeline = new Array(totalMinutes).fill(0);
-  for (const rec of block.records) {
-    const startOffset = Math.round((rec.start! - block.start) / 60000);
-    const unit = Math.max(1, rec.unit);
-    rec.arr.forEach((val: number, idx: number) => {
-      const stage = mapSleepType(Number(val));
-      const stageVal = stage === 'deep' ? 3 : stage === 'rem' ? 2 : stage === 'core' ? 1 : 0;
-      for (let k = 0; k < unit; k++) {
-        const pos = startOffset + idx * unit + k;
-        if (pos >= 0 && pos < timeline.length) timeline[pos] = stageVal;
-      }
-    });
-  }
-
-  let deepMinutes = 0, remMinutes = 0, lightMinutes = 0, awakeMinutes = 0;
-  for (const v of timeline) {
-    if (v === 3) deepMinutes++;
-    else if (v === 2) remMinutes++;
-    else if (v === 1) lightMinutes++;
-    else awakeMinutes++;
-  }
+  const { deep: deepMinutes, light: lightMinutes, rem: remMinutes, awake: awakeMinutes } = block.stages;
   const actualSleepMinutes = deepMinutes + lightMinutes + remMinutes;
   const { score } = calculateSleepScore({
     totalSleepMinutes: actualSleepMinutes,
@@ -1210,6 +1095,169 @@ const getEmptyData = (): HomeData => ({
   totalSleepMinutes: 0,
 });
 
+// ─── Hydration stages ───────────────────────────────────────────────────────
+// Network / HealthKit reads that don't touch BLE. They start together at the
+// top of fetchData and overlap with reconnect + the serial ring reads, which
+// fetchData drives inline (one BLE command at a time) and times via begin().
+
+const STRAVA_SYNC_INTERVAL_MS = 10 * 60 * 1000;
+
+type AuthResult = Awaited<ReturnType<typeof supabase.auth.getUser>>;
+type HKActivityTotals = { steps: number; calories: number; distanceM: number };
+type PriorDaySummary = { date: string; total_calories: number; total_steps: number };
+
+function homeHydrationStages(authPromise: Promise<AuthResult>): HydrationStage[] {
+  const userIdOf = async (get: StageGetter) =>
+    (await get<AuthResult>('auth')).data?.user?.id;
+
+  return [
+    {
+      id: 'ringStatus',
+      run: () => UnifiedSmartRingService.isConnected().catch(() => ({ connected: false })),
+    },
+    { id: 'auth', run: () => authPromise },
+    {
+      // Fired right after the status check; awaited only once the caller needs the ring.
+      id: 'reconnect',
+      deps: ['ringStatus'],
+      run: async get => {
+        const status = await get<{ connected?: boolean }>('ringStatus');
+        if (status.connected) return { success: true };
+        console.log('🔄 [useHomeData] autoReconnect...');
+        return UnifiedSmartRingService.autoReconnect();
+      },
+    },
+    {
+      // Rate-limited Strava pull. Failures return null and so are never cached.
+      id: 'stravaAutoSync',
+      deps: ['auth'],
+      ttlMs: STRAVA_SYNC_INTERVAL_MS,
+      run: async get => {
+        if (!(await userIdOf(get))) return null;
+        const r = await stravaService.backgroundSync(3).catch(() => null);
+        if (r) console.log(`🏃 [useHomeData] Auto Strava sync: ${r.count} new activities`);
+        return r ? { count: r.count } : null;
+      },
+    },
+    {
+      // After the auto-sync so the query always sees the freshest activities
+      id: 'stravaActivities',
+      deps: ['auth', 'stravaAutoSync'],
+      run: async get => {
+        const userId = await userIdOf(get);
+        if (!userId) return [];
+        const sevenDaysAgo = new Date();
+        sevenDaysAgo.setDate(sevenDaysAgo.getDate() - 7);
+        const { data } = await supabase
+          .from('strava_activities')
+          .select('id, name, sport_type, start_date, distance_m, moving_time_sec, average_heartrate, max_heartrate, suffer_score, calories, splits_metric_json, zones_json')
+          .eq('user_id', userId)
+          .gte('start_date', sevenDaysAgo.toISOString())
+          .order('start_date', { ascending: false });
+        return (data as unknown as StravaActivitySummary[]) ?? [];
+      },
+    },
+    {
+      id: 'naps',
+      deps: ['auth'],
+      run: async get => {
+        const userId = await userIdOf(get);
+        if (!userId) return [];
+        const todayStart = new Date();
+        todayStart.setHours(0, 0, 0, 0); // local midnight
+        const todayEnd = new Date(todayStart);
+        todayEnd.setDate(todayEnd.getDate() + 1);
+        const { data } = await supabase
+          .from('sleep_sessions')
+          .select('id, start_time, end_time, deep_min, light_min, rem_min, awake_min, nap_score, detail_json')
+          .eq('user_id', userId)
+          .eq('session_type', 'nap')
+          .gte('start_time', todayStart.toISOString())
+          .lte('start_time', todayEnd.toISOString())
+          .order('start_time', { ascending: true });
+        return ((data as any[]) ?? []).map(s => ({
+          id: s.id,
+          startTime: s.start_time,
+          endTime: s.end_time,
+          deepMin: s.deep_min || 0,
+          lightMin: s.light_min || 0,
+          remMin: s.rem_min || 0,
+          awakeMin: s.awake_min || 0,
+          napScore: s.nap_score,
+          totalMin: (s.deep_min || 0) + (s.light_min || 0) + (s.rem_min || 0),
+          segments: buildNapSegments(s.detail_json, s.start_time, s.end_time),
+        }));
+      },
+    },
+    {
+      // HealthKit workouts (7 days, iOS only — returns [] on Android). Past workouts
+      // rarely change, so a slightly stale list is served while HK is re-queried.
+      id: 'hkWorkouts',
+      deps: ['auth'],
+      ttlMs: 2 * 60 * 1000,
+      staleMs: 6 * 60 * 60 * 1000,
+      run: async get => {
+        if (!(await userIdOf(get))) return [];
+        return HealthKitService.fetchWeekWorkouts().catch(() => []);
+      },
+    },
+    {
+      // HealthKit activity metrics (iOS only — for max() blending with ring)
+      id: 'hkActivity',
+      deps: ['auth'],
+      run: async (get): Promise<HKActivityTotals> => {
+        if (Platform.OS !== 'ios' || !(await userIdOf(get))) return { steps: 0, calories: 0, distanceM: 0 };
+        const [steps, cal, dist] = await Promise.all([
+          HealthKitService.fetchSteps().catch(() => ({ steps: 0 })),
+          HealthKitService.fetchActiveCalories().catch(() => ({ calories: 0 })),
+          HealthKitService.fetchDistance().catch(() => ({ distanceM: 0 })),
+        ]);
+        const totals = { steps: steps.steps || 0, calories: cal.calories || 0, distanceM: dist.distanceM || 0 };
+        if (totals.steps > 0 || totals.calories > 0 || totals.distanceM > 0) {
+          console.log(`🍎 [useHomeData] HealthKit activity: steps=${totals.steps}, cal=${totals.calories}, dist=${totals.distanceM}m`);
+        }
+        return totals;
+      },
+    },
+    {
+      // Prior days for the strain EWMA — nothing before today changes during the day
+      id: 'priorDays',
+      deps: ['auth'],
+      ttlMs: 30 * 60 * 1000,
+      staleMs: 24 * 60 * 60 * 1000,
+      run: async (get): Promise<PriorDaySummary[]> => {
+        const userId = await userIdOf(get);
+        if (!userId) return [];
+        const sevenDaysAgo = new Date();
+        sevenDaysAgo.setDate(sevenDaysAgo.getDate() - 7);
+        const yesterday = new Date();
+        yesterday.setDate(yesterday.getDate() - 1);
+        const { data } = await supabase
+          .from('daily_summaries')
+          .select('date, total_calories, total_steps')
+          .eq('user_id', userId)
+          .gte('date', sevenDaysAgo.toISOString().slice(0, 10))
+          .lte('date', yesterday.toISOString().slice(0, 10))
+          .order('date', { ascending: false });
+        return (data as PriorDaySummary[]) ?? [];
+      },
+    },
+  ];
+}
+
+/** Cache scope for stage results: user + local day, so day-windowed queries never leak across midnight. */
+function hydrationScope(authPromise: Promise<AuthResult>): Promise<string | null> {
+  return authPromise.then(
+    r => {
+      const id = r.data?.user?.id;
+      if (!id) return null;
+      const d = new Date();
+      return `${id}:${d.getFullYear()}-${d.getMonth() + 1}-${d.getDate()}`;
+    },
+    () => null,
+  );
+}
+
 // Hook
 export function useHomeData(enabled = true): HomeData & { refresh: () => Promise<void>; applyOverrideNow: () => Promise<void> } {
   const [data, setData] = useState<HomeData>(getEmptyData);
@@ -1259,7 +1307,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
               ? Number(
                   (
                     result.vitals.temperatureC -
-                    (median(baselinesRef.current.temperature) ?? 36.5)
+                    (baselineMedian(baselinesRef.current.temperature) ?? 36.5)
                   ).toFixed(2)
                 )
               : prev.recoveryContributors.tempDeviation,
@@ -1278,7 +1326,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
                 ? Number(
                     (
                       result.vitals.temperatureC -
-                      (median(baselinesRef.current.temperature) ?? 36.5)
+                      (baselineMedian(baselinesRef.current.temperature) ?? 36.5)
                     ).toFixed(2)
                   )
                 : prev.recoveryContributors.tempDeviation,
@@ -1412,6 +1460,8 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
 
     if (isFetchingData.current) return;
     isFetchingData.current = true;
+    // Finished in `finally`, so early returns and failed runs still publish their metrics
+    let hydrationRun: ReturnType<typeof startHydration> | null = null;
     try {
       const now = Date.now();
       if (!forceRefresh && now - lastFetchTime.current < MIN_FETCH_INTERVAL) {
@@ -1419,10 +1469,17 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
       }
       lastFetchTime.current = now;
 
-      // ── Stage timing instrumentation ─────────────────────────────────────────
-      const syncStart = Date.now();
-      const logStage = (label: string, since: number) =>
-        console.log(`[sync] ${label} ${Date.now() - since}ms`);
+      // ── Hydration pipeline ───────────────────────────────────────────────────
+      // Network + HealthKit stages start now and run in parallel; BLE stages below
+      // stay serial and are timed with begin(). Timings land in one structured record.
+      const authPromise = supabase.auth.getUser();
+      const hydration = startHydration(
+        'home',
+        hydrationReason,
+        homeHydrationStages(authPromise),
+        hydrationScope(authPromise),
+      );
+      hydrationRun = hydration;
 
       // ── Sync progress tracking — starts immediately for instant header spinner ──
       // showSheet starts false; flipped to true after precheck when cold-start + disconnected.
@@ -1439,14 +1496,13 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
       setData(prev => ({ ...prev, isSyncing: true, error: null, syncProgress: sp }));
 
       // ── Pre-check: BLE status + auth ─────────────────────────────────────────
-      // Runs in parallel with the reconnect fire below. Auth may be slow on cold start
-      // (token refresh), but the header spinner is already visible above.
+      // Auth may be slow on cold start (token refresh), but the header spinner is
+      // already visible above. Reconnect has already been fired by its stage.
       const [statusResult, authResult] = await Promise.all([
-        UnifiedSmartRingService.isConnected().catch(() => ({ connected: false })),
-        supabase.auth.getUser(),
+        hydration.result<{ connected?: boolean }>('ringStatus'),
+        hydration.result<AuthResult>('auth'),
       ]);
-      logStage('precheck', syncStart);
-      const alreadyConnected = (statusResult as any).connected ?? false;
+      const alreadyConnected = statusResult.connected ?? false;
       const userName = resolveUserName(authResult.data?.user);
       const avatarUrl = resolveAvatarUrl(authResult.data?.user);
       const userId = authResult.data?.user?.id;
@@ -1457,94 +1513,22 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
         updateSP({ showSheet: true });
       }
 
-      // Fire reconnect immediately if needed (don't await yet)
-      const reconnectPromise: Promise<{ success: boolean }> = alreadyConnected
-        ? Promise.resolve({ success: true })
-        : UnifiedSmartRingService.autoReconnect();
-      if (!alreadyConnected) {
-        console.log('🔄 [useHomeData] autoReconnect...');
-      }
-
-      // Auto-sync Strava before reading from Supabase (rate-limited: once per 30 min).
-      // Awaited so the Supabase query below always sees the freshest activities.
-      // Runs in parallel with ring reconnect above — no added wall-clock time on most calls.
-      const STRAVA_SYNC_INTERVAL_MS = 10 * 60 * 1000;
-      try {
-        const lastSyncRaw = await AsyncStorage.getItem('strava_last_auto_sync_v1');
-        if (!lastSyncRaw || Date.now() - Number(lastSyncRaw) > STRAVA_SYNC_INTERVAL_MS) {
-          const r = await stravaService.backgroundSync(3).catch(() => null);
-          if (r !== null) {
-            await AsyncStorage.setItem('strava_last_auto_sync_v1', String(Date.now()));
-            console.log(`🏃 [useHomeData] Auto Strava sync: ${r.count} new activities`);
-          }
-        }
-      } catch {}
-
-      // Fetch Strava + naps + HealthKit workouts + HK activity metrics in parallel while ring connects
-      let stravaActivities: StravaActivitySummary[] = [];
-      let todayNaps: HomeData['todayNaps'] = [];
-      let hkWorkouts: import('../types/activity.types').HKWorkoutResult[] = [];
-      let hkSteps = 0;
-      let hkActiveCalories = 0;
-      let hkDistanceM = 0;
-      if (userId) {
-        const sevenDaysAgo = new Date();
-        sevenDaysAgo.setDate(sevenDaysAgo.getDate() - 7);
-        const todayStart = new Date();
-        todayStart.setHours(0, 0, 0, 0); // local midnight
-        const todayEnd = new Date(todayStart);
-        todayEnd.setDate(todayEnd.getDate() + 1);
-
-        const [stravaResult, napResult, hkWorkoutResult, hkStepsResult, hkCalResult, hkDistResult] = await Promise.all([
-          supabase
-            .from('strava_activities')
-            .select('id, name, sport_type, start_date, distance_m, moving_time_sec, average_heartrate, max_heartrate, suffer_score, calories, splits_metric_json, zones_json')
-            .eq('user_id', userId)
-            .gte('start_date', sevenDaysAgo.toISOString())
-            .order('start_date', { ascending: false }),
-          supabase
-            .from('sleep_sessions')
-            .select('id, start_time, end_time, deep_min, light_min, rem_min, awake_min, nap_score, detail_json')
-            .eq('user_id', userId)
-            .eq('session_type', 'nap')
-            .gte('start_time', todayStart.toISOString())
-            .lte('start_time', todayEnd.toISOString())
-            .order('start_time', { ascending: true }),
-          // HealthKit workouts (7 days, iOS only — returns [] on Android)
-          HealthKitService.fetchWeekWorkouts().catch(() => []),
-          // HealthKit activity metrics (iOS only — for max() blending with ring)
-          Platform.OS === 'ios' ? HealthKitService.fetchSteps().catch(() => ({ steps: 0, samples: [], source: 'error' })) : { steps: 0, samples: [], source: 'skip' },
-          Platform.OS === 'ios' ? HealthKitService.fetchActiveCalories().catch(() => ({ calories: 0, source: 'error' })) : { calories: 0, source: 'skip' },
-          Platform.OS === 'ios' ? HealthKitService.fetchDistance().catch(() => ({ distanceM: 0, source: 'error' })) : { distanceM: 0, source: 'skip' },
-        ]);
-        stravaActivities = (stravaResult.data as unknown as StravaActivitySummary[]) ?? [];
-        hkWorkouts = hkWorkoutResult;
-        hkSteps = (hkStepsResult as any).steps || 0;
-        hkActiveCalories = (hkCalResult as any).calories || 0;
-        hkDistanceM = (hkDistResult as any).distanceM || 0;
-        if (hkSteps > 0 || hkActiveCalories > 0 || hkDistanceM > 0) {
-          console.log(`🍎 [useHomeData] HealthKit activity: steps=${hkSteps}, cal=${hkActiveCalories}, dist=${hkDistanceM}m`);
-        }
-        todayNaps = ((napResult.data as any[]) ?? []).map(s => ({
-          id: s.id,
-          startTime: s.start_time,
-          endTime: s.end_time,
-          deepMin: s.deep_min || 0,
-          lightMin: s.light_min || 0,
-          remMin: s.rem_min || 0,
-          awakeMin: s.awake_min || 0,
-          napScore: s.nap_score,
-          totalMin: (s.deep_min || 0) + (s.light_min || 0) + (s.rem_min || 0),
-          segments: buildNapSegments(s.detail_json, s.start_time, s.end_time),
-        }));
-      }
+      // Strava + naps + HealthKit land whenever they land; the ring path only needs
+      // them when building the final state, so BLE reads no longer wait on them.
+      const sideStages = Promise.all([
+        hydration.result<StravaActivitySummary[]>('stravaActivities').catch((): StravaActivitySummary[] => []),
+        hydration.result<HomeData['todayNaps']>('naps').catch((): HomeData['todayNaps'] => []),
+        hydration.result<import('../types/activity.types').HKWorkoutResult[]>('hkWorkouts').catch(() => []),
+        hydration.result<HKActivityTotals>('hkActivity').catch(() => ({ steps: 0, calories: 0, distanceM: 0 })),
+      ]);
 
-      // Await reconnect (likely already done since Strava fetch ran concurrently)
-      const reconnectStart = Date.now();
-      const reconnectResult = await reconnectPromise;
-      if (!alreadyConnected) logStage('autoReconnect', reconnectStart);
+      const reconnectResult = await hydration.result<{ success: boolean }>('reconnect')
+        .catch(() => ({ success: false }));
       if (!alreadyConnected) {
         if (!reconnectResult.success) {
+          const [stravaActivities, , hkWorkouts, hkTotals] = await sideStages;
+          const hkActiveCalories = hkTotals.calories;
+          const hkDistanceM = hkTotals.distanceM;
           // ── HealthKit fallback when ring is not connected ──
           if (Platform.OS === 'ios') {
             try {
@@ -1605,6 +1589,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
                     hr: hkFbHR?.heartRate,
                     hrv: hkFbHRV?.sdnn,
                   });
+                  hydration.mark('firstScore');
                   return;
                 }
               }
@@ -1632,7 +1617,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
       let finalSleepData: SleepData | null = null;
       let ringNaps: RingNapBlock[] = [];
 
-      const sleepStart = Date.now();
+      const endSleep = hydration.begin('sleep');
       updateSP(prev => updateMetric(prev, 'sleep', 'loading'));
       for (let attempt = 1; attempt <= 3 && !finalSleepData; attempt++) {
         try {
@@ -1707,9 +1692,69 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
       }
 
       updateSP(prev => updateMetric(prev, 'sleep', finalSleepData ? 'done' : 'error'));
-      logStage('sleep', sleepStart);
+      endSleep();
 
-      if (finalSleepData) hasLoadedRealData.current = true;
+      // Apply manual sleep time override + fill gap with estimated stages
+      try {
+        const override = await getSleepOverride();
+        sleepSegmenter.setOverride(override && overrideWindow(override));
+        if (override && finalSleepData) {
+          const correctedBed = new Date(override.bedTime);
+          const correctedWake = new Date(override.wakeTime);
+          const firstSeg = finalSleepData.segments[0];
+          const gapMinutes = firstSeg
+            ? Math.round((firstSeg.startTime.getTime() - correctedBed.getTime()) / 60000)
+            : 0;
+
+          if (gapMinutes >= 10 && firstSeg) {
+            const inferred = fillSleepGap(correctedBed, firstSeg.startTime);
+            const newSegs  = [...inferred, ...finalSleepData.segments];
+            const newTotal = finalSleepData.timeAsleepMinutes + gapMinutes;
+            const newScore = scoreFromSegments(newSegs);
+            finalSleepData = {
+              ...finalSleepData,
+              segments:          newSegs,
+              score:             newScore,
+              bedTime:           correctedBed,
+              wakeTime:          correctedWake,
+              inBedTime:         correctedBed,
+              timeAsleepMinutes: newTotal,
+              timeAsleep:        formatSleepDuration(newTotal),
+            };
+            if (userId) {
+              void pushSleepOverrideToSupabase({ userId, correctedBed, correctedWake, newSegs, newScore });
+            }
+          } else {
+            finalSleepData = {
+              ...finalSleepData,
+              bedTime:   correctedBed,
+              wakeTime:  correctedWake,
+              inBedTime: correctedBed,
+            };
+          }
+        }
+      } catch (e: any) {
+        console.warn('[useHomeData] Failed to apply sleep override:', e?.message);
+      }
+
+      // Publish the night as soon as it's known — HR/HRV/steps keep streaming in
+      // behind it, and the final state below replaces this partial one.
+      if (finalSleepData) {
+        hasLoadedRealData.current = true;
+        const night = finalSleepData;
+        hydration.mark('firstScore');
+        setData(prev => ({
+          ...prev,
+          sleepScore: night.score,
+          lastNightSleep: {
+            ...night,
+            restingHR: night.restingHR || prev.lastNightSleep.restingHR,
+            respiratoryRate: night.respiratoryRate || prev.lastNightSleep.respiratoryRate,
+          },
+          isLoading: false,
+          isRingConnected: true,
+        }));
+      }
 
       // 3. Battery — deferred (fetch completes after main setData to avoid 5s timeout on critical path)
 
@@ -1717,7 +1762,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
       let restingHR = 0;
       let hrDataIsToday = false;
       const hrChartData: Array<{ timeMinutes: number; heartRate: number }> = [];
-      const hrStart = Date.now();
+      const endHeartRate = hydration.begin('heartRate');
       updateSP(prev => updateMetric(prev, 'heartRate', 'loading'));
       try {
       // Fetch continuous HR and single HR; use allSettled so a BLE disconnect during
@@ -1758,15 +1803,6 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
         return getRecordDateStr(rec) === targetDateStr;
       };
 
-      const parseX3DateToMinutes = (value?: string): number | undefined => {
-        if (!value || typeof value !== 'string') return undefined;
-        const [datePart, timePart] = value.trim().split(/\s+/);
-        if (!datePart) return undefined;
-        const [y, m, d] = datePart.split('.').map(Number);
-        const [hh, mm, ss] = (timePart || '00:00:00').split(':').map(Number);
-        if ([y, m, d, hh, mm, ss].some((n) => Number.isNaN(n))) return undefined;
-        return hh * 60 + mm;
-      };
       const tsToMinutes = (ts: number): number => {
         if (ts > 1e10) {
           const d = new Date(ts);
@@ -1780,7 +1816,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
           ? rec.arrayDynamicHR.map((v: any) => Number(v)).filter((v: number) => Number.isFinite(v))
           : [];
         const ts = rec.startTimestamp;
-        const startMin = typeof ts === 'number' ? tsToMinutes(ts) : (parseX3DateToMinutes(rec.date) ?? 0);
+        const startMin = typeof ts === 'number' ? tsToMinutes(ts) : (ringDateMinutes(rec.date) ?? 0);
         arr.forEach((v: number, idx: number) => {
           if (v > 0) {
             samples.push(v);
@@ -1794,7 +1830,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
             const segVals = Array.isArray(seg?.arrayHR)
               ? seg.arrayHR.map((v: any) => Number(v)).filter((v: number) => Number.isFinite(v))
               : [];
-            const segStart = parseX3DateToMinutes(seg?.date) ?? startMin;
+            const segStart = ringDateMinutes(seg?.date) ?? startMin;
             segVals.forEach((v: number, idx: number) => {
               if (v > 0) {
                 samples.push(v);
@@ -1812,7 +1848,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
             ? rec.arrayDynamicHR.map((v: any) => Number(v)).filter((v: number) => Number.isFinite(v))
             : [];
           const ts = rec.startTimestamp;
-          const startMin = typeof ts === 'number' ? tsToMinutes(ts) : (parseX3DateToMinutes(rec.date) ?? 0);
+          const startMin = typeof ts === 'number' ? tsToMinutes(ts) : (ringDateMinutes(rec.date) ?? 0);
           arr.forEach((v: number, idx: number) => {
             const minute = startMin + idx;
             if (v > 0 && !coveredMinutes.has(minute)) {
@@ -1866,12 +1902,12 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
         console.log('⚠️ [useHomeData] HR failed:', e);
         updateSP(prev => updateMetric(prev, 'heartRate', 'error'));
       }
-      logStage('heartRate', hrStart);
+      endHeartRate();
 
       // 5. HRV (testing.tsx pattern)
       let hrvSdnn = 0;
       const hrvHrPoints: Array<{ timeMinutes: number; heartRate: number }> = [];
-      const hrvStart = Date.now();
+      const endHrv = hydration.begin('hrv');
       updateSP(prev => updateMetric(prev, 'hrv', 'loading'));
       try {
       const hrvNorm = await UnifiedSmartRingService.getHRVDataNormalizedArray();
@@ -1910,7 +1946,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
         console.log('⚠️ [useHomeData] HRV failed:', e);
         updateSP(prev => updateMetric(prev, 'hrv', 'error'));
       }
-      logStage('hrv', hrvStart);
+      endHrv();
 
       if (restingHR === 0 && hrvHrPoints.length > 0) {
         // Use 10th percentile instead of absolute min to avoid outliers
@@ -1922,7 +1958,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
 
       // 6. Steps
       let activity: ActivityData = sanitizeActivity();
-      const stepsStart = Date.now();
+      const endSteps = hydration.begin('steps+sport');
       updateSP(prev => updateMetric(prev, 'steps', 'loading'));
       try {
       const stepsData = await UnifiedSmartRingService.getSteps();
@@ -1941,6 +1977,10 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
         updateSP(prev => updateMetric(prev, 'steps', 'error'));
       }
 
+      // Side stages have had the whole BLE chain to finish — normally this doesn't wait
+      const [stravaActivities, todayNaps, hkWorkouts, hkTotals] = await sideStages;
+      const { steps: hkSteps, calories: hkActiveCalories, distanceM: hkDistanceM } = hkTotals;
+
       // Blend HealthKit activity metrics using max(ring, healthKit)
       if (Platform.OS === 'ios' && (hkSteps > 0 || hkActiveCalories > 0 || hkDistanceM > 0)) {
         const blendedSteps = Math.max(activity.steps, hkSteps);
@@ -1958,6 +1998,10 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
         }
       }
 
+      // Progressive publish: steps/calories card fills before sport sessions + cloud reads
+      const blendedActivity = activity;
+      setData(prev => ({ ...prev, activity: blendedActivity }));
+
       const featureAvailability = UnifiedSmartRingService.getFeatureAvailability();
 
       let activitySessions: X3ActivitySession[] = [];
@@ -1981,7 +2025,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
       } catch (e) {
         console.log('⚠️ [useHomeData] sport sessions failed:', e);
       }
-      logStage('steps+sport', stepsStart);
+      endSteps();
 
       // Build final state
       if (restingHR === 0 && finalSleepData?.restingHR && finalSleepData.restingHR > 0) {
@@ -1990,48 +2034,6 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
       }
       if (finalSleepData && restingHR > 0) finalSleepData.restingHR = restingHR;
 
-      // Apply manual sleep time override + fill gap with estimated stages
-      try {
-        const override = await getSleepOverride();
-        if (override && finalSleepData) {
-          const correctedBed = new Date(override.bedTime);
-          const correctedWake = new Date(override.wakeTime);
-          const firstSeg = finalSleepData.segments[0];
-          const gapMinutes = firstSeg
-            ? Math.round((firstSeg.startTime.getTime() - correctedBed.getTime()) / 60000)
-            : 0;
-
-          if (gapMinutes >= 10 && firstSeg) {
-            const inferred = fillSleepGap(correctedBed, firstSeg.startTime);
-            const newSegs  = [...inferred, ...finalSleepData.segments];
-            const newTotal = finalSleepData.timeAsleepMinutes + gapMinutes;
-            const newScore = scoreFromSegments(newSegs);
-            finalSleepData = {
-              ...finalSleepData,
-              segments:          newSegs,
-              score:             newScore,
-              bedTime:           correctedBed,
-              wakeTime:          correctedWake,
-              inBedTime:         correctedBed,
-              timeAsleepMinutes: newTotal,
-              timeAsleep:        formatSleepDuration(newTotal),
-            };
-            if (userId) {
-              void pushSleepOverrideToSupabase({ userId, correctedBed, correctedWake, newSegs, newScore });
-            }
-          } else {
-            finalSleepData = {
-              ...finalSleepData,
-              bedTime:   correctedBed,
-              wakeTime:  correctedWake,
-              inBedTime: correctedBed,
-            };
-          }
-        }
-      } catch (e: any) {
-        console.warn('[useHomeData] Failed to apply sleep override:', e?.message);
-      }
-
       const sleep: SleepData = finalSleepData || {
         score: 0, timeAsleep: '0h 0m', timeAsleepMinutes: 0,
         restingHR, respiratoryRate: 0, segments: [], bedTime: new Date(), wakeTime: new Date(),
@@ -2059,38 +2061,32 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
 
       const todayIso = new Date().toISOString().slice(0, 10);
       const todayStravaSuffer = stravaSufferByDate.get(todayIso) ?? null;
+
+      // Prior days from daily_summaries (hydration stage, cached per user/day).
+      const priorDaysSummaries = await hydration.result<PriorDaySummary[]>('priorDays').catch(e => {
+        console.log('⚠️ [useHomeData] prior days fetch failed, using today-only strain:', e);
+        return [] as PriorDaySummary[];
+      });
+
+      // Intensity minutes from already-ingested ring minutes (storage only, no BLE here)
+      const todayKey = localDateKey(new Date());
+      const activityRollups = await UnifiedSmartRingService.activityDetail
+        .getDays([todayKey, ...priorDaysSummaries.map(row => row.date)])
+        .catch(() => new Map<string, DayActivityRollup>());
+
       const todayLoad = computeDailyLoad(
         activity.adjustedActiveCalories,
         activity.steps,
         todayStravaSuffer,
+        activityRollups.get(todayKey),
       );
 
-      // Fetch prior days from daily_summaries (userId already in scope from auth call above).
-      let priorDaysSummaries: Array<{ date: string; total_calories: number; total_steps: number }> = [];
-      try {
-        if (userId) {
-          const sevenDaysAgo = new Date();
-          sevenDaysAgo.setDate(sevenDaysAgo.getDate() - 7);
-          const yesterday = new Date();
-          yesterday.setDate(yesterday.getDate() - 1);
-          const { data: priorData } = await supabase
-            .from('daily_summaries')
-            .select('date, total_calories, total_steps')
-            .eq('user_id', userId)
-            .gte('date', sevenDaysAgo.toISOString().slice(0, 10))
-            .lte('date', yesterday.toISOString().slice(0, 10))
-            .order('date', { ascending: false });
-          if (priorData) priorDaysSummaries = priorData as any;
-        }
-      } catch (e) {
-        console.log('⚠️ [useHomeData] prior days fetch failed, using today-only strain:', e);
-      }
-
       const priorLoads = priorDaysSummaries.map(row =>
         computeDailyLoad(
           row.total_calories || 0,
           row.total_steps || 0,
           stravaSufferByDate.get(row.date) ?? null,
+          activityRollups.get(row.date),
         )
       );
 
@@ -2223,7 +2219,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
               ? Number(
                   (
                     restingHR -
-                    (median(baselinesRef.current.restingHR) ?? 60)
+                    (baselineMedian(baselinesRef.current.restingHR) ?? 60)
                   ).toFixed(1)
                 )
               : null,
@@ -2232,7 +2228,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
               ? Number(
                   (
                     prev.todayVitals.temperatureC -
-                    (median(baselinesRef.current.temperature) ?? 36.5)
+                    (baselineMedian(baselinesRef.current.temperature) ?? 36.5)
                   ).toFixed(2)
                 )
               : null,
@@ -2318,7 +2314,6 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
         void saveMetricBaselines(baselinesRef.current);
 
         lastSyncCompletedAt.current = Date.now();
-        logStage('TOTAL', syncStart);
         console.log('📊 [useHomeData] setData →', { sleepScore: newData.sleepScore, overallScore: newData.overallScore, steps: newData.activity.steps, battery: newData.ringBattery, hrPts: finalHrChartData.length });
         saveToCache(newData);
         // Push all ring data (7 days of sleep + vitals) to Supabase in the background
@@ -2372,6 +2367,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
       });
       void refreshMissingCardData(hydrationReason);
     } catch (error: any) {
+      hydrationRun?.mark('failed');
       const message = error?.message || 'Failed to sync ring data.';
       console.log('⚠️ [useHomeData] fetchData fatal error:', message);
       reportError(error, { op: 'homeData.fetchData' });
@@ -2383,6 +2379,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
         syncProgress: { ...prev.syncProgress, phase: 'idle' },
       }));
     } finally {
+      hydrationRun?.finish();
       isFetchingData.current = false;
     }
   }, [refreshMissingCardData]);
@@ -2488,6 +2485,7 @@ export function useHomeData(enabled = true): HomeData & { refresh: () => Promise
   // Call this right after setSleepOverride() for immediate hypnogram update.
   const applyOverrideNow = useCallback(async () => {
     const override = await getSleepOverride();
+    sleepSegmenter.setOverride(override && overrideWindow(override));
     if (!override) return;
 
     const cur            = dataRef.current.lastNightSleep;
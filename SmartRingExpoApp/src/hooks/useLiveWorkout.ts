@@ -0,0 +1,17 @@
+import { useEffect, useState } from 'react';
+import UnifiedSmartRingService from '../services/UnifiedSmartRingService';
+import type { WorkoutSnapshot } from '../services/WorkoutSession';
+
+/**
+ * Live workout snapshot (HR, zone, steps, calories, zone seconds). Updates at most
+ * as often as WorkoutSession emits (one per sample, bursts coalesced). The controls
+ * are on UnifiedSmartRingService.workout: start / pause / resume / stop.
+ */
+export function useLiveWorkout(): WorkoutSnapshot {
+  const workout = UnifiedSmartRingService.workout;
+  const [snapshot, setSnapshot] = useState<WorkoutSnapshot>(() => workout.snapshot());
+
+  useEffect(() => workout.subscribe(setSnapshot), [workout]);
+
+  return snapshot;
+}
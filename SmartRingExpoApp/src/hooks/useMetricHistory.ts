@@ -5,7 +5,8 @@
  * 'YYYY-MM-DD' date key, and returns a Map for instant day switching on detail screens.
  *
  * Strategy:
- * 1. Fetch from Supabase (fast, no BLE)
+ * 1. Read rows through DeltaSyncService (local per-day cache + updated_at cursor,
+ *    so a re-mount only pulls rows changed since the last read)
  * 2. If empty (first launch / no sync yet), fall back to SDK call + bucket by timestamp
  * 3. Cache in useRef for the screen's lifetime (no re-fetch on re-render)
  */
@@ -13,6 +14,7 @@
 import { useEffect, useRef, useState } from 'react';
 import i18next from 'i18next';
 import { supabase } from '../services/SupabaseService';
+import { getRowsSince } from '../services/DeltaSyncService';
 import { reportError } from '../utils/sentry';
 import UnifiedSmartRingService from '../services/UnifiedSmartRingService';
 import { calculateSleepScore } from '../utils/ringData/sleep';
@@ -213,14 +215,10 @@ function parseSegmentsFromJson(
 async function fetchSleepHistory(userId: string, days = 30): Promise<Map<string, DaySleepData>> {
   // Extend by 1 day so we catch sessions that started the night before the window
   const since = nDaysAgo(days + 1);
-  const { data, error } = await supabase
-    .from('sleep_sessions')
-    .select('*')
-    .eq('user_id', userId)
-    .eq('session_type', 'night')
-    .gte('start_time', since.toISOString())
-    .order('start_time', { ascending: false });
-  if (error || !data || data.length === 0) return new Map();
+  const data = (await getRowsSince(userId, 'sleep_sessions', since))
+    .filter(r => r.session_type === 'night')
+    .reverse(); // most recent first
+  if (data.length === 0) return new Map();
 
   const map = new Map<string, DaySleepData>();
   for (const row of data) {
@@ -281,23 +279,18 @@ async function fetchSleepHistory(userId: string, days = 30): Promise<Map<string,
     const earliest = new Date(Math.min(...data.map(r => new Date(r.start_time).getTime())));
     const latest   = new Date(Math.max(...data.map(r => new Date(r.end_time).getTime())));
 
-    const [hrResp, tempResp] = await Promise.all([
-      supabase.from('heart_rate_readings')
-        .select('heart_rate, recorded_at')
-        .eq('user_id', userId)
-        .gte('recorded_at', earliest.toISOString())
-        .lte('recorded_at', latest.toISOString())
-        .order('recorded_at', { ascending: true }),
-      supabase.from('temperature_readings')
-        .select('temperature_c, recorded_at')
-        .eq('user_id', userId)
-        .gte('recorded_at', earliest.toISOString())
-        .lte('recorded_at', latest.toISOString())
-        .order('recorded_at', { ascending: true }),
+    const [hrRows, tempRows] = await Promise.all([
+      getRowsSince(userId, 'heart_rate_readings', earliest),
+      getRowsSince(userId, 'temperature_readings', earliest),
     ]);
 
-    const allHR   = (hrResp.data ?? []).map(r => ({ timeMs: new Date(r.recorded_at).getTime(), heartRate: r.heart_rate }));
-    const allTemp = (tempResp.data ?? []).map(r => ({ timeMs: new Date(r.recorded_at).getTime(), temperature: r.temperature_c }));
+    const latestMs = latest.getTime();
+    const allHR = hrRows
+      .map(r => ({ timeMs: new Date(r.recorded_at).getTime(), heartRate: r.heart_rate as number }))
+      .filter(s => s.timeMs <= latestMs);
+    const allTemp = tempRows
+      .map(r => ({ timeMs: new Date(r.recorded_at).getTime(), temperature: r.temperature_c as number }))
+      .filter(s => s.timeMs <= latestMs);
 
     for (const [, day] of map) {
       if (!day.bedTime || !day.wakeTime) continue;
@@ -315,14 +308,8 @@ async function fetchSleepHistory(userId: string, days = 30): Promise<Map<string,
 
 async function fetchHRHistory(userId: string, days: number = 7): Promise<Map<string, DayHRData>> {
   const since = nDaysAgo(days);
-  const { data, error } = await supabase
-    .from('heart_rate_readings')
-    .select('heart_rate, recorded_at')
-    .eq('user_id', userId)
-    .gte('recorded_at', since.toISOString())
-    .order('recorded_at', { ascending: true });
-
-  if (error || !data || data.length === 0) return new Map();
+  const data = await getRowsSince(userId, 'heart_rate_readings', since);
+  if (data.length === 0) return new Map();
 
   // Group by date
   const byDate = new Map<string, Array<{ hour: number; minute: number; heartRate: number; val: number }>>();
@@ -356,14 +343,9 @@ async function fetchHRHistory(userId: string, days: number = 7): Promise<Map<str
 
 async function fetchHRVHistory(userId: string, days: number = 7): Promise<Map<string, DayHRVData>> {
   const since = nDaysAgo(days);
-  const { data, error } = await supabase
-    .from('hrv_readings')
-    .select('sdnn, rmssd, pnn50, lf, hf, lf_hf_ratio, recorded_at')
-    .eq('user_id', userId)
-    .gte('recorded_at', since.toISOString())
-    .order('recorded_at', { ascending: false }); // most recent first, take last per day
-
-  if (error || !data || data.length === 0) return new Map();
+  // most recent first, take last per day
+  const data = (await getRowsSince(userId, 'hrv_readings', since)).reverse();
+  if (data.length === 0) return new Map();
 
   const map = new Map<string, DayHRVData>();
   for (const row of data) {
@@ -389,14 +371,8 @@ async function fetchHRVHistory(userId: string, days: number = 7): Promise<Map<st
 
 async function fetchSpO2History(userId: string, days = 7): Promise<Map<string, DaySpO2Data>> {
   const since = nDaysAgo(days);
-  const { data, error } = await supabase
-    .from('spo2_readings')
-    .select('spo2, recorded_at')
-    .eq('user_id', userId)
-    .gte('recorded_at', since.toISOString())
-    .order('recorded_at', { ascending: true });
-
-  if (error || !data || data.length === 0) return new Map();
+  const data = await getRowsSince(userId, 'spo2_readings', since);
+  if (data.length === 0) return new Map();
 
   const byDate = new Map<string, Array<{ value: number; recordedAt: Date }>>();
   for (const row of data) {
@@ -421,14 +397,8 @@ async function fetchSpO2History(userId: string, days = 7): Promise<Map<string, D
 
 async function fetchTemperatureHistory(userId: string): Promise<Map<string, DayTemperatureData>> {
   const since = nDaysAgo(7);
-  const { data, error } = await supabase
-    .from('temperature_readings')
-    .select('temperature_c, recorded_at')
-    .eq('user_id', userId)
-    .gte('recorded_at', since.toISOString())
-    .order('recorded_at', { ascending: true });
-
-  if (error || !data || data.length === 0) return new Map();
+  const data = await getRowsSince(userId, 'temperature_readings', since);
+  if (data.length === 0) return new Map();
 
   const byDate = new Map<string, Array<{ value: number; recordedAt: Date }>>();
   for (const row of data) {
@@ -453,14 +423,8 @@ async function fetchTemperatureHistory(userId: string): Promise<Map<string, DayT
 
 async function fetchActivityHistory(userId: string, days: number = 7): Promise<Map<string, DayActivityData>> {
   const since = nDaysAgo(days);
-  const { data, error } = await supabase
-    .from('daily_summaries')
-    .select('date, total_steps, total_distance_m, total_calories, sleep_total_min, hr_avg, hr_min')
-    .eq('user_id', userId)
-    .gte('date', toDateStr(since))
-    .order('date', { ascending: false });
-
-  if (error || !data || data.length === 0) return new Map();
+  const data = (await getRowsSince(userId, 'daily_summaries', since)).reverse();
+  if (data.length === 0) return new Map();
 
   const map = new Map<string, DayActivityData>();
   for (const row of data) {
@@ -481,15 +445,10 @@ async function fetchActivityHistory(userId: string, days: number = 7): Promise<M
 
 async function fetchReadinessHistory(userId: string, days: number = 30): Promise<Map<string, DayReadinessData>> {
   const since = nDaysAgo(days);
-  const { data, error } = await supabase
-    .from('daily_summaries')
-    .select('date, readiness_score, readiness_sleep_score, readiness_hr_score, readiness_strain_score, readiness_resting_hr')
-    .eq('user_id', userId)
-    .gte('date', toDateStr(since))
-    .not('readiness_score', 'is', null)
-    .order('date', { ascending: false });
-
-  if (error || !data || data.length === 0) return new Map();
+  const data = (await getRowsSince(userId, 'daily_summaries', since))
+    .filter(r => r.readiness_score != null)
+    .reverse();
+  if (data.length === 0) return new Map();
 
   const map = new Map<string, DayReadinessData>();
   for (const row of data) {
@@ -757,7 +716,8 @@ export function useMetricHistory<T>(
         setIsLoading(false);
         // If cache is partial (previous phase 1 only), extend silently in background
         if (!cacheIsCompleteRef.current && (type === 'sleep' || type === 'hrv') && fullDays > initialDays) {
-          const { data: { user } } = await supabase.auth.getUser();
+          const { data: { session } } = await supabase.auth.getSession();
+          const user = session?.user;
           if (user && !cancelled) {
             const full = type === 'sleep'
               ? await fetchSleepHistory(user.id, fullDays)
@@ -778,7 +738,9 @@ export function useMetricHistory<T>(
       setError(null);
 
       try {
-        const { data: { user } } = await supabase.auth.getUser();
+        // getSession() reads the persisted session — no auth round-trip per mount
+        const { data: { session } } = await supabase.auth.getSession();
+        const user = session?.user;
         if (!user) throw new Error('Not authenticated');
 
         // ── Two-phase progressive load (sleep + HRV) ─────────────────────────
@@ -1,5 +1,5 @@
 import { useEffect, useState } from 'react';
-import { useHomeDataContext } from '../context/HomeDataContext';
+import { useHomeDataFields } from '../context/HomeDataContext';
 import { useFocusDataContext } from '../context/FocusDataContext';
 import { useSleepDebt } from './useSleepDebt';
 import { useCaffeineTimeline } from './useCaffeineTimeline';
@@ -7,7 +7,7 @@ import { resolveGaugePhase } from '../utils/overviewGaugePhase';
 import type { GaugePhase } from '../utils/overviewGaugePhase';
 
 export function useOverviewGaugePhase(): GaugePhase {
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('lastNightSleep', 'readiness', 'sleepScore', 'strain');
   const focusData = useFocusDataContext();
   const { sleepDebt } = useSleepDebt();
   const { currentMg } = useCaffeineTimeline();
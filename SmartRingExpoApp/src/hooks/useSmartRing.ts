@@ -289,7 +289,7 @@ export const useSmartRing = (): UseSmartRingReturn => {
     // Listen for real-time heart rate (from setStartSingleHR / receiveHeartRate delegate)
     const unsubHeartRate = UnifiedSmartRingService.onHeartRateReceived((data) => {
       if (data.heartRate > 0) {
-        setMetrics(prev => ({ ...prev, heartRate: data.heartRate }));
+        setMetrics(prev => (prev.heartRate === data.heartRate ? prev : { ...prev, heartRate: data.heartRate }));
       }
     });
 
@@ -301,13 +301,13 @@ export const useSmartRing = (): UseSmartRingReturn => {
     });
 
     // Listen for real-time steps (from receiveSteps delegate)
+    // Bail out on unchanged values so a repeated frame doesn't re-render every consumer
     const unsubSteps = UnifiedSmartRingService.onStepsReceived((data) => {
-      setMetrics(prev => ({
-        ...prev,
-        steps: data.steps,
-        calories: data.calories,
-        distance: data.distance,
-      }));
+      setMetrics(prev => (
+        prev.steps === data.steps && prev.calories === data.calories && prev.distance === data.distance
+          ? prev
+          : { ...prev, steps: data.steps, calories: data.calories, distance: data.distance }
+      ));
     });
 
     return () => {
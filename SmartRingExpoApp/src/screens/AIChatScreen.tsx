@@ -34,7 +34,7 @@ import * as Haptics from 'expo-haptics';
 
 import { supabase } from '../services/SupabaseService';
 import { stravaService } from '../services/StravaService';
-import { useHomeDataContext } from '../context/HomeDataContext';
+import { useHomeDataContext, useHomeDataFields } from '../context/HomeDataContext';
 import { useFocusDataContext } from '../context/FocusDataContext';
 import { useSleepDebt } from '../hooks/useSleepDebt';
 import type { HomeData } from '../hooks/useHomeData';
@@ -712,7 +712,11 @@ export function AIChatScreen() {
   const { q, mode: modeParam, activityId: activityIdParam } = useLocalSearchParams<{ q?: string; mode?: string; activityId?: string }>();
   const coachMode: CoachMode = modeParam === 'analyst' ? 'analyst' : 'coach';
   const activityId = activityIdParam ? parseInt(activityIdParam, 10) : undefined;
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields(
+    'activity', 'activitySessions', 'lastNightSleep', 'readiness', 'sleepScore', 'strain',
+    'stravaActivities', 'todayNaps', 'totalNapMinutesToday', 'unifiedActivities',
+    'unifiedSleepSessions',
+  );
   const focusState = useFocusDataContext();
   const { sleepDebt } = useSleepDebt();
   const [messages, setMessages] = useState<Message[]>([]);
@@ -18,7 +18,8 @@ import { HomeHeader } from '../components/home/HomeHeader';
 import { AnimatedGradientBackground } from '../components/home/AnimatedGradientBackground';
 import { OverviewTab, SleepTab, ActivityTab } from './home';
 import { TabType } from '../theme/gradients';
-import { useHomeDataContext } from '../context/HomeDataContext';
+import { useHomeDataFields, useHomeDataSelector } from '../context/HomeDataContext';
+import { countRender } from '../utils/renderCounts';
 import { useSmartRing } from '../hooks/useSmartRing';
 import { spacing, fontFamily } from '../theme/colors';
 import { OverviewIcon, SleepIcon, ActivityIcon } from '../assets/icons';
@@ -38,7 +39,20 @@ const ICON_STROKE_WIDTH = 1.5;
 // Map tab index to TabType
 const tabIndexMap: TabType[] = ['overview', 'sleep', 'activity'];
 
+// Subscribes to sync progress on its own so per-metric ticks don't re-render the screen
+function HomeSyncStatusSheet({ isSyncing }: { isSyncing: boolean }) {
+  const syncProgress = useHomeDataSelector(data => data.syncProgress);
+  return (
+    <SyncStatusSheet
+      syncProgress={syncProgress}
+      isSyncing={isSyncing}
+      onFindRings={() => router.push('/(onboarding)/connect')}
+    />
+  );
+}
+
 function NewHomeScreenContent() {
+  if (__DEV__) countRender('NewHomeScreen');
   const insets = useSafeAreaInsets();
   const { t } = useTranslation();
 
@@ -52,7 +66,11 @@ function NewHomeScreenContent() {
   const headerAnim = useRef(new Animated.Value(0)).current;
   const borderAnim = useRef(new Animated.Value(0)).current;
   const wasFullyCollapsed = useRef(false);
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields(
+    'avatarUrl', 'isRingCharging', 'isRingConnected', 'isSyncing', 'lastNightSleep', 'lastSyncedAt',
+    'refresh', 'ringBattery', 'sleepScore', 'streakDays', 'userName',
+  );
+  const syncPhase = useHomeDataSelector(data => data.syncProgress?.phase);
   const scrollViewRef = useRef<ScrollView>(null);
   const { autoConnect, isAutoConnecting, connectedDevice } = useSmartRing();
   const [isReconnecting, setIsReconnecting] = useState(false);
@@ -217,14 +235,14 @@ function NewHomeScreenContent() {
 
   // Schedule "Sleep Analysis Ready" notification for wakeTime + 30 min (foreground fallback)
   useEffect(() => {
-    const phase = homeData.syncProgress?.phase;
+    const phase = syncPhase;
     if (phase === 'complete' && prevSyncPhaseRef.current !== 'complete') {
       if (homeData.sleepScore && homeData.sleepScore > 0 && homeData.lastNightSleep?.wakeTime) {
         maybeSendSleepNotificationFromForeground(homeData.lastNightSleep.wakeTime).catch(e => { reportError(e, { op: 'homeScreen.sleepNotification' }, 'warning'); });
       }
     }
     if (phase) prevSyncPhaseRef.current = phase;
-  }, [homeData.syncProgress?.phase, homeData.sleepScore]);
+  }, [syncPhase, homeData.sleepScore]);
 
   const iconScale = 1;
   const iconOpacity = headerAnim.interpolate({
@@ -393,11 +411,7 @@ function NewHomeScreenContent() {
         </Animated.View>
       </View>
 
-      <SyncStatusSheet
-        syncProgress={homeData.syncProgress}
-        isSyncing={homeData.isSyncing}
-        onFindRings={() => router.push('/(onboarding)/connect')}
-      />
+      <HomeSyncStatusSheet isSyncing={homeData.isSyncing} />
       <BaselineCompleteOverlay />
       <DeviceSheet
         visible={deviceSheetVisible}
@@ -16,7 +16,7 @@ import { ActivityTrendCover } from '../components/trends/ActivityTrendCover';
 import { RunningTrendCover } from '../components/trends/RunningTrendCover';
 import { HRTrendCover } from '../components/trends/HRTrendCover';
 import { loadBaselines } from '../services/ReadinessService';
-import { useHomeDataContext } from '../context/HomeDataContext';
+import { useHomeDataFields } from '../context/HomeDataContext';
 import { colors, fontFamily, spacing, fontSize } from '../theme/colors';
 import type { FocusBaselines } from '../types/focus.types';
 
@@ -109,7 +109,7 @@ const bannerStyles = StyleSheet.create({
 
 export function TrendsScreen() {
   const { t } = useTranslation();
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields('refresh');
 
   const [baselines, setBaselines] = useState<FocusBaselines>(EMPTY_BASELINES);
   const [baselinesLoaded, setBaselinesLoaded] = useState(false);
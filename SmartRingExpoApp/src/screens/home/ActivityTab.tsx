@@ -8,13 +8,14 @@ import { useTranslation } from 'react-i18next';
 import { HeroLinearGauge } from '../../components/home/HeroLinearGauge';
 import { MetricInsightCard } from '../../components/home/MetricInsightCard';
 import { GradientInfoCard } from '../../components/common/GradientInfoCard';
-import { useHomeDataContext } from '../../context/HomeDataContext';
+import { useHomeDataFields } from '../../context/HomeDataContext';
 import { getActivityMessage } from '../../hooks/useHomeData';
 import { spacing, fontSize, borderRadius, fontFamily } from '../../theme/colors';
 import { InfoButton } from '../../components/common/InfoButton';
 import type { UnifiedActivity } from '../../types/activity.types';
 import Ionicons from '@expo/vector-icons/Ionicons';
 import { formatSleepDuration } from '../../utils/ringData/sleep';
+import { countRender } from '../../utils/renderCounts';
 import { TrainingInsightsCard } from '../../components/home/TrainingInsightsCard';
 import { RingIcon } from '../../assets/icons';
 import { useRelativeTime } from '../../hooks/useRelativeTime';
@@ -132,7 +133,11 @@ function OxygenIcon() {
 }
 
 export function ActivityTab({ onScroll, isActive = false }: ActivityTabProps) {
-  const homeData = useHomeDataContext();
+  if (__DEV__) countRender('ActivityTab');
+  const homeData = useHomeDataFields(
+    'activity', 'cardDataStatus', 'isRingConnected', 'isSyncing', 'lastSyncedAt', 'refresh',
+    'refreshMissingCardData', 'stravaActivities', 'todayVitals', 'unifiedActivities',
+  );
   const { t } = useTranslation();
   const [refreshing, setRefreshing] = React.useState(false);
   const lastSyncLabel = useRelativeTime(homeData.lastSyncedAt);
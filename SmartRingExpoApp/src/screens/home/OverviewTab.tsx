@@ -16,8 +16,9 @@ import { CaffeineWindowCard } from '../../components/home/CaffeineWindowCard';
 import { CaffeineBarChart } from '../../components/detail/CaffeineBarChart';
 import { clearanceHour, recommendedWindow, MAX_CAFFEINE_MG, CAFFEINE_PRESETS } from '../../utils/caffeinePk';
 import { formatDecimalHour, getSleepHours } from '../../utils/time';
+import { countRender } from '../../utils/renderCounts';
 import LogEntrySheet from '../../components/home/LogEntrySheet';
-import { useHomeDataContext } from '../../context/HomeDataContext';
+import { useHomeDataFields } from '../../context/HomeDataContext';
 import { useFocusDataContext } from '../../context/FocusDataContext';
 import { getScoreMessage, getSleepMessage } from '../../hooks/useHomeData';
 import { useTimelineEntries } from '../../hooks/useTimelineEntries';
@@ -68,10 +69,18 @@ type OverviewTabProps = {
 };
 
 export function OverviewTab({ onScroll, onChartTouchStart, onChartTouchEnd, onSleepPress, isActive = false }: OverviewTabProps) {
+  if (__DEV__) countRender('OverviewTab');
   const { t } = useTranslation();
-  const homeData = useHomeDataContext();
+  const homeData = useHomeDataFields(
+    'activitySessions', 'hrChartData', 'insight', 'isLoading', 'lastNightSleep', 'lastSyncedAt',
+    'overallScore', 'readiness', 'refresh', 'sleepScore', 'strain', 'todayNaps', 'unifiedActivities',
+    'userName',
+  );
   const focusData = useFocusDataContext();
   const { setActionHandler, showOverlay } = useAddOverlay();
+  // Stable props so the memoized cards below skip renders this tab doesn't change
+  const openAddOverlay = React.useCallback(() => showOverlay(), [showOverlay]);
+  const hrHeaderRight = React.useMemo(() => <InfoButton metricKey="daily_hr_chart" />, []);
   const { entries: timelineEntries, addEntry } = useTimelineEntries();
   const { entries: caffeineEntries, doses: caffeineDoses, currentMg: caffeineCurrentMg } = useCaffeineTimeline();
   const [refreshing, setRefreshing] = React.useState(false);
@@ -325,7 +334,7 @@ export function OverviewTab({ onScroll, onChartTouchStart, onChartTouchEnd, onSl
 
       {/* Heart rate through the day */}
       <View style={styles.gradientCardSection}>
-        <DailyHeartRateCard preloadedData={homeData.hrChartData} headerRight={<InfoButton metricKey="daily_hr_chart" />} onTouchStart={onChartTouchStart} onTouchEnd={onChartTouchEnd} />
+        <DailyHeartRateCard preloadedData={homeData.hrChartData} headerRight={hrHeaderRight} onTouchStart={onChartTouchStart} onTouchEnd={onChartTouchEnd} />
       </View>
 
       {/* Caffeine Window */}
@@ -342,7 +351,7 @@ export function OverviewTab({ onScroll, onChartTouchStart, onChartTouchEnd, onSl
           unifiedActivities={homeData.unifiedActivities}
           todayNaps={homeData.todayNaps}
           caffeineEntries={caffeineEntries}
-          onAddPress={() => showOverlay()}
+          onAddPress={openAddOverlay}
         />
       </View>
 
@@ -14,7 +14,8 @@ import DailySleepTrendCard from '../../components/home/DailySleepTrendCard';
 import SleepDebtCard from '../../components/home/SleepDebtCard';
 import SleepBaselineTierCard from '../../components/home/SleepBaselineTierCard';
 import NapCard from '../../components/home/NapCard';
-import { useHomeDataContext } from '../../context/HomeDataContext';
+import { useHomeDataFields } from '../../context/HomeDataContext';
+import { countRender } from '../../utils/renderCounts';
 import { getSleepMessage } from '../../hooks/useHomeData';
 import type { SleepSegment } from '../../components/home/SleepStagesChart';
 import { spacing, fontSize, fontFamily, borderRadius } from '../../theme/colors';
@@ -57,7 +58,13 @@ function DropIcon() {
 const TIP_CARD_WIDTH = Dimensions.get('window').width * 0.75;
 
 export function SleepTab({ onScroll, onHypnogramTouchStart, onHypnogramTouchEnd, isActive = false }: SleepTabProps) {
-  const homeData = useHomeDataContext();
+  if (__DEV__) countRender('SleepTab');
+  const homeData = useHomeDataFields(
+    'applyOverrideNow', 'cardDataStatus', 'hrvSdnn', 'insight', 'insightType', 'isLoading',
+    'isRingConnected', 'isSyncing', 'lastNightSleep', 'lastSyncedAt', 'refresh',
+    'refreshMissingCardData', 'sleepScore', 'todayNaps', 'todayVitals', 'totalNapMinutesToday',
+    'unifiedSleepSessions',
+  );
   const { t } = useTranslation();
   const baseline = useBaselineMode();
   const [refreshing, setRefreshing] = React.useState(false);
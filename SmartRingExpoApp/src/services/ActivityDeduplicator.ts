@@ -5,6 +5,8 @@
  * Priority: Strava > Apple Health > Ring
  * Dedup rule: if two activities overlap >70% of the shorter one's duration
  *   AND share the same sport category → keep the higher-priority source.
+ * Matching runs against a per-category interval index (ActivityMergeIndex),
+ * so merging years of history stays near O(n log n).
  */
 
 import type { UnifiedActivity, HKWorkoutResult } from '../types/activity.types';
@@ -151,67 +153,127 @@ function ringToUnified(session: X3ActivitySession): UnifiedActivity {
   };
 }
 
-// ── Main merge + dedup ──────────────────────────────────────────────────────
+// ── Interval index — per-category sorted intervals ──────────────────────────
+//
+// Timestamps are parsed once on insert. Each sport category keeps its
+// accepted intervals sorted by start plus the longest duration seen, so a
+// candidate [s, e) only needs to look at entries whose start lies in
+// [s - maxLen, e): a binary search and a short sweep instead of a scan over
+// everything accepted so far.
 
 const OVERLAP_THRESHOLD = 0.7;
 
-export function mergeActivities(
-  strava: StravaActivitySummary[],
-  healthKit: HKWorkoutResult[],
-  ringActivities: X3ActivitySession[],
-): UnifiedActivity[] {
-  // Convert all to unified format
-  const stravaUnified = strava.map(stravaToUnified);
-  const hkUnified = healthKit.map(healthKitToUnified);
-  const ringUnified = ringActivities.map(ringToUnified);
-
-  // Start with Strava (highest priority)
-  const result: UnifiedActivity[] = [...stravaUnified];
-
-  // Add HealthKit workouts that don't overlap with Strava
-  for (const hk of hkUnified) {
-    const hkRange: TimeRange = {
-      start: new Date(hk.startDate).getTime(),
-      end: new Date(hk.endDate).getTime(),
-    };
-    const hkCat = sportCategory(hk.sportType);
-
-    const isDuplicate = result.some((existing) => {
-      const existingRange: TimeRange = {
-        start: new Date(existing.startDate).getTime(),
-        end: new Date(existing.endDate).getTime(),
-      };
-      const existingCat = sportCategory(existing.sportType);
-      return hkCat === existingCat && overlapRatio(hkRange, existingRange) >= OVERLAP_THRESHOLD;
-    });
-
-    if (!isDuplicate) result.push(hk);
+interface IndexedActivity extends TimeRange {
+  activity: UnifiedActivity;
+}
+
+function toIndexed(activity: UnifiedActivity): IndexedActivity {
+  // Unparseable dates become a zero-length range at 0: never a duplicate, sorts last
+  // (a bad start with a good end must not become [0, end]: that would stretch maxLen
+  // and overlap everything before it)
+  const start = Date.parse(activity.startDate);
+  if (!Number.isFinite(start)) return { activity, start: 0, end: 0 };
+  const end = Date.parse(activity.endDate);
+  return { activity, start, end: Number.isFinite(end) ? Math.max(start, end) : start };
+}
+
+/** First index whose start is >= `t`. */
+function lowerBound(items: IndexedActivity[], t: number): number {
+  let lo = 0;
+  let hi = items.length;
+  while (lo < hi) {
+    const mid = (lo + hi) >>> 1;
+    if (items[mid].start < t) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+class CategoryIntervals {
+  private items: IndexedActivity[] = [];
+  private maxLen = 0;
+
+  overlaps(range: TimeRange): boolean {
+    // A positive overlap needs other.start < range.end and other.end > range.start;
+    // other.end <= other.start + maxLen bounds where the sweep has to begin.
+    for (let i = lowerBound(this.items, range.start - this.maxLen); i < this.items.length; i++) {
+      const other = this.items[i];
+      if (other.start >= range.end) break;
+      if (overlapRatio(range, other) >= OVERLAP_THRESHOLD) return true;
+    }
+    return false;
   }
 
-  // Add ring activities that don't overlap with anything already in result
-  for (const ring of ringUnified) {
-    const ringRange: TimeRange = {
-      start: new Date(ring.startDate).getTime(),
-      end: new Date(ring.endDate).getTime(),
-    };
-    const ringCat = sportCategory(ring.sportType);
-
-    const isDuplicate = result.some((existing) => {
-      const existingRange: TimeRange = {
-        start: new Date(existing.startDate).getTime(),
-        end: new Date(existing.endDate).getTime(),
-      };
-      const existingCat = sportCategory(existing.sportType);
-      return ringCat === existingCat && overlapRatio(ringRange, existingRange) >= OVERLAP_THRESHOLD;
-    });
-
-    if (!isDuplicate) result.push(ring);
+  insert(item: IndexedActivity): void {
+    this.items.splice(lowerBound(this.items, item.start), 0, item);
+    if (item.end - item.start > this.maxLen) this.maxLen = item.end - item.start;
   }
+}
 
-  // Sort by start date descending (newest first)
-  result.sort((a, b) => new Date(b.startDate).getTime() - new Date(a.startDate).getTime());
+/**
+ * Incremental merge state. Feed sources in priority order (Strava, then
+ * Apple Health, then ring) — later sources only fill gaps left by earlier
+ * ones — and call `add` again whenever another page or source arrives.
+ */
+export class ActivityMergeIndex {
+  private byCategory = new Map<string, CategoryIntervals>();
+  private accepted: IndexedActivity[] = [];
+  private sorted: UnifiedActivity[] | null = [];
 
-  return result;
+  get size(): number {
+    return this.accepted.length;
+  }
+
+  /**
+   * Accept `activity` unless it duplicates one already accepted (same sport
+   * category, ≥70% overlap of the shorter). `dedupe: false` always accepts —
+   * used for the top-priority source, which is never checked against itself.
+   * Returns whether it was accepted.
+   */
+  add(activity: UnifiedActivity, dedupe = true): boolean {
+    const item = toIndexed(activity);
+    const cat = sportCategory(activity.sportType);
+    let intervals = this.byCategory.get(cat);
+    if (!intervals) {
+      intervals = new CategoryIntervals();
+      this.byCategory.set(cat, intervals);
+    }
+    if (dedupe && intervals.overlaps(item)) return false;
+    intervals.insert(item);
+    this.accepted.push(item);
+    this.sorted = null;
+    return true;
+  }
+
+  /** Adds every activity; returns how many were accepted. */
+  addAll(activities: UnifiedActivity[], dedupe = true): number {
+    let added = 0;
+    for (const a of activities) if (this.add(a, dedupe)) added++;
+    return added;
+  }
+
+  /** Accepted activities, newest first. */
+  toArray(): UnifiedActivity[] {
+    if (!this.sorted) {
+      this.sorted = [...this.accepted].sort((a, b) => b.start - a.start).map(i => i.activity);
+    }
+    return this.sorted;
+  }
+}
+
+// ── Main merge + dedup ──────────────────────────────────────────────────────
+
+export function mergeActivities(
+  strava: StravaActivitySummary[],
+  healthKit: HKWorkoutResult[],
+  ringActivities: X3ActivitySession[],
+): UnifiedActivity[] {
+  const index = new ActivityMergeIndex();
+  // Strava first (highest priority, kept as-is), then HealthKit and ring fill the gaps
+  index.addAll(strava.map(stravaToUnified), false);
+  index.addAll(healthKit.map(healthKitToUnified));
+  index.addAll(ringActivities.map(ringToUnified));
+  return index.toArray();
 }
 
-export { getSportConfig, sportCategory, stravaToUnified, healthKitToUnified, ringToUnified };
+export { sportCategory, stravaToUnified, healthKitToUnified, ringToUnified };
@@ -0,0 +1,417 @@
+/**
+ * ActivityDetailStore — per-minute steps / calories from the ring's detail activity history
+ *
+ * The ring keeps 10-minute activity windows ({ date, arraySteps[10], step,
+ * calories, distance }). A sync asks the ring only for windows from the cursor
+ * (start of the newest window already ingested) onward, scatters them into
+ * fixed 1440-slot per-day arrays and recomputes that day's rollups once:
+ * hourly steps / calories / distance, daily totals and cadence-based intensity
+ * minutes. Readers (hourly charts, strain) read rollups and never touch BLE.
+ *
+ * Writes are slot overwrites, so re-ingesting a window (the cursor window is
+ * always re-sent, and a ring that lost its history resends everything) is
+ * idempotent.
+ *
+ * Days changed by a sync stay listed by pendingUpload() until markUploaded()
+ * confirms the backend has their current rollups.
+ *
+ * Storage: one key per local day. Minute arrays are stored with zero runs
+ * collapsed (a night is a single entry), calories in 0.1 kcal and distance in
+ * decimetres so everything stays integer.
+ *
+ * No React Native imports: the window fetcher and storage are injected.
+ */
+
+import { encodeZeroRuns, decodeZeroRuns } from '../utils/zeroRuns';
+import { parseRingDate } from '../utils/ringDate';
+
+const KEY_PREFIX = 'activity_detail_v1:';
+const CURSOR_KEY = 'activity_detail_v1_cursor';
+/** { dateKey: ms of the sync that last changed it } for days not yet uploaded. */
+const UNSYNCED_KEY = 'activity_detail_v1_unsynced';
+const MINUTES_PER_DAY = 1440;
+/** Steps per minute; ~100 spm is brisk walking, ~130 spm running. */
+export const MODERATE_CADENCE = 100;
+export const VIGOROUS_CADENCE = 130;
+
+/** One raw SDK record (arrayDetailActivityData entry). */
+export interface DetailActivityWindow {
+  date?: string;          // "YYYY.MM.DD HH:mm:ss", local time
+  arraySteps?: number[];  // steps per minute from `date`
+  step?: number;
+  calories?: number;      // kcal for the whole window
+  distance?: number;      // km for the whole window
+}
+
+export interface DayActivityRollup {
+  dateKey: string;        // YYYY-MM-DD, local
+  steps: number;
+  calories: number;       // kcal
+  distanceM: number;
+  hourlySteps: number[];  // 24
+  hourlyCalories: number[];
+  hourlyDistanceM: number[];
+  moderateMinutes: number;
+  vigorousMinutes: number;
+  /** Minutes covered by at least one window. */
+  coveredMinutes: number;
+}
+
+export interface ActivityDetailSyncResult {
+  windows: number;
+  days: string[];
+  cursor: string | null;
+}
+
+/** The subset of AsyncStorage the store uses. */
+export interface ActivityDetailStorage {
+  getItem(key: string): Promise<string | null>;
+  setItem(key: string, value: string): Promise<void>;
+  multiGet(keys: readonly string[]): Promise<readonly (readonly [string, string | null])[]>;
+  multiSet(pairs: [string, string][]): Promise<void>;
+  getAllKeys(): Promise<readonly string[]>;
+  multiRemove(keys: readonly string[]): Promise<void>;
+}
+
+export type DetailWindowFetcher = (since: string | null) => Promise<DetailActivityWindow[]>;
+
+export interface ActivityDetailStoreOptions {
+  /** Days older than this are dropped at sync. */
+  retentionDays?: number;
+  now?: () => number;
+}
+
+interface DayBuffer {
+  steps: Uint16Array;
+  deciKcal: Uint16Array;
+  dm: Uint16Array;
+  covered: Uint8Array;
+  rollup: DayActivityRollup;
+}
+
+interface PersistedDay {
+  s: number[];
+  c: number[];
+  d: number[];
+  v: number[];
+  r: DayActivityRollup;
+}
+
+const pad2 = (n: number) => (n < 10 ? `0${n}` : `${n}`);
+
+export function localDateKey(d: Date): string {
+  return `${d.getFullYear()}-${pad2(d.getMonth() + 1)}-${pad2(d.getDate())}`;
+}
+
+/** "YYYY.MM.DD HH:mm:ss" → local Date, or null. */
+function parseWindowStart(value: string | undefined): Date | null {
+  const ms = parseRingDate(value);
+  return ms === undefined ? null : new Date(ms);
+}
+
+function emptyRollup(dateKey: string): DayActivityRollup {
+  return {
+    dateKey,
+    steps: 0,
+    calories: 0,
+    distanceM: 0,
+    hourlySteps: new Array(24).fill(0),
+    hourlyCalories: new Array(24).fill(0),
+    hourlyDistanceM: new Array(24).fill(0),
+    moderateMinutes: 0,
+    vigorousMinutes: 0,
+    coveredMinutes: 0,
+  };
+}
+
+function emptyDay(dateKey: string): DayBuffer {
+  return {
+    steps: new Uint16Array(MINUTES_PER_DAY),
+    deciKcal: new Uint16Array(MINUTES_PER_DAY),
+    dm: new Uint16Array(MINUTES_PER_DAY),
+    covered: new Uint8Array(MINUTES_PER_DAY),
+    rollup: emptyRollup(dateKey),
+  };
+}
+
+/** Single pass over the minute arrays. */
+export function rollupDay(dateKey: string, steps: Uint16Array, deciKcal: Uint16Array, dm: Uint16Array, covered: Uint8Array): DayActivityRollup {
+  const r = emptyRollup(dateKey);
+  let kcal10 = 0;
+  let dmTotal = 0;
+  for (let m = 0; m < MINUTES_PER_DAY; m++) {
+    if (!covered[m]) continue;
+    const h = (m / 60) | 0;
+    const s = steps[m];
+    r.coveredMinutes++;
+    r.steps += s;
+    r.hourlySteps[h] += s;
+    r.hourlyCalories[h] += deciKcal[m];
+    r.hourlyDistanceM[h] += dm[m];
+    kcal10 += deciKcal[m];
+    dmTotal += dm[m];
+    if (s >= VIGOROUS_CADENCE) r.vigorousMinutes++;
+    else if (s >= MODERATE_CADENCE) r.moderateMinutes++;
+  }
+  for (let h = 0; h < 24; h++) {
+    r.hourlyCalories[h] = Math.round(r.hourlyCalories[h]) / 10;
+    r.hourlyDistanceM[h] = Math.round(r.hourlyDistanceM[h] / 10);
+  }
+  r.calories = Math.round(kcal10) / 10;
+  r.distanceM = Math.round(dmTotal / 10);
+  return r;
+}
+
+/**
+ * Split a window's totals over its minutes in proportion to steps (evenly when
+ * the window has no steps, i.e. resting calories) and write the slots.
+ * Returns the day keys touched; `dayFor` loads or creates the buffer.
+ */
+export function applyWindow(window: DetailActivityWindow, dayFor: (dateKey: string) => DayBuffer, touched: Set<string>): boolean {
+  const start = parseWindowStart(window.date);
+  const minuteSteps = Array.isArray(window.arraySteps) ? window.arraySteps : [];
+  if (!start || minuteSteps.length === 0) return false;
+
+  const n = minuteSteps.length;
+  let stepSum = 0;
+  for (const s of minuteSteps) stepSum += Math.max(0, Number(s) || 0);
+  const deciKcal = Math.max(0, Number(window.calories) || 0) * 10;
+  const dm = Math.max(0, Number(window.distance) || 0) * 10_000;
+
+  // Walk minute by minute so windows spanning midnight (or a DST jump) land on the right day.
+  // Shares are rounded cumulatively so the minutes always add back up to the window total.
+  const t = new Date(start.getFullYear(), start.getMonth(), start.getDate(), start.getHours(), start.getMinutes());
+  let cumShare = 0;
+  let kcalSoFar = 0;
+  let dmSoFar = 0;
+  for (let i = 0; i < n; i++) {
+    const dateKey = localDateKey(t);
+    const day = dayFor(dateKey);
+    touched.add(dateKey);
+    const slot = t.getHours() * 60 + t.getMinutes();
+    const s = Math.max(0, Number(minuteSteps[i]) || 0);
+    cumShare += stepSum > 0 ? s / stepSum : 1 / n;
+    const kcalTo = Math.round(deciKcal * cumShare);
+    const dmTo = Math.round(dm * cumShare);
+    day.steps[slot] = Math.min(0xffff, s);
+    day.deciKcal[slot] = Math.min(0xffff, kcalTo - kcalSoFar);
+    day.dm[slot] = Math.min(0xffff, dmTo - dmSoFar);
+    day.covered[slot] = 1;
+    kcalSoFar = kcalTo;
+    dmSoFar = dmTo;
+    t.setMinutes(t.getMinutes() + 1);
+  }
+  return true;
+}
+
+export class ActivityDetailStore {
+  private readonly fetchWindows: DetailWindowFetcher;
+  private readonly storage: ActivityDetailStorage;
+  private readonly retentionDays: number;
+  private readonly now: () => number;
+
+  private readonly rollups = new Map<string, DayActivityRollup>();
+  private unsynced: Promise<Record<string, number>> | null = null;
+  private inFlight: Promise<ActivityDetailSyncResult> | null = null;
+
+  constructor(fetchWindows: DetailWindowFetcher, storage: ActivityDetailStorage, options: ActivityDetailStoreOptions = {}) {
+    this.fetchWindows = fetchWindows;
+    this.storage = storage;
+    this.retentionDays = options.retentionDays ?? 14;
+    this.now = options.now ?? Date.now;
+  }
+
+  /** Pull windows since the cursor and fold them in. Concurrent calls share one sync. */
+  sync(): Promise<ActivityDetailSyncResult> {
+    if (!this.inFlight) {
+      this.inFlight = this.runSync().finally(() => {
+        this.inFlight = null;
+      });
+    }
+    return this.inFlight;
+  }
+
+  /** Rollup for a local day (YYYY-MM-DD), from memory or storage; null if never ingested. */
+  async getDay(dateKey: string): Promise<DayActivityRollup | null> {
+    return (await this.getDays([dateKey])).get(dateKey) ?? null;
+  }
+
+  async getDays(dateKeys: readonly string[]): Promise<Map<string, DayActivityRollup>> {
+    const out = new Map<string, DayActivityRollup>();
+    const missing: string[] = [];
+    for (const key of dateKeys) {
+      const cached = this.rollups.get(key);
+      if (cached) out.set(key, cached);
+      else missing.push(key);
+    }
+    if (missing.length > 0) {
+      const rows = await this.storage.multiGet(missing.map(k => KEY_PREFIX + k));
+      for (const [key, raw] of rows) {
+        if (!raw) continue;
+        try {
+          const rollup = (JSON.parse(raw) as PersistedDay).r;
+          const dateKey = key.slice(KEY_PREFIX.length);
+          this.rollups.set(dateKey, rollup);
+          out.set(dateKey, rollup);
+        } catch {
+          // Corrupt entry: treat as never ingested; the next sync rewrites it
+        }
+      }
+    }
+    return out;
+  }
+
+  /** Days changed since their last upload, oldest first. */
+  async pendingUpload(): Promise<string[]> {
+    return Object.keys(await this.loadUnsynced()).sort();
+  }
+
+  /**
+   * `dateKeys` were uploaded from rollups read after `uploadStartedAt`; days a sync
+   * changed again since then stay pending.
+   */
+  async markUploaded(dateKeys: readonly string[], uploadStartedAt: number): Promise<void> {
+    const unsynced = await this.loadUnsynced();
+    let changed = false;
+    for (const key of dateKeys) {
+      if (key in unsynced && unsynced[key] <= uploadStartedAt) {
+        delete unsynced[key];
+        changed = true;
+      }
+    }
+    if (changed) await this.storage.setItem(UNSYNCED_KEY, JSON.stringify(unsynced));
+  }
+
+  /** Per-minute steps for a day (for minute-resolution charts). */
+  async getMinuteSteps(dateKey: string): Promise<Uint16Array | null> {
+    const raw = await this.storage.getItem(KEY_PREFIX + dateKey);
+    if (!raw) return null;
+    try {
+      return decodeZeroRuns((JSON.parse(raw) as PersistedDay).s, new Uint16Array(MINUTES_PER_DAY));
+    } catch {
+      return null;
+    }
+  }
+
+  private async runSync(): Promise<ActivityDetailSyncResult> {
+    const cursor = await this.storage.getItem(CURSOR_KEY);
+    const windows = await this.fetchWindows(cursor);
+
+    // Load the touched days lazily, all in one multiGet
+    const starts = new Set<string>();
+    for (const w of windows) {
+      const start = parseWindowStart(w.date);
+      if (!start) continue;
+      starts.add(localDateKey(start));
+      // A window starting at 23:5x also touches the next day
+      starts.add(localDateKey(new Date(start.getTime() + 10 * 60_000)));
+    }
+    const days = await this.loadBuffers([...starts]);
+    const dayFor = (key: string) => {
+      let day = days.get(key);
+      if (!day) {
+        day = emptyDay(key);
+        days.set(key, day);
+      }
+      return day;
+    };
+
+    const touched = new Set<string>();
+    let newest = cursor;
+    let newestMs = parseWindowStart(cursor ?? undefined)?.getTime() ?? -Infinity;
+    let applied = 0;
+    for (const w of windows) {
+      if (!applyWindow(w, dayFor, touched)) continue;
+      applied++;
+      const ms = parseWindowStart(w.date)!.getTime();
+      if (ms > newestMs) {
+        newestMs = ms;
+        newest = w.date!.trim();
+      }
+    }
+
+    const pairs: [string, string][] = [];
+    const unsynced = await this.loadUnsynced();
+    const syncedAt = this.now();
+    for (const key of touched) {
+      unsynced[key] = syncedAt;
+      const day = days.get(key)!;
+      day.rollup = rollupDay(key, day.steps, day.deciKcal, day.dm, day.covered);
+      this.rollups.set(key, day.rollup);
+      const persisted: PersistedDay = {
+        s: encodeZeroRuns(day.steps),
+        c: encodeZeroRuns(day.deciKcal),
+        d: encodeZeroRuns(day.dm),
+        v: encodeZeroRuns(day.covered),
+        r: day.rollup,
+      };
+      pairs.push([KEY_PREFIX + key, JSON.stringify(persisted)]);
+    }
+    if (touched.size > 0) pairs.push([UNSYNCED_KEY, JSON.stringify(unsynced)]);
+    if (newest && newest !== cursor) pairs.push([CURSOR_KEY, newest]);
+    if (pairs.length > 0) await this.storage.multiSet(pairs);
+    if (touched.size > 0) await this.prune();
+
+    return { windows: applied, days: [...touched].sort(), cursor: newest ?? null };
+  }
+
+  private async loadBuffers(dateKeys: string[]): Promise<Map<string, DayBuffer>> {
+    const out = new Map<string, DayBuffer>();
+    if (dateKeys.length === 0) return out;
+    const rows = await this.storage.multiGet(dateKeys.map(k => KEY_PREFIX + k));
+    for (const [key, raw] of rows) {
+      if (!raw) continue;
+      const dateKey = key.slice(KEY_PREFIX.length);
+      try {
+        const p = JSON.parse(raw) as PersistedDay;
+        const day = emptyDay(dateKey);
+        decodeZeroRuns(p.s, day.steps);
+        decodeZeroRuns(p.c, day.deciKcal);
+        decodeZeroRuns(p.d, day.dm);
+        decodeZeroRuns(p.v, day.covered);
+        day.rollup = p.r;
+        out.set(dateKey, day);
+      } catch {
+        // Corrupt entry: start the day over
+      }
+    }
+    return out;
+  }
+
+  private async prune(): Promise<void> {
+    const cutoff = new Date(this.now());
+    cutoff.setDate(cutoff.getDate() - this.retentionDays);
+    const cutoffKey = localDateKey(cutoff);
+    const keys = await this.storage.getAllKeys();
+    const stale = keys.filter(k => k.startsWith(KEY_PREFIX) && k.slice(KEY_PREFIX.length) < cutoffKey);
+    if (stale.length === 0) return;
+    const unsynced = await this.loadUnsynced();
+    for (const k of stale) {
+      this.rollups.delete(k.slice(KEY_PREFIX.length));
+      delete unsynced[k.slice(KEY_PREFIX.length)];
+    }
+    await this.storage.multiRemove(stale);
+    await this.storage.setItem(UNSYNCED_KEY, JSON.stringify(unsynced));
+  }
+
+  private loadUnsynced(): Promise<Record<string, number>> {
+    if (!this.unsynced) {
+      this.unsynced = this.storage.getItem(UNSYNCED_KEY).then(async raw => {
+        if (raw) {
+          try {
+            return JSON.parse(raw) as Record<string, number>;
+          } catch {
+            // Corrupt: fall through and re-upload everything stored
+          }
+        }
+        // No record yet (first run of this version): every stored day is pending
+        const unsynced: Record<string, number> = {};
+        for (const k of await this.storage.getAllKeys()) {
+          if (k.startsWith(KEY_PREFIX)) unsynced[k.slice(KEY_PREFIX.length)] = 0;
+        }
+        return unsynced;
+      });
+    }
+    return this.unsynced;
+  }
+}
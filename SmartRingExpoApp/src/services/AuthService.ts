@@ -1,6 +1,10 @@
 import { Session, User } from '@supabase/supabase-js';
 import { reportError } from '../utils/sentry';
 import { supabase } from './SupabaseService';
+import { clearDeltaCache } from './DeltaSyncService';
+import { clearHydrationCache } from './HydrationPipeline';
+import { hkAnchoredStore } from './HealthKit/HealthKitAnchoredQueries';
+import { sleepSegmenter } from './SleepSegmentation';
 import { Profile } from '../types/supabase.types';
 import * as WebBrowser from 'expo-web-browser';
 import { makeRedirectUri } from 'expo-auth-session';
@@ -80,6 +84,8 @@ export async function signOut(): Promise<{ success: boolean; error?: string }> {
   if (error) {
     return { success: false, error: error.message };
   }
+  sleepSegmenter.clear();
+  await Promise.all([clearDeltaCache(), clearHydrationCache(), hkAnchoredStore.clear()]);
   return { success: true };
 }
 
@@ -0,0 +1,138 @@
+/**
+ * BackgroundBudget — time-budgeted executor for background-wake work.
+ *
+ * iOS gives a background wake a short, unannounced window. Instead of one
+ * monolithic syncAllData() that either finishes or persists nothing, work is
+ * split into prioritized units that run in order while the budget lasts:
+ *
+ *   - units still fresh (finished < minIntervalMs ago) are skipped
+ *   - a unit whose learned cost (EWMA of past runs) exceeds the remaining
+ *     budget is deferred; it keeps its stale timestamp, so it sorts first
+ *     among equal-priority units on the next wake. The first due unit of a
+ *     wake always runs, so an estimate above the whole budget can't starve
+ *     it forever (and the run corrects the estimate)
+ *   - the checkpoint is written after EVERY unit, so a wake that is killed
+ *     mid-way still keeps what already landed
+ *
+ * Per-unit timings are returned for logging and added as Sentry breadcrumbs.
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+import { addBreadcrumb, reportError } from '../utils/sentry';
+
+const CHECKPOINT_KEY = '@focus_bg_checkpoint_v1';
+// Weight of the newest sample in the per-unit cost estimate
+const COST_EWMA_ALPHA = 0.3;
+
+export type UnitStatus = 'done' | 'partial' | 'failed' | 'skipped';
+
+export interface WorkUnit {
+  id: string;
+  /** Lower runs first. */
+  priority: number;
+  /** Skip if the unit finished more recently than this. 0 = always eligible. */
+  minIntervalMs: number;
+  /** First-run cost guess before any timings are learned. */
+  defaultCostMs: number;
+  run: () => Promise<UnitStatus>;
+}
+
+export interface UnitCheckpoint {
+  lastDoneAt: number | null;
+  lastStatus: UnitStatus | 'deferred' | null;
+  avgCostMs: number | null;
+}
+
+export interface UnitReport {
+  id: string;
+  status: UnitStatus | 'deferred' | 'fresh';
+  ms: number;
+}
+
+export interface BudgetReport {
+  units: UnitReport[];
+  elapsedMs: number;
+  budgetMs: number;
+}
+
+async function loadCheckpoints(): Promise<Record<string, UnitCheckpoint>> {
+  try {
+    const raw = await AsyncStorage.getItem(CHECKPOINT_KEY);
+    return raw ? (JSON.parse(raw) as Record<string, UnitCheckpoint>) : {};
+  } catch {
+    return {};
+  }
+}
+
+async function saveCheckpoints(cp: Record<string, UnitCheckpoint>): Promise<void> {
+  try {
+    await AsyncStorage.setItem(CHECKPOINT_KEY, JSON.stringify(cp));
+  } catch (e) {
+    reportError(e, { op: 'backgroundBudget.checkpoint' }, 'warning');
+  }
+}
+
+/** Whether any unit is due — lets the caller skip BLE reconnect when nothing would run. */
+export async function hasDueUnits(units: WorkUnit[], now = Date.now()): Promise<boolean> {
+  const cp = await loadCheckpoints();
+  return units.some(u => {
+    const last = cp[u.id]?.lastDoneAt;
+    return !last || now - last >= u.minIntervalMs;
+  });
+}
+
+export async function runWithBudget(units: WorkUnit[], budgetMs: number): Promise<BudgetReport> {
+  const t0 = Date.now();
+  const cp = await loadCheckpoints();
+  const reports: UnitReport[] = [];
+  let ranAny = false;
+
+  // Priority first; within a priority, the unit that has waited longest goes first
+  const ordered = [...units].sort((a, b) =>
+    a.priority - b.priority
+    || (cp[a.id]?.lastDoneAt ?? 0) - (cp[b.id]?.lastDoneAt ?? 0),
+  );
+
+  for (const unit of ordered) {
+    const state: UnitCheckpoint = cp[unit.id] ?? { lastDoneAt: null, lastStatus: null, avgCostMs: null };
+    const startedAt = Date.now();
+
+    if (state.lastDoneAt && startedAt - state.lastDoneAt < unit.minIntervalMs) {
+      reports.push({ id: unit.id, status: 'fresh', ms: 0 });
+      continue;
+    }
+
+    const remaining = budgetMs - (startedAt - t0);
+    const expected = state.avgCostMs ?? unit.defaultCostMs;
+    if (ranAny && expected > remaining) {
+      cp[unit.id] = { ...state, lastStatus: 'deferred' };
+      reports.push({ id: unit.id, status: 'deferred', ms: 0 });
+      continue;
+    }
+
+    ranAny = true;
+    let status: UnitStatus;
+    try {
+      status = await unit.run();
+    } catch (e) {
+      reportError(e, { op: 'backgroundBudget.unit', unit: unit.id }, 'warning');
+      status = 'failed';
+    }
+    const ms = Date.now() - startedAt;
+
+    cp[unit.id] = {
+      lastDoneAt: status === 'done' ? Date.now() : state.lastDoneAt,
+      lastStatus: status,
+      // Only learn from runs that actually did the work
+      avgCostMs: status === 'done' || status === 'partial'
+        ? Math.round(state.avgCostMs == null ? ms : state.avgCostMs + COST_EWMA_ALPHA * (ms - state.avgCostMs))
+        : state.avgCostMs,
+    };
+    reports.push({ id: unit.id, status, ms });
+    addBreadcrumb('bg.unit', `${unit.id} ${status}`, { ms, remaining });
+    await saveCheckpoints(cp);
+  }
+
+  await saveCheckpoints(cp);
+  return { units: reports, elapsedMs: Date.now() - t0, budgetMs };
+}
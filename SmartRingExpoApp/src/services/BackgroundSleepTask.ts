@@ -5,6 +5,11 @@
  * sync sleep data from the ring over BLE, detect the wake time (endTime),
  * and schedule a local notification for wakeTime + 30 minutes.
  *
+ * Each wake runs prioritized work units (sleep → HR → vitals → activity) through
+ * BackgroundBudget, so whatever fits in the window is persisted and the rest
+ * resumes on the next wake. Log lines are buffered and written to
+ * background_logs in a single insert at the end of the wake.
+ *
  * Must be imported at the app root (before rendering) so the task is defined.
  */
 import * as TaskManager from 'expo-task-manager';
@@ -15,7 +20,8 @@ import { Platform } from 'react-native';
 import smartRingService from './UnifiedSmartRingService';
 import { reportError } from '../utils/sentry';
 import { supabase } from './SupabaseService';
-import dataSyncService from './DataSyncService';
+import dataSyncService, { type SingleSyncResult } from './DataSyncService';
+import { hasDueUnits, runWithBudget, type UnitStatus, type WorkUnit } from './BackgroundBudget';
 import { extractWakeTime } from '../utils/ringData/sleep';
 import { formatDurationHm } from '../utils/time';
 
@@ -24,33 +30,69 @@ const SCHEDULED_KEY = '@focus_sleep_notif_scheduled_v2';
 // In-memory flag prevents concurrent scheduling within the same app session.
 // Resets on app restart; AsyncStorage SCHEDULED_KEY handles cross-session dedup.
 let _schedulingInProgress = false;
-const BG_SYNC_KEY = '@focus_bg_sync_last_at';
 /** Per-day dedupe key for sleep-only sync — format: @focus_sleep_synced_for_YYYY-MM-DD */
 const SLEEP_SYNCED_PREFIX = '@focus_sleep_synced_for_';
 const NOTIFICATION_DELAY_MS = 30 * 60 * 1000; // 30 minutes after wake
 const MIN_HOUR = 7; // Don't process wake times before 7 AM (fragmented sleep guard)
 const HOME_CACHE_KEY = 'home_data_cache';
+/** Log rows that failed to upload — retried on the next flush. */
+const PENDING_LOGS_KEY = '@focus_bg_pending_logs_v1';
+const MAX_PENDING_LOGS = 200;
+/** Conservative share of the iOS background window spent on ring work. */
+const BG_BUDGET_MS = 25 * 1000;
+const UNIT_INTERVAL_MS = 2 * 60 * 60 * 1000;
 
 /** Returns the AsyncStorage key for the sleep-sync dedupe flag for a given date string (YYYY-MM-DD). */
 export function sleepSyncedKey(dateStr: string): string {
   return `${SLEEP_SYNCED_PREFIX}${dateStr}`;
 }
 
+interface BgLogRow {
+  task: string;
+  event: string;
+  details: Record<string, any>;
+}
+
+let _logBuffer: BgLogRow[] = [];
+
 /**
- * Log an event to the background_logs table in Supabase.
- * Fire-and-forget — never throws.
+ * Queue an event for the background_logs table. Buffered in memory — no
+ * network per line; flushBgLogs() writes the batch. Never throws.
  */
-async function bgLog(event: string, details: Record<string, any> = {}): Promise<void> {
+function bgLog(event: string, details: Record<string, any> = {}): void {
+  // `at` preserves event time; the row's created_at is the flush time
+  _logBuffer.push({ task: TASK_NAME, event, details: { ...details, at: new Date().toISOString() } });
+}
+
+/**
+ * Write buffered log lines (plus any left over from a failed flush) in one
+ * insert. On failure they're parked in AsyncStorage for the next wake.
+ */
+export async function flushBgLogs(): Promise<void> {
+  const batch = _logBuffer;
+  _logBuffer = [];
+  let pending: BgLogRow[] = [];
   try {
-    const { data: { user } } = await supabase.auth.getUser();
-    await supabase.from('background_logs').insert({
-      user_id: user?.id ?? null,
-      task: TASK_NAME,
-      event,
-      details,
-    });
+    const raw = await AsyncStorage.getItem(PENDING_LOGS_KEY);
+    if (raw) pending = JSON.parse(raw) as BgLogRow[];
+  } catch {}
+  const rows = [...pending, ...batch];
+  if (rows.length === 0) return;
+
+  try {
+    // getSession() reads the persisted session — no auth round-trip
+    const { data: { session } } = await supabase.auth.getSession();
+    const userId = session?.user?.id ?? null;
+    const { error } = await supabase
+      .from('background_logs')
+      .insert(rows.map(r => ({ ...r, user_id: userId })));
+    if (error) throw error;
+    if (pending.length > 0) await AsyncStorage.removeItem(PENDING_LOGS_KEY);
   } catch {
-    // Silently fail — logging should never break the task
+    // Logging should never break the task — keep the newest lines for next time
+    try {
+      await AsyncStorage.setItem(PENDING_LOGS_KEY, JSON.stringify(rows.slice(-MAX_PENDING_LOGS)));
+    } catch {}
   }
 }
 
@@ -152,14 +194,14 @@ async function patchHeroCache(userId: string): Promise<void> {
     };
 
     await AsyncStorage.setItem(HOME_CACHE_KEY, JSON.stringify(patched));
-    await bgLog('hero_cache_patched', {
+    bgLog('hero_cache_patched', {
       sleepScore: patched.sleepScore,
       bedTime: sleep.start_time,
       wakeTime: sleep.end_time,
       sleepMin,
     });
   } catch (e: any) {
-    await bgLog('hero_cache_patch_failed', { error: e?.message });
+    bgLog('hero_cache_patch_failed', { error: e?.message });
   }
 }
 
@@ -171,120 +213,176 @@ async function patchHeroCache(userId: string): Promise<void> {
  * Returns a human-readable summary of what happened for the debug UI.
  */
 export async function runBackgroundSleepCheck(): Promise<string> {
+  try {
+    return await runBudgetedWake();
+  } finally {
+    await flushBgLogs();
+  }
+}
+
+async function runBudgetedWake(): Promise<string> {
   const now = new Date();
   const hour = now.getHours();
 
   if (hour < 5 || hour >= 23) {
-    await bgLog('skipped_outside_window', { hour });
+    bgLog('skipped_outside_window', { hour });
     return `Skipped — outside window (hour ${hour}, runs 5–23)`;
   }
 
-  const { data: { user } } = await supabase.auth.getUser();
-  const userId = user?.id;
+  const { data: { session } } = await supabase.auth.getSession();
+  const userId = session?.user?.id;
   if (!userId) {
-    await bgLog('no_user');
+    bgLog('no_user');
     return 'Skipped — no authenticated user';
   }
 
   const today = now.toDateString();
   const todayDateStr = now.toISOString().split('T')[0];
-  const lastScheduled = await AsyncStorage.getItem(SCHEDULED_KEY);
-  const alreadyScheduledToday = lastScheduled === today;
-
-  let didSleepSync = false;
-  let didSchedule = false;
+  const alreadyScheduledToday = (await AsyncStorage.getItem(SCHEDULED_KEY)) === today;
   const events: string[] = [];
-
-  if (!alreadyScheduledToday) {
-    const connStatus = await smartRingService.isConnected();
-    if (!connStatus.connected) {
-      try {
-        const reconResult = await smartRingService.autoReconnect();
-        if (!reconResult.success) {
-          await bgLog('reconnect_failed', { message: reconResult.message });
-          events.push('reconnect failed');
-        } else {
-          await bgLog('reconnected');
-          events.push('reconnected');
+  let landedData = false;
+
+  // Anything short of 'done' keeps the unit's stale timestamp, so the next wake retries it
+  const singleSyncStatus = (label: string, r: SingleSyncResult): UnitStatus => {
+    events.push(`${label} sync ${r.success ? 'ok' : `failed: ${r.error}`}`);
+    if (r.success) landedData = true;
+    return r.success ? 'done' : 'failed';
+  };
+  // One ring_syncs record and one summary sweep for the whole wake, not per unit
+  const batch = dataSyncService.beginSingleSyncBatch(userId);
+
+  const units: WorkUnit[] = [
+    {
+      id: 'sleep',
+      priority: 0,
+      minIntervalMs: 0, // gated by SCHEDULED_KEY / per-day sleep-synced flag instead
+      defaultCostMs: 12 * 1000,
+      run: async () => {
+        if (alreadyScheduledToday) {
+          events.push('sleep check already done today');
+          return 'skipped';
+        }
+        const rawResult = await smartRingService.getSleepDataRaw();
+        const rawRecords: any[] = rawResult.records || [];
+        const wakeTime = rawRecords.length > 0 ? extractWakeTime(rawRecords) : null;
+
+        if (!wakeTime) {
+          bgLog('no_valid_wake_time', { recordCount: rawRecords.length });
+          events.push(`no wake time (${rawRecords.length} records)`);
+          return 'skipped';
         }
-      } catch (e: any) {
-        await bgLog('reconnect_error', { error: e?.message });
-        reportError(e, { op: 'backgroundTask.reconnect' });
-        events.push(`reconnect error: ${e?.message}`);
-      }
-    } else {
-      events.push('ring connected');
-    }
-
-    const rawResult = await smartRingService.getSleepDataRaw();
-    const rawRecords: any[] = rawResult.records || [];
-    const wakeTime = rawRecords.length > 0 ? extractWakeTime(rawRecords) : null;
 
-    if (!wakeTime) {
-      await bgLog('no_valid_wake_time', { recordCount: rawRecords.length });
-      events.push(`no wake time (${rawRecords.length} records)`);
-    } else {
-      const alreadySynced = await AsyncStorage.getItem(sleepSyncedKey(todayDateStr));
-      let sessionForNotif: { totalMin: number; sleepScore: number | null } | null = null;
+        const alreadySynced = await AsyncStorage.getItem(sleepSyncedKey(todayDateStr));
+        let sessionForNotif: { totalMin: number; sleepScore: number | null } | null = null;
+        let status: 'done' | 'partial' = 'done';
 
-      if (!alreadySynced) {
-        try {
+        if (!alreadySynced) {
           const syncResult = await dataSyncService.syncSleepOnly();
           if (syncResult.success) {
             await AsyncStorage.setItem(sleepSyncedKey(todayDateStr), '1');
-            didSleepSync = true;
+            landedData = true;
             sessionForNotif = syncResult.latestSession ?? null;
-            await bgLog('sleep_only_sync_complete', {
+            bgLog('sleep_only_sync_complete', {
               totalMin: sessionForNotif?.totalMin,
               score: sessionForNotif?.sleepScore,
             });
             await patchHeroCache(userId);
             events.push(`sleep synced (${sessionForNotif?.totalMin}min, score ${sessionForNotif?.sleepScore})`);
           } else {
-            await bgLog('sleep_only_sync_failed', { error: syncResult.error });
+            bgLog('sleep_only_sync_failed', { error: syncResult.error });
             events.push(`sleep sync failed: ${syncResult.error}`);
+            status = 'partial';
           }
-        } catch (e: any) {
-          await bgLog('sleep_only_sync_error', { error: e?.message });
-          events.push(`sleep sync error: ${e?.message}`);
+        } else {
+          events.push('sleep already synced today');
         }
-      } else {
-        events.push('sleep already synced today');
-      }
 
-      didSchedule = await scheduleSleepNotification(wakeTime, sessionForNotif);
-      await bgLog(didSchedule ? 'notification_scheduled' : 'notification_skipped_past', {
-        wakeTime: wakeTime.toISOString(),
-        fireAt: new Date(wakeTime.getTime() + NOTIFICATION_DELAY_MS).toISOString(),
-        recordCount: rawRecords.length,
-        enriched: !!sessionForNotif,
-      });
-      events.push(didSchedule ? 'notification scheduled' : 'notification skipped (fire time past)');
-      if (didSchedule) await AsyncStorage.setItem(SCHEDULED_KEY, today);
-    }
-  } else {
-    events.push('sleep check already done today');
+        const didSchedule = await scheduleSleepNotification(wakeTime, sessionForNotif);
+        bgLog(didSchedule ? 'notification_scheduled' : 'notification_skipped_past', {
+          wakeTime: wakeTime.toISOString(),
+          fireAt: new Date(wakeTime.getTime() + NOTIFICATION_DELAY_MS).toISOString(),
+          recordCount: rawRecords.length,
+          enriched: !!sessionForNotif,
+        });
+        events.push(didSchedule ? 'notification scheduled' : 'notification skipped (fire time past)');
+        if (didSchedule) await AsyncStorage.setItem(SCHEDULED_KEY, today);
+        return status;
+      },
+    },
+    {
+      id: 'heartRate',
+      priority: 1,
+      minIntervalMs: UNIT_INTERVAL_MS,
+      defaultCostMs: 8 * 1000,
+      run: async () => singleSyncStatus('hr', await dataSyncService.syncHeartRateOnly(batch)),
+    },
+    {
+      id: 'vitals',
+      priority: 2,
+      minIntervalMs: UNIT_INTERVAL_MS,
+      defaultCostMs: 6 * 1000,
+      run: async () => singleSyncStatus('vitals', await dataSyncService.syncVitalsOnly(batch)),
+    },
+    {
+      id: 'activity',
+      priority: 3,
+      minIntervalMs: UNIT_INTERVAL_MS,
+      defaultCostMs: 5 * 1000,
+      run: async () => singleSyncStatus('activity', await dataSyncService.syncActivityOnly(batch)),
+    },
+    {
+      // Last, after every unit that can land rows; runs only when one did
+      id: 'summaries',
+      priority: 4,
+      minIntervalMs: 0,
+      defaultCostMs: 3 * 1000,
+      run: async () => {
+        if (!batch.landed) return 'skipped';
+        const r = await dataSyncService.finishSingleSyncBatch(batch);
+        events.push(`summaries ${r.success ? 'ok' : `failed: ${r.error}`}`);
+        return r.success ? 'done' : 'failed';
+      },
+    },
+  ];
+
+  if (alreadyScheduledToday && !(await hasDueUnits(units.filter(u => u.id !== 'sleep' && u.id !== 'summaries')))) {
+    events.push('nothing due');
+    bgLog('nothing_due');
+    return events.join('\n');
   }
 
-  if (!didSleepSync) {
-    const lastBgSync = await AsyncStorage.getItem(BG_SYNC_KEY);
-    const twoHoursAgo = Date.now() - 2 * 60 * 60 * 1000;
-    if (!lastBgSync || Number(lastBgSync) < twoHoursAgo) {
-      try {
-        const syncResult = await dataSyncService.syncAllData();
-        await AsyncStorage.setItem(BG_SYNC_KEY, String(Date.now()));
-        await bgLog('bg_sync_complete', { success: syncResult.success, error: syncResult.error });
-        if (syncResult.success) await patchHeroCache(userId);
-        events.push(`full sync ${syncResult.success ? 'ok' : `failed: ${syncResult.error}`}`);
-      } catch (e: any) {
-        await bgLog('bg_sync_error', { error: e?.message });
-        events.push(`full sync error: ${e?.message}`);
+  // Connect once up front; every unit needs the ring
+  const connStatus = await smartRingService.isConnected();
+  if (!connStatus.connected) {
+    try {
+      const reconResult = await smartRingService.autoReconnect();
+      if (!reconResult.success) {
+        bgLog('reconnect_failed', { message: reconResult.message });
+        events.push('reconnect failed');
+      } else {
+        bgLog('reconnected');
+        events.push('reconnected');
       }
-    } else {
-      events.push('full sync skipped (ran < 2h ago)');
+    } catch (e: any) {
+      bgLog('reconnect_error', { error: e?.message });
+      reportError(e, { op: 'backgroundTask.reconnect' });
+      events.push(`reconnect error: ${e?.message}`);
     }
+  } else {
+    events.push('ring connected');
   }
 
+  const report = await runWithBudget(units, BG_BUDGET_MS);
+  if (landedData) await patchHeroCache(userId);
+
+  bgLog('budget_report', {
+    elapsedMs: report.elapsedMs,
+    budgetMs: report.budgetMs,
+    landedData,
+    units: report.units,
+  });
+  events.push(report.units.map(u => `${u.id}: ${u.status}${u.ms ? ` ${u.ms}ms` : ''}`).join(', '));
+
   return events.join('\n');
 }
 
@@ -293,7 +391,8 @@ TaskManager.defineTask(TASK_NAME, async () => {
     await runBackgroundSleepCheck();
     return BackgroundTask.BackgroundTaskResult.Success;
   } catch (error: any) {
-    await bgLog('task_error', { error: error?.message, stack: error?.stack?.slice(0, 300) });
+    bgLog('task_error', { error: error?.message, stack: error?.stack?.slice(0, 300) });
+    await flushBgLogs();
     reportError(error, { op: 'backgroundSleepTask.topLevel' }, 'fatal');
     return BackgroundTask.BackgroundTaskResult.Failed;
   }
@@ -344,11 +443,13 @@ export async function maybeSendSleepNotificationFromForeground(
   const didSchedule = await scheduleSleepNotification(sleepEndTime, session);
   if (didSchedule) {
     await AsyncStorage.setItem(SCHEDULED_KEY, today);
-    await bgLog('notification_scheduled_foreground', {
+    bgLog('notification_scheduled_foreground', {
       wakeTime: sleepEndTime.toISOString(),
       fireAt: new Date(sleepEndTime.getTime() + NOTIFICATION_DELAY_MS).toISOString(),
       enriched: !!session,
     });
+    // Foreground — no time budget, flush right away
+    await flushBgLogs();
   } else {
     // Fire time is past — don't lock out future attempts (e.g., next day)
     _schedulingInProgress = false;
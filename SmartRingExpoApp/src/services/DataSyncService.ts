@@ -1,5 +1,6 @@
 import { supabase, supabaseService } from './SupabaseService';
-import { reportError, addBreadcrumb } from '../utils/sentry';
+import { reportError, addBreadcrumb, withSpan } from '../utils/sentry';
+import { syncStatsDelta } from '../utils/bleSyncStats';
 import UnifiedSmartRingService from './UnifiedSmartRingService';
 import { stravaService } from './StravaService';
 import {
@@ -12,7 +13,11 @@ import {
   TemperatureData,
   BatteryData,
 } from '../types/sdk.types';
-import { classifySleepSession, calculateNapScore } from './NapClassifierService';
+import { calculateNapScore } from './NapClassifierService';
+import { MAX_SESSION_MS, sleepSegmenter } from './SleepSegmentation';
+import { markDeltaStale, type DeltaTable } from './DeltaSyncService';
+import { localDateKey } from './ActivityDetailStore';
+import { parseLocalDate } from '../utils/chartMath';
 import { calculateSleepScoreFromStages, extractSleepVitalsFromRaw } from '../utils/ringData/sleep';
 
 interface SyncStatus {
@@ -21,6 +26,20 @@ interface SyncStatus {
   error: string | null;
 }
 
+export interface SingleSyncResult {
+  success: boolean;
+  error?: string;
+}
+
+/** State shared by the single-category syncs of one background wake. */
+export interface SingleSyncBatch {
+  userId: string;
+  /** ring_syncs row, created by the first sync of the batch. */
+  syncId?: Promise<string | null>;
+  /** A sync stored rows since the last summary sweep. */
+  landed: boolean;
+}
+
 class DataSyncService {
   private _syncStatus: SyncStatus = {
     lastSyncAt: null,
@@ -103,27 +122,13 @@ class DataSyncService {
     this._syncStatus = { ...this._syncStatus, isSyncing: true, error: null };
     this.notifyListeners();
 
+    return this.traced('syncAllData', () => this.runSyncAll(userId));
+  }
+
+  private async runSyncAll(userId: string): Promise<{ success: boolean; error?: string }> {
     try {
       const smartRingService = UnifiedSmartRingService;
-
-      // Create a sync record (tolerate failures so sync continues)
-      let batteryLevel: number | undefined;
-      let versionStr: string | undefined;
-      try {
-        const battery = await smartRingService.getBattery();
-        batteryLevel = battery?.battery;
-      } catch (e) { console.warn('[Sync] getBattery failed:', (e as Error).message); reportError(e, { op: 'sync.getBattery' }, 'warning'); }
-      try {
-        const version = await smartRingService.getVersion();
-        versionStr = version?.version;
-      } catch (e) { console.warn('[Sync] getVersion failed:', (e as Error).message); reportError(e, { op: 'sync.getVersion' }, 'warning'); }
-
-      const syncId = await supabaseService.createRingSync(
-        userId,
-        'unknown', // device mac - would come from actual device
-        batteryLevel,
-        versionStr
-      );
+      const syncId = await this.createSyncRecord(userId);
 
       // Sync all data types
       await Promise.all([
@@ -135,15 +140,18 @@ class DataSyncService {
         this.syncSportRecords(userId, smartRingService), // NEW
       ]);
 
-      // Update daily summary for today and the past 6 days so the activity detail screen
-      // has real data for historical days (not just today).
-      const summaryDates: Date[] = [];
-      for (let i = 0; i < 7; i++) {
-        const d = new Date();
-        d.setDate(d.getDate() - i);
-        summaryDates.push(d);
+      // Every type is fetched, stored and uploaded by now; clear what the backend has acked
+      try {
+        const outcomes = await smartRingService.reclaimer.reclaim();
+        const acted = outcomes.filter(o => o.action !== 'skipped');
+        if (acted.length > 0) {
+          addBreadcrumb('sync', 'ring storage reclaimed', { outcomes: acted });
+        }
+      } catch (e) {
+        reportError(e, { op: 'sync.reclaimRingStorage' }, 'warning');
       }
-      await Promise.all(summaryDates.map(d => this.updateDailySummary(userId, d)));
+
+      await this.updateRecentSummaries(userId);
 
       this._syncStatus = {
         lastSyncAt: new Date(),
@@ -151,6 +159,8 @@ class DataSyncService {
         error: null,
       };
       this.notifyListeners();
+      // Fresh rows just landed — next history read should revalidate its cursor
+      markDeltaStale();
 
       addBreadcrumb('sync', 'syncAllData completed');
       return { success: true };
@@ -190,30 +200,156 @@ class DataSyncService {
       return { success: false, error: 'NOT_CONNECTED' };
     }
 
-    try {
-      await this.syncSleepData(userId, UnifiedSmartRingService);
-      await this.updateDailySummary(userId, new Date());
-
-      // Fetch the just-written session for notification body enrichment
-      const since = new Date();
-      since.setDate(since.getDate() - 2);
-      const sessions = await supabaseService.getSleepSessions(userId, since, new Date());
-      const latest = sessions.find(s => s.session_type === 'night') ?? sessions[0] ?? null;
-      const latestSession = latest
-        ? {
-            totalMin: (latest.deep_min || 0) + (latest.light_min || 0) + (latest.rem_min || 0),
-            sleepScore: latest.sleep_score,
-            wakeTime: new Date(latest.end_time),
-          }
-        : null;
+    return this.traced('syncSleepOnly', async () => {
+      try {
+        await this.syncSleepData(userId, UnifiedSmartRingService);
+        await this.updateDailySummary(userId, new Date());
+        markDeltaStale(['sleep_sessions', 'daily_summaries']);
+
+        // Fetch the just-written session for notification body enrichment
+        const since = new Date();
+        since.setDate(since.getDate() - 2);
+        const sessions = await supabaseService.getSleepSessions(userId, since, new Date());
+        const latest = sessions.find(s => s.session_type === 'night') ?? sessions[0] ?? null;
+        const latestSession = latest
+          ? {
+              totalMin: (latest.deep_min || 0) + (latest.light_min || 0) + (latest.rem_min || 0),
+              sleepScore: latest.sleep_score,
+              wakeTime: new Date(latest.end_time),
+            }
+          : null;
 
-      return { success: true, latestSession };
+        return { success: true, latestSession };
+      } catch (e: any) {
+        reportError(e, { op: 'syncSleepOnly' });
+        return { success: false, error: e?.message };
+      }
+    });
+  }
+
+  /**
+   * Single-category syncs used by the background budget executor
+   * (BackgroundSleepTask), so a short wake can land HR or vitals without
+   * paying for the whole syncAllData fan-out. Same writers as syncAllData;
+   * the per-sync bookkeeping is paid once per batch (one wake) instead of per
+   * unit: the ring_syncs record on the first sync, the 7-day summary sweep in
+   * finishSingleSyncBatch after the last.
+   *
+   * `success` means everything fetched was stored.
+   */
+  beginSingleSyncBatch(userId: string): SingleSyncBatch {
+    return { userId, landed: false };
+  }
+
+  async syncHeartRateOnly(batch: SingleSyncBatch): Promise<SingleSyncResult> {
+    return this.runSingleSync('syncHeartRateOnly', batch, ['heart_rate_readings'], syncId =>
+      this.syncHeartRateData(batch.userId, UnifiedSmartRingService, syncId));
+  }
+
+  async syncVitalsOnly(batch: SingleSyncBatch): Promise<SingleSyncResult> {
+    return this.runSingleSync('syncVitalsOnly', batch, ['spo2_readings', 'hrv_readings', 'temperature_readings'], () =>
+      this.syncVitalsData(batch.userId, UnifiedSmartRingService));
+  }
+
+  async syncActivityOnly(batch: SingleSyncBatch): Promise<SingleSyncResult> {
+    return this.runSingleSync('syncActivityOnly', batch, [], () =>
+      this.syncStepsData(batch.userId, UnifiedSmartRingService));
+  }
+
+  /** 7-day summary sweep over what the batch's syncs stored; no-op when nothing landed. */
+  async finishSingleSyncBatch(batch: SingleSyncBatch): Promise<SingleSyncResult> {
+    if (!batch.landed) return { success: true };
+    try {
+      const summariesOk = await this.updateRecentSummaries(batch.userId);
+      markDeltaStale(['daily_summaries']);
+      if (!summariesOk) return { success: false, error: 'daily summary update failed' };
+      batch.landed = false;
+      return { success: true };
     } catch (e: any) {
-      reportError(e, { op: 'syncSleepOnly' });
+      reportError(e, { op: 'finishSingleSyncBatch' });
       return { success: false, error: e?.message };
     }
   }
 
+  private async runSingleSync(
+    op: string,
+    batch: SingleSyncBatch,
+    tables: DeltaTable[],
+    sync: (syncId: string | null) => Promise<boolean>,
+  ): Promise<SingleSyncResult> {
+    const connectionStatus = await UnifiedSmartRingService.isConnected();
+    if (!connectionStatus.connected) {
+      return { success: false, error: 'NOT_CONNECTED' };
+    }
+    return this.traced(op, async () => {
+      try {
+        batch.syncId ??= this.createSyncRecord(batch.userId);
+        if (!(await sync(await batch.syncId))) {
+          return { success: false, error: `${op}: upload incomplete` };
+        }
+        batch.landed = true;
+        if (tables.length > 0) markDeltaStale(tables);
+        return { success: true };
+      } catch (e: any) {
+        reportError(e, { op });
+        return { success: false, error: e?.message };
+      }
+    });
+  }
+
+  /** ring_syncs row for this sync, with battery and firmware when the ring answers. */
+  private async createSyncRecord(userId: string): Promise<string | null> {
+    // Tolerate failures so sync continues
+    let batteryLevel: number | undefined;
+    let versionStr: string | undefined;
+    try {
+      const battery = await UnifiedSmartRingService.getBattery();
+      batteryLevel = battery?.battery;
+    } catch (e) { console.warn('[Sync] getBattery failed:', (e as Error).message); reportError(e, { op: 'sync.getBattery' }, 'warning'); }
+    try {
+      const version = await UnifiedSmartRingService.getVersion();
+      versionStr = version?.version;
+    } catch (e) { console.warn('[Sync] getVersion failed:', (e as Error).message); reportError(e, { op: 'sync.getVersion' }, 'warning'); }
+
+    return supabaseService.createRingSync(
+      userId,
+      'unknown', // device mac - would come from actual device
+      batteryLevel,
+      versionStr
+    );
+  }
+
+  /**
+   * Update daily summary for today and the past 6 days so the activity detail screen
+   * has real data for historical days (not just today). False if any day failed.
+   */
+  private async updateRecentSummaries(userId: string): Promise<boolean> {
+    const summaryDates: Date[] = [];
+    for (let i = 0; i < 7; i++) {
+      const d = new Date();
+      d.setDate(d.getDate() - i);
+      summaryDates.push(d);
+    }
+    const results = await Promise.all(summaryDates.map(d => this.updateDailySummary(userId, d)));
+    return results.every(Boolean);
+  }
+
+  /**
+   * Run a ring sync inside a `ble.sync` span carrying this sync's share of the
+   * native telemetry (bytes, pages, TTFB, watchdog fires) — see utils/bleSyncStats.
+   */
+  private traced<T>(name: string, run: () => Promise<T>): Promise<T> {
+    return withSpan('ble.sync', name, async setAttributes => {
+      const before = await UnifiedSmartRingService.getSyncStats();
+      try {
+        return await run();
+      } finally {
+        const after = await UnifiedSmartRingService.getSyncStats();
+        if (after) setAttributes(syncStatsDelta(before, after));
+      }
+    });
+  }
+
   // ============================================
   // INDIVIDUAL SYNC FUNCTIONS
   // ============================================
@@ -222,7 +358,7 @@ class DataSyncService {
     userId: string,
     service: typeof UnifiedSmartRingService,
     syncId: string | null
-  ) {
+  ): Promise<boolean> {
     try {
       const today = new Date();
       const todayStr = `${today.getFullYear()}-${String(today.getMonth() + 1).padStart(2, '0')}-${String(today.getDate()).padStart(2, '0')}`;
@@ -289,26 +425,33 @@ class DataSyncService {
 
       if (readings.length > 0) {
         await supabaseService.deleteHeartRateReadingsForRange(userId, startOfToday, endOfToday);
-        await supabaseService.insertHeartRateReadings(readings);
+        return await supabaseService.insertHeartRateReadings(readings);
       }
+      return true;
     } catch (e) {
       console.error('Error syncing heart rate data:', e);
       reportError(e, { op: 'syncHeartRateData' });
+      return false;
     }
   }
 
   private async syncStepsData(
     userId: string,
     service: typeof UnifiedSmartRingService
-  ) {
+  ): Promise<boolean> {
     try {
+      // Per-minute detail history first: days it covers go up as hourly rows below
+      const detail = await service.activityDetail.sync();
+      await service.reclaimer.noteFetched('getDetailActivityData', detail.windows);
+
       // Fetch all historical daily step entries from the ring (SDK stores ~7 days)
       const allDailySteps = await service.getAllDailyStepsHistory();
       const todayStr = new Date().toISOString().split('T')[0];
+      const detailDays = await service.activityDetail.getDays(allDailySteps.map(entry => entry.dateKey));
 
-      // Write one reading per past day (noon timestamp to avoid overlap with today's hourly reads)
+      // Write one reading per past day without detail (noon timestamp to avoid overlap with hourly reads)
       const historicalReadings = allDailySteps
-        .filter(entry => entry.dateKey !== todayStr && entry.steps > 0)
+        .filter(entry => entry.dateKey !== todayStr && entry.steps > 0 && !detailDays.has(entry.dateKey))
         .map(entry => ({
           user_id: userId,
           steps: entry.steps,
@@ -318,39 +461,48 @@ class DataSyncService {
           period_minutes: 1440, // full day
         }));
 
+      let acked = true;
       if (historicalReadings.length > 0) {
-        await supabaseService.insertStepsReadings(historicalReadings);
+        acked = await supabaseService.insertStepsReadings(historicalReadings);
       }
 
-      // Today: write hourly readings for fine-grained aggregation
-      const hourlySteps = await service.get24HourSteps();
-      const stepsData = await service.getSteps();
-
-      if (hourlySteps && hourlySteps.length > 0) {
-        const now = new Date();
-        const readings = hourlySteps
+      // Every day the detail store changed since its last upload, as hourly rows (real per-hour
+      // distance and calories, rolled up once at ingest). Upserts overwrite, so the current
+      // hour and a day re-synced later land with their final values.
+      const uploadStartedAt = Date.now();
+      const pendingDays = await service.activityDetail.pendingUpload();
+      const rollups = await service.activityDetail.getDays(pendingDays);
+      const readings = [...rollups.values()].flatMap(day => {
+        const midnight = parseLocalDate(day.dateKey);
+        return day.hourlySteps
           .map((steps, index) => {
             if (steps === 0) return null;
-            const recordedAt = new Date(now);
+            const recordedAt = new Date(midnight);
             recordedAt.setHours(index, 0, 0, 0);
             return {
               user_id: userId,
               steps,
-              distance_m: stepsData?.distance ? (stepsData.distance * steps) / stepsData.steps : null,
-              calories: stepsData?.calories ? (stepsData.calories * steps) / stepsData.steps : null,
+              distance_m: day.hourlyDistanceM[index],
+              calories: day.hourlyCalories[index],
               recorded_at: recordedAt.toISOString(),
               period_minutes: 60,
             };
           })
           .filter((r): r is NonNullable<typeof r> => r !== null);
+      });
 
-        if (readings.length > 0) {
-          await supabaseService.insertStepsReadings(readings);
-        }
+      const detailAcked = readings.length === 0 || (await supabaseService.insertStepsReadings(readings));
+      // The ring's detail history may only be cleared once every fetched day is on the backend
+      if (detailAcked) {
+        await service.activityDetail.markUploaded(pendingDays, uploadStartedAt);
+        await service.reclaimer.noteAcked('getDetailActivityData', uploadStartedAt);
       }
+      acked = acked && detailAcked;
+      return acked;
     } catch (e) {
       console.error('Error syncing steps data:', e);
       reportError(e, { op: 'syncStepsData' });
+      return false;
     }
   }
 
@@ -425,75 +577,21 @@ class DataSyncService {
       }
     }
 
-    // Parse "YYYY.MM.DD HH:mm:ss" string timestamps
-    const parseStartStr = (str?: string): number | undefined => {
-      if (!str) return undefined;
-      const [d, t] = str.split(' ');
-      if (!d || !t) return undefined;
-      const [y, m, day] = d.split('.').map(Number);
-      const [hh, mm, ss] = t.split(':').map(Number);
-      if ([y, m, day, hh, mm, ss].some(n => Number.isNaN(n))) return undefined;
-      return new Date(y, (m ?? 1) - 1, day, hh, mm, ss).getTime();
-    };
-
-    // Normalize records
-    const normalized = rawRecords.map(r => {
-      const start = r.startTimestamp || parseStartStr(r.startTime_SleepData);
-      const unit = Number(r.sleepUnitLength) || 1;
-      const arr: number[] = r.arraySleepQuality || [];
-      const durationMin = Number(r.totalSleepTime) || arr.length * unit;
-      return { start, unit, arr, durationMin };
-    }).filter(r => typeof r.start === 'number' && r.start > 0);
-
-    if (normalized.length === 0) return;
-
-    // Merge consecutive records with ≤60 min gap into blocks (mirrors deriveFromRaw)
-    const sorted = [...normalized].sort((a, b) => a.start! - b.start!);
-    const MAX_GAP_MS = 60 * 60 * 1000;
-    const blocks: { start: number; end: number; records: typeof normalized }[] = [];
-    let curBlock: typeof blocks[0] | null = null;
-
-    for (const rec of sorted) {
-      const recStart = rec.start!;
-      const recEnd = rec.start! + rec.durationMin * 60000;
-      if (!curBlock) {
-        curBlock = { start: recStart, end: recEnd, records: [rec] };
-      } else if (recStart - curBlock.end <= MAX_GAP_MS) {
-        curBlock.end = Math.max(curBlock.end, recEnd);
-        curBlock.records.push(rec);
-      } else {
-        blocks.push(curBlock);
-        curBlock = { start: recStart, end: recEnd, records: [rec] };
+    // X3: fold new per-minute overnight SpO2 / sleep+activity into the local store so
+    // night sessions below carry their breathing summary
+    if (!v8Svc) {
+      try {
+        await service.syncOvernight();
+      } catch (e) {
+        reportError(e, { op: 'syncSleepData.syncOvernight' }, 'warning');
       }
     }
-    if (curBlock) blocks.push(curBlock);
-
-    // Build per-minute timeline and compute stage minutes for a merged block.
-    // SDK encoding: 1=Deep, 2=Light, 3=REM, other=Awake (matches useHomeData mapSleepType).
-    const computeStageMins = (block: typeof blocks[0]) => {
-      const totalMin = Math.max(0, Math.round((block.end - block.start) / 60000));
-      const timeline = new Array(totalMin).fill(0);
-      for (const rec of block.records) {
-        const offset = Math.round((rec.start! - block.start) / 60000);
-        const unit = Math.max(1, rec.unit);
-        rec.arr.forEach((val: number, idx: number) => {
-          // Map SDK val → timeline value: deep=3, rem=2, light=1, awake=0
-          const tv = val === 1 ? 3 : val === 3 ? 2 : val === 2 ? 1 : 0;
-          for (let k = 0; k < unit; k++) {
-            const pos = offset + idx * unit + k;
-            if (pos >= 0 && pos < timeline.length) timeline[pos] = tv;
-          }
-        });
-      }
-      let deep = 0, rem = 0, light = 0, awake = 0;
-      for (const v of timeline) {
-        if (v === 3) deep++;
-        else if (v === 2) rem++;
-        else if (v === 1) light++;
-        else awake++;
-      }
-      return { deep, light, rem, awake };
-    };
+
+    // Merge into sessions (shared with the home screen; see SleepSegmentation)
+    sleepSegmenter.addRingRecords(rawRecords);
+    const blocks = sleepSegmenter.sessions().filter(s => s.records.length > 0);
+
+    if (blocks.length === 0) return;
 
     // Sync up to 7 days — match each block to the day it ENDS on (wake-up date)
     for (let dayIndex = 0; dayIndex < 7; dayIndex++) {
@@ -521,37 +619,22 @@ class DataSyncService {
         const endTime = new Date(block.end);
 
         // Duration gate — ring sometimes reports 20-25h cumulative sessions
-        const durationHours = (block.end - block.start) / (1000 * 60 * 60);
-        if (durationHours > 14) {
+        if (block.end - block.start > MAX_SESSION_MS) {
           continue;
         }
 
-        const { deep, light, rem, awake } = computeStageMins(block);
+        const { deep, light, rem, awake } = block.stages;
 
         if (deep === 0 && light === 0 && rem === 0) {
           continue;
         }
-        // Classify as night or nap
+        // Night or nap, classified against the previous night in the same sweep
         const totalSleepMin = deep + light + rem;
-        const priorNightEnd = await supabaseService.getLatestNightSessionEndTime(userId);
-        const classification = classifySleepSession(startTime, endTime, totalSleepMin, priorNightEnd);
+        const classification = { sessionType: block.sessionType, reason: block.reason };
 
         // Extract resting HR from the raw records belonging to this sleep block.
         // Done early so it's available for both new inserts and back-fill of existing sessions.
-        const blockRawRecords = rawRecords.filter((r: any) => {
-          const ts = r.startTimestamp || (() => {
-            const s = r.startTime_SleepData;
-            if (!s) return undefined;
-            const [d, t] = String(s).split(' ');
-            if (!d || !t) return undefined;
-            const [y, m, day] = d.split('.').map(Number);
-            const [hh, mm, ss] = t.split(':').map(Number);
-            if ([y, m, day, hh, mm, ss].some(n => Number.isNaN(n))) return undefined;
-            return new Date(y, (m ?? 1) - 1, day, hh, mm, ss).getTime();
-          })();
-          return typeof ts === 'number' && ts >= block.start && ts <= block.end;
-        });
-        const { restingHR, respiratoryRate } = extractSleepVitalsFromRaw(blockRawRecords.length > 0 ? blockRawRecords : rawRecords);
+        const { restingHR, respiratoryRate } = extractSleepVitalsFromRaw(block.records.map(rec => rec.raw));
 
         // Overlap guard — skip only if the existing session already has >= sleep minutes.
         // If the new block has more data (e.g. full night vs. partial mid-sleep sync), replace it.
@@ -596,9 +679,23 @@ class DataSyncService {
           sleepUnitLength: rec.unit,
           arraySleepQuality: rec.arr,
         }));
+        const night = classification.sessionType === 'night'
+          ? await service.overnight.getNight(localDateKey(endTime)).catch(() => null)
+          : null;
+        const breathing = night && night.spo2Minutes > 0
+          ? {
+              overnightSpo2: {
+                avg: night.spo2Avg,
+                min: night.spo2Min,
+                minutesBelow90: night.minutesBelow90,
+                odi: night.odi,
+              },
+            }
+          : {};
+        const extras = { ...(respiratoryRate > 0 ? { respiratoryRate } : {}), ...breathing };
         const detailJson = rawQualityRecords.length > 0
-          ? { rawQualityRecords, ...(respiratoryRate > 0 ? { respiratoryRate } : {}) }
-          : (respiratoryRate > 0 ? { respiratoryRate } : null);
+          ? { rawQualityRecords, ...extras }
+          : (Object.keys(extras).length > 0 ? extras : null);
 
         const napScore = classification.sessionType === 'nap'
           ? calculateNapScore(totalSleepMin, deep, light, rem, awake)
@@ -634,24 +731,71 @@ class DataSyncService {
   private async syncVitalsData(
     userId: string,
     service: typeof UnifiedSmartRingService
-  ) {
+  ): Promise<boolean> {
     try {
       const now = new Date().toISOString();
+      let stored = true;
 
       // SpO2
       const spo2Data = await service.getSpO2();
       if (spo2Data) {
-        await supabaseService.insertSpO2Readings([{
+        stored = await supabaseService.insertSpO2Readings([{
           user_id: userId,
           spo2: spo2Data.spo2,
           recorded_at: now,
         }]);
       }
 
+      // X3 overnight trace (5-minute means) so the daily summary's SpO2 avg/min cover the night
+      // (shares the in-flight overnight sync started by syncSleepData). Every night since the
+      // last acked upload is sent. The ack is only this upload's cursor: daytime and per-minute
+      // samples never leave the ring, so the reclaimer doesn't clear this type by default.
+      const overnight = await service.syncOvernight().catch(() => null);
+      const spo2Fetched = !!overnight && !overnight.failed.includes('spo2');
+      if (spo2Fetched) {
+        await service.reclaimer.noteFetched('getContinuousSpO2Data', overnight.spo2Records);
+      }
+      const uploadStartedAt = Date.now();
+      const ackedThrough = await service.reclaimer.ackedThrough('getContinuousSpO2Data');
+      // Nights are keyed by wake date, so anything recorded after noon lands in tomorrow's
+      const DAY_MS = 24 * 60 * 60 * 1000;
+      const nightKeys: string[] = [];
+      const day = new Date(spo2Fetched ? Math.max(ackedThrough ?? 0, uploadStartedAt - 13 * DAY_MS) : uploadStartedAt);
+      const lastKey = localDateKey(new Date(uploadStartedAt + DAY_MS));
+      for (; localDateKey(day) <= lastKey; day.setDate(day.getDate() + 1)) {
+        nightKeys.push(localDateKey(day));
+      }
+      const readings: { user_id: string; spo2: number; recorded_at: string }[] = [];
+      for (const nightKey of nightKeys) {
+        const night = await service.overnight.getSeries(nightKey).catch(() => null);
+        if (!night) continue;
+        for (let slot = 0; slot < night.spo2.length; slot += 5) {
+          let sum = 0;
+          let n = 0;
+          for (let i = slot; i < slot + 5 && i < night.spo2.length; i++) {
+            if (night.spo2[i] > 0) {
+              sum += night.spo2[i];
+              n++;
+            }
+          }
+          if (n === 0) continue;
+          readings.push({
+            user_id: userId,
+            spo2: Math.round(sum / n),
+            recorded_at: new Date(night.startMs + slot * 60_000).toISOString(),
+          });
+        }
+      }
+      const spo2Acked = readings.length === 0 || await supabaseService.insertSpO2Readings(readings);
+      if (spo2Fetched && spo2Acked) {
+        await service.reclaimer.noteAcked('getContinuousSpO2Data', uploadStartedAt);
+      }
+      stored = spo2Acked && stored;
+
       // HRV
       const hrvData = await service.getHRVData();
       if (hrvData) {
-        await supabaseService.insertHRVReadings([{
+        stored = (await supabaseService.insertHRVReadings([{
           user_id: userId,
           sdnn: hrvData.sdnn,
           rmssd: hrvData.rmssd,
@@ -660,31 +804,33 @@ class DataSyncService {
           hf: hrvData.hf,
           lf_hf_ratio: hrvData.lfHfRatio,
           recorded_at: now,
-        }]);
+        }])) && stored;
       }
 
       // Stress
       const stressData = await service.getStressData();
       if (stressData) {
-        await supabaseService.insertStressReadings([{
+        stored = (await supabaseService.insertStressReadings([{
           user_id: userId,
           stress_level: stressData.level,
           recorded_at: now,
-        }]);
+        }])) && stored;
       }
 
       // Temperature
       const tempData = await service.getTemperature();
       if (tempData) {
-        await supabaseService.insertTemperatureReadings([{
+        stored = (await supabaseService.insertTemperatureReadings([{
           user_id: userId,
           temperature_c: tempData.temperature,
           recorded_at: now,
-        }]);
+        }])) && stored;
       }
+      return stored;
     } catch (e) {
       console.error('Error syncing vitals data:', e);
       reportError(e, { op: 'syncVitalsData' });
+      return false;
     }
   }
 
@@ -0,0 +1,308 @@
+/**
+ * DeltaSyncService — per-table change cursors + local day-bucketed row cache.
+ *
+ * Detail screens and baseline bootstrap used to re-read 7–30 days of rows on
+ * every mount. This keeps those rows in AsyncStorage keyed by
+ * user/table/day and, on each request, only asks Supabase for rows whose
+ * `updated_at` moved past the stored cursor.
+ *
+ *   hit   — cache covers the range and was revalidated < MIN_RECHECK_MS ago → no network
+ *   delta — cache covers the range → fetch `updated_at >= cursor - overlap`, merge by id
+ *   full  — cold cache, wider range, or FULL_REVALIDATE_MS elapsed → one ranged read
+ *
+ * The periodic full read also picks up server-side deletes, which cursors can't see.
+ * Requires migration 20260503120000_delta_sync_updated_at.sql.
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+import { supabase } from './SupabaseService';
+import { addBreadcrumb, reportError } from '../utils/sentry';
+
+export type DeltaTable =
+  | 'sleep_sessions'
+  | 'heart_rate_readings'
+  | 'hrv_readings'
+  | 'spo2_readings'
+  | 'temperature_readings'
+  | 'daily_summaries';
+
+export type DeltaRow = Record<string, any> & { id: string; updated_at: string };
+
+/**
+ * Column superset cached per table. Every caller reads from the same cache,
+ * so filters like session_type or readiness_score IS NOT NULL are applied
+ * client-side rather than baked into the cached rows.
+ */
+const TABLES: Record<DeltaTable, { columns: string; timeColumn: string; dateOnly?: boolean }> = {
+  sleep_sessions: { columns: '*', timeColumn: 'start_time' },
+  heart_rate_readings: { columns: 'id, heart_rate, recorded_at, updated_at', timeColumn: 'recorded_at' },
+  hrv_readings: { columns: 'id, sdnn, rmssd, pnn50, lf, hf, lf_hf_ratio, recorded_at, updated_at', timeColumn: 'recorded_at' },
+  spo2_readings: { columns: 'id, spo2, recorded_at, updated_at', timeColumn: 'recorded_at' },
+  temperature_readings: { columns: 'id, temperature_c, recorded_at, updated_at', timeColumn: 'recorded_at' },
+  daily_summaries: { columns: '*', timeColumn: 'date', dateOnly: true },
+};
+
+const KEY_PREFIX = 'delta_sync_v1';
+const PAGE_SIZE = 1000;
+// Re-reading the same table within this window (tab switches) costs nothing
+const MIN_RECHECK_MS = 30 * 1000;
+// Full ranged read at most once a day to reconcile deletes
+const FULL_REVALIDATE_MS = 24 * 60 * 60 * 1000;
+// Cursor overlap absorbs commit-order skew between concurrent writers
+const CURSOR_OVERLAP_MS = 5 * 60 * 1000;
+// Day buckets older than this are evicted on write
+const MAX_CACHED_DAYS = 45;
+
+interface CursorMeta {
+  cursor: string | null;      // max(updated_at) seen
+  coveredFrom: string | null; // oldest day key the cache is complete for
+  fullAt: number;             // last full ranged read (epoch ms)
+  checkedAt: number;          // last network revalidation (epoch ms)
+  days: string[];             // day keys persisted for this user/table
+}
+
+interface Entry {
+  meta: CursorMeta;
+  days: Map<string, Map<string, DeltaRow>>;
+}
+
+const memory = new Map<string, Entry>();
+const inflight = new Map<string, Promise<DeltaRow[]>>();
+// Serializes syncs per user/table so two ranges never mutate one entry at once
+const tableChain = new Map<string, Promise<unknown>>();
+
+function metaKey(userId: string, table: DeltaTable): string {
+  return `${KEY_PREFIX}:${userId}:${table}`;
+}
+
+function dayStorageKey(userId: string, table: DeltaTable, day: string): string {
+  return `${KEY_PREFIX}:${userId}:${table}:${day}`;
+}
+
+function localDateStr(d: Date): string {
+  return `${d.getFullYear()}-${String(d.getMonth() + 1).padStart(2, '0')}-${String(d.getDate()).padStart(2, '0')}`;
+}
+
+/** Bucket key for a row. Timestamp tables bucket by UTC day; date tables by their own date. */
+function rowDay(table: DeltaTable, row: DeltaRow): string {
+  return String(row[TABLES[table].timeColumn] ?? '').slice(0, 10);
+}
+
+function sinceDay(table: DeltaTable, since: Date): string {
+  return TABLES[table].dateOnly ? localDateStr(since) : since.toISOString().slice(0, 10);
+}
+
+async function loadEntry(userId: string, table: DeltaTable): Promise<Entry> {
+  const mk = metaKey(userId, table);
+  const cached = memory.get(mk);
+  if (cached) return cached;
+
+  const entry: Entry = {
+    meta: { cursor: null, coveredFrom: null, fullAt: 0, checkedAt: 0, days: [] },
+    days: new Map(),
+  };
+  try {
+    const rawMeta = await AsyncStorage.getItem(mk);
+    if (rawMeta) {
+      entry.meta = { ...entry.meta, ...(JSON.parse(rawMeta) as Partial<CursorMeta>) };
+      const pairs = await AsyncStorage.multiGet(entry.meta.days.map(d => dayStorageKey(userId, table, d)));
+      pairs.forEach(([, raw], i) => {
+        if (!raw) return;
+        const rows = JSON.parse(raw) as DeltaRow[];
+        entry.days.set(entry.meta.days[i], new Map(rows.map(r => [r.id, r])));
+      });
+    }
+  } catch (e) {
+    reportError(e, { op: 'deltaSync.load', table }, 'warning');
+    entry.meta = { cursor: null, coveredFrom: null, fullAt: 0, checkedAt: 0, days: [] };
+    entry.days.clear();
+  }
+  memory.set(mk, entry);
+  return entry;
+}
+
+async function persist(userId: string, table: DeltaTable, entry: Entry, dirty: Set<string>, removed: string[]): Promise<void> {
+  try {
+    const sets: [string, string][] = [[metaKey(userId, table), JSON.stringify(entry.meta)]];
+    for (const day of dirty) {
+      const bucket = entry.days.get(day);
+      if (bucket) sets.push([dayStorageKey(userId, table, day), JSON.stringify(Array.from(bucket.values()))]);
+    }
+    await AsyncStorage.multiSet(sets);
+    if (removed.length > 0) {
+      await AsyncStorage.multiRemove(removed.map(d => dayStorageKey(userId, table, d)));
+    }
+  } catch (e) {
+    reportError(e, { op: 'deltaSync.persist', table }, 'warning');
+  }
+}
+
+/** Paged read so a 30-day HR window isn't silently truncated at PostgREST's row cap. */
+async function fetchPaged(
+  userId: string,
+  table: DeltaTable,
+  apply: (q: any) => any,
+  orderColumn: string,
+): Promise<DeltaRow[]> {
+  const out: DeltaRow[] = [];
+  for (let from = 0; ; from += PAGE_SIZE) {
+    const base = supabase.from(table as any).select(TABLES[table].columns).eq('user_id', userId);
+    const { data, error } = await apply(base)
+      .order(orderColumn, { ascending: true })
+      .order('id', { ascending: true })
+      .range(from, from + PAGE_SIZE - 1);
+    if (error) throw error;
+    const page = (data ?? []) as DeltaRow[];
+    out.push(...page);
+    if (page.length < PAGE_SIZE) return out;
+  }
+}
+
+function maxCursor(current: string | null, rows: DeltaRow[]): string | null {
+  let best = current ? Date.parse(current) : -Infinity;
+  let bestStr = current;
+  for (const r of rows) {
+    const t = Date.parse(r.updated_at);
+    if (t > best) { best = t; bestStr = r.updated_at; }
+  }
+  return bestStr;
+}
+
+async function syncTable(userId: string, table: DeltaTable, since: Date): Promise<DeltaRow[]> {
+  const t0 = Date.now();
+  const cfg = TABLES[table];
+  const fromDay = sinceDay(table, since);
+  const entry = await loadEntry(userId, table);
+  const { meta } = entry;
+
+  const covered = meta.cursor !== null
+    && meta.coveredFrom !== null
+    && meta.coveredFrom <= fromDay
+    && t0 - meta.fullAt < FULL_REVALIDATE_MS;
+
+  let mode: 'hit' | 'delta' | 'full' = 'hit';
+  let fetched = 0;
+  const dirty = new Set<string>();
+  const removed: string[] = [];
+
+  try {
+    if (covered && t0 - meta.checkedAt < MIN_RECHECK_MS) {
+      mode = 'hit';
+    } else if (covered) {
+      mode = 'delta';
+      const after = new Date(Date.parse(meta.cursor!) - CURSOR_OVERLAP_MS).toISOString();
+      const changed = await fetchPaged(userId, table, q => q.gte('updated_at', after), 'updated_at');
+      fetched = changed.length;
+      for (const row of changed) {
+        // A row may have moved days (edited start_time) — drop any stale copy first
+        for (const [day, bucket] of entry.days) {
+          if (bucket.delete(row.id)) dirty.add(day);
+        }
+        const day = rowDay(table, row);
+        if (day < meta.coveredFrom!) continue;
+        if (!entry.days.has(day)) entry.days.set(day, new Map());
+        entry.days.get(day)!.set(row.id, row);
+        dirty.add(day);
+      }
+      meta.cursor = maxCursor(meta.cursor, changed);
+      meta.checkedAt = t0;
+    } else {
+      mode = 'full';
+      const lower = cfg.dateOnly ? fromDay : `${fromDay}T00:00:00Z`;
+      const rows = await fetchPaged(userId, table, q => q.gte(cfg.timeColumn, lower), cfg.timeColumn);
+      fetched = rows.length;
+      removed.push(...entry.days.keys());
+      entry.days.clear();
+      for (const row of rows) {
+        const day = rowDay(table, row);
+        if (!entry.days.has(day)) entry.days.set(day, new Map());
+        entry.days.get(day)!.set(row.id, row);
+        dirty.add(day);
+      }
+      meta.cursor = maxCursor(null, rows) ?? new Date(t0).toISOString();
+      meta.coveredFrom = fromDay;
+      meta.fullAt = t0;
+      meta.checkedAt = t0;
+    }
+  } catch (e) {
+    // Serve whatever is cached; the next mount retries the network leg
+    reportError(e, { op: 'deltaSync.fetch', table, mode }, 'warning');
+    addBreadcrumb('sync.delta', `${table} error`, { table, mode, cachedDays: entry.days.size }, 'warning');
+  }
+
+  if (mode !== 'hit') {
+    // Evict buckets past the retention horizon
+    const horizon = new Date(t0);
+    horizon.setDate(horizon.getDate() - MAX_CACHED_DAYS);
+    const horizonDay = horizon.toISOString().slice(0, 10);
+    for (const day of Array.from(entry.days.keys())) {
+      if (day < horizonDay) {
+        entry.days.delete(day);
+        dirty.delete(day);
+        removed.push(day);
+      }
+    }
+    const kept = new Set(entry.days.keys());
+    meta.days = Array.from(kept);
+    if (meta.coveredFrom !== null && meta.coveredFrom < horizonDay) meta.coveredFrom = horizonDay;
+    await persist(userId, table, entry, dirty, removed.filter(d => !kept.has(d)));
+  }
+
+  const sinceMs = since.getTime();
+  const out: DeltaRow[] = [];
+  for (const [day, bucket] of entry.days) {
+    if (day < fromDay) continue;
+    for (const row of bucket.values()) {
+      if (!cfg.dateOnly && Date.parse(row[cfg.timeColumn]) < sinceMs) continue;
+      out.push(row);
+    }
+  }
+  out.sort((a, b) => String(a[cfg.timeColumn]).localeCompare(String(b[cfg.timeColumn])));
+
+  addBreadcrumb('sync.delta', `${table} ${mode}`, {
+    table,
+    mode,
+    hit: mode === 'hit',
+    fetched,
+    returned: out.length,
+    cachedDays: entry.days.size,
+    ms: Date.now() - t0,
+  });
+  return out;
+}
+
+/**
+ * Rows for `table` with time column ≥ `since`, ascending by time.
+ * Concurrent callers for the same user/table share one network leg.
+ */
+export function getRowsSince(userId: string, table: DeltaTable, since: Date): Promise<DeltaRow[]> {
+  const mk = metaKey(userId, table);
+  const key = `${mk}@${sinceDay(table, since)}`;
+  const pending = inflight.get(key);
+  if (pending) return pending;
+  const p = (tableChain.get(mk) ?? Promise.resolve())
+    .catch(() => {})
+    .then(() => syncTable(userId, table, since))
+    .finally(() => inflight.delete(key));
+  inflight.set(key, p);
+  tableChain.set(mk, p);
+  return p;
+}
+
+/** Force the next read of these tables to revalidate (e.g. right after a ring sync). */
+export function markDeltaStale(tables?: DeltaTable[]): void {
+  for (const [key, entry] of memory) {
+    if (!tables || tables.some(t => key.endsWith(`:${t}`))) entry.meta.checkedAt = 0;
+  }
+}
+
+/** Drop every cached bucket (sign-out). */
+export async function clearDeltaCache(): Promise<void> {
+  memory.clear();
+  try {
+    const keys = (await AsyncStorage.getAllKeys()).filter(k => k.startsWith(`${KEY_PREFIX}:`));
+    if (keys.length > 0) await AsyncStorage.multiRemove(keys);
+  } catch (e) {
+    reportError(e, { op: 'deltaSync.clear' }, 'warning');
+  }
+}
@@ -0,0 +1,296 @@
+/**
+ * DeviceConfigStore — keeps ring settings in sync without rewriting them on every connect
+ *
+ * Two models, both persisted:
+ *   desired — what the app wants on any ring (auto HR schedule, profile, step goal, clock
+ *             time zone). User-level, shared across devices.
+ *   actual  — what a given ring last reported or acknowledged, cached per device id under
+ *             a schema version; a version bump or a stale entry makes the next apply()
+ *             read the ring again.
+ *
+ * apply() reads only the fields the cache doesn't know (once per device, then every
+ * maxAgeMs), diffs desired against actual, and writes the changed fields back to back in
+ * one burst. A reconnect with nothing changed costs no BLE traffic.
+ *
+ * The clock's "actual" is the time zone it was last set in. It is rewritten when that
+ * differs or the last write is older than clockMaxAgeMs. On the first apply for a ring in
+ * each app session it is also checked, since the ring may have run flat: read where the
+ * transport can and rewritten if off by more than clockMaxDriftMs, rewritten otherwise.
+ *
+ * No React Native imports: the ring transport and storage are injected.
+ */
+
+import type { ActivityDetailStorage } from './ActivityDetailStore';
+
+const DESIRED_KEY = 'device_config_v1_desired';
+const ACTUAL_KEY_PREFIX = 'device_config_v1:';
+/** Bump when a field's shape or meaning changes; older cached entries are re-read. */
+export const DEVICE_CONFIG_VERSION = 1;
+const DAY_MS = 24 * 60 * 60 * 1000;
+
+export interface AutoMonitoringConfig {
+  enabled: boolean;
+  /** "HH:mm" */
+  startTime: string;
+  endTime: string;
+  /** Bit 0 = Sunday ... bit 6 = Saturday. */
+  weeks: number;
+  intervalMinutes: number;
+}
+
+export interface ProfileConfig {
+  gender: 'male' | 'female';
+  age: number;
+  height: number;
+  weight: number;
+  stride: number;
+}
+
+export interface DeviceConfig {
+  autoHr?: AutoMonitoringConfig;
+  profile?: ProfileConfig;
+  stepGoal?: number;
+  clockTz?: string;
+}
+
+export type DeviceConfigField = keyof DeviceConfig;
+
+const FIELDS: DeviceConfigField[] = ['clockTz', 'autoHr', 'profile', 'stepGoal'];
+
+/** What the app wrote on every connect before this store existed: 24/7 HR every 5 minutes. */
+export const DEFAULT_AUTO_HR: AutoMonitoringConfig = {
+  enabled: true,
+  startTime: '00:00',
+  endTime: '23:59',
+  weeks: 0x7f,
+  intervalMinutes: 5,
+};
+
+/**
+ * The connected ring's readers and writers. A missing reader means the field is
+ * write-only; a missing writer means the device doesn't support it.
+ */
+export interface DeviceConfigTransport {
+  deviceId: string;
+  read: { [K in DeviceConfigField]?: () => Promise<DeviceConfig[K] | null> };
+  write: { [K in DeviceConfigField]?: (value: NonNullable<DeviceConfig[K]>) => Promise<unknown> };
+  /** The ring's current time as epoch ms, null if it can't be parsed. */
+  readClock?: () => Promise<number | null>;
+}
+
+interface CachedConfig {
+  version: number;
+  actual: DeviceConfig;
+  /** Per field: when it was last read from or written to the ring. */
+  syncedAt: Partial<Record<DeviceConfigField, number>>;
+}
+
+export interface DeviceConfigApplyResult {
+  deviceId: string | null;
+  read: DeviceConfigField[];
+  wrote: DeviceConfigField[];
+  failed: { field: DeviceConfigField; error: string }[];
+}
+
+export interface DeviceConfigStoreOptions {
+  now?: () => number;
+  /** Re-read a cached field after this long, in case another app changed it. */
+  maxAgeMs?: number;
+  clockMaxAgeMs?: number;
+  /** Rewrite the clock when the ring's reported time is further off than this. */
+  clockMaxDriftMs?: number;
+  /** Desired values that come from the phone rather than storage (the current time zone). */
+  liveDesired?: () => Partial<DeviceConfig>;
+}
+
+export class DeviceConfigStore {
+  private readonly getTransport: () => Promise<DeviceConfigTransport | null>;
+  private readonly storage: ActivityDetailStorage;
+  private readonly now: () => number;
+  private readonly maxAgeMs: number;
+  private readonly clockMaxAgeMs: number;
+  private readonly clockMaxDriftMs: number;
+  private readonly liveDesired: () => Partial<DeviceConfig>;
+
+  private desired: DeviceConfig | null = null;
+  private cache = new Map<string, CachedConfig>();
+  /** Devices whose clock was read or written since launch. */
+  private clockCheckedThisSession = new Set<string>();
+  private inFlight: Promise<DeviceConfigApplyResult> | null = null;
+  private rerun = false;
+
+  constructor(
+    getTransport: () => Promise<DeviceConfigTransport | null>,
+    storage: ActivityDetailStorage,
+    options: DeviceConfigStoreOptions = {},
+  ) {
+    this.getTransport = getTransport;
+    this.storage = storage;
+    this.now = options.now ?? Date.now;
+    this.maxAgeMs = options.maxAgeMs ?? 7 * DAY_MS;
+    this.clockMaxAgeMs = options.clockMaxAgeMs ?? DAY_MS;
+    this.clockMaxDriftMs = options.clockMaxDriftMs ?? 60 * 1000;
+    this.liveDesired = options.liveDesired ?? (() => ({}));
+  }
+
+  async getDesired(): Promise<DeviceConfig> {
+    return { ...(await this.loadDesired()), ...this.liveDesired() };
+  }
+
+  /** Update the desired config; call apply() to push it to a connected ring. */
+  async setDesired(patch: DeviceConfig): Promise<void> {
+    const desired = { ...(await this.loadDesired()), ...patch };
+    this.desired = desired;
+    // A pass already running read the old desired config; have it go round once more
+    if (this.inFlight) this.rerun = true;
+    await this.storage.setItem(DESIRED_KEY, JSON.stringify(desired));
+  }
+
+  /** Last value the ring reported or acknowledged for `deviceId`, without touching BLE. */
+  async getActual(deviceId: string): Promise<DeviceConfig> {
+    return { ...(await this.loadCached(deviceId)).actual };
+  }
+
+  /** Forget what a ring holds (factory reset, unpair); the next apply() reads it again. */
+  async invalidate(deviceId: string): Promise<void> {
+    this.cache.delete(deviceId);
+    await this.storage.multiRemove([ACTUAL_KEY_PREFIX + deviceId]);
+  }
+
+  /**
+   * Bring the connected ring in line with the desired config. Concurrent calls share one
+   * pass; a setDesired() during the pass makes it run once more before resolving.
+   */
+  apply(): Promise<DeviceConfigApplyResult> {
+    if (this.inFlight) return this.inFlight;
+    this.inFlight = (async () => {
+      let result: DeviceConfigApplyResult;
+      do {
+        this.rerun = false;
+        result = await this.runApply();
+      } while (this.rerun);
+      return result;
+    })().finally(() => {
+      this.inFlight = null;
+    });
+    return this.inFlight;
+  }
+
+  private async runApply(): Promise<DeviceConfigApplyResult> {
+    const transport = await this.getTransport();
+    const result: DeviceConfigApplyResult = { deviceId: transport?.deviceId ?? null, read: [], wrote: [], failed: [] };
+    if (!transport) return result;
+
+    const desired = await this.getDesired();
+    const cached = await this.loadCached(transport.deviceId);
+    const fields = FIELDS.filter(f => desired[f] !== undefined && transport.write[f]);
+
+    // Read phase: only fields the cache can't vouch for
+    for (const field of fields) {
+      const reader = transport.read[field];
+      if (!reader || this.isFresh(cached, field, this.maxAgeMs)) continue;
+      try {
+        const value = await reader();
+        result.read.push(field);
+        if (value === null || value === undefined) delete cached.actual[field];
+        else (cached.actual as Record<string, unknown>)[field] = value;
+        cached.syncedAt[field] = this.now();
+      } catch {
+        // Unknown state: the diff below writes the field, which is always safe
+        delete cached.actual[field];
+      }
+    }
+
+    // A ring that lost power restarts from its epoch with the time zone unchanged; check
+    // once per session, asking the ring when it can tell and rewriting blind otherwise
+    let clockDrifted = false;
+    if (
+      fields.includes('clockTz') &&
+      !this.clockCheckedThisSession.has(transport.deviceId) &&
+      !this.needsWrite(cached, desired, 'clockTz')
+    ) {
+      clockDrifted = true;
+      if (transport.readClock) {
+        try {
+          const ringMs = await transport.readClock();
+          result.read.push('clockTz');
+          clockDrifted = ringMs === null || Math.abs(ringMs - this.now()) > this.clockMaxDriftMs;
+          if (!clockDrifted) this.clockCheckedThisSession.add(transport.deviceId);
+        } catch {
+          // Unknown state: rewrite
+        }
+      }
+    }
+
+    // Write phase: one burst of just the changed fields
+    for (const field of fields) {
+      if (!(field === 'clockTz' && clockDrifted) && !this.needsWrite(cached, desired, field)) continue;
+      const value = desired[field]!;
+      try {
+        await (transport.write[field] as (v: unknown) => Promise<unknown>)(value);
+        (cached.actual as Record<string, unknown>)[field] = value;
+        cached.syncedAt[field] = this.now();
+        if (field === 'clockTz') this.clockCheckedThisSession.add(transport.deviceId);
+        result.wrote.push(field);
+      } catch (e) {
+        delete cached.actual[field];
+        delete cached.syncedAt[field];
+        result.failed.push({ field, error: (e as Error)?.message ?? String(e) });
+      }
+    }
+
+    if (result.read.length || result.wrote.length || result.failed.length) {
+      await this.storage.setItem(ACTUAL_KEY_PREFIX + transport.deviceId, JSON.stringify(cached));
+    }
+    return result;
+  }
+
+  private needsWrite(cached: CachedConfig, desired: DeviceConfig, field: DeviceConfigField): boolean {
+    if (!sameValue(cached.actual[field], desired[field])) return true;
+    // Same zone still drifts
+    return field === 'clockTz' && !this.isFresh(cached, field, this.clockMaxAgeMs);
+  }
+
+  private isFresh(cached: CachedConfig, field: DeviceConfigField, maxAgeMs: number): boolean {
+    const at = cached.syncedAt[field];
+    return cached.actual[field] !== undefined && at !== undefined && this.now() - at < maxAgeMs;
+  }
+
+  private async loadDesired(): Promise<DeviceConfig> {
+    if (!this.desired) {
+      const raw = await this.storage.getItem(DESIRED_KEY);
+      try {
+        this.desired = raw ? JSON.parse(raw) : {};
+      } catch {
+        this.desired = {};
+      }
+      this.desired = { autoHr: DEFAULT_AUTO_HR, ...this.desired };
+    }
+    return this.desired!;
+  }
+
+  private async loadCached(deviceId: string): Promise<CachedConfig> {
+    let cached = this.cache.get(deviceId);
+    if (!cached) {
+      const raw = await this.storage.getItem(ACTUAL_KEY_PREFIX + deviceId);
+      try {
+        const parsed = raw ? (JSON.parse(raw) as CachedConfig) : null;
+        if (parsed?.version === DEVICE_CONFIG_VERSION) cached = parsed;
+      } catch {
+        // Corrupt entry: start over, costing one read pass
+      }
+      cached ??= { version: DEVICE_CONFIG_VERSION, actual: {}, syncedAt: {} };
+      this.cache.set(deviceId, cached);
+    }
+    return cached;
+  }
+}
+
+function sameValue(a: unknown, b: unknown): boolean {
+  if (a === b) return true;
+  if (typeof a !== 'object' || typeof b !== 'object' || a === null || b === null) return false;
+  const ka = Object.keys(a as object);
+  const kb = Object.keys(b as object);
+  if (ka.length !== kb.length) return false;
+  return ka.every(k => sameValue((a as Record<string, unknown>)[k], (b as Record<string, unknown>)[k]));
+}
@@ -0,0 +1,255 @@
+/**
+ * AnchoredSampleStore — incremental HealthKit reads via anchored queries
+ *
+ * Each registered sample type keeps its HealthKit anchor and a local cache of
+ * compact samples (trimmed to the type's retention window). A read sends the
+ * anchor, gets back only what was added or deleted since then, merges that into
+ * the cache and answers from the cache. The very first read of a type (no anchor)
+ * pulls the whole retention window once.
+ *
+ * Reads issued in the same tick are batched: one storage multiGet for the cached
+ * states, the HealthKit queries in parallel, one multiSet with every new anchor,
+ * and one metrics record for the whole batch.
+ *
+ * This file has no React Native imports. The HealthKit adapter and the
+ * key-value storage are injected, so it runs under Node against a mock adapter
+ * (scripts/sim-healthkit-anchors.ts).
+ */
+
+const KEY_PREFIX = 'hk_anchor_v1:';
+
+/** Every cached sample is at least this; specs add whatever their readers need. */
+export interface AnchoredItem {
+  uuid: string;
+  startMs: number;
+  endMs: number;
+}
+
+export type AnchoredKind = 'quantity' | 'category' | 'workout';
+
+export interface AnchoredTypeSpec<T extends AnchoredItem = AnchoredItem> {
+  /** Short id used for storage keys, metrics and `read()`. */
+  id: string;
+  kind: AnchoredKind;
+  /** HealthKit type identifier (unused for workouts). */
+  identifier: string;
+  /** Samples ending before now − retentionMs are dropped; reads older than that fall back. */
+  retentionMs: number;
+  map: (raw: any) => T | null;
+}
+
+export interface AnchoredDelta {
+  samples: unknown[];
+  deletedUuids: string[];
+  newAnchor: string;
+}
+
+export interface AnchoredQueryAdapter {
+  /**
+   * Samples added since `anchor` that end after `from`, plus deletions.
+   * Deliberately no upper bound: a sample stamped later than "now" would
+   * otherwise fall behind the new anchor and never be returned.
+   */
+  query(spec: AnchoredTypeSpec, anchor: string | null, from: Date): Promise<AnchoredDelta>;
+}
+
+/** The subset of AsyncStorage the store uses. */
+export interface AnchoredStorage {
+  multiGet(keys: readonly string[]): Promise<readonly (readonly [string, string | null])[]>;
+  multiSet(pairs: [string, string][]): Promise<void>;
+  getAllKeys(): Promise<readonly string[]>;
+  multiRemove(keys: readonly string[]): Promise<void>;
+}
+
+export interface AnchoredTypeMetric {
+  id: string;
+  /** No anchor yet — the whole retention window was fetched. */
+  full: boolean;
+  added: number;
+  deleted: number;
+  cached: number;
+  ms: number;
+  error?: string;
+}
+
+export interface AnchoredBatchMetrics {
+  at: number;
+  ms: number;
+  types: AnchoredTypeMetric[];
+}
+
+interface TypeState {
+  anchor: string | null;
+  items: AnchoredItem[];
+  refreshedAt: number;
+}
+
+interface PersistedState {
+  anchor: string | null;
+  items: AnchoredItem[];
+}
+
+export interface AnchoredStoreOptions {
+  /** A type refreshed more recently than this is served from cache without a query. */
+  minRefreshMs?: number;
+  now?: () => number;
+  onMetrics?: (m: AnchoredBatchMetrics) => void;
+}
+
+export class AnchoredSampleStore {
+  private readonly adapter: AnchoredQueryAdapter;
+  private readonly storage: AnchoredStorage;
+  private readonly minRefreshMs: number;
+  private readonly now: () => number;
+  private readonly onMetrics?: (m: AnchoredBatchMetrics) => void;
+
+  private readonly specs = new Map<string, AnchoredTypeSpec>();
+  private readonly states = new Map<string, TypeState>();
+  private pending = new Set<string>();
+  private batch: Promise<Map<string, Error>> | null = null;
+  private readonly inFlight = new Map<string, Promise<Map<string, Error>>>();
+  private lastMetrics: AnchoredBatchMetrics | null = null;
+
+  constructor(adapter: AnchoredQueryAdapter, storage: AnchoredStorage, options: AnchoredStoreOptions = {}) {
+    this.adapter = adapter;
+    this.storage = storage;
+    this.minRefreshMs = options.minRefreshMs ?? 10_000;
+    this.now = options.now ?? Date.now;
+    this.onMetrics = options.onMetrics;
+  }
+
+  register<T extends AnchoredItem>(spec: AnchoredTypeSpec<T>): void {
+    this.specs.set(spec.id, spec as AnchoredTypeSpec);
+  }
+
+  /**
+   * Cached samples of `id` overlapping [from, to], sorted by start, after
+   * pulling any HealthKit delta. Resolves null when `from` is older than the
+   * type's retention (caller should run a plain query); rejects if the
+   * anchored query failed.
+   */
+  async read<T extends AnchoredItem>(id: string, from: Date, to: Date): Promise<T[] | null> {
+    const spec = this.specs.get(id);
+    if (!spec) throw new Error(`AnchoredSampleStore: unknown type '${id}'`);
+    if (from.getTime() < this.now() - spec.retentionMs) return null;
+
+    const state = this.states.get(id);
+    if (!state || this.now() - state.refreshedAt >= this.minRefreshMs) {
+      const errors = await this.enqueue(id);
+      const err = errors.get(id);
+      if (err) throw err;
+    }
+
+    const fromMs = from.getTime();
+    const toMs = to.getTime();
+    return this.states.get(id)!.items.filter(s => s.endMs > fromMs && s.startMs < toMs) as T[];
+  }
+
+  /** Force the next read of `id` to query (e.g. after a HealthKit change notification). */
+  invalidate(id: string): void {
+    const state = this.states.get(id);
+    if (state) state.refreshedAt = 0;
+  }
+
+  getLastMetrics(): AnchoredBatchMetrics | null {
+    return this.lastMetrics;
+  }
+
+  /** Forget every anchor and cached sample (sign-out). */
+  async clear(): Promise<void> {
+    this.states.clear();
+    try {
+      const keys = (await this.storage.getAllKeys()).filter(k => k.startsWith(KEY_PREFIX));
+      if (keys.length > 0) await this.storage.multiRemove(keys);
+    } catch {}
+  }
+
+  // ── Batching ────────────────────────────────────────────────────────
+
+  private enqueue(id: string): Promise<Map<string, Error>> {
+    // A read arriving while its type is mid-query shares that query
+    const running = this.inFlight.get(id);
+    if (running) return running;
+    this.pending.add(id);
+    if (!this.batch) {
+      // Let every read issued in this tick join before flushing
+      this.batch = Promise.resolve().then(() => {
+        const ids = [...this.pending];
+        this.pending = new Set();
+        this.batch = null;
+        const flushing = this.flush(ids);
+        for (const i of ids) this.inFlight.set(i, flushing);
+        return flushing.finally(() => {
+          for (const i of ids) this.inFlight.delete(i);
+        });
+      });
+    }
+    return this.batch;
+  }
+
+  private async flush(ids: string[]): Promise<Map<string, Error>> {
+    const t0 = this.now();
+    const errors = new Map<string, Error>();
+
+    const unloaded = ids.filter(id => !this.states.has(id));
+    if (unloaded.length > 0) {
+      const rows = await this.storage.multiGet(unloaded.map(id => KEY_PREFIX + id)).catch(() => []);
+      const byKey = new Map(rows);
+      for (const id of unloaded) {
+        let persisted: PersistedState | null = null;
+        try {
+          const raw = byKey.get(KEY_PREFIX + id);
+          persisted = raw ? (JSON.parse(raw) as PersistedState) : null;
+        } catch {}
+        this.states.set(id, { anchor: persisted?.anchor ?? null, items: persisted?.items ?? [], refreshedAt: 0 });
+      }
+    }
+
+    const metrics = await Promise.all(ids.map(id => this.refresh(id).catch((e: Error) => {
+      errors.set(id, e);
+      return { id, full: false, added: 0, deleted: 0, cached: this.states.get(id)!.items.length, ms: 0, error: String(e?.message ?? e) };
+    })));
+
+    const dirty = ids.filter(id => !errors.has(id));
+    if (dirty.length > 0) {
+      const pairs: [string, string][] = dirty.map(id => {
+        const s = this.states.get(id)!;
+        const persisted: PersistedState = { anchor: s.anchor, items: s.items };
+        return [KEY_PREFIX + id, JSON.stringify(persisted)];
+      });
+      await this.storage.multiSet(pairs).catch(() => {});
+    }
+
+    const batchMetrics: AnchoredBatchMetrics = { at: t0, ms: this.now() - t0, types: metrics };
+    this.lastMetrics = batchMetrics;
+    this.onMetrics?.(batchMetrics);
+    return errors;
+  }
+
+  private async refresh(id: string): Promise<AnchoredTypeMetric> {
+    const spec = this.specs.get(id)!;
+    const state = this.states.get(id)!;
+    const t0 = this.now();
+    const windowStart = t0 - spec.retentionMs;
+
+    const delta = await this.adapter.query(spec, state.anchor, new Date(windowStart));
+
+    const byUuid = new Map(state.items.map(s => [s.uuid, s]));
+    for (const uuid of delta.deletedUuids) byUuid.delete(uuid);
+    let added = 0;
+    for (const raw of delta.samples) {
+      const item = spec.map(raw);
+      if (!item) continue;
+      byUuid.set(item.uuid, item);
+      added++;
+    }
+
+    const items = [...byUuid.values()]
+      .filter(s => s.endMs >= windowStart)
+      .sort((a, b) => a.startMs - b.startMs);
+
+    const full = state.anchor === null;
+    this.states.set(id, { anchor: delta.newAnchor, items, refreshedAt: this.now() });
+    return { id, full, added, deleted: delta.deletedUuids.length, cached: items.length, ms: this.now() - t0 };
+  }
+}
@@ -0,0 +1,57 @@
+/**
+ * HealthKitAnchoredQueries — shared AnchoredSampleStore bound to Apple Health
+ * Uses @kingstinct/react-native-healthkit v13 *WithAnchor queries
+ *
+ * Fetchers register their sample types on `hkAnchoredStore` and read through it;
+ * batch metrics go to a Sentry breadcrumb and `getLastHealthKitSyncMetrics()`.
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+import {
+  queryCategorySamplesWithAnchor,
+  queryQuantitySamplesWithAnchor,
+  queryWorkoutSamplesWithAnchor,
+} from '@kingstinct/react-native-healthkit';
+import { addBreadcrumb } from '../../utils/sentry';
+import { AnchoredSampleStore } from './AnchoredSampleStore';
+import type { AnchoredBatchMetrics, AnchoredDelta, AnchoredQueryAdapter } from './AnchoredSampleStore';
+
+function toDelta(res: any, samplesKey: 'samples' | 'workouts'): AnchoredDelta {
+  return {
+    samples: Array.isArray(res?.[samplesKey]) ? res[samplesKey] : Array.isArray(res?.samples) ? res.samples : [],
+    deletedUuids: Array.isArray(res?.deletedSamples) ? res.deletedSamples.map((d: any) => d.uuid) : [],
+    newAnchor: res?.newAnchor,
+  };
+}
+
+const healthKitAdapter: AnchoredQueryAdapter = {
+  async query(spec, anchor, from) {
+    const options = {
+      limit: 0, // 0 = unlimited
+      ...(anchor ? { anchor } : {}),
+      filter: { date: { startDate: from } },
+    };
+    switch (spec.kind) {
+      case 'quantity':
+        return toDelta(await queryQuantitySamplesWithAnchor(spec.identifier as any, options as any), 'samples');
+      case 'category':
+        return toDelta(await queryCategorySamplesWithAnchor(spec.identifier as any, options as any), 'samples');
+      case 'workout':
+        return toDelta(await queryWorkoutSamplesWithAnchor(options as any), 'workouts');
+    }
+  },
+};
+
+function logMetrics(m: AnchoredBatchMetrics): void {
+  addBreadcrumb('healthkit', `anchored batch ${m.ms}ms`, {
+    types: m.types
+      .map(t => `${t.id}:${t.full ? 'full' : 'delta'}+${t.added}-${t.deleted}=${t.cached}/${t.ms}ms${t.error ? '!' : ''}`)
+      .join(' '),
+  });
+}
+
+export const hkAnchoredStore = new AnchoredSampleStore(healthKitAdapter, AsyncStorage, { onMetrics: logMetrics });
+
+export function getLastHealthKitSyncMetrics(): AnchoredBatchMetrics | null {
+  return hkAnchoredStore.getLastMetrics();
+}
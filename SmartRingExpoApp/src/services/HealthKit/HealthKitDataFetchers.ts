@@ -1,6 +1,10 @@
 /**
  * HealthKitDataFetchers — read heart rate, steps, SpO2, HRV from Apple Health
  * Uses @kingstinct/react-native-healthkit v13 API (filter.date pattern)
+ *
+ * Today's steps / active energy / distance are read through the anchored store,
+ * so after the first read each refresh only transfers new and deleted samples.
+ * HR, HRV and SpO2 stay single most-recent-sample reads.
  */
 
 import {
@@ -8,6 +12,8 @@ import {
   queryQuantitySamples,
 } from '@kingstinct/react-native-healthkit';
 import { reportError } from '../../utils/sentry';
+import { hkAnchoredStore } from './HealthKitAnchoredQueries';
+import type { AnchoredItem } from './AnchoredSampleStore';
 
 export interface HKStepsResult {
   steps: number;
@@ -46,6 +52,40 @@ function startOfToday(): Date {
   return new Date(now.getFullYear(), now.getMonth(), now.getDate());
 }
 
+/** Compact cached form of a quantity sample. */
+export interface HKQuantityItem extends AnchoredItem {
+  startDate: string;
+  endDate: string;
+  quantity: number;
+  sourceName: string;
+}
+
+function toQuantityItem(s: any): HKQuantityItem | null {
+  const startMs = new Date(s?.startDate).getTime();
+  const endMs = new Date(s?.endDate).getTime();
+  if (!Number.isFinite(startMs) || !Number.isFinite(endMs)) return null;
+  return {
+    uuid: s.uuid ?? `${startMs}-${endMs}-${s.quantity}`,
+    startMs,
+    endMs,
+    startDate: new Date(startMs).toISOString(),
+    endDate: new Date(endMs).toISOString(),
+    quantity: Number(s.quantity) || 0,
+    sourceName: s?.device?.name || s?.sourceRevision?.source?.name || 'unknown',
+  };
+}
+
+const TODAY_TYPES = {
+  steps: 'HKQuantityTypeIdentifierStepCount',
+  activeEnergy: 'HKQuantityTypeIdentifierActiveEnergyBurned',
+  distance: 'HKQuantityTypeIdentifierDistanceWalkingRunning',
+} as const;
+
+// Two days so a read just after midnight still has yesterday's tail cached
+for (const [id, identifier] of Object.entries(TODAY_TYPES)) {
+  hkAnchoredStore.register({ id, kind: 'quantity', identifier, retentionMs: 2 * 86_400_000, map: toQuantityItem });
+}
+
 class HealthKitDataFetchers {
   async fetchHeartRateData(): Promise<HKHeartRateResult | null> {
     try {
@@ -61,27 +101,36 @@ class HealthKitDataFetchers {
     }
   }
 
-  async fetchStepsData(): Promise<HKStepsResult> {
+  /** Today's samples of one type: anchored cache first, plain query if that can't serve. */
+  private async todaySamples(id: keyof typeof TODAY_TYPES): Promise<HKQuantityItem[]> {
+    const from = startOfToday();
+    const to = new Date();
     try {
-      const now = new Date();
-      const todayQuery = await queryQuantitySamples(
-        'HKQuantityTypeIdentifierStepCount',
-        {
-          limit: 0, // 0 = unlimited
-          filter: {
-            date: { startDate: startOfToday(), endDate: now },
-          },
-        }
-      );
+      const cached = await hkAnchoredStore.read<HKQuantityItem>(id, from, to);
+      if (cached) return cached;
+    } catch (error) {
+      reportError(error, { op: `healthKit.anchored.${id}` }, 'warning');
+    }
+    const samples = await queryQuantitySamples(TODAY_TYPES[id], {
+      limit: 0, // 0 = unlimited
+      filter: {
+        date: { startDate: from, endDate: to },
+      },
+    });
+    return (Array.isArray(samples) ? samples : [])
+      .map(toQuantityItem)
+      .filter((s): s is HKQuantityItem => s !== null);
+  }
 
-      const allSamples = Array.isArray(todayQuery) ? todayQuery : [];
+  async fetchStepsData(): Promise<HKStepsResult> {
+    try {
+      const allSamples = await this.todaySamples('steps');
       const mapped = allSamples
-        .map((s: any) => ({
+        .map((s) => ({
           ...s,
-          _start: new Date(s.startDate).getTime(),
-          _end: new Date(s.endDate).getTime(),
-          quantity: Number(s.quantity) || 0,
-          _sourceName: s?.device?.name || s?.sourceRevision?.source?.name || 'unknown',
+          _start: s.startMs,
+          _end: s.endMs,
+          _sourceName: s.sourceName,
         }))
         .filter((s) => s.quantity > 0);
 
@@ -133,19 +182,8 @@ class HealthKitDataFetchers {
 
   async fetchActiveCaloriesData(): Promise<HKActiveCaloriesResult> {
     try {
-      const now = new Date();
-      const samples = await queryQuantitySamples(
-        'HKQuantityTypeIdentifierActiveEnergyBurned',
-        {
-          limit: 0,
-          filter: {
-            date: { startDate: startOfToday(), endDate: now },
-          },
-        }
-      );
-
-      const total = (Array.isArray(samples) ? samples : [])
-        .reduce((sum, s: any) => sum + (Number(s.quantity) || 0), 0);
+      const samples = await this.todaySamples('activeEnergy');
+      const total = samples.reduce((sum, s) => sum + s.quantity, 0);
 
       return { calories: Math.round(total), source: 'appleHealth' };
     } catch (error) {
@@ -156,19 +194,8 @@ class HealthKitDataFetchers {
 
   async fetchDistanceData(): Promise<HKDistanceResult> {
     try {
-      const now = new Date();
-      const samples = await queryQuantitySamples(
-        'HKQuantityTypeIdentifierDistanceWalkingRunning',
-        {
-          limit: 0,
-          filter: {
-            date: { startDate: startOfToday(), endDate: now },
-          },
-        }
-      );
-
-      const totalM = (Array.isArray(samples) ? samples : [])
-        .reduce((sum, s: any) => sum + (Number(s.quantity) || 0), 0);
+      const samples = await this.todaySamples('distance');
+      const totalM = samples.reduce((sum, s) => sum + s.quantity, 0);
 
       return { distanceM: Math.round(totalM), source: 'appleHealth' };
     } catch (error) {
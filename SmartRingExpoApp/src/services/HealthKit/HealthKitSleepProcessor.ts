@@ -5,6 +5,9 @@
 
 import { queryCategorySamples } from '@kingstinct/react-native-healthkit';
 import { reportError } from '../../utils/sentry';
+import { hkAnchoredStore } from './HealthKitAnchoredQueries';
+import type { AnchoredItem } from './AnchoredSampleStore';
+import { HEALTHKIT_MERGE_GAP_MS, mergeIntervals } from '../SleepSegmentation';
 
 export interface HKSleepResult {
   totalSleep: number; // minutes
@@ -27,7 +30,36 @@ const DEEP = 4;
 const REM = 5;
 
 const ASLEEP_VALUES = new Set([ASLEEP_GENERIC, CORE, DEEP, REM]);
-const SESSION_GAP_MIN = 90;
+
+/** Compact cached form of a sleep-analysis sample. */
+interface HKSleepItem extends AnchoredItem {
+  startDate: string;
+  endDate: string;
+  value: number;
+}
+
+function toSleepItem(s: any): HKSleepItem | null {
+  const startMs = new Date(s?.startDate).getTime();
+  const endMs = new Date(s?.endDate).getTime();
+  if (!Number.isFinite(startMs) || !Number.isFinite(endMs)) return null;
+  return {
+    uuid: s.uuid ?? `${startMs}-${endMs}-${s.value}`,
+    startMs,
+    endMs,
+    startDate: new Date(startMs).toISOString(),
+    endDate: new Date(endMs).toISOString(),
+    value: s.value,
+  };
+}
+
+// Covers the 7-day fallback window in fetchSleepData
+hkAnchoredStore.register({
+  id: 'sleep',
+  kind: 'category',
+  identifier: 'HKCategoryTypeIdentifierSleepAnalysis',
+  retentionMs: 8 * 86_400_000,
+  map: toSleepItem,
+});
 
 class HealthKitSleepProcessor {
   async fetchSleepData(): Promise<HKSleepResult | null> {
@@ -56,16 +88,28 @@ class HealthKitSleepProcessor {
     }
   }
 
+  /** Sleep samples overlapping the window: anchored cache first, plain query if that can't serve. */
+  private async windowSamples(from: Date, to: Date): Promise<HKSleepItem[]> {
+    try {
+      const cached = await hkAnchoredStore.read<HKSleepItem>('sleep', from, to);
+      if (cached) return cached;
+    } catch (error) {
+      reportError(error, { op: 'healthKit.anchored.sleep' }, 'warning');
+    }
+    const query = await queryCategorySamples('HKCategoryTypeIdentifierSleepAnalysis', {
+      limit: 0,
+      filter: {
+        date: { startDate: from, endDate: to },
+      },
+    });
+    return (Array.isArray(query) ? query : [])
+      .map(toSleepItem)
+      .filter((s): s is HKSleepItem => s !== null);
+  }
+
   private async querySleepWindow(from: Date, to: Date): Promise<HKSleepResult | null> {
     try {
-      const query = await queryCategorySamples('HKCategoryTypeIdentifierSleepAnalysis', {
-        limit: 0,
-        filter: {
-          date: { startDate: from, endDate: to },
-        },
-      });
-
-      const allSamples = Array.isArray(query) ? query : [];
+      const allSamples = await this.windowSamples(from, to);
       if (!allSamples.length) return null;
 
       // Clip samples to the query window
@@ -122,28 +166,15 @@ class HealthKitSleepProcessor {
   }
 
   private groupIntoSessions(samples: any[]): any[][] {
-    const sorted = [...samples].sort(
-      (a, b) => new Date(a.startDate).getTime() - new Date(b.startDate).getTime()
-    );
-    const sessions: any[][] = [];
-    let current: any[] = [];
-
-    for (const s of sorted) {
-      if (!current.length) {
-        current = [s];
-        continue;
-      }
-      const gap =
-        (new Date(s.startDate).getTime() - new Date(current[current.length - 1].endDate).getTime()) / 60000;
-      if (gap <= SESSION_GAP_MIN) {
-        current.push(s);
-      } else {
-        sessions.push(current);
-        current = [s];
-      }
-    }
-    if (current.length) sessions.push(current);
-    return sessions;
+    // Sorted by startDate; a sample joins the session when it starts within
+    // HEALTHKIT_MERGE_GAP_MS of the session's latest end so far
+    const timed = samples.map(s => ({
+      sample: s,
+      start: new Date(s.startDate).getTime(),
+      end: new Date(s.endDate).getTime(),
+    }));
+    return mergeIntervals(timed, t => t.start, t => t.end, HEALTHKIT_MERGE_GAP_MS)
+      .map(block => block.items.map(t => t.sample));
   }
 
   private processSleepData(samples: any[]): HKSleepResult {
@@ -4,7 +4,12 @@
  */
 
 import { queryWorkoutSamples } from '@kingstinct/react-native-healthkit';
+import { reportError } from '../../utils/sentry';
 import type { HKWorkoutResult } from '../../types/activity.types';
+import { hkAnchoredStore } from './HealthKitAnchoredQueries';
+import type { AnchoredItem } from './AnchoredSampleStore';
+
+const MAX_WORKOUTS = 50;
 
 // HealthKit WorkoutActivityType → normalized sport string
 const ACTIVITY_TYPE_MAP: Record<number, string> = {
@@ -52,11 +57,61 @@ function generateWorkoutName(sportType: string, startDate: Date): string {
   return `${timeOfDay} ${sportType}`;
 }
 
+type HKWorkoutItem = HKWorkoutResult & AnchoredItem;
+
+function toWorkoutResult(s: any): HKWorkoutItem {
+  const startDate = new Date(s.startDate);
+  const endDate = new Date(s.endDate);
+  const sportType = ACTIVITY_TYPE_MAP[s.workoutActivityType] || 'Workout';
+
+  return {
+    uuid: s.uuid,
+    startMs: startDate.getTime(),
+    endMs: endDate.getTime(),
+    activityType: s.workoutActivityType,
+    sportType,
+    name: generateWorkoutName(sportType, startDate),
+    startDate: startDate.toISOString(),
+    endDate: endDate.toISOString(),
+    durationSec: s.duration?.value ?? Math.round((endDate.getTime() - startDate.getTime()) / 1000),
+    distanceM: s.totalDistance?.value,
+    calories: s.totalEnergyBurned?.value ? Math.round(s.totalEnergyBurned.value) : undefined,
+    elevationAscended: s.metadataElevationAscended?.value,
+    elevationDescended: s.metadataElevationDescended?.value,
+    avgSpeed: s.metadataAverageSpeed?.value,
+    maxSpeed: s.metadataMaximumSpeed?.value,
+    isIndoor: s.metadataIndoorWorkout,
+    sourceName: s.sourceRevision?.source?.name || s.device?.name || 'Apple Health',
+  };
+}
+
+// Cached window; older ranges go straight to HealthKit
+hkAnchoredStore.register({
+  id: 'workouts',
+  kind: 'workout',
+  identifier: 'HKWorkoutTypeIdentifier',
+  retentionMs: 30 * 86_400_000,
+  map: (s: any) => (s?.uuid ? toWorkoutResult(s) : null),
+});
+
 class HealthKitWorkoutFetcher {
   async fetchWorkouts(from: Date, to: Date): Promise<HKWorkoutResult[]> {
+    try {
+      const cached = await hkAnchoredStore.read<HKWorkoutItem>('workouts', from, to);
+      if (cached) {
+        // Newest first, same shape and cap as the plain query
+        return cached
+          .slice(-MAX_WORKOUTS)
+          .reverse()
+          .map(({ startMs, endMs, ...w }) => w);
+      }
+    } catch (error) {
+      reportError(error, { op: 'healthKit.anchored.workouts' }, 'warning');
+    }
+
     try {
       const samples = await queryWorkoutSamples({
-        limit: 50,
+        limit: MAX_WORKOUTS,
         ascending: false,
         filter: {
           date: { startDate: from, endDate: to },
@@ -66,27 +121,8 @@ class HealthKitWorkoutFetcher {
       if (!Array.isArray(samples) || !samples.length) return [];
 
       return samples.map((s: any) => {
-        const startDate = new Date(s.startDate);
-        const endDate = new Date(s.endDate);
-        const sportType = ACTIVITY_TYPE_MAP[s.workoutActivityType] || 'Workout';
-
-        return {
-          uuid: s.uuid,
-          activityType: s.workoutActivityType,
-          sportType,
-          name: generateWorkoutName(sportType, startDate),
-          startDate: startDate.toISOString(),
-          endDate: endDate.toISOString(),
-          durationSec: s.duration?.value ?? Math.round((endDate.getTime() - startDate.getTime()) / 1000),
-          distanceM: s.totalDistance?.value,
-          calories: s.totalEnergyBurned?.value ? Math.round(s.totalEnergyBurned.value) : undefined,
-          elevationAscended: s.metadataElevationAscended?.value,
-          elevationDescended: s.metadataElevationDescended?.value,
-          avgSpeed: s.metadataAverageSpeed?.value,
-          maxSpeed: s.metadataMaximumSpeed?.value,
-          isIndoor: s.metadataIndoorWorkout,
-          sourceName: s.sourceRevision?.source?.name || s.device?.name || 'Apple Health',
-        };
+        const { startMs, endMs, ...w } = toWorkoutResult(s);
+        return w;
       });
     } catch (error) {
       return [];
@@ -10,6 +10,8 @@ import HealthKitDataFetchers from './HealthKit/HealthKitDataFetchers';
 import HealthKitSleepProcessor from './HealthKit/HealthKitSleepProcessor';
 import HealthKitSubscriptions from './HealthKit/HealthKitSubscriptions';
 import HealthKitWorkoutFetcher from './HealthKit/HealthKitWorkoutFetcher';
+import { hkAnchoredStore, getLastHealthKitSyncMetrics } from './HealthKit/HealthKitAnchoredQueries';
+import type { AnchoredBatchMetrics } from './HealthKit/AnchoredSampleStore';
 import type { HealthKitCallbacks } from './HealthKit/HealthKitSubscriptions';
 import type { HKStepsResult, HKHeartRateResult, HKHRVResult, HKSpO2Result, HKActiveCaloriesResult, HKDistanceResult } from './HealthKit/HealthKitDataFetchers';
 import type { HKSleepResult } from './HealthKit/HealthKitSleepProcessor';
@@ -134,13 +136,29 @@ class HealthKitService {
   // ── Subscriptions ───────────────────────────────────────────────────
 
   setupSubscriptions(callbacks: HealthKitCallbacks): void {
-    this.subscriptions.setupHealthDataSubscriptions(callbacks, this.permissions.hasAuthorization);
+    // A change notification means the anchored caches are behind; make the next read query
+    this.subscriptions.setupHealthDataSubscriptions({
+      ...callbacks,
+      onStepsChange: () => {
+        hkAnchoredStore.invalidate('steps');
+        callbacks.onStepsChange?.();
+      },
+      onSleepChange: () => {
+        hkAnchoredStore.invalidate('sleep');
+        callbacks.onSleepChange?.();
+      },
+    }, this.permissions.hasAuthorization);
   }
 
   clearSubscriptions(): void {
     this.subscriptions.clearSubscriptions();
   }
 
+  /** Last anchored-query batch: per type full/delta, samples added/deleted, cache size, ms. */
+  getLastSyncMetrics(): AnchoredBatchMetrics | null {
+    return getLastHealthKitSyncMetrics();
+  }
+
   // ── Cleanup ─────────────────────────────────────────────────────────
 
   cleanup(): void {
@@ -0,0 +1,214 @@
+/**
+ * HydrationPipeline — declarative stage graph for screen hydration.
+ *
+ * A screen describes its loads as stages with explicit dependencies instead of
+ * a hand-written await chain. Every stage starts as soon as its deps resolve,
+ * so independent network / HealthKit reads overlap with each other and with
+ * the BLE work the caller drives inline.
+ *
+ *   - ttlMs:   a cached result younger than this is returned without running
+ *   - staleMs: a cached result past ttlMs but younger than this is returned
+ *              immediately and refreshed in the background (stale-while-revalidate)
+ *   - results are cached per `scope` (user + local day), null/undefined never are
+ *
+ * Each run records per-stage timings (offset from start, duration, source) and
+ * named marks such as the first real score. `finish()` publishes them as one
+ * structured record: a Sentry breadcrumb, `getLastHydrationMetrics()`, and
+ * any `onHydrationMetrics` listeners.
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+import { addBreadcrumb } from '../utils/sentry';
+
+const CACHE_PREFIX = 'hydration_v1:';
+
+export type StageGetter = <D>(id: string) => Promise<D>;
+
+export interface HydrationStage<T = unknown> {
+  id: string;
+  deps?: string[];
+  ttlMs?: number;
+  staleMs?: number;
+  run: (get: StageGetter) => Promise<T>;
+}
+
+export type StageSource = 'run' | 'cache' | 'stale' | 'error' | 'inline';
+
+export interface StageMetric {
+  id: string;
+  /** Offset from pipeline start. */
+  startMs: number;
+  ms: number;
+  source: StageSource;
+}
+
+export interface HydrationMetrics {
+  pipeline: string;
+  reason: string;
+  startedAt: number;
+  totalMs: number;
+  stages: StageMetric[];
+  marks: Record<string, number>;
+}
+
+interface CacheEntry {
+  at: number;
+  value: unknown;
+}
+
+let lastMetrics: HydrationMetrics | null = null;
+const listeners = new Set<(m: HydrationMetrics) => void>();
+
+export function getLastHydrationMetrics(): HydrationMetrics | null {
+  return lastMetrics;
+}
+
+export function onHydrationMetrics(listener: (m: HydrationMetrics) => void): () => void {
+  listeners.add(listener);
+  return () => listeners.delete(listener);
+}
+
+/** Drop every cached stage result (sign-out, account switch). */
+export async function clearHydrationCache(): Promise<void> {
+  try {
+    const keys = await AsyncStorage.getAllKeys();
+    const ours = keys.filter(k => k.startsWith(CACHE_PREFIX));
+    if (ours.length > 0) await AsyncStorage.multiRemove(ours);
+  } catch {}
+}
+
+async function readCache(key: string): Promise<CacheEntry | null> {
+  try {
+    const raw = await AsyncStorage.getItem(key);
+    return raw ? (JSON.parse(raw) as CacheEntry) : null;
+  } catch {
+    return null;
+  }
+}
+
+function writeCache(key: string, value: unknown): void {
+  if (value === null || value === undefined) return;
+  AsyncStorage.setItem(key, JSON.stringify({ at: Date.now(), value })).catch(() => {});
+}
+
+export class HydrationRun {
+  private readonly t0 = Date.now();
+  private readonly byId = new Map<string, HydrationStage>();
+  private readonly results = new Map<string, Promise<unknown>>();
+  private readonly stageMetrics: StageMetric[] = [];
+  private readonly marks: Record<string, number> = {};
+  private readonly pipeline: string;
+  private readonly reason: string;
+  private readonly scope: Promise<string | null | undefined>;
+
+  constructor(
+    pipeline: string,
+    reason: string,
+    stages: HydrationStage[],
+    scope: Promise<string | null | undefined>,
+  ) {
+    this.pipeline = pipeline;
+    this.reason = reason;
+    this.scope = scope;
+    for (const s of stages) this.byId.set(s.id, s);
+    for (const s of stages) this.start(s.id);
+  }
+
+  /** Resolved value of a declared stage. Rejects if the stage (or a dep) threw. */
+  result<T>(id: string): Promise<T> {
+    return this.start(id) as Promise<T>;
+  }
+
+  /**
+   * Time a stage the caller runs inline (e.g. the serial BLE chain, which
+   * must stay one-command-at-a-time). Call the returned function when done.
+   */
+  begin(id: string): (source?: StageSource) => void {
+    const startedAt = Date.now();
+    return (source = 'inline') => this.record(id, startedAt, source);
+  }
+
+  /** Record a named milestone (e.g. 'firstScore') as an offset from start. */
+  mark(name: string): void {
+    if (this.marks[name] === undefined) this.marks[name] = Date.now() - this.t0;
+  }
+
+  finish(): HydrationMetrics {
+    const metrics: HydrationMetrics = {
+      pipeline: this.pipeline,
+      reason: this.reason,
+      startedAt: this.t0,
+      totalMs: Date.now() - this.t0,
+      stages: [...this.stageMetrics].sort((a, b) => a.startMs - b.startMs),
+      marks: { ...this.marks },
+    };
+    lastMetrics = metrics;
+    addBreadcrumb('hydration', `${this.pipeline} ${metrics.totalMs}ms`, {
+      reason: metrics.reason,
+      marks: metrics.marks,
+      stages: metrics.stages.map(s => `${s.id}:${s.ms}ms/${s.source}`).join(' '),
+    });
+    if (__DEV__) console.log(`[hydration] ${this.pipeline}`, JSON.stringify(metrics));
+    listeners.forEach(l => {
+      try { l(metrics); } catch {}
+    });
+    return metrics;
+  }
+
+  private record(id: string, startedAt: number, source: StageSource): void {
+    this.stageMetrics.push({ id, startMs: startedAt - this.t0, ms: Date.now() - startedAt, source });
+  }
+
+  private start(id: string): Promise<unknown> {
+    const existing = this.results.get(id);
+    if (existing) return existing;
+    const stage = this.byId.get(id);
+    if (!stage) return Promise.reject(new Error(`hydration: unknown stage '${id}'`));
+
+    const get: StageGetter = <D,>(dep: string) => this.result<D>(dep);
+    const p = (async () => {
+      if (stage.deps?.length) await Promise.all(stage.deps.map(d => this.start(d)));
+      const startedAt = Date.now();
+
+      const cacheable = !!stage.ttlMs;
+      const scope = cacheable ? await this.scope : null;
+      const key = scope ? `${CACHE_PREFIX}${this.pipeline}:${scope}:${stage.id}` : null;
+      if (key) {
+        const hit = await readCache(key);
+        const age = hit ? startedAt - hit.at : Infinity;
+        if (hit && age < stage.ttlMs!) {
+          this.record(stage.id, startedAt, 'cache');
+          return hit.value;
+        }
+        if (hit && age < (stage.staleMs ?? 0)) {
+          this.record(stage.id, startedAt, 'stale');
+          stage.run(get).then(v => writeCache(key, v)).catch(() => {});
+          return hit.value;
+        }
+      }
+
+      try {
+        const value = await stage.run(get);
+        this.record(stage.id, startedAt, 'run');
+        if (key) writeCache(key, value);
+        return value;
+      } catch (e) {
+        this.record(stage.id, startedAt, 'error');
+        throw e;
+      }
+    })();
+    // Keep unobserved failures from surfacing as unhandled rejections
+    p.catch(() => {});
+    this.results.set(id, p);
+    return p;
+  }
+}
+
+export function startHydration(
+  pipeline: string,
+  reason: string,
+  stages: HydrationStage[],
+  scope: Promise<string | null | undefined>,
+): HydrationRun {
+  return new HydrationRun(pipeline, reason, stages, scope);
+}
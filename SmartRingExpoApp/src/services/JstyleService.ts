@@ -13,7 +13,8 @@
 
 import { NativeModules, NativeEventEmitter, Platform } from 'react-native';
 import { SportType } from '../types/sdk.types';
-import { reportError, addBreadcrumb } from '../utils/sentry';
+import { reportError, addBreadcrumb, withSpan } from '../utils/sentry';
+import { parseRingDate } from '../utils/ringDate';
 import type {
   DeviceInfo,
   StepsData,
@@ -29,7 +30,26 @@ import type {
   SportData,
   X3ActivitySession,
   X3SleepBreathingMetrics,
+  NativeFetchMetrics,
+  NativeSyncStats,
+  NativeLogOptions,
+  NativeLogStats,
 } from '../types/sdk.types';
+import type { DetailActivityWindow } from './ActivityDetailStore';
+import { RealtimeFrameDecoder } from './RealtimeFrameDecoder';
+import { decodeLogBatch, type NativeLogBatch } from './LogPipeline';
+import { NativeCallQueue, type NativeCallOptions } from './NativeCallQueue';
+import {
+  x3ActivityModeColumns,
+  x3EventCountColumns,
+  x3HrvColumns,
+  x3PpiColumns,
+  x3SleepHrvColumns,
+  x3SpO2Columns,
+  x3TemperatureColumns,
+  type HrvColumns,
+  type PpiColumns,
+} from './SampleColumns';
 
 // Safely get native module
 let JstyleBridge: any = null;
@@ -74,17 +94,22 @@ function withNativeTimeout<T>(
 }
 
 class JstyleService {
-  private nativeCallQueue: Promise<void> = Promise.resolve();
+  private readonly nativeCalls = new NativeCallQueue();
+  // onRealTimeData frames carry changed fields only; listeners that need the rest decode
+  private readonly realtimeFrames = new RealtimeFrameDecoder();
   private readonly busyRetryableOperations = new Set<string>([
     'getDeviceTime',
     'getStepGoal',
     'getBatteryLevel',
     'getFirmwareVersion',
     'getStepsData',
+    'getDetailActivityData',
     'getSleepData',
     'getHeartRateData',
     'getHRVData',
     'getSpO2Data',
+    'getContinuousSpO2Data',
+    'getSleepWithActivity',
     'getTemperatureData',
     'getActivityModeData',
     'getSleepHRVData',
@@ -92,6 +117,11 @@ class JstyleService {
     'getEOVData',
     'getPPIData',
     'getMacAddress',
+    'deleteHistoryData',
+    'getUserInfo',
+    'setUserInfo',
+    'getAutoMonitoring',
+    'setAutoMonitoring',
   ]);
   private readonly pendingResolverOperations = new Set<string>([
     'syncTime',
@@ -101,10 +131,13 @@ class JstyleService {
     'getBatteryLevel',
     'getFirmwareVersion',
     'getStepsData',
+    'getDetailActivityData',
     'getSleepData',
     'getHeartRateData',
     'getHRVData',
     'getSpO2Data',
+    'getContinuousSpO2Data',
+    'getSleepWithActivity',
     'getTemperatureData',
     'getActivityModeData',
     'getSleepHRVData',
@@ -112,6 +145,10 @@ class JstyleService {
     'getEOVData',
     'getPPIData',
     'getMacAddress',
+    'getUserInfo',
+    'setUserInfo',
+    'getAutoMonitoring',
+    'setAutoMonitoring',
     'factoryReset',
   ]);
 
@@ -164,7 +201,8 @@ class JstyleService {
 
   private async enqueueNativeCall<T>(
     operationName: string,
-    operation: () => Promise<T>
+    operation: () => Promise<T>,
+    options?: NativeCallOptions
   ): Promise<T> {
     const run = async () => {
       const maxBusyRetries = this.busyRetryableOperations.has(operationName) ? 1 : 0;
@@ -172,7 +210,7 @@ class JstyleService {
 
       while (true) {
         try {
-          return await operation();
+          return await withSpan('ble.native', operationName, () => operation());
         } catch (rawError: any) {
           const normalized = this.normalizeNativeError(operationName, rawError);
           const isBusy = this.isBusyError(normalized);
@@ -202,35 +240,7 @@ class JstyleService {
       }
     };
 
-    const resultPromise = this.nativeCallQueue.then(run, run);
-    this.nativeCallQueue = resultPromise.then(
-      () => undefined,
-      () => undefined
-    );
-    return resultPromise;
-  }
-
-  // Parse SDK date string ("YYYY.MM.DD HH:mm:ss" or "YYYY.MM.DD") to local timestamp (ms)
-  private parseX3DateTime(value?: string): number | undefined {
-    if (!value || typeof value !== 'string') return undefined;
-    const [datePart, timePart] = value.trim().split(/\s+/);
-    if (!datePart) return undefined;
-    const [y, m, d] = datePart.split('.').map(Number);
-    if ([y, m, d].some(n => Number.isNaN(n))) return undefined;
-
-    const [hh, mm, ss] = (timePart || '00:00:00').split(':').map(Number);
-    if ([hh, mm, ss].some(n => Number.isNaN(n))) return undefined;
-
-    const ts = new Date(y, m - 1, d, hh, mm, ss).getTime();
-    return Number.isFinite(ts) && ts > 0 ? ts : undefined;
-  }
-
-  private pickNumber(record: Record<string, any>, keys: string[]): number | undefined {
-    for (const key of keys) {
-      const value = Number(record?.[key]);
-      if (Number.isFinite(value)) return value;
-    }
-    return undefined;
+    return this.nativeCalls.run(run, options);
   }
 
   private toSportType(value: number): SportType {
@@ -419,8 +429,10 @@ class JstyleService {
       weight: profile.weight,
       stride: profile.stride || 70,
     };
-    
-    return await JstyleBridge.setUserInfo(userInfo);
+
+    return await this.enqueueNativeCall<{ success: boolean }>('setUserInfo', async () =>
+      withNativeTimeout(JstyleBridge.setUserInfo(userInfo), 5000, 'setUserInfo')
+    );
   }
 
   async getProfile(): Promise<{
@@ -430,8 +442,46 @@ class JstyleService {
     weight: number;
     stride: number;
   }> {
-    // X3 SDK doesn't support reading profile back
-    throw new Error('Get profile not supported on X3');
+    if (!JstyleBridge) throw new Error('Jstyle SDK not available');
+    const info = await this.enqueueNativeCall<any>('getUserInfo', async () =>
+      withNativeTimeout(JstyleBridge.getUserInfo(), 5000, 'getUserInfo')
+    );
+    return {
+      gender: Number(info.gender) === 0 ? 'male' : 'female',
+      age: Number(info.age) || 0,
+      height: Number(info.height) || 0,
+      weight: Number(info.weight) || 0,
+      stride: Number(info.stride) || 0,
+    };
+  }
+
+  /** Automatic monitoring schedule for one measurement (1 = HR, 2 = SpO2, 3 = temperature, 4 = HRV). */
+  async getAutoMonitoring(dataType: number): Promise<{
+    workMode: number;
+    startTime: string;
+    endTime: string;
+    weeks: number;
+    intervalTime: number;
+    dataType: number;
+  }> {
+    if (!JstyleBridge) throw new Error('Jstyle SDK not available');
+    return await this.enqueueNativeCall('getAutoMonitoring', async () =>
+      withNativeTimeout(JstyleBridge.getAutoMonitoring(dataType), 5000, 'getAutoMonitoring')
+    );
+  }
+
+  async setAutoMonitoring(config: {
+    dataType: number;
+    workMode: number;
+    startTime: string;
+    endTime: string;
+    weeks: number;
+    intervalTime: number;
+  }): Promise<{ success: boolean }> {
+    if (!JstyleBridge) throw new Error('Jstyle SDK not available');
+    return await this.enqueueNativeCall<{ success: boolean }>('setAutoMonitoring', async () =>
+      withNativeTimeout(JstyleBridge.setAutoMonitoring(config), 5000, 'setAutoMonitoring')
+    );
   }
 
   async getGoal(): Promise<{ goal: number }> {
@@ -551,11 +601,6 @@ class JstyleService {
   // Cache for all sleep records — populated once per app session to avoid re-hitting native SDK
   private _sleepRecordsCache: any[] | null = null;
 
-  // Parse SDK date string ("YYYY.MM.DD HH:mm:ss") to timestamp (ms)
-  private parseSleepStart(value?: string): number | undefined {
-    return this.parseX3DateTime(value);
-  }
-
   async getSleepData(): Promise<{
     records: any[];
     timestamp: number;
@@ -580,7 +625,7 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
       const result = await this.getSleepData();
       this._sleepRecordsCache = result.records || [];
       const allDates = this._sleepRecordsCache.map(r => {
-        const ms = r.startTimestamp || r.startTime || this.parseSleepStart(r.startTime_SleepData);
+        const ms = r.startTimestamp || r.startTime || parseRingDate(r.startTime_SleepData);
         return ms ? new Date(ms).toISOString().split('T')[0] : '(no-ts)';
       });
     }
@@ -601,7 +646,7 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
         const candidates = [
           record.startTimestamp,
           record.startTime,
-          this.parseSleepStart(record.startTime_SleepData),
+          parseRingDate(record.startTime_SleepData),
         ].filter((v: any) => typeof v === 'number' && Number.isFinite(v) && v > 0);
         return candidates.length ? candidates[0] : undefined;
       })();
@@ -636,7 +681,7 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
         const candidates = [
           record.startTimestamp,
           record.startTime,
-          this.parseSleepStart(record.startTime_SleepData),
+          parseRingDate(record.startTime_SleepData),
         ].filter((v: any) => typeof v === 'number' && Number.isFinite(v) && v > 0);
         return candidates.length ? candidates[0] : undefined;
       })();
@@ -718,7 +763,7 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
         : [];
 
       if (existingDynamic.length > 0) {
-        const parsedDateTs = this.parseX3DateTime(rec?.date);
+        const parsedDateTs = parseRingDate(rec?.date);
         const startTs =
           typeof rec?.startTimestamp === 'number' && Number.isFinite(rec.startTimestamp) && rec.startTimestamp > 0
             ? rec.startTimestamp
@@ -744,7 +789,7 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
               .filter((v: number) => Number.isFinite(v))
           : [];
         const segDate = typeof seg?.date === 'string' ? seg.date : undefined;
-        const segTs = this.parseX3DateTime(segDate);
+        const segTs = parseRingDate(segDate);
         const fallbackTs =
           typeof rec?.startTimestamp === 'number' && Number.isFinite(rec.startTimestamp) && rec.startTimestamp > 0
             ? rec.startTimestamp
@@ -779,7 +824,7 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
       for (const entry of singles) {
         const hr = Number(entry?.singleHR);
         const dateStr = typeof entry?.date === 'string' ? entry.date : undefined;
-        const ts = this.parseX3DateTime(dateStr);
+        const ts = parseRingDate(dateStr);
         if (Number.isFinite(hr) && hr > 0) {
           normalizedRecords.push({
             date: dateStr ?? rec?.date,
@@ -845,6 +890,36 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
     );
   }
 
+  /**
+   * Realtime frame rate (0 = every packet, for recording) and whether frames carry only
+   * changed fields. Not queued: it only reconfigures the native coalescer, no BLE traffic.
+   */
+  async configureRealTimeStream(rateHz: number, deltas = true): Promise<any> {
+    if (!JstyleBridge || typeof JstyleBridge.configureRealTimeStream !== 'function') return null;
+    return await JstyleBridge.configureRealTimeStream(rateHz, deltas);
+  }
+
+  /**
+   * Native log level / sampling. Entries below `level` cost the bridge one compare;
+   * `sample: { debug: 10 }` keeps one debug entry in ten. Resolves the native log stats.
+   */
+  async configureLogging(options: NativeLogOptions): Promise<NativeLogStats | null> {
+    if (!JstyleBridge || typeof JstyleBridge.configureLogging !== 'function') return null;
+    return await JstyleBridge.configureLogging(options);
+  }
+
+  // ========== Activity Mode (live workout) ==========
+
+  // Priority: a workout start / stop runs right after the call in flight, ahead of queued fetches
+  async controlActivityMode(activityMode: number, workMode: number, minutes: number): Promise<{ success: boolean }> {
+    if (!JstyleBridge) throw new Error('Jstyle SDK not available');
+    return await this.enqueueNativeCall<{ success: boolean }>(
+      'controlActivityMode',
+      async () => withNativeTimeout(JstyleBridge.controlActivityMode(activityMode, workMode, minutes), 5000, 'controlActivityMode'),
+      { priority: true }
+    );
+  }
+
   // Use startRealTimeData as the equivalent of real-time HR
   async startRealTimeHeartRate(): Promise<{ success: boolean; message: string }> {
     return await this.startRealTimeData();
@@ -867,34 +942,18 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
     };
   }
 
-  async getHRVDataNormalized(): Promise<HRVData[]> {
+  /** HRV history as typed columns (one entry per arrayHrvData row); see SampleColumns. */
+  async getHRVDataColumns(): Promise<HrvColumns> {
     const result = await this.getHRVData();
-    const hrvData: HRVData[] = [];
-
-    const pushRecord = (rec: any, fallbackTs: number) => {
-      const rawDate = rec.date as string | undefined;
-      const ts = rawDate ? this.parseX3DateTime(rawDate) : undefined;
-      const hrvVal = Number(rec.hrv ?? rec.hrvValue ?? 0);
-      const hrVal = Number(rec.heartRate ?? 0);
-      const stressVal = Number(rec.stress ?? 0);
-      hrvData.push({
-        sdnn: hrvVal,
-        heartRate: hrVal,
-        stress: stressVal,
-        timestamp: ts && !Number.isNaN(ts) ? ts : fallbackTs,
-      });
-    };
+    return x3HrvColumns(result.records, result.timestamp);
+  }
 
-    for (const record of (result.records || [])) {
-      // Demo returns arrayHrvData per packet
-      if (Array.isArray(record.arrayHrvData)) {
-        record.arrayHrvData.forEach((entry: any) => pushRecord(entry, result.timestamp));
-        continue;
-      }
-      // Fallback: single record fields
-      pushRecord(record, result.timestamp);
+  async getHRVDataNormalized(): Promise<HRVData[]> {
+    const cols = await this.getHRVDataColumns();
+    const hrvData: HRVData[] = new Array(cols.length);
+    for (let i = 0; i < cols.length; i++) {
+      hrvData[i] = { sdnn: cols.sdnn[i], heartRate: cols.heartRate[i], stress: cols.stress[i], timestamp: cols.timestamp[i] };
     }
-
     return hrvData;
   }
 
@@ -934,32 +993,33 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
 
   async getSpO2DataNormalized(): Promise<SpO2Data[]> {
     const result = await this.getSpO2Data();
-    const spo2Data: SpO2Data[] = [];
-
-    for (const record of (result.records || [])) {
-      // X3 SDK returns paginated packets, each with arrayAutomaticSpo2Data[]
-      const entries: any[] = record.arrayAutomaticSpo2Data || [];
-      if (entries.length > 0) {
-        for (const entry of entries) {
-          // Key is automaticSpo2Data (not spo2)
-          const spo2 = Number(entry.automaticSpo2Data ?? entry.spo2 ?? 0);
-          if (spo2 > 0) {
-            const ts = this.parseX3DateTime(entry.date) ?? result.timestamp;
-            spo2Data.push({ spo2, timestamp: ts });
-          }
-        }
-        continue;
-      }
-      // Fallback: flat record with spo2 key
-      const spo2 = Number(record.spo2 ?? 0);
-      if (spo2 > 0) {
-        spo2Data.push({ spo2, timestamp: result.timestamp });
-      }
+    // Packets carry arrayAutomaticSpo2Data[] (value key automaticSpo2Data, not spo2)
+    const cols = x3SpO2Columns(result.records, result.timestamp);
+    const spo2Data: SpO2Data[] = new Array(cols.length);
+    for (let i = 0; i < cols.length; i++) {
+      spo2Data[i] = { spo2: cols.spo2[i], timestamp: cols.timestamp[i] };
     }
-
     return spo2Data;
   }
 
+  /** Raw continuous SpO2 packets (per-minute overnight values) from `since`; see OvernightStore. */
+  async getContinuousSpO2(since: string | null): Promise<any[]> {
+    if (!JstyleBridge) throw new Error('Jstyle SDK not available');
+    const result: any = await this.enqueueNativeCall<any>('getContinuousSpO2Data', async () =>
+      withNativeTimeout(JstyleBridge.getContinuousSpO2Data(since), 30000, 'getContinuousSpO2Data')
+    );
+    return result?.data || [];
+  }
+
+  /** Raw sleep detail + activity packets from `since`; see OvernightStore. */
+  async getSleepWithActivity(since: string | null): Promise<any[]> {
+    if (!JstyleBridge) throw new Error('Jstyle SDK not available');
+    const result: any = await this.enqueueNativeCall<any>('getSleepWithActivity', async () =>
+      withNativeTimeout(JstyleBridge.getSleepWithActivity(since), 30000, 'getSleepWithActivity')
+    );
+    return result?.data || [];
+  }
+
   async startSpO2Measuring(): Promise<{ success: boolean; message: string }> {
     if (!JstyleBridge) throw new Error('Jstyle SDK not available');
     return await JstyleBridge.startSpO2Measurement();
@@ -989,29 +1049,12 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
 
   async getTemperatureDataNormalized(): Promise<TemperatureData[]> {
     const result = await this.getTemperatureData();
-    const tempData: TemperatureData[] = [];
-
-    for (const record of (result.records || [])) {
-      // X3 SDK returns paginated packets, each with arrayemperatureData[] (SDK typo — missing capital T)
-      const entries: any[] = record.arrayemperatureData || record.arrayTemperatureData || [];
-      if (entries.length > 0) {
-        for (const entry of entries) {
-          const temp = Number(entry.temperature ?? 0);
-          // Filter to human body temperature range (34–42°C) — SDK returns corrupted values outside this range
-          if (temp >= 34 && temp <= 42) {
-            const ts = this.parseX3DateTime(entry.date) ?? result.timestamp;
-            tempData.push({ temperature: temp, timestamp: ts });
-          }
-        }
-        continue;
-      }
-      // Fallback: flat record
-      const temp = Number(record.temperature ?? 0);
-      if (temp >= 34 && temp <= 42) {
-        tempData.push({ temperature: temp, timestamp: result.timestamp });
-      }
+    // Out-of-range (corrupted) values are already dropped by x3TemperatureColumns
+    const cols = x3TemperatureColumns(result.records, result.timestamp);
+    const tempData: TemperatureData[] = new Array(cols.length);
+    for (let i = 0; i < cols.length; i++) {
+      tempData[i] = { temperature: cols.temperature[i], timestamp: cols.timestamp[i] };
     }
-
     return tempData;
   }
 
@@ -1031,6 +1074,31 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
     );
   }
 
+  /**
+   * Clear one history type on the ring (0x99 delete mode). `operation` is the fetch method the
+   * records came from, e.g. 'getDetailActivityData'. Only call after RingStorageReclaimer has
+   * verified those records are stored locally and acked by the backend. Resolves when the
+   * ring acknowledges the delete, not when the command is written.
+   */
+  async deleteHistoryData(operation: string): Promise<{ success: boolean }> {
+    if (!JstyleBridge) throw new Error('Jstyle SDK not available');
+    return await this.enqueueNativeCall<{ success: boolean }>('deleteHistoryData', async () =>
+      withNativeTimeout(JstyleBridge.deleteHistoryData(operation), 5000, 'deleteHistoryData')
+    );
+  }
+
+  // Not queued: reads counters only, never touches the ring
+  async getFetchMetrics(): Promise<Record<string, NativeFetchMetrics>> {
+    if (!JstyleBridge || typeof JstyleBridge.getFetchMetrics !== 'function') return {};
+    return await JstyleBridge.getFetchMetrics();
+  }
+
+  // Not queued: link + fetch telemetry, cumulative since launch or resetSyncStats
+  async getSyncStats(): Promise<NativeSyncStats | null> {
+    if (!JstyleBridge || typeof JstyleBridge.getSyncStats !== 'function') return null;
+    return await JstyleBridge.getSyncStats();
+  }
+
   // ========== Activity / Sport Mode ==========
 
   async getActivityModeData(): Promise<{ records: any[]; timestamp: number }> {
@@ -1046,45 +1114,37 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
 
   async getActivityModeDataNormalized(): Promise<X3ActivitySession[]> {
     const result = await this.getActivityModeData();
+    const cols = x3ActivityModeColumns(result.records);
     const sessions: X3ActivitySession[] = [];
 
-    for (const record of (result.records || [])) {
-      const entries = Array.isArray(record?.arrayActivityModeData)
-        ? record.arrayActivityModeData
-        : [record];
-
-      for (const entry of entries) {
-        const raw = entry || {};
-        const mode = Math.round(this.pickNumber(raw, ['activityMode', 'sportType', 'mode', 'type']) ?? -1);
-        const durationMin = this.pickNumber(raw, ['activityTime', 'duration', 'exerciseMinutes']) ?? 0;
-        const durationSec = Math.max(0, Math.round(durationMin > 1000 ? durationMin : durationMin * 60));
-
-        const parsedStart = this.parseX3DateTime(
-          raw.startDate || raw.startTime || raw.date || raw.startTime_ActivityModeData
-        );
-        const parsedEnd = this.parseX3DateTime(raw.endDate || raw.endTime);
-        const startTime = parsedStart ?? result.timestamp;
-        const endTime = parsedEnd ?? (durationSec > 0 ? startTime + durationSec * 1000 : startTime);
-
-        const steps = Math.max(0, Math.round(this.pickNumber(raw, ['step', 'steps']) ?? 0));
-        const distanceKm = this.pickNumber(raw, ['distance', 'distanceKm']) ?? 0;
-        const calories = Math.max(0, Math.round(this.pickNumber(raw, ['calories', 'kcal']) ?? 0));
-        const heartRateAvg = this.pickNumber(raw, ['averageHeartRate', 'avgHeartRate', 'heartRateAvg']);
-        const heartRateMax = this.pickNumber(raw, ['maxHeartRate', 'heartRateMax']);
-
-        sessions.push({
-          type: this.toSportType(mode),
-          typeLabel: raw.sportName || raw.modeName || `Sport ${mode >= 0 ? mode : 'Unknown'}`,
-          startTime,
-          endTime,
-          duration: Math.max(0, Math.round((endTime - startTime) / 1000)),
-          steps,
-          distance: Math.max(0, Math.round(distanceKm * 1000)),
-          calories,
-          heartRateAvg: heartRateAvg && heartRateAvg > 0 ? Math.round(heartRateAvg) : undefined,
-          heartRateMax: heartRateMax && heartRateMax > 0 ? Math.round(heartRateMax) : undefined,
-        });
-      }
+    for (let i = 0; i < cols.length; i++) {
+      const mode = Number.isNaN(cols.mode[i]) ? -1 : Math.round(cols.mode[i]);
+      const durationMin = Number.isNaN(cols.duration[i]) ? 0 : cols.duration[i];
+      const durationSec = Math.max(0, Math.round(durationMin > 1000 ? durationMin : durationMin * 60));
+
+      const startTime = Number.isNaN(cols.startTime[i]) ? result.timestamp : cols.startTime[i];
+      const endTime = !Number.isNaN(cols.endTime[i])
+        ? cols.endTime[i]
+        : (durationSec > 0 ? startTime + durationSec * 1000 : startTime);
+
+      const steps = Math.max(0, Math.round(cols.steps[i] || 0));
+      const distanceKm = cols.distanceKm[i] || 0;
+      const calories = Math.max(0, Math.round(cols.calories[i] || 0));
+      const heartRateAvg = cols.heartRateAvg[i];
+      const heartRateMax = cols.heartRateMax[i];
+
+      sessions.push({
+        type: this.toSportType(mode),
+        typeLabel: cols.label[i] || `Sport ${mode >= 0 ? mode : 'Unknown'}`,
+        startTime,
+        endTime,
+        duration: Math.max(0, Math.round((endTime - startTime) / 1000)),
+        steps,
+        distance: Math.max(0, Math.round(distanceKm * 1000)),
+        calories,
+        heartRateAvg: heartRateAvg > 0 ? Math.round(heartRateAvg) : undefined,
+        heartRateMax: heartRateMax > 0 ? Math.round(heartRateMax) : undefined,
+      });
     }
 
     return sessions
@@ -1092,6 +1152,15 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
       .sort((a, b) => b.startTime - a.startTime);
   }
 
+  /** 10-minute activity windows at or after `since` ("YYYY.MM.DD HH:mm:ss" of a stored window); null = everything. */
+  async getDetailActivity(since: string | null): Promise<DetailActivityWindow[]> {
+    if (!JstyleBridge) throw new Error('Jstyle SDK not available');
+    const result: any = await this.enqueueNativeCall<any>('getDetailActivityData', async () =>
+      withNativeTimeout(JstyleBridge.getDetailActivityData(since), 30000, 'getDetailActivityData')
+    );
+    return result?.data || [];
+  }
+
   async getSleepHRVData(): Promise<{ records: any[]; timestamp: number }> {
     if (!JstyleBridge) throw new Error('Jstyle SDK not available');
     const result: any = await this.enqueueNativeCall<any>('getSleepHRVData', async () =>
@@ -1105,33 +1174,18 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
 
   async getSleepHrvDataNormalized(): Promise<X3SleepBreathingMetrics[]> {
     const result = await this.getSleepHRVData();
-    const metrics: X3SleepBreathingMetrics[] = [];
-
-    for (const record of (result.records || [])) {
-      const entries = Array.isArray(record?.arraySleepHrvData)
-        ? record.arraySleepHrvData
-        : [record];
-
-      for (const entry of entries) {
-        const timestamp =
-          this.parseX3DateTime(entry?.date || entry?.startDate || entry?.startTime) ?? result.timestamp;
-        const respiratoryRate = this.pickNumber(entry || {}, [
-          'respiratoryRate',
-          'respRate',
-          'breathRate',
-          'sleepRespiratoryRate',
-        ]);
-        const oxygenDropIndex = this.pickNumber(entry || {}, ['oxygenDropIndex', 'odi']);
-
-        metrics.push({
-          timestamp,
-          respiratoryRate:
-            respiratoryRate && respiratoryRate >= 8 && respiratoryRate <= 40
-              ? Math.round(respiratoryRate)
-              : undefined,
-          oxygenDropIndex: oxygenDropIndex && oxygenDropIndex >= 0 ? oxygenDropIndex : undefined,
-        });
-      }
+    const cols = x3SleepHrvColumns(result.records, result.timestamp);
+    const metrics: X3SleepBreathingMetrics[] = new Array(cols.length);
+
+    for (let i = 0; i < cols.length; i++) {
+      const respiratoryRate = cols.respiratoryRate[i];
+      const oxygenDropIndex = cols.oxygenDropIndex[i];
+      metrics[i] = {
+        timestamp: cols.timestamp[i],
+        respiratoryRate: respiratoryRate >= 8 && respiratoryRate <= 40 ? Math.round(respiratoryRate) : undefined,
+        // NaN (missing) fails the comparison; 0 counts as missing like before
+        oxygenDropIndex: oxygenDropIndex > 0 ? oxygenDropIndex : undefined,
+      };
     }
 
     return metrics;
@@ -1164,19 +1218,9 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
     const combined: X3SleepBreathingMetrics[] = [];
 
     const append = (records: any[], key: 'apnoeaEvents' | 'eovEvents') => {
-      for (const record of records) {
-        const entries = Array.isArray(record?.arrayOSAData) || Array.isArray(record?.arrayEOVData)
-          ? [...(record.arrayOSAData || []), ...(record.arrayEOVData || [])]
-          : [record];
-        for (const entry of entries) {
-          const value = this.pickNumber(entry || {}, ['eventCount', 'count', 'events', 'value']);
-          if (!value || value < 0) continue;
-          const metric: X3SleepBreathingMetrics = {
-            timestamp: this.parseX3DateTime(entry?.date || entry?.startDate || entry?.startTime) ?? Date.now(),
-          };
-          metric[key] = Math.round(value);
-          combined.push(metric);
-        }
+      const cols = x3EventCountColumns(records, Date.now());
+      for (let i = 0; i < cols.length; i++) {
+        combined.push({ timestamp: cols.timestamp[i], [key]: Math.round(cols.count[i]) });
       }
     };
 
@@ -1196,22 +1240,18 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
     };
   }
 
-  async getPpiDataNormalized(): Promise<Array<{ timestamp: number; ppi: number }>> {
+  /** PPI history as typed columns; a week of beat intervals stays out of per-row objects. */
+  async getPpiDataColumns(): Promise<PpiColumns> {
     const result = await this.getPPIData();
-    const ppiData: Array<{ timestamp: number; ppi: number }> = [];
+    return x3PpiColumns(result.records, result.timestamp);
+  }
 
-    for (const record of (result.records || [])) {
-      const entries = Array.isArray(record?.arrayPpiData) ? record.arrayPpiData : [record];
-      for (const entry of entries) {
-        const ppi = this.pickNumber(entry || {}, ['ppi', 'rrInterval', 'rri']);
-        if (!ppi || ppi <= 0) continue;
-        ppiData.push({
-          timestamp: this.parseX3DateTime(entry?.date || entry?.startDate || entry?.startTime) ?? result.timestamp,
-          ppi,
-        });
-      }
+  async getPpiDataNormalized(): Promise<Array<{ timestamp: number; ppi: number }>> {
+    const cols = await this.getPpiDataColumns();
+    const ppiData: Array<{ timestamp: number; ppi: number }> = new Array(cols.length);
+    for (let i = 0; i < cols.length; i++) {
+      ppiData[i] = { timestamp: cols.timestamp[i], ppi: cols.ppi[i] };
     }
-
     return ppiData;
   }
 
@@ -1285,11 +1325,26 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
     };
   }
 
+  /** Raw activity-mode packets (live workout samples and start/pause/stop acks). */
+  onActivityModeData(callback: (data: any) => void): () => void {
+    if (!eventEmitter) return () => {};
+    const subscription = eventEmitter.addListener('onActivityModeData', callback);
+    return () => subscription.remove();
+  }
+
+  /** Services are discovered and the ring accepts commands (every connect, incl. native reconnects). */
+  onDeviceReady(callback: (event: { deviceId: string }) => void): () => void {
+    if (!eventEmitter) return () => {};
+    const subscription = eventEmitter.addListener('onDeviceReady', callback);
+    return () => subscription.remove();
+  }
+
   onCurrentStepInfo(callback: (data: { steps: number; calories: number; distance: number }) => void): () => void {
     if (!eventEmitter) return () => {};
     // Step info comes through onRealTimeData
-    const subscription = eventEmitter.addListener('onRealTimeData', (data) => {
-      if (data.steps !== undefined) {
+    const subscription = eventEmitter.addListener('onRealTimeData', (frame) => {
+      if (RealtimeFrameDecoder.touches(frame, ['steps', 'calories', 'distance'])) {
+        const data: any = this.realtimeFrames.decode(frame);
         callback({
           steps: data.steps || 0,
           calories: data.calories || 0,
@@ -1354,10 +1409,11 @@ async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
     return () => {};
   }
 
-  onDebugLog(callback: (message: string, timestamp: number) => void): () => void {
+  /** Native log entries, delivered in batches every ~0.5 s (see ios/JstyleBridge/BleLogQueue). */
+  onDebugLog(callback: (batch: NativeLogBatch) => void): () => void {
     if (!eventEmitter) return () => {};
     const subscription = eventEmitter.addListener('onDebugLog', (event) => {
-      callback(event.message, event.timestamp);
+      callback(decodeLogBatch(event.batch));
     });
     return () => subscription.remove();
   }
@@ -0,0 +1,220 @@
+/**
+ * LogPipeline — buffered, sampled remote logging
+ *
+ * log() is synchronous and cheap: a level/sampling check, then a push onto a bounded
+ * in-memory buffer (oldest entries are dropped first when it's full). Nothing touches
+ * the network until flush(), which runs every flushIntervalMs once start()ed and hands
+ * the sink up to maxBatch entries per call — one insert per batch instead of one per
+ * event. A failed batch goes back to the front of the buffer for the next flush.
+ *
+ * decodeLogBatch() reads the binary batches the native bridges send as onDebugLog /
+ * V8DebugLog (layout in ios/JstyleBridge/BleLog.h).
+ *
+ * No React Native imports: the sink is injected.
+ */
+
+export type LogLevel = 'debug' | 'info' | 'warn' | 'error';
+
+/** Ordered like BleLogLevel in ios/JstyleBridge/BleLog.h; the index is the wire value. */
+export const LOG_LEVELS: readonly LogLevel[] = ['debug', 'info', 'warn', 'error'];
+
+export function atLeast(level: LogLevel, min: LogLevel): boolean {
+  return LOG_LEVELS.indexOf(level) >= LOG_LEVELS.indexOf(min);
+}
+
+export interface LogEntry {
+  level: LogLevel;
+  /** Epoch ms. */
+  at: number;
+  source: string;
+  event: string;
+  payload?: Record<string, unknown>;
+  userId?: string;
+}
+
+/** Writes one batch; rejecting keeps the batch for the next flush. */
+export type LogSink = (entries: LogEntry[]) => Promise<void>;
+
+export interface LogPipelineOptions {
+  minLevel?: LogLevel;
+  /** Keep one entry in n per level (e.g. { debug: 10 }); 0 or 1 keeps all. */
+  sample?: Partial<Record<LogLevel, number>>;
+  maxBuffer?: number;
+  maxBatch?: number;
+  flushIntervalMs?: number;
+  now?: () => number;
+}
+
+export interface LogPipelineStats {
+  logged: number;
+  sampledOut: number;
+  /** Lost to a full buffer. */
+  dropped: number;
+  uploaded: number;
+  batches: number;
+  failedBatches: number;
+  buffered: number;
+}
+
+export class LogPipeline {
+  private readonly sink: LogSink;
+  private readonly maxBuffer: number;
+  private readonly maxBatch: number;
+  private readonly flushIntervalMs: number;
+  private readonly now: () => number;
+  private minIndex: number;
+  private sample: Partial<Record<LogLevel, number>>;
+  private sampleCounters: Record<LogLevel, number> = { debug: 0, info: 0, warn: 0, error: 0 };
+
+  private buffer: LogEntry[] = [];
+  private inFlight: Promise<number> | null = null;
+  private timer: ReturnType<typeof setInterval> | null = null;
+  private counters = { logged: 0, sampledOut: 0, dropped: 0, uploaded: 0, batches: 0, failedBatches: 0 };
+
+  constructor(sink: LogSink, options: LogPipelineOptions = {}) {
+    this.sink = sink;
+    this.minIndex = LOG_LEVELS.indexOf(options.minLevel ?? 'info');
+    this.sample = options.sample ?? {};
+    this.maxBuffer = options.maxBuffer ?? 500;
+    this.maxBatch = options.maxBatch ?? 100;
+    this.flushIntervalMs = options.flushIntervalMs ?? 30_000;
+    this.now = options.now ?? Date.now;
+  }
+
+  configure(options: Pick<LogPipelineOptions, 'minLevel' | 'sample'>): void {
+    if (options.minLevel) this.minIndex = LOG_LEVELS.indexOf(options.minLevel);
+    if (options.sample) this.sample = { ...this.sample, ...options.sample };
+  }
+
+  /** Whether an entry at `level` passes the threshold; check before building a costly payload. */
+  enabled(level: LogLevel): boolean {
+    return LOG_LEVELS.indexOf(level) >= this.minIndex;
+  }
+
+  log(level: LogLevel, source: string, event: string, payload?: Record<string, unknown>, userId?: string): void {
+    if (!this.enabled(level)) return;
+    const every = this.sample[level] ?? 1;
+    if (every > 1 && this.sampleCounters[level]++ % every !== 0) {
+      this.counters.sampledOut += 1;
+      return;
+    }
+    this.counters.logged += 1;
+    if (this.buffer.length >= this.maxBuffer) {
+      this.buffer.shift();
+      this.counters.dropped += 1;
+    }
+    this.buffer.push({ level, at: this.now(), source, event, payload, userId });
+  }
+
+  /** Send everything buffered, one sink call per maxBatch entries. Resolves the count sent. */
+  flush(): Promise<number> {
+    if (this.inFlight) return this.inFlight;
+    this.inFlight = this.drain().finally(() => {
+      this.inFlight = null;
+    });
+    return this.inFlight;
+  }
+
+  start(): void {
+    if (this.timer) return;
+    this.timer = setInterval(() => { this.flush(); }, this.flushIntervalMs);
+  }
+
+  stop(): void {
+    if (this.timer) clearInterval(this.timer);
+    this.timer = null;
+  }
+
+  stats(): LogPipelineStats {
+    return { ...this.counters, buffered: this.buffer.length };
+  }
+
+  private async drain(): Promise<number> {
+    let sent = 0;
+    while (this.buffer.length > 0) {
+      const batch = this.buffer.splice(0, this.maxBatch);
+      try {
+        await this.sink(batch);
+      } catch {
+        // Back in front of anything logged meanwhile, still within maxBuffer
+        this.counters.failedBatches += 1;
+        const room = Math.max(0, this.maxBuffer - this.buffer.length);
+        this.counters.dropped += Math.max(0, batch.length - room);
+        this.buffer.unshift(...batch.slice(batch.length - room));
+        break;
+      }
+      sent += batch.length;
+      this.counters.uploaded += batch.length;
+      this.counters.batches += 1;
+    }
+    return sent;
+  }
+}
+
+// ========== Native batches ==========
+
+const BATCH_MAGIC = 0x474f4c42; // "BLOG"
+const BATCH_VERSION = 1;
+const HEADER_BYTES = 24;
+const ENTRY_HEADER_BYTES = 7;
+
+export interface NativeLogEntry {
+  level: LogLevel;
+  at: number;
+  message: string;
+}
+
+export interface NativeLogBatch {
+  entries: NativeLogEntry[];
+  /** Entries the native ring dropped (full) since the previous batch. */
+  dropped: number;
+}
+
+/** Decode a base64 batch from onDebugLog / V8DebugLog. A malformed batch decodes as empty. */
+export function decodeLogBatch(base64: string): NativeLogBatch {
+  const bytes = base64ToBytes(base64);
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  if (bytes.length < HEADER_BYTES || view.getUint32(0, true) !== BATCH_MAGIC || view.getUint16(4, true) !== BATCH_VERSION) {
+    return { entries: [], dropped: 0 };
+  }
+  const count = view.getUint32(8, true);
+  const dropped = view.getUint32(12, true);
+  const baseMs = view.getFloat64(16, true);
+  const entries: NativeLogEntry[] = [];
+  let offset = HEADER_BYTES;
+  while (entries.length < count && offset + ENTRY_HEADER_BYTES <= bytes.length) {
+    const length = view.getUint16(offset + 5, true);
+    const start = offset + ENTRY_HEADER_BYTES;
+    if (start + length > bytes.length) break;
+    entries.push({
+      at: baseMs + view.getInt32(offset, true),
+      level: LOG_LEVELS[bytes[offset + 4]] ?? 'info',
+      message: utf8Decode(bytes, start, start + length),
+    });
+    offset = start + length;
+  }
+  return { entries, dropped };
+}
+
+function base64ToBytes(base64: string): Uint8Array {
+  const binary = atob(base64);
+  const bytes = new Uint8Array(binary.length);
+  for (let i = 0; i < binary.length; i++) bytes[i] = binary.charCodeAt(i);
+  return bytes;
+}
+
+// Hermes has no TextDecoder; the native side only ever cuts on character boundaries
+function utf8Decode(bytes: Uint8Array, start: number, end: number): string {
+  let out = '';
+  let i = start;
+  while (i < end) {
+    const b = bytes[i++];
+    let cp: number;
+    if (b < 0x80) cp = b;
+    else if (b < 0xe0) cp = ((b & 0x1f) << 6) | (bytes[i++] & 0x3f);
+    else if (b < 0xf0) cp = ((b & 0x0f) << 12) | ((bytes[i++] & 0x3f) << 6) | (bytes[i++] & 0x3f);
+    else cp = ((b & 0x07) << 18) | ((bytes[i++] & 0x3f) << 12) | ((bytes[i++] & 0x3f) << 6) | (bytes[i++] & 0x3f);
+    out += String.fromCodePoint(cp);
+  }
+  return out;
+}
@@ -0,0 +1,42 @@
+/**
+ * NativeCallQueue — runs bridge calls one at a time, in order
+ *
+ * Each bridge holds a single pending request, and a command written while a paged
+ * history fetch is in flight interleaves with its pages. So every call that talks
+ * to the ring goes through one queue per bridge. Priority calls (workout start /
+ * stop) go ahead of everything still waiting, in their own order, but never
+ * interrupt the call in flight.
+ */
+
+export interface NativeCallOptions {
+  /** Run next, ahead of non-priority calls already waiting. */
+  priority?: boolean;
+}
+
+export class NativeCallQueue {
+  private readonly waiting: (() => void)[] = [];
+  /** Leading entries of `waiting` that are priority calls. */
+  private priorityWaiting = 0;
+  private running = false;
+
+  run<T>(task: () => Promise<T>, options: NativeCallOptions = {}): Promise<T> {
+    return new Promise<T>((resolve, reject) => {
+      const start = () => {
+        Promise.resolve()
+          .then(task)
+          .then(resolve, reject)
+          .finally(() => this.next());
+      };
+      if (options.priority) this.waiting.splice(this.priorityWaiting++, 0, start);
+      else this.waiting.push(start);
+      if (!this.running) this.next();
+    });
+  }
+
+  private next(): void {
+    const start = this.waiting.shift();
+    if (this.priorityWaiting > 0) this.priorityWaiting--;
+    this.running = start !== undefined;
+    start?.();
+  }
+}
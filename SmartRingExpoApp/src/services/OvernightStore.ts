@@ -0,0 +1,418 @@
+/**
+ * OvernightStore — per-minute overnight SpO2 and sleep+activity series from the X3 ring
+ *
+ * Two X3 history streams are the densest the ring keeps: continuous SpO2 (one
+ * value per minute) and sleep detail paired with activity per sleep unit. Both
+ * are folded into one fixed grid per night, 18:00 → 12:00 local (1080
+ * minutes), keyed by the wake date:
+ *
+ *   spo2   Uint8   saturation %, 0 = no sample
+ *   stage  Uint8   SDK sleep quality + 1 (1=Deep, 2=Light, 3=REM, other=Awake), 0 = none
+ *   motion Uint16  activity level during that minute
+ *
+ * Each sync asks the ring only for records from the newest one already
+ * ingested (per-stream cursor) and recomputes the touched nights' summaries
+ * once: SpO2 mean / min / minutes below 90 %, oxygen desaturation index and
+ * restless minutes. Sleep and breathing analytics read the summaries.
+ *
+ * Record key names for these streams differ across X3 firmware, so parsing
+ * accepts the known variants. Writes are slot overwrites (idempotent).
+ *
+ * No React Native imports: fetchers and storage are injected.
+ */
+
+import { encodeZeroRuns, decodeZeroRuns } from '../utils/zeroRuns';
+import { parseRingDate } from '../utils/ringDate';
+import { localDateKey, type ActivityDetailStorage } from './ActivityDetailStore';
+
+const KEY_PREFIX = 'overnight_v1:';
+const SPO2_CURSOR_KEY = 'overnight_v1_cursor_spo2';
+const SLEEP_CURSOR_KEY = 'overnight_v1_cursor_sleep';
+
+export const NIGHT_START_HOUR = 18;
+export const NIGHT_END_HOUR = 12;
+export const NIGHT_MINUTES = (24 - NIGHT_START_HOUR + NIGHT_END_HOUR) * 60;
+
+const SPO2_MIN_VALID = 70;
+const SPO2_MAX_VALID = 100;
+/** A desaturation is a drop of at least this many points below the recent baseline. */
+const DESAT_DROP = 3;
+const DESAT_BASELINE_MINUTES = 5;
+
+export interface OvernightSummary {
+  nightKey: string;       // YYYY-MM-DD of the morning
+  spo2Minutes: number;
+  spo2Avg: number | null;
+  spo2Min: number | null;
+  minutesBelow90: number;
+  /** Desaturations (≥3 points) per hour of SpO2 coverage. */
+  odi: number | null;
+  sleepMinutes: number;
+  /** Asleep minutes with any movement. */
+  restlessMinutes: number;
+}
+
+export interface OvernightSeries {
+  nightKey: string;
+  startMs: number;        // 18:00 the evening before
+  spo2: Uint8Array;
+  stage: Uint8Array;
+  motion: Uint16Array;
+}
+
+export interface OvernightSyncResult {
+  spo2Records: number;
+  sleepRecords: number;
+  nights: string[];
+  /** Streams whose fetch failed (older firmware may not answer one of them). */
+  failed: Array<'spo2' | 'sleepActivity'>;
+}
+
+/** Raw packets as resolved by the bridge (whole packet dictionaries). */
+export type OvernightFetcher = (since: string | null) => Promise<any[]>;
+
+export interface OvernightStoreOptions {
+  retentionDays?: number;
+  now?: () => number;
+}
+
+interface NightBuffer extends OvernightSeries {
+  summary: OvernightSummary;
+}
+
+interface PersistedNight {
+  t: number;
+  p: number[];
+  s: number[];
+  m: number[];
+  r: OvernightSummary;
+}
+
+/** Night containing `ms`, or null for daytime minutes (12:00–18:00). */
+export function nightFor(ms: number): { nightKey: string; startMs: number } | null {
+  const d = new Date(ms);
+  const h = d.getHours();
+  if (h >= NIGHT_END_HOUR && h < NIGHT_START_HOUR) return null;
+  const start = new Date(d.getFullYear(), d.getMonth(), d.getDate(), NIGHT_START_HOUR);
+  if (h < NIGHT_END_HOUR) start.setDate(start.getDate() - 1);
+  const wake = new Date(start.getFullYear(), start.getMonth(), start.getDate() + 1);
+  return { nightKey: localDateKey(wake), startMs: start.getTime() };
+}
+
+function firstArray(obj: any, keys: readonly string[]): any[] | null {
+  for (const key of keys) {
+    if (Array.isArray(obj?.[key])) return obj[key];
+  }
+  return null;
+}
+
+function entriesOf(packet: any, keys: readonly string[]): any[] {
+  if (Array.isArray(packet)) return packet;
+  const list = firstArray(packet, keys);
+  // Same key can hold the per-minute values of a single-entry packet
+  if (list && (list.length === 0 || typeof list[0] === 'object')) return list;
+  return packet && typeof packet === 'object' ? [packet] : [];
+}
+
+const SPO2_ENTRY_KEYS = ['arrayContinueSpo2Data', 'continueSpo2Data', 'arrayContinuousSpo2Data'] as const;
+const SPO2_VALUE_ARRAY_KEYS = ['arrayContinueSpo2Data', 'arraySpo2', 'continueSpo2Data', 'arraySpO2'] as const;
+const SLEEP_ENTRY_KEYS = ['arraySleepData', 'arrayDetailSleepAndActivityData', 'arrayDetailSleepData'] as const;
+const SLEEP_QUALITY_KEYS = ['arraySleepQuality', 'arraySleepData_perMinute', 'arraySleepData_per2Minutes', 'arraySleep'] as const;
+const SLEEP_ACTIVITY_KEYS = ['arrayActicityData', 'arrayActivityData', 'arraySteps', 'arrayStep'] as const;
+
+/** Calls `visit(ms, spo2)` for every minute sample in continuous SpO2 packets. Returns the newest entry date. */
+export function forEachSpO2Minute(packets: readonly any[], visit: (ms: number, spo2: number) => void): { entries: number; newest: string | null } {
+  let entries = 0;
+  let newest: string | null = null;
+  let newestMs = -Infinity;
+  for (const packet of packets) {
+    for (const entry of entriesOf(packet, SPO2_ENTRY_KEYS)) {
+      const dateStr = entry?.date ?? entry?.strDate ?? entry?.startDate;
+      const start = parseRingDate(dateStr);
+      if (start == null) continue;
+      entries++;
+      if (start > newestMs) {
+        newestMs = start;
+        newest = String(dateStr).trim();
+      }
+      const values = firstArray(entry, SPO2_VALUE_ARRAY_KEYS);
+      if (values) {
+        for (let i = 0; i < values.length; i++) visit(start + i * 60_000, Number(values[i]) || 0);
+      } else {
+        visit(start, Number(entry.continueSpo2Data ?? entry.numberSpo2 ?? entry.spo2) || 0);
+      }
+    }
+  }
+  return { entries, newest };
+}
+
+/** Calls `visit(ms, quality, activity)` per minute of sleep+activity packets (units wider than a minute are expanded). */
+export function forEachSleepMinute(
+  packets: readonly any[],
+  visit: (ms: number, quality: number, activity: number) => void,
+): { entries: number; newest: string | null } {
+  let entries = 0;
+  let newest: string | null = null;
+  let newestMs = -Infinity;
+  for (const packet of packets) {
+    for (const entry of entriesOf(packet, SLEEP_ENTRY_KEYS)) {
+      const dateStr = entry?.startTime_SleepData ?? entry?.date ?? entry?.startTime;
+      const start = parseRingDate(dateStr);
+      const quality = firstArray(entry, SLEEP_QUALITY_KEYS);
+      if (start == null || !quality) continue;
+      entries++;
+      if (start > newestMs) {
+        newestMs = start;
+        newest = String(dateStr).trim();
+      }
+      const activity = firstArray(entry, SLEEP_ACTIVITY_KEYS) ?? [];
+      const unit = Math.max(1, Math.round(Number(entry.sleepUnitLength) || (entry.arraySleepData_per2Minutes ? 2 : 1)));
+      for (let i = 0; i < quality.length; i++) {
+        const q = Number(quality[i]) || 0;
+        const a = Math.max(0, Number(activity[i]) || 0);
+        for (let k = 0; k < unit; k++) visit(start + (i * unit + k) * 60_000, q, a);
+      }
+    }
+  }
+  return { entries, newest };
+}
+
+export function summarizeNight(nightKey: string, spo2: Uint8Array, stage: Uint8Array, motion: Uint16Array): OvernightSummary {
+  let n = 0;
+  let sum = 0;
+  let min = Infinity;
+  let below90 = 0;
+  let events = 0;
+  let inEvent = false;
+  let eventBase = 0;
+  const recent: number[] = [];
+  let sleepMinutes = 0;
+  let restless = 0;
+
+  for (let i = 0; i < spo2.length; i++) {
+    const st = stage[i];
+    if (st >= 2 && st <= 4) {
+      sleepMinutes++;
+      if (motion[i] > 0) restless++;
+    }
+
+    const v = spo2[i];
+    if (v === 0) continue;
+    n++;
+    sum += v;
+    if (v < min) min = v;
+    if (v < 90) below90++;
+
+    if (!inEvent) {
+      if (recent.length >= 3) {
+        let base = 0;
+        for (const r of recent) if (r > base) base = r;
+        if (v <= base - DESAT_DROP) {
+          events++;
+          inEvent = true;
+          eventBase = base;
+        }
+      }
+    } else if (v >= eventBase - 1) {
+      inEvent = false;
+    }
+    recent.push(v);
+    if (recent.length > DESAT_BASELINE_MINUTES) recent.shift();
+  }
+
+  return {
+    nightKey,
+    spo2Minutes: n,
+    spo2Avg: n > 0 ? Math.round((sum / n) * 10) / 10 : null,
+    spo2Min: n > 0 ? min : null,
+    minutesBelow90: below90,
+    odi: n >= 60 ? Math.round((events / (n / 60)) * 10) / 10 : null,
+    sleepMinutes,
+    restlessMinutes: restless,
+  };
+}
+
+function emptyNight(nightKey: string, startMs: number): NightBuffer {
+  const spo2 = new Uint8Array(NIGHT_MINUTES);
+  const stage = new Uint8Array(NIGHT_MINUTES);
+  const motion = new Uint16Array(NIGHT_MINUTES);
+  return { nightKey, startMs, spo2, stage, motion, summary: summarizeNight(nightKey, spo2, stage, motion) };
+}
+
+export class OvernightStore {
+  private readonly fetchSpO2: OvernightFetcher;
+  private readonly fetchSleepActivity: OvernightFetcher;
+  private readonly storage: ActivityDetailStorage;
+  private readonly retentionDays: number;
+  private readonly now: () => number;
+
+  private readonly summaries = new Map<string, OvernightSummary>();
+  private inFlight: Promise<OvernightSyncResult> | null = null;
+
+  constructor(
+    fetchSpO2: OvernightFetcher,
+    fetchSleepActivity: OvernightFetcher,
+    storage: ActivityDetailStorage,
+    options: OvernightStoreOptions = {},
+  ) {
+    this.fetchSpO2 = fetchSpO2;
+    this.fetchSleepActivity = fetchSleepActivity;
+    this.storage = storage;
+    this.retentionDays = options.retentionDays ?? 14;
+    this.now = options.now ?? Date.now;
+  }
+
+  /** Pull both streams since their cursors and fold them in. Concurrent calls share one sync. */
+  sync(): Promise<OvernightSyncResult> {
+    if (!this.inFlight) {
+      this.inFlight = this.runSync().finally(() => {
+        this.inFlight = null;
+      });
+    }
+    return this.inFlight;
+  }
+
+  async getNight(nightKey: string): Promise<OvernightSummary | null> {
+    return (await this.getNights([nightKey])).get(nightKey) ?? null;
+  }
+
+  async getNights(nightKeys: readonly string[]): Promise<Map<string, OvernightSummary>> {
+    const out = new Map<string, OvernightSummary>();
+    const missing: string[] = [];
+    for (const key of nightKeys) {
+      const cached = this.summaries.get(key);
+      if (cached) out.set(key, cached);
+      else missing.push(key);
+    }
+    if (missing.length > 0) {
+      for (const night of (await this.loadNights(missing)).values()) {
+        this.summaries.set(night.nightKey, night.summary);
+        out.set(night.nightKey, night.summary);
+      }
+    }
+    return out;
+  }
+
+  /** Decoded per-minute arrays for charts (hypnogram overlays, SpO2 trace). */
+  async getSeries(nightKey: string): Promise<OvernightSeries | null> {
+    return (await this.loadNights([nightKey])).get(nightKey) ?? null;
+  }
+
+  private async runSync(): Promise<OvernightSyncResult> {
+    const [spo2Cursor, sleepCursor] = await Promise.all([
+      this.storage.getItem(SPO2_CURSOR_KEY),
+      this.storage.getItem(SLEEP_CURSOR_KEY),
+    ]);
+
+    // BLE calls are serialized by the services anyway; sequential keeps one failure from hiding the other
+    const failed: OvernightSyncResult['failed'] = [];
+    let spo2Packets: any[] = [];
+    let sleepPackets: any[] = [];
+    try {
+      spo2Packets = await this.fetchSpO2(spo2Cursor);
+    } catch {
+      failed.push('spo2');
+    }
+    try {
+      sleepPackets = await this.fetchSleepActivity(sleepCursor);
+    } catch {
+      failed.push('sleepActivity');
+    }
+
+    // First pass: which nights are touched, so they load in one multiGet
+    const keys = new Set<string>();
+    const noteNight = (ms: number) => {
+      const night = nightFor(ms);
+      if (night) keys.add(night.nightKey);
+    };
+    forEachSpO2Minute(spo2Packets, noteNight);
+    forEachSleepMinute(sleepPackets, noteNight);
+    const nights = await this.loadNights([...keys]);
+
+    const touched = new Set<string>();
+    const slotFor = (ms: number): { night: NightBuffer; slot: number } | null => {
+      const where = nightFor(ms);
+      if (!where) return null;
+      let night = nights.get(where.nightKey);
+      if (!night) {
+        night = emptyNight(where.nightKey, where.startMs);
+        nights.set(where.nightKey, night);
+      }
+      const slot = Math.floor((ms - night.startMs) / 60_000);
+      if (slot < 0 || slot >= NIGHT_MINUTES) return null;
+      touched.add(where.nightKey);
+      return { night, slot };
+    };
+
+    const spo2 = forEachSpO2Minute(spo2Packets, (ms, value) => {
+      const at = slotFor(ms);
+      if (!at) return;
+      at.night.spo2[at.slot] = value >= SPO2_MIN_VALID && value <= SPO2_MAX_VALID ? value : 0;
+    });
+    const sleep = forEachSleepMinute(sleepPackets, (ms, quality, activity) => {
+      const at = slotFor(ms);
+      if (!at) return;
+      at.night.stage[at.slot] = Math.min(0xff, quality + 1);
+      at.night.motion[at.slot] = Math.min(0xffff, activity);
+    });
+
+    const pairs: [string, string][] = [];
+    for (const key of touched) {
+      const night = nights.get(key)!;
+      night.summary = summarizeNight(key, night.spo2, night.stage, night.motion);
+      this.summaries.set(key, night.summary);
+      const persisted: PersistedNight = {
+        t: night.startMs,
+        p: encodeZeroRuns(night.spo2),
+        s: encodeZeroRuns(night.stage),
+        m: encodeZeroRuns(night.motion),
+        r: night.summary,
+      };
+      pairs.push([KEY_PREFIX + key, JSON.stringify(persisted)]);
+    }
+    if (spo2.newest && spo2.newest !== spo2Cursor) pairs.push([SPO2_CURSOR_KEY, spo2.newest]);
+    if (sleep.newest && sleep.newest !== sleepCursor) pairs.push([SLEEP_CURSOR_KEY, sleep.newest]);
+    if (pairs.length > 0) await this.storage.multiSet(pairs);
+    if (touched.size > 0) await this.prune();
+
+    return {
+      spo2Records: spo2.entries,
+      sleepRecords: sleep.entries,
+      nights: [...touched].sort(),
+      failed,
+    };
+  }
+
+  private async loadNights(nightKeys: readonly string[]): Promise<Map<string, NightBuffer>> {
+    const out = new Map<string, NightBuffer>();
+    if (nightKeys.length === 0) return out;
+    const rows = await this.storage.multiGet(nightKeys.map(k => KEY_PREFIX + k));
+    for (const [key, raw] of rows) {
+      if (!raw) continue;
+      const nightKey = key.slice(KEY_PREFIX.length);
+      try {
+        const p = JSON.parse(raw) as PersistedNight;
+        const night = emptyNight(nightKey, p.t);
+        decodeZeroRuns(p.p, night.spo2);
+        decodeZeroRuns(p.s, night.stage);
+        decodeZeroRuns(p.m, night.motion);
+        night.summary = p.r;
+        out.set(nightKey, night);
+      } catch {
+        // Corrupt entry: start the night over
+      }
+    }
+    return out;
+  }
+
+  private async prune(): Promise<void> {
+    const cutoff = new Date(this.now());
+    cutoff.setDate(cutoff.getDate() - this.retentionDays);
+    const cutoffKey = localDateKey(cutoff);
+    const keys = await this.storage.getAllKeys();
+    const stale = keys.filter(k => k.startsWith(KEY_PREFIX) && k.slice(KEY_PREFIX.length) < cutoffKey);
+    if (stale.length === 0) return;
+    for (const k of stale) this.summaries.delete(k.slice(KEY_PREFIX.length));
+    await this.storage.multiRemove(stale);
+  }
+}
@@ -5,6 +5,8 @@
 
 import AsyncStorage from '@react-native-async-storage/async-storage';
 import { supabase } from './SupabaseService';
+import { getRowsSince } from './DeltaSyncService';
+import { BASELINE_DAYS, baselineMedian, median, pushRolling } from '../utils/rollingStats';
 import type {
   FocusBaselines,
   ReadinessScore,
@@ -62,23 +64,20 @@ export async function saveBaselines(b: FocusBaselines): Promise<void> {
 export async function bootstrapBaselinesFromSupabase(userId: string): Promise<FocusBaselines> {
   const cutoff = new Date();
   cutoff.setDate(cutoff.getDate() - 14);
-  const since = cutoff.toISOString();
 
+  // Shares the delta-sync cache with the detail screens, so a warm start
+  // only pulls rows changed since the last cursor instead of 14 days of history.
   const [hrvRes, sleepRes, tempRes, hrRes] = await Promise.allSettled([
-    supabase.from('hrv_readings').select('sdnn, recorded_at')
-      .eq('user_id', userId).gte('recorded_at', since).order('recorded_at'),
-    supabase.from('sleep_sessions').select('sleep_score, deep_min, light_min, rem_min, start_time')
-      .eq('user_id', userId).eq('session_type', 'night').gte('start_time', since).order('start_time'),
-    supabase.from('temperature_readings').select('temperature_c, recorded_at')
-      .eq('user_id', userId).gte('recorded_at', since).order('recorded_at'),
-    supabase.from('heart_rate_readings').select('heart_rate, recorded_at')
-      .eq('user_id', userId).gte('recorded_at', since).order('heart_rate', { ascending: true }),
+    getRowsSince(userId, 'hrv_readings', cutoff),
+    getRowsSince(userId, 'sleep_sessions', cutoff),
+    getRowsSince(userId, 'temperature_readings', cutoff),
+    getRowsSince(userId, 'heart_rate_readings', cutoff),
   ]);
 
   const byDay = new Map<string, DayReadings>();
 
   if (hrvRes.status === 'fulfilled') {
-    for (const row of (hrvRes.value.data ?? []) as { sdnn: number; recorded_at: string }[]) {
+    for (const row of hrvRes.value as unknown as { sdnn: number; recorded_at: string }[]) {
       const day = row.recorded_at.slice(0, 10);
       if (!byDay.has(day)) byDay.set(day, {});
       const d = byDay.get(day)!;
@@ -87,7 +86,8 @@ export async function bootstrapBaselinesFromSupabase(userId: string): Promise<Fo
     }
   }
   if (sleepRes.status === 'fulfilled') {
-    for (const row of (sleepRes.value.data ?? []) as { sleep_score: number; deep_min: number; light_min: number; rem_min: number; start_time: string }[]) {
+    for (const row of sleepRes.value as unknown as { session_type: string | null; sleep_score: number; deep_min: number; light_min: number; rem_min: number; start_time: string }[]) {
+      if (row.session_type !== 'night') continue;
       const day = row.start_time.slice(0, 10);
       if (!byDay.has(day)) byDay.set(day, {});
       const d = byDay.get(day)!;
@@ -96,17 +96,19 @@ export async function bootstrapBaselinesFromSupabase(userId: string): Promise<Fo
     }
   }
   if (tempRes.status === 'fulfilled') {
-    for (const row of (tempRes.value.data ?? []) as { temperature_c: number; recorded_at: string }[]) {
+    for (const row of tempRes.value as unknown as { temperature_c: number; recorded_at: string }[]) {
       const day = row.recorded_at.slice(0, 10);
       if (!byDay.has(day)) byDay.set(day, {});
       byDay.get(day)!.temperature ??= row.temperature_c;
     }
   }
   if (hrRes.status === 'fulfilled') {
-    for (const row of (hrRes.value.data ?? []) as { heart_rate: number; recorded_at: string }[]) {
+    // Per-day minimum HR as the resting estimate
+    for (const row of hrRes.value as unknown as { heart_rate: number; recorded_at: string }[]) {
       const day = row.recorded_at.slice(0, 10);
       if (!byDay.has(day)) byDay.set(day, {});
-      byDay.get(day)!.restingHR ??= row.heart_rate;
+      const d = byDay.get(day)!;
+      if (d.restingHR == null || row.heart_rate < d.restingHR) d.restingHR = row.heart_rate;
     }
   }
 
@@ -115,45 +117,42 @@ export async function bootstrapBaselinesFromSupabase(userId: string): Promise<Fo
     if (r.hrvValues && r.hrvValues.length > 0) r.hrv = median(r.hrvValues);
   }
 
+  // Collect each metric in day order and keep the newest BASELINE_DAYS once at the end,
+  // rather than copying the array (or maintaining a sorted window) once per day
   const today = new Date().toISOString().slice(0, 10);
-  let baselines = emptyBaselines();
+  const series = {
+    hrv: [] as number[],
+    restingHR: [] as number[],
+    temperature: [] as number[],
+    sleepScore: [] as number[],
+    sleepMinutes: [] as number[],
+  };
+  const accept = (arr: number[], v: number | null | undefined) => {
+    if (v != null && Number.isFinite(v) && v > 0) arr.push(v);
+  };
   const sortedDays = [...byDay.keys()].sort();
   for (const day of sortedDays) {
     const r = byDay.get(day)!;
-    baselines = {
-      hrv: r.hrv ? pushRolling(baselines.hrv, r.hrv) : baselines.hrv,
-      restingHR: r.restingHR ? pushRolling(baselines.restingHR, r.restingHR) : baselines.restingHR,
-      temperature: r.temperature ? pushRolling(baselines.temperature, r.temperature) : baselines.temperature,
-      sleepScore: r.sleepScore ? pushRolling(baselines.sleepScore, r.sleepScore) : baselines.sleepScore,
-      sleepMinutes: r.sleepMinutes ? pushRolling(baselines.sleepMinutes, r.sleepMinutes) : baselines.sleepMinutes,
-      respiratoryRate: baselines.respiratoryRate,
-      spo2Min: baselines.spo2Min,
-      sleepAwakeMin: baselines.sleepAwakeMin,
-      nocturnalHR: baselines.nocturnalHR,
-      updatedAt: day,
-      daysLogged: baselines.daysLogged + 1,
-    };
+    accept(series.hrv, r.hrv);
+    accept(series.restingHR, r.restingHR);
+    accept(series.temperature, r.temperature);
+    accept(series.sleepScore, r.sleepScore);
+    accept(series.sleepMinutes, r.sleepMinutes);
   }
-  baselines = { ...baselines, updatedAt: today };
+  const baselines: FocusBaselines = {
+    ...emptyBaselines(),
+    hrv: series.hrv.slice(-BASELINE_DAYS),
+    restingHR: series.restingHR.slice(-BASELINE_DAYS),
+    temperature: series.temperature.slice(-BASELINE_DAYS),
+    sleepScore: series.sleepScore.slice(-BASELINE_DAYS),
+    sleepMinutes: series.sleepMinutes.slice(-BASELINE_DAYS),
+    updatedAt: today,
+    daysLogged: sortedDays.length,
+  };
   await saveBaselines(baselines);
   return baselines;
 }
 
-function pushRolling(values: number[] | undefined, value: number, max = 14): number[] {
-  if (!Number.isFinite(value) || value <= 0) return values ?? [];
-  const next = [...(values ?? []), value];
-  return next.length <= max ? next : next.slice(next.length - max);
-}
-
-function median(values: number[]): number | null {
-  if (values.length === 0) return null;
-  const sorted = [...values].sort((a, b) => a - b);
-  const mid = Math.floor(sorted.length / 2);
-  return sorted.length % 2 === 0
-    ? (sorted[mid - 1] + sorted[mid]) / 2
-    : sorted[mid];
-}
-
 interface DayReadings {
   hrv?: number | null;
   hrvValues?: number[];
@@ -206,7 +205,7 @@ function clamp(v: number, min: number, max: number): number {
 
 function scoreHRVComponent(sdnn: number | null, baseline: number[]): number | null {
   if (sdnn == null) return null;
-  const med = median(baseline);
+  const med = baselineMedian(baseline);
   if (med == null) return null;
   return clamp(50 + ((sdnn - med) / med) * 75, 0, 100);
 }
@@ -218,7 +217,7 @@ function scoreSleepComponent(
   minutesBaseline: number[]
 ): number | null {
   if (sleepScore == null && sleepMinutes == null) return null;
-  const baselineMins = median(minutesBaseline) ?? 480;
+  const baselineMins = baselineMedian(minutesBaseline) ?? 480;
   const minsScore = sleepMinutes != null ? clamp((sleepMinutes / baselineMins) * 100, 0, 100) : 50;
   if (sleepScore == null) return minsScore;
   return clamp(sleepScore * 0.7 + minsScore * 0.3, 0, 100);
@@ -229,7 +228,7 @@ function scoreRestingHRComponent(
   baseline: number[]
 ): number | null {
   if (hr == null) return null;
-  const med = median(baseline);
+  const med = baselineMedian(baseline);
   if (med == null) {
     // No personal baseline yet — score against population norms so the bar isn't empty.
     // < 50 bpm = athlete level (excellent), 60 = average, 80+ = poor.
@@ -391,9 +390,9 @@ export function computeIllnessWatch(params: IllnessParams): IllnessWatch {
     baselines,
   } = params;
 
-  const tempMed = median(baselines.temperature);
-  const hrMed = median(baselines.restingHR);
-  const hrvMed = median(baselines.hrv);
+  const tempMed = baselineMedian(baselines.temperature);
+  const hrMed = baselineMedian(baselines.restingHR);
+  const hrvMed = baselineMedian(baselines.hrv);
 
   let signalCount = 0;
 
@@ -557,7 +556,7 @@ export async function computeLastRunContext(
     const s = sleepData?.[0];
     const runSleepMinutes = s ? (s.deep_min ?? 0) + (s.light_min ?? 0) + (s.rem_min ?? 0) : null;
 
-    const hrMed = median(baselines.restingHR);
+    const hrMed = baselineMedian(baselines.restingHR);
     // HR reserve model: zone-2 running HR ≈ restingHR + 65% of estimated HR reserve
     // Anchor pace: 5:30/km (easy run). Each min/km faster → +8 bpm, slower → -8 bpm.
     const estimatedMaxHR = 190;
@@ -569,7 +568,7 @@ export async function computeLastRunContext(
     if (avgHR > expectedHR + 8) effortVerdict = 'harder_than_expected';
     else if (avgHR < expectedHR - 8) effortVerdict = 'easier_than_expected';
 
-    const hrvMed = median(baselines.hrv);
+    const hrvMed = baselineMedian(baselines.hrv);
     let hrvVsNorm: 'above' | 'below' | 'normal' | null = null;
     if (runHrv != null && hrvMed != null) {
       if (runHrv > hrvMed * 1.05) hrvVsNorm = 'above';
@@ -661,7 +660,7 @@ export function buildDayMetrics(input: BuildDayMetricsInput): DayMetrics {
     scoreVal: number | null,
     baselineArr: number[]
   ): DayMetricValue => {
-    const med = median(baselineArr);
+    const med = baselineMedian(baselineArr);
     let deviationLabel: string | null = null;
     if (rawVal != null && med != null) {
       const diff = Math.round(rawVal - med);
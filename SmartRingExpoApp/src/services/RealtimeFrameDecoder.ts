@@ -0,0 +1,37 @@
+/**
+ * RealtimeFrameDecoder — rebuilds full realtime state from the bridges' delta frames
+ *
+ * The native coalescer (ios/JstyleBridge/BleRealtimeCoalescer) sends onRealTimeData /
+ * V8RealTimeData as frames carrying only the fields that changed, plus a full keyframe
+ * every few seconds. Every listener of one stream shares a decoder: the first listener
+ * to see a frame merges it (by seq), the rest get the same merged state.
+ */
+
+export interface RealtimeFrame {
+  seq?: number;
+  keyframe?: boolean;
+  /** Ring packets merged into this frame. */
+  packets?: number;
+  [field: string]: unknown;
+}
+
+export class RealtimeFrameDecoder {
+  private state: Record<string, unknown> = {};
+  private seq: number | undefined;
+
+  /** Merged state after `frame`. Idempotent per frame, so each listener may call it. */
+  decode(frame: RealtimeFrame): Readonly<Record<string, unknown>> {
+    // Frames without seq come from a bridge that doesn't coalesce: each one is complete
+    if (frame.seq === undefined) return frame;
+    if (frame.seq !== this.seq) {
+      this.seq = frame.seq;
+      this.state = frame.keyframe ? { ...frame } : { ...this.state, ...frame };
+    }
+    return this.state;
+  }
+
+  /** Whether `frame` changed any of `fields` (a keyframe counts as changing all of them). */
+  static touches(frame: RealtimeFrame, fields: readonly string[]): boolean {
+    return fields.some(f => frame[f] !== undefined);
+  }
+}
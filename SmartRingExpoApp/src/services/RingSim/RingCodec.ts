@@ -0,0 +1,353 @@
+/**
+ * RingCodec — wire format of the simulated FFF0 ring
+ *
+ * Commands (central → FFF6) are 16-byte frames like the real SDK's:
+ *   [cmd][mode][since yy][since mm][since dd][0 …][checksum]
+ * mode 0 = read from the start, 2 = next page, 0x99 = delete that history type.
+ *
+ * Responses (FFF7 notifications) carry one logical frame per history page:
+ *   [cmd][flags: bit0 dataEnd][count u16][payloadLen u16][payload …][checksum]
+ * split into MTU-sized chunks, each prefixed with one byte (bit7 = first chunk,
+ * low bits = chunk sequence). FrameAssembler stitches chunks back together and
+ * drops a frame when a chunk went missing or the checksum fails.
+ *
+ * Record payloads are encoded from per-type field schemas whose keys match the
+ * SDK's dicData keys, so decoded pages look like what the bridges resolve.
+ * The vendor byte layout lives in the closed SDK; this format models framing,
+ * paging and MTU cost, not the exact vendor encoding.
+ */
+
+export enum RingCommand {
+  Steps = 0x51,
+  Sleep = 0x53,
+  HeartRate = 0x54,
+  Hrv = 0x56,
+  Temperature = 0x62,
+  SpO2 = 0x66,
+}
+
+export const MODE_START = 0;
+export const MODE_NEXT = 2;
+export const MODE_DELETE = 0x99;
+
+export const COMMAND_LENGTH = 16;
+const FRAME_HEADER = 6;
+/** ATT notification overhead (opcode + handle) out of the negotiated MTU. */
+const ATT_OVERHEAD = 3;
+const CHUNK_HEADER = 1;
+
+type FieldKind =
+  | 'datetime' // "YYYY.MM.DD HH:mm:ss" ↔ 6 bytes
+  | 'date' //     "YYYY.MM.DD" ↔ 3 bytes
+  | 'u8'
+  | 'u16'
+  | 'u32'
+  | 'x10' //      signed one-decimal number ↔ i16
+  | 'x100' //     unsigned two-decimal number ↔ u16
+  | 'u8list'; //  number[] ↔ u16 length + bytes
+
+interface Field {
+  key: string;
+  kind: FieldKind;
+}
+
+export type RingRecord = Record<string, string | number | number[]>;
+
+/** Field layout and SDK array key per history type. */
+export const RECORD_SCHEMAS: Record<RingCommand, { arrayKey: string; fields: Field[] }> = {
+  [RingCommand.Steps]: {
+    arrayKey: 'arrayTotalActivityData',
+    fields: [
+      { key: 'date', kind: 'date' },
+      { key: 'step', kind: 'u32' },
+      { key: 'distance', kind: 'x100' },
+      { key: 'calories', kind: 'u16' },
+      { key: 'exerciseMinutes', kind: 'u16' },
+    ],
+  },
+  [RingCommand.Sleep]: {
+    arrayKey: 'arrayDetailSleepData',
+    fields: [
+      { key: 'startTime_SleepData', kind: 'datetime' },
+      { key: 'totalSleepTime', kind: 'u16' },
+      { key: 'sleepUnitLength', kind: 'u8' },
+      { key: 'arraySleepQuality', kind: 'u8list' },
+    ],
+  },
+  [RingCommand.HeartRate]: {
+    arrayKey: 'arrayContinuousHR',
+    fields: [
+      { key: 'date', kind: 'datetime' },
+      { key: 'arrayHR', kind: 'u8list' },
+    ],
+  },
+  [RingCommand.Hrv]: {
+    arrayKey: 'arrayHrvData',
+    fields: [
+      { key: 'date', kind: 'datetime' },
+      { key: 'hrv', kind: 'u8' },
+      { key: 'heartRate', kind: 'u8' },
+      { key: 'stress', kind: 'u8' },
+      { key: 'HighPressure', kind: 'u8' },
+      { key: 'LowPressure', kind: 'u8' },
+    ],
+  },
+  [RingCommand.Temperature]: {
+    // SDK typo — missing capital T
+    arrayKey: 'arrayemperatureData',
+    fields: [
+      { key: 'date', kind: 'datetime' },
+      { key: 'temperature', kind: 'x10' },
+    ],
+  },
+  [RingCommand.SpO2]: {
+    arrayKey: 'arrayAutomaticSpo2Data',
+    fields: [
+      { key: 'date', kind: 'datetime' },
+      { key: 'automaticSpo2Data', kind: 'u8' },
+    ],
+  },
+};
+
+// ── Commands ─────────────────────────────────────────────────────────
+
+export interface DecodedCommand {
+  cmd: RingCommand;
+  mode: number;
+  /** "YYYY.MM.DD" lower bound, or null for the whole history. */
+  since: string | null;
+}
+
+function checksum(bytes: Uint8Array, end: number): number {
+  let sum = 0;
+  for (let i = 0; i < end; i++) sum += bytes[i];
+  return sum & 0xff;
+}
+
+export function encodeCommand(cmd: RingCommand, mode: number, since: string | null = null): Uint8Array {
+  const out = new Uint8Array(COMMAND_LENGTH);
+  out[0] = cmd;
+  out[1] = mode;
+  if (since) {
+    const [y, m, d] = since.split('.').map(Number);
+    out[2] = y - 2000;
+    out[3] = m;
+    out[4] = d;
+  }
+  out[COMMAND_LENGTH - 1] = checksum(out, COMMAND_LENGTH - 1);
+  return out;
+}
+
+export function decodeCommand(bytes: Uint8Array): DecodedCommand | null {
+  if (bytes.length !== COMMAND_LENGTH) return null;
+  if (checksum(bytes, COMMAND_LENGTH - 1) !== bytes[COMMAND_LENGTH - 1]) return null;
+  if (!(bytes[0] in RECORD_SCHEMAS)) return null;
+  const since = bytes[2] || bytes[3] || bytes[4]
+    ? `${2000 + bytes[2]}.${pad2(bytes[3])}.${pad2(bytes[4])}`
+    : null;
+  return { cmd: bytes[0] as RingCommand, mode: bytes[1], since };
+}
+
+// ── Records ──────────────────────────────────────────────────────────
+
+const pad2 = (n: number) => (n < 10 ? `0${n}` : `${n}`);
+
+function fieldSize(kind: FieldKind, value: unknown): number {
+  switch (kind) {
+    case 'datetime': return 6;
+    case 'date': return 3;
+    case 'u8': return 1;
+    case 'u16': case 'x10': case 'x100': return 2;
+    case 'u32': return 4;
+    case 'u8list': return 2 + (value as number[]).length;
+  }
+}
+
+export function recordSize(cmd: RingCommand, record: RingRecord): number {
+  let n = 0;
+  for (const f of RECORD_SCHEMAS[cmd].fields) n += fieldSize(f.kind, record[f.key]);
+  return n;
+}
+
+function writeRecord(view: DataView, bytes: Uint8Array, at: number, fields: Field[], record: RingRecord): number {
+  for (const f of fields) {
+    const v = record[f.key];
+    switch (f.kind) {
+      case 'datetime': {
+        const s = v as string; // YYYY.MM.DD HH:mm:ss
+        bytes[at] = Number(s.slice(0, 4)) - 2000;
+        bytes[at + 1] = Number(s.slice(5, 7));
+        bytes[at + 2] = Number(s.slice(8, 10));
+        bytes[at + 3] = Number(s.slice(11, 13));
+        bytes[at + 4] = Number(s.slice(14, 16));
+        bytes[at + 5] = Number(s.slice(17, 19));
+        at += 6;
+        break;
+      }
+      case 'date': {
+        const s = v as string;
+        bytes[at] = Number(s.slice(0, 4)) - 2000;
+        bytes[at + 1] = Number(s.slice(5, 7));
+        bytes[at + 2] = Number(s.slice(8, 10));
+        at += 3;
+        break;
+      }
+      case 'u8': bytes[at++] = v as number; break;
+      case 'u16': view.setUint16(at, v as number, true); at += 2; break;
+      case 'u32': view.setUint32(at, v as number, true); at += 4; break;
+      case 'x10': view.setInt16(at, Math.round((v as number) * 10), true); at += 2; break;
+      case 'x100': view.setUint16(at, Math.round((v as number) * 100), true); at += 2; break;
+      case 'u8list': {
+        const list = v as number[];
+        view.setUint16(at, list.length, true);
+        bytes.set(list, at + 2);
+        at += 2 + list.length;
+        break;
+      }
+    }
+  }
+  return at;
+}
+
+function readRecord(view: DataView, bytes: Uint8Array, at: number, fields: Field[]): [RingRecord, number] {
+  const rec: RingRecord = {};
+  for (const f of fields) {
+    switch (f.kind) {
+      case 'datetime':
+        rec[f.key] = `${2000 + bytes[at]}.${pad2(bytes[at + 1])}.${pad2(bytes[at + 2])} ` +
+          `${pad2(bytes[at + 3])}:${pad2(bytes[at + 4])}:${pad2(bytes[at + 5])}`;
+        at += 6;
+        break;
+      case 'date':
+        rec[f.key] = `${2000 + bytes[at]}.${pad2(bytes[at + 1])}.${pad2(bytes[at + 2])}`;
+        at += 3;
+        break;
+      case 'u8': rec[f.key] = bytes[at++]; break;
+      case 'u16': rec[f.key] = view.getUint16(at, true); at += 2; break;
+      case 'u32': rec[f.key] = view.getUint32(at, true); at += 4; break;
+      case 'x10': rec[f.key] = view.getInt16(at, true) / 10; at += 2; break;
+      case 'x100': rec[f.key] = view.getUint16(at, true) / 100; at += 2; break;
+      case 'u8list': {
+        const n = view.getUint16(at, true);
+        rec[f.key] = Array.from(bytes.subarray(at + 2, at + 2 + n));
+        at += 2 + n;
+        break;
+      }
+    }
+  }
+  return [rec, at];
+}
+
+// ── Frames ───────────────────────────────────────────────────────────
+
+export interface DecodedFrame {
+  cmd: RingCommand;
+  dataEnd: boolean;
+  records: RingRecord[];
+}
+
+export function encodeFrame(cmd: RingCommand, records: RingRecord[], dataEnd: boolean): Uint8Array {
+  const { fields } = RECORD_SCHEMAS[cmd];
+  let payload = 0;
+  for (const r of records) payload += recordSize(cmd, r);
+
+  const out = new Uint8Array(FRAME_HEADER + payload + 1);
+  const view = new DataView(out.buffer);
+  out[0] = cmd;
+  out[1] = dataEnd ? 1 : 0;
+  view.setUint16(2, records.length, true);
+  view.setUint16(4, payload, true);
+  let at = FRAME_HEADER;
+  for (const r of records) at = writeRecord(view, out, at, fields, r);
+  out[at] = checksum(out, at);
+  return out;
+}
+
+export function decodeFrame(frame: Uint8Array): DecodedFrame | null {
+  if (frame.length < FRAME_HEADER + 1) return null;
+  const view = new DataView(frame.buffer, frame.byteOffset, frame.byteLength);
+  const payload = view.getUint16(4, true);
+  const end = FRAME_HEADER + payload;
+  if (frame.length !== end + 1 || checksum(frame, end) !== frame[end]) return null;
+  const schema = RECORD_SCHEMAS[frame[0] as RingCommand];
+  if (!schema) return null;
+
+  const count = view.getUint16(2, true);
+  const records: RingRecord[] = new Array(count);
+  let at = FRAME_HEADER;
+  for (let i = 0; i < count; i++) {
+    const [rec, next] = readRecord(view, frame, at, schema.fields);
+    records[i] = rec;
+    at = next;
+  }
+  return { cmd: frame[0] as RingCommand, dataEnd: (frame[1] & 1) === 1, records };
+}
+
+/** Split a frame into notification payloads for the given ATT MTU. */
+export function chunkFrame(frame: Uint8Array, mtu: number): Uint8Array[] {
+  const body = Math.max(1, mtu - ATT_OVERHEAD - CHUNK_HEADER);
+  const chunks: Uint8Array[] = [];
+  for (let off = 0, seq = 0; off < frame.length; off += body, seq++) {
+    const part = frame.subarray(off, Math.min(frame.length, off + body));
+    const chunk = new Uint8Array(part.length + CHUNK_HEADER);
+    chunk[0] = (off === 0 ? 0x80 : 0) | (seq & 0x7f);
+    chunk.set(part, CHUNK_HEADER);
+    chunks.push(chunk);
+  }
+  return chunks;
+}
+
+/**
+ * Reassembles chunked frames. A gap in the sequence discards the frame in
+ * progress, so a lost notification costs the whole page, as it would when the
+ * SDK's parser sees a truncated packet.
+ */
+export class FrameAssembler {
+  private parts: Uint8Array[] = [];
+  private have = 0;
+  private want = -1;
+  private nextSeq = 0;
+  dropped = 0;
+
+  /** Returns a complete decoded frame, or null while one is still in progress. */
+  push(chunk: Uint8Array): DecodedFrame | null {
+    const first = (chunk[0] & 0x80) !== 0;
+    const seq = chunk[0] & 0x7f;
+    const body = chunk.subarray(CHUNK_HEADER);
+
+    if (first) {
+      if (this.want >= 0) this.dropped++;
+      this.reset();
+      if (body.length < FRAME_HEADER) return null;
+      const view = new DataView(body.buffer, body.byteOffset, body.byteLength);
+      this.want = FRAME_HEADER + view.getUint16(4, true) + 1;
+    } else if (this.want < 0 || seq !== this.nextSeq) {
+      if (this.want >= 0) this.dropped++;
+      this.reset();
+      return null;
+    }
+
+    this.parts.push(body);
+    this.have += body.length;
+    this.nextSeq = (seq + 1) & 0x7f;
+    if (this.have < this.want) return null;
+
+    const frame = new Uint8Array(this.have);
+    let at = 0;
+    for (const p of this.parts) {
+      frame.set(p, at);
+      at += p.length;
+    }
+    this.reset();
+    const decoded = decodeFrame(frame);
+    if (!decoded) this.dropped++;
+    return decoded;
+  }
+
+  reset(): void {
+    this.parts = [];
+    this.have = 0;
+    this.want = -1;
+    this.nextSeq = 0;
+  }
+}
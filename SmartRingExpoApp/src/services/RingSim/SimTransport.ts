@@ -0,0 +1,83 @@
+/**
+ * SimTransport — the seams between a bridge and a (simulated) ring
+ *
+ * RingTransport is what a bridge needs from the BLE link: write a command to
+ * FFF6 and receive FFF7 notifications. SimClock is what it needs for its
+ * watchdog / idle timers. VirtualClock implements SimClock as a discrete-event
+ * loop, so a simulated 20 s watchdog or a 30 ms connection interval costs no
+ * wall time and every run with the same seed produces the same event order.
+ */
+
+export interface RingTransport {
+  /** Negotiated ATT MTU. */
+  readonly mtu: number;
+  /** Write to the command characteristic (FFF6). */
+  write(data: Uint8Array): void;
+  /** Subscribe to the notify characteristic (FFF7). */
+  onNotify(listener: (data: Uint8Array) => void): () => void;
+}
+
+export interface SimClock {
+  now(): number;
+  setTimeout(fn: () => void, ms: number): number;
+  clearTimeout(id: number): void;
+}
+
+interface Timer {
+  id: number;
+  at: number;
+  fn: () => void;
+}
+
+const flushMicrotasks = () => new Promise<void>(resolve => setImmediate(resolve));
+
+export class VirtualClock implements SimClock {
+  private t: number;
+  private nextId = 1;
+  // Sorted by (at, id) so timers due at the same instant fire in creation order
+  private queue: Timer[] = [];
+
+  /** @param startMs epoch the simulation starts at (ring clock and history end). */
+  constructor(startMs = 0) {
+    this.t = startMs;
+  }
+
+  now(): number {
+    return this.t;
+  }
+
+  setTimeout(fn: () => void, ms: number): number {
+    const timer = { id: this.nextId++, at: this.t + Math.max(0, ms), fn };
+    let lo = 0;
+    let hi = this.queue.length;
+    while (lo < hi) {
+      const mid = (lo + hi) >> 1;
+      if (this.queue[mid].at <= timer.at) lo = mid + 1;
+      else hi = mid;
+    }
+    this.queue.splice(lo, 0, timer);
+    return timer.id;
+  }
+
+  clearTimeout(id: number): void {
+    const i = this.queue.findIndex(tm => tm.id === id);
+    if (i >= 0) this.queue.splice(i, 1);
+  }
+
+  /**
+   * Fire timers in order until `promise` settles. Microtasks (promise
+   * continuations) are drained between timers, like a real event loop.
+   */
+  async run<T>(promise: Promise<T>): Promise<T> {
+    let settled = false;
+    promise.then(() => { settled = true; }, () => { settled = true; });
+    for (;;) {
+      await flushMicrotasks();
+      if (settled) return promise;
+      const next = this.queue.shift();
+      if (!next) throw new Error('VirtualClock: promise still pending with no timers left');
+      this.t = next.at;
+      next.fn();
+    }
+  }
+}
@@ -0,0 +1,277 @@
+/**
+ * SimulatedBridge — TypeScript stand-in for JstyleBridge / V8Bridge over a RingTransport
+ *
+ * Mirrors the parts of the native bridges a sync exercises:
+ *   - one pending data request at a time (BUSY), the 20 s NATIVE_TIMEOUT
+ *     watchdog and cancelPendingDataRequest (CANCELLED)
+ *   - BleFetchEngine paging: mode 0, then mode 2 per page until dataEnd, a
+ *     short page or the 3 s idle timeout, per each descriptor's end detection
+ *   - getFetchMetrics() with the same counters as the native engine
+ *
+ * Timers run on a SimClock, so under a VirtualClock a full history pull is
+ * simulated in milliseconds. Results resolve as { data: records[] } for every
+ * type; the per-type packet shapes the real X3 bridge resolves are decoded by
+ * JstyleService and are not reproduced here.
+ */
+
+import {
+  encodeCommand,
+  FrameAssembler,
+  MODE_NEXT,
+  MODE_START,
+  RingCommand,
+} from './RingCodec';
+import type { DecodedFrame, RingRecord } from './RingCodec';
+import type { RingTransport, SimClock } from './SimTransport';
+import type { RingProfile } from './SimulatedRing';
+import type { NativeFetchMetrics } from '../../types/sdk.types';
+
+type EndDetection = 'dataEnd' | 'shortPage' | 'dataEndOrIdle';
+
+interface FetchDescriptor {
+  name: string;
+  cmd: RingCommand;
+  endDetection: EndDetection;
+  /** Start date for mode 0, "YYYY.MM.DD", or null for everything on the ring. */
+  since?: (now: number) => string | null;
+}
+
+export interface SimulatedBridgeOptions {
+  watchdogMs?: number;
+  idleTimeoutMs?: number;
+  pageSize?: number;
+}
+
+export interface BridgeError extends Error {
+  code: string;
+}
+
+const DAY = 86_400_000;
+
+const sinceDaysAgo = (days: number) => (now: number) => {
+  const d = new Date(now - days * DAY);
+  const mm = String(d.getUTCMonth() + 1).padStart(2, '0');
+  const dd = String(d.getUTCDate()).padStart(2, '0');
+  return `${d.getUTCFullYear()}.${mm}.${dd}`;
+};
+
+// Same method names and end detection as each native bridge's descriptor table
+const BRIDGE_METHODS: Record<RingProfile, Record<string, FetchDescriptor>> = {
+  x3: {
+    getStepsData: { name: 'Steps', cmd: RingCommand.Steps, endDetection: 'dataEnd' },
+    getSleepData: { name: 'Sleep', cmd: RingCommand.Sleep, endDetection: 'dataEnd' },
+    getHeartRateData: { name: 'HR', cmd: RingCommand.HeartRate, endDetection: 'dataEnd' },
+    getHRVData: { name: 'HRV', cmd: RingCommand.Hrv, endDetection: 'dataEnd' },
+    getSpO2Data: { name: 'SpO2', cmd: RingCommand.SpO2, endDetection: 'dataEnd' },
+    getTemperatureData: { name: 'Temperature', cmd: RingCommand.Temperature, endDetection: 'dataEnd' },
+  },
+  v8: {
+    getStepsData: { name: 'Steps', cmd: RingCommand.Steps, endDetection: 'shortPage' },
+    getSleepData: { name: 'Sleep', cmd: RingCommand.Sleep, endDetection: 'shortPage' },
+    getContinuousHR: { name: 'HR', cmd: RingCommand.HeartRate, endDetection: 'dataEndOrIdle', since: sinceDaysAgo(2) },
+    getHRVData: { name: 'HRV', cmd: RingCommand.Hrv, endDetection: 'dataEndOrIdle' },
+    getAutoSpO2: { name: 'SpO2', cmd: RingCommand.SpO2, endDetection: 'shortPage' },
+    getTemperature: { name: 'Temperature', cmd: RingCommand.Temperature, endDetection: 'shortPage' },
+  },
+};
+
+const emptyMetrics = (): NativeFetchMetrics & { totalMs: number } => ({
+  fetches: 0, completed: 0, pages: 0, records: 0, bytes: 0,
+  lastMs: 0, avgMs: 0, maxMs: 0, totalMs: 0,
+  idleEnds: 0, timeouts: 0, cancels: 0, errors: 0, disconnects: 0,
+});
+
+const bridgeError = (code: string, message: string): BridgeError =>
+  Object.assign(new Error(message), { code });
+
+interface Pending {
+  descriptor: FetchDescriptor;
+  resolve: (result: { data: RingRecord[] }) => void;
+  reject: (e: BridgeError) => void;
+  records: RingRecord[];
+  pages: number;
+  bytes: number;
+  startedAt: number;
+  watchdog: number;
+  idle: number | null;
+}
+
+export class SimulatedBridge {
+  readonly profile: RingProfile;
+  private readonly transport: RingTransport;
+  private readonly clock: SimClock;
+  private readonly watchdogMs: number;
+  private readonly idleTimeoutMs: number;
+  private readonly pageSize: number;
+  private readonly assembler = new FrameAssembler();
+  private readonly metrics = new Map<string, ReturnType<typeof emptyMetrics>>();
+  private pending: Pending | null = null;
+
+  constructor(profile: RingProfile, transport: RingTransport, clock: SimClock, options: SimulatedBridgeOptions = {}) {
+    this.profile = profile;
+    this.transport = transport;
+    this.clock = clock;
+    this.watchdogMs = options.watchdogMs ?? 20_000;
+    this.idleTimeoutMs = options.idleTimeoutMs ?? 3_000;
+    this.pageSize = options.pageSize ?? 50;
+    transport.onNotify(chunk => this.onNotify(chunk));
+  }
+
+  /** Native method names this profile's bridge exports for history reads. */
+  get methods(): string[] {
+    return Object.keys(BRIDGE_METHODS[this.profile]);
+  }
+
+  /** Which ring history type a bridge method reads. */
+  commandFor(method: string): RingCommand {
+    const descriptor = BRIDGE_METHODS[this.profile][method];
+    if (!descriptor) throw new Error(`${this.profile} bridge has no method ${method}`);
+    return descriptor.cmd;
+  }
+
+  /** Name a bridge method's fetch metrics are reported under. */
+  nameFor(method: string): string {
+    return BRIDGE_METHODS[this.profile][method]?.name ?? method;
+  }
+
+  /** Start date a bridge method sends with mode 0, or null when it reads everything. */
+  sinceFor(method: string): string | null {
+    const descriptor = BRIDGE_METHODS[this.profile][method];
+    return descriptor?.since ? descriptor.since(this.clock.now()) : null;
+  }
+
+  /** Invoke a history read by its native method name, e.g. call('getSleepData'). */
+  call(method: string): Promise<{ data: RingRecord[] }> {
+    const descriptor = BRIDGE_METHODS[this.profile][method];
+    if (!descriptor) {
+      return Promise.reject(bridgeError('UNSUPPORTED', `${this.profile} bridge has no method ${method}`));
+    }
+    if (this.pending) {
+      return Promise.reject(bridgeError('BUSY', `${method} rejected: bridge is busy with pending data type ${this.pending.descriptor.name}`));
+    }
+    return new Promise((resolve, reject) => {
+      const m = this.metricsFor(descriptor.name);
+      m.fetches++;
+      this.pending = {
+        descriptor,
+        resolve,
+        reject,
+        records: [],
+        pages: 0,
+        bytes: 0,
+        startedAt: this.clock.now(),
+        watchdog: this.clock.setTimeout(() => this.abort('NATIVE_TIMEOUT'), this.watchdogMs),
+        idle: null,
+      };
+      this.assembler.reset();
+      const since = descriptor.since ? descriptor.since(this.clock.now()) : null;
+      this.transport.write(encodeCommand(descriptor.cmd, MODE_START, since));
+    });
+  }
+
+  cancelPendingDataRequest(): Promise<{ success: boolean }> {
+    this.abort('CANCELLED');
+    return Promise.resolve({ success: true });
+  }
+
+  getFetchMetrics(): Record<string, NativeFetchMetrics> {
+    const out: Record<string, NativeFetchMetrics> = {};
+    for (const [name, m] of this.metrics) {
+      const { totalMs, ...rest } = m;
+      out[name] = { ...rest, avgMs: m.completed > 0 ? Math.round(totalMs / m.completed) : 0 };
+    }
+    return out;
+  }
+
+  resetFetchMetrics(): void {
+    this.metrics.clear();
+  }
+
+  // ── Engine ────────────────────────────────────────────────────────
+
+  private metricsFor(name: string) {
+    let m = this.metrics.get(name);
+    if (!m) {
+      m = emptyMetrics();
+      this.metrics.set(name, m);
+    }
+    return m;
+  }
+
+  private onNotify(chunk: Uint8Array): void {
+    if (this.pending) this.pending.bytes += chunk.length;
+    const frame = this.assembler.push(chunk);
+    if (frame) this.onFrame(frame);
+  }
+
+  private onFrame(frame: DecodedFrame): void {
+    const p = this.pending;
+    if (!p || p.descriptor.cmd !== frame.cmd) {
+      return; // late page from a fetch that already finished, timed out or was cancelled
+    }
+    const { descriptor } = p;
+    p.pages++;
+    for (const r of frame.records) p.records.push(r);
+
+    switch (descriptor.endDetection) {
+      case 'dataEnd':
+        if (frame.dataEnd) this.finish(false);
+        else this.requestNextPage();
+        break;
+      case 'shortPage':
+        if (frame.dataEnd || frame.records.length < this.pageSize) this.finish(false);
+        else this.requestNextPage();
+        break;
+      case 'dataEndOrIdle':
+        if (frame.dataEnd) {
+          this.finish(false);
+        } else {
+          if (p.records.length > 0 && p.records.length % this.pageSize === 0) this.requestNextPage();
+          if (p.idle !== null) this.clock.clearTimeout(p.idle);
+          p.idle = this.clock.setTimeout(() => this.finish(true), this.idleTimeoutMs);
+        }
+        break;
+    }
+  }
+
+  private requestNextPage(): void {
+    if (this.pending) this.transport.write(encodeCommand(this.pending.descriptor.cmd, MODE_NEXT));
+  }
+
+  private close(): Pending | null {
+    const p = this.pending;
+    if (!p) return null;
+    this.clock.clearTimeout(p.watchdog);
+    if (p.idle !== null) this.clock.clearTimeout(p.idle);
+    this.pending = null;
+    const m = this.metricsFor(p.descriptor.name);
+    m.pages += p.pages;
+    m.bytes += p.bytes;
+    return p;
+  }
+
+  private finish(byIdle: boolean): void {
+    const p = this.close();
+    if (!p) return;
+    const ms = this.clock.now() - p.startedAt;
+    const m = this.metricsFor(p.descriptor.name);
+    m.completed++;
+    m.records += p.records.length;
+    m.lastMs = ms;
+    m.totalMs += ms;
+    m.maxMs = Math.max(m.maxMs, ms);
+    if (byIdle) m.idleEnds++;
+    p.resolve({ data: p.records });
+  }
+
+  private abort(code: 'NATIVE_TIMEOUT' | 'CANCELLED'): void {
+    const p = this.close();
+    if (!p) return;
+    const m = this.metricsFor(p.descriptor.name);
+    if (code === 'NATIVE_TIMEOUT') m.timeouts++;
+    else m.cancels++;
+    p.reject(bridgeError(code, code === 'NATIVE_TIMEOUT'
+      ? `Pending data request timed out in native bridge (${p.descriptor.name})`
+      : 'Pending data request cancelled by JS timeout recovery'));
+  }
+}
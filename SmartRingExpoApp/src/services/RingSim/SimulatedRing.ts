@@ -0,0 +1,289 @@
+/**
+ * SimulatedRing — deterministic X3 / V8 peripheral behind a RingTransport
+ *
+ * Holds a seeded history for steps, sleep, continuous HR, HRV, SpO2 and
+ * temperature, answers paged read commands (mode 0 / 2) and delete commands
+ * (0x99) the way the ring firmware does, and models the link on the way back:
+ *   - notifications only leave at connection events (connectionIntervalMs),
+ *     at most packetsPerEvent per event
+ *   - each page is chunked to the MTU
+ *   - a fixed one-way latency
+ *   - seeded link-layer loss: a lost PDU is retransmitted in the next slot,
+ *     costing airtime but not data, as BLE's acknowledged link layer does
+ *   - optional notifications that never arrive (by ordinal, so a scenario
+ *     hits the same gap every run), which drives the bridges' watchdog and
+ *     retry paths
+ *
+ * Profiles follow each firmware's paging. X3 sends one frame per page and
+ * flags the last page with dataEnd. V8 does the same for steps / sleep /
+ * SpO2 / temperature (the bridge also ends on a short page), but streams HR
+ * and HRV pages as several smaller frames. With silentEnd set, V8 simply
+ * stops after the last of those instead of flagging it, which is what the
+ * bridge's idle timeout exists for.
+ */
+
+import {
+  chunkFrame,
+  decodeCommand,
+  encodeFrame,
+  MODE_DELETE,
+  MODE_NEXT,
+  MODE_START,
+  RingCommand,
+} from './RingCodec';
+import type { RingRecord } from './RingCodec';
+import type { RingTransport, SimClock } from './SimTransport';
+
+export type RingProfile = 'x3' | 'v8';
+
+export interface SimulatedRingOptions {
+  profile: RingProfile;
+  seed?: number;
+  /** Days of history on the ring, ending at clock.now(). */
+  historyDays?: number;
+  mtu?: number;
+  connectionIntervalMs?: number;
+  packetsPerEvent?: number;
+  /** One-way radio + OS latency added to every write and notification. */
+  latencyMs?: number;
+  /** Probability a notification PDU has to be retransmitted. */
+  lossRate?: number;
+  /** 1-based ordinals of notifications that never arrive. */
+  dropAt?: number[];
+  /** Firmware time to assemble a page after a command lands. */
+  processingMs?: number;
+  /** V8 only: end HR / HRV transfers by going quiet instead of flagging dataEnd. */
+  silentEnd?: boolean;
+}
+
+export interface SimulatedRingStats {
+  commands: number;
+  pages: number;
+  notifications: number;
+  retransmits: number;
+  dropped: number;
+  bytes: number;
+}
+
+const PAGE_SIZE = 50;
+// V8 streams HR / HRV pages in frames of this many records
+const V8_STREAM_FRAME = 10;
+const MIN = 60_000;
+const DAY = 24 * 60 * MIN;
+
+const pad2 = (n: number) => (n < 10 ? `0${n}` : `${n}`);
+// UTC fields so generated history doesn't depend on the host timezone
+const fmtDate = (ms: number) => {
+  const d = new Date(ms);
+  return `${d.getUTCFullYear()}.${pad2(d.getUTCMonth() + 1)}.${pad2(d.getUTCDate())}`;
+};
+const fmtDateTime = (ms: number) => {
+  const d = new Date(ms);
+  return `${fmtDate(ms)} ${pad2(d.getUTCHours())}:${pad2(d.getUTCMinutes())}:${pad2(d.getUTCSeconds())}`;
+};
+
+export class SimulatedRing implements RingTransport {
+  readonly mtu: number;
+  readonly profile: RingProfile;
+  readonly stats: SimulatedRingStats = { commands: 0, pages: 0, notifications: 0, retransmits: 0, dropped: 0, bytes: 0 };
+
+  private readonly clock: SimClock;
+  private readonly interval: number;
+  private readonly packetsPerEvent: number;
+  private readonly latency: number;
+  private readonly lossRate: number;
+  private readonly dropAt: Set<number>;
+  private readonly processingMs: number;
+  private readonly silentEnd: boolean;
+  private seed: number;
+
+  private readonly store = new Map<RingCommand, RingRecord[]>();
+  private readonly cursors = new Map<RingCommand, { records: RingRecord[]; at: number }>();
+  private readonly listeners = new Set<(data: Uint8Array) => void>();
+  private txQueue: Uint8Array[] = [];
+  private pumpScheduled = false;
+
+  constructor(clock: SimClock, options: SimulatedRingOptions) {
+    this.clock = clock;
+    this.profile = options.profile;
+    this.mtu = options.mtu ?? 23;
+    this.interval = options.connectionIntervalMs ?? 30;
+    this.packetsPerEvent = options.packetsPerEvent ?? 4;
+    this.latency = options.latencyMs ?? 0;
+    this.lossRate = options.lossRate ?? 0;
+    this.dropAt = new Set(options.dropAt ?? []);
+    this.processingMs = options.processingMs ?? 2;
+    this.silentEnd = options.silentEnd ?? options.profile === 'v8';
+    this.seed = options.seed ?? 1;
+    this.generateHistory(options.historyDays ?? 7);
+  }
+
+  /** What the ring currently stores for a type, oldest first. */
+  history(cmd: RingCommand): RingRecord[] {
+    return this.store.get(cmd) ?? [];
+  }
+
+  // ── RingTransport ─────────────────────────────────────────────────
+
+  write(data: Uint8Array): void {
+    const copy = data.slice();
+    // Writes go out at the next connection event and land after the link latency
+    this.clock.setTimeout(() => this.onCommand(copy), this.untilNextEvent() + this.latency + this.processingMs);
+  }
+
+  onNotify(listener: (data: Uint8Array) => void): () => void {
+    this.listeners.add(listener);
+    return () => this.listeners.delete(listener);
+  }
+
+  // ── Firmware ──────────────────────────────────────────────────────
+
+  private onCommand(bytes: Uint8Array): void {
+    const command = decodeCommand(bytes);
+    if (!command) return; // firmware ignores malformed commands
+    this.stats.commands++;
+    const { cmd, mode, since } = command;
+
+    if (mode === MODE_DELETE) {
+      this.store.set(cmd, []);
+      this.cursors.delete(cmd);
+      this.sendFrames(cmd, [], true);
+      return;
+    }
+
+    if (mode === MODE_START) {
+      const all = this.history(cmd);
+      const records = since ? all.filter(r => String(r.date ?? r.startTime_SleepData).slice(0, 10) >= since) : all;
+      this.cursors.set(cmd, { records, at: 0 });
+    } else if (mode !== MODE_NEXT || !this.cursors.has(cmd)) {
+      return;
+    }
+
+    const cursor = this.cursors.get(cmd)!;
+    const page = cursor.records.slice(cursor.at, cursor.at + PAGE_SIZE);
+    cursor.at += page.length;
+    const last = cursor.at >= cursor.records.length;
+    const streamed = this.profile === 'v8' && (cmd === RingCommand.HeartRate || cmd === RingCommand.Hrv);
+
+    if (streamed && last && this.silentEnd && page.length === 0) {
+      return; // nothing left and this firmware never says so
+    }
+    this.stats.pages++;
+    this.sendFrames(cmd, page, last && !(streamed && this.silentEnd), streamed ? V8_STREAM_FRAME : PAGE_SIZE);
+  }
+
+  private sendFrames(cmd: RingCommand, records: RingRecord[], dataEnd: boolean, perFrame = PAGE_SIZE): void {
+    if (records.length === 0) {
+      this.enqueue(encodeFrame(cmd, [], dataEnd));
+      return;
+    }
+    for (let i = 0; i < records.length; i += perFrame) {
+      const slice = records.slice(i, i + perFrame);
+      this.enqueue(encodeFrame(cmd, slice, dataEnd && i + perFrame >= records.length));
+    }
+  }
+
+  // ── Link ──────────────────────────────────────────────────────────
+
+  private untilNextEvent(): number {
+    const now = this.clock.now();
+    return Math.ceil(now / this.interval) * this.interval - now;
+  }
+
+  private enqueue(frame: Uint8Array): void {
+    for (const chunk of chunkFrame(frame, this.mtu)) this.txQueue.push(chunk);
+    if (!this.pumpScheduled) {
+      this.pumpScheduled = true;
+      this.clock.setTimeout(() => this.pump(), this.untilNextEvent());
+    }
+  }
+
+  /** One connection event: up to packetsPerEvent PDU slots for queued notifications. */
+  private pump(): void {
+    for (let slot = 0; slot < this.packetsPerEvent && this.txQueue.length > 0; slot++) {
+      if (this.rand() < this.lossRate) {
+        this.stats.retransmits++;
+        continue; // not acked; the head PDU goes again in the next slot
+      }
+      const chunk = this.txQueue.shift()!;
+      this.stats.notifications++;
+      this.stats.bytes += chunk.length;
+      if (this.dropAt.has(this.stats.notifications)) {
+        this.stats.dropped++;
+        continue;
+      }
+      this.clock.setTimeout(() => {
+        for (const l of this.listeners) l(chunk);
+      }, this.latency);
+    }
+    if (this.txQueue.length > 0) {
+      this.clock.setTimeout(() => this.pump(), this.interval);
+    } else {
+      this.pumpScheduled = false;
+    }
+  }
+
+  // ── History ───────────────────────────────────────────────────────
+
+  private rand(): number {
+    this.seed = (this.seed * 1_103_515_245 + 12_345) & 0x7fffffff;
+    return this.seed / 0x7fffffff;
+  }
+
+  private int(lo: number, hi: number): number {
+    return lo + Math.floor(this.rand() * (hi - lo + 1));
+  }
+
+  private generateHistory(days: number): void {
+    const now = this.clock.now();
+    const firstDay = Math.floor(now / DAY) * DAY - (days - 1) * DAY;
+    const steps: RingRecord[] = [];
+    const sleep: RingRecord[] = [];
+    const hr: RingRecord[] = [];
+    const hrv: RingRecord[] = [];
+    const spo2: RingRecord[] = [];
+    const temp: RingRecord[] = [];
+
+    for (let d = 0; d < days; d++) {
+      const day = firstDay + d * DAY;
+      const step = this.int(2_000, 16_000);
+      steps.push({
+        date: fmtDate(day),
+        step,
+        distance: Math.round(step * 0.075) / 100, // km, two decimals like the ring
+        calories: Math.round(step * 0.04),
+        exerciseMinutes: this.int(10, 90),
+      });
+
+      // Night starting 22:30–00:30 the previous evening
+      const start = day - 90 * MIN + this.int(0, 120) * MIN;
+      const minutes = this.int(300, 540);
+      const quality: number[] = new Array(minutes);
+      let stage = 2;
+      for (let m = 0; m < minutes; m++) {
+        if (this.rand() < 0.06) stage = this.int(1, 4);
+        quality[m] = stage;
+      }
+      if (start < now) {
+        sleep.push({ startTime_SleepData: fmtDateTime(start), totalSleepTime: minutes, sleepUnitLength: 1, arraySleepQuality: quality });
+      }
+
+      for (let t = day; t < day + DAY && t < now; t += 15 * MIN) {
+        const base = this.int(52, 95);
+        hr.push({ date: fmtDateTime(t), arrayHR: Array.from({ length: 15 }, () => base + this.int(-4, 4)) });
+        if ((t / (15 * MIN)) % 2 === 0) {
+          hrv.push({ date: fmtDateTime(t), hrv: this.int(20, 110), heartRate: base, stress: this.int(5, 80), HighPressure: this.int(105, 135), LowPressure: this.int(65, 88) });
+          spo2.push({ date: fmtDateTime(t), automaticSpo2Data: this.int(93, 99) });
+          temp.push({ date: fmtDateTime(t), temperature: Math.round((35.8 + this.rand() * 1.2) * 10) / 10 });
+        }
+      }
+    }
+
+    this.store.set(RingCommand.Steps, steps);
+    this.store.set(RingCommand.Sleep, sleep);
+    this.store.set(RingCommand.HeartRate, hr);
+    this.store.set(RingCommand.Hrv, hrv);
+    this.store.set(RingCommand.SpO2, spo2);
+    this.store.set(RingCommand.Temperature, temp);
+  }
+}
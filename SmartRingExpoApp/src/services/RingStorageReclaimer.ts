@@ -0,0 +1,258 @@
+/**
+ * RingStorageReclaimer — frees ring history storage once its records are safe elsewhere
+ *
+ * The ring only offers "delete all records of a type" (mode 0x99 on each
+ * ...WithMode: history command), so a type may be cleared only when nothing
+ * it holds is ring-only. Two watermarks per type make that checkable:
+ *
+ *   fetchedAt — a fetch of the type finished and its records are persisted in
+ *               the local store, i.e. the store holds everything the ring held
+ *               at that instant (the stores fetch from a cursor, so this holds
+ *               across syncs).
+ *   ackedAt   — an upload that started at this instant, covering everything
+ *               the local store held, was acknowledged by the backend.
+ *
+ * reclaim() deletes a type when ackedAt >= fetchedAt and the fetch is recent
+ * (the same sync): only records the ring wrote between that fetch and the
+ * delete command are lost, at most a minute or two of data. A type is also
+ * left alone until minIntervalDays have passed since it was last cleared (or
+ * first seen), so the ring always keeps a buffer of history.
+ *
+ * Every delete, dry run and failure is written to a ledger pruned after
+ * ledgerRetentionDays. dryRun (the default) evaluates and records everything
+ * but never sends the command.
+ *
+ * No React Native imports: the delete call and storage are injected.
+ */
+
+import type { ActivityDetailStorage } from './ActivityDetailStore';
+
+const POLICY_KEY = 'ring_reclaim_v1_policy';
+const STATE_KEY = 'ring_reclaim_v1_state';
+const LEDGER_KEY = 'ring_reclaim_v1_ledger';
+const DAY_MS = 24 * 60 * 60 * 1000;
+
+export interface ReclaimPolicy {
+  enabled: boolean;
+  /** Evaluate and write ledger entries without sending delete commands. */
+  dryRun: boolean;
+  /** Fetch operation names whose ring history may be cleared. */
+  types: string[];
+  /** Keep at least this many days of history on the ring between clears. */
+  minIntervalDays: number;
+  /** Skip types with fewer records fetched since the last clear. */
+  minRecords: number;
+  /** A fetch older than this no longer vouches for the ring's contents. */
+  maxFetchAgeMs: number;
+  ledgerRetentionDays: number;
+}
+
+/**
+ * Only streams whose every record is stored and uploaded are cleared by default:
+ * per-minute activity (ActivityDetailStore, hourly rollups of every changed day).
+ * X3 continuous SpO2 is not: OvernightStore keeps only the overnight window, and
+ * only 5-minute means are uploaded. Sleep and HR are still read straight from the ring.
+ */
+export const DEFAULT_RECLAIM_POLICY: ReclaimPolicy = {
+  enabled: true,
+  dryRun: true,
+  types: ['getDetailActivityData'],
+  minIntervalDays: 3,
+  minRecords: 1,
+  maxFetchAgeMs: 10 * 60 * 1000,
+  ledgerRetentionDays: 90,
+};
+
+interface TypeState {
+  /** First fetch noted since the last clear. */
+  since: number;
+  fetchedAt: number;
+  ackedAt: number | null;
+  /** Records fetched since the last clear. */
+  records: number;
+  lastClearedAt: number | null;
+}
+
+export interface ReclaimLedgerEntry {
+  at: number;
+  type: string;
+  action: 'deleted' | 'dryRun' | 'failed';
+  records: number;
+  fetchedAt: number;
+  ackedAt: number;
+  error?: string;
+}
+
+export interface ReclaimOutcome {
+  type: string;
+  action: ReclaimLedgerEntry['action'] | 'skipped';
+  reason?: string;
+}
+
+export type HistoryDeleter = (type: string) => Promise<unknown>;
+
+export interface RingStorageReclaimerOptions {
+  now?: () => number;
+}
+
+export class RingStorageReclaimer {
+  private readonly deleteHistory: HistoryDeleter;
+  private readonly storage: ActivityDetailStorage;
+  private readonly now: () => number;
+
+  private loaded: Promise<void> | null = null;
+  private policy: ReclaimPolicy = { ...DEFAULT_RECLAIM_POLICY };
+  private state: Record<string, TypeState> = {};
+  private ledger: ReclaimLedgerEntry[] = [];
+  private inFlight: Promise<ReclaimOutcome[]> | null = null;
+
+  constructor(deleteHistory: HistoryDeleter, storage: ActivityDetailStorage, options: RingStorageReclaimerOptions = {}) {
+    this.deleteHistory = deleteHistory;
+    this.storage = storage;
+    this.now = options.now ?? Date.now;
+  }
+
+  async getPolicy(): Promise<ReclaimPolicy> {
+    await this.load();
+    return { ...this.policy, types: [...this.policy.types] };
+  }
+
+  async setPolicy(patch: Partial<ReclaimPolicy>): Promise<ReclaimPolicy> {
+    await this.load();
+    this.policy = { ...this.policy, ...patch };
+    await this.storage.setItem(POLICY_KEY, JSON.stringify(this.policy));
+    return this.getPolicy();
+  }
+
+  /** Newest entries last. */
+  async getLedger(): Promise<ReclaimLedgerEntry[]> {
+    await this.load();
+    return [...this.ledger];
+  }
+
+  /** The fetch of `type` finished and its `records` are persisted locally. */
+  async noteFetched(type: string, records: number): Promise<void> {
+    await this.load();
+    const at = this.now();
+    const prev = this.state[type];
+    this.state[type] = {
+      since: prev?.since ?? at,
+      fetchedAt: at,
+      ackedAt: prev?.ackedAt ?? null,
+      records: (prev?.records ?? 0) + Math.max(0, records),
+      lastClearedAt: prev?.lastClearedAt ?? null,
+    };
+    await this.saveState();
+  }
+
+  /**
+   * The backend acknowledged an upload, started at `uploadStartedAt`, of everything the
+   * local store held for `type` since ackedThrough(type).
+   */
+  async noteAcked(type: string, uploadStartedAt: number): Promise<void> {
+    await this.load();
+    const entry = this.state[type];
+    if (!entry) return;
+    entry.ackedAt = Math.max(entry.ackedAt ?? 0, uploadStartedAt);
+    await this.saveState();
+  }
+
+  /** Local data for `type` up to this instant is on the backend; null = never acked. */
+  async ackedThrough(type: string): Promise<number | null> {
+    await this.load();
+    return this.state[type]?.ackedAt ?? null;
+  }
+
+  /** Clear every eligible type on the ring. Concurrent calls share one pass. */
+  reclaim(): Promise<ReclaimOutcome[]> {
+    if (!this.inFlight) {
+      this.inFlight = this.runReclaim().finally(() => {
+        this.inFlight = null;
+      });
+    }
+    return this.inFlight;
+  }
+
+  private async runReclaim(): Promise<ReclaimOutcome[]> {
+    await this.load();
+    const policy = this.policy;
+    if (!policy.enabled) return [];
+
+    const outcomes: ReclaimOutcome[] = [];
+    for (const type of policy.types) {
+      const entry = this.state[type];
+      const reason = this.skipReason(entry, policy);
+      if (reason || !entry) {
+        outcomes.push({ type, action: 'skipped', reason: reason ?? undefined });
+        continue;
+      }
+
+      const record: ReclaimLedgerEntry = {
+        at: this.now(),
+        type,
+        action: 'dryRun',
+        records: entry.records,
+        fetchedAt: entry.fetchedAt,
+        ackedAt: entry.ackedAt!,
+      };
+      if (!policy.dryRun) {
+        try {
+          await this.deleteHistory(type);
+          record.action = 'deleted';
+        } catch (e) {
+          record.action = 'failed';
+          record.error = (e as Error)?.message ?? String(e);
+        }
+      }
+      // A dry run advances the schedule like a delete, so the ledger shows the real cadence
+      if (record.action !== 'failed') {
+        this.state[type] = { ...entry, since: record.at, records: 0, lastClearedAt: record.at };
+      }
+      this.ledger.push(record);
+      outcomes.push({ type, action: record.action, reason: record.error });
+    }
+
+    if (outcomes.some(o => o.action !== 'skipped')) {
+      const cutoff = this.now() - policy.ledgerRetentionDays * DAY_MS;
+      this.ledger = this.ledger.filter(e => e.at >= cutoff);
+      await this.storage.multiSet([
+        [STATE_KEY, JSON.stringify(this.state)],
+        [LEDGER_KEY, JSON.stringify(this.ledger)],
+      ]);
+    }
+    return outcomes;
+  }
+
+  private skipReason(entry: TypeState | undefined, policy: ReclaimPolicy): string | null {
+    if (!entry) return 'never fetched';
+    const now = this.now();
+    if (now - entry.fetchedAt > policy.maxFetchAgeMs) return 'fetch is stale';
+    if (entry.ackedAt === null || entry.ackedAt < entry.fetchedAt) return 'not acked since last fetch';
+    if (entry.records < policy.minRecords) return 'too few records';
+    if (now - (entry.lastClearedAt ?? entry.since) < policy.minIntervalDays * DAY_MS) return 'cleared too recently';
+    return null;
+  }
+
+  private load(): Promise<void> {
+    if (!this.loaded) {
+      this.loaded = this.storage.multiGet([POLICY_KEY, STATE_KEY, LEDGER_KEY]).then(rows => {
+        for (const [key, raw] of rows) {
+          if (!raw) continue;
+          try {
+            const value = JSON.parse(raw);
+            if (key === POLICY_KEY) this.policy = { ...DEFAULT_RECLAIM_POLICY, ...value };
+            else if (key === STATE_KEY) this.state = value;
+            else if (key === LEDGER_KEY) this.ledger = value;
+          } catch {
+            // Corrupt entry: fall back to defaults; a bad state only delays reclaiming
+          }
+        }
+      });
+    }
+    return this.loaded;
+  }
+
+  private saveState(): Promise<void> {
+    return this.storage.setItem(STATE_KEY, JSON.stringify(this.state));
+  }
+}
@@ -0,0 +1,330 @@
+/**
+ * SampleColumns — struct-of-arrays normalization for SDK history batches
+ *
+ * The bridges hand back packets of `any` dictionaries: each packet either holds an
+ * entry array (arrayHrvData, arrayPpiData, ...) or is an entry itself, and the same
+ * value can sit under one of several key names depending on firmware. Instead of
+ * trying every fallback key and splitting every date string per record, a batch is
+ * normalized in one pass:
+ *   - the key for each field is resolved once, from the first entries that carry it;
+ *     an entry missing the resolved key falls back to the other names, and a field no
+ *     early entry carries is looked up per entry (mixed batches, optional fields)
+ *   - dates go through a RingDateParser (fixed-width digits, per-day midnight cache)
+ *   - each field lands in its own Float64Array (NaN = missing), `length` rows long
+ *
+ * The x3* / v8* helpers apply each service's filters and fallback timestamps; the
+ * services turn columns into row objects only where a caller still wants them.
+ *
+ * No React Native imports, so scripts/bench-sample-columns.ts runs it under Node.
+ */
+
+import { RingDateParser } from '../utils/ringDate';
+
+export interface ColumnSpec<N extends string, D extends string = never, S extends string = never> {
+  /** Entry arrays inside a packet (all present ones are concatenated, even empty); a packet with none is an entry. */
+  arrays: readonly string[];
+  /** Candidate keys per numeric field, in preference order. */
+  numbers: Record<N, readonly string[]>;
+  dates?: Record<D, readonly string[]>;
+  strings?: Record<S, readonly string[]>;
+}
+
+export type Columns<N extends string, D extends string = never, S extends string = never> =
+  { length: number } & Record<N | D, Float64Array> & Record<S, (string | undefined)[]>;
+
+/** How many rows a key is looked for in before falling back to per-entry lookup. */
+const RESOLVE_SCAN = 64;
+
+function entriesOf(packets: readonly any[], arrays: readonly string[]): { chunks: any[][]; total: number } {
+  const chunks: any[][] = [];
+  let total = 0;
+  let singles: any[] | null = null;
+  for (const packet of packets) {
+    if (!packet || typeof packet !== 'object') continue;
+    let found = false;
+    for (const key of arrays) {
+      const list = packet[key];
+      if (Array.isArray(list)) {
+        if (list.length > 0) {
+          chunks.push(list);
+          total += list.length;
+        }
+        found = true;
+      }
+    }
+    if (!found) {
+      if (!singles) {
+        singles = [];
+        chunks.push(singles);
+      }
+      singles.push(packet);
+      total += 1;
+    }
+  }
+  return { chunks, total };
+}
+
+function resolveKey(chunks: any[][], keys: readonly string[], accept: (value: unknown) => boolean): string | null {
+  let scanned = 0;
+  for (const chunk of chunks) {
+    for (const entry of chunk) {
+      if (entry) {
+        for (const key of keys) {
+          if (accept(entry[key])) return key;
+        }
+      }
+      if (++scanned >= RESOLVE_SCAN) return null;
+    }
+  }
+  return null;
+}
+
+const isNumeric = (value: unknown) => value !== undefined && Number.isFinite(Number(value));
+const isPresent = (value: unknown) => !!value;
+
+/** One pass over `packets` into typed columns; see the header comment. */
+export function normalizeColumns<N extends string, D extends string = never, S extends string = never>(
+  packets: readonly any[],
+  spec: ColumnSpec<N, D, S>,
+  parser: RingDateParser = new RingDateParser(),
+): Columns<N, D, S> {
+  const { chunks, total } = entriesOf(packets ?? [], spec.arrays);
+  const out: Record<string, unknown> = { length: total };
+
+  const numberFields = Object.keys(spec.numbers) as N[];
+  for (const field of numberFields) {
+    const keys = spec.numbers[field];
+    const column = new Float64Array(total).fill(NaN);
+    out[field] = column;
+    // Unresolved: start from the preferred name; the per-entry fallback below tries the rest
+    const key = resolveKey(chunks, keys, isNumeric) ?? keys[0];
+    let i = 0;
+    for (const chunk of chunks) {
+      for (const entry of chunk) {
+        if (entry) {
+          let value = Number(entry[key]);
+          if (!Number.isFinite(value)) {
+            value = NaN;
+            for (const alt of keys) {
+              const v = Number(entry[alt]);
+              if (entry[alt] !== undefined && Number.isFinite(v)) { value = v; break; }
+            }
+          }
+          column[i] = value;
+        }
+        i++;
+      }
+    }
+  }
+
+  const dateFields = Object.keys(spec.dates ?? {}) as D[];
+  for (const field of dateFields) {
+    const keys = spec.dates![field];
+    const column = new Float64Array(total).fill(NaN);
+    out[field] = column;
+    const key = resolveKey(chunks, keys, isPresent) ?? keys[0];
+    let i = 0;
+    for (const chunk of chunks) {
+      for (const entry of chunk) {
+        if (entry) {
+          let raw = entry[key];
+          if (!raw) raw = keys.map(k => entry[k]).find(isPresent);
+          const ts = parser.parse(raw);
+          if (ts !== undefined) column[i] = ts;
+        }
+        i++;
+      }
+    }
+  }
+
+  const stringFields = Object.keys(spec.strings ?? {}) as S[];
+  for (const field of stringFields) {
+    const keys = spec.strings![field];
+    const column: (string | undefined)[] = new Array(total).fill(undefined);
+    out[field] = column;
+    let i = 0;
+    for (const chunk of chunks) {
+      for (const entry of chunk) {
+        const raw = entry ? keys.map(k => entry[k]).find(isPresent) : undefined;
+        if (raw !== undefined) column[i] = String(raw);
+        i++;
+      }
+    }
+  }
+
+  return out as Columns<N, D, S>;
+}
+
+/** Drop the rows `keep` rejects, in place; `length` shrinks, capacity doesn't. */
+export function compactColumns<C extends { length: number }>(columns: C, keep: (row: number) => boolean): C {
+  const fields = Object.keys(columns).filter(k => k !== 'length') as (keyof C)[];
+  let w = 0;
+  for (let r = 0; r < columns.length; r++) {
+    if (!keep(r)) continue;
+    if (w !== r) {
+      for (const f of fields) (columns[f] as any)[w] = (columns[f] as any)[r];
+    }
+    w++;
+  }
+  columns.length = w;
+  return columns;
+}
+
+/** Fill NaN timestamps with `fallback`. */
+function fillTimestamps(column: Float64Array, length: number, fallback: number): void {
+  for (let i = 0; i < length; i++) {
+    if (Number.isNaN(column[i])) column[i] = fallback;
+  }
+}
+
+// ========== X3 (JstyleService) ==========
+
+const X3_DATE_KEYS = ['date', 'startDate', 'startTime'] as const;
+
+export type HrvColumns = Columns<'sdnn' | 'heartRate' | 'stress', 'timestamp'>;
+
+/** Missing values are 0, like the per-record parser this replaced. */
+export function x3HrvColumns(packets: readonly any[], fallbackTs: number): HrvColumns {
+  const cols = normalizeColumns(packets, {
+    arrays: ['arrayHrvData'],
+    numbers: { sdnn: ['hrv', 'hrvValue'], heartRate: ['heartRate'], stress: ['stress'] },
+    dates: { timestamp: ['date'] },
+  });
+  fillTimestamps(cols.timestamp, cols.length, fallbackTs);
+  for (const f of ['sdnn', 'heartRate', 'stress'] as const) {
+    const c = cols[f];
+    for (let i = 0; i < cols.length; i++) if (Number.isNaN(c[i])) c[i] = 0;
+  }
+  return cols;
+}
+
+export type SpO2Columns = Columns<'spo2', 'timestamp'>;
+
+export function x3SpO2Columns(packets: readonly any[], fallbackTs: number): SpO2Columns {
+  const cols = normalizeColumns(packets, {
+    arrays: ['arrayAutomaticSpo2Data'],
+    numbers: { spo2: ['automaticSpo2Data', 'spo2'] },
+    dates: { timestamp: ['date'] },
+  });
+  fillTimestamps(cols.timestamp, cols.length, fallbackTs);
+  return compactColumns(cols, i => cols.spo2[i] > 0);
+}
+
+export type TemperatureColumns = Columns<'temperature', 'timestamp'>;
+
+export function x3TemperatureColumns(packets: readonly any[], fallbackTs: number): TemperatureColumns {
+  const cols = normalizeColumns(packets, {
+    // SDK typo — missing capital T
+    arrays: ['arrayemperatureData', 'arrayTemperatureData'],
+    numbers: { temperature: ['temperature'] },
+    dates: { timestamp: ['date'] },
+  });
+  fillTimestamps(cols.timestamp, cols.length, fallbackTs);
+  // Human body temperature range (34–42°C) — the SDK returns corrupted values outside it
+  return compactColumns(cols, i => cols.temperature[i] >= 34 && cols.temperature[i] <= 42);
+}
+
+export type SleepHrvColumns = Columns<'respiratoryRate' | 'oxygenDropIndex', 'timestamp'>;
+
+export function x3SleepHrvColumns(packets: readonly any[], fallbackTs: number): SleepHrvColumns {
+  const cols = normalizeColumns(packets, {
+    arrays: ['arraySleepHrvData'],
+    numbers: {
+      respiratoryRate: ['respiratoryRate', 'respRate', 'breathRate', 'sleepRespiratoryRate'],
+      oxygenDropIndex: ['oxygenDropIndex', 'odi'],
+    },
+    dates: { timestamp: X3_DATE_KEYS },
+  });
+  fillTimestamps(cols.timestamp, cols.length, fallbackTs);
+  return cols;
+}
+
+export type EventCountColumns = Columns<'count', 'timestamp'>;
+
+/** OSA / EOV event counts; rows without a positive count are dropped. */
+export function x3EventCountColumns(packets: readonly any[], fallbackTs: number): EventCountColumns {
+  const cols = normalizeColumns(packets, {
+    arrays: ['arrayOSAData', 'arrayEOVData'],
+    numbers: { count: ['eventCount', 'count', 'events', 'value'] },
+    dates: { timestamp: X3_DATE_KEYS },
+  });
+  fillTimestamps(cols.timestamp, cols.length, fallbackTs);
+  return compactColumns(cols, i => cols.count[i] > 0);
+}
+
+export type PpiColumns = Columns<'ppi', 'timestamp'>;
+
+export function x3PpiColumns(packets: readonly any[], fallbackTs: number): PpiColumns {
+  const cols = normalizeColumns(packets, {
+    arrays: ['arrayPpiData'],
+    numbers: { ppi: ['ppi', 'rrInterval', 'rri'] },
+    dates: { timestamp: X3_DATE_KEYS },
+  });
+  fillTimestamps(cols.timestamp, cols.length, fallbackTs);
+  return compactColumns(cols, i => cols.ppi[i] > 0);
+}
+
+export type ActivityModeColumns = Columns<
+  'mode' | 'duration' | 'steps' | 'distanceKm' | 'calories' | 'heartRateAvg' | 'heartRateMax',
+  'startTime' | 'endTime',
+  'label'
+>;
+
+/** Raw activity-mode sessions; durations are as sent (minutes, or seconds above 1000). */
+export function x3ActivityModeColumns(packets: readonly any[]): ActivityModeColumns {
+  return normalizeColumns(packets, {
+    arrays: ['arrayActivityModeData'],
+    numbers: {
+      mode: ['activityMode', 'sportType', 'mode', 'type'],
+      duration: ['activityTime', 'duration', 'exerciseMinutes'],
+      steps: ['step', 'steps'],
+      distanceKm: ['distance', 'distanceKm'],
+      calories: ['calories', 'kcal'],
+      heartRateAvg: ['averageHeartRate', 'avgHeartRate', 'heartRateAvg'],
+      heartRateMax: ['maxHeartRate', 'heartRateMax'],
+    },
+    dates: {
+      startTime: ['startDate', 'startTime', 'date', 'startTime_ActivityModeData'],
+      endTime: ['endDate', 'endTime'],
+    },
+    strings: { label: ['sportName', 'modeName'] },
+  });
+}
+
+// ========== V8 (V8Service) ==========
+// Flat records (no entry arrays); missing or zero values stay NaN / 0 for the service to map
+
+export function v8HrvColumns(items: readonly any[]): HrvColumns {
+  return normalizeColumns(items, {
+    arrays: [],
+    numbers: { sdnn: ['hrv'], heartRate: ['heartRate'], stress: ['stress'] },
+    dates: { timestamp: ['date'] },
+  });
+}
+
+export function v8SpO2Columns(items: readonly any[]): SpO2Columns {
+  return normalizeColumns(items, {
+    arrays: [],
+    numbers: { spo2: ['automaticSpo2Data'] },
+    dates: { timestamp: ['date'] },
+  });
+}
+
+export function v8TemperatureColumns(items: readonly any[]): TemperatureColumns {
+  return normalizeColumns(items, {
+    arrays: [],
+    numbers: { temperature: ['temperature'] },
+    dates: { timestamp: ['date'] },
+  });
+}
+
+export type V8SportColumns = Columns<'durationSec' | 'steps' | 'distanceKm' | 'calories' | 'heartRate', 'startTime'>;
+
+export function v8SportColumns(items: readonly any[]): V8SportColumns {
+  return normalizeColumns(items, {
+    arrays: [],
+    // activeMinutes is actually seconds despite the name
+    numbers: { durationSec: ['activeMinutes'], steps: ['step'], distanceKm: ['distance'], calories: ['calories'], heartRate: ['heartRate'] },
+    dates: { startTime: ['date'] },
+  });
+}
@@ -5,6 +5,8 @@
 
 import AsyncStorage from '@react-native-async-storage/async-storage';
 import { supabase } from './SupabaseService';
+import { getRowsSince, type DeltaRow } from './DeltaSyncService';
+import { RollingWindow } from '../utils/rollingStats';
 import type {
   SleepDebtCategory,
   DailyDeficit,
@@ -26,6 +28,24 @@ interface CachedSleepDebt {
   cachedAt: number;
 }
 
+// Last computation per user, keyed by night. The delta cache hands back the
+// same row object until that row changes, so a night is reused while it and the
+// nights its debt and recommendation read are unchanged, whatever its position
+// after the 30-day window slides.
+interface DebtMemoEntry {
+  row: DeltaRow;
+  /** Date of the valid night before this one, null for the first. */
+  prevDate: string | null;
+  point: NightlyPoint;
+}
+
+interface DebtMemo {
+  targetMin: number;
+  byDate: Map<string, DebtMemoEntry>;
+}
+
+const debtMemo = new Map<string, DebtMemo>();
+
 // ─── Sleep target ──────────────────────────────────────────────────────────────
 
 export async function getSleepTarget(userId: string): Promise<number> {
@@ -100,40 +120,12 @@ export async function computeSleepDebt(userId: string): Promise<SleepDebtState>
 
   const thirtyDaysAgo = new Date();
   thirtyDaysAgo.setDate(thirtyDaysAgo.getDate() - 30);
-  const cutoff = thirtyDaysAgo.toISOString().slice(0, 10);
-
-  const { data: rows } = await (supabase
-    .from('daily_summaries') as any)
-    .select('date, sleep_total_min, nap_total_min')
-    .eq('user_id', userId)
-    .gte('date', cutoff)
-    .order('date', { ascending: true })
-    .limit(30);
-
-  const validRows: Array<{ date: string; sleep_total_min: number; nap_total_min: number | null }> =
-    (rows ?? []).filter(
-      (r: any) => r.sleep_total_min != null && r.sleep_total_min > 0
-    );
-
-  // Compute NightlyPoint for each valid row with trailing 7-day running debt
-  // Pass 1: compute running debt at each point (needed to derive recommendedMin for the next point)
-  const runningDebts: number[] = validRows.map((r, i, arr) => {
-    const windowStart = Math.max(0, i - 6);
-    return arr.slice(windowStart, i + 1).reduce((sum, wr) => {
-      const a = wr.sleep_total_min + (wr.nap_total_min || 0);
-      return sum + Math.max(0, targetMin - a);
-    }, 0);
-  });
-
-  // Pass 2: build full NightlyPoint using prior-night running debt for recommendedMin
-  const last30: NightlyPoint[] = validRows.map((r, i) => {
-    const actualMin = r.sleep_total_min + (r.nap_total_min || 0);
-    const deficitMin = Math.max(0, targetMin - actualMin);
-    const runningDebtMin = runningDebts[i];
-    const priorDebt = i > 0 ? runningDebts[i - 1] : 0;
-    const recommendedMin = computeTonightRecommendation({ targetMin, totalDebtMin: priorDebt }).recommendedMin;
-    return { date: r.date, actualMin, targetMin, deficitMin, runningDebtMin, recommendedMin };
-  });
+
+  // Shares the delta-sync cache, so a warm call only pulls rows changed since the last cursor.
+  // The cache holds every row since the cutoff, so the 30-row cap is applied here, keeping the newest.
+  const rows = (await getRowsSince(userId, 'daily_summaries', thirtyDaysAgo)).slice(-30);
+  const validRows = rows.filter(r => r.sleep_total_min != null && r.sleep_total_min > 0);
+  const last30 = nightlyPoints(userId, targetMin, validRows);
 
   const last7 = last30.slice(-7);
 
@@ -181,6 +173,53 @@ export async function computeSleepDebt(userId: string): Promise<SleepDebtState>
   };
 }
 
+/**
+ * NightlyPoint per row with its trailing 7-night running debt. A night's point
+ * is reused when none of the nights it reads (itself and the 7 before it, as the
+ * recommendation uses the previous night's window) changed, moved or was dropped
+ * since the last call; the rest are rebuilt.
+ */
+function nightlyPoints(userId: string, targetMin: number, rows: DeltaRow[]): NightlyPoint[] {
+  const memo = debtMemo.get(userId);
+  const prev = memo && memo.targetMin === targetMin ? memo.byDate : null;
+  const byDate = new Map<string, DebtMemoEntry>();
+  const points: NightlyPoint[] = [];
+  const debt = new RollingWindow(7);
+  let lastChanged = -Infinity;
+
+  for (let i = 0; i < rows.length; i++) {
+    const r = rows[i];
+    const prevDate = i > 0 ? rows[i - 1].date : null;
+    const entry = prev?.get(r.date);
+    if (!entry || entry.row !== r || entry.prevDate !== prevDate) lastChanged = i;
+
+    let point: NightlyPoint;
+    if (entry && i - lastChanged > 7) {
+      point = entry.point;
+      debt.push(point.deficitMin);
+    } else {
+      const actualMin = r.sleep_total_min + (r.nap_total_min || 0);
+      const deficitMin = Math.max(0, targetMin - actualMin);
+      // Running debt through the previous night drives tonight's recommendation
+      const priorDebt = debt.sum;
+      debt.push(deficitMin);
+      point = {
+        date: r.date,
+        actualMin,
+        targetMin,
+        deficitMin,
+        runningDebtMin: debt.sum,
+        recommendedMin: computeTonightRecommendation({ targetMin, totalDebtMin: priorDebt }).recommendedMin,
+      };
+    }
+    points.push(point);
+    byDate.set(r.date, { row: r, prevDate, point });
+  }
+
+  debtMemo.set(userId, { targetMin, byDate });
+  return points;
+}
+
 // ─── Cache helpers ─────────────────────────────────────────────────────────────
 
 export async function getCachedSleepDebt(): Promise<SleepDebtState | null> {
@@ -203,6 +242,7 @@ export async function cacheSleepDebt(state: SleepDebtState): Promise<void> {
 }
 
 export async function clearSleepDebtCache(): Promise<void> {
+  debtMemo.clear();
   try {
     await AsyncStorage.removeItem(CACHE_KEY);
   } catch {}
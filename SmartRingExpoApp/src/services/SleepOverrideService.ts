@@ -1,4 +1,5 @@
 import AsyncStorage from '@react-native-async-storage/async-storage';
+import type { SleepOverrideWindow } from './SleepSegmentation';
 
 const KEY = 'sleep_time_override_v1';
 
@@ -38,3 +39,8 @@ export async function clearSleepOverride(date?: Date): Promise<void> {
   delete store[dateKey(date)];
   await AsyncStorage.setItem(KEY, JSON.stringify(store));
 }
+
+/** Override as epoch ms, for SleepSegmenter.setOverride. */
+export function overrideWindow(override: SleepTimeOverride): SleepOverrideWindow {
+  return { bedTime: Date.parse(override.bedTime), wakeTime: Date.parse(override.wakeTime) };
+}
@@ -0,0 +1,394 @@
+/**
+ * SleepSegmentation — sleep sessions from ring, HealthKit and manual intervals
+ *
+ * Ring sleep arrives as ~2 h records (arraySleepQuality, sleepUnitLength minutes per
+ * value). Records at most RING_MERGE_GAP_MS apart form one block; each block gets a
+ * per-minute stage timeline, stage totals and a night / nap classification
+ * (NapClassifierService), and becomes a SleepSession. HealthKit samples are swept the
+ * same way with their own gap and fused onto the ring session they overlap
+ * (suggestedBedTime when the phone had the user in bed ≥45 min before the ring did); a
+ * manual bed / wake override is attached to the session it overlaps. `sources` says
+ * where each session's data came from.
+ *
+ * SleepSegmenter keeps ring records sorted (one sort per batch, only when a batch lands
+ * out of order) and re-sweeps from the first session a batch can touch, so sessions
+ * before it keep their identity between syncs. `sleepSegmenter` is the instance the
+ * sync path and the home screen share.
+ *
+ * No React Native imports, so scripts/bench-sleep-segmentation.ts runs it under Node.
+ */
+
+import { parseRingDate } from '../utils/ringDate';
+import { classifySleepSession, type SessionType } from './NapClassifierService';
+
+export type SleepSource = 'ring' | 'healthkit' | 'manual';
+
+const MINUTE_MS = 60 * 1000;
+/** Ring records this close (end → next start) belong to one sleep. */
+export const RING_MERGE_GAP_MS = 60 * MINUTE_MS;
+/** HealthKit samples this close belong to one sleep. */
+export const HEALTHKIT_MERGE_GAP_MS = 90 * MINUTE_MS;
+/** Blocks at least this long are full nights when picking the main night. */
+export const NIGHT_MIN_MS = 180 * MINUTE_MS;
+/** The ring sometimes reports 20–25 h cumulative sessions; longer than this isn't one sleep. */
+export const MAX_SESSION_MS = 14 * 60 * MINUTE_MS;
+/** An earlier HealthKit in-bed start only counts when it's at least this far ahead of the ring. */
+export const SUGGESTED_BEDTIME_MIN_GAP_MS = 45 * MINUTE_MS;
+/** Sessions ending this long before the newest record are dropped; sync covers 7 days. */
+const RING_RETENTION_MS = 14 * 24 * 60 * MINUTE_MS;
+
+// Timeline codes (also the order the hypnogram stacks them)
+export const STAGE_AWAKE = 0;
+export const STAGE_LIGHT = 1;
+export const STAGE_REM = 2;
+export const STAGE_DEEP = 3;
+
+/** SDK sleep quality value → timeline code. X3: 1=Deep, 2=Light, 3=REM, anything else awake. */
+export function ringStageCode(value: number): number {
+  return value === 1 ? STAGE_DEEP : value === 3 ? STAGE_REM : value === 2 ? STAGE_LIGHT : STAGE_AWAKE;
+}
+
+export interface RingSleepRecord {
+  start: number;
+  /** Minutes per arraySleepQuality value. */
+  unit: number;
+  arr: number[];
+  /** Recording length (arr.length × unit), not net sleep: totalSleepTime undershoots the
+   *  record and opens false gaps between adjacent records. */
+  durationMin: number;
+  raw: any;
+}
+
+/** Raw getSleepData records → RingSleepRecord, dropping ones without a usable start. */
+export function ringSleepRecords(raw: readonly any[]): RingSleepRecord[] {
+  const out: RingSleepRecord[] = [];
+  for (const r of raw ?? []) {
+    if (!r) continue;
+    const start: number | undefined = [r.startTimestamp, r.startTime].find(v => typeof v === 'number' && Number.isFinite(v) && v > 0)
+      ?? parseRingDate(r.startTime_SleepData);
+    if (start === undefined) continue;
+    const unit = Number(r.sleepUnitLength) || 1;
+    const arr: number[] = Array.isArray(r.arraySleepQuality) ? r.arraySleepQuality : [];
+    const durationMin = arr.length * unit || Number(r.totalSleepTime) || 0;
+    out.push({ start, unit, arr, durationMin, raw: r });
+  }
+  return out;
+}
+
+export interface IntervalBlock<T> {
+  start: number;
+  end: number;
+  items: T[];
+}
+
+/** Sort-and-sweep: items whose start is within gapMs of the running block's end join it. */
+export function mergeIntervals<T>(
+  items: readonly T[],
+  startOf: (item: T) => number,
+  endOf: (item: T) => number,
+  gapMs: number,
+): IntervalBlock<T>[] {
+  const sorted = [...items].sort((a, b) => startOf(a) - startOf(b));
+  return sweepSorted(sorted, 0, startOf, endOf, gapMs);
+}
+
+function sweepSorted<T>(
+  sorted: readonly T[],
+  from: number,
+  startOf: (item: T) => number,
+  endOf: (item: T) => number,
+  gapMs: number,
+): IntervalBlock<T>[] {
+  const blocks: IntervalBlock<T>[] = [];
+  let cur: IntervalBlock<T> | null = null;
+  for (let i = from; i < sorted.length; i++) {
+    const item = sorted[i];
+    const start = startOf(item);
+    const end = endOf(item);
+    if (cur && start - cur.end <= gapMs) {
+      if (end > cur.end) cur.end = end;
+      cur.items.push(item);
+    } else {
+      cur = { start, end, items: [item] };
+      blocks.push(cur);
+    }
+  }
+  return blocks;
+}
+
+const ringStart = (r: RingSleepRecord) => r.start;
+const ringEnd = (r: RingSleepRecord) => r.start + r.durationMin * MINUTE_MS;
+
+export interface StageMinutes {
+  deep: number;
+  light: number;
+  rem: number;
+  awake: number;
+}
+
+/** One code per minute from start to end; minutes no record covers stay awake. */
+export function ringTimeline(start: number, end: number, records: readonly RingSleepRecord[]): Uint8Array {
+  const timeline = new Uint8Array(Math.max(0, Math.round((end - start) / MINUTE_MS)));
+  for (const rec of records) {
+    const offset = Math.round((rec.start - start) / MINUTE_MS);
+    const unit = Math.max(1, rec.unit);
+    for (let idx = 0; idx < rec.arr.length; idx++) {
+      const code = ringStageCode(Number(rec.arr[idx]));
+      const from = Math.max(0, offset + idx * unit);
+      const to = Math.min(timeline.length, offset + (idx + 1) * unit);
+      for (let pos = from; pos < to; pos++) timeline[pos] = code;
+    }
+  }
+  return timeline;
+}
+
+function countStages(timeline: Uint8Array): StageMinutes {
+  const counts = [0, 0, 0, 0];
+  for (let i = 0; i < timeline.length; i++) counts[timeline[i]]++;
+  return { deep: counts[STAGE_DEEP], light: counts[STAGE_LIGHT], rem: counts[STAGE_REM], awake: counts[STAGE_AWAKE] };
+}
+
+export interface SleepOverrideWindow {
+  bedTime: number;
+  wakeTime: number;
+}
+
+export interface SleepSession {
+  start: number;
+  end: number;
+  /** Ring records in the block; empty for a HealthKit-only session. */
+  records: RingSleepRecord[];
+  /** Per-minute stage codes (STAGE_*) from start; empty without ring data. */
+  timeline: Uint8Array;
+  stages: StageMinutes;
+  sessionType: SessionType;
+  reason: string;
+  sources: SleepSource[];
+  /** HealthKit in-bed start, when it's ≥45 min before the ring's first record. */
+  suggestedBedTime?: number;
+  override?: SleepOverrideWindow;
+}
+
+function ringSession(block: IntervalBlock<RingSleepRecord>, priorNightEnd: number | null): SleepSession {
+  const timeline = ringTimeline(block.start, block.end, block.items);
+  const stages = countStages(timeline);
+  const { sessionType, reason } = classifySleepSession(
+    new Date(block.start),
+    new Date(block.end),
+    stages.deep + stages.light + stages.rem,
+    priorNightEnd === null ? null : new Date(priorNightEnd),
+  );
+  return { start: block.start, end: block.end, records: block.items, timeline, stages, sessionType, reason, sources: ['ring'] };
+}
+
+function healthKitSession(block: IntervalBlock<{ start: number; end: number }>): SleepSession {
+  const { sessionType, reason } = classifySleepSession(
+    new Date(block.start),
+    new Date(block.end),
+    Math.round((block.end - block.start) / MINUTE_MS),
+  );
+  return {
+    start: block.start,
+    end: block.end,
+    records: [],
+    timeline: new Uint8Array(0),
+    stages: { deep: 0, light: 0, rem: 0, awake: 0 },
+    sessionType,
+    reason,
+    sources: ['healthkit'],
+  };
+}
+
+const overlaps = (aStart: number, aEnd: number, bStart: number, bEnd: number) => aStart < bEnd && bStart < aEnd;
+
+export class SleepSegmenter {
+  private records: RingSleepRecord[] = [];
+  private byStart = new Map<number, RingSleepRecord>();
+  /** One per ring block, sorted; disjoint, so their ends are sorted too. */
+  private ringSessions: SleepSession[] = [];
+  private dirtyFrom = Infinity;
+  private healthKit: IntervalBlock<{ start: number; end: number }>[] = [];
+  private override: SleepOverrideWindow | null = null;
+  private fused: SleepSession[] | null = null;
+  private fusedByBase = new WeakMap<SleepSession, SleepSession>();
+
+  /**
+   * Add raw getSleepData records. A record whose start is already known replaces the old
+   * one only if it's longer (a night first synced mid-sleep). Returns whether anything changed.
+   */
+  addRingRecords(raw: readonly any[]): boolean {
+    let last = this.records.length > 0 ? this.records[this.records.length - 1].start : -Infinity;
+    let sorted = true;
+    let replaced: Set<RingSleepRecord> | null = null;
+    let changed = false;
+    for (const rec of ringSleepRecords(raw)) {
+      const prev = this.byStart.get(rec.start);
+      if (prev) {
+        if (prev.durationMin >= rec.durationMin) continue;
+        (replaced ??= new Set()).add(prev);
+      }
+      this.byStart.set(rec.start, rec);
+      this.records.push(rec);
+      if (rec.start < last) sorted = false;
+      else last = rec.start;
+      if (rec.start < this.dirtyFrom) this.dirtyFrom = rec.start;
+      changed = true;
+    }
+    if (!changed) return false;
+    if (replaced) this.records = this.records.filter(r => !replaced!.has(r));
+    if (!sorted) this.records.sort((a, b) => a.start - b.start);
+    this.fused = null;
+    return true;
+  }
+
+  /** HealthKit sleep samples (any order); replaces the previous set. */
+  setHealthKit(samples: ReadonlyArray<{ start: number; end: number }>): void {
+    this.healthKit = mergeIntervals(
+      samples.filter(s => s.end > s.start),
+      s => s.start,
+      s => s.end,
+      HEALTHKIT_MERGE_GAP_MS,
+    );
+    this.fused = null;
+  }
+
+  setOverride(override: SleepOverrideWindow | null): void {
+    if (override?.bedTime === this.override?.bedTime && override?.wakeTime === this.override?.wakeTime) return;
+    this.override = override;
+    this.fused = null;
+  }
+
+  /** Every session, oldest first. Same array (and session objects) until an input changes. */
+  sessions(): readonly SleepSession[] {
+    this.resweep();
+    if (!this.fused) this.fused = this.fuse();
+    return this.fused;
+  }
+
+  /**
+   * The night the home screen shows: the latest-ending ring session of at least
+   * NIGHT_MIN_MS, otherwise the latest-ending ring session if it classifies as a night
+   * (short or disrupted night); null when the most recent sleep is a nap.
+   */
+  mainNight(): SleepSession | null {
+    let full: SleepSession | null = null;
+    let latest: SleepSession | null = null;
+    for (const s of this.sessions()) {
+      if (s.records.length === 0) continue;
+      if (!latest || s.end > latest.end) latest = s;
+      if (s.end - s.start >= NIGHT_MIN_MS && (!full || s.end > full.end)) full = s;
+    }
+    return full ?? (latest?.sessionType === 'night' ? latest : null);
+  }
+
+  /** The session covering `ms`, if any. */
+  sessionAt(ms: number): SleepSession | null {
+    return this.sessions().find(s => s.start <= ms && ms <= s.end) ?? null;
+  }
+
+  clear(): void {
+    this.records = [];
+    this.byStart.clear();
+    this.ringSessions = [];
+    this.dirtyFrom = Infinity;
+    this.healthKit = [];
+    this.override = null;
+    this.fused = null;
+  }
+
+  /** Drop whole sessions that ended more than RING_RETENTION_MS before the newest record. */
+  private prune(): void {
+    const cutoff = this.records[this.records.length - 1].start - RING_RETENTION_MS;
+    let drop = 0;
+    let dropRecords = 0;
+    while (drop < this.ringSessions.length && this.ringSessions[drop].end < cutoff) {
+      dropRecords += this.ringSessions[drop++].records.length;
+    }
+    if (drop === 0) return;
+    for (let i = 0; i < dropRecords; i++) this.byStart.delete(this.records[i].start);
+    this.records = this.records.slice(dropRecords);
+    this.ringSessions = this.ringSessions.slice(drop);
+  }
+
+  private resweep(): void {
+    if (this.dirtyFrom === Infinity) return;
+    // Sessions ending more than a merge gap before the first change can't absorb it
+    let lo = 0;
+    let hi = this.ringSessions.length;
+    while (lo < hi) {
+      const mid = (lo + hi) >> 1;
+      if (this.ringSessions[mid].end + RING_MERGE_GAP_MS < this.dirtyFrom) lo = mid + 1;
+      else hi = mid;
+    }
+    const kept = this.ringSessions.slice(0, lo);
+    let from = 0;
+    let priorNightEnd: number | null = null;
+    for (const s of kept) {
+      from += s.records.length;
+      if (s.sessionType === 'night') priorNightEnd = s.end;
+    }
+    for (const block of sweepSorted(this.records, from, ringStart, ringEnd, RING_MERGE_GAP_MS)) {
+      const session = ringSession(block, priorNightEnd);
+      if (session.sessionType === 'night') priorNightEnd = session.end;
+      kept.push(session);
+    }
+    this.ringSessions = kept;
+    this.dirtyFrom = Infinity;
+    this.prune();
+  }
+
+  private fuse(): SleepSession[] {
+    const out: SleepSession[] = [];
+    const hk = this.healthKit;
+    const usedHk = new Uint8Array(hk.length);
+    let h = 0;
+    for (const base of this.ringSessions) {
+      // Both lists are sorted; skip HealthKit blocks that end before this session
+      while (h < hk.length && hk[h].end <= base.start) h++;
+      let hkStart = Infinity;
+      for (let j = h; j < hk.length && hk[j].start < base.end; j++) {
+        hkStart = Math.min(hkStart, hk[j].start);
+        usedHk[j] = 1;
+      }
+      const suggestedBedTime = hkStart <= base.start - SUGGESTED_BEDTIME_MIN_GAP_MS ? hkStart : undefined;
+      const override = this.override && overlaps(this.override.bedTime, this.override.wakeTime, base.start, base.end)
+        ? this.override
+        : undefined;
+      out.push(this.fusedSession(base, hkStart < Infinity, suggestedBedTime, override));
+    }
+    for (let j = 0; j < hk.length; j++) {
+      if (!usedHk[j]) out.push(healthKitSession(hk[j]));
+    }
+    if (out.length > this.ringSessions.length) out.sort((a, b) => a.start - b.start);
+    return out;
+  }
+
+  private fusedSession(
+    base: SleepSession,
+    withHealthKit: boolean,
+    suggestedBedTime: number | undefined,
+    override: SleepOverrideWindow | undefined,
+  ): SleepSession {
+    if (!withHealthKit && !override) return base;
+    const prev = this.fusedByBase.get(base);
+    if (prev && prev.suggestedBedTime === suggestedBedTime && prev.override === override &&
+        prev.sources.includes('healthkit') === withHealthKit) {
+      return prev;
+    }
+    const sources: SleepSource[] = ['ring'];
+    if (withHealthKit) sources.push('healthkit');
+    if (override) sources.push('manual');
+    const fused = { ...base, sources, suggestedBedTime, override };
+    this.fusedByBase.set(base, fused);
+    return fused;
+  }
+}
+
+/** Sessions for a one-off batch of raw records, without touching the shared instance. */
+export function segmentRingSleep(raw: readonly any[]): readonly SleepSession[] {
+  const segmenter = new SleepSegmenter();
+  segmenter.addRingRecords(raw);
+  return segmenter.sessions();
+}
+
+export const sleepSegmenter = new SleepSegmenter();
@@ -0,0 +1,134 @@
+/**
+ * StravaRateLimiter — client-side token buckets matched to Strava's quota.
+ *
+ * Strava enforces two fixed windows per app: 100 read requests per 15 min
+ * (reset on the quarter hour) and 1000 per day (reset at 00:00 UTC). Each
+ * bucket holds what is left of its current window and refills completely
+ * when the window rolls over.
+ *
+ * Every response's rate-limit headers ("short,daily" limit + usage) are
+ * folded back in, so requests made outside this process still count, and a
+ * 429 empties the short bucket until its reset. State is persisted so an app
+ * relaunch mid-backlog does not start over from a full bucket.
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+
+const STORAGE_KEY = '@strava_rate_limit_v1';
+const SHORT_WINDOW_MS = 15 * 60 * 1000;
+const DAY_WINDOW_MS = 24 * 60 * 60 * 1000;
+
+interface Bucket {
+  limit: number;
+  used: number;
+  /** floor(now / windowMs) — a change means the window reset. */
+  windowId: number;
+}
+
+/** Parse a "short,daily" header pair, e.g. "100,1000". */
+function parsePair(raw: string | null): [number, number] | null {
+  if (!raw) return null;
+  const [a, b] = raw.split(',').map(v => Number(v.trim()));
+  return Number.isFinite(a) && Number.isFinite(b) ? [a, b] : null;
+}
+
+class StravaRateLimiter {
+  private short: Bucket = { limit: 100, used: 0, windowId: 0 };
+  private daily: Bucket = { limit: 1000, used: 0, windowId: 0 };
+  private loaded: Promise<void> | null = null;
+  private saving = false;
+  private dirty = false;
+
+  /**
+   * Reserve `n` requests in both windows, waiting for a reset if needed.
+   * Resolves false without reserving when the wait would exceed `maxWaitMs`.
+   */
+  async acquire(n: number, maxWaitMs: number): Promise<boolean> {
+    await this.load();
+    for (;;) {
+      const now = Date.now();
+      const wait = this.waitTimeMs(n, now);
+      if (wait === 0) {
+        this.short.used += n;
+        this.daily.used += n;
+        this.persist();
+        return true;
+      }
+      if (wait > maxWaitMs) return false;
+      await new Promise(r => setTimeout(r, wait));
+    }
+  }
+
+  /** ms until `n` more requests fit in both windows (0 = now). */
+  waitTimeMs(n: number, now = Date.now()): number {
+    this.roll(now);
+    let wait = 0;
+    if (this.daily.used + n > this.daily.limit) {
+      wait = (this.daily.windowId + 1) * DAY_WINDOW_MS - now;
+    } else if (this.short.used + n > this.short.limit) {
+      wait = (this.short.windowId + 1) * SHORT_WINDOW_MS - now;
+    }
+    // Small margin so we land after Strava's reset, not on it
+    return wait > 0 ? wait + 1000 : 0;
+  }
+
+  /** Fold a response's status + rate-limit headers into the buckets. */
+  observe(status: number, headers: Headers): void {
+    this.roll(Date.now());
+    // Read endpoints are governed by the read limit when Strava sends it
+    const limit = parsePair(headers.get('X-ReadRateLimit-Limit')) ?? parsePair(headers.get('X-RateLimit-Limit'));
+    const usage = parsePair(headers.get('X-ReadRateLimit-Usage')) ?? parsePair(headers.get('X-RateLimit-Usage'));
+    if (limit) {
+      this.short.limit = limit[0];
+      this.daily.limit = limit[1];
+    }
+    if (usage) {
+      // Local counts include requests still in flight, so never lower them
+      this.short.used = Math.max(this.short.used, usage[0]);
+      this.daily.used = Math.max(this.daily.used, usage[1]);
+    }
+    if (status === 429) {
+      this.short.used = Math.max(this.short.used, this.short.limit);
+      if (usage && usage[1] >= this.daily.limit) this.daily.used = this.daily.limit;
+    }
+    if (limit || usage || status === 429) this.persist();
+  }
+
+  private roll(now: number): void {
+    const shortId = Math.floor(now / SHORT_WINDOW_MS);
+    if (shortId !== this.short.windowId) this.short = { ...this.short, used: 0, windowId: shortId };
+    const dayId = Math.floor(now / DAY_WINDOW_MS);
+    if (dayId !== this.daily.windowId) this.daily = { ...this.daily, used: 0, windowId: dayId };
+  }
+
+  private load(): Promise<void> {
+    if (!this.loaded) {
+      this.loaded = AsyncStorage.getItem(STORAGE_KEY)
+        .then(raw => {
+          if (!raw) return;
+          const saved = JSON.parse(raw) as { short: Bucket; daily: Bucket };
+          // Anything used before this process started still counts against its window
+          this.short = { ...saved.short, used: Math.max(saved.short.used, this.short.used) };
+          this.daily = { ...saved.daily, used: Math.max(saved.daily.used, this.daily.used) };
+        })
+        .catch(() => {});
+    }
+    return this.loaded;
+  }
+
+  /** Coalesced write — at most one in flight, re-run if state changed meanwhile. */
+  private persist(): void {
+    this.dirty = true;
+    if (this.saving) return;
+    this.saving = true;
+    (async () => {
+      while (this.dirty) {
+        this.dirty = false;
+        await AsyncStorage.setItem(STORAGE_KEY, JSON.stringify({ short: this.short, daily: this.daily })).catch(() => {});
+      }
+      this.saving = false;
+    })();
+  }
+}
+
+export const stravaRateLimiter = new StravaRateLimiter();
@@ -2,6 +2,7 @@ import * as WebBrowser from 'expo-web-browser';
 import * as AuthSession from 'expo-auth-session';
 import { supabase } from './SupabaseService';
 import { reportError } from '../utils/sentry';
+import { stravaRateLimiter } from './StravaRateLimiter';
 import {
   StravaTokens,
   StravaTokenResponse,
@@ -20,6 +21,12 @@ const STRAVA_AUTH_URL = 'https://www.strava.com/oauth/authorize';
 const STRAVA_TOKEN_URL = 'https://www.strava.com/oauth/token';
 const STRAVA_API_URL = 'https://www.strava.com/api/v3';
 
+// Detail backfill: each activity costs 2 requests (detail + zones)
+const DETAIL_CONCURRENCY = 4;
+const DETAIL_WRITE_BATCH = 25;
+// Wait for a quota reset only if it is this close; otherwise stop and resume next sync
+const DETAIL_DEFAULT_MAX_WAIT_MS = 60 * 1000;
+
 // OAuth scopes we need
 const REQUIRED_SCOPES: StravaScope[] = [
   'read',
@@ -306,9 +313,14 @@ class StravaService {
   // ============================================
 
   private async apiRequest<T>(endpoint: string, options: RequestInit = {}): Promise<T | null> {
+    return (await this.apiFetch<T>(endpoint, options)).data;
+  }
+
+  /** Like apiRequest, but also returns the HTTP status (0 = no response) so callers can tell a 429 apart. */
+  private async apiFetch<T>(endpoint: string, options: RequestInit = {}): Promise<{ data: T | null; status: number }> {
     if (!(await this.ensureValidToken())) {
       console.error('Failed to ensure valid Strava token');
-      return null;
+      return { data: null, status: 0 };
     }
 
     try {
@@ -319,17 +331,18 @@ class StravaService {
           Authorization: `Bearer ${this._tokens!.access_token}`,
         },
       });
+      stravaRateLimiter.observe(response.status, response.headers);
 
       if (!response.ok) {
         console.error('Strava API error:', response.status, await response.text());
-        return null;
+        return { data: null, status: response.status };
       }
 
-      return await response.json();
+      return { data: await response.json(), status: response.status };
     } catch (e) {
       console.error('Strava API request failed:', e);
       reportError(e, { op: 'strava.apiRequest' });
-      return null;
+      return { data: null, status: 0 };
     }
   }
 
@@ -396,10 +409,21 @@ class StravaService {
     return { detail, zones };
   }
 
+  /**
+   * Backfill detail + HR zones for every activity without detail_fetched_at.
+   *
+   * Runs DETAIL_CONCURRENCY fetches at a time, gated by stravaRateLimiter, so
+   * throughput is bounded by Strava's quota rather than a fixed sleep. Rows are
+   * written in bulk upserts of DETAIL_WRITE_BATCH. The pending set is re-read
+   * from detail_fetched_at on every call, so a run that stops early (quota
+   * exhausted beyond `maxWaitMs`, app killed) resumes where it left off.
+   */
   async syncAllActivityDetails(
     userId: string,
-    onProgress?: (synced: number, total: number) => void
-  ): Promise<{ synced: number; failed: number }> {
+    onProgress?: (synced: number, total: number) => void,
+    options: { maxWaitMs?: number } = {},
+  ): Promise<{ synced: number; failed: number; remaining: number }> {
+    const maxWaitMs = options.maxWaitMs ?? DETAIL_DEFAULT_MAX_WAIT_MS;
     // Find activities without detail
     const { data: pending, error } = await supabase
       .from('strava_activities')
@@ -411,27 +435,59 @@ class StravaService {
     if (error) {
       console.error('[StravaService] syncAllActivityDetails: query error', error);
       reportError(error, { op: 'strava.syncDetails.query' });
-      return { synced: 0, failed: 0 };
+      return { synced: 0, failed: 0, remaining: 0 };
     }
     if (!pending || pending.length === 0) {
-      return { synced: 0, failed: 0 };
+      return { synced: 0, failed: 0, remaining: 0 };
     }
     let synced = 0;
     let failed = 0;
+    let processed = 0;
+    let next = 0;
+    let stopped = false;
     const total = pending.length;
+    const buffer: Record<string, unknown>[] = [];
 
-    for (let i = 0; i < pending.length; i++) {
-      const activityId = pending[i].id;
-      try {
-        const { detail, zones } = await this.getActivityDetail(activityId);
+    const flush = async () => {
+      const rows = buffer.splice(0);
+      if (rows.length === 0) return;
+      const { error: upsertError } = await supabase
+        .from('strava_activities')
+        .upsert(rows as any, { onConflict: 'id' });
+      if (upsertError) {
+        reportError(upsertError, { op: 'strava.syncDetails.upsert', rows: rows.length }, 'warning');
+        failed += rows.length;
+      } else {
+        synced += rows.length;
+      }
+    };
 
-        if (!detail) {
-          console.warn(`[StravaService] detail fetch failed for ${activityId}`);
-          failed++;
-        } else {
-          await supabase
-            .from('strava_activities')
-            .update({
+    const worker = async () => {
+      while (!stopped && next < total) {
+        if (!(await stravaRateLimiter.acquire(2, maxWaitMs))) {
+          stopped = true;
+          break;
+        }
+        if (stopped || next >= total) break;
+        const activityId = pending[next++].id;
+        try {
+          const [detailRes, zonesRes] = await Promise.all([
+            this.apiFetch<StravaActivityDetail>(`/activities/${activityId}`),
+            this.apiFetch<StravaHRZones>(`/activities/${activityId}/zones`),
+          ]);
+          const detail = detailRes.data;
+          if (detailRes.status === 429 || zonesRes.status === 429) {
+            // Quota hit mid-flight — leave it pending; the limiter now knows to wait
+            stopped = true;
+            break;
+          }
+          if (!detail) {
+            console.warn(`[StravaService] detail fetch failed for ${activityId}`);
+            failed++;
+          } else {
+            buffer.push({
+              id: activityId,
+              user_id: userId,
               suffer_score: detail.suffer_score ?? null,
               average_cadence: detail.average_cadence ?? null,
               average_speed: detail.average_speed ?? null,
@@ -439,28 +495,33 @@ class StravaService {
               pr_count: detail.pr_count ?? null,
               elev_high: detail.elev_high ?? null,
               elev_low: detail.elev_low ?? null,
-              zones_json: zones ?? null,
+              zones_json: zonesRes.data ?? null,
               splits_metric_json: detail.splits_metric ?? null,
               laps_json: detail.laps ?? null,
               best_efforts_json: detail.best_efforts ?? null,
               detail_fetched_at: new Date().toISOString(),
-            } as Record<string, unknown>)
-            .eq('id', activityId);
-          synced++;
+            });
+            if (buffer.length >= DETAIL_WRITE_BATCH) await flush();
+          }
+        } catch (e) {
+          reportError(e, { op: 'strava.fetchActivityDetail' }, 'warning');
+          failed++;
         }
-      } catch (e) {
-        reportError(e, { op: 'strava.fetchActivityDetail' }, 'warning');
-        failed++;
+        processed++;
+        onProgress?.(processed, total);
       }
+    };
 
-      onProgress?.(synced + failed, total);
-
-      // Rate-limit: 1 req-pair/sec to stay under Strava's 100/15min
-      if (i < pending.length - 1) {
-        await new Promise(r => setTimeout(r, 1000));
-      }
+    try {
+      await Promise.all(Array.from({ length: Math.min(DETAIL_CONCURRENCY, total) }, worker));
+    } finally {
+      await flush();
+    }
+    const remaining = total - processed;
+    if (remaining > 0) {
+      console.log(`[StravaService] detail sync paused on rate limit: ${remaining} left for next sync`);
     }
-    return { synced, failed };
+    return { synced, failed, remaining };
   }
 
   async syncActivitiesToSupabase(days: number = 60): Promise<{ success: boolean; count: number }> {
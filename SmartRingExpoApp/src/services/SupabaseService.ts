@@ -4,6 +4,7 @@ import { reportError } from '../utils/sentry';
 import AsyncStorage from '@react-native-async-storage/async-storage';
 import { AppState } from 'react-native';
 import { Database } from '../types/supabase.types';
+import { LogPipeline } from './LogPipeline';
 
 // Initialize Supabase client
 const supabaseUrl = process.env.EXPO_PUBLIC_SUPABASE_URL || 'https://pxuemdkxdjuwxtupeqoa.supabase.co';
@@ -21,11 +22,35 @@ export const supabase: SupabaseClient<Database> = createClient<Database>(supabas
   },
 });
 
+// Remote debug log: buffered in memory, one debug_logs insert per batch every 30 s.
+// level / source / at ride in payload so the table schema is unchanged; entries logged
+// while signed out are discarded (RLS only accepts the caller's own user_id).
+export const appLog = new LogPipeline(async (entries) => {
+  const sessionUserId = entries.some(e => !e.userId)
+    ? (await supabase.auth.getSession()).data.session?.user.id
+    : undefined;
+  const rows = entries.flatMap(e => {
+    const userId = e.userId ?? sessionUserId;
+    if (!userId) return [];
+    return [{
+      user_id: userId,
+      event: e.event,
+      payload: { ...e.payload, level: e.level, source: e.source, at: new Date(e.at).toISOString() },
+    }];
+  });
+  if (rows.length === 0) return;
+  const { error } = await supabase.from('debug_logs' as any).insert(rows);
+  if (error) throw error;
+});
+appLog.start();
+
 // Handle app state changes for token refresh (per Supabase docs)
 AppState.addEventListener('change', (state) => {
   if (state === 'active') {
     supabase.auth.startAutoRefresh();
   } else {
+    // Upload buffered logs while the app still has time to run
+    appLog.flush();
     supabase.auth.stopAutoRefresh();
   }
 });
@@ -100,7 +125,7 @@ class SupabaseService {
   async insertHeartRateReadings(readings: Omit<HeartRateReading, 'id' | 'created_at'>[]): Promise<boolean> {
     const { error } = await supabase
       .from('heart_rate_readings')
-      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: true });
+      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: false });
 
     if (error) {
       console.error('Error inserting heart rate readings:', error);
@@ -148,7 +173,7 @@ class SupabaseService {
   async insertStepsReadings(readings: Omit<StepsReading, 'id' | 'created_at'>[]): Promise<boolean> {
     const { error } = await supabase
       .from('steps_readings')
-      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: true });
+      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: false });
 
     if (error) {
       console.error('Error inserting steps readings:', error);
@@ -455,7 +480,7 @@ class SupabaseService {
   ): Promise<boolean> {
     const { error } = await supabase
       .from('spo2_readings')
-      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: true });
+      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: false });
     if (error) {
       console.error('Error inserting SpO2 readings:', error);
       reportError(error, { method: 'insertSpO2Readings', table: 'spo2_readings' });
@@ -492,7 +517,7 @@ class SupabaseService {
   ): Promise<boolean> {
     const { error } = await supabase
       .from('stress_readings')
-      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: true });
+      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: false });
     if (error) {
       console.error('Error inserting stress readings:', error);
       reportError(error, { method: 'insertStressReadings', table: 'stress_readings' });
@@ -506,7 +531,7 @@ class SupabaseService {
   ): Promise<boolean> {
     const { error } = await supabase
       .from('temperature_readings')
-      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: true });
+      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: false });
     if (error) {
       console.error('Error inserting temperature readings:', error);
       reportError(error, { method: 'insertTemperatureReadings', table: 'temperature_readings' });
@@ -530,7 +555,7 @@ class SupabaseService {
   ): Promise<boolean> {
     const { error } = await supabase
       .from('blood_pressure_readings')
-      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: true });
+      .upsert(readings, { onConflict: 'user_id,recorded_at', ignoreDuplicates: false });
     if (error) {
       console.error('Error inserting BP readings:', error);
       reportError(error, { method: 'insertBloodPressureReadings', table: 'blood_pressure_readings' });
@@ -755,9 +780,9 @@ class SupabaseService {
     }
   }
 
-  // Fire-and-forget remote debug log — never throws, never blocks sync
+  // Remote debug log — never throws, never blocks sync; uploaded in batches by appLog
   debugLog(userId: string, event: string, payload: Record<string, any>): void {
-    supabase.from('debug_logs' as any).insert({ user_id: userId, event, payload }).then();
+    appLog.log('info', 'sync', event, payload, userId);
   }
 }
 
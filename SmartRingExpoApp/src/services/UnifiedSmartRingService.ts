@@ -10,7 +10,16 @@ import { Platform } from 'react-native';
 import AsyncStorage from '@react-native-async-storage/async-storage';
 import JstyleService from './JstyleService';
 import V8Service from './V8Service';
+import { ActivityDetailStore, localDateKey } from './ActivityDetailStore';
+import { OvernightStore, type OvernightSyncResult } from './OvernightStore';
+import { RingStorageReclaimer } from './RingStorageReclaimer';
+import { WorkoutSession } from './WorkoutSession';
+import { RealtimeFrameDecoder } from './RealtimeFrameDecoder';
+import { DeviceConfigStore, type DeviceConfigField, type DeviceConfigTransport } from './DeviceConfigStore';
+import type { NativeLogBatch } from './LogPipeline';
+import { getHeartRateZone } from '../utils/ringData/heartRate';
 import { reportError, addBreadcrumb, setRingContext } from '../utils/sentry';
+import { parseRingDate } from '../utils/ringDate';
 import type {
   DeviceInfo,
   DeviceType,
@@ -29,16 +38,42 @@ import type {
   SportData,
   FeatureAvailability,
   RecoveryContributors,
+  NativeSyncStats,
+  NativeLogOptions,
 } from '../types/sdk.types';
+import type { DetailActivityWindow } from './ActivityDetailStore';
 
 export type SDKType = 'jstyle' | 'v8' | 'none';
 
+/** X3 automatic monitoring workMode the app writes for "on" (0 = off). */
+const AUTO_HR_WORK_MODE = 2;
+
 class UnifiedSmartRingService {
   private activeSDK: SDKType = 'none';
   private connectedSDKType: SDKType = 'none';
   private connectedDeviceType: DeviceType | null = null;
   private autoReconnectInFlight: Promise<{ success: boolean; message: string; deviceId?: string; deviceName?: string }> | null = null;
-  private syncClockInFlight: Promise<void> | null = null;
+  // Per-minute activity history; readers use its stored rollups without touching BLE
+  readonly activityDetail = new ActivityDetailStore(since => this.getDetailActivity(since), AsyncStorage);
+  // X3 per-minute overnight SpO2 + sleep/activity; summaries are read from storage
+  readonly overnight = new OvernightStore(
+    since => JstyleService.getContinuousSpO2(since),
+    since => JstyleService.getSleepWithActivity(since),
+    AsyncStorage,
+  );
+  // Clears ring history types once DataSyncService has them stored and acked
+  readonly reclaimer = new RingStorageReclaimer(type => this.deleteHistoryData(type), AsyncStorage);
+  // Live workout on the ring's activity mode; a session the app died in is recovered on reconnect
+  readonly workout = new WorkoutSession(
+    (activity, workMode, minutes) => this.controlActivityMode(activity, workMode, minutes),
+    onPacket => this.onActivityModeData(onPacket),
+    (hr, age) => getHeartRateZone(hr, age),
+    AsyncStorage,
+  );
+  // Ring settings (auto HR, profile, goal, clock): cached per device, only changed fields are written
+  readonly deviceConfig = new DeviceConfigStore(() => this.deviceConfigTransport(), AsyncStorage, {
+    liveDesired: () => ({ clockTz: Intl.DateTimeFormat().resolvedOptions().timeZone }),
+  });
 
   private async getPersistedSDKType(): Promise<SDKType> {
     try {
@@ -53,6 +88,9 @@ class UnifiedSmartRingService {
 
   constructor() {
     this.detectSDK();
+    // Fires once the ring accepts commands on every connect, including native background reconnects
+    JstyleService.onDeviceReady(() => { this.applyDeviceConfig(); });
+    V8Service.onDeviceReady(() => { this.applyDeviceConfig(); });
   }
 
   /**
@@ -376,7 +414,8 @@ class UnifiedSmartRingService {
               addBreadcrumb('ble', 'autoReconnect succeeded', { sdkType: 'jstyle' });
               if (result.deviceId) setRingContext(result.deviceId, 'jstyle');
               setTimeout(() => this.emitConnectionState('connected'), 50);
-              this.maybeSyncRingClock().catch(() => {});
+              this.applyDeviceConfig();
+              this.workout.recover().catch(e => reportError(e, { op: 'workout.recover' }, 'warning'));
               V8Service.forgetPairedDevice().catch(() => {});
               return result;
             }
@@ -405,6 +444,8 @@ class UnifiedSmartRingService {
                 addBreadcrumb('ble', 'autoReconnect succeeded', { sdkType: 'v8' });
                 if (result.deviceId) setRingContext(result.deviceId, 'v8');
                 setTimeout(() => this.emitConnectionState('connected'), 50);
+                this.applyDeviceConfig();
+                this.workout.recover().catch(e => reportError(e, { op: 'workout.recover' }, 'warning'));
                 JstyleService.forgetPairedDevice().catch(() => {});
                 return result;
               }
@@ -431,6 +472,15 @@ class UnifiedSmartRingService {
     return this.connectedSDKType === 'v8';
   }
 
+  // Telemetry only — never throws, null when the bridge doesn't export it
+  async getSyncStats(): Promise<NativeSyncStats | null> {
+    try {
+      return this.isV8() ? await V8Service.getSyncStats() : await JstyleService.getSyncStats();
+    } catch {
+      return null;
+    }
+  }
+
   // ========== Data Retrieval ==========
 
   async getSteps(): Promise<StepsData> {
@@ -504,9 +554,19 @@ class UnifiedSmartRingService {
       });
   }
 
+  // Raw 10-minute windows since a stored window's date string; ActivityDetailStore owns the cursor
+  async getDetailActivity(since: string | null): Promise<DetailActivityWindow[]> {
+    this.ensureConnected();
+    if (this.isV8()) return await V8Service.getDetailActivity(since);
+    return await JstyleService.getDetailActivity(since);
+  }
+
+  // Today's steps per hour (24 entries), after pulling any new windows from the ring
   async get24HourSteps(): Promise<number[]> {
     this.ensureConnected();
-    return [];
+    await this.activityDetail.sync();
+    const today = await this.activityDetail.getDay(localDateKey(new Date()));
+    return today ? today.hourlySteps : [];
   }
 
   async getHRVData(): Promise<HRVData> {
@@ -619,12 +679,22 @@ class UnifiedSmartRingService {
     };
   }
 
+  // Pull new overnight SpO2 / sleep+activity records (X3 only; V8 gets sleep+activity via getSleepByDay)
+  async syncOvernight(): Promise<OvernightSyncResult | null> {
+    this.ensureConnected();
+    if (this.isV8()) return null;
+    return await this.overnight.sync();
+  }
+
   async getRecoveryContributors(dayIndex: number = 0): Promise<RecoveryContributors> {
-    const [hrv, sleep, temp, spo2] = await Promise.all([
+    const wake = new Date();
+    wake.setDate(wake.getDate() - dayIndex);
+    const [hrv, sleep, temp, spo2, night] = await Promise.all([
       this.getHRVData().catch(() => ({} as HRVData)),
       this.getSleepByDay(dayIndex).catch(() => null),
       this.getTemperature().catch(() => ({ temperature: 0 } as TemperatureData)),
       this.getSpO2().catch(() => ({ spo2: 0 } as SpO2Data)),
+      this.overnight.getNight(localDateKey(wake)).catch(() => null),
     ]);
 
     const restingHr = Number((sleep as any)?.restingHR ?? 0);
@@ -637,7 +707,8 @@ class UnifiedSmartRingService {
       hrvBalance: hrv.sdnn && hrv.sdnn > 0 ? Math.max(0, Math.min(100, Math.round((hrv.sdnn / 80) * 100))) : null,
       restingHrDelta: restingHr > 0 ? restingHr - 60 : null,
       tempDeviation: temp.temperature && temp.temperature > 0 ? Number((temp.temperature - 36.5).toFixed(2)) : null,
-      overnightSpo2: spo2.spo2 && spo2.spo2 > 0 ? spo2.spo2 : null,
+      // Mean of the night's per-minute samples when ingested, else the latest spot reading
+      overnightSpo2: night?.spo2Avg ?? (spo2.spo2 && spo2.spo2 > 0 ? spo2.spo2 : null),
       sleepImpact: sleepTotal > 0 ? Math.max(0, Math.min(100, Math.round((sleepTotal / 480) * 100))) : null,
     };
   }
@@ -693,17 +764,18 @@ class UnifiedSmartRingService {
 
   async setProfile(profile: ProfileData): Promise<{ success: boolean }> {
     this.ensureConnected();
-    if (this.isV8()) return await V8Service.setProfile(profile);
-    return await JstyleService.setProfile(profile);
+    await this.deviceConfig.setDesired({ profile: { ...profile, stride: 70 } });
+    return await this.applyDeviceConfigField('profile');
   }
 
   async getProfile(): Promise<ProfileData> {
     this.ensureConnected();
-    // V8 doesn't support reading profile back — return defaults
-    if (this.isV8()) {
-      return { age: 25, height: 170, weight: 70, gender: 'male' };
-    }
-    const profile = await JstyleService.getProfile();
+    const { deviceMac } = await this.isConnected();
+    const cached = deviceMac ? (await this.deviceConfig.getActual(deviceMac)).profile : undefined;
+    const profile = cached
+      ?? (this.isV8() ? (await this.deviceConfig.getDesired()).profile : await JstyleService.getProfile())
+      // V8 doesn't support reading profile back — return defaults
+      ?? { age: 25, height: 170, weight: 70, gender: 'male' as const };
     return {
       age: profile.age,
       height: profile.height,
@@ -720,8 +792,8 @@ class UnifiedSmartRingService {
 
   async setGoal(goal: number): Promise<{ success: boolean }> {
     this.ensureConnected();
-    if (this.isV8()) return await V8Service.setGoal(goal);
-    return await JstyleService.setGoal(goal);
+    await this.deviceConfig.setDesired({ stepGoal: goal });
+    return await this.applyDeviceConfigField('stepGoal');
   }
 
   async setTimeFormat(is24Hour: boolean): Promise<{ success: boolean }> {
@@ -740,21 +812,73 @@ class UnifiedSmartRingService {
     return await JstyleService.getDeviceTime();
   }
 
-  async maybeSyncRingClock(): Promise<void> {
-    if (this.syncClockInFlight) return this.syncClockInFlight;
-    this.syncClockInFlight = (async () => {
-      const currentTz = Intl.DateTimeFormat().resolvedOptions().timeZone;
-      try {
-        const lastTz = await AsyncStorage.getItem('ring_clock_last_tz_v1');
-        if (lastTz === currentTz) return;
-        await JstyleService.setTime();
-        await AsyncStorage.setItem('ring_clock_last_tz_v1', currentTz);
-        addBreadcrumb('ble', 'ring clock synced', { tz: currentTz, prev: lastTz ?? 'none' });
-      } catch (e) {
-        reportError(e, { op: 'maybeSyncRingClock' });
+  /** Push changed settings to the connected ring; fire-and-forget, failures retry on the next connect. */
+  applyDeviceConfig(): void {
+    this.deviceConfig.apply().then(result => {
+      if (result.read.length || result.wrote.length) {
+        addBreadcrumb('ble', 'device config applied', { read: result.read.join(','), wrote: result.wrote.join(',') });
       }
-    })();
-    try { await this.syncClockInFlight; } finally { this.syncClockInFlight = null; }
+      for (const { field, error } of result.failed) {
+        reportError(new Error(error), { op: 'deviceConfig.apply', field }, 'warning');
+      }
+    }).catch(e => reportError(e, { op: 'deviceConfig.apply' }));
+  }
+
+  private async applyDeviceConfigField(field: DeviceConfigField): Promise<{ success: boolean }> {
+    const result = await this.deviceConfig.apply();
+    const failure = result.failed.find(f => f.field === field);
+    if (failure) throw new Error(failure.error);
+    return { success: true };
+  }
+
+  private async deviceConfigTransport(): Promise<DeviceConfigTransport | null> {
+    const status = await this.isConnected().catch(() => null);
+    if (!status?.connected || !status.deviceMac) return null;
+    if (this.isV8()) {
+      return {
+        deviceId: status.deviceMac,
+        read: { stepGoal: async () => (await V8Service.getGoal()).goal },
+        write: {
+          clockTz: () => V8Service.syncTime(),
+          profile: profile => V8Service.setProfile(profile),
+          stepGoal: goal => V8Service.setGoal(goal),
+        },
+      };
+    }
+    return {
+      deviceId: status.deviceMac,
+      read: {
+        autoHr: async () => {
+          const m = await JstyleService.getAutoMonitoring(1);
+          const workMode = Number(m.workMode);
+          // Another non-zero mode is a different schedule type; unknown makes the diff rewrite it
+          if (workMode !== 0 && workMode !== AUTO_HR_WORK_MODE) return null;
+          return {
+            enabled: workMode === AUTO_HR_WORK_MODE,
+            startTime: m.startTime,
+            endTime: m.endTime,
+            weeks: Number(m.weeks),
+            intervalMinutes: Number(m.intervalTime),
+          };
+        },
+        profile: () => JstyleService.getProfile(),
+        stepGoal: async () => (await JstyleService.getGoal()).goal,
+      },
+      readClock: async () => parseRingDate((await JstyleService.getDeviceTime()).time) ?? null,
+      write: {
+        clockTz: () => JstyleService.setTime(),
+        autoHr: config => JstyleService.setAutoMonitoring({
+          dataType: 1,
+          workMode: config.enabled ? AUTO_HR_WORK_MODE : 0,
+          startTime: config.startTime,
+          endTime: config.endTime,
+          weeks: config.weeks,
+          intervalTime: config.intervalMinutes,
+        }),
+        profile: profile => JstyleService.setProfile(profile),
+        stepGoal: goal => JstyleService.setGoal(goal),
+      },
+    };
   }
 
   // ========== Device ==========
@@ -762,10 +886,27 @@ class UnifiedSmartRingService {
   findDevice(): void {
   }
 
+  /** Start (1), pause (2), continue (3) or stop (4) the ring's activity mode; see workout. */
+  async controlActivityMode(activity: number, workMode: number, minutes: number): Promise<{ success: boolean }> {
+    this.ensureConnected();
+    if (this.isV8()) return await V8Service.controlActivityMode(activity, workMode, minutes);
+    return await JstyleService.controlActivityMode(activity, workMode, minutes);
+  }
+
+  /** Clear one history type on the ring; `type` is its fetch operation name. See reclaimer. */
+  async deleteHistoryData(type: string): Promise<{ success: boolean }> {
+    this.ensureConnected();
+    if (this.isV8()) return await V8Service.deleteHistoryData(type);
+    return await JstyleService.deleteHistoryData(type);
+  }
+
   async factoryReset(): Promise<{ success: boolean }> {
     this.ensureConnected();
-    if (this.isV8()) return await V8Service.factoryReset();
-    return await JstyleService.factoryReset();
+    const { deviceMac } = await this.isConnected();
+    const result = this.isV8() ? await V8Service.factoryReset() : await JstyleService.factoryReset();
+    // The ring is back to its defaults; read it again before diffing
+    if (result.success && deviceMac) await this.deviceConfig.invalidate(deviceMac);
+    return result;
   }
 
   // ========== Event Listeners ==========
@@ -848,6 +989,14 @@ class UnifiedSmartRingService {
     return () => unsubs.forEach(u => u());
   }
 
+  /** Raw activity-mode packets from whichever SDK is present; WorkoutSession parses them. */
+  onActivityModeData(callback: (packet: any) => void): () => void {
+    const unsubs: (() => void)[] = [];
+    if (JstyleService.isAvailable()) unsubs.push(JstyleService.onActivityModeData(callback));
+    if (V8Service.isAvailable()) unsubs.push(V8Service.onActivityModeData(callback));
+    return () => unsubs.forEach(u => u());
+  }
+
   onStepsReceived(callback: (data: StepsData) => void): () => void {
     const unsubs: (() => void)[] = [];
 
@@ -862,7 +1011,8 @@ class UnifiedSmartRingService {
       }));
     }
     if (V8Service.isAvailable()) {
-      unsubs.push(V8Service.onRealTimeData((data: any) => {
+      unsubs.push(V8Service.onRealTimeData((data: any, frame) => {
+        if (!RealtimeFrameDecoder.touches(frame, ['steps', 'calories', 'distance'])) return;
         callback({
           steps: Number(data.steps) || 0,
           distance: (Number(data.distance) || 0) * 1000,
@@ -910,6 +1060,14 @@ class UnifiedSmartRingService {
     return () => {};
   }
 
+  /** Native log batches from both bridges, tagged with the SDK that logged them. */
+  onNativeLog(callback: (batch: NativeLogBatch, source: 'jstyle' | 'v8') => void): () => void {
+    const unsubs: (() => void)[] = [];
+    if (JstyleService.isAvailable()) unsubs.push(JstyleService.onDebugLog(batch => callback(batch, 'jstyle')));
+    if (V8Service.isAvailable()) unsubs.push(V8Service.onDebugLog(batch => callback(batch, 'v8')));
+    return () => unsubs.forEach(u => u());
+  }
+
   onError(callback: (error: any) => void): () => void {
     const unsubs: (() => void)[] = [];
 
@@ -1073,6 +1231,26 @@ class UnifiedSmartRingService {
     await JstyleService.stopRealTimeData();
   }
 
+  /**
+   * Realtime event rate: 4 Hz with deltas (the default) for screens, 0 = every packet for
+   * recording. Stream counters (packets, frames, merged, unchanged) are in getSyncStats().realtime.
+   */
+  async configureRealTimeStream(rateHz: number, deltas = true): Promise<void> {
+    if (this.isV8()) {
+      await V8Service.configureRealTimeStream(rateHz, deltas);
+      return;
+    }
+    await JstyleService.configureRealTimeStream(rateHz, deltas);
+  }
+
+  /** Log level / sampling for both bridges (either may log: scanning runs on both SDKs). */
+  async configureNativeLogging(options: NativeLogOptions): Promise<void> {
+    await Promise.all([
+      JstyleService.isAvailable() ? JstyleService.configureLogging(options) : null,
+      V8Service.isAvailable() ? V8Service.configureLogging(options) : null,
+    ]);
+  }
+
   // ========== SDK-Specific Feature Access ==========
 
   getJstyleService() {
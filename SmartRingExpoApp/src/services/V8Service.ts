@@ -12,7 +12,8 @@
 
 import { NativeModules, NativeEventEmitter, Platform } from 'react-native';
 import { SportType } from '../types/sdk.types';
-import { reportError } from '../utils/sentry';
+import { reportError, withSpan } from '../utils/sentry';
+import { parseRingDate } from '../utils/ringDate';
 import type {
   DeviceInfo,
   StepsData,
@@ -26,7 +27,16 @@ import type {
   BluetoothState,
   SportData,
   SleepQualityRecord,
+  NativeFetchMetrics,
+  NativeSyncStats,
+  NativeLogOptions,
+  NativeLogStats,
 } from '../types/sdk.types';
+import type { DetailActivityWindow } from './ActivityDetailStore';
+import { RealtimeFrameDecoder, type RealtimeFrame } from './RealtimeFrameDecoder';
+import { decodeLogBatch, type NativeLogBatch } from './LogPipeline';
+import { NativeCallQueue, type NativeCallOptions } from './NativeCallQueue';
+import { v8HrvColumns, v8SpO2Columns, v8SportColumns, v8TemperatureColumns } from './SampleColumns';
 
 let V8Bridge: any = null;
 let eventEmitter: NativeEventEmitter | null = null;
@@ -81,7 +91,9 @@ async function cancelPendingNativeRequest(label: string): Promise<void> {
 }
 
 // Serialized native call queue (one-at-a-time)
-let callQueue: Promise<any> = Promise.resolve();
+const callQueue = new NativeCallQueue();
+// V8RealTimeData frames carry changed fields only; see RealtimeFrameDecoder
+const realtimeFrames = new RealtimeFrameDecoder();
 
 // Cache raw sleep records so the SDK is only called once per sync cycle
 let _sleepRecordsCache: any[] | null = null;
@@ -89,11 +101,12 @@ let _sleepRecordsCache: any[] | null = null;
 function enqueueNativeCall<T>(
   fn: () => Promise<T>,
   timeoutMs: number,
-  label: string
+  label: string,
+  options?: NativeCallOptions
 ): Promise<T> {
   const run = async (): Promise<T> => {
     try {
-      return await withNativeTimeout(fn(), timeoutMs, label);
+      return await withSpan('ble.native', label, () => withNativeTimeout(fn(), timeoutMs, label));
     } catch (error: any) {
       // On BUSY or timeout, clear the native pending resolver so subsequent calls work
       if (isBusyOrTimeout(error)) {
@@ -102,9 +115,7 @@ function enqueueNativeCall<T>(
       throw error;
     }
   };
-  const next = callQueue.then(run, run);
-  callQueue = next.catch(() => {});
-  return next;
+  return callQueue.run(run, options);
 }
 
 /**
@@ -182,14 +193,10 @@ function mergeV8SleepWindows(records: Array<{
 }
 
 /**
- * Parse V8 date string "YYYY.MM.dd HH:mm:ss" to timestamp
+ * Parse V8 date string "YYYY.MM.dd HH:mm:ss" (or with '-') to local epoch ms; 0 if invalid
  */
 function parseV8Date(dateStr: string): number {
-  if (!dateStr) return 0;
-  // Handle both "YYYY.MM.dd HH:mm:ss" and "YYYY-MM-dd HH:mm:ss"
-  const normalized = dateStr.replace(/\./g, '-');
-  const ts = new Date(normalized).getTime();
-  return isNaN(ts) ? 0 : ts;
+  return parseRingDate(dateStr) ?? 0;
 }
 
 /**
@@ -326,6 +333,13 @@ const V8Service = {
     }, 5000, 'getSteps');
   },
 
+  async getDetailActivity(since: string | null): Promise<DetailActivityWindow[]> {
+    return enqueueNativeCall(async () => {
+      const result = await V8Bridge.getDetailActivityData(since);
+      return result.data || [];
+    }, 30000, 'getDetailActivityData');
+  },
+
   async getSleepByDay(dayIndex: number = 0): Promise<SleepData> {
     return enqueueNativeCall(async () => {
       // Fetch once and cache — use getSleepWithActivity (type 81), merge overlapping windows
@@ -468,57 +482,66 @@ const V8Service = {
   async getHRVDataNormalized(): Promise<HRVData[]> {
     return enqueueNativeCall(async () => {
       const result = await V8Bridge.getHRVData();
-      const items: any[] = result.data || [];
-      return items.map((item: any) => ({
-        sdnn: Number(item.hrv) || undefined,
-        heartRate: Number(item.heartRate) || undefined,
-        stress: Number(item.stress) || undefined,
-        timestamp: parseV8Date(item.date) || undefined,
-      }));
+      const cols = v8HrvColumns(result.data || []);
+      const rows: HRVData[] = new Array(cols.length);
+      for (let i = 0; i < cols.length; i++) {
+        // NaN (missing) and 0 both map to undefined
+        rows[i] = {
+          sdnn: cols.sdnn[i] || undefined,
+          heartRate: cols.heartRate[i] || undefined,
+          stress: cols.stress[i] || undefined,
+          timestamp: cols.timestamp[i] || undefined,
+        };
+      }
+      return rows;
     }, 10000, 'getHRVData');
   },
 
   async getSpO2DataNormalized(): Promise<SpO2Data[]> {
     return enqueueNativeCall(async () => {
       const result = await V8Bridge.getAutoSpO2();
-      const items: any[] = result.data || [];
-      return items.map((item: any) => ({
-        spo2: Number(item.automaticSpo2Data) || 0,
-        timestamp: parseV8Date(item.date) || undefined,
-      }));
+      const cols = v8SpO2Columns(result.data || []);
+      const rows: SpO2Data[] = new Array(cols.length);
+      for (let i = 0; i < cols.length; i++) {
+        rows[i] = { spo2: cols.spo2[i] || 0, timestamp: cols.timestamp[i] || undefined };
+      }
+      return rows;
     }, 10000, 'getAutoSpO2');
   },
 
   async getTemperatureDataNormalized(): Promise<TemperatureData[]> {
     return enqueueNativeCall(async () => {
       const result = await V8Bridge.getTemperature();
-      const items: any[] = result.data || [];
-      return items.map((item: any) => ({
-        temperature: Number(item.temperature) || 0,
-        timestamp: parseV8Date(item.date) || undefined,
-      }));
+      const cols = v8TemperatureColumns(result.data || []);
+      const rows: TemperatureData[] = new Array(cols.length);
+      for (let i = 0; i < cols.length; i++) {
+        rows[i] = { temperature: cols.temperature[i] || 0, timestamp: cols.timestamp[i] || undefined };
+      }
+      return rows;
     }, 10000, 'getTemperature');
   },
 
   async getSportData(): Promise<SportData[]> {
     return enqueueNativeCall(async () => {
       const result = await V8Bridge.getActivityModeData();
-      const items: any[] = result.data || [];
-      const activityMode = Number(result.activityMode) || -1;
-      return items.map((item: any) => {
-        const startTime = parseV8Date(item.date);
-        const durationSec = Number(item.activeMinutes) || 0; // actually seconds despite name
-        return {
-          type: mapV8ActivityMode(activityMode),
+      const type = mapV8ActivityMode(Number(result.activityMode) || -1);
+      const cols = v8SportColumns(result.data || []);
+      const rows: SportData[] = new Array(cols.length);
+      for (let i = 0; i < cols.length; i++) {
+        const startTime = cols.startTime[i] || 0;
+        const durationSec = cols.durationSec[i] || 0;
+        rows[i] = {
+          type,
           startTime,
           endTime: startTime + durationSec * 1000,
           duration: durationSec,
-          steps: Number(item.step) || 0,
-          distance: (Number(item.distance) || 0) * 1000, // km -> m
-          calories: Number(item.calories) || 0,
-          heartRateAvg: Number(item.heartRate) || undefined,
+          steps: cols.steps[i] || 0,
+          distance: (cols.distanceKm[i] || 0) * 1000, // km -> m
+          calories: cols.calories[i] || 0,
+          heartRateAvg: cols.heartRate[i] || undefined,
         };
-      });
+      }
+      return rows;
     }, 10000, 'getActivityModeData');
   },
 
@@ -550,10 +573,27 @@ const V8Service = {
     return await V8Bridge.factoryReset();
   },
 
+  /** Clear one history type on the ring; see JstyleService.deleteHistoryData. */
+  async deleteHistoryData(operation: string): Promise<{ success: boolean }> {
+    if (!V8Bridge) return { success: false };
+    return enqueueNativeCall(() => V8Bridge.deleteHistoryData(operation), 5000, 'deleteHistoryData');
+  },
+
   async cancelPendingDataRequest(): Promise<void> {
     if (V8Bridge) await V8Bridge.cancelPendingDataRequest().catch((e: any) => reportError(e, { op: 'v8.cancelPendingDataRequest' }, 'warning'));
   },
 
+  async getFetchMetrics(): Promise<Record<string, NativeFetchMetrics>> {
+    if (!V8Bridge || typeof V8Bridge.getFetchMetrics !== 'function') return {};
+    return await V8Bridge.getFetchMetrics();
+  },
+
+  // Not queued: link + fetch telemetry, cumulative since launch or resetSyncStats
+  async getSyncStats(): Promise<NativeSyncStats | null> {
+    if (!V8Bridge || typeof V8Bridge.getSyncStats !== 'function') return null;
+    return await V8Bridge.getSyncStats();
+  },
+
   // ========== Real-Time Data Stream ==========
 
   async startRealTimeData(): Promise<{ success: boolean }> {
@@ -566,6 +606,43 @@ const V8Service = {
     return await V8Bridge.stopRealTimeData();
   },
 
+  /** See JstyleService.configureRealTimeStream. */
+  async configureRealTimeStream(rateHz: number, deltas = true): Promise<any> {
+    if (!V8Bridge || typeof V8Bridge.configureRealTimeStream !== 'function') return null;
+    return await V8Bridge.configureRealTimeStream(rateHz, deltas);
+  },
+
+  /** See JstyleService.configureLogging. */
+  async configureLogging(options: NativeLogOptions): Promise<NativeLogStats | null> {
+    if (!V8Bridge || typeof V8Bridge.configureLogging !== 'function') return null;
+    return await V8Bridge.configureLogging(options);
+  },
+
+  // ========== Activity Mode (live workout) ==========
+
+  /** Queued with priority; see JstyleService.controlActivityMode. */
+  async controlActivityMode(activityMode: number, workMode: number, minutes: number): Promise<{ success: boolean }> {
+    if (!V8Bridge) return { success: false };
+    return enqueueNativeCall(
+      () => V8Bridge.controlActivityMode(activityMode, workMode, minutes),
+      5000,
+      'controlActivityMode',
+      { priority: true }
+    );
+  },
+
+  onActivityModeData(callback: (data: any) => void): () => void {
+    if (!eventEmitter) return () => {};
+    const sub = eventEmitter.addListener('V8ActivityModeData', callback);
+    return () => sub.remove();
+  },
+
+  onDeviceReady(callback: (event: { deviceId: string }) => void): () => void {
+    if (!eventEmitter) return () => {};
+    const sub = eventEmitter.addListener('V8DeviceReady', callback);
+    return () => sub.remove();
+  },
+
   // ========== Manual Measurement ==========
 
   async startHeartRateMeasuring(): Promise<{ success: boolean }> {
@@ -658,9 +735,10 @@ const V8Service = {
     return () => sub.remove();
   },
 
-  onRealTimeData(callback: (data: any) => void): () => void {
+  /** Full realtime state per frame; `frame` holds just the fields that changed. */
+  onRealTimeData(callback: (data: any, frame: RealtimeFrame) => void): () => void {
     if (!eventEmitter) return () => {};
-    const sub = eventEmitter.addListener('V8RealTimeData', callback);
+    const sub = eventEmitter.addListener('V8RealTimeData', (frame: any) => callback(realtimeFrames.decode(frame), frame));
     return () => sub.remove();
   },
 
@@ -669,6 +747,13 @@ const V8Service = {
     const sub = eventEmitter.addListener('V8Error', callback);
     return () => sub.remove();
   },
+
+  /** Native log entries, delivered in batches (see ios/JstyleBridge/BleLogQueue). */
+  onDebugLog(callback: (batch: NativeLogBatch) => void): () => void {
+    if (!eventEmitter) return () => {};
+    const sub = eventEmitter.addListener('V8DebugLog', (event: any) => callback(decodeLogBatch(event.batch)));
+    return () => sub.remove();
+  },
 };
 
 export default V8Service;
@@ -0,0 +1,625 @@
+/**
+ * WorkoutSession — live workout mode on the ring's activity mode
+ *
+ * start/pause/resume/stop drive the ring's activity mode (startActivityMode
+ * with work mode 1-4); while it runs, the ring pushes an activity-mode packet
+ * about once a second carrying HR, session steps and calories.
+ * Each packet becomes one sample per elapsed second (a second packet in the
+ * same second overwrites it) in a fixed-capacity typed-array ring buffer, and
+ * running stats (avg / max HR, seconds per HR zone) are updated in O(1).
+ *
+ * UI listeners get a snapshot per sample, immediately when the previous one
+ * is older than minEmitIntervalMs and otherwise once at the end of that
+ * interval, so a 1 Hz stream reaches the screen with bridge latency only and
+ * a burst after a reconnect costs one render, not one per packet.
+ *
+ * Crash safety: samples are appended to storage in chunks every flushEvery
+ * samples (and on pause / stop) next to a small head record. recover() on the
+ * next launch either resumes a session whose planned duration has not run out
+ * or finalizes it as interrupted; at most flushEvery seconds are lost.
+ *
+ * No React Native imports: ring control, the packet subscription, the zone
+ * function and storage are injected.
+ */
+
+import type { ActivityDetailStorage } from './ActivityDetailStore';
+
+const HEAD_KEY = 'workout_v1_active';
+const CHUNK_PREFIX = 'workout_v1_chunk:';
+const SESSION_PREFIX = 'workout_v1:';
+const DAY_MS = 24 * 60 * 60 * 1000;
+
+/** WORKMODE_X3 / WORKMODE_V8 */
+export const WORK_MODE = { start: 1, pause: 2, resume: 3, stop: 4 } as const;
+/** ActivityModeData packet type (X3 and V8); 31-34 are the ring's control acks. */
+const ACTIVITY_MODE_DATA = 30;
+
+export type WorkoutState = 'idle' | 'active' | 'paused';
+
+export interface WorkoutSample {
+  t: number;       // epoch ms
+  hr: number;
+  steps: number;   // cumulative for the session
+  kcal: number;    // cumulative for the session
+}
+
+export interface WorkoutSnapshot {
+  state: WorkoutState;
+  id: string | null;
+  activity: number;
+  startedAt: number;
+  elapsedS: number;
+  hr: number;
+  zone: string | null;
+  steps: number;
+  kcal: number;
+  avgHr: number;
+  maxHr: number;
+  zoneSeconds: Record<string, number>;
+  samples: number;
+  /** Native packet timestamp → sample applied in JS, for the last sample. */
+  latencyMs: number | null;
+}
+
+export interface WorkoutSummary {
+  id: string;
+  activity: number;
+  startedAt: number;
+  endedAt: number;
+  activeS: number;
+  avgHr: number;
+  maxHr: number;
+  steps: number;
+  kcal: number;
+  zoneSeconds: Record<string, number>;
+  samples: number;
+  /** Finalized by recover() after the app died mid-session. */
+  interrupted: boolean;
+}
+
+export interface StoredWorkout {
+  summary: WorkoutSummary;
+  /** Per-sample series, t as ms offsets from startedAt, kcal in 0.1 kcal. */
+  t: number[];
+  hr: number[];
+  steps: number[];
+  kcal: number[];
+}
+
+export interface WorkoutStartOptions {
+  /** ACTIVITYMODE_X3 / ACTIVITYMODE_V8 sport (0 = run, 9 = walk, 10 = workout, ...). */
+  activity: number;
+  /** Planned duration; the ring counts down from it. */
+  minutes?: number;
+  age?: number;
+}
+
+export type ActivityModeControl = (activity: number, workMode: number, minutes: number) => Promise<unknown>;
+export type ActivityModeSubscribe = (onPacket: (packet: any) => void) => () => void;
+export type HeartRateZoneFn = (hr: number, age: number) => string;
+
+export interface WorkoutSessionOptions {
+  /** Samples kept in memory for live charts (one per second). */
+  capacity?: number;
+  flushEvery?: number;
+  minEmitIntervalMs?: number;
+  retentionDays?: number;
+  now?: () => number;
+}
+
+/** Fixed-capacity sample buffer; the oldest sample is overwritten when full. */
+export class SampleRing {
+  readonly capacity: number;
+  private readonly t: Float64Array;
+  private readonly hr: Uint8Array;
+  private readonly steps: Uint32Array;
+  private readonly kcal: Float32Array;
+  private head = 0;
+  size = 0;
+
+  constructor(capacity: number) {
+    this.capacity = capacity;
+    this.t = new Float64Array(capacity);
+    this.hr = new Uint8Array(capacity);
+    this.steps = new Uint32Array(capacity);
+    this.kcal = new Float32Array(capacity);
+  }
+
+  push(s: WorkoutSample): void {
+    this.write(this.head, s);
+    this.head = (this.head + 1) % this.capacity;
+    if (this.size < this.capacity) this.size++;
+  }
+
+  replaceLast(s: WorkoutSample): void {
+    this.write((this.head - 1 + this.capacity) % this.capacity, s);
+  }
+
+  /** i = 0 is the oldest retained sample. */
+  at(i: number): WorkoutSample {
+    const idx = (this.head - this.size + i + this.capacity) % this.capacity;
+    return { t: this.t[idx], hr: this.hr[idx], steps: this.steps[idx], kcal: this.kcal[idx] };
+  }
+
+  /** The newest `limit` samples, oldest first. */
+  toArray(limit: number = this.size): WorkoutSample[] {
+    const n = Math.min(limit, this.size);
+    const out: WorkoutSample[] = new Array(n);
+    for (let i = 0; i < n; i++) out[i] = this.at(this.size - n + i);
+    return out;
+  }
+
+  clear(): void {
+    this.head = 0;
+    this.size = 0;
+  }
+
+  private write(idx: number, s: WorkoutSample): void {
+    this.t[idx] = s.t;
+    this.hr[idx] = Math.min(255, Math.max(0, s.hr));
+    this.steps[idx] = s.steps;
+    this.kcal[idx] = s.kcal;
+  }
+}
+
+const num = (...values: unknown[]): number => {
+  for (const v of values) {
+    const n = Number(v);
+    if (v !== undefined && v !== null && Number.isFinite(n)) return n;
+  }
+  return 0;
+};
+
+/** Live fields of an activity-mode packet; null for control acks without samples. */
+export function parseActivityPacket(packet: any): { hr: number; steps: number; kcal: number } | null {
+  if (!packet) return null;
+  const hasSample = packet.heartRate !== undefined || packet.HeartRate !== undefined || packet.step !== undefined || packet.Step !== undefined;
+  if (!hasSample && Number(packet.packetType) !== ACTIVITY_MODE_DATA) return null;
+  return {
+    hr: num(packet.heartRate, packet.HeartRate, packet.hr),
+    steps: num(packet.step, packet.Step, packet.ActivityStep, packet.steps),
+    kcal: num(packet.calories, packet.Calories),
+  };
+}
+
+interface Head {
+  id: string;
+  activity: number;
+  minutes: number;
+  age: number;
+  startedAt: number;
+  state: WorkoutState;
+  pausedAt: number | null;
+  pausedMs: number;
+  chunks: number;
+  stats: Stats;
+}
+
+interface Stats {
+  samples: number;
+  hrSum: number;
+  hrN: number;
+  maxHr: number;
+  steps: number;
+  kcal: number;
+  elapsedS: number;
+  zoneSeconds: Record<string, number>;
+}
+
+interface Chunk {
+  t: number[];
+  hr: number[];
+  steps: number[];
+  kcal: number[];
+}
+
+const emptyStats = (): Stats => ({ samples: 0, hrSum: 0, hrN: 0, maxHr: 0, steps: 0, kcal: 0, elapsedS: 0, zoneSeconds: {} });
+
+export class WorkoutSession {
+  private readonly control: ActivityModeControl;
+  private readonly subscribePackets: ActivityModeSubscribe;
+  private readonly zoneOf: HeartRateZoneFn;
+  private readonly storage: ActivityDetailStorage;
+  private readonly flushEvery: number;
+  private readonly minEmitIntervalMs: number;
+  private readonly retentionDays: number;
+  private readonly now: () => number;
+
+  readonly buffer: SampleRing;
+  private head: Head | null = null;
+  private unsubscribe: (() => void) | null = null;
+  private unflushed = 0;
+  /** Chunks queued but not yet confirmed written, by storage key. */
+  private pendingChunks = new Map<string, Chunk>();
+  private writes: Promise<void> = Promise.resolve();
+  private lastSecond = -1;
+  private lastZone: string | null = null;
+  private latencyMs: number | null = null;
+
+  private readonly listeners = new Set<(s: WorkoutSnapshot) => void>();
+  private lastEmitAt = 0;
+  private emitTimer: ReturnType<typeof setTimeout> | null = null;
+
+  constructor(
+    control: ActivityModeControl,
+    subscribePackets: ActivityModeSubscribe,
+    zoneOf: HeartRateZoneFn,
+    storage: ActivityDetailStorage,
+    options: WorkoutSessionOptions = {},
+  ) {
+    this.control = control;
+    this.subscribePackets = subscribePackets;
+    this.zoneOf = zoneOf;
+    this.storage = storage;
+    this.buffer = new SampleRing(options.capacity ?? 3600);
+    this.flushEvery = Math.min(options.flushEvery ?? 10, this.buffer.capacity);
+    this.minEmitIntervalMs = options.minEmitIntervalMs ?? 250;
+    this.retentionDays = options.retentionDays ?? 90;
+    this.now = options.now ?? Date.now;
+  }
+
+  get state(): WorkoutState {
+    return this.head?.state ?? 'idle';
+  }
+
+  /** Listener gets the current snapshot right away, then one per (coalesced) sample. */
+  subscribe(listener: (s: WorkoutSnapshot) => void): () => void {
+    this.listeners.add(listener);
+    listener(this.snapshot());
+    return () => {
+      this.listeners.delete(listener);
+    };
+  }
+
+  snapshot(): WorkoutSnapshot {
+    const head = this.head;
+    const stats = head?.stats ?? emptyStats();
+    const last = this.buffer.size > 0 ? this.buffer.at(this.buffer.size - 1) : null;
+    return {
+      state: this.state,
+      id: head?.id ?? null,
+      activity: head?.activity ?? -1,
+      startedAt: head?.startedAt ?? 0,
+      elapsedS: stats.elapsedS,
+      hr: last?.hr ?? 0,
+      zone: this.lastZone,
+      steps: stats.steps,
+      kcal: stats.kcal,
+      avgHr: stats.hrN > 0 ? Math.round(stats.hrSum / stats.hrN) : 0,
+      maxHr: stats.maxHr,
+      zoneSeconds: { ...stats.zoneSeconds },
+      samples: stats.samples,
+      latencyMs: this.latencyMs,
+    };
+  }
+
+  async start(options: WorkoutStartOptions): Promise<WorkoutSnapshot> {
+    if (this.head) throw new Error(`Workout already ${this.head.state}`);
+    // A session the app died in is finalized before the ring is told to start another
+    await this.recover();
+    if (this.head) throw new Error('Workout resumed from a previous launch');
+
+    const minutes = options.minutes ?? 60;
+    await this.control(options.activity, WORK_MODE.start, minutes);
+    const startedAt = this.now();
+    this.head = {
+      id: String(startedAt),
+      activity: options.activity,
+      minutes,
+      age: options.age ?? 30,
+      startedAt,
+      state: 'active',
+      pausedAt: null,
+      pausedMs: 0,
+      chunks: 0,
+      stats: emptyStats(),
+    };
+    this.resetLive();
+    this.attach();
+    await this.flush();
+    this.emit(true);
+    return this.snapshot();
+  }
+
+  async pause(): Promise<void> {
+    const head = this.head;
+    if (!head || head.state !== 'active') return;
+    await this.control(head.activity, WORK_MODE.pause, head.minutes);
+    head.state = 'paused';
+    head.pausedAt = this.now();
+    await this.flush();
+    this.emit(true);
+  }
+
+  async resume(): Promise<void> {
+    const head = this.head;
+    if (!head || head.state !== 'paused') return;
+    await this.control(head.activity, WORK_MODE.resume, head.minutes);
+    head.pausedMs += this.now() - (head.pausedAt ?? this.now());
+    head.pausedAt = null;
+    head.state = 'active';
+    await this.flush();
+    this.emit(true);
+  }
+
+  /** Stop the ring's activity mode and store the session; null when nothing was running. */
+  async stop(): Promise<WorkoutSummary | null> {
+    const head = this.head;
+    if (!head) return null;
+    try {
+      await this.control(head.activity, WORK_MODE.stop, head.minutes);
+    } catch {
+      // The session is still finalized; the ring leaves activity mode when its timer runs out
+    }
+    return this.finalize(false);
+  }
+
+  /**
+   * Pick up a session persisted by a previous launch. Resumes it when its planned
+   * duration has not elapsed yet, otherwise stores it as interrupted and returns that.
+   */
+  async recover(): Promise<{ resumed: boolean; summary: WorkoutSummary | null }> {
+    if (this.head) return { resumed: true, summary: null };
+    const raw = await this.storage.getItem(HEAD_KEY);
+    if (!raw) return { resumed: false, summary: null };
+    let head: Head;
+    try {
+      head = JSON.parse(raw);
+    } catch {
+      await this.storage.multiRemove([HEAD_KEY]);
+      return { resumed: false, summary: null };
+    }
+    this.head = head;
+    this.resetLive();
+
+    const plannedEnd = head.startedAt + head.pausedMs + head.minutes * 60_000;
+    if (this.now() < plannedEnd) {
+      const chunks = await this.loadChunks(head);
+      for (const c of chunks) {
+        for (let i = 0; i < c.t.length; i++) {
+          this.buffer.push({ t: head.startedAt + c.t[i], hr: c.hr[i], steps: c.steps[i], kcal: c.kcal[i] / 10 });
+        }
+      }
+      const last = this.buffer.size > 0 ? this.buffer.at(this.buffer.size - 1) : null;
+      if (last) {
+        this.lastSecond = Math.floor((last.t - head.startedAt) / 1000);
+        this.lastZone = last.hr > 0 ? this.zoneOf(last.hr, head.age) : null;
+      }
+      this.attach();
+      this.emit(true);
+      return { resumed: true, summary: null };
+    }
+    return { resumed: false, summary: await this.finalize(true) };
+  }
+
+  /** Newest first. */
+  async listSessions(): Promise<WorkoutSummary[]> {
+    const keys = (await this.storage.getAllKeys()).filter(k => k.startsWith(SESSION_PREFIX));
+    const rows = await this.storage.multiGet(keys);
+    const out: WorkoutSummary[] = [];
+    for (const [, raw] of rows) {
+      if (!raw) continue;
+      try {
+        out.push((JSON.parse(raw) as StoredWorkout).summary);
+      } catch {
+        // Corrupt entry: skipped
+      }
+    }
+    return out.sort((a, b) => b.startedAt - a.startedAt);
+  }
+
+  async getSession(id: string): Promise<StoredWorkout | null> {
+    const raw = await this.storage.getItem(SESSION_PREFIX + id);
+    if (!raw) return null;
+    try {
+      return JSON.parse(raw) as StoredWorkout;
+    } catch {
+      return null;
+    }
+  }
+
+  /** Apply one activity-mode packet (the subscription calls this). */
+  ingest(packet: any): void {
+    const head = this.head;
+    if (!head || head.state !== 'active') return;
+    const live = parseActivityPacket(packet);
+    if (!live) return;
+
+    const at = this.now();
+    const stats = head.stats;
+    // Wall clock, not the packet's time field: firmware reports the countdown on some models
+    const elapsedS = Math.floor((at - head.startedAt - head.pausedMs) / 1000);
+    const second = Math.floor((at - head.startedAt) / 1000);
+    const sample: WorkoutSample = {
+      t: at,
+      hr: live.hr,
+      steps: Math.max(stats.steps, live.steps),
+      kcal: Math.max(stats.kcal, live.kcal),
+    };
+    const zone = sample.hr > 0 ? this.zoneOf(sample.hr, head.age) : null;
+
+    if (second === this.lastSecond && this.buffer.size > 0) {
+      // Same second: the newer packet wins unless the sample is already on disk
+      if (this.unflushed === 0) return;
+      const prev = this.buffer.at(this.buffer.size - 1);
+      if (prev.hr > 0) {
+        stats.hrSum -= prev.hr;
+        stats.hrN--;
+      }
+      if (this.lastZone) stats.zoneSeconds[this.lastZone]--;
+      this.buffer.replaceLast(sample);
+    } else {
+      this.buffer.push(sample);
+      stats.samples++;
+      this.unflushed++;
+    }
+    this.lastSecond = second;
+    this.lastZone = zone;
+
+    if (sample.hr > 0) {
+      stats.hrSum += sample.hr;
+      stats.hrN++;
+      if (sample.hr > stats.maxHr) stats.maxHr = sample.hr;
+    }
+    if (zone) stats.zoneSeconds[zone] = (stats.zoneSeconds[zone] ?? 0) + 1;
+    stats.steps = sample.steps;
+    stats.kcal = sample.kcal;
+    stats.elapsedS = elapsedS;
+    const sentAt = Number(packet.timestamp);
+    this.latencyMs = Number.isFinite(sentAt) && sentAt > 0 ? Math.max(0, at - sentAt) : null;
+
+    if (this.unflushed >= this.flushEvery) {
+      void this.flush();
+    }
+    this.emit(false);
+  }
+
+  private attach(): void {
+    this.unsubscribe?.();
+    this.unsubscribe = this.subscribePackets(packet => this.ingest(packet));
+  }
+
+  private resetLive(): void {
+    this.buffer.clear();
+    this.unflushed = 0;
+    this.pendingChunks = new Map();
+    this.lastSecond = -1;
+    this.lastZone = null;
+    this.latencyMs = null;
+  }
+
+  /**
+   * Cut the unflushed tail into a chunk and write it, with any earlier chunk whose write
+   * failed, plus the head as of now. Writes are serialized.
+   */
+  private flush(): Promise<void> {
+    const head = this.head;
+    if (!head) return this.writes;
+    if (this.unflushed > 0) {
+      const chunk: Chunk = { t: [], hr: [], steps: [], kcal: [] };
+      for (const s of this.buffer.toArray(this.unflushed)) {
+        chunk.t.push(s.t - head.startedAt);
+        chunk.hr.push(s.hr);
+        chunk.steps.push(s.steps);
+        chunk.kcal.push(Math.round(s.kcal * 10));
+      }
+      this.pendingChunks.set(`${CHUNK_PREFIX}${head.id}:${head.chunks}`, chunk);
+      head.chunks++;
+      this.unflushed = 0;
+    }
+    // Serialized now so the head's stats match the chunks written with it
+    const pairs: [string, string][] = [...this.pendingChunks].map(([key, c]) => [key, JSON.stringify(c)]);
+    pairs.push([HEAD_KEY, JSON.stringify(head)]);
+    this.writes = this.writes.then(async () => {
+      if (this.head !== head) return;
+      try {
+        await this.storage.multiSet(pairs);
+        for (const [key] of pairs) this.pendingChunks.delete(key);
+      } catch {
+        // Chunks stay queued; the next flush retries them
+      }
+    });
+    return this.writes;
+  }
+
+  private async loadChunks(head: Head): Promise<Chunk[]> {
+    const keys: string[] = [];
+    for (let i = 0; i < head.chunks; i++) keys.push(`${CHUNK_PREFIX}${head.id}:${i}`);
+    const rows = await this.storage.multiGet(keys);
+    const out: Chunk[] = [];
+    for (const [key, raw] of rows) {
+      const queued = this.pendingChunks.get(key);
+      if (queued) {
+        out.push(queued);
+        continue;
+      }
+      if (!raw) continue;
+      try {
+        out.push(JSON.parse(raw));
+      } catch {
+        // Corrupt chunk: those seconds are lost, the rest of the session is kept
+      }
+    }
+    return out;
+  }
+
+  private async finalize(interrupted: boolean): Promise<WorkoutSummary> {
+    const head = this.head!;
+    this.unsubscribe?.();
+    this.unsubscribe = null;
+    await this.flush();
+    // Chunks still queued after a failed write go into the stored session directly
+    const chunks = await this.loadChunks(head);
+
+    // An interrupted session ends at its last stored sample
+    const lastT = chunks.length > 0 ? chunks[chunks.length - 1].t[chunks[chunks.length - 1].t.length - 1] : undefined;
+    const endedAt = interrupted ? head.startedAt + (lastT ?? 0) : this.now();
+    const pausedMs = head.pausedMs + (head.state === 'paused' && head.pausedAt ? Math.max(0, endedAt - head.pausedAt) : 0);
+    const stats = head.stats;
+    const summary: WorkoutSummary = {
+      id: head.id,
+      activity: head.activity,
+      startedAt: head.startedAt,
+      endedAt,
+      activeS: Math.max(stats.elapsedS, Math.round((endedAt - head.startedAt - pausedMs) / 1000)),
+      avgHr: stats.hrN > 0 ? Math.round(stats.hrSum / stats.hrN) : 0,
+      maxHr: stats.maxHr,
+      steps: stats.steps,
+      kcal: Math.round(stats.kcal * 10) / 10,
+      zoneSeconds: { ...stats.zoneSeconds },
+      samples: stats.samples,
+      interrupted,
+    };
+
+    const stored: StoredWorkout = { summary, t: [], hr: [], steps: [], kcal: [] };
+    for (const c of chunks) {
+      stored.t.push(...c.t);
+      stored.hr.push(...c.hr);
+      stored.steps.push(...c.steps);
+      stored.kcal.push(...c.kcal);
+    }
+    const chunkKeys: string[] = [];
+    for (let i = 0; i < head.chunks; i++) chunkKeys.push(`${CHUNK_PREFIX}${head.id}:${i}`);
+
+    // Session first, so a crash in between leaves the chunks (recoverable), never neither
+    await this.storage.setItem(SESSION_PREFIX + head.id, JSON.stringify(stored));
+    await this.storage.multiRemove([...chunkKeys, HEAD_KEY]);
+    await this.prune();
+
+    this.head = null;
+    this.emit(true);
+    return summary;
+  }
+
+  private async prune(): Promise<void> {
+    const cutoff = this.now() - this.retentionDays * DAY_MS;
+    const stale = (await this.storage.getAllKeys()).filter(k => {
+      if (k.startsWith(SESSION_PREFIX)) return Number(k.slice(SESSION_PREFIX.length)) < cutoff;
+      // Orphaned chunks (a session finalized while a write was in flight)
+      if (k.startsWith(CHUNK_PREFIX)) return true;
+      return false;
+    });
+    if (stale.length > 0) await this.storage.multiRemove(stale);
+  }
+
+  private emit(force: boolean): void {
+    if (this.listeners.size === 0) return;
+    const at = this.now();
+    if (force || at - this.lastEmitAt >= this.minEmitIntervalMs) {
+      if (this.emitTimer) {
+        clearTimeout(this.emitTimer);
+        this.emitTimer = null;
+      }
+      this.lastEmitAt = at;
+      const snap = this.snapshot();
+      this.listeners.forEach(l => l(snap));
+      return;
+    }
+    if (!this.emitTimer) {
+      this.emitTimer = setTimeout(() => {
+        this.emitTimer = null;
+        this.emit(true);
+      }, this.minEmitIntervalMs - (at - this.lastEmitAt));
+    }
+  }
+}
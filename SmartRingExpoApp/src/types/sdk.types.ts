@@ -232,6 +232,107 @@ export interface DaySummary {
   caloriesTotal?: number;
 }
 
+// Native log2 latency histogram (BleLatencyHistogram); bucket i counts samples < 2^(i+4) ms
+export interface NativeLatencyHistogram {
+  count: number;
+  sumMs: number;
+  avgMs: number;
+  maxMs: number;
+  p50Ms: number;
+  p90Ms: number;
+  buckets: number[];
+}
+
+// Native paged-history fetch counters, keyed by type name ("Sleep", "HR", ...)
+export interface NativeFetchMetrics {
+  fetches: number;
+  completed: number;
+  pages: number;
+  records: number;
+  bytes: number;
+  lastMs: number;
+  avgMs: number;
+  maxMs: number;
+  idleEnds: number;
+  timeouts: number;
+  cancels: number;
+  errors: number;
+  disconnects: number;
+  // Native engine only (the ring simulator doesn't keep histograms)
+  ttfbMs?: NativeLatencyHistogram;
+  durationMs?: NativeLatencyHistogram;
+}
+
+// Process-wide BLE link counters from NewBle (shared by both bridges)
+export interface NativeLinkStats {
+  connects: number;
+  connectFailures: number;
+  disconnects: number;
+  unexpectedDisconnects: number;
+  reconnects: number;
+  /** App relaunches by CoreBluetooth state restoration */
+  restores?: number;
+  bytesIn: number;
+  packetsIn: number;
+  bytesOut: number;
+  packetsOut: number;
+  parseAvgMs: number;
+  parseMaxMs: number;
+  connectMs: NativeLatencyHistogram;
+  discoveryMs: NativeLatencyHistogram;
+  /** Unexpected disconnect → link usable again (services discovered) */
+  recoveryMs?: NativeLatencyHistogram;
+}
+
+export interface NativeReconnectState {
+  state: 'idle' | 'connecting' | 'connected' | 'waiting' | 'paused';
+  failures: number;
+  targetId: string | null;
+}
+
+// Realtime coalescer counters (BleRealtimeCoalescer): packets in vs frames sent over the bridge
+export interface NativeRealtimeStats {
+  rateHz: number;
+  deltas: boolean;
+  packets: number;
+  frames: number;
+  keyframes: number;
+  /** Packets folded into a frame another packet opened */
+  merged: number;
+  /** Frames not sent because no field changed */
+  unchanged: number;
+  fieldsIn: number;
+  fieldsOut: number;
+}
+
+export type NativeLogLevelName = 'debug' | 'info' | 'warn' | 'error' | 'off';
+
+export interface NativeLogOptions {
+  level?: NativeLogLevelName;
+  /** Keep one entry in n per level; 0 or 1 keeps all. */
+  sample?: Partial<Record<Exclude<NativeLogLevelName, 'off'>, number>>;
+  flushIntervalMs?: number;
+}
+
+export interface NativeLogStats {
+  level: NativeLogLevelName;
+  appended: number;
+  /** Lost to a full native ring */
+  dropped: number;
+  sampledOut: number;
+  drained: number;
+  batches: number;
+}
+
+export interface NativeSyncStats {
+  link: NativeLinkStats;
+  fetch: Record<string, NativeFetchMetrics>;
+  realtime?: NativeRealtimeStats;
+  log?: NativeLogStats;
+  watchdogFires: number;
+  reconnect?: NativeReconnectState;
+}
+
 // Event types for the SDK
 export interface SDKEvents {
   onConnectionStateChanged: (state: ConnectionState) => void;
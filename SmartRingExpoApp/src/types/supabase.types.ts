@@ -148,6 +148,7 @@ export interface Database {
           recorded_at: string;
           source: string;
           created_at: string;
+          updated_at: string;
         };
         Insert: {
           id?: string;
@@ -158,6 +159,7 @@ export interface Database {
           recorded_at: string;
           source?: string;
           created_at?: string;
+          updated_at?: string;
         };
         Update: {
           id?: string;
@@ -168,6 +170,7 @@ export interface Database {
           recorded_at?: string;
           source?: string;
           created_at?: string;
+          updated_at?: string;
         };
       };
       steps_readings: {
@@ -217,6 +220,7 @@ export interface Database {
           session_type: string | null;
           nap_score: number | null;
           created_at: string;
+          updated_at: string;
         };
         Insert: {
           id?: string;
@@ -232,6 +236,7 @@ export interface Database {
           session_type?: string | null;
           nap_score?: number | null;
           created_at?: string;
+          updated_at?: string;
         };
         Update: {
           id?: string;
@@ -247,6 +252,7 @@ export interface Database {
           session_type?: string | null;
           nap_score?: number | null;
           created_at?: string;
+          updated_at?: string;
         };
       };
       spo2_readings: {
@@ -256,6 +262,7 @@ export interface Database {
           spo2: number;
           recorded_at: string;
           created_at: string;
+          updated_at: string;
         };
         Insert: {
           id?: string;
@@ -263,6 +270,7 @@ export interface Database {
           spo2: number;
           recorded_at: string;
           created_at?: string;
+          updated_at?: string;
         };
         Update: {
           id?: string;
@@ -270,6 +278,7 @@ export interface Database {
           spo2?: number;
           recorded_at?: string;
           created_at?: string;
+          updated_at?: string;
         };
       };
       hrv_readings: {
@@ -284,6 +293,7 @@ export interface Database {
           lf_hf_ratio: number | null;
           recorded_at: string;
           created_at: string;
+          updated_at: string;
         };
         Insert: {
           id?: string;
@@ -296,6 +306,7 @@ export interface Database {
           lf_hf_ratio?: number | null;
           recorded_at: string;
           created_at?: string;
+          updated_at?: string;
         };
         Update: {
           id?: string;
@@ -308,6 +319,7 @@ export interface Database {
           lf_hf_ratio?: number | null;
           recorded_at?: string;
           created_at?: string;
+          updated_at?: string;
         };
       };
       stress_readings: {
@@ -340,6 +352,7 @@ export interface Database {
           temperature_c: number;
           recorded_at: string;
           created_at: string;
+          updated_at: string;
         };
         Insert: {
           id?: string;
@@ -347,6 +360,7 @@ export interface Database {
           temperature_c: number;
           recorded_at: string;
           created_at?: string;
+          updated_at?: string;
         };
         Update: {
           id?: string;
@@ -354,6 +368,7 @@ export interface Database {
           temperature_c?: number;
           recorded_at?: string;
           created_at?: string;
+          updated_at?: string;
         };
       };
       strava_activities: {
@@ -0,0 +1,63 @@
+/**
+ * Per-sync deltas of the native BLE telemetry (getSyncStats).
+ *
+ * The native counters are cumulative since launch (or resetSyncStats), so a
+ * sync snapshots them before and after and reports the difference. The flat
+ * attribute map is what goes onto the Sentry `ble.sync` span: link bytes and
+ * packets, reconnects, restores and watchdog fires for the radio; parse time for the
+ * vendor SDK; per-type pages, records, time-to-first-byte and native duration.
+ * Comparing native duration with the JS `ble.native` spans separates bridge /
+ * JS overhead from time spent on the air.
+ */
+
+import type { NativeFetchMetrics, NativeLatencyHistogram, NativeSyncStats } from '../types/sdk.types';
+
+export type SyncSpanAttributes = Record<string, number>;
+
+const avgDelta = (before: NativeLatencyHistogram | undefined, after: NativeLatencyHistogram | undefined) => {
+  if (!after) return 0;
+  const count = after.count - (before?.count ?? 0);
+  return count > 0 ? Math.round((after.sumMs - (before?.sumMs ?? 0)) / count) : 0;
+};
+
+/** "Single HR" → "single_hr" */
+const attrKey = (name: string) => name.toLowerCase().replace(/[^a-z0-9]+/g, '_');
+
+/**
+ * Flatten the change between two getSyncStats snapshots into span attributes.
+ * Types with no fetch in between are omitted. `before` may be null when the
+ * first snapshot failed; the whole `after` is reported then.
+ */
+export function syncStatsDelta(before: NativeSyncStats | null, after: NativeSyncStats): SyncSpanAttributes {
+  const a = after.link;
+  const b = before?.link;
+  const out: SyncSpanAttributes = {
+    'ble.bytes_in': a.bytesIn - (b?.bytesIn ?? 0),
+    'ble.packets_in': a.packetsIn - (b?.packetsIn ?? 0),
+    'ble.bytes_out': a.bytesOut - (b?.bytesOut ?? 0),
+    'ble.packets_out': a.packetsOut - (b?.packetsOut ?? 0),
+    'ble.reconnects': a.reconnects - (b?.reconnects ?? 0),
+    'ble.restores': (a.restores ?? 0) - (b?.restores ?? 0),
+    'ble.unexpected_disconnects': a.unexpectedDisconnects - (b?.unexpectedDisconnects ?? 0),
+    'ble.watchdog_fires': after.watchdogFires - (before?.watchdogFires ?? 0),
+    // Cumulative, not per-sync: connection setup happens outside the sync window
+    'ble.connect_p50_ms': a.connectMs.p50Ms,
+    'ble.discovery_p50_ms': a.discoveryMs.p50Ms,
+    'ble.recovery_p50_ms': a.recoveryMs?.p50Ms ?? 0,
+    'ble.parse_avg_ms': a.parseAvgMs,
+  };
+
+  for (const [name, m] of Object.entries(after.fetch)) {
+    const prev: NativeFetchMetrics | undefined = before?.fetch[name];
+    const fetches = m.fetches - (prev?.fetches ?? 0);
+    if (fetches <= 0) continue;
+    const key = `ble.${attrKey(name)}`;
+    out[`${key}.pages`] = m.pages - (prev?.pages ?? 0);
+    out[`${key}.records`] = m.records - (prev?.records ?? 0);
+    out[`${key}.bytes`] = m.bytes - (prev?.bytes ?? 0);
+    out[`${key}.ttfb_ms`] = avgDelta(prev?.ttfbMs, m.ttfbMs);
+    out[`${key}.native_ms`] = avgDelta(prev?.durationMs, m.durationMs);
+    out[`${key}.timeouts`] = m.timeouts - (prev?.timeouts ?? 0);
+  }
+  return out;
+}
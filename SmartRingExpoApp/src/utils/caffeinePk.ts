@@ -19,15 +19,101 @@ export function totalMgAt(h: number, doses: CaffeineDose[]): number {
   return doses.reduce((sum, d) => sum + doseMgAt(h, d), 0);
 }
 
+// ── Curve kernel ─────────────────────────────────────────────────────────────
+// The summed curve is sampled once per (dose set, range, step) into a
+// Float32Array. After its peak every dose decays by the same factor per step,
+// so the decaying part of the sum is carried forward as one running value:
+//   decay[i] = decay[i-1] · 0.5^(step / HALF_LIFE_H)
+// and pow() runs once per dose (when it peaks) rather than once per sample.
+// Only doses still in their 45-min ramp are visited per sample.
+// Peak, clearance and the SVG path all read the same buffer.
+
+export interface CaffeineCurve {
+  start: number;
+  /** Actual spacing — the requested step, shrunk so the last sample lands on `end`. */
+  step: number;
+  mg: Float32Array;
+  peakMg: number;
+  peakHour: number;
+}
+
+const CURVE_CACHE_MAX = 24;
+const curveCache = new Map<string, CaffeineCurve>();
+const pathCache = new Map<string, string>();
+
+function doseSetKey(doses: CaffeineDose[]): string {
+  let key = '';
+  for (const d of doses) key += `${d.intakeHour}:${d.amountMg};`;
+  return key;
+}
+
+function remember<T>(cache: Map<string, T>, key: string, value: T): T {
+  if (cache.size >= CURVE_CACHE_MAX) cache.delete(cache.keys().next().value as string);
+  cache.set(key, value);
+  return value;
+}
+
+function computeCurve(doses: CaffeineDose[], start: number, end: number, stepHint: number): CaffeineCurve {
+  const span = Math.max(0, end - start);
+  const intervals = span > 0 ? Math.max(1, Math.ceil(span / stepHint - 1e-9)) : 0;
+  const step = intervals > 0 ? span / intervals : stepHint;
+  const n = intervals + 1;
+  const mg = new Float32Array(n);
+  const stepDecay = Math.pow(0.5, step / HALF_LIFE_H);
+
+  // Doses ordered by the moment they start decaying
+  const byPeak = [...doses].sort((a, b) => a.intakeHour - b.intakeHour);
+  let nextPeak = 0;
+  let decay = 0;
+  let peakMg = 0;
+  let peakHour = start;
+
+  for (let i = 0; i < n; i++) {
+    const h = start + i * step;
+    decay *= stepDecay;
+    while (nextPeak < byPeak.length && byPeak[nextPeak].intakeHour + ABSORPTION_H <= h) {
+      const d = byPeak[nextPeak++];
+      decay += d.amountMg * Math.pow(0.5, (h - d.intakeHour - ABSORPTION_H) / HALF_LIFE_H);
+    }
+    let total = decay;
+    for (let j = nextPeak; j < byPeak.length; j++) {
+      const d = byPeak[j];
+      if (d.intakeHour >= h) break;
+      total += d.amountMg * (h - d.intakeHour) / ABSORPTION_H;
+    }
+    mg[i] = total;
+    if (total > peakMg) {
+      peakMg = total;
+      peakHour = h;
+    }
+  }
+  return { start, step, mg, peakMg, peakHour };
+}
+
+/** Summed curve over [start, end], memoized by dose set + range + step. */
+export function caffeineCurve(
+  doses: CaffeineDose[],
+  start: number,
+  end: number,
+  step = 0.1,
+): CaffeineCurve {
+  const key = `${start}|${end}|${step}|${doseSetKey(doses)}`;
+  return curveCache.get(key) ?? remember(curveCache, key, computeCurve(doses, start, end, step));
+}
+
 export function clearanceHour(
   doses: CaffeineDose[],
   threshold = SLEEP_THRESHOLD_MG,
   endHour = 26,
 ): number | null {
   if (doses.length === 0) return null;
-  const latestIntake = Math.max(...doses.map(d => d.intakeHour));
-  for (let h = latestIntake + ABSORPTION_H; h <= endHour; h += 0.1) {
-    if (totalMgAt(h, doses) < threshold) return h;
+  let latestIntake = -Infinity;
+  for (const d of doses) latestIntake = Math.max(latestIntake, d.intakeHour);
+  const from = latestIntake + ABSORPTION_H;
+  if (from > endHour) return null;
+  const curve = caffeineCurve(doses, from, endHour, 0.1);
+  for (let i = 0; i < curve.mg.length; i++) {
+    if (curve.mg[i] < threshold) return from + i * curve.step;
   }
   return null;
 }
@@ -55,16 +141,21 @@ export function buildMultiDoseCurvePath(
 ): string {
   const timeSpan = timeEnd - timeStart;
   if (!Number.isFinite(timeSpan) || timeSpan <= 0) return '';
-  const pts: string[] = [];
-  for (let t = timeStart; t <= timeEnd + 0.05; t += 0.12) {
-    const tc  = Math.min(t, timeEnd);
-    const mg  = totalMgAt(tc, doses);
-    const conc = Math.min(mg / yScaleMg, 1);
-    const x   = (chartPadL + ((tc - timeStart) / timeSpan) * innerW).toFixed(1);
-    const y   = (curveTopY + (1 - conc) * (curveBotY - curveTopY)).toFixed(1);
-    pts.push(pts.length === 0 ? `M${x},${y}` : `L${x},${y}`);
+  const curve = caffeineCurve(doses, timeStart, timeEnd, 0.12);
+  const key = `${innerW}|${chartPadL}|${curveTopY}|${curveBotY}|${yScaleMg}|${timeStart}|${timeEnd}|${doseSetKey(doses)}`;
+  const cached = pathCache.get(key);
+  if (cached !== undefined) return cached;
+
+  const xPerSample = (curve.step / timeSpan) * innerW;
+  const height = curveBotY - curveTopY;
+  // One decimal is plenty for SVG; rounding by hand avoids a toFixed() per point
+  const r1 = (v: number) => Math.round(v * 10) / 10;
+  let path = '';
+  for (let i = 0; i < curve.mg.length; i++) {
+    const conc = Math.min(curve.mg[i] / yScaleMg, 1);
+    path += `${i === 0 ? 'M' : ' L'}${r1(chartPadL + i * xPerSample)},${r1(curveTopY + (1 - conc) * height)}`;
   }
-  return pts.join(' ');
+  return remember(pathCache, key, path);
 }
 
 // Samples the total mg curve across the day and returns the peak value.
@@ -75,11 +166,7 @@ export function peakMgForDoses(
   timeEnd = 23,
 ): number {
   if (doses.length === 0) return 0;
-  let peak = 0;
-  for (let h = timeStart; h <= timeEnd; h += 0.1) {
-    peak = Math.max(peak, totalMgAt(h, doses));
-  }
-  return peak;
+  return caffeineCurve(doses, timeStart, timeEnd, 0.1).peakMg;
 }
 
 // Default predicted dose used as a baseline curve even before any drinks are logged.
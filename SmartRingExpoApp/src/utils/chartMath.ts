@@ -1,7 +1,48 @@
 /**
  * Shared SVG chart math utilities used across detail page trend charts.
+ *
+ * The geometry builders are 'worklet' functions with no closures, so they run
+ * unchanged on the JS thread during render or on the UI runtime from animated
+ * props. Paths that only depend on a series can be cached across mounts with
+ * `memoPath(seriesKey(values) + …, build)`.
+ *
+ * Timings per series size: scripts/bench-chart-math.ts.
  */
 
+// ── Path cache ───────────────────────────────────────────────────────────────
+
+const PATH_CACHE_MAX = 64;
+const pathCache = new Map<string, string>();
+
+/**
+ * Stable version key for a numeric series (FNV-1a over the values). Cheap
+ * next to building a path, and unchanged data gives the same key across
+ * renders and mounts.
+ */
+export function seriesKey(values: ArrayLike<number>): string {
+  let h = 0x811c9dc5;
+  for (let i = 0; i < values.length; i++) {
+    // Hundredths are finer than any pixel position we draw
+    h ^= Math.round(values[i] * 100) | 0;
+    h = Math.imul(h, 0x01000193);
+  }
+  return `${values.length}:${(h >>> 0).toString(36)}`;
+}
+
+/** Return the cached path for `key`, building (and caching) it on a miss. LRU. */
+export function memoPath(key: string, build: () => string): string {
+  const hit = pathCache.get(key);
+  if (hit !== undefined) {
+    pathCache.delete(key);
+    pathCache.set(key, hit);
+    return hit;
+  }
+  const path = build();
+  if (pathCache.size >= PATH_CACHE_MAX) pathCache.delete(pathCache.keys().next().value as string);
+  pathCache.set(key, path);
+  return path;
+}
+
 /** Parse a YYYY-MM-DD date string as a local midnight Date (avoids UTC offset shifting the day). */
 export function parseLocalDate(dateStr: string): Date {
   const [y, m, d] = dateStr.split('-').map(Number);
@@ -17,33 +58,55 @@ export function roundedBar(
   rTop: number,
   rBot: number,
 ): string {
+  'worklet';
   const rt = Math.min(rTop, h / 2, w / 2);
   const rb = Math.min(rBot, h / 2, w / 2);
-  return [
-    `M ${x + rt} ${y}`,
-    `H ${x + w - rt}`,
-    `Q ${x + w} ${y} ${x + w} ${y + rt}`,
-    `V ${y + h - rb}`,
-    `Q ${x + w} ${y + h} ${x + w - rb} ${y + h}`,
-    `H ${x + rb}`,
-    `Q ${x} ${y + h} ${x} ${y + h - rb}`,
-    `V ${y + rt}`,
-    `Q ${x} ${y} ${x + rt} ${y}`,
-    `Z`,
-  ].join(' ');
+  const r = x + w;
+  const b = y + h;
+  return `M ${x + rt} ${y} H ${r - rt} Q ${r} ${y} ${r} ${y + rt} V ${b - rb} Q ${r} ${b} ${r - rb} ${b} H ${x + rb} Q ${x} ${b} ${x} ${b - rb} V ${y + rt} Q ${x} ${y} ${x + rt} ${y} Z`;
 }
 
-/** 5-day centered rolling average. Skips zero values. Returns null if no valid values in window. */
+/** 5-day centered rolling average at one index. Skips zero values. Returns null if no valid values in window. */
 export function rollingAvg(values: number[], i: number, window = 5): number | null {
   const half = Math.floor(window / 2);
   const from = Math.max(0, i - half);
   const to = Math.min(values.length - 1, i + half);
-  const valid = values.slice(from, to + 1).filter(v => v > 0);
-  return valid.length > 0 ? valid.reduce((a, b) => a + b, 0) / valid.length : null;
+  let sum = 0;
+  let count = 0;
+  for (let j = from; j <= to; j++) {
+    if (values[j] > 0) { sum += values[j]; count++; }
+  }
+  return count > 0 ? sum / count : null;
+}
+
+/**
+ * Centered rolling average for every index in one O(n) pass — same result as
+ * calling `rollingAvg(values, i, window)` for each i.
+ */
+export function rollingAverages(values: number[], window = 5): Array<number | null> {
+  'worklet';
+  const n = values.length;
+  const half = Math.floor(window / 2);
+  const out: Array<number | null> = new Array(n);
+  let sum = 0;
+  let count = 0;
+  // Prime with [0, half - 1]; each step then admits i + half and drops i - half - 1
+  for (let j = 0; j < Math.min(half, n); j++) {
+    if (values[j] > 0) { sum += values[j]; count++; }
+  }
+  for (let i = 0; i < n; i++) {
+    const enter = i + half;
+    if (enter < n && values[enter] > 0) { sum += values[enter]; count++; }
+    const leave = i - half - 1;
+    if (leave >= 0 && values[leave] > 0) { sum -= values[leave]; count--; }
+    out[i] = count > 0 ? sum / count : null;
+  }
+  return out;
 }
 
 /** Fritsch-Carlson monotone cubic spline path through the given points. */
 export function monotoneCubicPath(pts: Array<{ x: number; y: number }>): string {
+  'worklet';
   if (pts.length < 2) return '';
   const n = pts.length;
   const d: number[] = [];
@@ -0,0 +1,22 @@
+/**
+ * Dev-only render counters.
+ *
+ * Components call countRender('Name') in their body (behind __DEV__); the home
+ * data provider resets the counters when a sync starts and logs them when it
+ * finishes, so the renders one full sync costs per card are visible in the
+ * Metro log.
+ */
+
+const counts = new Map<string, number>();
+
+export function countRender(name: string): void {
+  counts.set(name, (counts.get(name) ?? 0) + 1);
+}
+
+export function renderCounts(): Record<string, number> {
+  return Object.fromEntries([...counts].sort((a, b) => b[1] - a[1]));
+}
+
+export function resetRenderCounts(): void {
+  counts.clear();
+}
@@ -10,6 +10,7 @@
  */
 
 import UnifiedSmartRingService from '../../services/UnifiedSmartRingService';
+import { NIGHT_MIN_MS, segmentRingSleep } from '../../services/SleepSegmentation';
 
 export interface SleepSegment {
   startTime: string;
@@ -218,25 +219,13 @@ export function getSleepStageColor(type: number): string {
   }
 }
 
-const MIN_NIGHT_DURATION_MS = 180 * 60 * 1000; // 3 hours
 const MIN_WAKE_HOUR = 7; // Don't treat wakes before 7 AM as a full night
 
-/** Parses X3 SDK local-time strings ("YYYY.MM.DD HH:mm:ss") to a ms timestamp. */
-function parseX3DateTimeStr(value?: string): number | undefined {
-  if (!value || typeof value !== 'string') return undefined;
-  const [datePart, timePart] = value.trim().split(/\s+/);
-  if (!datePart) return undefined;
-  const [y, m, d] = datePart.split('.').map(Number);
-  if ([y, m, d].some(n => Number.isNaN(n))) return undefined;
-  const [hh = 0, mm = 0, ss = 0] = (timePart || '00:00:00').split(':').map(Number);
-  const ts = new Date(y, m - 1, d, hh, mm, ss).getTime();
-  return Number.isFinite(ts) && ts > 0 ? ts : undefined;
-}
-
 /**
  * Extracts the latest wake time (end of night) from raw SDK sleep records.
- * Only considers blocks ≥180 min that ended at or after 7 AM today.
- * Returns null if no qualifying record is found.
+ * Only considers merged blocks (SleepSegmentation, ≤60 min gaps) ≥180 min that have a
+ * record starting after 6 PM yesterday and ended at or after 7 AM.
+ * Returns null if no qualifying block is found.
  */
 export function extractWakeTime(rawRecords: any[]): Date | null {
   if (!rawRecords || rawRecords.length === 0) return null;
@@ -248,27 +237,12 @@ export function extractWakeTime(rawRecords: any[]): Date | null {
 
   let latestEnd: number | null = null;
 
-  for (const record of rawRecords) {
-    const startMs = (() => {
-      const numeric = [record.startTimestamp, record.startTime]
-        .find((v: any) => typeof v === 'number' && Number.isFinite(v) && v > 0);
-      return numeric ?? parseX3DateTimeStr(record.startTime_SleepData);
-    })();
-
-    if (typeof startMs !== 'number') continue;
-    if (startMs < windowStart) continue;
-
-    const qualityArray: number[] = record.arraySleepQuality || [];
-    const unitLength = Number(record.sleepUnitLength || 1);
-    const durationMin = Number(record.totalSleepTime) || qualityArray.length * unitLength;
-    const durationMs = durationMin * 60 * 1000;
-
-    if (durationMs < MIN_NIGHT_DURATION_MS) continue;
-
-    const endMs = startMs + durationMs;
-    if (new Date(endMs).getHours() < MIN_WAKE_HOUR) continue;
-
-    if (!latestEnd || endMs > latestEnd) latestEnd = endMs;
+  for (const block of segmentRingSleep(rawRecords)) {
+    if (block.records.length === 0) continue;
+    if (block.records[block.records.length - 1].start < windowStart) continue;
+    if (block.end - block.start < NIGHT_MIN_MS) continue;
+    if (new Date(block.end).getHours() < MIN_WAKE_HOUR) continue;
+    if (!latestEnd || block.end > latestEnd) latestEnd = block.end;
   }
 
   return latestEnd ? new Date(latestEnd) : null;
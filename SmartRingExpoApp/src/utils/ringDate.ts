@@ -0,0 +1,136 @@
+/**
+ * Ring SDK date strings ("YYYY.MM.DD HH:mm:ss", "YYYY.MM.DD HH:mm", "YYYY.MM.DD"; local
+ * time) → epoch ms. The one parser for SDK dates in the app; the native bridges use the
+ * same scheme in ios/JstyleBridge/BleRingDate.c.
+ *
+ * History batches hold thousands of stamps from a handful of days, so the parser reads
+ * the fixed-width digits with charCodeAt and caches each day's local midnight: a stamp
+ * costs a few multiplies instead of split / map(Number) / new Date, and allocates
+ * nothing. A day whose length isn't 24 h (a DST switch) skips the cache and goes through
+ * new Date, so results match new Date(y, m - 1, d, hh, mm, ss) on every day. Anything
+ * not fixed-width (unpadded fields, extra whitespace) takes the same slow path.
+ *
+ * Cached midnights assume the time zone doesn't change: the app calls
+ * resetRingDateCache() on foreground, and a private RingDateParser is always fresh.
+ */
+
+const HOUR_MS = 60 * 60 * 1000;
+const DAY_MS = 24 * HOUR_MS;
+const MAX_CACHED_DAYS = 1024;
+/** Marks a day with a DST switch: its stamps can't be midnight + offset. */
+const IRREGULAR = -1;
+
+export class RingDateParser {
+  private days = new Map<number, number>();
+  private lastDayKey = -1;
+  private lastMidnight = IRREGULAR;
+
+  /** Local epoch ms, or undefined for a missing / malformed / pre-1970 value. */
+  parse(value: unknown): number | undefined {
+    if (typeof value !== 'string') return undefined;
+    const n = value.length;
+    if (n !== 10 && n !== 16 && n !== 19) return parseSlow(value);
+
+    const y = digits4(value, 0);
+    const mo = digits2(value, 5);
+    const d = digits2(value, 8);
+    const sep = value.charCodeAt(4);
+    if (y < 0 || mo < 1 || mo > 12 || d < 1 || d > 31 || (sep !== 46 && sep !== 45) || value.charCodeAt(7) !== sep) {
+      return parseSlow(value);
+    }
+    let secOfDay = 0;
+    let hh = 0, mm = 0, ss = 0;
+    if (n > 10) {
+      hh = digits2(value, 11);
+      mm = digits2(value, 14);
+      ss = n === 19 ? digits2(value, 17) : 0;
+      if (value.charCodeAt(10) !== 32 || value.charCodeAt(13) !== 58 || (n === 19 && value.charCodeAt(16) !== 58) ||
+          hh < 0 || hh > 23 || mm < 0 || mm > 59 || ss < 0 || ss > 59) {
+        return parseSlow(value);
+      }
+      secOfDay = hh * 3600 + mm * 60 + ss;
+    }
+
+    const midnight = this.midnight(y, mo, d);
+    const ts = midnight === IRREGULAR
+      ? new Date(y, mo - 1, d, hh, mm, ss).getTime()
+      : midnight + secOfDay * 1000;
+    return Number.isFinite(ts) && ts > 0 ? ts : undefined;
+  }
+
+  /** Drop cached midnights (after a time zone change). */
+  clear(): void {
+    this.days.clear();
+    this.lastDayKey = -1;
+    this.lastMidnight = IRREGULAR;
+  }
+
+  private midnight(y: number, mo: number, d: number): number {
+    const key = y * 10000 + mo * 100 + d;
+    if (key === this.lastDayKey) return this.lastMidnight;
+    let midnight = this.days.get(key);
+    if (midnight === undefined) {
+      const start = new Date(y, mo - 1, d).getTime();
+      const next = new Date(y, mo - 1, d + 1).getTime();
+      midnight = next - start === DAY_MS ? start : IRREGULAR;
+      if (this.days.size >= MAX_CACHED_DAYS) this.days.clear();
+      this.days.set(key, midnight);
+    }
+    this.lastDayKey = key;
+    this.lastMidnight = midnight;
+    return midnight;
+  }
+}
+
+const shared = new RingDateParser();
+
+/** Local epoch ms for an SDK date string, or undefined for a missing / malformed / pre-1970 value. */
+export function parseRingDate(value: unknown): number | undefined {
+  return shared.parse(value);
+}
+
+/** Minutes since local midnight as written in the string ("… 07:45:10" → 465). */
+export function ringDateMinutes(value: unknown): number | undefined {
+  if (typeof value !== 'string') return undefined;
+  if (value.length === 16 || value.length === 19) {
+    const hh = digits2(value, 11);
+    const mm = digits2(value, 14);
+    if (value.charCodeAt(10) === 32 && value.charCodeAt(13) === 58 && hh >= 0 && hh <= 23 && mm >= 0 && mm <= 59 &&
+        shared.parse(value) !== undefined) {
+      return hh * 60 + mm;
+    }
+  }
+  const ts = parseSlow(value);
+  if (ts === undefined) return undefined;
+  const d = new Date(ts);
+  return d.getHours() * 60 + d.getMinutes();
+}
+
+/** Forget cached midnights; call when the device time zone may have changed. */
+export function resetRingDateCache(): void {
+  shared.clear();
+}
+
+function digits2(s: string, at: number): number {
+  const a = s.charCodeAt(at) - 48;
+  const b = s.charCodeAt(at + 1) - 48;
+  return a >= 0 && a <= 9 && b >= 0 && b <= 9 ? a * 10 + b : -1;
+}
+
+function digits4(s: string, at: number): number {
+  const hi = digits2(s, at);
+  const lo = digits2(s, at + 2);
+  return hi < 0 || lo < 0 ? -1 : hi * 100 + lo;
+}
+
+// Loose form: any whitespace, unpadded fields, '.', '-' or '/' between date parts
+function parseSlow(value: string): number | undefined {
+  const [datePart, timePart] = value.trim().split(/\s+/);
+  if (!datePart) return undefined;
+  const [y, m, d] = datePart.split(/[.\-/]/).map(Number);
+  if ([y, m, d].some(n => Number.isNaN(n))) return undefined;
+  const [hh = 0, mm = 0, ss = 0] = (timePart || '00:00:00').split(':').map(Number);
+  if ([hh, mm, ss].some(n => Number.isNaN(n))) return undefined;
+  const ts = new Date(y, m - 1, d, hh, mm, ss).getTime();
+  return Number.isFinite(ts) && ts > 0 ? ts : undefined;
+}
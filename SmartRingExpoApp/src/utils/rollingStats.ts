@@ -0,0 +1,140 @@
+/**
+ * Rolling statistics shared by the baseline, readiness and sleep-debt code.
+ *
+ * Baselines are persisted as plain number arrays (oldest → newest, capped at
+ * the window length); those arrays ARE the rolling state. `RollingWindow`
+ * rehydrates one in O(n log n) and then keeps:
+ *   - sum / mean in O(1) per push (running total)
+ *   - median in O(1), located by an O(log n) binary search per push into a
+ *     sorted copy of the window (built on the first median() call, so
+ *     sum-only windows like the sleep-debt one never pay for it)
+ * and `values()` hands the array back for storage.
+ *
+ * baselineMedian() keeps one window per persisted array (weakly, keyed by the
+ * array), and pushRolling() hands that window on to the array it returns, so
+ * a baseline is sorted once per load and each new night after that is one
+ * O(log n) insert/evict rather than a copy+sort per read.
+ *
+ * The sorted copy costs a memmove on insert/evict, which for the window
+ * sizes used here (7–365) measured several times faster than two heaps with
+ * lazy deletion (scripts/bench-rolling-stats.ts).
+ */
+
+/** First index in ascending `sorted` whose value is >= `x`. */
+function lowerBound(sorted: number[], x: number): number {
+  let lo = 0;
+  let hi = sorted.length;
+  while (lo < hi) {
+    const mid = (lo + hi) >>> 1;
+    if (sorted[mid] < x) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+export class RollingWindow {
+  readonly capacity: number;
+  // Ring buffer in insertion order; `head` is the oldest slot once full
+  private ring: number[] = [];
+  private head = 0;
+  private total = 0;
+  // Same values kept in ascending order for order statistics; null until median() needs it
+  private sorted: number[] | null = null;
+
+  constructor(capacity: number, initial: readonly number[] = []) {
+    this.capacity = capacity;
+    for (const v of initial.slice(-capacity)) this.push(v);
+  }
+
+  get size(): number {
+    return this.ring.length;
+  }
+
+  get sum(): number {
+    return this.total;
+  }
+
+  mean(): number | null {
+    return this.ring.length > 0 ? this.total / this.ring.length : null;
+  }
+
+  median(): number | null {
+    const s = (this.sorted ??= [...this.ring].sort((a, b) => a - b));
+    const n = s.length;
+    if (n === 0) return null;
+    const mid = n >> 1;
+    return n % 2 === 0 ? (s[mid - 1] + s[mid]) / 2 : s[mid];
+  }
+
+  /** Window contents, oldest first — the persisted form. */
+  values(): number[] {
+    return [...this.ring.slice(this.head), ...this.ring.slice(0, this.head)];
+  }
+
+  /** Append a value, evicting the oldest once full. Returns the evicted value, if any. */
+  push(v: number): number | undefined {
+    let evicted: number | undefined;
+    if (this.ring.length === this.capacity) {
+      evicted = this.ring[this.head];
+      this.ring[this.head] = v;
+      this.head = (this.head + 1) % this.capacity;
+      this.total -= evicted;
+      this.sorted?.splice(lowerBound(this.sorted, evicted), 1);
+    } else {
+      this.ring.push(v);
+    }
+    this.total += v;
+    this.sorted?.splice(lowerBound(this.sorted, v), 0, v);
+    return evicted;
+  }
+}
+
+/** Days kept in a persisted baseline array. */
+export const BASELINE_DAYS = 14;
+
+// Live window for each persisted baseline array, dropped with the array
+const baselineWindows = new WeakMap<readonly number[], RollingWindow>();
+
+/**
+ * Median of a persisted baseline array. The first read builds its window;
+ * later reads of the same array (and of the arrays pushRolling derives from
+ * it) are O(1). Null when empty.
+ */
+export function baselineMedian(values: readonly number[] | undefined): number | null {
+  if (!values || values.length === 0) return null;
+  let w = baselineWindows.get(values);
+  if (!w) {
+    // Longer legacy arrays get a window that holds all of them, so the median is unchanged
+    w = new RollingWindow(Math.max(BASELINE_DAYS, values.length), values);
+    baselineWindows.set(values, w);
+  }
+  return w.median();
+}
+
+/** Median of an arbitrary list (copy + sort). Null when empty. */
+export function median(values: number[]): number | null {
+  if (values.length === 0) return null;
+  const sorted = [...values].sort((a, b) => a - b);
+  const mid = Math.floor(sorted.length / 2);
+  return sorted.length % 2 === 0 ? (sorted[mid - 1] + sorted[mid]) / 2 : sorted[mid];
+}
+
+/**
+ * Append `value` to a persisted baseline array, keeping the newest `max`.
+ * Non-finite and non-positive values mean "no reading" and are skipped.
+ * The input's window (if baselineMedian built one) moves to the result.
+ */
+export function pushRolling(values: number[] | undefined, value: number, max = BASELINE_DAYS): number[] {
+  if (!Number.isFinite(value) || value <= 0) return values ?? [];
+  const base = values ?? [];
+  const start = Math.max(0, base.length + 1 - max);
+  const next = base.slice(start);
+  next.push(value);
+  const w = values && baselineWindows.get(values);
+  if (w && w.capacity === max) {
+    baselineWindows.delete(values);
+    w.push(value);
+    baselineWindows.set(next, w);
+  }
+  return next;
+}
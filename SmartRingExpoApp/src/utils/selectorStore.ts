@@ -0,0 +1,120 @@
+/**
+ * Minimal external store for useSyncExternalStore with structural sharing.
+ *
+ * `set` merges the new state into the previous one with shareStructure: any
+ * subtree that is deep-equal to what was there keeps its old reference, so a
+ * selector over an untouched slice returns the same value and its component
+ * doesn't re-render. Listeners only run when the shared state actually
+ * changed.
+ *
+ * createSelection is the per-subscriber memo: it re-runs the selector for a
+ * new snapshot and keeps the previous result while `isEqual` says nothing
+ * changed (shallowEqual for selectors that build an object of several fields).
+ *
+ * No React imports, so scripts/bench-home-data-store.ts runs it under Node.
+ */
+
+export interface SelectorStore<T> {
+  getSnapshot: () => T;
+  subscribe: (listener: () => void) => () => void;
+  /** Replace the state; returns whether anything changed. */
+  set: (next: T) => boolean;
+}
+
+const isPlainObject = (value: unknown): value is Record<string, unknown> => {
+  if (value === null || typeof value !== 'object') return false;
+  const proto = Object.getPrototypeOf(value);
+  return proto === Object.prototype || proto === null;
+};
+
+/**
+ * `next`, with every part deep-equal to the same part of `prev` replaced by the
+ * `prev` reference. Plain objects, arrays and Dates are compared by value;
+ * anything else (functions, class instances) by reference.
+ */
+export function shareStructure<T>(prev: T, next: T): T {
+  if (Object.is(prev, next)) return prev;
+  if (prev instanceof Date && next instanceof Date) {
+    return prev.getTime() === next.getTime() || (Number.isNaN(prev.getTime()) && Number.isNaN(next.getTime()))
+      ? prev
+      : next;
+  }
+  if (Array.isArray(prev) && Array.isArray(next)) {
+    let out: unknown[] | null = prev.length === next.length ? null : new Array(next.length);
+    for (let i = 0; i < next.length; i++) {
+      const shared = i < prev.length ? shareStructure(prev[i], next[i]) : next[i];
+      if (!out && shared !== prev[i]) {
+        out = new Array(next.length);
+        for (let j = 0; j < i; j++) out[j] = prev[j];
+      }
+      if (out) out[i] = shared;
+    }
+    return (out ?? prev) as T;
+  }
+  if (isPlainObject(prev) && isPlainObject(next)) {
+    const nextKeys = Object.keys(next);
+    let changed = nextKeys.length !== Object.keys(prev).length;
+    const out: Record<string, unknown> = {};
+    for (const key of nextKeys) {
+      const shared = shareStructure(prev[key], next[key]);
+      if (shared !== prev[key] || !(key in prev)) changed = true;
+      out[key] = shared;
+    }
+    return (changed ? out : prev) as T;
+  }
+  return next;
+}
+
+export function createSelectorStore<T>(initial: T): SelectorStore<T> {
+  let state = initial;
+  const listeners = new Set<() => void>();
+  return {
+    getSnapshot: () => state,
+    subscribe: listener => {
+      listeners.add(listener);
+      return () => {
+        listeners.delete(listener);
+      };
+    },
+    set: next => {
+      const shared = shareStructure(state, next);
+      if (shared === state) return false;
+      state = shared;
+      listeners.forEach(listener => listener());
+      return true;
+    },
+  };
+}
+
+export function shallowEqual<T>(a: T, b: T): boolean {
+  if (Object.is(a, b)) return true;
+  if (!a || !b || typeof a !== 'object' || typeof b !== 'object') return false;
+  const aKeys = Object.keys(a);
+  if (aKeys.length !== Object.keys(b).length) return false;
+  return aKeys.every(key => Object.prototype.hasOwnProperty.call(b, key) &&
+    Object.is((a as Record<string, unknown>)[key], (b as Record<string, unknown>)[key]));
+}
+
+export interface Selection<S, T> {
+  read: (snapshot: S, selector: (snapshot: S) => T, isEqual: (a: T, b: T) => boolean) => T;
+}
+
+export function createSelection<S, T>(): Selection<S, T> {
+  let hasValue = false;
+  let lastSnapshot: S;
+  let lastSelector: (snapshot: S) => T;
+  let value: T;
+  return {
+    read: (snapshot, selector, isEqual) => {
+      if (hasValue && snapshot === lastSnapshot && selector === lastSelector) return value;
+      const next = selector(snapshot);
+      lastSnapshot = snapshot;
+      lastSelector = selector;
+      if (!hasValue || !isEqual(value, next)) {
+        value = next;
+        hasValue = true;
+      }
+      return value;
+    },
+  };
+}
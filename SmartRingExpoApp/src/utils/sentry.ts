@@ -65,6 +65,19 @@ export function addBreadcrumb(
   Sentry.addBreadcrumb({ category, message, data, level });
 }
 
+/**
+ * Run `fn` inside a Sentry performance span. `fn` gets a setter for
+ * attributes only known once the work is done (byte counts, page counts).
+ * Unsampled spans are no-ops, so this is cheap on hot paths.
+ */
+export function withSpan<T>(
+  op: string,
+  name: string,
+  fn: (setAttributes: (attributes: Record<string, number | string>) => void) => Promise<T>,
+): Promise<T> {
+  return Sentry.startSpan({ op, name }, span => fn(attributes => span.setAttributes(attributes)));
+}
+
 /**
  * Identify the current user so errors in Sentry show who was affected.
  * Call on login with user info, call with null on logout.
@@ -0,0 +1,39 @@
+/**
+ * Zero-run encoding for sparse per-minute series persisted as JSON.
+ *
+ * Ring series are mostly empty (no steps overnight, no SpO2 during the day),
+ * so each run of zeros is stored as its negated length: [0,0,0,5,0] → [-3,5,-1].
+ * Values must be non-negative integers, which every typed-array series is.
+ */
+
+export function encodeZeroRuns(values: ArrayLike<number>): number[] {
+  const out: number[] = [];
+  let zeros = 0;
+  for (let i = 0; i < values.length; i++) {
+    const v = values[i];
+    if (v === 0) {
+      zeros++;
+      continue;
+    }
+    if (zeros > 0) {
+      out.push(-zeros);
+      zeros = 0;
+    }
+    out.push(v);
+  }
+  if (zeros > 0) out.push(-zeros);
+  return out;
+}
+
+/** Decode into a preallocated array; anything past its length is dropped. */
+export function decodeZeroRuns<T extends Uint8Array | Uint16Array>(encoded: readonly number[], into: T): T {
+  let i = 0;
+  for (const v of encoded) {
+    if (v < 0) {
+      i += -v;
+    } else if (i < into.length) {
+      into[i++] = v;
+    }
+  }
+  return into;
+}
@@ -0,0 +1,162 @@
+/**
+ * fanout — shared helpers for cron-driven per-user fan-out functions
+ * (daily-summary-push, whatsapp-checkin).
+ *
+ * Pure TypeScript with no Deno/npm imports so it can be exercised from
+ * Node (scripts/bench-push-fanout.ts) against a mocked endpoint.
+ *
+ *   groupByTzCohort   — bucket rows by push_tokens.tz_offset_min so each
+ *                       cohort is loaded with ONE batched `.in('user_id', …)`
+ *   cohortLocalDate   — YYYY-MM-DD for "now" as seen by a cohort
+ *   mapWithConcurrency — bounded worker pool (never more than N in flight)
+ *   fetchWithRetry    — retry 429/5xx/network errors with exponential
+ *                       backoff + full jitter, honouring Retry-After;
+ *                       `idempotent: false` narrows that to 429 and
+ *                       connection-refused for sends that must not repeat
+ */
+
+export interface TzCohort<T> {
+  /** Minutes from UTC (e.g. -180 for ART). Missing offsets fall into 0. */
+  tzOffsetMin: number;
+  rows: T[];
+  /** Distinct user ids in this cohort — feed straight into `.in('user_id', …)` */
+  userIds: string[];
+}
+
+export function groupByTzCohort<T extends { user_id: string; tz_offset_min?: number | null }>(
+  rows: T[],
+): TzCohort<T>[] {
+  const byOffset = new Map<number, { rows: T[]; users: Set<string> }>();
+  for (const row of rows) {
+    const off = row.tz_offset_min ?? 0;
+    let bucket = byOffset.get(off);
+    if (!bucket) {
+      bucket = { rows: [], users: new Set() };
+      byOffset.set(off, bucket);
+    }
+    bucket.rows.push(row);
+    bucket.users.add(row.user_id);
+  }
+  return Array.from(byOffset, ([tzOffsetMin, b]) => ({
+    tzOffsetMin,
+    rows: b.rows,
+    userIds: Array.from(b.users),
+  }));
+}
+
+/** Local calendar date (YYYY-MM-DD) for `now` in a cohort's offset. */
+export function cohortLocalDate(now: Date, tzOffsetMin: number): string {
+  return new Date(now.getTime() + tzOffsetMin * 60_000).toISOString().slice(0, 10);
+}
+
+/** Split an array into chunks of at most `size` (PostgREST `.in()` URL limit, Expo 100/request). */
+export function chunk<T>(arr: T[], size: number): T[][] {
+  const out: T[][] = [];
+  for (let i = 0; i < arr.length; i += size) out.push(arr.slice(i, i + size));
+  return out;
+}
+
+/**
+ * Run `fn` over every item with at most `limit` calls in flight.
+ * Results keep input order. A rejected call rejects the whole run, so
+ * callers that want per-item isolation should catch inside `fn`.
+ */
+export async function mapWithConcurrency<T, R>(
+  items: T[],
+  limit: number,
+  fn: (item: T, index: number) => Promise<R>,
+): Promise<R[]> {
+  const results = new Array<R>(items.length);
+  let next = 0;
+  const worker = async () => {
+    while (next < items.length) {
+      const i = next++;
+      results[i] = await fn(items[i], i);
+    }
+  };
+  const workers: Promise<void>[] = [];
+  for (let w = 0; w < Math.max(1, Math.min(limit, items.length)); w++) workers.push(worker());
+  await Promise.all(workers);
+  return results;
+}
+
+export interface RetryOptions {
+  /** Total attempts including the first one. Default 4. */
+  attempts?: number;
+  /** Base delay for exponential backoff. Default 250 ms. */
+  baseDelayMs?: number;
+  /** Upper bound for a single wait. Default 8 s. */
+  maxDelayMs?: number;
+  /**
+   * Default true. Pass false for requests that deliver something (a WhatsApp
+   * message, a push batch): a 5xx or a dropped connection may come after the
+   * provider already accepted it, so only failures that prove it was never
+   * processed — 429 and connection refused — are retried.
+   */
+  idempotent?: boolean;
+  /** Injected for tests/benchmarks. */
+  fetchImpl?: typeof fetch;
+  sleep?: (ms: number) => Promise<void>;
+}
+
+const defaultSleep = (ms: number) => new Promise<void>(r => setTimeout(r, ms));
+
+function isRetryableStatus(status: number, idempotent: boolean): boolean {
+  if (!idempotent) return status === 429;
+  return status === 429 || status === 408 || status >= 500;
+}
+
+/** Deno: "Connection refused (os error 111)" / ConnectionRefused; Node: cause.code ECONNREFUSED. */
+function isConnectionRefused(err: unknown): boolean {
+  let e = err as { name?: string; message?: string; code?: string; cause?: unknown } | undefined;
+  for (let depth = 0; e && depth < 4; depth++) {
+    if (e.code === 'ECONNREFUSED' || e.name === 'ConnectionRefused') return true;
+    if (/connection refused/i.test(String(e.message ?? ''))) return true;
+    e = e.cause as typeof e;
+  }
+  return false;
+}
+
+function retryAfterMs(res: Response): number | null {
+  const raw = res.headers.get('Retry-After');
+  if (!raw) return null;
+  const secs = Number(raw);
+  if (Number.isFinite(secs)) return secs * 1000;
+  const at = Date.parse(raw);
+  return Number.isFinite(at) ? Math.max(0, at - Date.now()) : null;
+}
+
+/**
+ * fetch() with retry on 408/429/5xx and thrown network errors (only 429 and
+ * connection refused when `idempotent: false`).
+ * Non-retryable responses are returned as-is for the caller to inspect.
+ * The last response is returned (or the last error re-thrown) when attempts run out.
+ */
+export async function fetchWithRetry(
+  url: string,
+  init: RequestInit,
+  opts: RetryOptions = {},
+): Promise<Response> {
+  const attempts = opts.attempts ?? 4;
+  const base = opts.baseDelayMs ?? 250;
+  const cap = opts.maxDelayMs ?? 8_000;
+  const doFetch = opts.fetchImpl ?? fetch;
+  const sleep = opts.sleep ?? defaultSleep;
+  const idempotent = opts.idempotent ?? true;
+
+  for (let attempt = 1; ; attempt++) {
+    let res: Response | null = null;
+    try {
+      res = await doFetch(url, init);
+      if (!isRetryableStatus(res.status, idempotent) || attempt >= attempts) return res;
+      // Release the discarded body so Deno doesn't hold the connection open
+      await res.body?.cancel().catch(() => {});
+    } catch (err) {
+      if (attempt >= attempts || (!idempotent && !isConnectionRefused(err))) throw err;
+    }
+    // Full jitter: uniform in [0, min(cap, base·2^n)], but never shorter than Retry-After
+    const backoff = Math.random() * Math.min(cap, base * 2 ** (attempt - 1));
+    const hinted = res ? retryAfterMs(res) : null;
+    await sleep(hinted != null ? Math.min(cap, Math.max(hinted, backoff)) : backoff);
+  }
+}
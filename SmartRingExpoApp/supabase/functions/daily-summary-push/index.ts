@@ -1,5 +1,13 @@
 import { serve } from 'https://deno.land/std@0.168.0/http/server.ts';
-import { createClient } from 'https://esm.sh/@supabase/supabase-js@2';
+import { createClient, type SupabaseClient } from 'https://esm.sh/@supabase/supabase-js@2';
+import {
+  chunk,
+  cohortLocalDate,
+  fetchWithRetry,
+  groupByTzCohort,
+  mapWithConcurrency,
+  type TzCohort,
+} from '../_shared/fanout.ts';
 
 /**
  * daily-summary-push — personalized daily push notifications for all users.
@@ -22,7 +30,39 @@ import { createClient } from 'https://esm.sh/@supabase/supabase-js@2';
  *   7-day average wake time: wind_down_hour = avg_wake_utc - 8.5h.
  *   Only users whose wind-down UTC hour matches the current UTC hour receive it.
  *   "Time to wind down 🌙 To wake at 6:45 AM rested, aim to be asleep by 10:45 PM."
+ *
+ * Fan-out: tokens are grouped into tz_offset_min cohorts; each cohort loads
+ * its data with a single `.in('user_id', …)` query (chunked for URL length,
+ * paged past PostgREST's row cap), and Expo batches go out through a
+ * bounded-concurrency sender that retries only 429 / connection refused, so a
+ * batch Expo already accepted is never pushed twice.
  */
+
+type PushType = 'morning' | 'evening' | 'wind-down';
+
+interface TokenRow {
+  user_id: string;
+  token: string;
+  tz_offset_min: number | null;
+}
+
+interface PushMessage {
+  to: string;
+  title: string;
+  body: string;
+  sound: 'default';
+  data: { url: string };
+}
+
+const EXPO_PUSH_URL = 'https://exp.host/--/api/v2/push/send';
+const EXPO_BATCH = 100;
+const SEND_CONCURRENCY = 4;
+const COHORT_CONCURRENCY = 4;
+// Keeps the PostgREST `in.(…)` filter well under URL length limits
+const USER_ID_CHUNK = 200;
+// PostgREST's default max-rows; a chunk of users can exceed it (7 days × 200 users)
+const PAGE_SIZE = 1000;
+
 serve(async (req: Request) => {
   try {
     if (req.method !== 'POST') {
@@ -35,7 +75,7 @@ serve(async (req: Request) => {
       return new Response('Unauthorized', { status: 401 });
     }
 
-    const { type } = (await req.json()) as { type: 'morning' | 'evening' | 'wind-down' };
+    const { type } = (await req.json()) as { type: PushType };
     if (!['morning', 'evening', 'wind-down'].includes(type)) {
       return new Response(JSON.stringify({ error: 'type must be "morning", "evening", or "wind-down"' }), {
         status: 400,
@@ -48,11 +88,12 @@ serve(async (req: Request) => {
     const supabase = createClient(supabaseUrl, supabaseKey);
 
     // All users with push tokens
-    const { data: tokenRows, error: tokenErr } = await supabase
+    const tokenRows = await selectPaged<TokenRow>(() => supabase
       .from('push_tokens')
-      .select('user_id, token, tz_offset_min');
+      .select('user_id, token, tz_offset_min')
+      .order('id')).catch(() => null);
 
-    if (tokenErr || !tokenRows?.length) {
+    if (!tokenRows?.length) {
       return new Response(JSON.stringify({ sent: 0, reason: 'no tokens' }), {
         headers: { 'Content-Type': 'application/json' },
       });
@@ -60,146 +101,15 @@ serve(async (req: Request) => {
 
     const now = new Date();
     const currentUtcHour = now.getUTCHours();
-    const todayUtc = now.toISOString().slice(0, 10);
-    const oneDayAgo = new Date(now.getTime() - 24 * 60 * 60 * 1000).toISOString();
-    const sevenDaysAgo = new Date(now.getTime() - 7 * 24 * 60 * 60 * 1000).toISOString();
-
-    // Bulk-fetch all data upfront — no N+1 queries
-    const [{ data: allSessions }, { data: allSummaries }, { data: allWindDownSessions }] = await Promise.all([
-      type === 'morning'
-        ? supabase
-            .from('sleep_sessions')
-            .select('user_id, start_time, end_time, sleep_score, deep_min, light_min, rem_min')
-            .gte('end_time', oneDayAgo)
-            .order('end_time', { ascending: false })
-        : Promise.resolve({ data: null }),
-
-      type === 'evening'
-        ? supabase
-            .from('daily_summaries')
-            .select('user_id, total_steps, hr_avg')
-            .eq('date', todayUtc)
-        : Promise.resolve({ data: null }),
-
-      type === 'wind-down'
-        ? supabase
-            .from('sleep_sessions')
-            .select('user_id, end_time')
-            .gte('end_time', sevenDaysAgo)
-            .order('end_time', { ascending: false })
-        : Promise.resolve({ data: null }),
-    ]);
-
-    // Most-recent session per user for morning (already ordered desc)
-    const sessionByUser: Record<string, { start_time: string; end_time: string; sleep_score: number | null }> = {};
-    for (const s of allSessions ?? []) {
-      if (!sessionByUser[s.user_id]) sessionByUser[s.user_id] = s;
-    }
 
-    const summaryByUser: Record<string, { total_steps: number | null; hr_avg: number | null }> = {};
-    for (const s of allSummaries ?? []) {
-      summaryByUser[s.user_id] = s;
-    }
-
-    // 7-day average wake time per user (UTC minutes of day)
-    // Used to compute each user's personal wind-down delivery hour
-    const wakeUtcMinSumByUser: Record<string, { sum: number; count: number }> = {};
-    for (const s of allWindDownSessions ?? []) {
-      const d = new Date(s.end_time);
-      const utcMin = d.getUTCHours() * 60 + d.getUTCMinutes();
-      if (!wakeUtcMinSumByUser[s.user_id]) wakeUtcMinSumByUser[s.user_id] = { sum: 0, count: 0 };
-      wakeUtcMinSumByUser[s.user_id].sum += utcMin;
-      wakeUtcMinSumByUser[s.user_id].count += 1;
-    }
-
-    const messages: object[] = [];
-
-    for (const { user_id, token, tz_offset_min } of tokenRows) {
-      let title = '';
-      let body = '';
-
-      if (type === 'morning') {
-        const session = sessionByUser[user_id];
-
-        if (!session) {
-          // Fallback: no synced data yet — nudge user to open the app
-          title = 'Your sleep summary is ready 🌙';
-          body = 'See how you slept last night. Tap to view your analysis.';
-        } else {
-          const stageTotalMin = (session.deep_min || 0) + (session.light_min || 0) + (session.rem_min || 0);
-          const totalMin = stageTotalMin > 0
-            ? stageTotalMin
-            : Math.round((new Date(session.end_time).getTime() - new Date(session.start_time).getTime()) / 60000);
-          const h = Math.floor(totalMin / 60);
-          const m = totalMin % 60;
-          const scoreText = session.sleep_score ? ` · Score: ${session.sleep_score}` : '';
-          title = 'Good morning! Your sleep is ready 🌙';
-          body = `You slept ${h}h ${m}m${scoreText}. Tap to see your full analysis.`;
-        }
-
-      } else if (type === 'evening') {
-        const summary = summaryByUser[user_id];
-        if (!summary) continue;
-
-        const steps = summary.total_steps ? summary.total_steps.toLocaleString('en-US') : null;
-        const hr = summary.hr_avg ? Math.round(summary.hr_avg) : null;
-        if (!steps && !hr) continue;
-
-        const parts: string[] = [];
-        if (steps) parts.push(`${steps} steps`);
-        if (hr) parts.push(`avg HR ${hr} bpm`);
-
-        title = "Today's activity summary 🏃";
-        body = `${parts.join(' · ')}. Tap to see your full day.`;
-
-      } else {
-        // wind-down: only send if this UTC hour matches the user's computed wind-down hour
-        const userData = wakeUtcMinSumByUser[user_id];
-        if (!userData) continue;
-
-        const avgWakeUtcMin = Math.round(userData.sum / userData.count);
-
-        // Wind-down = 30 min before bedtime; bedtime = wake - 8h
-        // So wind-down = wake - 8h 30min = wake - 510 min
-        const windDownUtcMin = ((avgWakeUtcMin - 510) + 1440 * 2) % 1440;
-        const windDownUtcHour = Math.floor(windDownUtcMin / 60);
-
-        // Skip users whose wind-down hour doesn't match the current UTC hour
-        if (windDownUtcHour !== currentUtcHour) continue;
-
-        // Convert UTC minutes to local minutes using device timezone offset
-        const tzOff = tz_offset_min ?? 0;
-        const avgWakeLocalMin = ((avgWakeUtcMin + tzOff) + 1440 * 2) % 1440;
-
-        // Format average wake time for display (12h, local)
-        const wakeH = Math.floor(avgWakeLocalMin / 60);
-        const wakeM = avgWakeLocalMin % 60;
-        const wakeH12 = wakeH % 12 || 12;
-        const wakeAmPm = wakeH < 12 ? 'AM' : 'PM';
-        const wakeStr = `${wakeH12}:${String(wakeM).padStart(2, '0')} ${wakeAmPm}`;
-
-        // Format bedtime (wake - 8h, 12h, local)
-        const bedLocalMin = ((avgWakeLocalMin - 480) + 1440) % 1440;
-        const bedH = Math.floor(bedLocalMin / 60);
-        const bedM = bedLocalMin % 60;
-        const bedH12 = bedH % 12 || 12;
-        const bedAmPm = bedH < 12 ? 'AM' : 'PM';
-        const bedStr = `${bedH12}:${String(bedM).padStart(2, '0')} ${bedAmPm}`;
-
-        title = 'Time to wind down 🌙';
-        body = `To wake at ${wakeStr} well-rested, aim to be asleep by ${bedStr}.`;
-      }
-
-      messages.push({
-        to: token,
-        title,
-        body,
-        sound: 'default',
-        data: {
-          url: type === 'evening' ? 'smartring:///?tab=activity' : 'smartring:///?tab=sleep',
-        },
-      });
-    }
+    // One batched query per tz cohort instead of one global scan: each cohort
+    // only loads rows for its own users, and the evening summary is keyed on
+    // the cohort's local date rather than the UTC date.
+    const cohorts = groupByTzCohort(tokenRows);
+    const perCohort = await mapWithConcurrency(cohorts, COHORT_CONCURRENCY, cohort =>
+      buildCohortMessages(supabase, type, cohort, now, currentUtcHour),
+    );
+    const messages = perCohort.flat();
 
     if (messages.length === 0) {
       return new Response(JSON.stringify({ sent: 0, reason: 'no matching users for this hour' }), {
@@ -207,19 +117,30 @@ serve(async (req: Request) => {
       });
     }
 
-    // Send in batches of 100 (Expo limit)
-    const BATCH = 100;
-    let totalSent = 0;
-    for (let i = 0; i < messages.length; i += BATCH) {
-      const res = await fetch('https://exp.host/--/api/v2/push/send', {
-        method: 'POST',
-        headers: { 'Content-Type': 'application/json', 'Accept': 'application/json' },
-        body: JSON.stringify(messages.slice(i, i + BATCH)),
-      });
-      if (res.ok) totalSent += Math.min(BATCH, messages.length - i);
-    }
-
-    return new Response(JSON.stringify({ sent: totalSent, type, utcHour: currentUtcHour }), {
+    // Send in batches of 100 (Expo limit), a few batches in flight at a time,
+    // retrying 429 / connection refused with exponential backoff.
+    const batches = chunk(messages, EXPO_BATCH);
+    const sentPerBatch = await mapWithConcurrency(batches, SEND_CONCURRENCY, async batch => {
+      try {
+        const res = await fetchWithRetry(EXPO_PUSH_URL, {
+          method: 'POST',
+          headers: { 'Content-Type': 'application/json', 'Accept': 'application/json' },
+          body: JSON.stringify(batch),
+        }, { idempotent: false });
+        return res.ok ? batch.length : 0;
+      } catch {
+        return 0;
+      }
+    });
+    const totalSent = sentPerBatch.reduce((a, b) => a + b, 0);
+
+    return new Response(JSON.stringify({
+      sent: totalSent,
+      type,
+      utcHour: currentUtcHour,
+      cohorts: cohorts.length,
+      batches: batches.length,
+    }), {
       headers: { 'Content-Type': 'application/json' },
     });
   } catch (err) {
@@ -229,3 +150,161 @@ serve(async (req: Request) => {
     });
   }
 });
+
+
+// ── Per-cohort message builder ────────────────────────────────────────────────
+
+interface RangeQuery<T> {
+  range(from: number, to: number): PromiseLike<{ data: T[] | null; error: unknown }>;
+}
+
+/**
+ * Every row of `query`, paged with `.range()` until a short page. The query
+ * must order by a unique key so pages don't overlap.
+ */
+async function selectPaged<T>(query: () => RangeQuery<T>): Promise<T[]> {
+  const rows: T[] = [];
+  for (let from = 0; ; from += PAGE_SIZE) {
+    const { data, error } = await query().range(from, from + PAGE_SIZE - 1);
+    if (error) throw error;
+    if (data) rows.push(...data);
+    if (!data || data.length < PAGE_SIZE) return rows;
+  }
+}
+
+/** Rows for `userIds`: one paged `.in()` query per chunk of users. */
+async function selectForUsers<T>(
+  userIds: string[],
+  query: (ids: string[]) => RangeQuery<T>,
+): Promise<T[]> {
+  const perChunk = await Promise.all(chunk(userIds, USER_ID_CHUNK).map(ids => selectPaged(() => query(ids))));
+  return perChunk.flat();
+}
+
+function formatClock12(localMin: number): string {
+  const h = Math.floor(localMin / 60);
+  const m = localMin % 60;
+  return `${h % 12 || 12}:${String(m).padStart(2, '0')} ${h < 12 ? 'AM' : 'PM'}`;
+}
+
+async function buildCohortMessages(
+  supabase: SupabaseClient,
+  type: PushType,
+  cohort: TzCohort<TokenRow>,
+  now: Date,
+  currentUtcHour: number,
+): Promise<PushMessage[]> {
+  const url = type === 'evening' ? 'smartring:///?tab=activity' : 'smartring:///?tab=sleep';
+  const messages: PushMessage[] = [];
+  const push = (to: string, title: string, body: string) =>
+    messages.push({ to, title, body, sound: 'default', data: { url } });
+
+  if (type === 'morning') {
+    const oneDayAgo = new Date(now.getTime() - 24 * 60 * 60 * 1000).toISOString();
+    const sessions = await selectForUsers<{
+      user_id: string; start_time: string; end_time: string;
+      sleep_score: number | null; deep_min: number | null; light_min: number | null; rem_min: number | null;
+    }>(cohort.userIds, ids => supabase
+      .from('sleep_sessions')
+      .select('user_id, start_time, end_time, sleep_score, deep_min, light_min, rem_min')
+      .in('user_id', ids)
+      .gte('end_time', oneDayAgo)
+      .order('id'));
+
+    // Most-recent session per user
+    const sessionByUser = new Map<string, typeof sessions[number]>();
+    for (const s of sessions) {
+      const prev = sessionByUser.get(s.user_id);
+      if (!prev || s.end_time > prev.end_time) sessionByUser.set(s.user_id, s);
+    }
+
+    for (const { user_id, token } of cohort.rows) {
+      const session = sessionByUser.get(user_id);
+      if (!session) {
+        // Fallback: no synced data yet — nudge user to open the app
+        push(token, 'Your sleep summary is ready 🌙', 'See how you slept last night. Tap to view your analysis.');
+        continue;
+      }
+      const stageTotalMin = (session.deep_min || 0) + (session.light_min || 0) + (session.rem_min || 0);
+      const totalMin = stageTotalMin > 0
+        ? stageTotalMin
+        : Math.round((new Date(session.end_time).getTime() - new Date(session.start_time).getTime()) / 60000);
+      const h = Math.floor(totalMin / 60);
+      const m = totalMin % 60;
+      const scoreText = session.sleep_score ? ` · Score: ${session.sleep_score}` : '';
+      push(token, 'Good morning! Your sleep is ready 🌙', `You slept ${h}h ${m}m${scoreText}. Tap to see your full analysis.`);
+    }
+    return messages;
+  }
+
+  if (type === 'evening') {
+    const localDate = cohortLocalDate(now, cohort.tzOffsetMin);
+    const summaries = await selectForUsers<{ user_id: string; total_steps: number | null; hr_avg: number | null }>(
+      cohort.userIds,
+      ids => supabase
+        .from('daily_summaries')
+        .select('user_id, total_steps, hr_avg')
+        .in('user_id', ids)
+        .eq('date', localDate)
+        .order('id'),
+    );
+    const summaryByUser = new Map(summaries.map(s => [s.user_id, s]));
+
+    for (const { user_id, token } of cohort.rows) {
+      const summary = summaryByUser.get(user_id);
+      if (!summary) continue;
+
+      const steps = summary.total_steps ? summary.total_steps.toLocaleString('en-US') : null;
+      const hr = summary.hr_avg ? Math.round(summary.hr_avg) : null;
+      if (!steps && !hr) continue;
+
+      const parts: string[] = [];
+      if (steps) parts.push(`${steps} steps`);
+      if (hr) parts.push(`avg HR ${hr} bpm`);
+      push(token, "Today's activity summary 🏃", `${parts.join(' · ')}. Tap to see your full day.`);
+    }
+    return messages;
+  }
+
+  // wind-down: only send if this UTC hour matches the user's computed wind-down hour
+  const sevenDaysAgo = new Date(now.getTime() - 7 * 24 * 60 * 60 * 1000).toISOString();
+  const wakes = await selectForUsers<{ user_id: string; end_time: string }>(cohort.userIds, ids => supabase
+    .from('sleep_sessions')
+    .select('user_id, end_time')
+    .in('user_id', ids)
+    .gte('end_time', sevenDaysAgo)
+    .order('id'));
+
+  // 7-day average wake time per user (UTC minutes of day)
+  const wakeUtcMinSumByUser = new Map<string, { sum: number; count: number }>();
+  for (const s of wakes) {
+    const d = new Date(s.end_time);
+    const utcMin = d.getUTCHours() * 60 + d.getUTCMinutes();
+    const acc = wakeUtcMinSumByUser.get(s.user_id);
+    if (acc) { acc.sum += utcMin; acc.count += 1; }
+    else wakeUtcMinSumByUser.set(s.user_id, { sum: utcMin, count: 1 });
+  }
+
+  for (const { user_id, token, tz_offset_min } of cohort.rows) {
+    const userData = wakeUtcMinSumByUser.get(user_id);
+    if (!userData) continue;
+
+    const avgWakeUtcMin = Math.round(userData.sum / userData.count);
+
+    // Wind-down = 30 min before bedtime; bedtime = wake - 8h
+    // So wind-down = wake - 8h 30min = wake - 510 min
+    const windDownUtcMin = ((avgWakeUtcMin - 510) + 1440 * 2) % 1440;
+    if (Math.floor(windDownUtcMin / 60) !== currentUtcHour) continue;
+
+    // Convert UTC minutes to local minutes using device timezone offset
+    const avgWakeLocalMin = ((avgWakeUtcMin + (tz_offset_min ?? 0)) + 1440 * 2) % 1440;
+    const bedLocalMin = ((avgWakeLocalMin - 480) + 1440) % 1440;
+
+    push(
+      token,
+      'Time to wind down 🌙',
+      `To wake at ${formatClock12(avgWakeLocalMin)} well-rested, aim to be asleep by ${formatClock12(bedLocalMin)}.`,
+    );
+  }
+  return messages;
+}
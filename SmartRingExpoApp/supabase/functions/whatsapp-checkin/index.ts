@@ -1,5 +1,6 @@
 import { serve } from 'https://deno.land/std@0.168.0/http/server.ts';
 import { createClient } from 'https://esm.sh/@supabase/supabase-js@2';
+import { fetchWithRetry } from '../_shared/fanout.ts';
 
 /**
  * whatsapp-checkin — 3× daily WhatsApp health check-in via Twilio + Claude AI.
@@ -19,6 +20,11 @@ import { createClient } from 'https://esm.sh/@supabase/supabase-js@2';
  * app_config keys:
  *   whatsapp_recipient, whatsapp_app_link (optional),
  *   edge_function_url, notification_secret
+ *
+ * The four snapshot tables are read in one parallel round; Anthropic and
+ * Twilio calls go through fetchWithRetry (429/5xx → backoff + jitter). The
+ * Twilio send is non-idempotent, so it only retries 429 / connection refused:
+ * a 5xx after Twilio queued the message would otherwise send it twice.
  */
 
 const VALID_TYPES = ['morning', 'evening', 'night'] as const;
@@ -197,7 +203,7 @@ serve(async (req: Request) => {
     });
 
     // ── Claude AI message ───────────────────────────────────────────────────
-    const anthropicRes = await fetch('https://api.anthropic.com/v1/messages', {
+    const anthropicRes = await fetchWithRetry('https://api.anthropic.com/v1/messages', {
       method: 'POST',
       headers: {
         'x-api-key': anthropicKey,
@@ -235,7 +241,7 @@ serve(async (req: Request) => {
       Body: message,
     });
 
-    const twilioRes = await fetch(
+    const twilioRes = await fetchWithRetry(
       `https://api.twilio.com/2010-04-01/Accounts/${twilioSid}/Messages.json`,
       {
         method: 'POST',
@@ -245,6 +251,7 @@ serve(async (req: Request) => {
         },
         body: twilioBody.toString(),
       },
+      { idempotent: false },
     );
 
     if (!twilioRes.ok) {
@@ -0,0 +1,46 @@
+-- Delta-sync change cursors.
+-- The app caches metric rows locally per user/table/day and, on each mount,
+-- only asks for rows whose updated_at is newer than its last cursor
+-- (see src/services/DeltaSyncService.ts). That needs an updated_at column
+-- that moves on every INSERT and on every upsert-driven UPDATE.
+
+CREATE OR REPLACE FUNCTION set_row_updated_at()
+RETURNS TRIGGER LANGUAGE plpgsql AS $$
+BEGIN
+  NEW.updated_at = NOW();
+  RETURN NEW;
+END;
+$$;
+
+DO $$
+DECLARE
+  t TEXT;
+BEGIN
+  FOREACH t IN ARRAY ARRAY[
+    'sleep_sessions',
+    'heart_rate_readings',
+    'hrv_readings',
+    'spo2_readings',
+    'temperature_readings',
+    'daily_summaries'
+  ]
+  LOOP
+    -- No default yet: ADD COLUMN ... DEFAULT NOW() would stamp every existing
+    -- row with the migration time and the backfill below would match nothing
+    EXECUTE format('ALTER TABLE %I ADD COLUMN IF NOT EXISTS updated_at TIMESTAMPTZ', t);
+    -- Existing rows: treat creation time as the last change
+    EXECUTE format('UPDATE %I SET updated_at = COALESCE(created_at, NOW()) WHERE updated_at IS NULL', t);
+    EXECUTE format('ALTER TABLE %I ALTER COLUMN updated_at SET DEFAULT NOW()', t);
+    EXECUTE format('ALTER TABLE %I ALTER COLUMN updated_at SET NOT NULL', t);
+
+    EXECUTE format('DROP TRIGGER IF EXISTS %I ON %I', t || '_set_updated_at', t);
+    EXECUTE format(
+      'CREATE TRIGGER %I BEFORE UPDATE ON %I FOR EACH ROW EXECUTE FUNCTION set_row_updated_at()',
+      t || '_set_updated_at', t
+    );
+
+    -- Cursor scans: WHERE user_id = $1 AND updated_at >= $2
+    EXECUTE format('CREATE INDEX IF NOT EXISTS %I ON %I (user_id, updated_at)', 'idx_' || t || '_user_updated', t);
+  END LOOP;
+END;
+$$;